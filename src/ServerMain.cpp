@@ -54,6 +54,7 @@ int main(int argc, char** argv) {
   bool onlyPsoAndPosPermutations;
   bool persistUpdates;
   std::vector<std::string> preloadMaterializedViews;
+  std::string cacheWarmupFile;
 
   ad_utility::MemorySize memoryMaxSize;
 
@@ -197,6 +198,17 @@ int main(int argc, char** argv) {
       "prefix are rejected. To disable all federated queries, set this option "
       "to an invalid IRI prefix like `-`. Magic services (for example spatial "
       "search or materialized views) are never affected.");
+  add("cache-warmup-file",
+      po::value<std::string>(&cacheWarmupFile)->default_value(""),
+      "If set, the hottest queries are saved to this file periodically and "
+      "when the server is shut down, and they are replayed in the background "
+      "when the server is started, to warm up the caches (default: no "
+      "warm-up).");
+  add("cache-warmup-num-queries",
+      optionFactory
+          .getProgramOption<&RuntimeParameters::cacheWarmupNumQueries_>(),
+      "The number of the hottest queries that are saved for the cache "
+      "warm-up.");
   add("log-level",
       optionFactory.getProgramOption<&RuntimeParameters::logLevel_>(),
       "Runtime log level: FATAL, ERROR, WARN, INFO, DEBUG, TIMING, or TRACE. "
@@ -231,7 +243,8 @@ int main(int argc, char** argv) {
     Server server(port, numSimultaneousQueries, memoryMaxSize,
                   std::move(accessToken), noAccessCheck, !noPatterns);
     server.run(indexBasename, text, !noPatterns, !onlyPsoAndPosPermutations,
-               persistUpdates, preloadMaterializedViews);
+               persistUpdates, preloadMaterializedViews,
+               std::move(cacheWarmupFile));
   } catch (const std::exception& e) {
     // This code should never be reached as all exceptions should be handled
     // within server.run()
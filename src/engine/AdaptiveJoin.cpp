@@ -0,0 +1,297 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/AdaptiveJoin.h"
+
+#include <absl/strings/str_cat.h>
+
+#include "engine/ExplicitIdTableOperation.h"
+#include "engine/Join.h"
+#include "engine/MultiColumnJoin.h"
+#include "engine/QueryPlanner.h"
+#include "engine/Sort.h"
+#include "global/RuntimeParameters.h"
+
+namespace {
+// Return true iff the root operation of the `qet` is a binary join that is
+// part of a join region.
+bool isJoin(const QueryExecutionTree& qet) {
+  const auto* operation = qet.getRootOperation().get();
+  return dynamic_cast<const Join*>(operation) != nullptr ||
+         dynamic_cast<const MultiColumnJoin*>(operation) != nullptr;
+}
+
+// Skip the `Sort`s at the root of the `qet`, which the query planner adds in
+// between the joins.
+template <typename T>
+T* skipSorts(T* qet) {
+  while (dynamic_cast<const Sort*>(qet->getRootOperation().get()) != nullptr) {
+    qet = qet->getRootOperation()->getChildren().at(0);
+  }
+  return qet;
+}
+
+// Collect the inputs of the join region rooted at the `join` (skipping
+// `Sort`s) in the order in which they are executed.
+template <typename T>
+void collectInputs(T* join, std::vector<T*>& inputs) {
+  for (T* child : join->getRootOperation()->getChildren()) {
+    T* input = skipSorts(child);
+    if (isJoin(*input)) {
+      collectInputs(input, inputs);
+    } else {
+      inputs.push_back(input);
+    }
+  }
+}
+
+// Return the first join of the region rooted at the `join` that has to be
+// executed, i.e. the first join (in the order of the execution) whose inputs
+// are not joins.
+QueryExecutionTree* findNextJoin(QueryExecutionTree* join) {
+  for (auto* child : join->getRootOperation()->getChildren()) {
+    auto* input = skipSorts(child);
+    if (isJoin(*input)) {
+      return findNextJoin(input);
+    }
+  }
+  return join;
+}
+
+// Return a pointer to the `IdTable` of the fully materialized `result` that
+// keeps the `result` alive.
+std::shared_ptr<const IdTable> getIdTablePointer(
+    std::shared_ptr<const Result> result) {
+  const IdTable* idTable = &result->idTable();
+  return {std::move(result), idTable};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+AdaptiveJoin::AdaptiveJoin(QueryExecutionContext* qec,
+                           std::shared_ptr<QueryExecutionTree> plan,
+                           std::optional<double> reoptimizationFactor)
+    : Operation{qec},
+      plan_{std::move(plan)},
+      reoptimizationFactor_{reoptimizationFactor.value_or(
+          getRuntimeParameter<
+              &RuntimeParameters::adaptiveJoinReoptimizationFactor_>())} {
+  AD_CONTRACT_CHECK(plan_ != nullptr);
+  cacheKey_ = absl::StrCat("ADAPTIVE JOIN\n", plan_->getCacheKey());
+}
+
+// _____________________________________________________________________________
+bool AdaptiveJoin::isApplicable(const QueryExecutionTree& plan) {
+  const auto* qet = skipSorts(&plan);
+  if (isJoin(*qet)) {
+    std::vector<const QueryExecutionTree*> inputs;
+    collectInputs(qet, inputs);
+    return inputs.size() >= 3;
+  }
+  return ql::ranges::any_of(
+      qet->getRootOperation()->getChildren(),
+      [](const QueryExecutionTree* child) { return isApplicable(*child); });
+}
+
+// _____________________________________________________________________________
+std::vector<QueryExecutionTree*> AdaptiveJoin::getChildren() {
+  return {plan_.get()};
+}
+
+// _____________________________________________________________________________
+std::string AdaptiveJoin::getDescriptor() const { return "Adaptive Join"; }
+
+// _____________________________________________________________________________
+size_t AdaptiveJoin::getResultWidth() const { return plan_->getResultWidth(); }
+
+// _____________________________________________________________________________
+size_t AdaptiveJoin::getCostEstimate() { return plan_->getCostEstimate(); }
+
+// _____________________________________________________________________________
+float AdaptiveJoin::getMultiplicity(size_t col) {
+  return plan_->getMultiplicity(col);
+}
+
+// _____________________________________________________________________________
+bool AdaptiveJoin::knownEmptyResult() { return plan_->knownEmptyResult(); }
+
+// _____________________________________________________________________________
+std::string AdaptiveJoin::getCacheKeyImpl() const { return cacheKey_; }
+
+// _____________________________________________________________________________
+uint64_t AdaptiveJoin::getSizeEstimateBeforeLimit() {
+  return plan_->getSizeEstimate();
+}
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> AdaptiveJoin::resultSortedOn() const {
+  return plan_->resultSortedOn();
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> AdaptiveJoin::cloneImpl() const {
+  return std::make_unique<AdaptiveJoin>(getExecutionContext(), plan_->clone(),
+                                        reoptimizationFactor_);
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap AdaptiveJoin::computeVariableToColumnMap() const {
+  return plan_->getVariableColumns();
+}
+
+// _____________________________________________________________________________
+Result AdaptiveJoin::computeResult([[maybe_unused]] bool requestLaziness) {
+  materializedResults_.clear();
+  reoptimizations_ = nlohmann::json::array();
+  executeJoinRegions(*plan_);
+  auto result = plan_->getResult();
+
+  // Show the subtrees that computed the materialized results in the runtime
+  // information. The materialized results themselves take no time.
+  for (const auto& [operation, runtimeInfoOfComputation] :
+       materializedResults_) {
+    auto& info = operation->runtimeInfo();
+    info.children_ = {runtimeInfoOfComputation};
+    info.totalTime_ = runtimeInfoOfComputation->totalTime_;
+  }
+  runtimeInfo().addDetail("reoptimizations", reoptimizations_);
+
+  auto localVocab = result->getCopyOfLocalVocab();
+  return {getIdTablePointer(std::move(result)), resultSortedOn(),
+          std::move(localVocab)};
+}
+
+// _____________________________________________________________________________
+void AdaptiveJoin::executeJoinRegions(QueryExecutionTree& qet) {
+  if (isJoin(*skipSorts(&qet))) {
+    executeJoinRegion(qet);
+    return;
+  }
+  for (auto* child : qet.getRootOperation()->getChildren()) {
+    executeJoinRegions(*child);
+  }
+}
+
+// _____________________________________________________________________________
+void AdaptiveJoin::executeJoinRegion(QueryExecutionTree& root) {
+  // The result of the region must have the same columns and the same order as
+  // in the original plan. The columns of a re-planned tree can only be
+  // rearranged if all the columns are bound to variables.
+  const VariableToColumnMap variables = root.getVariableColumns();
+  const std::vector<ColumnIndex> sortedOn = root.resultSortedOn();
+  const bool canBeReplanned =
+      reoptimizationFactor_ > 1.0 &&
+      variables.size() == root.getResultWidth() &&
+      root.getRootOperation()->getLimitOffset().isUnconstrained();
+
+  QueryPlanner planner{getExecutionContext(), getCancellationHandle()};
+  // The tree that is currently executed, and for a re-planned tree the column
+  // of the re-planned tree for each column of the original region.
+  QueryExecutionTree* current = &root;
+  std::shared_ptr<QueryExecutionTree> replanned;
+  std::vector<ColumnIndex> permutation;
+
+  while (true) {
+    checkCancellation();
+    auto* join = skipSorts(current);
+    if (!isJoin(*join)) {
+      break;
+    }
+    auto* next = findNextJoin(join);
+    if (next == join) {
+      break;
+    }
+    // Execute the next join and replace it by its result.
+    const size_t estimate = next->getSizeEstimate();
+    auto result = next->getResult();
+    const size_t actualSize = result->idTable().numRows();
+    auto descriptor = next->getRootOperation()->getDescriptor();
+    auto localVocab = result->getCopyOfLocalVocab();
+    replaceByMaterializedResult(
+        *next, getIdTablePointer(std::move(result)), std::move(localVocab),
+        next->getRootOperation()->getRuntimeInfoPointer());
+
+    if (!canBeReplanned || !isMisestimated(estimate, actualSize)) {
+      continue;
+    }
+    std::vector<QueryExecutionTree*> inputs;
+    collectInputs(join, inputs);
+    if (inputs.size() < 3) {
+      continue;
+    }
+    // Re-plan the remaining joins. The new tree is sorted like the original
+    // one, so only the columns have to be rearranged at the end.
+    std::vector<std::shared_ptr<QueryExecutionTree>> subtrees;
+    for (const auto* input : inputs) {
+      subtrees.push_back(std::make_shared<QueryExecutionTree>(*input));
+    }
+    auto joinTree = planner.createJoinTree(std::move(subtrees));
+    permutation.clear();
+    permutation.resize(root.getResultWidth());
+    for (const auto& [variable, info] : variables) {
+      permutation.at(info.columnIndex_) = joinTree->getVariableColumn(variable);
+    }
+    std::vector<ColumnIndex> sortColumns;
+    for (ColumnIndex col : sortedOn) {
+      sortColumns.push_back(permutation.at(col));
+    }
+    replanned =
+        QueryExecutionTree::createSortedTree(std::move(joinTree), sortColumns);
+    replanned->getRootOperation()->createRuntimeInfoFromEstimates(
+        getRootRuntimeInfoPointer());
+    current = replanned.get();
+    reoptimizations_.push_back(
+        nlohmann::json{{"subresult", descriptor},
+                       {"estimated-size", estimate},
+                       {"actual-size", actualSize},
+                       {"num-replanned-inputs", inputs.size()}});
+  }
+
+  // Execute the last join and replace the complete region by its result.
+  auto result = current->getResult();
+  auto localVocab = result->getCopyOfLocalVocab();
+  auto runtimeInfoOfComputation =
+      current->getRootOperation()->getRuntimeInfoPointer();
+  std::shared_ptr<const IdTable> idTable;
+  if (replanned == nullptr) {
+    idTable = getIdTablePointer(std::move(result));
+  } else {
+    auto table = result->idTable().clone();
+    table.setColumnSubset(permutation);
+    idTable = std::make_shared<const IdTable>(std::move(table));
+  }
+  replaceByMaterializedResult(root, std::move(idTable), std::move(localVocab),
+                              std::move(runtimeInfoOfComputation));
+}
+
+// _____________________________________________________________________________
+void AdaptiveJoin::replaceByMaterializedResult(
+    QueryExecutionTree& qet, std::shared_ptr<const IdTable> result,
+    LocalVocab localVocab,
+    std::shared_ptr<RuntimeInformation> runtimeInfoOfComputation) {
+  AD_CORRECTNESS_CHECK(result->numColumns() == qet.getResultWidth());
+  // The cache key stays the same, s.t. the cache keys of the ancestors remain
+  // valid.
+  auto operation = std::make_shared<ExplicitIdTableOperation>(
+      getExecutionContext(), std::move(result), qet.getVariableColumns(),
+      qet.resultSortedOn(), std::move(localVocab), qet.getCacheKey());
+  std::vector<float> multiplicities;
+  for (size_t col = 0; col < qet.getResultWidth(); ++col) {
+    multiplicities.push_back(qet.getMultiplicity(col));
+  }
+  operation->setMultiplicities(std::move(multiplicities));
+  operation->createRuntimeInfoFromEstimates(getRootRuntimeInfoPointer());
+  materializedResults_.emplace_back(operation,
+                                    std::move(runtimeInfoOfComputation));
+  qet = QueryExecutionTree{getExecutionContext(), std::move(operation)};
+}
+
+// _____________________________________________________________________________
+bool AdaptiveJoin::isMisestimated(size_t estimate, size_t actualSize) const {
+  auto larger = static_cast<double>(std::max(estimate, actualSize));
+  auto smaller =
+      static_cast<double>(std::max(std::min(estimate, actualSize), size_t{1}));
+  return larger > reoptimizationFactor_ * smaller;
+}
@@ -0,0 +1,103 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_ADAPTIVEJOIN_H
+#define QLEVER_SRC_ENGINE_ADAPTIVEJOIN_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+// An operation that executes a plan that was chosen by the `QueryPlanner` and
+// contains a tree of (at least two) binary joins, but re-plans the remaining
+// joins during the execution if the size estimates turn out to be wrong.
+//
+// The joins of such a tree (the "join region") are executed one by one
+// bottom-up. Each intermediate result is fully materialized and replaces the
+// join in the tree. If the actual size of an intermediate result differs from
+// its estimate by more than the `reoptimizationFactor`, the join order of the
+// remaining inputs (the materialized intermediate results, the sizes of which
+// are now known exactly, and the inputs that have not been executed yet) is
+// planned again. The result of the join region has the same columns and is
+// sorted in the same way as in the original plan, so the operations above the
+// join region are not affected.
+//
+// The re-planned trees are part of the runtime information (as the children of
+// the materialized results), and the details of each re-optimization are
+// stored in the runtime information of the `AdaptiveJoin`.
+class AdaptiveJoin : public Operation {
+ private:
+  // The plan that is executed. Its join regions are replaced by their
+  // materialized results during `computeResult`.
+  std::shared_ptr<QueryExecutionTree> plan_;
+  double reoptimizationFactor_;
+  // The cache key of the original `plan_`.
+  std::string cacheKey_;
+
+  // The materialized results that were inserted into the tree, together with
+  // the runtime information of the subtrees that computed them.
+  std::vector<std::pair<std::shared_ptr<Operation>,
+                        std::shared_ptr<RuntimeInformation>>>
+      materializedResults_;
+  // The details of the re-optimizations for the runtime information.
+  nlohmann::json reoptimizations_ = nlohmann::json::array();
+
+ public:
+  // Create an `AdaptiveJoin` for the `plan`. If the `reoptimizationFactor` is
+  // not specified, the value of the runtime parameter
+  // `adaptive-join-reoptimization-factor` is used.
+  AdaptiveJoin(QueryExecutionContext* qec,
+               std::shared_ptr<QueryExecutionTree> plan,
+               std::optional<double> reoptimizationFactor = std::nullopt);
+
+  // Return true iff the `plan` contains a join region with at least three
+  // inputs, s.t. there is something to re-plan.
+  static bool isApplicable(const QueryExecutionTree& plan);
+
+  std::vector<QueryExecutionTree*> getChildren() override;
+  std::string getDescriptor() const override;
+  size_t getResultWidth() const override;
+  size_t getCostEstimate() override;
+  float getMultiplicity(size_t col) override;
+  bool knownEmptyResult() override;
+
+  // The details of the re-optimizations of the last execution. Public for
+  // testing.
+  const nlohmann::json& reoptimizations() const { return reoptimizations_; }
+
+ private:
+  std::string getCacheKeyImpl() const override;
+  uint64_t getSizeEstimateBeforeLimit() override;
+  std::vector<ColumnIndex> resultSortedOn() const override;
+  std::unique_ptr<Operation> cloneImpl() const override;
+  Result computeResult(bool requestLaziness) override;
+  VariableToColumnMap computeVariableToColumnMap() const override;
+
+  // Execute all the join regions in the subtree rooted at `qet` and replace
+  // them by their materialized results.
+  void executeJoinRegions(QueryExecutionTree& qet);
+
+  // Execute the join region rooted at `root` and replace it by its
+  // materialized result.
+  void executeJoinRegion(QueryExecutionTree& root);
+
+  // Replace the `qet` by an operation that returns the given `result` (which
+  // must have the same columns and the same sort order as the `qet`). The
+  // runtime information of the original `qet` becomes the child of the
+  // runtime information of the replacement.
+  void replaceByMaterializedResult(
+      QueryExecutionTree& qet, std::shared_ptr<const IdTable> result,
+      LocalVocab localVocab,
+      std::shared_ptr<RuntimeInformation> runtimeInfoOfComputation);
+
+  // Return true iff the actual size of a result differs from the `estimate` by
+  // more than the `reoptimizationFactor_`.
+  bool isMisestimated(size_t estimate, size_t actualSize) const;
+};
+
+#endif  // QLEVER_SRC_ENGINE_ADAPTIVEJOIN_H
@@ -0,0 +1,233 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/CacheWarmup.h"
+
+#include <absl/strings/str_cat.h>
+
+#include <filesystem>
+#include <nlohmann/json.hpp>
+#include <tuple>
+
+#include "backports/algorithm.h"
+#include "global/RuntimeParameters.h"
+#include "util/File.h"
+#include "util/Log.h"
+#include "util/Timer.h"
+
+namespace {
+// The order of the queries from the hottest to the coldest.
+bool isHotter(const CacheWarmup::Entry& a, const CacheWarmup::Entry& b) {
+  return std::tie(b.numExecutions_, b.totalTime_, a.query_) <
+         std::tie(a.numExecutions_, a.totalTime_, b.query_);
+}
+
+// The version of the file format, which is increased whenever the format
+// changes in an incompatible way.
+constexpr size_t CACHE_WARMUP_FILE_VERSION = 1;
+}  // namespace
+
+// _____________________________________________________________________________
+CacheWarmup::CacheWarmup(std::string filename, ReplayQuery replayQuery)
+    : filename_{std::move(filename)},
+      replayQuery_{std::move(replayQuery)},
+      thread_{[this]() { run(); }} {}
+
+// _____________________________________________________________________________
+CacheWarmup::~CacheWarmup() {
+  {
+    std::unique_lock lock{mutex_};
+    running_ = false;
+    if (currentReplay_ != nullptr) {
+      currentReplay_->cancel(ad_utility::CancellationState::MANUAL);
+    }
+  }
+  conditionVariable_.notify_all();
+}
+
+// _____________________________________________________________________________
+void CacheWarmup::recordQuery(std::string_view query,
+                              std::chrono::milliseconds time) {
+  auto numQueries =
+      getRuntimeParameter<&RuntimeParameters::cacheWarmupNumQueries_>();
+  if (numQueries == 0) {
+    return;
+  }
+  queries_.withWriteLock([&](auto& queries) {
+    auto [it, isNew] = queries.try_emplace(std::string{query});
+    auto& entry = it->second;
+    if (isNew) {
+      entry.query_ = it->first;
+    }
+    ++entry.numExecutions_;
+    entry.totalTime_ += time;
+    removeColdQueries(queries, numQueries);
+  });
+}
+
+// _____________________________________________________________________________
+void CacheWarmup::removeColdQueries(
+    ad_utility::HashMap<std::string, Entry>& queries, size_t numQueries) {
+  if (queries.size() <= maxNumRecordedQueriesFactor_ * numQueries) {
+    return;
+  }
+  // Only keep the hottest queries, s.t. there is room for new queries before
+  // the next removal.
+  std::vector<Entry> entries;
+  for (auto& [query, entry] : queries) {
+    entries.push_back(std::move(entry));
+  }
+  ql::ranges::sort(entries, isHotter);
+  entries.resize(numQueries);
+  queries.clear();
+  for (auto& entry : entries) {
+    auto query = entry.query_;
+    queries.emplace(std::move(query), std::move(entry));
+  }
+}
+
+// _____________________________________________________________________________
+auto CacheWarmup::hottestQueries(size_t numQueries) const
+    -> std::vector<Entry> {
+  auto entries = queries_.withReadLock([](const auto& queries) {
+    std::vector<Entry> result;
+    for (const auto& [query, entry] : queries) {
+      result.push_back(entry);
+    }
+    return result;
+  });
+  ql::ranges::sort(entries, isHotter);
+  if (entries.size() > numQueries) {
+    entries.resize(numQueries);
+  }
+  return entries;
+}
+
+// _____________________________________________________________________________
+void CacheWarmup::save() const {
+  auto numQueries =
+      getRuntimeParameter<&RuntimeParameters::cacheWarmupNumQueries_>();
+  auto queries = nlohmann::json::array();
+  for (const auto& entry : hottestQueries(numQueries)) {
+    queries.push_back({{"query", entry.query_},
+                       {"num-executions", entry.numExecutions_},
+                       {"total-time-ms", entry.totalTime_.count()}});
+  }
+  nlohmann::json json{{"version", CACHE_WARMUP_FILE_VERSION},
+                      {"queries", std::move(queries)}};
+  auto tmpFilename = absl::StrCat(filename_, ".tmp");
+  {
+    auto file = ad_utility::makeOfstream(tmpFilename);
+    file << json.dump() << std::endl;
+  }
+  std::filesystem::rename(tmpFilename, filename_);
+}
+
+// _____________________________________________________________________________
+auto CacheWarmup::readFromFile(const std::string& filename)
+    -> std::vector<Entry> {
+  if (!std::filesystem::exists(filename)) {
+    return {};
+  }
+  nlohmann::json json;
+  ad_utility::makeIfstream(filename) >> json;
+  auto version = json.at("version").get<size_t>();
+  if (version != CACHE_WARMUP_FILE_VERSION) {
+    throw std::runtime_error{absl::StrCat(
+        "The file \"", filename, "\" with the queries for the cache warm-up ",
+        "has format version ", version, ", but this version of QLever ",
+        "expects format version ", CACHE_WARMUP_FILE_VERSION)};
+  }
+  std::vector<Entry> entries;
+  for (const auto& query : json.at("queries")) {
+    entries.push_back(Entry{
+        query.at("query").get<std::string>(),
+        query.at("num-executions").get<size_t>(),
+        std::chrono::milliseconds{query.at("total-time-ms").get<int64_t>()}});
+  }
+  return entries;
+}
+
+// _____________________________________________________________________________
+void CacheWarmup::replay() {
+  std::vector<Entry> entries;
+  try {
+    entries = readFromFile(filename_);
+  } catch (const std::exception& e) {
+    AD_LOG_ERROR << "Reading the queries for the cache warm-up failed: "
+                 << e.what() << std::endl;
+    return;
+  }
+  if (entries.empty()) {
+    return;
+  }
+  queries_.withWriteLock([&entries](auto& queries) {
+    for (const auto& entry : entries) {
+      auto& recorded = queries[entry.query_];
+      recorded.query_ = entry.query_;
+      recorded.numExecutions_ += entry.numExecutions_;
+      recorded.totalTime_ += entry.totalTime_;
+    }
+  });
+
+  AD_LOG_INFO << "Warming up the cache with " << entries.size()
+              << " queries in the background ..." << std::endl;
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  size_t numReplayed = 0;
+  for (const auto& entry : entries) {
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    {
+      std::unique_lock lock{mutex_};
+      if (!running_) {
+        // This object is being destroyed.
+        return;
+      }
+      currentReplay_ = handle;
+    }
+    try {
+      replayQuery_(entry.query_, std::move(handle));
+      ++numReplayed;
+    } catch (const std::exception& e) {
+      // The warm-up is only an optimization, so a single query that fails
+      // (e.g. because it is not valid for a new index or because it timed
+      // out) must not stop it.
+      AD_LOG_WARN << "Replaying a query for the cache warm-up failed: "
+                  << e.what() << std::endl;
+    }
+  }
+  AD_LOG_INFO << "Cache warm-up done, " << numReplayed << " of "
+              << entries.size() << " queries were replayed in "
+              << timer.msecs().count() << " ms" << std::endl;
+}
+
+// _____________________________________________________________________________
+void CacheWarmup::run() {
+  replay();
+  std::unique_lock lock{mutex_};
+  while (true) {
+    // The parameters are read in each round, s.t. changes of the runtime
+    // parameters take effect without a restart.
+    std::chrono::seconds interval =
+        getRuntimeParameter<&RuntimeParameters::cacheWarmupSaveInterval_>();
+    bool isPeriodic = interval.count() > 0;
+    bool stopped = conditionVariable_.wait_for(
+        lock, isPeriodic ? interval : disabledCheckInterval_,
+        [this]() { return !running_; });
+    if ((isPeriodic || stopped) &&
+        getRuntimeParameter<&RuntimeParameters::cacheWarmupNumQueries_>() > 0) {
+      lock.unlock();
+      try {
+        save();
+      } catch (const std::exception& e) {
+        AD_LOG_ERROR << "Saving the queries for the cache warm-up failed: "
+                     << e.what() << std::endl;
+      }
+      lock.lock();
+    }
+    if (stopped) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,107 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_CACHEWARMUP_H
+#define QLEVER_SRC_ENGINE_CACHEWARMUP_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "util/CancellationHandle.h"
+#include "util/HashMap.h"
+#include "util/Synchronized.h"
+#include "util/jthread.h"
+
+// Warm up the caches of the server after a restart (or after switching to a
+// new index). The server records the queries that it executes, and the
+// hottest of them (those that were executed most often, see
+// `cache-warmup-num-queries`) are periodically written to a file (see
+// `cache-warmup-save-interval`) and once more when this object is destroyed.
+// When this object is created, the queries from that file are replayed in a
+// background thread. This fills the `QueryResultCache` with the results of
+// their subtrees and the page cache of the OS with the blocks of the
+// permutations and the vocabulary that they read.
+class CacheWarmup {
+ public:
+  // Compute the result of the given query (e.g. with a low priority). Each
+  // query gets its own cancellation handle (which can e.g. be cancelled after
+  // a deadline without stopping the replay of the other queries). It is
+  // cancelled when this object is destroyed.
+  using ReplayQuery = std::function<void(
+      const std::string& query, ad_utility::SharedCancellationHandle)>;
+
+  // A recorded query.
+  struct Entry {
+    std::string query_;
+    size_t numExecutions_ = 0;
+    std::chrono::milliseconds totalTime_{0};
+    bool operator==(const Entry&) const = default;
+  };
+
+ private:
+  std::string filename_;
+  ReplayQuery replayQuery_;
+  ad_utility::Synchronized<ad_utility::HashMap<std::string, Entry>> queries_;
+  std::mutex mutex_;
+  // The cancellation handle of the query that is currently replayed, used to
+  // stop the replay when this object is destroyed. Guarded by `mutex_`.
+  ad_utility::SharedCancellationHandle currentReplay_;
+  std::condition_variable conditionVariable_;
+  bool running_ = true;
+  ad_utility::JThread thread_;
+
+  // At most this many times `cache-warmup-num-queries` queries are recorded.
+  // When there are more, only the hottest queries are kept.
+  static constexpr size_t maxNumRecordedQueriesFactor_ = 10;
+  // If the saving is disabled, check this often whether it has been enabled
+  // in the meantime.
+  static constexpr std::chrono::seconds disabledCheckInterval_{1};
+
+ public:
+  // Start the background thread that replays the queries from the file with
+  // the given name (if it exists) and then saves the hottest queries to it.
+  CacheWarmup(std::string filename, ReplayQuery replayQuery);
+
+  // Stop the background thread (and cancel an ongoing replay) and save the
+  // hottest queries one last time.
+  ~CacheWarmup();
+
+  CacheWarmup(const CacheWarmup&) = delete;
+  CacheWarmup& operator=(const CacheWarmup&) = delete;
+
+  // Record that the given query was executed and took the given `time`.
+  void recordQuery(std::string_view query, std::chrono::milliseconds time);
+
+  // The `numQueries` hottest recorded queries, the hottest first.
+  std::vector<Entry> hottestQueries(size_t numQueries) const;
+
+  // Write the hottest queries to the file. The file is replaced atomically,
+  // s.t. it is never left in a partially written state.
+  void save() const;
+
+  // Read the queries from the file with the given name. Return no queries if
+  // the file doesn't exist.
+  static std::vector<Entry> readFromFile(const std::string& filename);
+
+ private:
+  // The loop of the background thread.
+  void run();
+
+  // Replay the queries from the file, the hottest first. The queries are also
+  // recorded, s.t. they are still considered hot after the restart.
+  void replay();
+
+  // Remove the coldest queries if there are too many, the lock of the
+  // `queries_` must be held.
+  static void removeColdQueries(ad_utility::HashMap<std::string, Entry>& map,
+                                size_t numQueries);
+};
+
+#endif  // QLEVER_SRC_ENGINE_CACHEWARMUP_H
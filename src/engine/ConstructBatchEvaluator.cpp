@@ -51,10 +51,8 @@ EvaluatedVariableValues ConstructBatchEvaluator::evaluateVariableByColumn(
 
   const size_t numRows = ctx.numRows();
 
-  // Build a `(rowInBatch, Id)` index vector and sort by `Id`. This ensures
-  // that `VocabIndex` IDs form a contiguous, sorted block (see
-  // `idsToStringAndType`), converting vocabulary lookups from random-access
-  // reads to sequential reads for I/O locality.
+  // Build a `(rowInBatch, Id)` index vector and sort by `Id`, s.t. equal IDs
+  // are adjacent and each distinct ID is resolved only once.
   auto sortedIndices = ::ranges::to_vector(::ranges::views::enumerate(col));
 
   ql::ranges::sort(sortedIndices, {}, ad_utility::second);
@@ -80,9 +78,8 @@ EvaluatedVariableValues ConstructBatchEvaluator::evaluateVariableByColumn(
     }
   }
 
-  // Phase 2: batch-resolve cache misses. `missIds` is deduplicated and sorted
-  // (inherited from `sortedIndices`), satisfying the `idsToStringAndType`
-  // precondition for sequential VocabIndex I/O.
+  // Phase 2: batch-resolve cache misses. The `VocabIndex` IDs among them are
+  // looked up in a single batch (see `idsToStringAndType`).
   auto missResolved =
       ql::exportIds::idsToStringAndType(index, missIds, localVocab);
   for (auto&& [id, resolved, rows] :
@@ -5,8 +5,10 @@
 #include "engine/ExecuteUpdate.h"
 
 #include "engine/ExportQueryExecutionTrees.h"
+#include "engine/MaterializedViews.h"
 #include "engine/UpdateMetadata.h"
 #include "index/IndexImpl.h"
+#include "util/Timer.h"
 
 // _____________________________________________________________________________
 UpdateMetadata ExecuteUpdate::executeUpdate(
@@ -26,6 +28,26 @@ UpdateMetadata ExecuteUpdate::executeUpdate(
 
   // "The deletion of the triples happens before the insertion." (SPARQL 1.1
   // Update 3.1.3)
+  size_t numTriples = toDelete.idTriples_.size() + toInsert.idTriples_.size();
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+
+  // If there are loaded materialized views that are maintained incrementally,
+  // they need the changed triples (with the local vocab entries and blank
+  // nodes of the `deltaTriples`) and the state of the index before the update.
+  const auto& viewsManager = qet.getQec()->materializedViewsManager();
+  std::optional<std::pair<LocatedTriplesSharedState, DeltaTriples::Triples>>
+      stateBeforeAndChangedTriples;
+  if (viewsManager.hasViewsToMaintain()) {
+    deltaTriples.rewriteLocalVocabEntriesAndBlankNodes(toDelete.idTriples_);
+    deltaTriples.rewriteLocalVocabEntriesAndBlankNodes(toInsert.idTriples_);
+    deltaTriples.updateAugmentedMetadata();
+    DeltaTriples::Triples changedTriples = toDelete.idTriples_;
+    ql::ranges::copy(toInsert.idTriples_, std::back_inserter(changedTriples));
+    stateBeforeAndChangedTriples.emplace(
+        deltaTriples.getLocatedTriplesSharedStateCopy(),
+        std::move(changedTriples));
+  }
+
   tracer.beginTrace("deleteTriples");
   if (!toDelete.idTriples_.empty()) {
     deltaTriples.deleteTriples(cancellationHandle,
@@ -38,6 +60,18 @@ UpdateMetadata ExecuteUpdate::executeUpdate(
                                std::move(toInsert.idTriples_), tracer);
   }
   tracer.endTrace("insertTriples");
+  if (stateBeforeAndChangedTriples.has_value()) {
+    tracer.beginTrace("updateMaterializedViews");
+    deltaTriples.updateAugmentedMetadata();
+    const auto& [stateBefore, changedTriples] =
+        stateBeforeAndChangedTriples.value();
+    viewsManager.updateViewsAfterDeltaTriplesChange(
+        index.getImpl(), *stateBefore,
+        *deltaTriples.getLocatedTriplesSharedStateCopy(), changedTriples,
+        cancellationHandle);
+    tracer.endTrace("updateMaterializedViews");
+  }
+  metadata.throughput_ = DeltaTriplesThroughput{numTriples, timer.value()};
   return metadata;
 }
 
@@ -60,10 +94,9 @@ ExecuteUpdate::transformTriplesTemplate(
   // NOTE: This make a copy of each `TripleComponent' (for the hash set).
   auto addTCToLookup = [&lookupItems,
                         &encodedIriManager](const TripleComponent& tc) {
-    // IRIs encoded in the `Id` do not need a vocab lookup.
-    if (tc.isIri() &&
-        encodedIriManager.encode(tc.getIri().toStringRepresentation())
-            .has_value()) {
+    // IRIs and literals encoded in the `Id` do not need a vocab lookup.
+    if ((tc.isIri() || tc.isLiteral()) &&
+        tc.toValueIdIfNotString(&encodedIriManager).has_value()) {
       return;
     }
     if (tc.isLiteral() || tc.isIri()) {
@@ -60,10 +60,16 @@ uint64_t ExplicitIdTableOperation::getSizeEstimateBeforeLimit() {
 }
 
 // _____________________________________________________________________________
-float ExplicitIdTableOperation::getMultiplicity([[maybe_unused]] size_t col) {
-  // The multiplicity currently is a dummy, we could extend this class to also
-  // (optionally) store multiplicities.
-  return 1.0f;
+void ExplicitIdTableOperation::setMultiplicities(
+    std::vector<float> multiplicities) {
+  AD_CONTRACT_CHECK(multiplicities.size() == getResultWidth());
+  multiplicities_ = std::move(multiplicities);
+}
+
+// _____________________________________________________________________________
+float ExplicitIdTableOperation::getMultiplicity(size_t col) {
+  // Without explicitly set multiplicities, the multiplicity is a dummy.
+  return multiplicities_.empty() ? 1.0f : multiplicities_.at(col);
 }
 
 // _____________________________________________________________________________
@@ -71,9 +77,11 @@ bool ExplicitIdTableOperation::knownEmptyResult() { return idTable_->empty(); }
 
 // _____________________________________________________________________________
 std::unique_ptr<Operation> ExplicitIdTableOperation::cloneImpl() const {
-  return std::make_unique<ExplicitIdTableOperation>(
+  auto copy = std::make_unique<ExplicitIdTableOperation>(
       getExecutionContext(), idTable_, variables_, sortedColumns_,
       localVocab_.clone(), cacheKey_);
+  copy->multiplicities_ = multiplicities_;
+  return copy;
 }
 
 // _____________________________________________________________________________
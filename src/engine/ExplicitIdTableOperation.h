@@ -21,6 +21,8 @@ class ExplicitIdTableOperation : public Operation {
   std::vector<ColumnIndex> sortedColumns_;
   LocalVocab localVocab_;
   std::string cacheKey_;
+  // Optional multiplicities of the columns, see `setMultiplicities`.
+  std::vector<float> multiplicities_;
 
  public:
   ExplicitIdTableOperation(QueryExecutionContext* ctx,
@@ -32,6 +34,10 @@ class ExplicitIdTableOperation : public Operation {
   // Const and public getter for testing.
   size_t sizeEstimate() const { return idTable_->numRows(); }
 
+  // Set the multiplicities of the columns, e.g. the estimates of the operation
+  // that originally computed the table. Must contain one value per column.
+  void setMultiplicities(std::vector<float> multiplicities);
+
   // Overridden methods from the `Operation` base class.
   std::vector<QueryExecutionTree*> getChildren() override;
   std::string getCacheKeyImpl() const override;
@@ -99,6 +99,65 @@ STREAMABLE_GENERATOR_TYPE computeResultForAsk(
           "ASK queries are not supported for TSV or CSV or binary format."};
   }
 }
+
+// Helper for the export of the rows of a result, which resolves the IDs one by
+// one. Before a row is exported, the words of the `VocabIndex` IDs in the
+// exported columns of this and the following rows are looked up in a single
+// batch via `Vocabulary::prefetch`. The lookups of the individual IDs are then
+// served by the cache of hot strings of the vocabulary. This only happens if
+// the runtime parameter `vocabulary-hot-string-cache` is set.
+class VocabularyPrefetcher {
+  const Index& index_;
+  std::vector<size_t> columns_;
+  // The rows for which the words were prefetched most recently.
+  const IdTable* idTable_ = nullptr;
+  uint64_t beginOfPrefetchedRows_ = 0;
+  uint64_t endOfPrefetchedRows_ = 0;
+
+ public:
+  VocabularyPrefetcher(
+      const Index& index,
+      const QueryExecutionTree::ColumnIndicesAndTypes& columns)
+      : index_{index} {
+    // Without the cache, there is nothing to prefetch.
+    if (!getRuntimeParameter<&RuntimeParameters::vocabularyHotStringCache_>()) {
+      return;
+    }
+    for (const auto& column : columns) {
+      if (column.has_value()) {
+        columns_.push_back(column->columnIndex_);
+      }
+    }
+  }
+
+  // Has to be called before the row with the given `rowIndex` of the `idTable`
+  // is exported. The rows in `[rowIndex, endRow)` of the `idTable` will be
+  // exported next.
+  void operator()(const IdTable& idTable, uint64_t rowIndex, uint64_t endRow) {
+    if (columns_.empty() ||
+        (&idTable == idTable_ && rowIndex >= beginOfPrefetchedRows_ &&
+         rowIndex < endOfPrefetchedRows_)) {
+      return;
+    }
+    // The number of words must not exceed the `prefetchBatchSize_`, otherwise
+    // the words could be evicted from the cache before they are accessed.
+    uint64_t numRows = std::max<uint64_t>(
+        1, Index::Vocab::prefetchBatchSize_ / columns_.size());
+    idTable_ = &idTable;
+    beginOfPrefetchedRows_ = rowIndex;
+    endOfPrefetchedRows_ = std::min(endRow, rowIndex + numRows);
+    std::vector<VocabIndex> vocabIndices;
+    for (size_t column : columns_) {
+      for (Id id : idTable.getColumn(column).subspan(
+               rowIndex, endOfPrefetchedRows_ - rowIndex)) {
+        if (id.getDatatype() == Datatype::VocabIndex) {
+          vocabIndices.push_back(id.getVocabIndex());
+        }
+      }
+    }
+    index_.getVocab().prefetch(vocabIndices);
+  }
+};
 }  // namespace
 
 // __________________________________________________________________________
@@ -341,16 +400,21 @@ auto ExportQueryExecutionTrees::idTableToQLeverJSONBindings(
   AD_CORRECTNESS_CHECK(result != nullptr);
 
   auto rowIndicies = getRowIndices(limitAndOffset, *result, resultSize);
+  auto prefetcher = std::make_shared<VocabularyPrefetcher>(
+      qet.getQec()->getIndex(), columns);
   return ad_utility::OwningView(std::move(rowIndicies)) |
          ql::views::transform(
              [&qet, columns = std::move(columns), result = std::move(result),
-              cancellationHandle =
-                  std::move(cancellationHandle)](const auto& tableWithView) {
+              cancellationHandle = std::move(cancellationHandle),
+              prefetcher =
+                  std::move(prefetcher)](const auto& tableWithView) {
                return ql::ranges::transform_view(
                    tableWithView.view_, [&](uint64_t rowIndex) {
                      cancellationHandle->throwIfCancelled();
                      TableConstRefWithVocab tableWithVocab =
                          tableWithView.tableWithVocab_;
+                     (*prefetcher)(tableWithVocab.idTable(), rowIndex,
+                                   tableWithView.view_.back() + 1);
                      return idTableToQLeverJSONRow(
                                 qet, columns, tableWithVocab.localVocab(),
                                 rowIndex, tableWithVocab.idTable())
@@ -505,10 +569,13 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream(
   constexpr auto& escapeFunction = format == MediaType::tsv
                                        ? RdfEscaping::escapeForTsv
                                        : RdfEscaping::escapeForCsv;
+  VocabularyPrefetcher prefetcher{qet.getQec()->getIndex(),
+                                  selectedColumnIndices};
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
     for (uint64_t i : range) {
+      prefetcher(pair.idTable(), i, range.back() + 1);
       for (size_t j = 0; j < selectedColumnIndices.size(); ++j) {
         if (selectedColumnIndices[j].has_value()) {
           const auto& val = selectedColumnIndices[j].value();
@@ -640,10 +707,13 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
   auto selectedColumnIndices =
       qet.selectedVariablesToColumnIndices(selectClause, false);
   // TODO<joka921> we could prefilter for the nonexisting variables.
+  VocabularyPrefetcher prefetcher{qet.getQec()->getIndex(),
+                                  selectedColumnIndices};
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
     for (uint64_t i : range) {
+      prefetcher(pair.idTable(), i, range.back() + 1);
       STREAMABLE_YIELD("\n  <result>");
       for (auto& selectedColIdx : selectedColumnIndices) {
         if (selectedColIdx.has_value()) {
@@ -706,10 +776,12 @@ STREAMABLE_GENERATOR_TYPE ExportQueryExecutionTrees::selectQueryResultToStream<
   // Iterate over the result and yield the bindings. Note that when `columns`
   // is empty, we have to output an empty set of bindings per row.
   bool isFirstRow = true;
+  VocabularyPrefetcher prefetcher{qet.getQec()->getIndex(), columns};
   uint64_t resultSize = 0;
   for (const auto& [pair, range] :
        getRowIndices(limitAndOffset, *result, resultSize)) {
     for (uint64_t i : range) {
+      prefetcher(pair.idTable(), i, range.back() + 1);
       if (!isFirstRow) [[likely]] {
         STREAMABLE_YIELD(",");
       }
@@ -119,6 +119,16 @@ IndexScan::IndexScan(QueryExecutionContext* qec, PermutationPtr permutation,
 
 // _____________________________________________________________________________
 string IndexScan::getCacheKeyImpl() const {
+  auto result = getCacheKeyWithoutColumnSubset();
+  if (varsToKeep_.has_value()) {
+    absl::StrAppend(&result, " column subset ",
+                    absl::StrJoin(getSubsetForStrippedColumns(), ","));
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+string IndexScan::getCacheKeyWithoutColumnSubset() const {
   std::ostringstream os;
   // This string only represents the type of permutation, like "SPO".
   auto permutationString = Permutation::toString(permutation().permutation());
@@ -147,12 +157,17 @@ string IndexScan::getCacheKeyImpl() const {
 
   os << " ";
   graphsToFilter_.format(os, &TripleComponent::toRdfLiteral);
+  return std::move(os).str();
+}
 
-  if (varsToKeep_.has_value()) {
-    os << " column subset "
-       << absl::StrJoin(getSubsetForStrippedColumns(), ",");
+// _____________________________________________________________________________
+std::optional<std::pair<std::string, std::vector<ColumnIndex>>>
+IndexScan::getCacheKeyOfColumnSuperset() const {
+  if (!varsToKeep_.has_value()) {
+    return std::nullopt;
   }
-  return std::move(os).str();
+  return std::pair{getCacheKeyWithoutColumnSubset(),
+                   getSubsetForStrippedColumns()};
 }
 
 // _____________________________________________________________________________
@@ -230,22 +245,59 @@ IndexScan::getUpdatedQueryExecutionTreeWithPrefilterApplied(
   // intersecting its block ranges with the block ranges from the applicable
   // prefilters.
   const auto& [sortedVar, colIndex] = sortedVarAndColIndex.value();
-  auto it =
-      ql::ranges::find(prefilterVariablePairs, sortedVar, ad_utility::second);
+  auto findPrefilter = [&prefilterVariablePairs](const Variable& variable) {
+    return ql::ranges::find(prefilterVariablePairs, variable,
+                            ad_utility::second);
+  };
+  std::optional<ScanSpecAndBlocks> prefiltered;
+  // A prefiltered scan can't be cached, so the zone maps (see below) only
+  // count as a prefilter if they actually remove blocks.
+  bool isPrefiltered = false;
+  auto it = findPrefilter(sortedVar);
   if (it != prefilterVariablePairs.end()) {
+    isPrefiltered = true;
     const auto& blockMetadataRanges =
         prefilterExpressions::detail::logicalOps::getIntersectionOfBlockRanges(
             it->first->evaluate(getLocalVocabContext(),
                                 getScanSpecAndBlocks().getBlockMetadataSpan(),
                                 colIndex),
             scanSpecAndBlocks_.blockMetadata_);
+    prefiltered.emplace(scanSpecAndBlocks_.scanSpec_, blockMetadataRanges);
+  }
 
-    return makeCopyWithPrefilteredScanSpecAndBlocks(
-        {scanSpecAndBlocks_.scanSpec_, blockMetadataRanges});
+  // The blocks are not sorted by the remaining variables, so the prefilters
+  // for these can only be applied via the zone maps of the blocks.
+  const auto& zoneMaps = permutation().zoneMaps();
+  if (zoneMaps.has_value()) {
+    const auto& permutedTriple = getPermutedTriple();
+    for (size_t col = colIndex + 1; col < permutedTriple.size(); ++col) {
+      it = findPrefilter(permutedTriple[col]->getVariable());
+      if (it == prefilterVariablePairs.end()) {
+        continue;
+      }
+      if (!prefiltered.has_value()) {
+        prefiltered = scanSpecAndBlocks_;
+      }
+      const auto& expression = *it->first;
+      auto numBlocks = prefiltered->sizeBlockMetadata_;
+      prefiltered->removeBlocksExcludedByZoneMaps(
+          zoneMaps.value(), col,
+          permutation().getLocatedTriplesForPermutation(locatedTriplesState()),
+          [&expression, this](const ColumnZoneMap& zoneMap) {
+            return expression.mayBeTrueForZoneMap(getLocalVocabContext(),
+                                                  zoneMap);
+          });
+      isPrefiltered =
+          isPrefiltered || prefiltered->sizeBlockMetadata_ < numBlocks;
+    }
   }
 
   // If no prefilter applies, return `std::nullopt`.
-  return std::nullopt;
+  if (!isPrefiltered) {
+    return std::nullopt;
+  }
+  return makeCopyWithPrefilteredScanSpecAndBlocks(
+      std::move(prefiltered.value()));
 }
 
 // _____________________________________________________________________________
@@ -902,6 +954,42 @@ std::unique_ptr<Operation> IndexScan::cloneImpl() const {
       varsToKeep_, sizeEstimateIsExact_, sizeEstimate_);
 }
 
+// _____________________________________________________________________________
+std::shared_ptr<IndexScan> IndexScan::makeCopyWithSubstitutedConstants(
+    QueryExecutionContext* qec,
+    LocatedTriplesSharedState locatedTriplesSharedState,
+    const ad_utility::HashMap<TripleComponent, TripleComponent>&
+        substitutions) const {
+  if (scanSpecAndBlocksIsPrefiltered_) {
+    return nullptr;
+  }
+  auto substitute = [&substitutions](const TripleComponent& tc) {
+    if (tc.isVariable()) {
+      return tc;
+    }
+    auto it = substitutions.find(tc);
+    return it == substitutions.end() ? tc : it->second;
+  };
+  std::vector<std::pair<ColumnIndex, Variable>> additionalScanColumns;
+  for (size_t i = 0; i < additionalColumns_.size(); ++i) {
+    additionalScanColumns.emplace_back(additionalColumns_.at(i),
+                                       additionalVariables_.at(i));
+  }
+  auto copy = std::make_shared<IndexScan>(
+      qec, permutation_, std::move(locatedTriplesSharedState),
+      SparqlTripleSimple{substitute(subject_), substitute(predicate_),
+                         substitute(object_), std::move(additionalScanColumns)},
+      graphsToFilter_, std::nullopt, varsToKeep_);
+  // Keep the `LIMIT`/`OFFSET` and the hidden columns of this scan, as it is
+  // done by `Operation::clone()`.
+  std::vector<Variable> visibleVariables;
+  ql::ranges::copy(getExternallyVisibleVariableColumns() | ql::views::keys,
+                   std::back_inserter(visibleVariables));
+  copy->setSelectedVariablesForSubquery(visibleVariables);
+  copy->setLimitOffsetDirectlyWithoutTriggeringHooks(getLimitOffset());
+  return copy;
+}
+
 // _____________________________________________________________________________
 bool IndexScan::columnOriginatesFromGraphOrUndef(
     const Variable& variable) const {
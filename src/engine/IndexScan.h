@@ -99,7 +99,9 @@ class IndexScan final : public Operation {
 
   // Return a new `QueryExecutionTree` with prefiltered `scanSpecAndBlocks`. If
   // none of the prefilters in `prefilterVariablePairs` applies, return
-  // `std::nullopt`.
+  // `std::nullopt`. A prefilter for the variable by which the scan is sorted is
+  // evaluated on the first and last triple of the blocks, prefilters for the
+  // other variables on the zone maps of the permutation (if present).
   std::optional<std::shared_ptr<QueryExecutionTree>>
   getUpdatedQueryExecutionTreeWithPrefilterApplied(
       const std::vector<PrefilterVariablePair>& prefilterVariablePairs)
@@ -216,6 +218,24 @@ class IndexScan final : public Operation {
   // Retrieve the `Permutation` entity for this `IndexScan`.
   const Permutation& permutation() const;
 
+  // Retrieve the located triples that are used by this `IndexScan`.
+  const LocatedTriplesSharedState& locatedTriplesSharedState() const {
+    return locatedTriplesSharedState_;
+  }
+
+  // Return a copy of this `IndexScan` that uses the `qec` and the
+  // `locatedTriplesSharedState`, and in which each constant subject,
+  // predicate, or object that is a key of `substitutions` is replaced by the
+  // corresponding value. The size estimate is recomputed. Return `nullptr` if
+  // the blocks of this scan have been prefiltered, because the prefiltering
+  // depends on the constants and the located triples. Used by the
+  // `QueryPlanCache` to reuse a query plan for different constants.
+  std::shared_ptr<IndexScan> makeCopyWithSubstitutedConstants(
+      QueryExecutionContext* qec,
+      LocatedTriplesSharedState locatedTriplesSharedState,
+      const ad_utility::HashMap<TripleComponent, TripleComponent>&
+          substitutions) const;
+
  private:
   std::unique_ptr<Operation> cloneImpl() const override;
 
@@ -239,6 +259,15 @@ class IndexScan final : public Operation {
 
   std::string getCacheKeyImpl() const override;
 
+  // The cache key of this `IndexScan` without the column subset of the
+  // `varsToKeep_`, so the cache key of the scan with all columns.
+  std::string getCacheKeyWithoutColumnSubset() const;
+
+  // If columns are stripped, the result can be derived from a cached result of
+  // the same scan with all columns.
+  std::optional<std::pair<std::string, std::vector<ColumnIndex>>>
+  getCacheKeyOfColumnSuperset() const override;
+
   // If `ScanSpecAndBlocks` contains prefiltered `BlockMetadataRanges`, the
   // result of this `IndexScan` shouldn't be cached. Thus, this method returns
   // `false` if prefilterd `BlockMetadataRanges` are contained.
@@ -12,8 +12,10 @@
 #include <absl/strings/str_cat.h>
 
 #include <filesystem>
+#include <future>
 #include <memory>
 #include <nlohmann/json.hpp>
+#include <numeric>
 #include <stdexcept>
 
 #include "engine/IndexScan.h"
@@ -40,7 +42,8 @@ MaterializedViewWriter::MaterializedViewWriter(
     std::string onDiskBase, std::string name,
     const qlever::Qlever::QueryPlan& queryPlan,
     ad_utility::MemorySize memoryLimit,
-    ad_utility::AllocatorWithLimit<Id> allocator)
+    ad_utility::AllocatorWithLimit<Id> allocator,
+    const std::vector<MaterializedViewColumnOrder>& additionalOrders)
     : onDiskBase_{std::move(onDiskBase)},
       name_{std::move(name)},
       memoryLimit_{std::move(memoryLimit)},
@@ -59,16 +62,67 @@ MaterializedViewWriter::MaterializedViewWriter(
   columnPermutation_ = ::ranges::to<std::vector<ColumnIndex>>(
       columnNamesAndPermutation | ql::views::values);
   numAddEmptyColumns_ = numAddEmptyColumns;
+
+  ad_utility::HashSet<std::string> names{name_};
+  for (const auto& order : additionalOrders) {
+    if (!names.insert(order.viewName_).second) {
+      throw std::runtime_error{absl::StrCat(
+          "The name \"", order.viewName_,
+          "\" is used for more than one column order of the materialized "
+          "view \"",
+          name_, "\".")};
+    }
+    additionalOrders_.push_back(makeColumnOrder(order));
+  }
+}
+
+// _____________________________________________________________________________
+auto MaterializedViewWriter::makeColumnOrder(
+    const MaterializedViewColumnOrder& order) const -> ColumnOrder {
+  MaterializedView::throwIfInvalidName(order.viewName_);
+  auto it = ql::ranges::find(columnNames_, order.firstColumn_);
+  if (it == columnNames_.end()) {
+    throw std::runtime_error{absl::StrCat(
+        "The column ", order.firstColumn_.name(),
+        " for the additional column order \"", order.viewName_,
+        "\" is not selected by the query of the materialized view \"", name_,
+        "\".")};
+  }
+  if (it == columnNames_.begin()) {
+    throw std::runtime_error{absl::StrCat(
+        "The column ", order.firstColumn_.name(),
+        " for the additional column order \"", order.viewName_,
+        "\" is already the first column of the materialized view \"", name_,
+        "\".")};
+  }
+  // The `firstColumn_` is moved to the front, the other columns (including the
+  // empty columns at the end) keep their relative order.
+  auto firstColumn = static_cast<ColumnIndex>(it - columnNames_.begin());
+  std::vector<ColumnIndex> columns{firstColumn};
+  for (ColumnIndex col = 0; col < numCols(); ++col) {
+    if (col != firstColumn) {
+      columns.push_back(col);
+    }
+  }
+  return {order.viewName_, std::move(columns)};
 }
 
 // _____________________________________________________________________________
 void MaterializedViewsManager::writeViewToDisk(
     std::string name, const qlever::Qlever::QueryPlan& queryPlan,
     ad_utility::MemorySize memoryLimit,
-    ad_utility::AllocatorWithLimit<Id> allocator) const {
+    ad_utility::AllocatorWithLimit<Id> allocator,
+    const std::vector<MaterializedViewColumnOrder>& additionalOrders) const {
   unloadViewIfLoaded(name);
-  MaterializedViewWriter writer{onDiskBase_, std::move(name), queryPlan,
-                                std::move(memoryLimit), std::move(allocator)};
+  for (const auto& order : additionalOrders) {
+    unloadViewIfLoaded(order.viewName_);
+  }
+  MaterializedViewWriter writer{onDiskBase_,
+                                std::move(name),
+                                queryPlan,
+                                std::move(memoryLimit),
+                                std::move(allocator),
+                                additionalOrders};
   writer.computeResultAndWritePermutation();
 }
 
@@ -79,8 +133,9 @@ std::string MaterializedView::getFilenameBase(std::string_view onDiskBase,
 }
 
 // _____________________________________________________________________________
-std::string MaterializedViewWriter::getFilenameBase() const {
-  return MaterializedView::getFilenameBase(onDiskBase_, name_);
+std::string MaterializedViewWriter::getFilenameBase(
+    std::string_view name) const {
+  return MaterializedView::getFilenameBase(onDiskBase_, name);
 }
 
 // _____________________________________________________________________________
@@ -157,10 +212,23 @@ void MaterializedViewWriter::permuteIdTableAndCheckNoLocalVocabEntries(
   }
 }
 
+// _____________________________________________________________________________
+void MaterializedViewWriter::pushToAdditionalSorters(
+    const IdTable& block, AdditionalSorters& additionalSorters) const {
+  AD_CORRECTNESS_CHECK(additionalSorters.size() == additionalOrders_.size());
+  // The sorters copy the rows anyway, so the columns are only permuted via a
+  // view.
+  for (size_t i = 0; i < additionalOrders_.size(); ++i) {
+    additionalSorters.at(i)->pushBlock(
+        block.asColumnSubsetView(additionalOrders_.at(i).columns_));
+  }
+}
+
 // _____________________________________________________________________________
 MaterializedViewWriter::RangeOfIdTables
 MaterializedViewWriter::getBlocksForAlreadySortedResult(
-    std::shared_ptr<const Result> result) const {
+    std::shared_ptr<const Result> result,
+    AdditionalSorters& additionalSorters) const {
   // Results are already sorted correctly: we do not need to invoke the
   // external sorter, but we still need to permute the `IdTable`s to the
   // desired column ordering and construct a range for the
@@ -173,6 +241,7 @@ MaterializedViewWriter::getBlocksForAlreadySortedResult(
     // necessary modifications (permuting columns).
     IdTable idTableCopyForPermutation = result->idTable().clone();
     permuteIdTableAndCheckNoLocalVocabEntries(idTableCopyForPermutation);
+    pushToAdditionalSorters(idTableCopyForPermutation, additionalSorters);
     std::vector<IdTableStatic<0>> singleIdTable;
     singleIdTable.push_back(std::move(idTableCopyForPermutation));
     return RangeOfIdTables{std::move(singleIdTable)};
@@ -184,6 +253,7 @@ MaterializedViewWriter::getBlocksForAlreadySortedResult(
             [&](auto& idTableAndLocalVocab) -> IdTableStatic<0> {
               auto& [block, vocab] = idTableAndLocalVocab;
               permuteIdTableAndCheckNoLocalVocabEntries(block);
+              pushToAdditionalSorters(block, additionalSorters);
               return std::move(block);
             })};
   }
@@ -192,7 +262,8 @@ MaterializedViewWriter::getBlocksForAlreadySortedResult(
 // _____________________________________________________________________________
 MaterializedViewWriter::RangeOfIdTables
 MaterializedViewWriter::getBlocksForUnsortedResult(
-    Sorter& spoSorter, std::shared_ptr<const Result> result) const {
+    Sorter& spoSorter, std::shared_ptr<const Result> result,
+    AdditionalSorters& additionalSorters) const {
   // Results are not yet sorted by the required columns. Sort results
   // externally.
   AD_LOG_INFO << "Sorting query result rows for materialized view \"" << name_
@@ -204,6 +275,7 @@ MaterializedViewWriter::getBlocksForUnsortedResult(
     permuteIdTableAndCheckNoLocalVocabEntries(block);
     totalTriples += block.numRows();
     spoSorter.pushBlock(block);
+    pushToAdditionalSorters(block, additionalSorters);
     if (progressBar.update()) {
       AD_LOG_INFO << progressBar.getProgressString() << std::flush;
     }
@@ -231,7 +303,8 @@ MaterializedViewWriter::getBlocksForUnsortedResult(
 
 // _____________________________________________________________________________
 MaterializedViewWriter::RangeOfIdTables MaterializedViewWriter::getSortedBlocks(
-    Sorter& spoSorter, std::shared_ptr<const Result> result) const {
+    Sorter& spoSorter, std::shared_ptr<const Result> result,
+    AdditionalSorters& additionalSorters) const {
   // Check if the query result is already sorted by SPO considering the target
   // column ordering
   constexpr size_t numSortedColumns = 3;
@@ -243,19 +316,19 @@ MaterializedViewWriter::RangeOfIdTables MaterializedViewWriter::getSortedBlocks(
   // Either call the version that only permutes the correctly sorted blocks or
   // the version that sorts them.
   if (isAlreadySorted) {
-    return getBlocksForAlreadySortedResult(result);
+    return getBlocksForAlreadySortedResult(result, additionalSorters);
   } else {
-    return getBlocksForUnsortedResult(spoSorter, result);
+    return getBlocksForUnsortedResult(spoSorter, result, additionalSorters);
   }
 }
 
 // _____________________________________________________________________________
 IndexMetaDataMmap MaterializedViewWriter::writePermutation(
-    RangeOfIdTables sortedBlocksSPO) const {
-  std::string spoFilename = getFilenameBase() + ".index.spo";
+    std::string_view name, RangeOfIdTables sortedBlocksSPO) const {
+  std::string spoFilename = getFilenameBase(name) + ".index.spo";
   auto spoWriter = std::make_unique<CompressedRelationWriter>(
       numCols(), ad_utility::File{spoFilename, "w"},
-      UNCOMPRESSED_BLOCKSIZE_COMPRESSED_METADATA_PER_COLUMN);
+      UNCOMPRESSED_BLOCKSIZE_COMPRESSED_METADATA_PER_COLUMN, true);
 
   qlever::KeyOrder spoKeyOrder{0, 1, 2, 3};
   IndexMetaDataMmap spoMetaData;
@@ -276,7 +349,7 @@ IndexMetaDataMmap MaterializedViewWriter::writePermutation(
   AD_LOG_DEBUG << "Writing metadata ..." << std::endl;
   spoMetaData.blockData() = std::move(blockData);
   spoMetaData.calculateStatistics(numDistinctPredicates);
-  spoMetaData.setName(getFilenameBase());
+  spoMetaData.setName(getFilenameBase(name));
   {
     ad_utility::File spoFile(spoFilename, "r+");
     spoMetaData.appendToFile(&spoFile);
@@ -286,13 +359,19 @@ IndexMetaDataMmap MaterializedViewWriter::writePermutation(
 }
 
 // _____________________________________________________________________________
-void MaterializedViewWriter::writeViewMetadata() const {
-  // Export column names to view info JSON file.
+void MaterializedViewWriter::writeViewMetadata(
+    std::string_view name, const std::vector<ColumnIndex>& columns) const {
+  // Export column names to view info JSON file. The empty columns at the end
+  // have no names.
   const auto& varToCol = qet_->getVariableColumns();
+  auto namedColumns = columns | ql::views::filter([this](ColumnIndex col) {
+                        return col < columnNames_.size();
+                      });
   nlohmann::json viewInfo = {
       {"version", MATERIALIZED_VIEWS_VERSION},
       {"columns",
-       (columnNames_ | ql::views::transform([&varToCol](const Variable& v) {
+       (namedColumns | ql::views::transform([&](ColumnIndex col) {
+          const Variable& v = columnNames_.at(col);
           return nlohmann::json{
               {"name", v.name()},
               {"always_defined",
@@ -301,10 +380,25 @@ void MaterializedViewWriter::writeViewMetadata() const {
         }) |
         ::ranges::to<std::vector<nlohmann::json>>())},
       {"query", parsedQuery_._originalString}};
-  ad_utility::makeOfstream(getFilenameBase() + ".viewinfo.json")
+  ad_utility::makeOfstream(getFilenameBase(name) + ".viewinfo.json")
       << viewInfo.dump() << std::endl;
 }
 
+// _____________________________________________________________________________
+void MaterializedViewWriter::writeView(std::string_view name,
+                                       const std::vector<ColumnIndex>& columns,
+                                       RangeOfIdTables sortedBlocksSPO) const {
+  AD_LOG_INFO << "Writing materialized view \"" << name << "\" to disk ..."
+              << std::endl;
+  auto spoMetaData = writePermutation(name, std::move(sortedBlocksSPO));
+  writeViewMetadata(name, columns);
+
+  AD_LOG_INFO << "Statistics for view \"" << name
+              << "\": " << spoMetaData.statistics() << std::endl;
+  AD_LOG_INFO << "Materialized view \"" << name << "\" written to disk"
+              << std::endl;
+}
+
 // _____________________________________________________________________________
 void MaterializedViewWriter::computeResultAndWritePermutation() const {
   // Run query and sort the result externally (only if necessary).
@@ -313,20 +407,45 @@ void MaterializedViewWriter::computeResultAndWritePermutation() const {
               << std::endl;
   auto result = qet_->getResult(true);
 
+  // Each column order has its own sorter, which all get their share of the
+  // memory. The sorters of the additional column orders are filled while the
+  // blocks for the main view are computed, s.t. the query result is computed
+  // only once.
+  auto sorterMemory = memoryLimit_ / (additionalOrders_.size() + 1);
+  AdditionalSorters additionalSorters;
+  for (const auto& order : additionalOrders_) {
+    additionalSorters.push_back(std::make_unique<Sorter>(
+        getFilenameBase(order.name_) + ".spo-sorter.dat", numCols(),
+        sorterMemory, allocator_));
+  }
   Sorter spoSorter{getFilenameBase() + ".spo-sorter.dat", numCols(),
-                   memoryLimit_, allocator_};
-  RangeOfIdTables sortedBlocksSPO = getSortedBlocks(spoSorter, result);
+                   sorterMemory, allocator_};
+  RangeOfIdTables sortedBlocksSPO =
+      getSortedBlocks(spoSorter, result, additionalSorters);
 
   // Write compressed relation to disk.
-  AD_LOG_INFO << "Writing materialized view \"" << name_ << "\" to disk ..."
-              << std::endl;
-  auto spoMetaData = writePermutation(std::move(sortedBlocksSPO));
-  writeViewMetadata();
-
-  AD_LOG_INFO << "Statistics for view \"" << name_
-              << "\": " << spoMetaData.statistics() << std::endl;
-  AD_LOG_INFO << "Materialized view \"" << name_ << "\" written to disk"
-              << std::endl;
+  std::vector<ColumnIndex> columns(numCols());
+  std::iota(columns.begin(), columns.end(), ColumnIndex{0});
+  writeView(name_, columns, std::move(sortedBlocksSPO));
+
+  // Now all the rows have been pushed to the additional sorters. Their views
+  // are independent of each other and are therefore written concurrently (the
+  // `CompressedRelationWriter` of each view additionally compresses its blocks
+  // in parallel).
+  std::vector<std::future<void>> futures;
+  for (size_t i = 0; i < additionalOrders_.size(); ++i) {
+    futures.push_back(std::async(std::launch::async, [this, i,
+                                                      &additionalSorters]() {
+      const auto& order = additionalOrders_.at(i);
+      writeView(order.name_, order.columns_,
+                additionalSorters.at(i)->template getSortedBlocks<0>());
+    }));
+  }
+  // NOTE: If one of the views fails, the destructors of the remaining
+  // `futures` wait for the other views, before the sorters are destroyed.
+  for (auto& future : futures) {
+    future.get();
+  }
 }
 
 // _____________________________________________________________________________
@@ -344,8 +463,7 @@ const Variable& MaterializedView::dummyObject() {
 // _____________________________________________________________________________
 MaterializedView::MaterializedView(std::string onDiskBase, std::string name)
     : onDiskBase_{std::move(onDiskBase)},
-      name_{std::move(name)},
-      locatedTriplesState_{makeEmptyLocatedTriplesState()} {
+      name_{std::move(name)} {
   AD_CORRECTNESS_CHECK(onDiskBase_ != "",
                        "The index base filename was not set.");
   throwIfInvalidName(name_);
@@ -426,6 +544,7 @@ MaterializedView::MaterializedView(std::string onDiskBase, std::string name)
                              Permutation::Type::MATERIALIZED_VIEW,
                              std::move(possiblyUndefinedColumns));
   AD_CORRECTNESS_CHECK(permutation_->isLoaded());
+  updates_.wlock()->locatedTriplesState_ = makeEmptyLocatedTriplesState();
 }
 
 // _____________________________________________________________________________
@@ -643,7 +762,92 @@ void MaterializedViewsManager::setOnDiskBase(const std::string& onDiskBase) {
 
 // _____________________________________________________________________________
 LocatedTriplesSharedState MaterializedView::locatedTriplesState() const {
-  return {locatedTriplesState_};
+  return {updates_.rlock()->locatedTriplesState_};
+}
+
+// _____________________________________________________________________________
+bool MaterializedView::isStale() const { return updates_.rlock()->isStale_; }
+
+// _____________________________________________________________________________
+void MaterializedView::markStale(std::string_view reason) {
+  markStale(*updates_.wlock(), reason);
+}
+
+// _____________________________________________________________________________
+void MaterializedView::markStale(Updates& updates,
+                                 std::string_view reason) const {
+  if (updates.isStale_) {
+    return;
+  }
+  updates.isStale_ = true;
+  AD_LOG_INFO << "The materialized view '" << name_
+              << "' is stale and will no longer be used for query rewriting: "
+              << reason << "." << std::endl;
+}
+
+// _____________________________________________________________________________
+bool MaterializedView::updateAfterDeltaTriplesChange(
+    const IndexImpl& index, const LocatedTriplesState& before,
+    const LocatedTriplesState& after,
+    ql::span<const IdTriple<>> changedTriples,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) {
+  auto lock = updates_.wlock();
+  if (lock->isStale_) {
+    return false;
+  }
+  if (!lock->maintenancePlan_.has_value()) {
+    if (parsedQuery_.has_value()) {
+      lock->maintenancePlan_ =
+          materializedViewsMaintenance::ViewMaintenancePlan::make(
+              name_, parsedQuery_.value(), varToColMap_, index);
+    }
+    if (!lock->maintenancePlan_.has_value()) {
+      markStale(*lock, "it cannot be maintained incrementally");
+      return false;
+    }
+  }
+  auto delta = lock->maintenancePlan_.value().computeDelta(
+      index, before, after, changedTriples, cancellationHandle);
+  if (delta.rowsToInsert_.empty() && delta.rowsToDelete_.empty()) {
+    return true;
+  }
+
+  // Only apply the delta to a copy of the located triples of the view's
+  // permutation (the copy shares all blocks that are not changed, see
+  // `LocatedTriplesPerBlock`). The located triples are only located in the
+  // (single) SPO permutation of the view. Rows that are inserted after they
+  // were deleted (or the other way around) cancel out, s.t. the rows are
+  // always relative to the view on disk.
+  auto state =
+      std::make_shared<LocatedTriplesState>(*lock->locatedTriplesState_);
+  auto& locatedTriples = state->getLocatedTriplesForPermutation<false>(
+      permutation_->permutation());
+  auto apply = [&](const std::vector<materializedViewsMaintenance::ViewRow>&
+                       rows,
+                   auto& sameSet, auto& oppositeSet, bool insertOrDelete) {
+    auto located = LocatedTriple::locateTriplesInPermutation(
+        rows, permutation_->metaData().blockData(), permutation_->keyOrder(),
+        insertOrDelete, cancellationHandle);
+    std::vector<LocatedTriple> locatedToAdd;
+    for (size_t i = 0; i < rows.size(); ++i) {
+      if (oppositeSet.erase(rows[i])) {
+        locatedTriples.erase(located[i].blockIndex_, located[i].triple_);
+      } else if (sameSet.insert(rows[i]).second) {
+        locatedToAdd.push_back(std::move(located[i]));
+      }
+    }
+    locatedTriples.add(locatedToAdd);
+  };
+  apply(delta.rowsToInsert_, lock->insertedRows_, lock->deletedRows_, true);
+  apply(delta.rowsToDelete_, lock->deletedRows_, lock->insertedRows_, false);
+  locatedTriples.updateAugmentedMetadata();
+  // The inserted rows may contain entries of the local vocab of the
+  // `DeltaTriples`, which only grows until the delta triples are cleared (then
+  // the views are marked as stale).
+  state->localVocabLifetimeExtender_ = after.localVocabLifetimeExtender_;
+  state->index_ = after.index_;
+  lock->locatedTriplesState_ = std::move(state);
+  return true;
 }
 
 // _____________________________________________________________________________
@@ -674,9 +878,44 @@ std::shared_ptr<IndexScan> MaterializedView::makeIndexScan(
   // query.
   auto scanTriple = makeScanConfig(viewQuery);
   return std::make_shared<IndexScan>(
-      qec, permutation_, LocatedTriplesSharedState{locatedTriplesState_},
-      std::move(scanTriple), IndexScan::Graphs::All(), std::nullopt,
-      viewQuery.getVarsToKeep());
+      qec, permutation_, locatedTriplesState(), std::move(scanTriple),
+      IndexScan::Graphs::All(), std::nullopt, viewQuery.getVarsToKeep());
+}
+
+// _____________________________________________________________________________
+bool MaterializedViewsManager::hasViewsToMaintain() const {
+  return ql::ranges::any_of(loadedViews_.rlock()->views_, [](const auto& p) {
+    return !p.second->isStale();
+  });
+}
+
+// _____________________________________________________________________________
+void MaterializedViewsManager::updateViewsAfterDeltaTriplesChange(
+    const IndexImpl& index, const LocatedTriplesState& before,
+    const LocatedTriplesState& after,
+    ql::span<const IdTriple<>> changedTriples,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) const {
+  auto lock = loadedViews_.wlock();
+  for (const auto& [name, view] : lock->views_) {
+    if (view->isStale()) {
+      continue;
+    }
+    if (!view->updateAfterDeltaTriplesChange(index, before, after,
+                                             changedTriples,
+                                             cancellationHandle)) {
+      lock->queryPatternCache_.removeView(view);
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void MaterializedViewsManager::markAllViewsStale(
+    std::string_view reason) const {
+  auto lock = loadedViews_.wlock();
+  for (const auto& [name, view] : lock->views_) {
+    view->markStale(reason);
+    lock->queryPatternCache_.removeView(view);
+  }
 }
 
 // _____________________________________________________________________________
@@ -688,6 +927,13 @@ MaterializedViewsManager::makeJoinReplacementIndexScans(
       qec, triples);
 }
 
+// _____________________________________________________________________________
+std::optional<ParsedQuery> MaterializedViewsManager::makeAggregateRewrite(
+    QueryExecutionContext* qec, const ParsedQuery& query) const {
+  return loadedViews_.rlock()->queryPatternCache_.makeAggregateRewrite(qec,
+                                                                       query);
+}
+
 // _____________________________________________________________________________
 std::shared_ptr<IndexScan> MaterializedViewsManager::makeIndexScan(
     QueryExecutionContext* qec,
@@ -12,6 +12,7 @@
 
 #include <gtest/gtest_prod.h>
 
+#include "engine/MaterializedViewsMaintenance.h"
 #include "engine/MaterializedViewsQueryAnalysis.h"
 #include "engine/VariableToColumnMap.h"
 #include "engine/idTable/CompressedExternalIdTable.h"
@@ -36,9 +37,21 @@ class IndexScan;
 // cleanly without breaking the entire index format.
 static constexpr size_t MATERIALIZED_VIEWS_VERSION = 1;
 
+// An additional column order in which the rows of a materialized view are
+// written (see `MaterializedViewsManager::writeViewToDisk`). The rows are
+// written once more as a separate view with the name `viewName_`, which has
+// the `firstColumn_` as its first column (followed by the remaining columns in
+// their original order), s.t. the rows can also be scanned efficiently by this
+// column.
+struct MaterializedViewColumnOrder {
+  std::string viewName_;
+  Variable firstColumn_;
+};
+
 // The `MaterializedViewWriter` can be used to write a new materialized view to
 // disk, given an already planned query. The query will be executed lazily and
-// the results will be written to the view.
+// the results will be written to the view. Optionally, the same rows can be
+// written in additional column orders in the same pass.
 class MaterializedViewWriter {
  private:
   // Filename components for writing the view to disk.
@@ -67,26 +80,43 @@ class MaterializedViewWriter {
   // resulting table has at least four columns.
   uint8_t numAddEmptyColumns_;
 
+  // The additional column orders of the view. The `columns_` are the
+  // permutation that is applied to the (already permuted) rows of the view.
+  struct ColumnOrder {
+    std::string name_;
+    std::vector<ColumnIndex> columns_;
+  };
+  std::vector<ColumnOrder> additionalOrders_;
+
   using RangeOfIdTables = ad_utility::InputRangeTypeErased<IdTableStatic<0>>;
   // SPO comparator
   using Comparator = SortTriple<0, 1, 2>;
   // Sorter for SPO permutation with a dynamic number of columns (template
   // argument `NumStaticCols == 0`)
   using Sorter = ad_utility::CompressedExternalIdTableSorter<Comparator, 0>;
+  // One sorter for each of the `additionalOrders_`.
+  using AdditionalSorters = std::vector<std::unique_ptr<Sorter>>;
 
   using QueryPlan = qlever::QueryPlan;
 
   // Initialize a writer given the base filename of the view and a query plan.
   // The view will be written to files prefixed with the index basename followed
   // by the view name.
-  MaterializedViewWriter(std::string onDiskBase, std::string name,
-                         const QueryPlan& queryPlan,
-                         ad_utility::MemorySize memoryLimit,
-                         ad_utility::AllocatorWithLimit<Id> allocator);
-
-  // Get the base filename for the view's permutation and metadata files. This
-  // name is the result of concatenating `onDiskBase` and `name`.
-  std::string getFilenameBase() const;
+  MaterializedViewWriter(
+      std::string onDiskBase, std::string name, const QueryPlan& queryPlan,
+      ad_utility::MemorySize memoryLimit,
+      ad_utility::AllocatorWithLimit<Id> allocator,
+      const std::vector<MaterializedViewColumnOrder>& additionalOrders = {});
+
+  // Get the base filename for the permutation and metadata files of the view
+  // with the given `name` (the main view or one of its additional column
+  // orders). This name is the result of concatenating `onDiskBase` and `name`.
+  std::string getFilenameBase(std::string_view name) const;
+  std::string getFilenameBase() const { return getFilenameBase(name_); }
+
+  // Helper for the constructor: compute the `ColumnOrder` of the view with the
+  // given `order`.
+  ColumnOrder makeColumnOrder(const MaterializedViewColumnOrder& order) const;
 
   // Helper that computes the column ordering how the `IdTable`s from executing
   // the `QueryExecutionTree` must be permuted to match the requested target
@@ -108,35 +138,56 @@ class MaterializedViewWriter {
   // that there are no `LocalVocabEntry` values in any of the selected columns.
   void permuteIdTableAndCheckNoLocalVocabEntries(IdTable& block) const;
 
+  // Push the (already permuted) `block` to the `additionalSorters`, each in
+  // the column order of the corresponding entry of `additionalOrders_`.
+  void pushToAdditionalSorters(const IdTable& block,
+                               AdditionalSorters& additionalSorters) const;
+
   // Helper for `computeResultAndWritePermutation`: If the query given by the
   // user is already sorted correctly, this function can be used to obtain the
-  // permuted blocks.
+  // permuted blocks. The blocks are pushed to the `additionalSorters` while
+  // the returned range is consumed.
   RangeOfIdTables getBlocksForAlreadySortedResult(
-      std::shared_ptr<const Result> result) const;
+      std::shared_ptr<const Result> result,
+      AdditionalSorters& additionalSorters) const;
 
   // Helper for `computeResultAndWritePermutation`: If the query given by the
   // user is not sorted correctly, this function can be used to invoke the
-  // external sorted and obtain sorted and correctly permuted blocks.
+  // external sorted and obtain sorted and correctly permuted blocks. The
+  // blocks are also pushed to the `additionalSorters`.
   RangeOfIdTables getBlocksForUnsortedResult(
-      Sorter& spoSorter, std::shared_ptr<const Result> result) const;
+      Sorter& spoSorter, std::shared_ptr<const Result> result,
+      AdditionalSorters& additionalSorters) const;
 
   // Helper for `computeResultAndWritePermutation`: Checks if the result is
   // correctly sorted and invokes `getBlocksForAlreadySortedResult` or
   // `getBlocksForUnsortedResult` accordingly.
   RangeOfIdTables getSortedBlocks(Sorter& spoSorter,
-                                  std::shared_ptr<const Result> result) const;
+                                  std::shared_ptr<const Result> result,
+                                  AdditionalSorters& additionalSorters) const;
 
   // Helper for `computeResultAndWritePermutation`: given sorted and permuted
-  // blocks from `getSortedBlocks`, write the `Permutation` to disk using
-  // `CompressedRelationWriter`. Returns the permutation metadata.
-  IndexMetaDataMmap writePermutation(RangeOfIdTables sortedBlocksSPO) const;
+  // blocks from `getSortedBlocks`, write the `Permutation` of the view with
+  // the given `name` to disk using `CompressedRelationWriter`. Returns the
+  // permutation metadata.
+  IndexMetaDataMmap writePermutation(std::string_view name,
+                                     RangeOfIdTables sortedBlocksSPO) const;
 
   // Helper for `computeResultAndWritePermutation`: Writes the metadata JSON
-  // files with column names and ordering to disk.
-  void writeViewMetadata() const;
+  // files with column names and ordering of the view with the given `name`
+  // to disk. The `columns` are the column order of the view.
+  void writeViewMetadata(std::string_view name,
+                         const std::vector<ColumnIndex>& columns) const;
+
+  // Helper for `computeResultAndWritePermutation`: Write the permutation and
+  // the metadata of the view with the given `name` and column order.
+  void writeView(std::string_view name, const std::vector<ColumnIndex>& columns,
+                 RangeOfIdTables sortedBlocksSPO) const;
 
   // Actually computes, permutes and if needed externally sorts the query result
-  // and writes the view (SPO permutation and metadata) to disk.
+  // and writes the view (SPO permutation and metadata) to disk. The query
+  // result is computed only once, also if there are additional column orders.
+  // Their permutations are written concurrently after the main view.
   void computeResultAndWritePermutation() const;
 
   friend MaterializedViewsManager;
@@ -151,7 +202,6 @@ class MaterializedView : public std::enable_shared_from_this<MaterializedView> {
   std::shared_ptr<Permutation> permutation_{std::make_shared<Permutation>(
       Permutation::Enum::SPO, ad_utility::makeUnlimitedAllocator<Id>(), name_)};
   VariableToColumnMap varToColMap_;
-  std::shared_ptr<LocatedTriplesState> locatedTriplesState_;
   std::optional<std::string> originalQuery_;
   std::optional<ParsedQuery> parsedQuery_;
 
@@ -160,12 +210,30 @@ class MaterializedView : public std::enable_shared_from_this<MaterializedView> {
   // the target column index.
   materializedViewsQueryAnalysis::BindExpressionAndTargetCol coveredBinds_;
 
+  // The changes of the view by SPARQL UPDATEs since it was loaded, relative to
+  // the view on disk, and the resulting located triples of its permutation.
+  struct Updates {
+    std::shared_ptr<LocatedTriplesState> locatedTriplesState_;
+    materializedViewsMaintenance::ViewRows insertedRows_;
+    materializedViewsMaintenance::ViewRows deletedRows_;
+    // The plan for the incremental maintenance, computed on the first update.
+    std::optional<materializedViewsMaintenance::ViewMaintenancePlan>
+        maintenancePlan_;
+    // A stale view is no longer maintained. It keeps the state of the last
+    // update that could be applied.
+    bool isStale_ = false;
+  };
+  ad_utility::Synchronized<Updates> updates_;
+
   using AdditionalScanColumns = SparqlTripleSimple::AdditionalScanColumns;
 
-  // Helper to create an empty `LocatedTriplesState` for `IndexScan`s as
-  // materialized views do not support updates yet.
+  // Helper to create a `LocatedTriplesState` without located triples, but with
+  // the correct metadata of the view's permutation.
   std::shared_ptr<LocatedTriplesState> makeEmptyLocatedTriplesState() const;
 
+  // Mark the view as stale (the lock on `updates_` must be held).
+  void markStale(Updates& updates, std::string_view reason) const;
+
   FRIEND_TEST(MaterializedViewsTest, ManualConfigurations);
 
  public:
@@ -205,11 +273,27 @@ class MaterializedView : public std::enable_shared_from_this<MaterializedView> {
   // `nullptr`.
   std::shared_ptr<const Permutation> permutation() const;
 
-  // Return a reference to the `LocatedTriplesSnapshot` for the permutation. For
-  // now this is always an empty snapshot but with the correct permutation
-  // metadata.
+  // Return a reference to the `LocatedTriplesSnapshot` for the permutation. It
+  // contains the rows that were inserted into or deleted from the view by
+  // SPARQL UPDATEs since the view was loaded (see
+  // `updateAfterDeltaTriplesChange`).
   LocatedTriplesSharedState locatedTriplesState() const;
 
+  // Update the view after the delta triples of the `index` changed from the
+  // state `before` to the state `after` by inserting or deleting the
+  // `changedTriples`. If the view cannot be maintained incrementally, it is
+  // marked as stale instead. Return `false` iff the view is stale.
+  bool updateAfterDeltaTriplesChange(
+      const IndexImpl& index, const LocatedTriplesState& before,
+      const LocatedTriplesState& after,
+      ql::span<const IdTriple<>> changedTriples,
+      const ad_utility::SharedCancellationHandle& cancellationHandle);
+
+  // A stale view no longer reflects the current state of the index. It can
+  // still be scanned explicitly, but it is not used for query rewriting.
+  bool isStale() const;
+  void markStale(std::string_view reason);
+
   // Checks if the given name is allowed for a materialized view. Currently only
   // alphanumerics and hyphens are allowed. This is relevant for safe filenames
   // and for correctly splitting the special predicate.
@@ -311,6 +395,23 @@ class MaterializedViewsManager {
       QueryExecutionContext* qec,
       const parsedQuery::MaterializedViewQuery& viewQuery) const;
 
+  // Return true iff at least one of the loaded views is not stale and
+  // therefore has to be updated when the delta triples change.
+  bool hasViewsToMaintain() const;
+
+  // Update all loaded views that are not stale after the delta triples of the
+  // `index` changed (see `MaterializedView::updateAfterDeltaTriplesChange`).
+  // Views that become stale are no longer used for query rewriting.
+  void updateViewsAfterDeltaTriplesChange(
+      const IndexImpl& index, const LocatedTriplesState& before,
+      const LocatedTriplesState& after,
+      ql::span<const IdTriple<>> changedTriples,
+      const ad_utility::SharedCancellationHandle& cancellationHandle) const;
+
+  // Mark all loaded views as stale, for example after all delta triples were
+  // removed.
+  void markAllViewsStale(std::string_view reason) const;
+
   // Given a set of triples, check if some join operations that would be
   // required when evaluating them can be replaced by scans on materialized
   // views that are currently loaded. This is implemented using the
@@ -319,6 +420,12 @@ class MaterializedViewsManager {
       QueryExecutionContext* qec,
       const parsedQuery::BasicGraphPattern& triples) const;
 
+  // Check if the `query` can be answered by re-aggregating one of the views
+  // that are currently loaded and store pre-aggregated results. If yes, return
+  // the rewritten query. This is implemented using the `queryPatternCache_`.
+  std::optional<ParsedQuery> makeAggregateRewrite(
+      QueryExecutionContext* qec, const ParsedQuery& query) const;
+
   // Write a `MaterializedView` given a valid `name` (consisting only of
   // alphanumerics and hyphens) and a `queryPlan` to be executed. The query's
   // result is written to the view.
@@ -329,11 +436,17 @@ class MaterializedViewsManager {
   // The `memoryLimit` and `allocator` are used only for sorting the
   // permutation if the query result is not correctly sorted already. The
   // `queryPlan` is executed with the normal query memory limit.
+  //
+  // For each of the `additionalOrders`, the same rows are written to another
+  // view with the first column of the order (see `MaterializedViewColumnOrder`)
+  // in the same pass. The `memoryLimit` is then split between the sorters.
   void writeViewToDisk(
       std::string name, const qlever::QueryPlan& queryPlan,
       ad_utility::MemorySize memoryLimit = ad_utility::MemorySize::gigabytes(4),
       ad_utility::AllocatorWithLimit<Id> allocator =
-          ad_utility::makeUnlimitedAllocator<Id>()) const;
+          ad_utility::makeUnlimitedAllocator<Id>(),
+      const std::vector<MaterializedViewColumnOrder>& additionalOrders =
+          {}) const;
 };
 
 #endif  // QLEVER_SRC_ENGINE_MATERIALIZEDVIEWS_H_
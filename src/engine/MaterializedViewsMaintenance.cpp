@@ -0,0 +1,289 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/MaterializedViewsMaintenance.h"
+
+#include <absl/strings/str_cat.h>
+
+#include "backports/StartsWithAndEndsWith.h"
+#include "backports/algorithm.h"
+#include "global/Constants.h"
+#include "index/IndexImpl.h"
+#include "index/Permutation.h"
+#include "index/ScanSpecification.h"
+#include "parser/GraphPatternOperation.h"
+#include "util/Exception.h"
+#include "util/Log.h"
+#include "util/Views.h"
+
+namespace materializedViewsMaintenance {
+
+// _____________________________________________________________________________
+std::optional<ViewMaintenancePlan> ViewMaintenancePlan::make(
+    std::string_view viewName, const ParsedQuery& query,
+    const VariableToColumnMap& columns, const IndexImpl& index) {
+  auto notMaintainable = [&viewName](std::string_view reason)
+      -> std::optional<ViewMaintenancePlan> {
+    AD_LOG_INFO << "The materialized view '" << viewName
+                << "' cannot be maintained incrementally under updates, "
+                << "because " << reason << "." << std::endl;
+    return std::nullopt;
+  };
+
+  // The query must be a plain join of the triples of a single basic graph
+  // pattern.
+  if (!query.hasSelectClause() || !query.selectClause().getAliases().empty()) {
+    return notMaintainable("its query is not a SELECT query without aliases");
+  }
+  const auto& rootPattern = query._rootGraphPattern;
+  if (rootPattern._graphPatterns.size() != 1 ||
+      !std::holds_alternative<parsedQuery::BasicGraphPattern>(
+          rootPattern._graphPatterns.at(0)) ||
+      !rootPattern._filters.empty()) {
+    return notMaintainable(
+        "its query does not consist of a single basic graph pattern");
+  }
+  if (!query._groupByVariables.empty() || !query._havingClauses.empty() ||
+      !query._limitOffset.isUnconstrained() ||
+      query.datasetClauses_.activeDefaultGraphs().has_value()) {
+    return notMaintainable(
+        "its query has a GROUP BY, HAVING, LIMIT, OFFSET, or FROM clause");
+  }
+  // The located triples of the view's permutation can only store four
+  // columns.
+  if (columns.size() > ViewRow::NumCols) {
+    return notMaintainable(absl::StrCat("it has more than ", ViewRow::NumCols,
+                                        " columns"));
+  }
+
+  const auto& triples = rootPattern._graphPatterns.at(0).getBasic()._triples;
+  std::vector<Pattern> patterns;
+  ad_utility::HashSet<Variable> variablesInPattern;
+  for (const auto& triple : triples) {
+    auto predicate = triple.getSimplePredicate();
+    if (!predicate.has_value() && !triple.getPredicateVariable()) {
+      return notMaintainable("its query contains a property path");
+    }
+    if (predicate.has_value() &&
+        ql::starts_with(predicate.value(),
+                        QLEVER_INTERNAL_PREFIX_IRI_WITHOUT_CLOSING_BRACKET)) {
+      return notMaintainable("its query contains a special predicate");
+    }
+    auto simpleTriple = triple.getSimple();
+    Pattern pattern;
+    std::array components{&simpleTriple.s_, &simpleTriple.p_, &simpleTriple.o_};
+    for (auto [position, component] : ::ranges::views::enumerate(components)) {
+      if (component->isVariable()) {
+        const auto& variable = component->getVariable();
+        auto column = columns.find(variable);
+        if (column == columns.end()) {
+          return notMaintainable(absl::StrCat("the variable ", variable.name(),
+                                              " is not selected"));
+        }
+        variablesInPattern.insert(variable);
+        pattern[position] = column->second.columnIndex_;
+      } else {
+        auto id = component->toValueId(index);
+        if (!id.has_value()) {
+          return notMaintainable(absl::StrCat(
+              component->toString(), " is not contained in the vocabulary"));
+        }
+        pattern[position] = id.value();
+      }
+    }
+    patterns.push_back(pattern);
+  }
+  if (patterns.empty() || variablesInPattern.size() != columns.size()) {
+    return notMaintainable(
+        "not all of its columns are bound by the basic graph pattern");
+  }
+  return ViewMaintenancePlan{std::move(patterns), columns.size()};
+}
+
+// _____________________________________________________________________________
+auto ViewMaintenancePlan::initialBinding() const -> Binding {
+  Binding binding;
+  for (size_t i = numColumns_; i < binding.size(); ++i) {
+    binding[i] = Id::makeUndefined();
+  }
+  return binding;
+}
+
+// _____________________________________________________________________________
+auto ViewMaintenancePlan::unify(const Pattern& pattern,
+                                const std::array<Id, 3>& triple,
+                                Binding binding) -> std::optional<Binding> {
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    if (const Id* id = std::get_if<Id>(&pattern[i])) {
+      if (*id != triple[i]) {
+        return std::nullopt;
+      }
+      continue;
+    }
+    auto& value = binding.at(std::get<ColumnIndex>(pattern[i]));
+    if (value.has_value() && value.value() != triple[i]) {
+      return std::nullopt;
+    }
+    value = triple[i];
+  }
+  return binding;
+}
+
+// _____________________________________________________________________________
+std::vector<std::array<Id, 3>> ViewMaintenancePlan::scanPattern(
+    const IndexImpl& index, const LocatedTriplesState& state,
+    const Pattern& pattern, const Binding& binding,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) {
+  // The `Id`s that are fixed for the scan, either by the pattern or by the
+  // `binding`.
+  std::array<std::optional<Id>, 3> fixed;
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    if (const Id* id = std::get_if<Id>(&pattern[i])) {
+      fixed[i] = *id;
+    } else {
+      fixed[i] = binding.at(std::get<ColumnIndex>(pattern[i]));
+    }
+  }
+
+  // Use the loaded permutation where the longest prefix of the key is fixed.
+  const Permutation* bestPermutation = nullptr;
+  size_t bestPrefixLength = 0;
+  for (auto permutationEnum : Permutation::ALL) {
+    auto permutation = index.getPermutationPtr(permutationEnum);
+    if (permutation == nullptr || !permutation->isLoaded()) {
+      continue;
+    }
+    const auto& keys = permutation->keyOrder().keys();
+    size_t prefixLength = 0;
+    while (prefixLength < 3 && fixed[keys[prefixLength]].has_value()) {
+      ++prefixLength;
+    }
+    if (bestPermutation == nullptr || prefixLength > bestPrefixLength) {
+      bestPermutation = permutation.get();
+      bestPrefixLength = prefixLength;
+    }
+  }
+  AD_CORRECTNESS_CHECK(bestPermutation != nullptr);
+  const auto& keys = bestPermutation->keyOrder().keys();
+  std::array<std::optional<Id>, 3> scanIds;
+  for (size_t i = 0; i < bestPrefixLength; ++i) {
+    scanIds[i] = fixed[keys[i]];
+  }
+  ScanSpecification scanSpec{scanIds[0], scanIds[1], scanIds[2]};
+  auto table = bestPermutation->scan(
+      bestPermutation->getScanSpecAndBlocks(scanSpec, state), {},
+      cancellationHandle, state);
+
+  // The columns of the result are the remaining columns of the permutation.
+  // The fixed `Id`s that are not part of the prefix still have to be checked.
+  std::vector<std::array<Id, 3>> result;
+  for (size_t row = 0; row < table.numRows(); ++row) {
+    std::array<Id, 3> triple;
+    bool matches = true;
+    for (size_t i = 0; i < 3; ++i) {
+      triple[keys[i]] = i < bestPrefixLength
+                            ? scanIds[i].value()
+                            : table(row, i - bestPrefixLength);
+      matches = matches && (!fixed[keys[i]].has_value() ||
+                            fixed[keys[i]].value() == triple[keys[i]]);
+    }
+    if (matches) {
+      result.push_back(triple);
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+ViewRows ViewMaintenancePlan::evaluate(
+    const IndexImpl& index, const LocatedTriplesState& state,
+    const Binding& binding,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) const {
+  ViewRows result;
+  std::vector<bool> isJoined(patterns_.size(), false);
+  // Index nested loop join: Extend the `binding` by the matches of the
+  // pattern with the most bound positions, until all patterns are joined.
+  auto extend = [&](auto& self, const Binding& current,
+                    size_t numJoined) -> void {
+    cancellationHandle->throwIfCancelled();
+    if (numJoined == patterns_.size()) {
+      std::array<Id, ViewRow::NumCols> row;
+      for (size_t i = 0; i < row.size(); ++i) {
+        AD_CORRECTNESS_CHECK(current[i].has_value());
+        row[i] = current[i].value();
+      }
+      result.insert(ViewRow{row});
+      return;
+    }
+    auto numBound = [&current](const Pattern& pattern) {
+      return ql::ranges::count_if(pattern, [&current](const Position& p) {
+        const auto* column = std::get_if<ColumnIndex>(&p);
+        return column == nullptr || current.at(*column).has_value();
+      });
+    };
+    std::optional<size_t> next;
+    for (size_t i = 0; i < patterns_.size(); ++i) {
+      if (!isJoined[i] &&
+          (!next.has_value() ||
+           numBound(patterns_[i]) > numBound(patterns_[next.value()]))) {
+        next = i;
+      }
+    }
+    const auto& pattern = patterns_.at(next.value());
+    isJoined[next.value()] = true;
+    for (const auto& triple :
+         scanPattern(index, state, pattern, current, cancellationHandle)) {
+      if (auto extended = unify(pattern, triple, current)) {
+        self(self, extended.value(), numJoined + 1);
+      }
+    }
+    isJoined[next.value()] = false;
+  };
+  extend(extend, binding, 0);
+  return result;
+}
+
+// _____________________________________________________________________________
+ViewDelta ViewMaintenancePlan::computeDelta(
+    const IndexImpl& index, const LocatedTriplesState& before,
+    const LocatedTriplesState& after,
+    ql::span<const IdTriple<>> changedTriples,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) const {
+  ViewRows rowsBefore;
+  ViewRows rowsAfter;
+  for (const auto& changedTriple : changedTriples) {
+    const auto& ids = changedTriple.ids();
+    std::array<Id, 3> triple{ids[0], ids[1], ids[2]};
+    for (const auto& pattern : patterns_) {
+      auto binding = unify(pattern, triple, initialBinding());
+      if (!binding.has_value()) {
+        continue;
+      }
+      for (auto& row :
+           evaluate(index, before, binding.value(), cancellationHandle)) {
+        rowsBefore.insert(std::move(row));
+      }
+      for (auto& row :
+           evaluate(index, after, binding.value(), cancellationHandle)) {
+        rowsAfter.insert(std::move(row));
+      }
+    }
+  }
+
+  ViewDelta delta;
+  for (const auto& row : rowsAfter) {
+    if (!rowsBefore.contains(row)) {
+      delta.rowsToInsert_.push_back(row);
+    }
+  }
+  for (const auto& row : rowsBefore) {
+    if (!rowsAfter.contains(row)) {
+      delta.rowsToDelete_.push_back(row);
+    }
+  }
+  return delta;
+}
+
+}  // namespace materializedViewsMaintenance
@@ -0,0 +1,126 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_MATERIALIZEDVIEWSMAINTENANCE_H_
+#define QLEVER_SRC_ENGINE_MATERIALIZEDVIEWSMAINTENANCE_H_
+
+#include <array>
+#include <optional>
+#include <variant>
+#include <vector>
+
+#include "backports/span.h"
+#include "engine/VariableToColumnMap.h"
+#include "global/Id.h"
+#include "global/IdTriple.h"
+#include "index/DeltaTriples.h"
+#include "parser/ParsedQuery.h"
+#include "util/CancellationHandle.h"
+#include "util/HashSet.h"
+
+// Forward declarations to prevent cyclic dependencies.
+class IndexImpl;
+
+// _____________________________________________________________________________
+namespace materializedViewsMaintenance {
+
+// The rows of a materialized view with at most four columns, as `IdTriple`s
+// (the fourth `Id` is the fourth column of the view). This is also the format
+// of the located triples of the view's permutation.
+using ViewRow = IdTriple<>;
+using ViewRows = ad_utility::HashSet<ViewRow>;
+
+// The rows that have to be inserted into or deleted from a materialized view
+// after an update of the index.
+struct ViewDelta {
+  std::vector<ViewRow> rowsToInsert_;
+  std::vector<ViewRow> rowsToDelete_;
+};
+
+// Incremental maintenance of a materialized view under SPARQL UPDATE for views
+// whose query is a join of the triples of a single basic graph pattern that
+// selects all the variables of the pattern (so the rows of the view are
+// exactly the distinct solutions of the pattern).
+//
+// The delta of the view is computed from the changed triples: Every row that
+// is added to (removed from) the view contains a triple that was inserted
+// (deleted) by the update. So for each changed triple and each triple of the
+// pattern that it matches, we evaluate the pattern with the variables bound by
+// the changed triple, once on the index before and once on the index after the
+// update, by index nested loop joins. Rows that are only found after (before)
+// the update have to be inserted into (deleted from) the view.
+class ViewMaintenancePlan {
+ public:
+  // Each position of a triple of the pattern is either a fixed `Id` or the
+  // column of the view that is bound to the variable at that position.
+  using Position = std::variant<Id, ColumnIndex>;
+  using Pattern = std::array<Position, 3>;
+
+ private:
+  std::vector<Pattern> patterns_;
+  // The number of columns of the view. The remaining columns of a `ViewRow`
+  // are always `UNDEF` (like the empty columns that pad the view on disk).
+  size_t numColumns_;
+
+  // The values of the columns of the view during the evaluation of the
+  // pattern, `std::nullopt` for columns that are not bound yet.
+  using Binding = std::array<std::optional<Id>, ViewRow::NumCols>;
+
+  ViewMaintenancePlan(std::vector<Pattern> patterns, size_t numColumns)
+      : patterns_{std::move(patterns)}, numColumns_{numColumns} {}
+
+ public:
+  // Create the plan for the view with the given `query` and `columns`. Return
+  // `std::nullopt` (and log the reason) if the view cannot be maintained
+  // incrementally.
+  static std::optional<ViewMaintenancePlan> make(
+      std::string_view viewName, const ParsedQuery& query,
+      const VariableToColumnMap& columns, const IndexImpl& index);
+
+  // Compute the rows that have to be inserted into and deleted from the view
+  // when the index changes from the state `before` to the state `after` by
+  // inserting or deleting the `changedTriples`. The local vocab entries and
+  // blank nodes of the `changedTriples` must already be the ones of the
+  // `DeltaTriples` (see `DeltaTriples::rewriteLocalVocabEntriesAndBlankNodes`),
+  // so that they match the triples of the state `after`.
+  ViewDelta computeDelta(
+      const IndexImpl& index, const LocatedTriplesState& before,
+      const LocatedTriplesState& after,
+      ql::span<const IdTriple<>> changedTriples,
+      const ad_utility::SharedCancellationHandle& cancellationHandle) const;
+
+  // Getter for testing.
+  const std::vector<Pattern>& patterns() const { return patterns_; }
+
+ private:
+  // The binding where only the padding columns are bound (to `UNDEF`).
+  Binding initialBinding() const;
+
+  // Bind the variables of the `pattern` to the `Id`s of the `triple` (which
+  // only consists of subject, predicate, and object), starting from the
+  // `binding`. Return `std::nullopt` if the `triple` does not match.
+  static std::optional<Binding> unify(const Pattern& pattern,
+                                      const std::array<Id, 3>& triple,
+                                      Binding binding);
+
+  // Return all the rows of the view that are compatible with the `binding`
+  // on the index with the given `state`.
+  ViewRows evaluate(
+      const IndexImpl& index, const LocatedTriplesState& state,
+      const Binding& binding,
+      const ad_utility::SharedCancellationHandle& cancellationHandle) const;
+
+  // Return the triples (subject, predicate, object) of the index with the
+  // given `state` that match the `pattern` when the variables of the `pattern`
+  // are replaced by the values of the `binding`.
+  static std::vector<std::array<Id, 3>> scanPattern(
+      const IndexImpl& index, const LocatedTriplesState& state,
+      const Pattern& pattern, const Binding& binding,
+      const ad_utility::SharedCancellationHandle& cancellationHandle);
+};
+
+}  // namespace materializedViewsMaintenance
+
+#endif  // QLEVER_SRC_ENGINE_MATERIALIZEDVIEWSMAINTENANCE_H_
@@ -9,18 +9,27 @@
 
 #include "engine/MaterializedViewsQueryAnalysis.h"
 
+#include <absl/strings/str_cat.h>
+
 #include <algorithm>
 #include <optional>
+#include <tuple>
 #include <variant>
 
+#include "backports/StartsWithAndEndsWith.h"
 #include "backports/algorithm.h"
 #include "engine/IndexScan.h"
 #include "engine/MaterializedViews.h"
 #include "engine/VariableToColumnMap.h"
+#include "engine/sparqlExpressions/AggregateExpression.h"
+#include "engine/sparqlExpressions/CountStarExpression.h"
+#include "global/Constants.h"
 #include "parser/GraphPatternOperation.h"
+#include "parser/MagicServiceIriConstants.h"
 #include "parser/PropertyPath.h"
 #include "parser/SparqlParser.h"
 #include "util/Exception.h"
+#include "util/Log.h"
 #include "util/VariantRangeFilter.h"
 
 namespace materializedViewsQueryAnalysis {
@@ -340,6 +349,424 @@ bool QueryPatternCache::analyzeJoinStar(
   return true;
 }
 
+namespace {
+
+// The prefix of the variables that the aggregate columns of a view are bound
+// to when a query is rewritten to re-aggregate the view.
+constexpr std::string_view MATERIALIZED_VIEW_AGGREGATE_VARIABLE_PREFIX =
+    "?_ql_materialized_view_agg_";
+
+// The kind and the argument of a simple aggregate (see `getSimpleAggregate`).
+using SimpleAggregate = std::pair<AggregateKind, std::optional<Variable>>;
+
+// Return the kind and the argument of the `expression` if it is a non-distinct
+// `COUNT`, `SUM`, `MIN`, `MAX`, or `AVG` of a single variable or `COUNT(*)`,
+// otherwise return `std::nullopt`. For `COUNT`, the argument is always
+// `std::nullopt`, because all variables of a basic graph pattern are bound.
+std::optional<SimpleAggregate> getSimpleAggregate(
+    const sparqlExpression::SparqlExpression& expression) {
+  using namespace sparqlExpression;
+  if (expression.isAggregate() !=
+      SparqlExpression::AggregateStatus::NonDistinctAggregate) {
+    return std::nullopt;
+  }
+  if (dynamic_cast<const CountStarExpression*>(&expression) ||
+      dynamic_cast<const CountExpression*>(&expression)) {
+    return SimpleAggregate{AggregateKind::Count, std::nullopt};
+  }
+  std::optional<AggregateKind> kind;
+  if (dynamic_cast<const SumExpression*>(&expression)) {
+    kind = AggregateKind::Sum;
+  } else if (dynamic_cast<const MinExpression*>(&expression)) {
+    kind = AggregateKind::Min;
+  } else if (dynamic_cast<const MaxExpression*>(&expression)) {
+    kind = AggregateKind::Max;
+  } else if (dynamic_cast<const AvgExpression*>(&expression)) {
+    kind = AggregateKind::Avg;
+  }
+  auto children = expression.children();
+  if (!kind.has_value() || children.size() != 1) {
+    return std::nullopt;
+  }
+  auto argument = children[0]->getVariableOrNullopt();
+  if (!argument.has_value()) {
+    return std::nullopt;
+  }
+  return SimpleAggregate{kind.value(), std::move(argument)};
+}
+
+// Return the triples of a basic graph pattern as `SparqlTripleSimple`s, or
+// `std::nullopt` if one of them has a property path or a special predicate.
+std::optional<std::vector<SparqlTripleSimple>> getSimpleTriples(
+    const std::vector<SparqlTriple>& triples) {
+  std::vector<SparqlTripleSimple> result;
+  for (const auto& triple : triples) {
+    auto predicate = triple.getSimplePredicate();
+    if (!predicate.has_value() && !triple.getPredicateVariable()) {
+      return std::nullopt;
+    }
+    if ((predicate.has_value() &&
+         ql::starts_with(predicate.value(),
+                         QLEVER_INTERNAL_PREFIX_IRI_WITHOUT_CLOSING_BRACKET)) ||
+        !triple.additionalScanColumns_.empty()) {
+      return std::nullopt;
+    }
+    result.push_back(triple.getSimple());
+  }
+  return result;
+}
+
+// A bijection between the variables of the query and the variables of a view.
+struct VariableMapping {
+  ad_utility::HashMap<Variable, Variable> queryToView_;
+  ad_utility::HashMap<Variable, Variable> viewToQuery_;
+
+  // Extend the mapping s.t. the `queryComponent` is mapped to the
+  // `viewComponent`. Return `false` if this is not possible.
+  bool unify(const TripleComponent& queryComponent,
+             const TripleComponent& viewComponent) {
+    if (!queryComponent.isVariable() || !viewComponent.isVariable()) {
+      return queryComponent == viewComponent;
+    }
+    const auto& queryVariable = queryComponent.getVariable();
+    const auto& viewVariable = viewComponent.getVariable();
+    auto [it, isNew] = queryToView_.try_emplace(queryVariable, viewVariable);
+    if (!isNew) {
+      return it->second == viewVariable;
+    }
+    return viewToQuery_.try_emplace(viewVariable, queryVariable).second;
+  }
+};
+
+// Return a `VariableMapping` under which the triples of the query are exactly
+// the triples of the view, or `std::nullopt` if there is none. The mapping is
+// found by backtracking, which is fine for the small patterns of views.
+std::optional<VariableMapping> matchBasicGraphPatterns(
+    const std::vector<SparqlTripleSimple>& query,
+    const std::vector<SparqlTripleSimple>& view) {
+  if (query.size() != view.size()) {
+    return std::nullopt;
+  }
+  std::vector<bool> isMatched(view.size(), false);
+  auto match = [&](auto& self, size_t queryIdx, const VariableMapping& mapping)
+      -> std::optional<VariableMapping> {
+    if (queryIdx == query.size()) {
+      return mapping;
+    }
+    const auto& triple = query.at(queryIdx);
+    for (size_t viewIdx = 0; viewIdx < view.size(); ++viewIdx) {
+      if (isMatched.at(viewIdx)) {
+        continue;
+      }
+      const auto& viewTriple = view.at(viewIdx);
+      VariableMapping extended = mapping;
+      if (!extended.unify(triple.s_, viewTriple.s_) ||
+          !extended.unify(triple.p_, viewTriple.p_) ||
+          !extended.unify(triple.o_, viewTriple.o_)) {
+        continue;
+      }
+      isMatched.at(viewIdx) = true;
+      auto result = self(self, queryIdx + 1, extended);
+      isMatched.at(viewIdx) = false;
+      if (result.has_value()) {
+        return result;
+      }
+    }
+    return std::nullopt;
+  };
+  return match(match, 0, VariableMapping{});
+}
+
+// The result of matching a query against an aggregate view: The text of the
+// query that re-aggregates the view, and the filters of the query that have to
+// be applied to the rows of the view.
+struct AggregateRewrite {
+  std::string query_;
+  std::vector<SparqlFilter> residualFilters_;
+};
+
+// Check if the `query` with the given `triples` and `aggregates` (one for each
+// alias of the query) can be answered by re-aggregating the `view`. See
+// `QueryPatternCache::makeAggregateRewrite` for details.
+std::optional<AggregateRewrite> matchAggregateView(
+    const ParsedQuery& query, const std::vector<SparqlTripleSimple>& triples,
+    const std::vector<SimpleAggregate>& aggregates,
+    const MaterializedView& view, const AggregateViewInfo& info) {
+  auto mapping = matchBasicGraphPatterns(triples, info.triples_);
+  if (!mapping.has_value()) {
+    return std::nullopt;
+  }
+  const auto& queryToView = mapping->queryToView_;
+
+  // The variables of the rewritten query that the columns of the view are
+  // bound to.
+  ad_utility::HashMap<Variable, Variable> requestedColumns;
+
+  // Grouped and filtered variables of the query must be grouped variables of
+  // the view. They keep their name in the rewritten query.
+  auto requestGroupedColumn = [&](const Variable& variable) {
+    auto it = queryToView.find(variable);
+    if (it == queryToView.end() ||
+        ql::ranges::find(info.groupVariables_, it->second) ==
+            info.groupVariables_.end()) {
+      return false;
+    }
+    requestedColumns.try_emplace(it->second, variable);
+    return true;
+  };
+  if (!ql::ranges::all_of(query._groupByVariables, requestGroupedColumn)) {
+    return std::nullopt;
+  }
+
+  // Filters of the view must be present in the query with the same variables.
+  // All other filters are applied to the rows of the view.
+  ad_utility::HashSet<std::string> coveredFilters;
+  std::vector<SparqlFilter> residualFilters;
+  for (const auto& filter : query._rootGraphPattern._filters) {
+    auto variables = filter.expression_.containedVariables();
+    bool hasSameVariables =
+        ql::ranges::all_of(variables, [&](const Variable* variable) {
+          auto it = queryToView.find(*variable);
+          return it != queryToView.end() && it->second == *variable;
+        });
+    const auto& descriptor = filter.expression_.getDescriptor();
+    if (hasSameVariables && info.filters_.contains(descriptor)) {
+      coveredFilters.insert(descriptor);
+      continue;
+    }
+    if (!ql::ranges::all_of(variables, [&](const Variable* variable) {
+          return requestGroupedColumn(*variable);
+        })) {
+      return std::nullopt;
+    }
+    residualFilters.push_back(filter);
+  }
+  if (coveredFilters.size() != info.filters_.size()) {
+    return std::nullopt;
+  }
+
+  // Return the variable of the rewritten query that the column of the view
+  // that stores the aggregate of the given `kind` over the given `argument` of
+  // the query is bound to, or `std::nullopt` if there is no such column.
+  auto aggregateColumn = [&](AggregateKind kind,
+                             const std::optional<Variable>& argument)
+      -> std::optional<std::string> {
+    std::optional<Variable> viewArgument;
+    if (argument.has_value()) {
+      auto it = queryToView.find(argument.value());
+      if (it == queryToView.end()) {
+        return std::nullopt;
+      }
+      viewArgument = it->second;
+    }
+    auto it = ql::ranges::find_if(info.aggregates_, [&](const auto& agg) {
+      return agg.kind_ == kind && agg.argument_ == viewArgument;
+    });
+    if (it == info.aggregates_.end()) {
+      return std::nullopt;
+    }
+    auto column = requestedColumns.try_emplace(
+        it->target_, absl::StrCat(MATERIALIZED_VIEW_AGGREGATE_VARIABLE_PREFIX,
+                                  requestedColumns.size()));
+    return column.first->second.name();
+  };
+
+  // Re-aggregate the columns of the view.
+  ad_utility::HashMap<Variable, std::string> aggregateExpressions;
+  const auto& aliases = query.selectClause().getAliases();
+  AD_CORRECTNESS_CHECK(aliases.size() == aggregates.size());
+  for (size_t i = 0; i < aliases.size(); ++i) {
+    const auto& [kind, argument] = aggregates.at(i);
+    std::optional<std::string> expression;
+    if (kind == AggregateKind::Avg) {
+      auto sum = aggregateColumn(AggregateKind::Sum, argument);
+      auto count = aggregateColumn(AggregateKind::Count, std::nullopt);
+      if (sum.has_value() && count.has_value()) {
+        expression = absl::StrCat("(SUM(", sum.value(), ") / SUM(",
+                                  count.value(), "))");
+      }
+    } else if (auto column = aggregateColumn(kind, argument)) {
+      std::string_view function = kind == AggregateKind::Min   ? "MIN"
+                                  : kind == AggregateKind::Max ? "MAX"
+                                                               : "SUM";
+      expression = absl::StrCat(function, "(", column.value(), ")");
+    }
+    if (!expression.has_value()) {
+      return std::nullopt;
+    }
+    aggregateExpressions.emplace(aliases.at(i)._target,
+                                 std::move(expression.value()));
+  }
+
+  // The first column of the view must always be requested.
+  const auto& viewColumns = view.variableToColumnMap();
+  auto columns = copySortedByColumnIndex(viewColumns);
+  AD_CORRECTNESS_CHECK(!columns.empty());
+  requestedColumns.try_emplace(
+      columns.at(0).first,
+      absl::StrCat(MATERIALIZED_VIEW_AGGREGATE_VARIABLE_PREFIX, "first"));
+
+  // Assemble the query that re-aggregates the view.
+  std::string selectClause;
+  for (const auto& variable : query.selectClause().getSelectedVariables()) {
+    auto it = aggregateExpressions.find(variable);
+    absl::StrAppend(&selectClause, " ",
+                    it == aggregateExpressions.end()
+                        ? variable.name()
+                        : absl::StrCat("(", it->second, " AS ",
+                                       variable.name(), ")"));
+  }
+  std::string serviceConfig;
+  for (const auto& [viewVariable, columnInfo] : columns) {
+    auto it = requestedColumns.find(viewVariable);
+    if (it != requestedColumns.end()) {
+      absl::StrAppend(&serviceConfig, " _:config <",
+                      MATERIALIZED_VIEW_IRI_WITHOUT_BRACKETS, "column-",
+                      std::string_view{viewVariable.name()}.substr(1), "> ",
+                      it->second.name(), " .");
+    }
+  }
+  std::string groupBy;
+  for (const auto& variable : query._groupByVariables) {
+    absl::StrAppend(&groupBy, groupBy.empty() ? " GROUP BY " : " ",
+                    variable.name());
+  }
+  return AggregateRewrite{
+      absl::StrCat("SELECT", selectClause, " WHERE { SERVICE <",
+                   MATERIALIZED_VIEW_IRI_WITHOUT_BRACKETS, view.name(), "> {",
+                   serviceConfig, " } }", groupBy),
+      std::move(residualFilters)};
+}
+
+}  // namespace
+
+// _____________________________________________________________________________
+bool QueryPatternCache::analyzeAggregateView(ViewPtr view,
+                                             const ParsedQuery& parsed) {
+  const auto& rootPattern = parsed._rootGraphPattern;
+  if (!parsed.hasSelectClause() || !parsed._havingClauses.empty() ||
+      rootPattern._graphPatterns.size() != 1 ||
+      !std::holds_alternative<parsedQuery::BasicGraphPattern>(
+          rootPattern._graphPatterns.at(0)) ||
+      !parsed._limitOffset.isUnconstrained() ||
+      parsed.postQueryValuesClause_.has_value() ||
+      parsed.datasetClauses_.activeDefaultGraphs().has_value()) {
+    return false;
+  }
+
+  AggregateViewInfo info;
+  auto triples =
+      getSimpleTriples(rootPattern._graphPatterns.at(0).getBasic()._triples);
+  if (!triples.has_value() || triples->empty()) {
+    return false;
+  }
+  info.triples_ = std::move(triples.value());
+  for (const auto& filter : rootPattern._filters) {
+    info.filters_.insert(filter.expression_.getDescriptor());
+  }
+
+  // All grouped variables must be columns of the view.
+  const auto& columns = view->variableToColumnMap();
+  for (const auto& variable : parsed._groupByVariables) {
+    if (!columns.contains(variable)) {
+      return false;
+    }
+    info.groupVariables_.push_back(variable);
+  }
+
+  // Other aliases (for example `AVG`, which can't be re-aggregated) are just
+  // columns of the view that are not used for rewriting.
+  for (const auto& alias : parsed.getAliases()) {
+    auto aggregate = getSimpleAggregate(*alias._expression.getPimpl());
+    if (aggregate.has_value() && aggregate->first != AggregateKind::Avg) {
+      info.aggregates_.push_back(
+          {aggregate->first, std::move(aggregate->second), alias._target});
+    }
+  }
+  if (info.aggregates_.empty()) {
+    return false;
+  }
+
+  aggregateCache_.insert({view, std::move(info)});
+  return true;
+}
+
+// _____________________________________________________________________________
+std::optional<ParsedQuery> QueryPatternCache::makeAggregateRewrite(
+    QueryExecutionContext* qec, const ParsedQuery& query) const {
+  if (aggregateCache_.empty() || !query.hasSelectClause()) {
+    return std::nullopt;
+  }
+  const auto& selectClause = query.selectClause();
+  const auto& rootPattern = query._rootGraphPattern;
+  if (selectClause.isAsterisk() || !query._havingClauses.empty() ||
+      rootPattern._optional || rootPattern._graphPatterns.size() != 1 ||
+      !std::holds_alternative<parsedQuery::BasicGraphPattern>(
+          rootPattern._graphPatterns.at(0))) {
+    return std::nullopt;
+  }
+  const auto& aliases = selectClause.getAliases();
+  if (query._groupByVariables.empty() && aliases.empty()) {
+    return std::nullopt;
+  }
+
+  // Each alias of the query must be a simple aggregate.
+  std::vector<SimpleAggregate> aggregates;
+  for (const auto& alias : aliases) {
+    auto aggregate = getSimpleAggregate(*alias._expression.getPimpl());
+    if (!aggregate.has_value()) {
+      return std::nullopt;
+    }
+    aggregates.push_back(std::move(aggregate.value()));
+  }
+  auto triples =
+      getSimpleTriples(rootPattern._graphPatterns.at(0).getBasic()._triples);
+  if (!triples.has_value()) {
+    return std::nullopt;
+  }
+
+  // Among the matching views, choose the one with the fewest grouped variables
+  // (which typically has the fewest rows). Ties are broken by the name of the
+  // view to make the choice deterministic.
+  std::optional<AggregateRewrite> bestRewrite;
+  ViewPtr bestView;
+  for (const auto& [view, info] : aggregateCache_) {
+    if (bestView != nullptr &&
+        std::tuple{info.groupVariables_.size(), view->name()} >=
+            std::tuple{aggregateCache_.at(bestView).groupVariables_.size(),
+                       bestView->name()}) {
+      continue;
+    }
+    auto rewrite =
+        matchAggregateView(query, triples.value(), aggregates, *view, info);
+    if (rewrite.has_value()) {
+      bestRewrite = std::move(rewrite);
+      bestView = view;
+    }
+  }
+  if (!bestRewrite.has_value()) {
+    return std::nullopt;
+  }
+
+  // Replace the body, the `GROUP BY` clause and the `SELECT` clause of the
+  // query by those of the rewritten query. All the other clauses (`ORDER BY`,
+  // `LIMIT`, ...) stay the same, because the result has the same columns.
+  auto rewritten = SparqlParser::parseQuery(
+      &qec->getIndex().encodedIriManager(), std::move(bestRewrite->query_));
+  ParsedQuery result = query;
+  result._rootGraphPattern = std::move(rewritten._rootGraphPattern);
+  ql::ranges::move(bestRewrite->residualFilters_,
+                   std::back_inserter(result._rootGraphPattern._filters));
+  result._groupByVariables = std::move(rewritten._groupByVariables);
+  result._clause = std::move(rewritten._clause);
+  result.selectClause().distinct_ = selectClause.distinct_;
+  result.selectClause().reduced_ = selectClause.reduced_;
+  AD_LOG_DEBUG << "The query is answered by re-aggregating the materialized "
+                  "view '"
+               << bestView->name() << "'." << std::endl;
+  return result;
+}
+
 // _____________________________________________________________________________
 bool QueryPatternCache::analyzeView(ViewPtr view) {
   auto explainIgnore = [&](const std::string& reason) {
@@ -356,6 +783,21 @@ bool QueryPatternCache::analyzeView(ViewPtr view) {
     return false;
   }
 
+  // Views that store pre-aggregated results can only be used for rewriting
+  // queries with aggregates.
+  if (!parsed->_groupByVariables.empty() ||
+      ql::ranges::any_of(parsed->getAliases(), [](const Alias& alias) {
+        return alias._expression.containsAggregate();
+      })) {
+    if (!analyzeAggregateView(view, parsed.value())) {
+      explainIgnore(
+          "The view aggregates, but is not a supported aggregation of a basic "
+          "graph pattern");
+      return false;
+    }
+    return true;
+  }
+
   auto graphPatternsFiltered = graphPatternInvariantFilter(parsed.value());
   if (graphPatternsFiltered.size() != 1) {
     explainIgnore(
@@ -442,6 +884,9 @@ void QueryPatternCache::removeView(ViewPtr view) {
 
   // Remove `view` from star cache.
   starCache_.erase(view);
+
+  // Remove `view` from aggregate cache.
+  aggregateCache_.erase(view);
 }
 
 // _____________________________________________________________________________
@@ -13,9 +13,11 @@
 #include "engine/VariableToColumnMap.h"
 #include "parser/GraphPatternAnalysis.h"
 #include "parser/GraphPatternOperation.h"
+#include "parser/ParsedQuery.h"
 #include "parser/SparqlTriple.h"
 #include "parser/TripleComponent.h"
 #include "rdfTypes/Variable.h"
+#include "util/HashSet.h"
 #include "util/StringPairHashMap.h"
 
 // Forward declarations to prevent cyclic dependencies.
@@ -54,6 +56,27 @@ struct StarInfo {
   std::vector<StarArm> arms_;
 };
 
+// Types required to store cached aggregate views. That is, queries of the form
+// `SELECT ?g1 ?g2 (COUNT(?x) AS ?c) (SUM(?y) AS ?s) { <BGP> FILTER(...) }
+// GROUP BY ?g1 ?g2`. The `ViewAggregate` stores the kind of an aggregate, the
+// variable it aggregates (`std::nullopt` for `COUNT`, because all the variables
+// of a basic graph pattern are always bound) and the column of the view it is
+// stored in. The `AggregateViewInfo` additionally stores the triples of the
+// basic graph pattern, the descriptors of the filters, and the grouped
+// variables of the view.
+enum class AggregateKind { Count, Sum, Min, Max, Avg };
+struct ViewAggregate {
+  AggregateKind kind_;
+  std::optional<Variable> argument_;
+  Variable target_;
+};
+struct AggregateViewInfo {
+  std::vector<SparqlTripleSimple> triples_;
+  ad_utility::HashSet<std::string> filters_;
+  std::vector<Variable> groupVariables_;
+  std::vector<ViewAggregate> aggregates_;
+};
+
 // Helper class that represents a possible join replacement and indicates the
 // subset of triples it handles.
 struct MaterializedViewJoinReplacement {
@@ -79,6 +102,9 @@ class QueryPatternCache {
   // All star patterns extracted from materialized views.
   ad_utility::HashMap<ViewPtr, StarInfo> starCache_;
 
+  // All views that store pre-aggregated results.
+  ad_utility::HashMap<ViewPtr, AggregateViewInfo> aggregateCache_;
+
   // NOTE: When a new data structure for caching is added here, the unloading
   // should also be implemented in the `removeView` method.
  public:
@@ -112,6 +138,20 @@ class QueryPatternCache {
       QueryExecutionContext* qec, ViewPtr starView,
       parsedQuery::MaterializedViewQuery::RequestedColumns columns) const;
 
+  // Given a `query` that groups the solutions of a basic graph pattern and
+  // computes aggregates, check if it can be answered by re-aggregating one of
+  // the aggregate views. This is the case if the basic graph pattern of the
+  // view is the same (up to the names of the variables), the query groups by a
+  // subset of the grouped variables of the view, each of its aggregates can be
+  // computed from the aggregates of the view (`COUNT` and `SUM` via `SUM`,
+  // `MIN` via `MIN`, `MAX` via `MAX`, and `AVG` via `SUM` and `COUNT`), and
+  // each of its filters is either a filter of the view or only uses grouped
+  // variables of the view. If there is such a view, return the query that
+  // re-aggregates the view with the fewest grouped variables, otherwise return
+  // `std::nullopt`.
+  std::optional<ParsedQuery> makeAggregateRewrite(
+      QueryExecutionContext* qec, const ParsedQuery& query) const;
+
  private:
   // Helper for `analyzeView`, that checks for a simple chain. It returns `true`
   // iff a simple chain `a->b` is present.
@@ -134,6 +174,14 @@ class QueryPatternCache {
   // `true` iff the view contains a star.
   bool analyzeJoinStar(ViewPtr view, const std::vector<SparqlTriple>& triples);
 
+  // Helper for `analyzeView`, that is called for views whose query has a
+  // `GROUP BY` clause or aggregates. If the query groups the solutions of a
+  // single basic graph pattern (optionally with filters) and computes at least
+  // one `COUNT`, `SUM`, `MIN` or `MAX` of a variable, the `view` is added to
+  // the cache for aggregate views. The function returns `true` iff this is the
+  // case. The argument `parsed` is required to be the parsed query of `view`.
+  bool analyzeAggregateView(ViewPtr view, const ParsedQuery& parsed);
+
   // Given potential left and right sides of simple chains, check for available
   // replacement index scans, construct them and insert them into the `result`
   // vector.
@@ -0,0 +1,298 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/MultiwayJoin.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+#include "util/HashMap.h"
+#include "util/JoinAlgorithms/LeapfrogTriejoin.h"
+
+// _____________________________________________________________________________
+MultiwayJoin::MultiwayJoin(QueryExecutionContext* qec, Children children,
+                           std::optional<uint64_t> sizeEstimateHint)
+    : Operation{qec},
+      children_{std::move(children)},
+      sizeEstimateHint_{sizeEstimateHint} {
+  AD_CONTRACT_CHECK(children_.size() >= 2);
+  AD_CONTRACT_CHECK(ql::ranges::all_of(
+      children_, [](const auto& child) { return child != nullptr; }));
+  // Make the order of the children deterministic, s.t. identical joins can be
+  // found in the cache.
+  ql::ranges::sort(children_, ql::ranges::less{},
+                   [](const auto& child) { return child->getCacheKey(); });
+
+  AD_CONTRACT_CHECK(
+      ql::ranges::all_of(children_,
+                         [](const auto& child) {
+                           return child->getVariableColumns().size() ==
+                                  child->getResultWidth();
+                         }),
+      "All columns of the children of a `MultiwayJoin` must be bound to a "
+      "variable");
+  variables_ = computeVariableOrder(children_);
+  ad_utility::HashMap<Variable, size_t> variableIndex;
+  for (size_t i = 0; i < variables_.size(); ++i) {
+    variableIndex[variables_[i]] = i;
+  }
+
+  // Determine the columns of each child in the order of the variables and
+  // sort the children accordingly (this is a no-op if a child is already
+  // sorted in the required way).
+  for (auto& child : children_) {
+    const auto& varCols = child->getVariableColumns();
+    std::vector<std::pair<size_t, ColumnIndex>> columns;
+    for (const auto& [var, info] : varCols) {
+      AD_CONTRACT_CHECK(
+          info.mightContainUndef_ ==
+              ColumnIndexAndTypeInfo::UndefStatus::AlwaysDefined,
+          "The columns of the children of a `MultiwayJoin` must not contain "
+          "UNDEF values");
+      columns.emplace_back(variableIndex.at(var), info.columnIndex_);
+    }
+    ql::ranges::sort(columns);
+    std::vector<ColumnIndex> sortColumns;
+    for (const auto& [varIdx, col] : columns) {
+      sortColumns.push_back(col);
+    }
+    child = QueryExecutionTree::createSortedTree(std::move(child), sortColumns);
+    childColumns_.push_back(std::move(columns));
+  }
+}
+
+// _____________________________________________________________________________
+std::vector<Variable> MultiwayJoin::computeVariableOrder(
+    const Children& children) {
+  // Collect the variables in the order of their first appearance (first by
+  // child, then by the sort order of the child), and the constraints "`a` has
+  // to be bound before `b`" that are induced by the sort orders of the
+  // children.
+  std::vector<Variable> variables;
+  ad_utility::HashMap<Variable, size_t> index;
+  auto getIndex = [&variables, &index](const Variable& var) {
+    auto [it, isNew] = index.try_emplace(var, variables.size());
+    if (isNew) {
+      variables.push_back(var);
+    }
+    return it->second;
+  };
+  std::vector<std::pair<size_t, size_t>> constraints;
+  for (const auto& child : children) {
+    std::optional<size_t> previous;
+    for (ColumnIndex col : child->resultSortedOn()) {
+      size_t current =
+          getIndex(child->getVariableAndInfoByColumnIndex(col).first);
+      if (previous.has_value()) {
+        constraints.emplace_back(previous.value(), current);
+      }
+      previous = current;
+    }
+  }
+  for (const auto& child : children) {
+    std::vector<std::pair<ColumnIndex, Variable>> remaining;
+    for (const auto& [var, info] : child->getVariableColumns()) {
+      remaining.emplace_back(info.columnIndex_, var);
+    }
+    ql::ranges::sort(remaining, ql::ranges::less{},
+                     [](const auto& p) { return p.first; });
+    for (const auto& var : remaining | ql::views::values) {
+      getIndex(var);
+    }
+  }
+
+  // Topologically sort the variables (Kahn's algorithm), where ties are broken
+  // by the order of first appearance. If the constraints are contradictory,
+  // the first variable that has not yet been placed is chosen, which means
+  // that some of the children will have to be sorted.
+  const size_t numVariables = variables.size();
+  std::vector<size_t> numPredecessors(numVariables, 0);
+  for (const auto& [before, after] : constraints) {
+    ++numPredecessors[after];
+  }
+  std::vector<bool> placed(numVariables, false);
+  std::vector<Variable> result;
+  result.reserve(numVariables);
+  while (result.size() < numVariables) {
+    std::optional<size_t> next;
+    for (size_t i = 0; i < numVariables && !next.has_value(); ++i) {
+      if (!placed[i] && numPredecessors[i] == 0) {
+        next = i;
+      }
+    }
+    for (size_t i = 0; i < numVariables && !next.has_value(); ++i) {
+      if (!placed[i]) {
+        next = i;
+      }
+    }
+    AD_CORRECTNESS_CHECK(next.has_value());
+    placed[next.value()] = true;
+    result.push_back(variables[next.value()]);
+    for (const auto& [before, after] : constraints) {
+      if (before == next.value() && numPredecessors[after] > 0) {
+        --numPredecessors[after];
+      }
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::vector<QueryExecutionTree*> MultiwayJoin::getChildren() {
+  std::vector<QueryExecutionTree*> result;
+  ql::ranges::copy(
+      children_ | ql::views::transform([](auto& ptr) { return ptr.get(); }),
+      std::back_inserter(result));
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string MultiwayJoin::getCacheKeyImpl() const {
+  std::string result = "MULTIWAY JOIN\n";
+  for (size_t i = 0; i < children_.size(); ++i) {
+    absl::StrAppend(&result, children_[i]->getCacheKey(), " columns: [",
+                    absl::StrJoin(childColumns_[i], " ",
+                                  [](std::string* out, const auto& p) {
+                                    absl::StrAppend(out, p.first, ":",
+                                                    p.second);
+                                  }),
+                    "]\n");
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string MultiwayJoin::getDescriptor() const {
+  return absl::StrCat(
+      "MultiwayJoin on ",
+      absl::StrJoin(variables_, " ", [](std::string* out, const Variable& v) {
+        absl::StrAppend(out, v.name());
+      }));
+}
+
+// _____________________________________________________________________________
+size_t MultiwayJoin::getResultWidth() const { return variables_.size(); }
+
+// _____________________________________________________________________________
+std::vector<ColumnIndex> MultiwayJoin::resultSortedOn() const {
+  std::vector<ColumnIndex> result;
+  for (ColumnIndex i = 0; i < variables_.size(); ++i) {
+    result.push_back(i);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+uint64_t MultiwayJoin::getSizeEstimateBeforeLimit() {
+  if (sizeEstimateHint_.has_value()) {
+    return sizeEstimateHint_.value();
+  }
+  // Without a hint from the query planner we use the size of the smallest
+  // child as a (crude) estimate.
+  auto sizes = children_ | ql::views::transform([](const auto& child) {
+                 return child->getSizeEstimate();
+               });
+  return ql::ranges::min(sizes);
+}
+
+// _____________________________________________________________________________
+size_t MultiwayJoin::getCostEstimate() {
+  // Each input row is touched (at most) once by the seek operations, each of
+  // which is more expensive than a step of a zipper join.
+  double seekCost =
+      _executionContext
+          ? _executionContext->getCostFactor("MULTIWAY_JOIN_SEEK_COST")
+          : 2.0;
+  size_t costEstimate = getSizeEstimateBeforeLimit();
+  for (const auto& child : children_) {
+    costEstimate += child->getCostEstimate();
+    costEstimate += static_cast<size_t>(
+        seekCost * static_cast<double>(child->getSizeEstimate()));
+  }
+  return costEstimate;
+}
+
+// _____________________________________________________________________________
+float MultiwayJoin::getMultiplicity(size_t col) {
+  AD_CONTRACT_CHECK(col < variables_.size());
+  // The multiplicity of a join variable cannot be larger than its
+  // multiplicity in any of the inputs (if the inputs are duplicate-free).
+  float result = std::numeric_limits<float>::max();
+  for (size_t i = 0; i < children_.size(); ++i) {
+    for (const auto& [varIdx, childCol] : childColumns_[i]) {
+      if (varIdx == col) {
+        result = std::min(result, children_[i]->getMultiplicity(childCol));
+      }
+    }
+  }
+  return std::max(result, 1.0f);
+}
+
+// _____________________________________________________________________________
+bool MultiwayJoin::knownEmptyResult() {
+  return ql::ranges::any_of(children_, [](const auto& child) {
+    return child->knownEmptyResult();
+  });
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<Operation> MultiwayJoin::cloneImpl() const {
+  auto copy = std::make_unique<MultiwayJoin>(*this);
+  for (auto& child : copy->children_) {
+    child = child->clone();
+  }
+  return copy;
+}
+
+// _____________________________________________________________________________
+VariableToColumnMap MultiwayJoin::computeVariableToColumnMap() const {
+  VariableToColumnMap result;
+  for (size_t i = 0; i < variables_.size(); ++i) {
+    result[variables_[i]] = makeAlwaysDefinedColumn(i);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+Result MultiwayJoin::computeResult([[maybe_unused]] bool requestLaziness) {
+  IdTable result{getResultWidth(), getExecutionContext()->getAllocator()};
+  if (knownEmptyResult()) {
+    return {std::move(result), resultSortedOn(), LocalVocab{}};
+  }
+
+  std::vector<std::shared_ptr<const Result>> subResults;
+  subResults.reserve(children_.size());
+  for (const auto& child : children_) {
+    subResults.push_back(child->getResult());
+    checkCancellation();
+  }
+
+  std::vector<ad_utility::LeapfrogRelation<Id>> relations;
+  relations.reserve(children_.size());
+  for (size_t i = 0; i < children_.size(); ++i) {
+    const IdTable& table = subResults[i]->idTable();
+    auto& relation = relations.emplace_back();
+    for (const auto& [varIdx, col] : childColumns_[i]) {
+      relation.columns_.push_back(table.getColumn(col));
+      relation.variables_.push_back(varIdx);
+    }
+  }
+
+  ad_utility::leapfrogTriejoin(
+      relations, variables_.size(),
+      [&result](const std::vector<Id>& tuple, size_t multiplicity) {
+        for (size_t i = 0; i < multiplicity; ++i) {
+          result.push_back(tuple);
+        }
+      },
+      std::less<>{}, [this]() { checkCancellation(); });
+
+  return {std::move(result), resultSortedOn(),
+          Result::getMergedLocalVocab(
+              subResults |
+              ql::views::transform([](const auto& res) -> const Result& {
+                return *res;
+              }))};
+}
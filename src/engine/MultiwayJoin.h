@@ -0,0 +1,74 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_MULTIWAYJOIN_H
+#define QLEVER_SRC_ENGINE_MULTIWAYJOIN_H
+
+#include <optional>
+#include <vector>
+
+#include "engine/Operation.h"
+#include "engine/QueryExecutionTree.h"
+
+// A worst-case optimal join of an arbitrary number of children, computed with
+// the leapfrog triejoin algorithm (see `util/JoinAlgorithms/LeapfrogTriejoin.h`).
+// In contrast to a tree of binary joins, the size of the intermediate results
+// is never larger than the size of the final result, which makes a huge
+// difference for cyclic patterns like triangles or cliques. The children are
+// typically index scans that are already sorted in the required order, so
+// that no additional sorting is required.
+//
+// All the columns of all the children must be bound to variables that are
+// always defined. The result contains one column per variable, the order of
+// the variables is computed in the constructor, and the result is sorted by
+// all its columns.
+class MultiwayJoin : public Operation {
+ public:
+  using Children = std::vector<std::shared_ptr<QueryExecutionTree>>;
+
+ private:
+  Children children_;
+  // The order in which the variables are bound by the join. This is also the
+  // order of the columns in the result.
+  std::vector<Variable> variables_;
+  // For each child the pairs `(indexOfVariable, columnIndexInChild)`, sorted
+  // by the index of the variable (which is also the sort order of the child).
+  std::vector<std::vector<std::pair<size_t, ColumnIndex>>> childColumns_;
+  // An optional estimate for the size of the result that was computed by the
+  // query planner, e.g. from an equivalent tree of binary joins.
+  std::optional<uint64_t> sizeEstimateHint_;
+
+ public:
+  // Constructor. There must be at least two `children`. The children are
+  // sorted as required by the join if they are not already.
+  MultiwayJoin(QueryExecutionContext* qec, Children children,
+               std::optional<uint64_t> sizeEstimateHint = std::nullopt);
+
+  std::vector<QueryExecutionTree*> getChildren() override;
+  std::string getDescriptor() const override;
+  size_t getResultWidth() const override;
+  size_t getCostEstimate() override;
+  float getMultiplicity(size_t col) override;
+  bool knownEmptyResult() override;
+
+  // The order of the variables (and therefore of the result columns).
+  const std::vector<Variable>& variableOrder() const { return variables_; }
+
+  // Compute the order in which the variables of the `children` are bound.
+  // The order is consistent with the sort order of as many children as
+  // possible such that as few children as possible have to be sorted. Public
+  // for testing.
+  static std::vector<Variable> computeVariableOrder(const Children& children);
+
+ private:
+  std::string getCacheKeyImpl() const override;
+  uint64_t getSizeEstimateBeforeLimit() override;
+  std::vector<ColumnIndex> resultSortedOn() const override;
+  std::unique_ptr<Operation> cloneImpl() const override;
+  Result computeResult(bool requestLaziness) override;
+  VariableToColumnMap computeVariableToColumnMap() const override;
+};
+
+#endif  // QLEVER_SRC_ENGINE_MULTIWAYJOIN_H
@@ -11,6 +11,7 @@
 
 #include <absl/cleanup/cleanup.h>
 #include <absl/container/inlined_vector.h>
+#include <absl/strings/str_join.h>
 
 #include "engine/NamedResultCache.h"
 #include "engine/OperationBindPushDownImpl.h"
@@ -143,6 +144,35 @@ void Operation::updateRuntimeStats(bool applyToLimit, uint64_t numRows,
   }
 }
 
+// _____________________________________________________________________________
+// The part of the cache key of an `Operation` that represents its `LIMIT`
+// clause.
+static std::string cacheKeySuffix(const LimitOffsetClause& limitOffset) {
+  std::string result;
+  if (limitOffset._limit.has_value()) {
+    absl::StrAppend(&result, " LIMIT ", limitOffset._limit.value());
+  }
+  if (limitOffset._offset != 0) {
+    absl::StrAppend(&result, " OFFSET ", limitOffset._offset);
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+static RuntimeInformation::Status statusOfConsumedLazyResult(
+    Result::GeneratorState state) {
+  using enum Result::GeneratorState;
+  switch (state) {
+    case FINISHED:
+      return RuntimeInformation::lazilyMaterializedCompleted;
+    case CANCELLED:
+      return RuntimeInformation::cancelled;
+    default:
+      AD_CORRECTNESS_CHECK(state == FAILED);
+      return RuntimeInformation::failed;
+  }
+}
+
 // _____________________________________________________________________________
 Result Operation::runComputation(const ad_utility::Timer& timer,
                                  ComputationMode computationMode) {
@@ -217,18 +247,7 @@ Result Operation::runComputation(const ad_utility::Timer& timer,
           signalQueryUpdate(RuntimeInformation::SendPriority::IfDue);
         },
         [this](Result::GeneratorState state) {
-          runtimeInfo().status_ = [state]() {
-            using enum Result::GeneratorState;
-            switch (state) {
-              case FINISHED:
-                return RuntimeInformation::lazilyMaterializedCompleted;
-              case CANCELLED:
-                return RuntimeInformation::cancelled;
-              default:
-                AD_CORRECTNESS_CHECK(state == FAILED);
-                return RuntimeInformation::failed;
-            }
-          }();
+          runtimeInfo().status_ = statusOfConsumedLazyResult(state);
           signalQueryUpdate(RuntimeInformation::SendPriority::Always);
         });
   }
@@ -261,6 +280,45 @@ CacheValue Operation::runComputationAndPrepareForCache(
     const ad_utility::Timer& timer, ComputationMode computationMode,
     const QueryCacheKey& cacheKey, bool pinned, bool isRoot) {
   auto& cache = _executionContext->getQueryTreeCache();
+  // Lazy results are shared with concurrent computations of the same subtree
+  // (see `SharedLazyResults`).
+  auto maxMemoryForSharing =
+      getRuntimeParameter<&RuntimeParameters::lazyResultSharingMaxMemory_>();
+  const bool shareLazyResult =
+      computationMode == ComputationMode::LAZY_IF_SUPPORTED &&
+      canResultBeCached() && !pinned && maxMemoryForSharing > 0_B;
+  if (shareLazyResult) {
+    // If this consumer is detached from the shared result, it computes the
+    // result itself.
+    auto recompute = [this, computationMode]() {
+      ad_utility::Timer recomputeTimer{ad_utility::Timer::Started};
+      auto result = runComputation(recomputeTimer, computationMode);
+      if (result.isFullyMaterialized()) {
+        return Result::LazyResult{
+            std::array{Result::IdTableVocabPair{result.idTable().clone(),
+                                                result.getCopyOfLocalVocab()}}};
+      }
+      return result.idTables();
+    };
+    if (auto sharedResult = cache.sharedLazyResults().tryAttach(
+            cacheKey, recompute, allocator())) {
+      auto& rti = runtimeInfo();
+      rti.status_ = RuntimeInformation::lazilyMaterializedInProgress;
+      rti.addDetail("shared-with-concurrent-query", true);
+      Result result{std::move(sharedResult.value()), getResultSortedOn()};
+      result.runOnNewChunkComputed(
+          [this](const Result::IdTableVocabPair& pair,
+                 std::chrono::microseconds duration) {
+            updateRuntimeStats(false, pair.idTable_.numRows(),
+                               pair.idTable_.numColumns(), duration);
+          },
+          [this](Result::GeneratorState state) {
+            runtimeInfo().status_ = statusOfConsumedLazyResult(state);
+            signalQueryUpdate(RuntimeInformation::SendPriority::Always);
+          });
+      return CacheValue{std::move(result), rti};
+    }
+  }
   auto result = runComputation(timer, computationMode);
   auto maxSize =
       isRoot ? cache.getMaxSizeSingleEntry()
@@ -296,11 +354,88 @@ CacheValue Operation::runComputationAndPrepareForCache(
     auto resultNumCols = result.idTable().numColumns();
     AD_LOG_DEBUG << "Computed result of size " << resultNumRows << " x "
                  << resultNumCols << std::endl;
+  } else if (shareLazyResult) {
+    auto sortedBy = result.sortedBy();
+    result = Result{cache.sharedLazyResults().share(
+                        cacheKey, result.idTables(), maxMemoryForSharing),
+                    std::move(sortedBy)};
   }
 
   return CacheValue{std::move(result), runtimeInfo()};
 }
 
+// _____________________________________________________________________________
+std::shared_ptr<const Result> Operation::deriveResultFromCachedSuperset(
+    const QueryCacheKey& cacheKey, const ad_utility::Timer& timer) {
+  auto columnSuperset = getCacheKeyOfColumnSuperset();
+  if (limitOffset_.isUnconstrained() && !columnSuperset.has_value()) {
+    return nullptr;
+  }
+
+  // The cache keys of the more general computations, the most specific ones
+  // first, together with the information which parts of the result have to be
+  // derived.
+  struct Superset {
+    std::string key_;
+    bool applyLimitOffset_;
+    std::optional<std::vector<ColumnIndex>> columns_;
+  };
+  std::vector<Superset> supersets;
+  if (!limitOffset_.isUnconstrained()) {
+    supersets.push_back({getCacheKeyImpl(), true, std::nullopt});
+  }
+  if (columnSuperset.has_value()) {
+    auto& [key, columns] = columnSuperset.value();
+    supersets.push_back({absl::StrCat(key, cacheKeySuffix(limitOffset_)),
+                         false, columns});
+    if (!limitOffset_.isUnconstrained()) {
+      supersets.push_back({std::move(key), true, std::move(columns)});
+    }
+  }
+
+  auto& cache = _executionContext->getQueryTreeCache();
+  for (auto& superset : supersets) {
+    auto cached = cache.getIfContained(
+        {std::move(superset.key_), cacheKey.locatedTriplesSnapshotIndex_});
+    if (!cached.has_value()) {
+      continue;
+    }
+    const auto& cachedValue = *cached.value()._resultPointer;
+    const IdTable& table = cachedValue.resultTable().idTable();
+    auto numRows = table.numRows();
+    size_t begin = 0;
+    size_t end = numRows;
+    if (superset.applyLimitOffset_) {
+      begin = limitOffset_.actualOffset(numRows);
+      end = limitOffset_.upperBound(numRows);
+    }
+    // Deriving the result copies its rows, which is only worthwhile if this
+    // is cheaper than computing the result.
+    if (end - begin > getCostEstimate()) {
+      continue;
+    }
+    IdTable idTable{getResultWidth(), allocator()};
+    idTable.insertAtEnd(table, begin, end, superset.columns_);
+    auto result = std::make_shared<const Result>(
+        std::move(idTable), getResultSortedOn(),
+        cachedValue.resultTable().getSharedLocalVocab());
+    updateRuntimeInformationOnSuccess(result->idTable().size(),
+                                      cached.value()._cacheStatus,
+                                      timer.msecs(), cachedValue.runtimeInfo());
+    std::vector<std::string_view> derivations;
+    if (superset.applyLimitOffset_) {
+      derivations.push_back("limit-offset");
+    }
+    if (superset.columns_.has_value()) {
+      derivations.push_back("column-subset");
+    }
+    runtimeInfo().addDetail("derived-from-cached-result",
+                            absl::StrJoin(derivations, ", "));
+    return result;
+  }
+  return nullptr;
+}
+
 // ________________________________________________________________________
 std::shared_ptr<const Result> Operation::getResult(
     bool isRoot, ComputationMode computationMode) {
@@ -361,6 +496,15 @@ std::shared_ptr<const Result> Operation::getResult(
       return std::make_shared<Result>(runComputation(timer, computationMode));
     }
 
+    // A result that is not cached itself can still be derived from the
+    // cached result of a more general computation.
+    if (!pinResult && !pinResultWithName && !cache.cacheContains(cacheKey)) {
+      if (auto derivedResult = deriveResultFromCachedSuperset(cacheKey, timer);
+          derivedResult != nullptr) {
+        return derivedResult;
+      }
+    }
+
     auto cacheSetup = [this, &timer, computationMode, &cacheKey, pinResult,
                        isRoot]() {
       return runComputationAndPrepareForCache(timer, computationMode, cacheKey,
@@ -726,14 +870,7 @@ std::string Operation::getCacheKey() const {
     // disabled.
     return "";
   }
-  auto result = getCacheKeyImpl();
-  if (limitOffset_._limit.has_value()) {
-    absl::StrAppend(&result, " LIMIT ", limitOffset_._limit.value());
-  }
-  if (limitOffset_._offset != 0) {
-    absl::StrAppend(&result, " OFFSET ", limitOffset_._offset);
-  }
-  return result;
+  return absl::StrCat(getCacheKeyImpl(), cacheKeySuffix(limitOffset_));
 }
 
 // _____________________________________________________________________________
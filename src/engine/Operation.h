@@ -191,6 +191,17 @@ class Operation {
   // be customized by every child class.
   virtual std::string getCacheKeyImpl() const = 0;
 
+  // If the result of this `Operation` consists of a subset of the columns of
+  // the result of a more general computation (e.g. an `IndexScan` with
+  // stripped columns), return the cache key of that computation (without the
+  // `LIMIT` clause, like `getCacheKeyImpl`) together with the indices of the
+  // columns of this result in its result. This is used to derive the result
+  // from the cache (see `deriveResultFromCachedSuperset`).
+  virtual std::optional<std::pair<std::string, std::vector<ColumnIndex>>>
+  getCacheKeyOfColumnSuperset() const {
+    return std::nullopt;
+  }
+
  public:
   // Gets a very short (one line without line ending) descriptor string for
   // this Operation.  This string is used in the RuntimeInformation
@@ -244,6 +255,13 @@ class Operation {
     return _runtimeInfo;
   }
 
+  // The `RuntimeInformation` of the whole query. Operations that create and
+  // execute new subtrees during their own execution have to pass it to
+  // `createRuntimeInfoFromEstimates` of these subtrees.
+  std::shared_ptr<const RuntimeInformation> getRootRuntimeInfoPointer() const {
+    return _rootRuntimeInfo;
+  }
+
   RuntimeInformationWholeQuery& getRuntimeInfoWholeQuery() {
     return _runtimeInfoWholeQuery;
   }
@@ -328,6 +346,15 @@ class Operation {
     return _executionContext;
   }
 
+  // Replace the `QueryExecutionContext` of this operation (but not of its
+  // children). This is only allowed for operations that have not been
+  // executed yet, see `QueryExecutionTree::
+  // setExecutionContextAndReplaceOperations` for the intended use.
+  void setExecutionContext(QueryExecutionContext* executionContext) {
+    AD_CONTRACT_CHECK(executionContext != nullptr);
+    _executionContext = executionContext;
+  }
+
   const ad_utility::AllocatorWithLimit<Id>& allocator() const {
     return getExecutionContext()->getAllocator();
   }
@@ -492,6 +519,15 @@ class Operation {
   Result runComputation(const ad_utility::Timer& timer,
                         ComputationMode computationMode);
 
+  // Derive the result of this `Operation` from a cached result of a more
+  // general computation, namely the same computation without `LIMIT` and
+  // `OFFSET` and/or with additional columns (see
+  // `getCacheKeyOfColumnSuperset`), by slicing the rows and projecting the
+  // columns. Return `nullptr` if there is no such cached result or if the
+  // result is too large for copying it to be cheaper than computing it.
+  std::shared_ptr<const Result> deriveResultFromCachedSuperset(
+      const QueryCacheKey& cacheKey, const ad_utility::Timer& timer);
+
   // Call `runComputation` and transform it into a value that could be inserted
   // into the cache.
   CacheValue runComputationAndPrepareForCache(const ad_utility::Timer& timer,
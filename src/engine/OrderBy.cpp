@@ -9,6 +9,7 @@
 
 #include "engine/CallFixedSize.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/sparqlExpressions/RelationalExpressionHelpers.h"
 #include "global/RuntimeParameters.h"
 #include "global/ValueIdComparators.h"
 #include "index/IdTableUtils.h"
@@ -102,11 +103,21 @@ Result OrderBy::computeResult([[maybe_unused]] bool requestLaziness) {
 
   // Return true iff `rowA` comes before `rowB` in the sort order specified by
   // `sortIndices_`.
-  auto comparison = [this](const auto& row1, const auto& row2) -> bool {
+  // Short literals that are stored inline are compared via the vocabulary (see
+  // `compareStringsWithInlineLiterals`).
+  auto comparison = [this, &index = getIndex()](const auto& row1,
+                                                const auto& row2) -> bool {
     for (auto& [column, isDescending] : sortIndices_) {
       if (row1[column] == row2[column]) {
         continue;
       }
+      if (auto cmp = sparqlExpression::compareStringsWithInlineLiterals(
+              row1[column], row2[column], index)) {
+        if (*cmp == 0) {
+          continue;
+        }
+        return (*cmp < 0) != isDescending;
+      }
       bool isLessThan =
           toBoolNotUndef(valueIdComparators::compareIds<
                          valueIdComparators::ComparisonForIncompatibleTypes::
@@ -0,0 +1,393 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/PreparedStatement.h"
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+
+#include "backports/StartsWithAndEndsWith.h"
+#include "backports/algorithm.h"
+#include "global/Constants.h"
+#include "parser/GraphPatternOperation.h"
+#include "parser/SparqlParser.h"
+#include "util/Exception.h"
+
+namespace {
+
+// Return true iff `c` can be part of the name of a parameter (or variable).
+bool isNameChar(char c) {
+  auto u = static_cast<unsigned char>(c);
+  return (u >= 'a' && u <= 'z') || (u >= 'A' && u <= 'Z') ||
+         (u >= '0' && u <= '9') || u == '_' || u >= 0x80;
+}
+
+// Return true iff `c` is allowed inside of an IRIREF (`<...>`).
+bool isIrirefChar(char c) {
+  auto u = static_cast<unsigned char>(c);
+  return u > 0x20 && std::string_view{"<>\"{}|^`\\"}.find(c) ==
+                         std::string_view::npos;
+}
+
+// If `s` starts with an IRIREF, return its length, else return 0.
+size_t lengthOfIriref(std::string_view s) {
+  if (s.empty() || s[0] != '<') {
+    return 0;
+  }
+  size_t i = 1;
+  while (i < s.size() && isIrirefChar(s[i])) {
+    ++i;
+  }
+  return i < s.size() && s[i] == '>' ? i + 1 : 0;
+}
+
+// If `s` starts with a string literal (in single or double quotes, short or
+// long), return its length (including the quotes), else return 0. Escape
+// sequences are skipped but not validated.
+size_t lengthOfStringLiteral(std::string_view s, bool allowLongStrings) {
+  if (s.empty() || (s[0] != '"' && s[0] != '\'')) {
+    return 0;
+  }
+  const char quote = s[0];
+  const bool isLong = allowLongStrings && s.size() >= 3 && s[1] == quote &&
+                      s[2] == quote;
+  size_t i = isLong ? 3 : 1;
+  while (i < s.size()) {
+    if (s[i] == '\\') {
+      i += 2;
+      continue;
+    }
+    if (!isLong && (s[i] == '\n' || s[i] == '\r')) {
+      return 0;
+    }
+    if (s[i] == quote) {
+      if (!isLong) {
+        return i + 1;
+      }
+      if (s.substr(i, 3) == std::string(3, quote)) {
+        return i + 3;
+      }
+    }
+    ++i;
+  }
+  return 0;
+}
+
+// Return true iff `s` is a SPARQL number (integer, decimal, or double, with
+// an optional sign).
+bool isNumber(std::string_view s) {
+  size_t i = 0;
+  if (i < s.size() && (s[i] == '+' || s[i] == '-')) {
+    ++i;
+  }
+  auto isDigit = [](char c) { return c >= '0' && c <= '9'; };
+  size_t numDigits = 0;
+  while (i < s.size() && isDigit(s[i])) {
+    ++i;
+    ++numDigits;
+  }
+  if (i < s.size() && s[i] == '.') {
+    ++i;
+    while (i < s.size() && isDigit(s[i])) {
+      ++i;
+      ++numDigits;
+    }
+  }
+  if (numDigits == 0) {
+    return false;
+  }
+  if (i < s.size() && (s[i] == 'e' || s[i] == 'E')) {
+    ++i;
+    if (i < s.size() && (s[i] == '+' || s[i] == '-')) {
+      ++i;
+    }
+    size_t numExponentDigits = 0;
+    while (i < s.size() && isDigit(s[i])) {
+      ++i;
+      ++numExponentDigits;
+    }
+    if (numExponentDigits == 0) {
+      return false;
+    }
+  }
+  return i == s.size();
+}
+
+// Return true iff `s` is a language tag without the leading `@`.
+bool isLanguageTag(std::string_view s) {
+  auto isAlpha = [](char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+  };
+  auto isAlnum = [&isAlpha](char c) {
+    return isAlpha(c) || (c >= '0' && c <= '9');
+  };
+  size_t i = 0;
+  while (i < s.size() && isAlpha(s[i])) {
+    ++i;
+  }
+  if (i == 0) {
+    return false;
+  }
+  while (i < s.size()) {
+    if (s[i] != '-' || i + 1 == s.size() || !isAlnum(s[i + 1])) {
+      return false;
+    }
+    ++i;
+    while (i < s.size() && isAlnum(s[i])) {
+      ++i;
+    }
+  }
+  return true;
+}
+
+namespace p = parsedQuery;
+
+// Append the subjects, predicates, and objects of all the triples in
+// `pattern` to `result`, see `PreparedStatement::collectTripleComponents`.
+void collectTripleComponentsImpl(
+    const p::GraphPattern& pattern,
+    std::vector<std::optional<TripleComponent>>& result) {
+  for (const auto& operation : pattern._graphPatterns) {
+    operation.visit([&result](const auto& arg) {
+      using T = std::decay_t<decltype(arg)>;
+      if constexpr (std::is_same_v<T, p::Optional> ||
+                    std::is_same_v<T, p::GroupGraphPattern> ||
+                    std::is_same_v<T, p::Minus>) {
+        collectTripleComponentsImpl(arg._child, result);
+      } else if constexpr (std::is_same_v<T, p::Union>) {
+        collectTripleComponentsImpl(arg._child1, result);
+        collectTripleComponentsImpl(arg._child2, result);
+      } else if constexpr (std::is_same_v<T, p::Subquery>) {
+        collectTripleComponentsImpl(arg.get()._rootGraphPattern, result);
+      } else if constexpr (std::is_same_v<T, p::BasicGraphPattern>) {
+        for (const SparqlTriple& triple : arg._triples) {
+          result.push_back(triple.s_);
+          if (auto var = triple.getPredicateVariable()) {
+            result.emplace_back(var.value());
+          } else if (auto iri = triple.getSimplePredicate()) {
+            result.emplace_back(
+                ad_utility::triple_component::Iri::fromIriref(iri.value()));
+          } else {
+            result.emplace_back(std::nullopt);
+          }
+          result.push_back(triple.o_);
+        }
+      }
+      // All other operations don't contain ordinary triples. Parameters that
+      // occur in them make the statement non-rebindable, see
+      // `PreparedStatement::analyzeTemplate`.
+    });
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+PreparedStatement::PreparedStatement(std::string templateString,
+                                     std::vector<DatasetClause> datasetClauses,
+                                     const EncodedIriManager* encodedIriManager)
+    : templateString_{std::move(templateString)},
+      datasetClauses_{std::move(datasetClauses)} {
+  findOccurrences();
+  for (const auto& occurrence : occurrences_) {
+    parameterNames_.push_back(occurrence.name_);
+  }
+  ql::ranges::sort(parameterNames_);
+  parameterNames_.erase(
+      std::unique(parameterNames_.begin(), parameterNames_.end()),
+      parameterNames_.end());
+  analyzeTemplate(SparqlParser::parseQuery(encodedIriManager, templateString_,
+                                           datasetClauses_));
+}
+
+// _____________________________________________________________________________
+void PreparedStatement::findOccurrences() {
+  std::string_view s = templateString_;
+  size_t i = 0;
+  while (i < s.size()) {
+    char c = s[i];
+    if (c == '#') {
+      auto end = s.find('\n', i);
+      i = end == std::string_view::npos ? s.size() : end;
+    } else if (c == '"' || c == '\'') {
+      auto length = lengthOfStringLiteral(s.substr(i), true);
+      // An unterminated literal is a syntax error that will be reported when
+      // the template is parsed.
+      i = length == 0 ? s.size() : i + length;
+    } else if (c == '<') {
+      // If this is not an IRI, then it is the less-than operator.
+      i += std::max(lengthOfIriref(s.substr(i)), size_t{1});
+    } else if (c == '$') {
+      size_t end = i + 1;
+      while (end < s.size() && isNameChar(s[end])) {
+        ++end;
+      }
+      if (end > i + 1) {
+        occurrences_.push_back(
+            {i, end, std::string{s.substr(i + 1, end - i - 1)}});
+      }
+      i = end;
+    } else {
+      ++i;
+    }
+  }
+}
+
+// _____________________________________________________________________________
+void PreparedStatement::analyzeTemplate(const ParsedQuery& parsedTemplate) {
+  auto components = collectTripleComponents(parsedTemplate);
+  numTripleComponents_ = components.size();
+  for (size_t i = 0; i < components.size(); ++i) {
+    const auto& component = components[i];
+    if (!component.has_value()) {
+      continue;
+    }
+    if (!component->isVariable()) {
+      constants_.insert(component.value());
+      continue;
+    }
+    // Note: The parser normalizes `$name` to `?name`.
+    std::string_view name = component->getVariable().name();
+    AD_CORRECTNESS_CHECK(!name.empty());
+    name.remove_prefix(1);
+    if (ql::ranges::binary_search(parameterNames_, name)) {
+      parameterSlots_[std::string{name}].push_back(i);
+    }
+  }
+  // The statement is rebindable iff each textual occurrence of each parameter
+  // corresponds to exactly one position in a triple. Otherwise, a parameter
+  // is also used elsewhere (e.g. in a `FILTER` or in the `SELECT` clause), or
+  // the same variable is also written with a leading `?`.
+  isRebindable_ = ql::ranges::all_of(parameterNames_, [this](const auto& name) {
+    auto numOccurrences = ql::ranges::count_if(
+        occurrences_,
+        [&name](const Occurrence& occ) { return occ.name_ == name; });
+    auto it = parameterSlots_.find(name);
+    return it != parameterSlots_.end() &&
+           static_cast<size_t>(numOccurrences) == it->second.size();
+  });
+}
+
+// _____________________________________________________________________________
+std::string PreparedStatement::cacheKey() const {
+  std::string result = templateString_;
+  for (const auto& clause : datasetClauses_) {
+    absl::StrAppend(&result, clause.isNamed_ ? "\nFROM NAMED " : "\nFROM ",
+                    clause.dataset_.toStringRepresentation());
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+std::string PreparedStatement::bindParameters(
+    const ad_utility::HashMap<std::string, std::string>& values) const {
+  for (const auto& [name, value] : values) {
+    if (!ql::ranges::binary_search(parameterNames_, name)) {
+      throw std::runtime_error(absl::StrCat(
+          "The prepared statement has no parameter with the name \"$", name,
+          "\". The parameters are: ",
+          absl::StrJoin(parameterNames_, ", ",
+                        [](std::string* out, const std::string& param) {
+                          absl::StrAppend(out, "$", param);
+                        })));
+    }
+    if (!isSingleRdfTerm(value)) {
+      throw std::runtime_error(absl::StrCat(
+          "The value for the parameter \"$", name,
+          "\" must be a single IRI in angle brackets, a literal, a number, or "
+          "a boolean, but was \"",
+          value, "\""));
+    }
+  }
+  std::string result;
+  size_t previousEnd = 0;
+  for (const auto& occurrence : occurrences_) {
+    auto it = values.find(occurrence.name_);
+    if (it == values.end()) {
+      throw std::runtime_error(absl::StrCat(
+          "No value was specified for the parameter \"$", occurrence.name_,
+          "\" of the prepared statement"));
+    }
+    // The trailing space makes sure that the value is separated from the
+    // following token (e.g. a number from a following `.`).
+    absl::StrAppend(
+        &result,
+        std::string_view{templateString_}.substr(
+            previousEnd, occurrence.begin_ - previousEnd),
+        it->second, " ");
+    previousEnd = occurrence.end_;
+  }
+  absl::StrAppend(&result,
+                  std::string_view{templateString_}.substr(previousEnd));
+  return result;
+}
+
+// _____________________________________________________________________________
+std::optional<PreparedStatement::ParameterValues>
+PreparedStatement::getParameterValues(const ParsedQuery& parsedQuery) const {
+  if (!isRebindable_) {
+    return std::nullopt;
+  }
+  auto components = collectTripleComponents(parsedQuery);
+  if (components.size() != numTripleComponents_) {
+    return std::nullopt;
+  }
+  ParameterValues result;
+  for (const auto& [name, slots] : parameterSlots_) {
+    std::optional<TripleComponent> value;
+    for (size_t slot : slots) {
+      const auto& component = components.at(slot);
+      if (!component.has_value() || component->isVariable() ||
+          (value.has_value() && value.value() != component.value())) {
+        return std::nullopt;
+      }
+      value = component.value();
+    }
+    AD_CORRECTNESS_CHECK(value.has_value());
+    // IRIs from the internal namespace (like `ql:has-predicate` or
+    // `ql:contains-word`) have a special meaning in the query planner, so
+    // a plan for such a value cannot be obtained by replacing a constant.
+    if (value->isIri() &&
+        ql::starts_with(value->getIri().toStringRepresentation(),
+                        QLEVER_INTERNAL_PREFIX_IRI_WITHOUT_CLOSING_BRACKET)) {
+      return std::nullopt;
+    }
+    result.emplace(name, std::move(value).value());
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+bool PreparedStatement::isSingleRdfTerm(std::string_view value) {
+  if (value == "true" || value == "false" || isNumber(value)) {
+    return true;
+  }
+  if (auto length = lengthOfIriref(value); length > 0) {
+    return length == value.size();
+  }
+  auto length = lengthOfStringLiteral(value, false);
+  if (length == 0) {
+    return false;
+  }
+  auto suffix = value.substr(length);
+  if (suffix.empty()) {
+    return true;
+  }
+  if (suffix[0] == '@') {
+    return isLanguageTag(suffix.substr(1));
+  }
+  if (ql::starts_with(suffix, "^^")) {
+    suffix.remove_prefix(2);
+    return !suffix.empty() && lengthOfIriref(suffix) == suffix.size();
+  }
+  return false;
+}
+
+// _____________________________________________________________________________
+std::vector<std::optional<TripleComponent>>
+PreparedStatement::collectTripleComponents(const ParsedQuery& parsedQuery) {
+  std::vector<std::optional<TripleComponent>> result;
+  collectTripleComponentsImpl(parsedQuery._rootGraphPattern, result);
+  return result;
+}
@@ -0,0 +1,135 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_PREPAREDSTATEMENT_H
+#define QLEVER_SRC_ENGINE_PREPAREDSTATEMENT_H
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parser/ParsedQuery.h"
+#include "parser/TripleComponent.h"
+#include "parser/sparqlParser/DatasetClause.h"
+#include "util/HashMap.h"
+#include "util/HashSet.h"
+
+// A SPARQL query with named parameters that can be prepared once and then
+// executed many times with different values for the parameters. A parameter is
+// written like a variable with a leading `$` (for example `$person`); all the
+// variables that are written this way are parameters, so ordinary variables
+// have to be written with a leading `?`. When the statement is executed, each
+// parameter is replaced by a single RDF term (an IRI in angle brackets, a
+// literal, a number, or a boolean), see `bindParameters`.
+//
+// If all the occurrences of the parameters are subjects, predicates, or
+// objects of ordinary triples, then the statement is "rebindable": the query
+// plans of different executions only differ in the constants of some index
+// scans, so a plan can be reused by replacing these constants (see
+// `QueryPlanCache`).
+class PreparedStatement {
+ public:
+  // The values of the parameters of a single execution, as they appear in the
+  // parsed query.
+  using ParameterValues = ad_utility::HashMap<std::string, TripleComponent>;
+
+ private:
+  std::string templateString_;
+  std::vector<DatasetClause> datasetClauses_;
+
+  // A single occurrence of a parameter in the `templateString_`. `begin_` is
+  // the position of the leading `$`, `end_` is the position after the name.
+  struct Occurrence {
+    size_t begin_;
+    size_t end_;
+    std::string name_;
+  };
+  std::vector<Occurrence> occurrences_;
+
+  // The names of the parameters (without the leading `$`), sorted and without
+  // duplicates.
+  std::vector<std::string> parameterNames_;
+
+  // For each parameter the indices of the triple positions (see
+  // `collectTripleComponents` below) that contain the parameter. Only
+  // meaningful if `isRebindable_` is true.
+  ad_utility::HashMap<std::string, std::vector<size_t>> parameterSlots_;
+
+  // The total number of triple positions in the template.
+  size_t numTripleComponents_ = 0;
+
+  // The constants at the triple positions of the template (which are the same
+  // for all executions).
+  ad_utility::HashSet<TripleComponent> constants_;
+
+  bool isRebindable_ = false;
+
+ public:
+  // Create a prepared statement from the `templateString`. The template is
+  // parsed once to check that it is a valid SPARQL query. Throw if parsing
+  // fails.
+  PreparedStatement(std::string templateString,
+                    std::vector<DatasetClause> datasetClauses,
+                    const EncodedIriManager* encodedIriManager);
+
+  const std::string& templateString() const { return templateString_; }
+  const std::vector<DatasetClause>& datasetClauses() const {
+    return datasetClauses_;
+  }
+  const std::vector<std::string>& parameterNames() const {
+    return parameterNames_;
+  }
+  bool isRebindable() const { return isRebindable_; }
+  const ad_utility::HashMap<std::string, std::vector<size_t>>& parameterSlots()
+      const {
+    return parameterSlots_;
+  }
+  const ad_utility::HashSet<TripleComponent>& constants() const {
+    return constants_;
+  }
+
+  // A key that identifies the template and the dataset clauses of this
+  // statement. Two statements with the same key have the same query plans.
+  std::string cacheKey() const;
+
+  // Return the query string where each parameter is replaced by its value from
+  // `values`. Throw if a value is missing or is not a single RDF term (see
+  // `isSingleRdfTerm`), or if `values` contains an unknown parameter.
+  std::string bindParameters(
+      const ad_utility::HashMap<std::string, std::string>& values) const;
+
+  // Return the values of the parameters in `parsedQuery`, which must be the
+  // result of parsing the output of `bindParameters`. Return `std::nullopt` if
+  // the statement is not rebindable or the structure of `parsedQuery` doesn't
+  // match the template.
+  std::optional<ParameterValues> getParameterValues(
+      const ParsedQuery& parsedQuery) const;
+
+  // Return true iff `value` is a single IRI in angle brackets (`<...>`), a
+  // literal in single or double quotes with an optional language tag or
+  // datatype IRI, a number, or one of `true` and `false`. Only such values may
+  // be bound to parameters, which in particular prevents the injection of
+  // arbitrary SPARQL code.
+  static bool isSingleRdfTerm(std::string_view value);
+
+  // Collect the subjects, predicates, and objects of all the triples in
+  // `parsedQuery` in a fixed order (depth-first in the order of the graph
+  // patterns, including subqueries). Predicates that are neither variables nor
+  // IRIs (that is, complex property paths) are represented as `std::nullopt`.
+  static std::vector<std::optional<TripleComponent>> collectTripleComponents(
+      const ParsedQuery& parsedQuery);
+
+ private:
+  // Find the occurrences of the parameters in the `templateString_`, skipping
+  // IRIs, literals, and comments.
+  void findOccurrences();
+
+  // Determine the `parameterSlots_` and whether the statement
+  // `isRebindable_` from the `parsedTemplate`.
+  void analyzeTemplate(const ParsedQuery& parsedTemplate);
+};
+
+#endif  // QLEVER_SRC_ENGINE_PREPAREDSTATEMENT_H
@@ -0,0 +1,300 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/QueryAdmissionController.h"
+
+#include <absl/cleanup/cleanup.h>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <utility>
+
+#include "backports/algorithm.h"
+#include "engine/HttpError.h"
+#include "global/Constants.h"
+#include "global/RuntimeParameters.h"
+#include "util/Exception.h"
+#include "util/Log.h"
+
+namespace net = boost::asio;
+
+// _____________________________________________________________________________
+std::string_view toString(QueryPriority priority) {
+  switch (priority) {
+    case QueryPriority::Interactive:
+      return "interactive";
+    case QueryPriority::Batch:
+      return "batch";
+  }
+  AD_FAIL();
+}
+
+// _____________________________________________________________________________
+std::optional<QueryPriority> parseQueryPriority(std::string_view priority) {
+  if (priority == "interactive") {
+    return QueryPriority::Interactive;
+  } else if (priority == "batch") {
+    return QueryPriority::Batch;
+  }
+  return std::nullopt;
+}
+
+// _____________________________________________________________________________
+QueryAdmissionController::Ticket::Ticket(Ticket&& other) noexcept
+    : controller_{std::exchange(other.controller_, nullptr)},
+      reservedMemory_{other.reservedMemory_},
+      waitTime_{other.waitTime_} {}
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::Ticket::operator=(Ticket&& other) noexcept
+    -> Ticket& {
+  if (this != &other) {
+    if (controller_ != nullptr) {
+      controller_->release(reservedMemory_);
+    }
+    controller_ = std::exchange(other.controller_, nullptr);
+    reservedMemory_ = other.reservedMemory_;
+    waitTime_ = other.waitTime_;
+  }
+  return *this;
+}
+
+// _____________________________________________________________________________
+QueryAdmissionController::Ticket::~Ticket() {
+  if (controller_ != nullptr) {
+    controller_->release(reservedMemory_);
+  }
+}
+
+// _____________________________________________________________________________
+std::optional<ad_utility::MemorySize>
+QueryAdmissionController::memoryBudgetPerQuery() const {
+  auto budget = getRuntimeParameter<&RuntimeParameters::queryMemoryBudget_>();
+  if (budget == ad_utility::MemorySize::bytes(0)) {
+    return std::nullopt;
+  }
+  // A larger budget could never be reserved.
+  return std::min(budget, totalMemory_);
+}
+
+// _____________________________________________________________________________
+bool QueryAdmissionController::hasCapacity(
+    const State& state, ad_utility::MemorySize memory) const {
+  auto maxConcurrent =
+      getRuntimeParameter<&RuntimeParameters::admissionMaxConcurrentQueries_>();
+  if (maxConcurrent != 0 && state.numRunning_ >= maxConcurrent) {
+    return false;
+  }
+  return state.reservedMemory_ + memory <= totalMemory_;
+}
+
+// _____________________________________________________________________________
+size_t QueryAdmissionController::bestWaiter(const std::vector<Waiter>& waiters,
+                                            Clock::time_point now) {
+  AD_CORRECTNESS_CHECK(!waiters.empty());
+  std::chrono::seconds starvationTimeout =
+      getRuntimeParameter<&RuntimeParameters::admissionStarvationTimeout_>();
+  // The cost estimate of a query is divided by one plus the number of seconds
+  // it has been waiting. The queries that have waited for longer than the
+  // starvation timeout come first, in the order of their arrival (the IDs are
+  // increasing). The queries that may only run when the server is idle come
+  // last, s.t. they never block the other queries.
+  auto rank = [now, starvationTimeout](const Waiter& waiter) {
+    auto waited = now - waiter.enqueueTime_;
+    bool isStarving = starvationTimeout.count() > 0 &&
+                      waited > starvationTimeout &&
+                      !waiter.request_.onlyWhenIdle_;
+    if (isStarving) {
+      return std::tuple{false, false, QueryPriority::Interactive, 0.0,
+                        waiter.id_};
+    }
+    double secondsWaited = std::chrono::duration<double>(waited).count();
+    double agedCost = static_cast<double>(waiter.request_.costEstimate_) /
+                      (1.0 + std::max(secondsWaited, 0.0));
+    return std::tuple{waiter.request_.onlyWhenIdle_, true,
+                      waiter.request_.priority_, agedCost, waiter.id_};
+  };
+  size_t best = 0;
+  for (size_t i = 1; i < waiters.size(); ++i) {
+    if (rank(waiters[i]) < rank(waiters[best])) {
+      best = i;
+    }
+  }
+  return best;
+}
+
+// _____________________________________________________________________________
+size_t QueryAdmissionController::enqueue(Request request,
+                                         Clock::time_point now) {
+  auto maxQueueLength =
+      getRuntimeParameter<&RuntimeParameters::admissionMaxQueueLength_>();
+  auto memory = memoryBudgetPerQuery().value_or(ad_utility::MemorySize{});
+  return state_.withWriteLock([&](State& state) {
+    // A query that can be admitted immediately never has to wait, so it is
+    // not rejected even if the queue has length 0.
+    bool admissibleImmediately =
+        state.waiters_.empty() && hasCapacity(state, memory);
+    if (state.waiters_.size() >= maxQueueLength && !admissibleImmediately) {
+      ++state.numRejected_;
+      throw HttpError(
+          boost::beast::http::status::service_unavailable,
+          absl::StrCat("The query was rejected because ",
+                       state.waiters_.size(),
+                       " queries are already waiting for their execution, "
+                       "please try again later"));
+    }
+    auto id = state.nextId_++;
+    state.waiters_.push_back(Waiter{id, request, now});
+    return id;
+  });
+}
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::tryAdmit(size_t id, Clock::time_point now)
+    -> std::optional<Ticket> {
+  auto memory = memoryBudgetPerQuery().value_or(ad_utility::MemorySize{});
+  auto waitTime = state_.withWriteLock(
+      [&](State& state) -> std::optional<std::chrono::milliseconds> {
+        auto& waiters = state.waiters_;
+        auto best = bestWaiter(waiters, now);
+        if (waiters[best].id_ != id || !hasCapacity(state, memory)) {
+          return std::nullopt;
+        }
+        // If the best waiter may only run when the server is idle, no other
+        // query is waiting.
+        if (waiters[best].request_.onlyWhenIdle_ && state.numRunning_ > 0) {
+          return std::nullopt;
+        }
+        auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(
+            now - waiters[best].enqueueTime_);
+        waiters.erase(waiters.begin() + best);
+        ++state.numRunning_;
+        ++state.numAdmitted_;
+        state.reservedMemory_ += memory;
+        return waited;
+      });
+  if (!waitTime.has_value()) {
+    return std::nullopt;
+  }
+  // The next waiting query might also have enough resources.
+  wakeUpWaiters();
+  return Ticket{this, memory, waitTime.value()};
+}
+
+// _____________________________________________________________________________
+void QueryAdmissionController::withdraw(size_t id) {
+  state_.withWriteLock([id](State& state) {
+    ql::erase_if(state.waiters_,
+                 [id](const Waiter& waiter) { return waiter.id_ == id; });
+  });
+  // The withdrawn query might have blocked the other queries.
+  wakeUpWaiters();
+}
+
+// _____________________________________________________________________________
+void QueryAdmissionController::release(ad_utility::MemorySize reservedMemory) {
+  state_.withWriteLock([reservedMemory](State& state) {
+    AD_CORRECTNESS_CHECK(state.numRunning_ > 0);
+    --state.numRunning_;
+    state.reservedMemory_ -= reservedMemory;
+  });
+  wakeUpWaiters();
+}
+
+// _____________________________________________________________________________
+void QueryAdmissionController::wakeUpWaiters() {
+  std::vector<std::shared_ptr<net::steady_timer>> timers;
+  {
+    std::lock_guard lock{wakeUpMutex_};
+    ++numWakeUps_;
+    ql::ranges::copy(waitingTimers_ | ql::views::values,
+                     std::back_inserter(timers));
+  }
+  wakeUp_.notify_all();
+  // The timers may only be accessed on their executor.
+  for (auto& timer : timers) {
+    auto executor = timer->get_executor();
+    net::dispatch(executor, [timer = std::weak_ptr{timer}]() {
+      if (auto pointer = timer.lock()) {
+        pointer->cancel();
+      }
+    });
+  }
+}
+
+// _____________________________________________________________________________
+size_t QueryAdmissionController::getNumWakeUps() {
+  std::lock_guard lock{wakeUpMutex_};
+  return numWakeUps_;
+}
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::getStatistics() const -> Statistics {
+  return state_.withReadLock([](const State& state) {
+    return Statistics{state.numRunning_, state.waiters_.size(),
+                      state.numAdmitted_, state.numRejected_,
+                      state.reservedMemory_};
+  });
+}
+
+// _____________________________________________________________________________
+net::awaitable<QueryAdmissionController::Ticket>
+QueryAdmissionController::admit(
+    Request request, ad_utility::SharedCancellationHandle cancellationHandle) {
+  auto id = enqueue(request);
+  absl::Cleanup withdrawOnError{[this, id]() { withdraw(id); }};
+  // The timer is cancelled by `wakeUpWaiters`.
+  auto timer =
+      std::make_shared<net::steady_timer>(co_await net::this_coro::executor);
+  {
+    std::lock_guard lock{wakeUpMutex_};
+    waitingTimers_.emplace(id, timer);
+  }
+  absl::Cleanup unregisterTimer{[this, id]() {
+    std::lock_guard lock{wakeUpMutex_};
+    waitingTimers_.erase(id);
+  }};
+  while (true) {
+    if (auto ticket = tryAdmit(id); ticket.has_value()) {
+      std::move(withdrawOnError).Cancel();
+      if (ticket->waitTime() > std::chrono::milliseconds{0}) {
+        AD_LOG_INFO << "The query was admitted after waiting "
+                    << ticket->waitTime().count() << " ms" << std::endl;
+      }
+      co_return std::move(ticket).value();
+    }
+    cancellationHandle->throwIfCancelled();
+    // A wake-up that happens before the wait begins is dispatched to this
+    // executor, so it cancels the wait when it has begun.
+    timer->expires_after(DESIRED_CANCELLATION_CHECK_INTERVAL);
+    [[maybe_unused]] auto [error] =
+        co_await timer->async_wait(net::as_tuple(net::use_awaitable));
+  }
+}
+
+// _____________________________________________________________________________
+auto QueryAdmissionController::admitBlocking(
+    Request request, ad_utility::SharedCancellationHandle cancellationHandle)
+    -> Ticket {
+  auto id = enqueue(request);
+  absl::Cleanup withdrawOnError{[this, id]() { withdraw(id); }};
+  while (true) {
+    // Read the number of wake-ups before the attempt, s.t. no wake-up between
+    // the attempt and the wait is missed.
+    auto numWakeUps = getNumWakeUps();
+    if (auto ticket = tryAdmit(id); ticket.has_value()) {
+      std::move(withdrawOnError).Cancel();
+      return std::move(ticket).value();
+    }
+    cancellationHandle->throwIfCancelled();
+    std::unique_lock lock{wakeUpMutex_};
+    wakeUp_.wait_for(lock, DESIRED_CANCELLATION_CHECK_INTERVAL,
+                     [this, numWakeUps]() {
+                       return numWakeUps_ != numWakeUps;
+                     });
+  }
+}
@@ -0,0 +1,185 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYADMISSIONCONTROLLER_H
+#define QLEVER_SRC_ENGINE_QUERYADMISSIONCONTROLLER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "util/CancellationHandle.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+#include "util/http/beast.h"
+
+// The priority class of a query. Interactive queries are always admitted
+// before batch queries.
+enum class QueryPriority { Interactive, Batch };
+
+// Convert the `QueryPriority` to a string and back. `parseQueryPriority`
+// returns `std::nullopt` for an invalid string.
+std::string_view toString(QueryPriority priority);
+std::optional<QueryPriority> parseQueryPriority(std::string_view priority);
+
+// Admission control for the queries of the server. A query is only executed
+// after it has been admitted, and it is only admitted if fewer than
+// `admission-max-concurrent-queries` queries are running and if its memory
+// budget (`query-memory-budget`) can still be reserved from the memory limit
+// of the server. Queries that cannot be admitted immediately wait in a queue,
+// from which the interactive queries are admitted first, and within a priority
+// class the queries with the smallest cost estimate (which is reduced the
+// longer a query waits, s.t. expensive queries don't starve). The aging only
+// reorders the queries within a priority class, so a query that has waited
+// longer than `admission-starvation-timeout` is admitted before all other
+// queries (in the order of their arrival), s.t. batch queries don't starve
+// under a steady load of interactive queries. Queries that may only run when
+// the server is idle are admitted last. When the queue is full
+// (`admission-max-queue-length`), further queries are rejected. The waiting
+// queries are woken up whenever a query is admitted, finishes, or stops
+// waiting.
+class QueryAdmissionController {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // The properties of a query that are relevant for its admission.
+  struct Request {
+    QueryPriority priority_ = QueryPriority::Interactive;
+    // The cost estimate of the query planner.
+    size_t costEstimate_ = 0;
+    // If set, the query is only admitted when no other query is running or
+    // waiting, regardless of `admission-max-concurrent-queries` (e.g. for the
+    // queries that are replayed by the `CacheWarmup`).
+    bool onlyWhenIdle_ = false;
+  };
+
+  // A query holds a `Ticket` while it is executed. When the `Ticket` is
+  // destroyed, the slot and the memory budget of the query are released.
+  class Ticket {
+    QueryAdmissionController* controller_;
+    ad_utility::MemorySize reservedMemory_;
+    std::chrono::milliseconds waitTime_;
+
+    friend class QueryAdmissionController;
+    Ticket(QueryAdmissionController* controller,
+           ad_utility::MemorySize reservedMemory,
+           std::chrono::milliseconds waitTime)
+        : controller_{controller},
+          reservedMemory_{reservedMemory},
+          waitTime_{waitTime} {}
+
+   public:
+    Ticket(Ticket&& other) noexcept;
+    Ticket& operator=(Ticket&& other) noexcept;
+    Ticket(const Ticket&) = delete;
+    Ticket& operator=(const Ticket&) = delete;
+    ~Ticket();
+
+    // The time the query waited in the queue.
+    std::chrono::milliseconds waitTime() const { return waitTime_; }
+    // The memory that was reserved for the query.
+    ad_utility::MemorySize reservedMemory() const { return reservedMemory_; }
+  };
+
+  // Statistics for the `stats` command of the server.
+  struct Statistics {
+    size_t numRunning_ = 0;
+    size_t numWaiting_ = 0;
+    size_t numAdmitted_ = 0;
+    size_t numRejected_ = 0;
+    ad_utility::MemorySize reservedMemory_;
+  };
+
+ private:
+  struct Waiter {
+    size_t id_;
+    Request request_;
+    Clock::time_point enqueueTime_;
+  };
+
+  struct State {
+    size_t numRunning_ = 0;
+    ad_utility::MemorySize reservedMemory_;
+    std::vector<Waiter> waiters_;
+    size_t nextId_ = 0;
+    size_t numAdmitted_ = 0;
+    size_t numRejected_ = 0;
+  };
+
+  // The memory limit of the server, from which the budgets of the queries are
+  // reserved.
+  ad_utility::MemorySize totalMemory_;
+  ad_utility::Synchronized<State> state_;
+
+  // Used to wake up the waiting queries (see `wakeUpWaiters`). The timers
+  // of the queries that wait in `admit` are cancelled, the queries that wait
+  // in `admitBlocking` wait for the `wakeUp_` condition variable.
+  std::mutex wakeUpMutex_;
+  std::condition_variable wakeUp_;
+  size_t numWakeUps_ = 0;
+  ad_utility::HashMap<size_t, std::shared_ptr<boost::asio::steady_timer>>
+      waitingTimers_;
+
+ public:
+  explicit QueryAdmissionController(ad_utility::MemorySize totalMemory)
+      : totalMemory_{totalMemory} {}
+
+  // Wait until the query with the given `request` is admitted and return its
+  // `Ticket`. Throw an `HttpError` (503) if the queue is full, and a
+  // `CancellationException` if the `cancellationHandle` is cancelled (e.g.
+  // because the time limit of the query has expired) while waiting. This has
+  // to be called on a strand or in a single-threaded environment, because the
+  // wake-up of the query is dispatched to its executor.
+  boost::asio::awaitable<Ticket> admit(
+      Request request, ad_utility::SharedCancellationHandle cancellationHandle);
+
+  // Like `admit`, but block the calling thread while waiting. Used for the
+  // queries that are not executed on behalf of a request (see `CacheWarmup`).
+  Ticket admitBlocking(Request request,
+                       ad_utility::SharedCancellationHandle cancellationHandle);
+
+  // The memory budget of a single query, or `std::nullopt` if the budgets are
+  // disabled.
+  std::optional<ad_utility::MemorySize> memoryBudgetPerQuery() const;
+
+  Statistics getStatistics() const;
+
+  // The building blocks of `admit`, public for testing. `enqueue` adds the
+  // query to the queue (or throws if the queue is full) and returns its ID,
+  // `tryAdmit` admits the query with the given ID if it is the best waiting
+  // query and there are enough resources left, and `withdraw` removes the
+  // query from the queue.
+  size_t enqueue(Request request, Clock::time_point now = Clock::now());
+  std::optional<Ticket> tryAdmit(size_t id,
+                                 Clock::time_point now = Clock::now());
+  void withdraw(size_t id);
+
+ private:
+  // Release the resources of an admitted query, called by `~Ticket`.
+  void release(ad_utility::MemorySize reservedMemory);
+
+  // Wake up all waiting queries, s.t. they check if they can be admitted.
+  // Called whenever the resources or the queue change. The waiting queries
+  // also wake up regularly to check their cancellation handle.
+  void wakeUpWaiters();
+
+  // The current value of `numWakeUps_`.
+  size_t getNumWakeUps();
+
+  // Return true if one more query with the budget `memory` can be admitted.
+  bool hasCapacity(const State& state, ad_utility::MemorySize memory) const;
+
+  // The position of the waiter that is admitted next.
+  static size_t bestWaiter(const std::vector<Waiter>& waiters,
+                           Clock::time_point now);
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYADMISSIONCONTROLLER_H
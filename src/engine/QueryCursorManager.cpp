@@ -0,0 +1,145 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/QueryCursorManager.h"
+
+#include <absl/container/flat_hash_map.h>
+#include <absl/strings/str_cat.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "backports/algorithm.h"
+#include "engine/HttpError.h"
+#include "global/RuntimeParameters.h"
+#include "util/Exception.h"
+
+namespace http = boost::beast::http;
+
+// _____________________________________________________________________________
+ad_utility::MemorySize QueryCursorManager::memoryOfResult(
+    const Result& result) {
+  const auto& table = result.idTable();
+  return ad_utility::MemorySize::bytes(table.numRows() * table.numColumns() *
+                                       sizeof(Id));
+}
+
+// _____________________________________________________________________________
+void QueryCursorManager::removeExpired(State& state, Clock::time_point now) {
+  auto timeout = getRuntimeParameter<&RuntimeParameters::cursorTimeout_>();
+  absl::erase_if(state.cursors_, [&state, now, timeout](const auto& entry) {
+    const Cursor& cursor = entry.second;
+    if (now - cursor.lastAccess_ < timeout) {
+      return false;
+    }
+    state.memory_ -= cursor.memory_;
+    return true;
+  });
+}
+
+// _____________________________________________________________________________
+auto QueryCursorManager::findCursor(State& state, const std::string& id,
+                                    std::string_view client)
+    -> ad_utility::HashMap<std::string, Cursor>::iterator {
+  auto it = state.cursors_.find(id);
+  if (it != state.cursors_.end() && it->second.client_ != client) {
+    return state.cursors_.end();
+  }
+  return it;
+}
+
+// _____________________________________________________________________________
+std::string QueryCursorManager::open(CursorResult result, std::string client,
+                                     Clock::time_point now) {
+  AD_CONTRACT_CHECK(result.result_ != nullptr);
+  AD_CONTRACT_CHECK(result.rowBegin_ <= result.rowEnd_);
+  AD_CONTRACT_CHECK(result.rowEnd_ <= result.result_->idTable().numRows());
+  auto memory = memoryOfResult(*result.result_);
+  auto maxOpenPerClient =
+      getRuntimeParameter<&RuntimeParameters::cursorMaxOpenPerClient_>();
+  auto maxMemory = getRuntimeParameter<&RuntimeParameters::cursorMaxMemory_>();
+  auto cursorResult = std::make_shared<const CursorResult>(std::move(result));
+  return state_.withWriteLock([&](State& state) {
+    removeExpired(state, now);
+    auto numOpen = static_cast<size_t>(
+        ql::ranges::count_if(state.cursors_, [&client](const auto& entry) {
+          return entry.second.client_ == client;
+        }));
+    if (numOpen >= maxOpenPerClient) {
+      throw HttpError(http::status::too_many_requests,
+                      absl::StrCat("A client may have at most ",
+                                   maxOpenPerClient,
+                                   " open cursors, please close one of them "
+                                   "first"));
+    }
+    if (state.memory_ + memory > maxMemory) {
+      throw HttpError(
+          http::status::service_unavailable,
+          absl::StrCat("The result of the query (", memory.asString(),
+                       ") does not fit into the memory that is left for "
+                       "cursors, please try again later or without a cursor"));
+    }
+    auto id = state.generateId_();
+    state.memory_ += memory;
+    auto position = cursorResult->rowBegin_;
+    state.cursors_.emplace(id, Cursor{std::move(cursorResult),
+                                      std::move(client), memory, position,
+                                      now});
+    return id;
+  });
+}
+
+// _____________________________________________________________________________
+auto QueryCursorManager::nextPage(const std::string& id,
+                                  std::string_view client, size_t pageSize,
+                                  Clock::time_point now) -> Page {
+  AD_CONTRACT_CHECK(pageSize > 0);
+  return state_.withWriteLock([&](State& state) {
+    removeExpired(state, now);
+    auto it = findCursor(state, id, client);
+    if (it == state.cursors_.end()) {
+      throw HttpError(http::status::not_found,
+                      absl::StrCat("There is no open cursor with ID \"", id,
+                                   "\", it might have expired or all its "
+                                   "rows have already been fetched"));
+    }
+    Cursor& cursor = it->second;
+    auto rowEnd = cursor.result_->rowEnd_;
+    Page page{cursor.result_, cursor.position_,
+              cursor.position_ + std::min(pageSize, rowEnd - cursor.position_),
+              false};
+    page.isLast_ = page.end_ == rowEnd;
+    if (page.isLast_) {
+      state.memory_ -= cursor.memory_;
+      state.cursors_.erase(it);
+    } else {
+      cursor.position_ = page.end_;
+      cursor.lastAccess_ = now;
+    }
+    return page;
+  });
+}
+
+// _____________________________________________________________________________
+bool QueryCursorManager::close(const std::string& id, std::string_view client,
+                               Clock::time_point now) {
+  return state_.withWriteLock([&](State& state) {
+    removeExpired(state, now);
+    auto it = findCursor(state, id, client);
+    if (it == state.cursors_.end()) {
+      return false;
+    }
+    state.memory_ -= it->second.memory_;
+    state.cursors_.erase(it);
+    return true;
+  });
+}
+
+// _____________________________________________________________________________
+auto QueryCursorManager::getStatistics() const -> Statistics {
+  return state_.withReadLock([](const State& state) {
+    return Statistics{state.cursors_.size(), state.memory_};
+  });
+}
@@ -0,0 +1,125 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYCURSORMANAGER_H
+#define QLEVER_SRC_ENGINE_QUERYCURSORMANAGER_H
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "engine/Result.h"
+#include "engine/VariableToColumnMap.h"
+#include "parser/ParsedQuery.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Random.h"
+#include "util/Synchronized.h"
+#include "util/http/MediaTypes.h"
+
+// The server-side cursors for the queries that are sent with `cursor=true`.
+// The result of such a query is computed once and then kept in memory, s.t.
+// the client can fetch it page by page (`cmd=fetch-cursor`) and each page
+// only costs time proportional to its size (instead of re-executing the query
+// with an increasing OFFSET for each page). A cursor is closed after its last
+// page has been fetched, when the client closes it (`cmd=close-cursor`), or
+// when it has not been accessed for `cursor-timeout`. The number of open
+// cursors per client (`cursor-max-open-per-client`) and the memory of the
+// results of all open cursors (`cursor-max-memory`) are limited. A cursor can
+// only be fetched and closed by the client that opened it.
+class QueryCursorManager {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // The immutable part of a cursor, everything that is needed to export the
+  // rows of the result.
+  struct CursorResult {
+    // The query (e.g. for the selected variables or the CONSTRUCT template).
+    ParsedQuery parsedQuery_;
+    std::shared_ptr<const Result> result_;
+    VariableToColumnMap variableColumns_;
+    ad_utility::MediaType mediaType_;
+    // The rows `[rowBegin_, rowEnd_)` of the `result_` are the rows of the
+    // query (the LIMIT and OFFSET of the query are not necessarily applied to
+    // the `result_` itself).
+    size_t rowBegin_ = 0;
+    size_t rowEnd_ = 0;
+  };
+
+  // A single page of a cursor, the rows `[begin_, end_)` of its result.
+  struct Page {
+    std::shared_ptr<const CursorResult> cursor_;
+    size_t begin_ = 0;
+    size_t end_ = 0;
+    // True iff there are no rows after this page. The cursor is then already
+    // closed.
+    bool isLast_ = true;
+  };
+
+  // Statistics for the `stats` command of the server.
+  struct Statistics {
+    size_t numOpen_ = 0;
+    ad_utility::MemorySize memory_;
+  };
+
+ private:
+  struct Cursor {
+    std::shared_ptr<const CursorResult> result_;
+    std::string client_;
+    ad_utility::MemorySize memory_;
+    // The first row of the next page.
+    size_t position_;
+    Clock::time_point lastAccess_;
+  };
+
+  struct State {
+    ad_utility::HashMap<std::string, Cursor> cursors_;
+    ad_utility::MemorySize memory_;
+    ad_utility::UuidGenerator generateId_;
+  };
+  ad_utility::Synchronized<State> state_;
+
+ public:
+  // Open a cursor for the `result` on behalf of the `client` and return its
+  // ID. Throw an `HttpError` if the `client` already has
+  // `cursor-max-open-per-client` open cursors (429) or if the memory for the
+  // cursors is exhausted (503).
+  std::string open(CursorResult result, std::string client,
+                   Clock::time_point now = Clock::now());
+
+  // Return the next page of at most `pageSize` rows of the cursor with the
+  // given `id` and advance the cursor. Throw an `HttpError` (404) if there is
+  // no open cursor with this `id` (e.g. because it has expired), or if it was
+  // opened by a different `client`.
+  Page nextPage(const std::string& id, std::string_view client,
+                size_t pageSize, Clock::time_point now = Clock::now());
+
+  // Close the cursor with the given `id`. Return false if there was no open
+  // cursor with this `id` that was opened by the `client`.
+  bool close(const std::string& id, std::string_view client,
+             Clock::time_point now = Clock::now());
+
+  // Note: Expired cursors are only removed by the other functions, so they
+  // are still counted here.
+  Statistics getStatistics() const;
+
+  // The memory of the `result` that is accounted for a cursor. This is the
+  // size of its `IdTable`, the local vocabulary is not considered.
+  static ad_utility::MemorySize memoryOfResult(const Result& result);
+
+ private:
+  // Close all the cursors that have not been accessed for `cursor-timeout`.
+  static void removeExpired(State& state, Clock::time_point now);
+
+  // Return the open cursor with the given `id` if it was opened by the
+  // `client`, and `end()` otherwise. Cursors of other clients are treated as
+  // if they didn't exist, s.t. their IDs can't be probed.
+  static ad_utility::HashMap<std::string, Cursor>::iterator findCursor(
+      State& state, const std::string& id, std::string_view client);
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYCURSORMANAGER_H
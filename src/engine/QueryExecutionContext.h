@@ -16,6 +16,7 @@
 #include "engine/QueryPlanningCostFactors.h"
 #include "engine/Result.h"
 #include "engine/RuntimeInformation.h"
+#include "engine/SharedLazyResults.h"
 #include "engine/SortPerformanceEstimator.h"
 #include "global/Id.h"
 #include "index/DeltaTriples.h"
@@ -88,9 +89,21 @@ struct QueryCacheKey {
 
 // Threadsafe LRU cache for (partial) query results, that
 // checks on insertion, if the result is currently being computed
-// by another query.
-using QueryResultCache = ad_utility::ConcurrentCache<
-    ad_utility::LRUCache<QueryCacheKey, CacheValue, CacheValue::SizeGetter>>;
+// by another query. Results that are computed lazily are not stored in the
+// cache (unless they are small), but can be shared with concurrent queries via
+// `sharedLazyResults()`.
+class QueryResultCache
+    : public ad_utility::ConcurrentCache<ad_utility::LRUCache<
+          QueryCacheKey, CacheValue, CacheValue::SizeGetter>> {
+  SharedLazyResults<QueryCacheKey> sharedLazyResults_;
+
+ public:
+  using ConcurrentCache::ConcurrentCache;
+
+  SharedLazyResults<QueryCacheKey>& sharedLazyResults() {
+    return sharedLazyResults_;
+  }
+};
 
 // Forward declaration because of cyclic dependency
 class NamedResultCache;
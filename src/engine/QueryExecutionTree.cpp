@@ -161,6 +161,37 @@ void QueryExecutionTree::readFromCache() {
   }
 }
 
+// _____________________________________________________________________________
+void QueryExecutionTree::setExecutionContextAndReplaceOperations(
+    QueryExecutionContext* qec,
+    const ad_utility::HashMap<const Operation*, std::shared_ptr<Operation>>&
+        replacements) {
+  AD_CONTRACT_CHECK(qec != nullptr);
+  AD_CONTRACT_CHECK(rootOperation_);
+  if (auto it = replacements.find(rootOperation_.get());
+      it != replacements.end()) {
+    const auto& replacement = it->second;
+    AD_CONTRACT_CHECK(replacement != nullptr);
+    AD_CONTRACT_CHECK(replacement->getExternallyVisibleVariableColumns() ==
+                      getVariableColumns());
+    AD_CONTRACT_CHECK(replacement->getResultSortedOn() == resultSortedOn());
+    rootOperation_ = replacement;
+  }
+  // The children have to be handled first, because the cache key of an
+  // operation depends on the cache keys of its children.
+  for (auto* child : rootOperation_->getChildren()) {
+    if (child) {
+      child->setExecutionContextAndReplaceOperations(qec, replacements);
+    }
+  }
+  rootOperation_->setExecutionContext(qec);
+  qec_ = qec;
+  cachedResult_ = nullptr;
+  resultWidth_ = rootOperation_->getResultWidth();
+  cacheKey_ = rootOperation_->getCacheKey();
+  sizeEstimate_ = std::nullopt;
+}
+
 // ________________________________________________________________________________________________________________
 std::shared_ptr<QueryExecutionTree>
 QueryExecutionTree::createSortedTreeAnyPermutation(
@@ -15,6 +15,7 @@
 #include "engine/QueryExecutionContext.h"
 #include "parser/ParsedQuery.h"
 #include "parser/data/Types.h"
+#include "util/HashMap.h"
 #include "util/HashSet.h"
 
 // Strongly typed enum for controlling whether stripped variables are explicitly
@@ -310,6 +311,20 @@ class QueryExecutionTree {
                                 qec_, rootOperation_->clone())
                           : std::make_shared<QueryExecutionTree>(qec_);
   }
+
+  // Set the `QueryExecutionContext` of this tree and of all its descendants to
+  // `qec`. Additionally, each operation in the tree that is a key in
+  // `replacements` is replaced by the corresponding value, which must have the
+  // same result columns and sort order. The cache keys are then recomputed
+  // bottom-up. Results are not read from the cache, call `readFromCache` if
+  // this is required. The tree must not have been executed yet and must not
+  // share operations with other trees (e.g. it must be a fresh `clone()`).
+  // This is used by the `QueryPlanCache` to reuse a plan in the context of a
+  // different query.
+  void setExecutionContextAndReplaceOperations(
+      QueryExecutionContext* qec,
+      const ad_utility::HashMap<const Operation*, std::shared_ptr<Operation>>&
+          replacements);
 };
 
 namespace ad_utility {
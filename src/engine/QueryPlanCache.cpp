@@ -0,0 +1,222 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/QueryPlanCache.h"
+
+#include "engine/IndexScan.h"
+#include "global/RuntimeParameters.h"
+#include "index/IndexImpl.h"
+#include "util/HashSet.h"
+
+// _____________________________________________________________________________
+QueryExecutionTree QueryPlanCache::getOrCreatePlan(
+    const PreparedStatement& statement, const ParsedQuery& parsedQuery,
+    QueryExecutionContext& qec, const PlanFunction& planFunction,
+    const MakeContext& makeContextForCache) {
+  auto maxNumEntries =
+      getRuntimeParameter<&RuntimeParameters::queryPlanCacheMaxNumEntries_>();
+  // Without cache keys, the plans cannot be validated.
+  if (maxNumEntries == 0 || qec.disableCaching()) {
+    return planFunction();
+  }
+  // Note: The values have to be extracted before the query is planned,
+  // because the query planner might modify the `parsedQuery`.
+  auto values = statement.getParameterValues(parsedQuery);
+  if (!values.has_value()) {
+    return planFunction();
+  }
+
+  auto key = statement.cacheKey();
+  std::optional<Entry> entry;
+  std::shared_ptr<QueryExecutionTree> clone;
+  {
+    auto lock = cache_.wlock();
+    lock->setMaxNumEntries(maxNumEntries);
+    if (auto cached = (*lock)[key]) {
+      entry = *cached;
+      // The clone is created while holding the lock, because the operations
+      // of the cached plan lazily compute some of their members.
+      if (entry->status_ != Status::NotReusable) {
+        clone = entry->plan_->clone();
+      }
+    }
+  }
+
+  std::optional<QueryExecutionTree> rebound;
+  if (clone != nullptr) {
+    rebound = rebindPlan(std::move(clone), entry->parameterValues_,
+                         values.value(), statement, qec);
+  }
+  if (entry.has_value() && entry->status_ == Status::Validated &&
+      rebound.has_value()) {
+    ++numHits_;
+    return std::move(rebound).value();
+  }
+
+  ++numMisses_;
+  auto plan = planFunction();
+  if (!entry.has_value()) {
+    store(key, plan, std::move(values).value(), Status::Unvalidated,
+          makeContextForCache);
+  } else if (entry->status_ == Status::Unvalidated) {
+    // If the rebound plan differs from the fresh plan, the plan depends on the
+    // values of the parameters. Otherwise, the plan can only be considered
+    // independent of the values if all the values have changed.
+    bool isSamePlan =
+        rebound.has_value() && rebound->getCacheKey() == plan.getCacheKey();
+    bool allValuesChanged =
+        ql::ranges::all_of(values.value(), [&entry](const auto& nameAndValue) {
+          return entry->parameterValues_.at(nameAndValue.first) !=
+                 nameAndValue.second;
+        });
+    if (!isSamePlan) {
+      store(key, plan, std::move(values).value(), Status::NotReusable,
+            makeContextForCache);
+    } else if (allValuesChanged) {
+      store(key, plan, std::move(values).value(), Status::Validated,
+            makeContextForCache);
+    }
+  }
+  return plan;
+}
+
+// _____________________________________________________________________________
+std::optional<QueryExecutionTree> QueryPlanCache::rebindPlan(
+    std::shared_ptr<QueryExecutionTree> plan,
+    const PreparedStatement::ParameterValues& oldValues,
+    const PreparedStatement::ParameterValues& newValues,
+    const PreparedStatement& statement, QueryExecutionContext& qec) {
+  AD_CONTRACT_CHECK(plan != nullptr);
+  // Determine the constants that have to be replaced. This is only possible if
+  // all the parameters that were bound to the same constant change in the same
+  // way.
+  ad_utility::HashMap<TripleComponent, TripleComponent> substitutions;
+  ad_utility::HashSet<TripleComponent> unchangedValues;
+  size_t numExpectedSubstitutions = 0;
+  for (const auto& [name, slots] : statement.parameterSlots()) {
+    const auto& oldValue = oldValues.at(name);
+    const auto& newValue = newValues.at(name);
+    if (oldValue == newValue) {
+      unchangedValues.insert(oldValue);
+      continue;
+    }
+    auto [it, isNew] = substitutions.try_emplace(oldValue, newValue);
+    if (!isNew && it->second != newValue) {
+      return std::nullopt;
+    }
+    numExpectedSubstitutions += slots.size();
+  }
+  if (ql::ranges::any_of(unchangedValues, [&substitutions](const auto& value) {
+        return substitutions.contains(value);
+      })) {
+    return std::nullopt;
+  }
+  // If a constant of the template is equal to one of the replaced values, then
+  // the index scans cannot tell apart the occurrences of the parameter from
+  // those of the constant.
+  if (ql::ranges::any_of(substitutions | ql::views::keys,
+                         [&statement](const auto& value) {
+                           return statement.constants().contains(value);
+                         })) {
+    return std::nullopt;
+  }
+
+  // Replace the `IndexScan`s that contain one of the constants. The scans on
+  // the ordinary permutations additionally have to use the located triples of
+  // the `qec`, which might be newer than the ones of the cached plan. Other
+  // scans (e.g. of materialized views) keep their own located triples.
+  const auto& index = qec.getIndex().getImpl();
+  ad_utility::HashMap<const Operation*, std::shared_ptr<Operation>>
+      replacements;
+  size_t numSubstitutions = 0;
+  bool success = true;
+  auto handleTree = [&](QueryExecutionTree* tree) {
+    auto scan = std::dynamic_pointer_cast<IndexScan>(tree->getRootOperation());
+    if (scan == nullptr) {
+      return;
+    }
+    size_t numSubstitutionsInScan = 0;
+    for (const TripleComponent* tc :
+         {&scan->subject(), &scan->predicate(), &scan->object()}) {
+      if (!tc->isVariable() && substitutions.contains(*tc)) {
+        ++numSubstitutionsInScan;
+      }
+    }
+    const auto& permutation = scan->permutation();
+    bool isOrdinaryPermutation =
+        &permutation == &index.getPermutation(permutation.permutation());
+    bool locatedTriplesChanged =
+        isOrdinaryPermutation &&
+        scan->locatedTriplesSharedState() != qec.locatedTriplesSharedState();
+    if (numSubstitutionsInScan == 0 && !locatedTriplesChanged) {
+      return;
+    }
+    auto replacement = scan->makeCopyWithSubstitutedConstants(
+        &qec,
+        isOrdinaryPermutation ? qec.locatedTriplesSharedState()
+                              : scan->locatedTriplesSharedState(),
+        substitutions);
+    if (replacement == nullptr) {
+      success = false;
+      return;
+    }
+    numSubstitutions += numSubstitutionsInScan;
+    replacements.emplace(scan.get(), std::move(replacement));
+  };
+  handleTree(plan.get());
+  plan->forAllDescendants(handleTree);
+  // None of the replaced values is a constant of the template (see above), so
+  // each replaced constant of a scan is an occurrence of a parameter. If the
+  // numbers don't match, then some of the parameters are not constants of an
+  // `IndexScan` (e.g. because the query planner turned a triple into a
+  // different operation), and the plan cannot be rebound.
+  if (!success || numSubstitutions != numExpectedSubstitutions) {
+    return std::nullopt;
+  }
+
+  plan->setExecutionContextAndReplaceOperations(&qec, replacements);
+  plan->readFromCache();
+  plan->forAllDescendants(
+      [](QueryExecutionTree* tree) { tree->readFromCache(); });
+  return std::move(*plan);
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::store(const Key& key, const QueryExecutionTree& plan,
+                           PreparedStatement::ParameterValues values,
+                           Status status,
+                           const MakeContext& makeContextForCache) {
+  auto cacheQec = makeContextForCache();
+  auto cachedPlan = plan.clone();
+  cachedPlan->setExecutionContextAndReplaceOperations(cacheQec.get(), {});
+  auto lock = cache_.wlock();
+  // The underlying cache throws on insert if the key is already present.
+  lock->erase(key);
+  lock->insert(key, Entry{std::move(cacheQec), std::move(cachedPlan),
+                          std::move(values), status});
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::onDeltaTriplesChanged(size_t numDeltaTriples,
+                                           size_t numTriplesInIndex) {
+  auto maxRatio = getRuntimeParameter<
+      &RuntimeParameters::queryPlanCacheMaxDeltaTriplesRatio_>();
+  auto lock = numDeltaTriplesAtLastClear_.wlock();
+  size_t difference = numDeltaTriples > *lock ? numDeltaTriples - *lock
+                                              : *lock - numDeltaTriples;
+  if (static_cast<double>(difference) >
+      maxRatio * static_cast<double>(numTriplesInIndex)) {
+    clear();
+    *lock = numDeltaTriples;
+  }
+}
+
+// _____________________________________________________________________________
+void QueryPlanCache::clear() { cache_.wlock()->clearAll(); }
+
+// _____________________________________________________________________________
+size_t QueryPlanCache::numEntries() const {
+  return cache_.rlock()->numNonPinnedEntries();
+}
@@ -0,0 +1,122 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
+#define QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "engine/PreparedStatement.h"
+#include "engine/QueryExecutionContext.h"
+#include "engine/QueryExecutionTree.h"
+#include "util/Cache.h"
+#include "util/Synchronized.h"
+
+// A thread-safe cache for the query plans of `PreparedStatement`s. For a
+// rebindable statement, the plan for one set of parameter values is turned
+// into the plan for another set of values by replacing the constants of the
+// affected `IndexScan`s, which avoids running the query planner.
+//
+// A cached plan is only reused after it has been validated: For the first
+// execution with different values for all the parameters, the query is
+// planned as usual and the plan is compared to the rebound cached plan. If
+// they are the same, the cached plan is reused for all later executions, else
+// the plans of the statement are never reused. Note that the reused plan is
+// always correct, but it might be less efficient than a freshly planned one if
+// the optimal join order depends on the values of the parameters.
+class QueryPlanCache {
+ public:
+  // The state of a cached plan, see above.
+  enum class Status { Unvalidated, Validated, NotReusable };
+
+  // A cached plan. The plan uses its own `QueryExecutionContext`, because the
+  // context of the query that created the plan (which might e.g. hold a
+  // websocket connection) must not be kept alive. The plan is never executed,
+  // only clones of it. Note: `qec_` must be declared before `plan_`, s.t. it
+  // is destroyed after it.
+  struct Entry {
+    std::shared_ptr<QueryExecutionContext> qec_;
+    std::shared_ptr<const QueryExecutionTree> plan_;
+    PreparedStatement::ParameterValues parameterValues_;
+    Status status_ = Status::Unvalidated;
+  };
+
+  // Each cached plan counts as one entry.
+  struct ValueSizeGetter {
+    ad_utility::MemorySize operator()(const Entry&) const {
+      return ad_utility::MemorySize::bytes(1);
+    }
+  };
+
+  // The key is the `PreparedStatement::cacheKey()`.
+  using Key = std::string;
+  using Cache = ad_utility::LRUCache<Key, Entry, ValueSizeGetter>;
+
+  // Plan the query with the `QueryExecutionContext` of the current request.
+  using PlanFunction = std::function<QueryExecutionTree()>;
+  // Create a new `QueryExecutionContext` for a cached plan.
+  using MakeContext = std::function<std::shared_ptr<QueryExecutionContext>()>;
+
+ private:
+  ad_utility::Synchronized<Cache> cache_;
+
+  // The number of delta triples when the cache was last cleared, see
+  // `onDeltaTriplesChanged`.
+  ad_utility::Synchronized<size_t> numDeltaTriplesAtLastClear_{0};
+
+  // Statistics for `cache-stats`.
+  std::atomic<size_t> numHits_ = 0;
+  std::atomic<size_t> numMisses_ = 0;
+
+ public:
+  // Return the plan for the `parsedQuery` (which must be the result of parsing
+  // `statement.bindParameters(...)`) that uses the `qec`. Reuse a cached plan
+  // if possible, otherwise call the `planFunction` (which must plan the
+  // `parsedQuery` using the `qec`) and store its result in the cache (using a
+  // new context created by `makeContextForCache`).
+  QueryExecutionTree getOrCreatePlan(const PreparedStatement& statement,
+                                     const ParsedQuery& parsedQuery,
+                                     QueryExecutionContext& qec,
+                                     const PlanFunction& planFunction,
+                                     const MakeContext& makeContextForCache);
+
+  // Has to be called after each update with the current number of delta
+  // triples and the number of triples in the index. If the number of delta
+  // triples has changed significantly since the cache was last cleared (see
+  // the runtime parameter `query-plan-cache-max-delta-triples-ratio`), all the
+  // plans are discarded, because they were chosen based on outdated
+  // statistics.
+  void onDeltaTriplesChanged(size_t numDeltaTriples, size_t numTriplesInIndex);
+
+  // Discard all the cached plans.
+  void clear();
+
+  // Statistics.
+  size_t numEntries() const;
+  size_t numHits() const { return numHits_; }
+  size_t numMisses() const { return numMisses_; }
+
+  // Turn the `plan` (a fresh clone of a plan that was created for the
+  // `oldValues`) into a plan for the `newValues` that uses the `qec`. Return
+  // `std::nullopt` if this is not safely possible, e.g. because a parameter
+  // is not the constant of an `IndexScan`. Public for testing.
+  static std::optional<QueryExecutionTree> rebindPlan(
+      std::shared_ptr<QueryExecutionTree> plan,
+      const PreparedStatement::ParameterValues& oldValues,
+      const PreparedStatement::ParameterValues& newValues,
+      const PreparedStatement& statement, QueryExecutionContext& qec);
+
+ private:
+  // Store the `plan` in the cache.
+  void store(const Key& key, const QueryExecutionTree& plan,
+             PreparedStatement::ParameterValues values, Status status,
+             const MakeContext& makeContextForCache);
+};
+
+#endif  // QLEVER_SRC_ENGINE_QUERYPLANCACHE_H
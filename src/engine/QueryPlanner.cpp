@@ -19,6 +19,7 @@
 #include "backports/StartsWithAndEndsWith.h"
 #include "backports/algorithm.h"
 #include "backports/type_traits.h"
+#include "engine/AdaptiveJoin.h"
 #include "engine/Bind.h"
 #include "engine/CartesianProductJoin.h"
 #include "engine/CheckUsePatternTrick.h"
@@ -36,6 +37,7 @@
 #include "engine/MaterializedViews.h"
 #include "engine/Minus.h"
 #include "engine/MultiColumnJoin.h"
+#include "engine/MultiwayJoin.h"
 #include "engine/NamedResultCache.h"
 #include "engine/NeutralElementOperation.h"
 #include "engine/NeutralOptional.h"
@@ -138,6 +140,19 @@ std::vector<SubtreePlan> QueryPlanner::createExecutionTrees(ParsedQuery& pq,
     AD_CORRECTNESS_CHECK(pq.datasetClauses_.isUnconstrainedOrWithClause());
   }
 
+  // If the query aggregates the solutions of a basic graph pattern, it can
+  // possibly be answered by re-aggregating a materialized view that stores
+  // pre-aggregated results. The views are computed on the default graph.
+  if (!isSubquery && !activeDatasetClauses_.activeDefaultGraphs().has_value() &&
+      getRuntimeParameter<
+          &RuntimeParameters::enableMaterializedViewQueryRewrite_>()) {
+    auto rewritten =
+        _qec->materializedViewsManager().makeAggregateRewrite(_qec, pq);
+    if (rewritten.has_value()) {
+      pq = std::move(rewritten.value());
+    }
+  }
+
   // Look for ql:has-predicate to determine if the pattern trick should be used.
   // If the pattern trick is used, the ql:has-predicate triple will be removed
   // from the list of where clause triples. Otherwise, the ql:has-predicate
@@ -268,6 +283,35 @@ QueryExecutionTree QueryPlanner::createExecutionTree(ParsedQuery& pq,
   }
 }
 
+// _____________________________________________________________________________
+std::shared_ptr<QueryExecutionTree> QueryPlanner::createJoinTree(
+    std::vector<std::shared_ptr<QueryExecutionTree>> subtrees) {
+  AD_CONTRACT_CHECK(!subtrees.empty());
+  AD_CONTRACT_CHECK(subtrees.size() <= 64,
+                    "At most 64 subtrees can be joined at once");
+  std::vector<SubtreePlan> seeds;
+  for (size_t i = 0; i < subtrees.size(); ++i) {
+    SubtreePlan plan{_qec};
+    plan._qet = std::move(subtrees.at(i));
+    plan._idsOfIncludedNodes = uint64_t{1} << i;
+    seeds.push_back(std::move(plan));
+  }
+  std::vector<const SubtreePlan*> graph;
+  for (const auto& plan : seeds) {
+    graph.push_back(&plan);
+  }
+  const size_t budget =
+      getRuntimeParameter<&RuntimeParameters::queryPlanningBudget_>();
+  auto impl = countSubgraphs(graph, {}, budget) > budget
+                  ? &QueryPlanner::runGreedyPlanningOnConnectedComponent
+                  : &QueryPlanner::runDynamicProgrammingOnConnectedComponent;
+  auto candidates =
+      std::invoke(impl, this, std::move(seeds), FiltersAndOptionalSubstitutes{},
+                  TextLimitVec{}, TripleGraph{}, ReplacementPlans{});
+  AD_CORRECTNESS_CHECK(!candidates.empty());
+  return std::move(candidates.at(findCheapestExecutionTree(candidates))._qet);
+}
+
 // _____________________________________________________________________________
 std::vector<SubtreePlan> QueryPlanner::optimize(
     ParsedQuery::GraphPattern* rootPattern) {
@@ -1744,6 +1788,166 @@ std::vector<SubtreePlan> QueryPlanner::runGreedyPlanningOnConnectedComponent(
   return result;
 }
 
+// _____________________________________________________________________________
+bool QueryPlanner::isCyclicComponentOfIndexScans(
+    const std::vector<SubtreePlan>& seeds) const {
+  if (isInTestMode() ||
+      !getRuntimeParameter<&RuntimeParameters::enableMultiwayJoin_>()) {
+    return false;
+  }
+  // One hyperedge (the sorted set of variables) per triple.
+  ad_utility::HashMap<uint64_t, std::vector<Variable>> edgesByNode;
+  for (const auto& plan : seeds) {
+    const auto& qet = *plan._qet;
+    if (absl::popcount(plan._idsOfIncludedNodes) != 1 ||
+        plan._idsOfIncludedFilters != 0 || plan.type != SubtreePlan::BASIC ||
+        dynamic_cast<const IndexScan*>(qet.getRootOperation().get()) ==
+            nullptr ||
+        qet.getVariableColumns().size() != qet.getResultWidth()) {
+      return false;
+    }
+    auto& edge = edgesByNode[plan._idsOfIncludedNodes];
+    if (edge.empty()) {
+      for (const auto& [var, info] : qet.getVariableColumns()) {
+        if (info.mightContainUndef_ != ColumnIndexAndTypeInfo::AlwaysDefined) {
+          return false;
+        }
+        edge.push_back(var);
+      }
+      ql::ranges::sort(edge);
+    }
+  }
+
+  // The GYO reduction: Repeatedly remove variables that occur in only one
+  // hyperedge, and hyperedges that are contained in another hyperedge. The
+  // hypergraph is acyclic iff this reduces it to at most one hyperedge.
+  std::vector<std::vector<Variable>> edges;
+  ql::ranges::copy(edgesByNode | ql::views::values, std::back_inserter(edges));
+  bool changed = true;
+  while (changed && edges.size() > 1) {
+    changed = false;
+    ad_utility::HashMap<Variable, size_t> numOccurrences;
+    for (const auto& edge : edges) {
+      for (const auto& var : edge) {
+        ++numOccurrences[var];
+      }
+    }
+    for (auto& edge : edges) {
+      auto numErased = ql::erase_if(edge, [&numOccurrences](const auto& var) {
+        return numOccurrences.at(var) == 1;
+      });
+      changed = changed || numErased > 0;
+    }
+    for (size_t i = 0; i < edges.size(); ++i) {
+      bool isContainedInOtherEdge = false;
+      for (size_t j = 0; j < edges.size() && !isContainedInOtherEdge; ++j) {
+        isContainedInOtherEdge =
+            i != j && std::includes(edges[j].begin(), edges[j].end(),
+                                    edges[i].begin(), edges[i].end());
+      }
+      if (isContainedInOtherEdge) {
+        edges.erase(edges.begin() + i);
+        changed = true;
+        break;
+      }
+    }
+  }
+  return edges.size() > 1;
+}
+
+// _____________________________________________________________________________
+std::vector<SubtreePlan> QueryPlanner::createMultiwayJoinCandidates(
+    const std::vector<SubtreePlan>& seeds,
+    const std::vector<SubtreePlan>& binaryJoinPlans) const {
+  if (binaryJoinPlans.empty()) {
+    return {};
+  }
+  // Only consider the `MultiwayJoin` if the best plan from binary joins
+  // has an intermediate result that is larger than all the inputs together,
+  // which the `MultiwayJoin` reads only once. Note: The estimate of the final
+  // result is not suited for this comparison, because it is derived from the
+  // (equally blown up) estimates of the intermediate results.
+  const auto& bestBinaryPlan =
+      binaryJoinPlans.at(findCheapestExecutionTree(binaryJoinPlans));
+  uint64_t finalSize = bestBinaryPlan._qet->getSizeEstimate();
+  uint64_t maxIntermediateSize = 0;
+  bestBinaryPlan._qet->forAllDescendants(
+      [&maxIntermediateSize](QueryExecutionTree* qet) {
+        if (!qet->getRootOperation()->getChildren().empty()) {
+          maxIntermediateSize =
+              std::max(maxIntermediateSize, qet->getSizeEstimate());
+        }
+      });
+  uint64_t inputSize = 0;
+  ad_utility::HashSet<uint64_t> coveredNodes;
+  for (const auto& plan : seeds) {
+    if (coveredNodes.insert(plan._idsOfIncludedNodes).second) {
+      inputSize += plan._qet->getSizeEstimate();
+    }
+  }
+  if (maxIntermediateSize <= inputSize ||
+      maxIntermediateSize <
+          getRuntimeParameter<
+              &RuntimeParameters::multiwayJoinMinIntermediateSize_>()) {
+    return {};
+  }
+
+  // Choose an order of the variables, where variables that occur in many
+  // triples come first. For each triple, prefer the index scan on the
+  // permutation that is sorted in this order, s.t. no sorting is required.
+  ad_utility::HashMap<uint64_t, std::vector<const SubtreePlan*>> plansByNode;
+  ad_utility::HashMap<Variable, size_t> numOccurrences;
+  for (const auto& plan : seeds) {
+    auto& plans = plansByNode[plan._idsOfIncludedNodes];
+    if (plans.empty()) {
+      for (const auto& var :
+           plan._qet->getVariableColumns() | ql::views::keys) {
+        ++numOccurrences[var];
+      }
+    }
+    plans.push_back(&plan);
+  }
+  auto isBefore = [&numOccurrences](const Variable& a, const Variable& b) {
+    auto occA = numOccurrences.at(a);
+    auto occB = numOccurrences.at(b);
+    return occA != occB ? occA > occB : a < b;
+  };
+  auto hasPreferredSortOrder = [&isBefore](const SubtreePlan* plan) {
+    const auto& qet = *plan->_qet;
+    const auto& sortedOn = qet.resultSortedOn();
+    if (sortedOn.size() != qet.getResultWidth()) {
+      return false;
+    }
+    for (size_t i = 1; i < sortedOn.size(); ++i) {
+      if (!isBefore(qet.getVariableAndInfoByColumnIndex(sortedOn[i - 1]).first,
+                    qet.getVariableAndInfoByColumnIndex(sortedOn[i]).first)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  MultiwayJoin::Children children;
+  uint64_t includedNodes = 0;
+  // Iterate in a deterministic order.
+  std::vector<uint64_t> nodeIds;
+  ql::ranges::copy(plansByNode | ql::views::keys, std::back_inserter(nodeIds));
+  ql::ranges::sort(nodeIds);
+  for (uint64_t nodeId : nodeIds) {
+    const auto& plans = plansByNode.at(nodeId);
+    auto it = ql::ranges::find_if(plans, hasPreferredSortOrder);
+    const SubtreePlan* chosen = it != plans.end() ? *it : plans.front();
+    children.push_back(chosen->_qet);
+    includedNodes |= nodeId;
+  }
+  auto plan =
+      makeSubtreePlan<MultiwayJoin>(_qec, std::move(children), finalSize);
+  plan._idsOfIncludedNodes = includedNodes;
+  std::vector<SubtreePlan> result;
+  result.push_back(std::move(plan));
+  return result;
+}
+
 // _____________________________________________________________________________
 QueryPlanner::FiltersAndOptionalSubstitutes QueryPlanner::seedFilterSubstitutes(
     const std::vector<SparqlFilter>& filters) const {
@@ -1822,6 +2026,13 @@ std::vector<std::vector<SubtreePlan>> QueryPlanner::fillDpTab(
 
     std::vector<SubtreePlan> lastDpRow;
 
+    // For cyclic patterns, we additionally consider a worst-case optimal join
+    // of all the triples, for which we need the original index scans.
+    std::vector<SubtreePlan> seedsForMultiwayJoin;
+    if (isCyclicComponentOfIndexScans(component)) {
+      seedsForMultiwayJoin = component;
+    }
+
     auto addCandidates = [&lastDpRow](std::vector<SubtreePlan> candidates) {
       std::move(candidates.begin(), candidates.end(),
                 std::back_inserter(lastDpRow));
@@ -1844,6 +2055,26 @@ std::vector<std::vector<SubtreePlan>> QueryPlanner::fillDpTab(
     addCandidates(std::invoke(impl, this, std::move(component),
                               filtersAndOptSubstitutes, textLimitVec, tg,
                               std::move(applicableReplacementPlans)));
+    if (!seedsForMultiwayJoin.empty()) {
+      auto multiwayJoinCandidates =
+          createMultiwayJoinCandidates(seedsForMultiwayJoin, lastDpRow);
+      applyFiltersIfPossible<FilterMode::ReplaceUnfilteredNoSubstitutes>(
+          multiwayJoinCandidates, filtersAndOptSubstitutes);
+      applyTextLimitsIfPossible(multiwayJoinCandidates, textLimitVec, true);
+      addCandidates(std::move(multiwayJoinCandidates));
+    }
+    // Let the joins of larger components be re-planned during the execution
+    // if the estimates turn out to be wrong.
+    if (absl::popcount(coveredNodes) >= 3 &&
+        getRuntimeParameter<
+            &RuntimeParameters::adaptiveJoinReoptimizationFactor_>() > 0.0) {
+      for (auto& plan : lastDpRow) {
+        if (AdaptiveJoin::isApplicable(*plan._qet)) {
+          plan._qet = ad_utility::makeExecutionTree<AdaptiveJoin>(
+              _qec, std::move(plan._qet));
+        }
+      }
+    }
     lastDpRowFromComponents.push_back(std::move(lastDpRow));
     checkCancellation();
   }
@@ -51,6 +51,13 @@ class QueryPlanner {
   QueryExecutionTree createExecutionTree(ParsedQuery& pq,
                                          bool isSubquery = false);
 
+  // Return the cheapest plan that joins all the `subtrees`, which must be
+  // connected via their variables. This is used to re-plan the remaining joins
+  // of a query during its execution, when the sizes of some of the `subtrees`
+  // are known exactly (see `AdaptiveJoin`).
+  std::shared_ptr<QueryExecutionTree> createJoinTree(
+      std::vector<std::shared_ptr<QueryExecutionTree>> subtrees);
+
   class TripleGraph {
    public:
     TripleGraph();
@@ -444,6 +451,23 @@ class QueryPlanner {
                                                       const SubtreePlan& b,
                                                       const JoinColumns& jcs);
 
+  // Return true iff all the `seeds` of a connected component are index scans
+  // that can be joined by a `MultiwayJoin`, and their join graph (the
+  // hypergraph with one hyperedge per triple that contains the variables of
+  // the triple) is cyclic.
+  bool isCyclicComponentOfIndexScans(
+      const std::vector<SubtreePlan>& seeds) const;
+
+  // Create a worst-case optimal `MultiwayJoin` of all the `seeds` of a cyclic
+  // connected component (see `isCyclicComponentOfIndexScans`). The candidate
+  // is only created if the cheapest of the `binaryJoinPlans` for the same
+  // component is estimated to have an intermediate result that is larger than
+  // all the `seeds` together. The result is either empty or contains a single
+  // plan.
+  std::vector<SubtreePlan> createMultiwayJoinCandidates(
+      const std::vector<SubtreePlan>& seeds,
+      const std::vector<SubtreePlan>& binaryJoinPlans) const;
+
   // Helper that generates `IndexScan` query plans on materialized views if they
   // can be used to avoid joins between some of the `triples`. The resulting
   // plans for part of the `triples` are given in a vector of query planning
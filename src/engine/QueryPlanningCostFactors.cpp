@@ -22,6 +22,9 @@ QueryPlanningCostFactors::QueryPlanningCostFactors() : _factors() {
   _factors["HASH_MAP_OPERATION_COST"] = 50.0;
   _factors["JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"] = 0.7;
   _factors["DUMMY_JOIN_SIZE_ESTIMATE_CORRECTION_FACTOR"] = 0.7;
+  // A seek in the leapfrog triejoin (see `MultiwayJoin`) is more expensive
+  // than a single step of a zipper join.
+  _factors["MULTIWAY_JOIN_SEEK_COST"] = 2.0;
 
   // Assume that a random disk seek is 100 times more expensive than an
   // average `O(1)` access to a single ID.
@@ -222,7 +222,11 @@ void to_json(nlohmann::ordered_json& j, const RuntimeInformation& rti) {
 void to_json(nlohmann::ordered_json& j,
              const RuntimeInformationWholeQuery& rti) {
   j = nlohmann::ordered_json{
-      {"time_query_planning", rti.timeQueryPlanning.count()}};
+      {"time_query_planning", rti.timeQueryPlanning.count()},
+      {"time_admission_queue", rti.timeAdmissionQueue.count()}};
+  if (!rti.admissionPriority.empty()) {
+    j["admission_priority"] = rti.admissionPriority;
+  }
 }
 
 // __________________________________________________________________________
@@ -154,6 +154,10 @@ struct RuntimeInformationWholeQuery {
   // The time spent during query planning (this does not include the time spent
   // on `IndexScan`s that were executed during the query planning).
   std::chrono::milliseconds timeQueryPlanning = RuntimeInformation::ZERO;
+  // The time the query waited for its admission (see
+  // `QueryAdmissionController`) and its priority class.
+  std::chrono::milliseconds timeAdmissionQueue = RuntimeInformation::ZERO;
+  std::string admissionPriority;
   /// Output as json. The signature of this function is mandated by the json
   /// library to allow for implicit conversion.
   friend void to_json(nlohmann::ordered_json& j,
@@ -12,13 +12,18 @@
 #include <absl/functional/bind_front.h>
 #include <absl/strings/str_cat.h>
 #include <absl/strings/str_join.h>
+#include <absl/strings/strip.h>
 
+#include <charconv>
+#include <limits>
 #include <string>
 #include <variant>
 #include <vector>
 
 #include "CompilationInfo.h"
+#include "backports/StartsWithAndEndsWith.h"
 #include "engine/ExecuteUpdate.h"
+#include "engine/ExplicitIdTableOperation.h"
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/GraphStoreProtocol.h"
 #include "engine/HttpError.h"
@@ -62,6 +67,7 @@ Server::Server(unsigned short port, size_t numThreads,
                    cache_.makeRoomAsMuchAsPossible(MAKE_ROOM_SLACK_FACTOR *
                                                    numMemoryToAllocate);
                  }},
+      admissionController_{maxMem},
       index_{std::make_shared<Index>(allocator_)},
       enablePatternTrick_(usePatternTrick),
       // The number of server threads currently also is the number of queries
@@ -83,7 +89,8 @@ Server::Server(unsigned short port, size_t numThreads,
 void Server::initialize(const std::string& indexBaseName, bool useText,
                         bool usePatterns, bool loadAllPermutations,
                         bool persistUpdates,
-                        std::vector<std::string> preloadMaterializedViews) {
+                        std::vector<std::string> preloadMaterializedViews,
+                        std::string cacheWarmupFile) {
   AD_LOG_INFO << "Initializing server ..." << std::endl;
 
   index().usePatterns() = usePatterns;
@@ -96,6 +103,7 @@ void Server::initialize(const std::string& indexBaseName, bool useText,
   }
 
   materializedViewsManager_->setOnDiskBase(indexBaseName);
+  deltaTriplesCompactor_.emplace(index().deltaTriplesManager());
 
   // Preload materialized views as requested by the user. This is done in a
   // try-catch block to prevent an exception during loading of a view from
@@ -113,6 +121,16 @@ void Server::initialize(const std::string& indexBaseName, bool useText,
       allocator_, index().numTriples().normalAndInternal_() *
                       PERCENTAGE_OF_TRIPLES_FOR_SORT_ESTIMATE / 100);
 
+  // Replay the hottest queries from before the restart in the background, the
+  // server already accepts requests in the meantime.
+  if (!cacheWarmupFile.empty()) {
+    cacheWarmup_.emplace(std::move(cacheWarmupFile),
+                         [this](const std::string& query,
+                                SharedCancellationHandle handle) {
+                           replayCacheWarmupQuery(query, std::move(handle));
+                         });
+  }
+
   if (noAccessCheck_) {
     AD_LOG_INFO << "No access token required for restricted API calls"
                 << std::endl;
@@ -126,7 +144,8 @@ void Server::initialize(const std::string& indexBaseName, bool useText,
 void Server::run(const std::string& indexBaseName, bool useText,
                  bool usePatterns, bool loadAllPermutations,
                  bool persistUpdates,
-                 std::vector<std::string> preloadMaterializedViews) {
+                 std::vector<std::string> preloadMaterializedViews,
+                 std::string cacheWarmupFile) {
   using namespace ad_utility::httpUtils;
 
   // Function that handles a request asynchronously, will be passed as argument
@@ -208,7 +227,8 @@ void Server::run(const std::string& indexBaseName, bool useText,
 
   // Initialize the index
   initialize(indexBaseName, useText, usePatterns, loadAllPermutations,
-             persistUpdates, std::move(preloadMaterializedViews));
+             persistUpdates, std::move(preloadMaterializedViews),
+             std::move(cacheWarmupFile));
 
   AD_LOG_INFO << "The server is ready, listening for requests on port "
               << std::to_string(httpServer.getPort()) << " ..." << std::endl;
@@ -328,7 +348,7 @@ auto Server::prepareOperation(
       std::make_shared<ad_utility::websocket::MessageSender>(
           std::move(messageSender));
   auto qec = std::make_shared<QueryExecutionContext>(
-      index_, &cache_, allocator_, sortPerformanceEstimator_,
+      index_, &cache_, makeOperationAllocator(), sortPerformanceEstimator_,
       &namedResultCache_, materializedViewsManager_,
       [sharedMessageSender = std::move(sharedMessageSender)](std::string json) {
         (*sharedMessageSender)(std::move(json));
@@ -422,6 +442,8 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     AD_LOG_INFO << "Processing command \"" << cmd.value() << "\"" << ": "
                 << actionMsg << std::endl;
   };
+  // Set by `cmd=execute`, see below.
+  std::shared_ptr<const PreparedStatement> preparedStatement;
   if (auto cmd = checkParameter("cmd", "stats")) {
     logCommand(cmd, "get index statistics");
     response = createJsonResponse(composeStatsJson(), request);
@@ -436,6 +458,7 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     requireValidAccessToken("clear-cache-complete");
     logCommand(cmd, "clear cache completely (including unpinned elements)");
     cache_.clearAll();
+    queryPlanCache_.clear();
     response = createJsonResponse(composeCacheStatsJson(), request);
   } else if (auto cmd = checkParameter("cmd", "clear-named-cache")) {
     requireValidAccessToken("clear-named-cache");
@@ -465,6 +488,12 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         },
         handle);
     auto countAfterClear = co_await std::move(coroutine);
+    // The incrementally maintained materialized views still contain the rows
+    // from the removed delta triples.
+    materializedViewsManager_->markAllViewsStale(
+        "the delta triples were cleared");
+    // The cached query plans might refer to the old delta triples.
+    queryPlanCache_.clear();
     response = createJsonResponse(json(countAfterClear), request);
   } else if (auto cmd = checkParameter("cmd", "vacuum-delta-triples")) {
     requireValidAccessToken("vacuum-delta-triples");
@@ -496,6 +525,35 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         handle);
     auto vacuumStats = co_await std::move(coroutine);
     response = createJsonResponse(vacuumStats, request);
+  } else if (auto cmd = checkParameter("cmd", "compact-delta-triples")) {
+    requireValidAccessToken("compact-delta-triples");
+    logCommand(cmd, "compact delta triples");
+
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    std::optional<TimeLimit> timeLimit =
+        co_await verifyUserSubmittedQueryTimeout(
+            checkParameter("timeout", std::nullopt), accessTokenOk, request,
+            send);
+    if (!timeLimit.has_value()) {
+      // If the optional is empty, this indicates an error response has been
+      // sent to the client already. We can stop here.
+      co_return;
+    }
+    auto cancelTimeoutOnDestruction =
+        cancelAfterDeadline(handle, timeLimit.value());
+
+    // Unlike the background compaction, compact all blocks that are large
+    // enough. The blocks are computed without holding the lock on the delta
+    // triples, so this does not have to run on the update thread.
+    auto coroutine = computeInNewThread(
+        queryThreadPool_,
+        [this, handle] {
+          return this->index().deltaTriplesManager().compact(
+              std::numeric_limits<size_t>::max(), handle);
+        },
+        handle);
+    auto compactionStats = co_await std::move(coroutine);
+    response = createJsonResponse(compactionStats, request);
   } else if (auto cmd = checkParameter("cmd", "get-settings")) {
     logCommand(cmd, "get server settings");
     response = createJsonResponse(
@@ -541,6 +599,21 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     AD_CONTRACT_CHECK(name.value() != "",
                       "The name for the view may not be empty");
 
+    // Extract the optional additional column orders of the view. Each is given
+    // via an 'additional-view' parameter of the form `NAME:?column`.
+    std::vector<MaterializedViewColumnOrder> additionalOrders;
+    if (auto it = parameters.find("additional-view"); it != parameters.end()) {
+      for (std::string_view value : it->second) {
+        auto sep = value.find(':');
+        AD_CONTRACT_CHECK(sep != std::string_view::npos,
+                          "The 'additional-view' parameter must have the form "
+                          "'NAME:?column'");
+        additionalOrders.push_back(
+            {std::string{value.substr(0, sep)},
+             Variable{std::string{value.substr(sep + 1)}}});
+      }
+    }
+
     // Extract query body.
     auto query = std::visit(
         [](const auto& op) -> Query {
@@ -568,9 +641,11 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         std::make_shared<ad_utility::CancellationHandle<>>();
     auto coroutine = computeInNewThread(
         queryThreadPool_,
-        [name, query, requestTimer, cancellationHandle, timeLimit, this] {
+        [name, query, requestTimer, cancellationHandle, timeLimit,
+         additionalOrders, this] {
           writeMaterializedView(name.value(), query, requestTimer,
-                                cancellationHandle, timeLimit.value());
+                                cancellationHandle, timeLimit.value(),
+                                additionalOrders);
         },
         cancellationHandle);
     co_await std::move(coroutine);
@@ -591,10 +666,115 @@ CPP_template_def(typename RequestT, typename ResponseT)(
     AD_CONTRACT_CHECK(name.has_value());
 
     materializedViewsManager_->loadView(name.value());
+    // The new view might be used by the query planner.
+    queryPlanCache_.clear();
 
     // Construct simple response JSON.
     nlohmann::json json{{"materialized-view-loaded", name.value()}};
     response = createJsonResponse(json, request);
+  } else if (auto cmd = checkParameter("cmd", "fetch-cursor")) {
+    logCommand(cmd, "fetch the next page of a cursor");
+    auto id = ad_utility::url_parser::getParameterCheckAtMostOnce(parameters,
+                                                                  "cursor");
+    if (!id.has_value()) {
+      throw std::runtime_error(
+          "Fetching a page requires the ID of the cursor to be set via the "
+          "'cursor' parameter");
+    }
+    auto page =
+        queryCursors_.nextPage(id.value(), determineCursorClient(request),
+                               determineCursorPageSize(parameters));
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    co_await sendCursorPage(request, send, id.value(), page, requestTimer,
+                            std::move(handle));
+    co_return;
+  } else if (auto cmd = checkParameter("cmd", "close-cursor")) {
+    logCommand(cmd, "close a cursor");
+    auto id = ad_utility::url_parser::getParameterCheckAtMostOnce(parameters,
+                                                                  "cursor");
+    if (!id.has_value()) {
+      throw std::runtime_error(
+          "Closing a cursor requires its ID to be set via the 'cursor' "
+          "parameter");
+    }
+    nlohmann::json json{
+        {"cursor", id.value()},
+        {"closed",
+         queryCursors_.close(id.value(), determineCursorClient(request))}};
+    response = createJsonResponse(json, request);
+  } else if (auto cmd = checkParameter("cmd", "prepare")) {
+    // The prepared statements are kept until they are replaced, so preparing
+    // them must not be possible for anonymous clients.
+    requireValidAccessToken("prepare");
+    logCommand(cmd, "prepare a statement");
+    auto name = ad_utility::url_parser::getParameterCheckAtMostOnce(
+        parameters, "statement-name");
+    if (!name.has_value() || name.value().empty()) {
+      throw std::runtime_error(
+          "Preparing a statement requires a non-empty name to be set via the "
+          "'statement-name' parameter");
+    }
+
+    // Extract the query template, see `PreparedStatement` for the syntax of
+    // the parameters.
+    auto query = std::visit(
+        [](const auto& op) -> Query {
+          using T = std::decay_t<decltype(op)>;
+          if constexpr (std::is_same_v<T, Query>) {
+            return op;
+          } else {
+            static_assert(
+                ad_utility::SameAsAny<T, Update, GraphStoreOperation, None>);
+            throw std::runtime_error(
+                "Action 'prepare' requires a SPARQL query.");
+          }
+        },
+        parsedHttpRequest.operation_);
+    auto statement = std::make_shared<const PreparedStatement>(
+        std::move(query.query_), std::move(query.datasetClauses_),
+        &index().encodedIriManager());
+
+    nlohmann::json json{{"prepared-statement", name.value()},
+                        {"parameters", statement->parameterNames()},
+                        {"rebindable", statement->isRebindable()}};
+    preparedStatements_.wlock()->insert_or_assign(name.value(),
+                                                  std::move(statement));
+    response = createJsonResponse(json, request);
+
+    // The template itself is not executed.
+    parsedHttpRequest.operation_ = None{};
+  } else if (auto cmd = checkParameter("cmd", "execute")) {
+    logCommand(cmd, "execute a prepared statement");
+    auto name = ad_utility::url_parser::getParameterCheckAtMostOnce(
+        parameters, "statement-name");
+    if (!name.has_value()) {
+      throw std::runtime_error(
+          "Executing a prepared statement requires its name to be set via the "
+          "'statement-name' parameter");
+    }
+    preparedStatement = [this, &name]() {
+      auto lock = preparedStatements_.rlock();
+      auto it = lock->find(name.value());
+      if (it == lock->end()) {
+        throw std::runtime_error(absl::StrCat("No statement with the name \"",
+                                              name.value(),
+                                              "\" has been prepared"));
+      }
+      return it->second;
+    }();
+
+    // The values of the parameters are passed as `$name=value`.
+    ad_utility::HashMap<std::string, std::string> values;
+    for (const auto& key : parameters | ql::views::keys) {
+      if (ql::starts_with(key, "$")) {
+        values[key.substr(1)] =
+            ad_utility::url_parser::getParameterCheckAtMostOnce(parameters, key)
+                .value();
+      }
+    }
+    parsedHttpRequest.operation_ =
+        Query{preparedStatement->bindParameters(values),
+              preparedStatement->datasetClauses()};
   }
 
   // Ping with or without message.
@@ -635,6 +815,8 @@ CPP_template_def(typename RequestT, typename ResponseT)(
                   << " to value \"" << value.value() << "\"" << std::endl;
       globalRuntimeParameters.wlock()->setFromString(
           key, std::string{value.value()});
+      // Many of the parameters influence the query planning.
+      queryPlanCache_.clear();
       response = createJsonResponse(
           json(globalRuntimeParameters.rlock()->toMap()), request);
     }
@@ -646,7 +828,7 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   std::optional<PlannedQuery> plannedQuery;
   auto visitOperation =
       [&checkParameter, &accessTokenOk, &request, &send, &parameters,
-       &requestTimer, &plannedQuery, this](
+       &requestTimer, &plannedQuery, &preparedStatement, this](
           std::vector<ParsedQuery> operations, std::string operationName,
           const std::string operationString,
           std::function<bool(const ParsedQuery&)> expectedOperation,
@@ -681,7 +863,8 @@ CPP_template_def(typename RequestT, typename ResponseT)(
                            query.hasConstructClause());
       co_return co_await processQuery(
           parameters, std::move(query), requestTimer, cancellationHandle, qec,
-          std::move(request), send, timeLimit.value(), plannedQuery);
+          std::move(request), send, timeLimit.value(), accessTokenOk,
+          plannedQuery, preparedStatement);
     }
   };
   auto visitQuery = [this, &visitOperation](Query query) -> Awaitable<void> {
@@ -779,13 +962,148 @@ std::pair<bool, bool> Server::determineResultPinning(
   return {pinSubresults, pinResult};
 }
 
+// ____________________________________________________________________________
+CPP_template_def(typename RequestT)(
+    requires ad_utility::httpUtils::HttpRequest<RequestT>) QueryPriority
+    Server::determineQueryPriority(const RequestT& request, size_t costEstimate,
+                                   bool accessTokenOk) {
+  std::string_view priorityHeader = request.base()["Query-Priority"];
+  auto priority = QueryPriority::Interactive;
+  if (!priorityHeader.empty()) {
+    auto parsed = parseQueryPriority(priorityHeader);
+    if (!parsed.has_value()) {
+      throw HttpError(
+          http::status::bad_request,
+          absl::StrCat("Invalid value \"", priorityHeader,
+                       "\" for the header \"Query-Priority\", must be "
+                       "\"interactive\" or \"batch\""));
+    }
+    priority = parsed.value();
+  }
+  auto maxInteractiveCost =
+      getRuntimeParameter<&RuntimeParameters::admissionInteractiveMaxCost_>();
+  if (!accessTokenOk && maxInteractiveCost != 0 &&
+      costEstimate > maxInteractiveCost) {
+    priority = QueryPriority::Batch;
+  }
+  return priority;
+}
+
+// ____________________________________________________________________________
+CPP_template_def(typename RequestT)(
+    requires ad_utility::httpUtils::HttpRequest<RequestT>) std::string
+    Server::determineCursorClient(const RequestT& request) {
+  std::string remoteAddress{
+      request.base()[ad_utility::httpUtils::REMOTE_ADDRESS_HEADER]};
+  auto trustedProxies =
+      getRuntimeParameter<&RuntimeParameters::cursorTrustedProxies_>();
+  std::string_view forwardedFor = request.base()["X-Forwarded-For"];
+  if (forwardedFor.empty() ||
+      !ad_utility::contains(trustedProxies, remoteAddress)) {
+    return remoteAddress;
+  }
+  // Only the last address was added by the trusted proxy, all the others
+  // might have been sent by the client.
+  auto lastComma = forwardedFor.rfind(',');
+  if (lastComma != std::string_view::npos) {
+    forwardedFor.remove_prefix(lastComma + 1);
+  }
+  return std::string{absl::StripAsciiWhitespace(forwardedFor)};
+}
+
+// ____________________________________________________________________________
+size_t Server::determineCursorPageSize(
+    const ad_utility::url_parser::ParamValueMap& params) {
+  auto pageSize =
+      ad_utility::url_parser::getParameterCheckAtMostOnce(params, "page-size");
+  if (!pageSize.has_value()) {
+    return std::max(
+        getRuntimeParameter<&RuntimeParameters::cursorDefaultPageSize_>(),
+        size_t{1});
+  }
+  const auto& value = pageSize.value();
+  size_t result = 0;
+  auto [ptr, ec] =
+      std::from_chars(value.data(), value.data() + value.size(), result);
+  if (ec != std::errc{} || ptr != value.data() + value.size() || result == 0) {
+    throw HttpError(http::status::bad_request,
+                    absl::StrCat("Invalid value \"", value,
+                                 "\" for the parameter \"page-size\", must "
+                                 "be a positive number"));
+  }
+  return result;
+}
+
+// ____________________________________________________________________________
+ad_utility::AllocatorWithLimit<Id> Server::makeOperationAllocator() const {
+  auto budget = admissionController_.memoryBudgetPerQuery();
+  if (!budget.has_value()) {
+    return allocator_;
+  }
+  // Clearing the cache only helps if the memory is missing in the pool of the
+  // whole server and not in the budget of the operation.
+  return ad_utility::AllocatorWithLimit<Id>{
+      ad_utility::makeAllocationMemoryLeftThreadsafeObject(
+          budget.value(), allocator_.getMemoryLeft()),
+      [serverAllocator = allocator_](ad_utility::MemorySize numMemory) {
+        if (serverAllocator.amountMemoryLeft() < numMemory) {
+          serverAllocator.clearOnAllocation()(numMemory);
+        }
+      }};
+}
+
+// ____________________________________________________________________________
+std::shared_ptr<QueryExecutionContext>
+Server::makeDefaultQueryExecutionContext() {
+  return std::make_shared<QueryExecutionContext>(
+      index_, &cache_, allocator_, sortPerformanceEstimator_,
+      &namedResultCache_, materializedViewsManager_);
+}
+
+// ____________________________________________________________________________
+void Server::replayCacheWarmupQuery(const std::string& query,
+                                    SharedCancellationHandle handle) {
+  ad_utility::Timer timer{ad_utility::Timer::Started};
+  auto defaultTimeout =
+      getRuntimeParameter<&RuntimeParameters::defaultQueryTimeout_>();
+  auto timeLimit = std::chrono::duration_cast<TimeLimit>(
+      decltype(defaultTimeout)::DurationType{defaultTimeout});
+  // Like the queries of the users, a replayed query may only use the memory
+  // budget that is reserved for it when it is admitted.
+  auto qec = std::make_shared<QueryExecutionContext>(
+      index_, &cache_, makeOperationAllocator(), sortPerformanceEstimator_,
+      &namedResultCache_, materializedViewsManager_);
+  auto plan =
+      planQuery(SparqlParser::parseQuery(&index().encodedIriManager(), query),
+                timer, timeLimit, *qec, handle);
+  auto& qet = plan.queryExecutionTree();
+  // The replayed queries must not slow down the queries of the users, so they
+  // are only started when no other query is running or waiting (also if the
+  // number of concurrent queries is unlimited). The time limit only starts
+  // when the query is admitted.
+  auto ticket = admissionController_.admitBlocking(
+      {QueryPriority::Batch, qet.getCostEstimate(), true}, handle);
+  qet.getRootOperation()->recursivelySetTimeConstraint(timeLimit);
+  absl::Cleanup cancelTimeout{cancelAfterDeadline(handle, timeLimit)};
+  [[maybe_unused]] auto result = qet.getResult();
+}
+
 // ____________________________________________________________________________
 Server::PlannedQuery Server::planQuery(
     ParsedQuery&& operation, const ad_utility::Timer& requestTimer,
     TimeLimit timeLimit, QueryExecutionContext& qec,
-    ad_utility::SharedCancellationHandle handle) const {
-  QueryPlanner qp(&qec, handle);
-  auto executionTree = qp.createExecutionTree(operation);
+    ad_utility::SharedCancellationHandle handle,
+    const PreparedStatement* preparedStatement) {
+  auto plan = [&qec, &handle, &operation]() {
+    QueryPlanner qp(&qec, handle);
+    return qp.createExecutionTree(operation);
+  };
+  auto executionTree =
+      preparedStatement != nullptr
+          ? queryPlanCache_.getOrCreatePlan(
+                *preparedStatement, operation, qec, plan,
+                [this]() { return makeDefaultQueryExecutionContext(); })
+          : plan();
   PlannedQuery plannedQuery{std::move(operation), std::move(executionTree),
                             qec};
   handle->throwIfCancelled();
@@ -859,6 +1177,12 @@ nlohmann::json Server::composeStatsJson() const {
   result["num-text-records"] = index().getNofTextRecords();
   result["num-word-occurrences"] = index().getNofWordPostings();
   result["num-entity-occurrences"] = index().getNofEntityPostings();
+  auto admission = admissionController_.getStatistics();
+  result["num-queries-running"] = admission.numRunning_;
+  result["num-queries-waiting"] = admission.numWaiting_;
+  result["num-queries-admitted"] = admission.numAdmitted_;
+  result["num-queries-rejected"] = admission.numRejected_;
+  result["num-open-cursors"] = queryCursors_.getStatistics().numOpen_;
   return result;
 }
 
@@ -868,6 +1192,9 @@ nlohmann::json Server::composeCacheStatsJson() const {
   result["num-results-unpinned"] = cache_.numNonPinnedEntries();
   result["num-results-pinned-unnamed"] = cache_.numPinnedEntries();
   result["num-results-pinned-named"] = namedResultCache_.numEntries();
+  result["num-query-plans"] = queryPlanCache_.numEntries();
+  result["num-query-plan-cache-hits"] = queryPlanCache_.numHits();
+  result["num-query-plan-cache-misses"] = queryPlanCache_.numMisses();
 
   // TODO: Get rid of the `getByte()`, once `MemorySize` has it's own JSON
   // converter.
@@ -943,6 +1270,44 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   }
 }
 
+// _____________________________________________________________________________
+CPP_template_def(typename RequestT, typename ResponseT)(
+    requires ad_utility::httpUtils::HttpRequest<RequestT>)
+    Awaitable<void> Server::sendCursorPage(
+        const RequestT& request, ResponseT& send, const std::string& cursorId,
+        const QueryCursorManager::Page& page,
+        const ad_utility::Timer& requestTimer,
+        SharedCancellationHandle handle) {
+  const auto& cursor = *page.cursor_;
+  const auto& result = cursor.result_;
+  // Export the rows of the page from the stored result (without copying it)
+  // with an `ExplicitIdTableOperation` and the LIMIT and OFFSET of the page.
+  auto qec = makeDefaultQueryExecutionContext();
+  std::shared_ptr<const IdTable> table{result, &result->idTable()};
+  auto qet = ad_utility::makeExecutionTree<ExplicitIdTableOperation>(
+      qec.get(), std::move(table), cursor.variableColumns_, result->sortedBy(),
+      result->localVocab().clone(), absl::StrCat("QueryCursor ", cursorId));
+  ParsedQuery parsedQuery = cursor.parsedQuery_;
+  parsedQuery._limitOffset =
+      LimitOffsetClause{page.end_ - page.begin_, page.begin_};
+  // The client fetches the next page with the ID from the header.
+  parsedQuery.responseMiddleware_ =
+      ResponseMiddleware{ResponseMiddleware::QueryMiddleware{
+          [cursorId, isLast = page.isLast_](auto response) {
+            if (!isLast) {
+              response.set("QLever-Cursor", cursorId);
+              response.set(http::field::access_control_expose_headers,
+                           "QLever-Cursor");
+            }
+            return response;
+          }}};
+  PlannedQuery plannedQuery{std::move(parsedQuery), *qet, *qec};
+  co_await sendStreamableResponse(request, send, cursor.mediaType_,
+                                  plannedQuery,
+                                  plannedQuery.queryExecutionTree(),
+                                  requestTimer, std::move(handle));
+}
+
 // ____________________________________________________________________________
 CPP_template_def(typename RequestT)(
     requires ad_utility::httpUtils::HttpRequest<RequestT>)
@@ -1041,7 +1406,9 @@ CPP_template_def(typename RequestT, typename ResponseT)(
         ParsedQuery&& query, const ad_utility::Timer& requestTimer,
         ad_utility::SharedCancellationHandle cancellationHandle,
         QueryExecutionContext& qec, const RequestT& request, ResponseT&& send,
-        TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery) {
+        TimeLimit timeLimit, bool accessTokenOk,
+        std::optional<PlannedQuery>& plannedQuery,
+        std::shared_ptr<const PreparedStatement> preparedStatement) {
   AD_CORRECTNESS_CHECK(!query.hasUpdateClause());
 
   auto mediaTypes = determineMediaTypes(params, request);
@@ -1063,15 +1430,27 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   // an explicit variable instead of directly `co_await`-ing it.
   auto coroutine = computeInNewThread(
       queryThreadPool_,
-      [this, &query, &requestTimer, &timeLimit, &qec,
-       &cancellationHandle]() -> std::optional<PlannedQuery> {
+      [this, &query, &requestTimer, &timeLimit, &qec, &cancellationHandle,
+       &preparedStatement]() -> std::optional<PlannedQuery> {
         return this->planQuery(std::move(query), requestTimer, timeLimit, qec,
-                               cancellationHandle);
+                               cancellationHandle, preparedStatement.get());
       },
       cancellationHandle);
   plannedQuery = co_await std::move(coroutine);
   auto qet = plannedQuery.value().queryExecutionTree();
 
+  // Wait until the query is admitted. The `ticket` holds the resources of the
+  // query until the result has been sent.
+  auto costEstimate = qet.getCostEstimate();
+  auto priority = determineQueryPriority(request, costEstimate, accessTokenOk);
+  auto admission = admissionController_.admit({priority, costEstimate},
+                                              cancellationHandle);
+  auto ticket = co_await std::move(admission);
+  auto& runtimeInfoWholeQuery =
+      qet.getRootOperation()->getRuntimeInfoWholeQuery();
+  runtimeInfoWholeQuery.timeAdmissionQueue = ticket.waitTime();
+  runtimeInfoWholeQuery.admissionPriority = toString(priority);
+
   MediaType mediaType = chooseBestFittingMediaType(
       mediaTypes, plannedQuery.value().parsedQuery());
 
@@ -1087,12 +1466,59 @@ CPP_template_def(typename RequestT, typename ResponseT)(
   // offset is not applied twice when exporting the query.
   adjustParsedQueryLimitOffset(plannedQuery.value(), mediaType, params);
 
-  // This actually processes the query and sends the result in the
-  // requested format.
-  co_await sendStreamableResponse(request, AD_FWD(send), mediaType,
-                                  plannedQuery.value(),
-                                  plannedQuery.value().queryExecutionTree(),
-                                  requestTimer, cancellationHandle);
+  if (ad_utility::url_parser::checkParameter(params, "cursor", "true")) {
+    // Compute the complete result, keep it in a cursor, and only send its
+    // first page, see `QueryCursorManager`.
+    const auto& parsedQuery = plannedQuery.value().parsedQuery();
+    if (parsedQuery.hasAskClause()) {
+      throw std::runtime_error("Cursors are not supported for ASK queries");
+    }
+    auto pageSize = determineCursorPageSize(params);
+    const auto& rootQet = plannedQuery.value().queryExecutionTree();
+    auto computation = computeInNewThread(
+        queryThreadPool_, [&rootQet]() { return rootQet.getResult(false); },
+        cancellationHandle);
+    std::shared_ptr<const Result> result = co_await std::move(computation);
+
+    // If the root operation doesn't apply the LIMIT and OFFSET itself, only
+    // a part of its result belongs to the cursor.
+    auto numRows = result->idTable().numRows();
+    const auto& limitOffset = parsedQuery._limitOffset;
+    bool limitOffsetApplied = rootQet.supportsLimitOffset();
+    QueryCursorManager::CursorResult cursor{
+        parsedQuery,
+        result,
+        rootQet.getVariableColumns(),
+        mediaType,
+        limitOffsetApplied ? 0 : limitOffset.actualOffset(numRows),
+        limitOffsetApplied ? numRows : limitOffset.upperBound(numRows)};
+    auto client = determineCursorClient(request);
+    auto id = queryCursors_.open(std::move(cursor), client);
+    co_await sendCursorPage(request, send, id,
+                            queryCursors_.nextPage(id, client, pageSize),
+                            requestTimer, cancellationHandle);
+  } else {
+    // This actually processes the query and sends the result in the
+    // requested format.
+    co_await sendStreamableResponse(request, AD_FWD(send), mediaType,
+                                    plannedQuery.value(),
+                                    plannedQuery.value().queryExecutionTree(),
+                                    requestTimer, cancellationHandle);
+  }
+  // Record the query for the cache warm-up after the next restart. Queries
+  // whose dataset is specified by the request parameters can't be replayed
+  // from the query string alone.
+  bool hasDatasetFromRequest =
+      params.contains("default-graph-uri") ||
+      params.contains("named-graph-uri") ||
+      (preparedStatement != nullptr &&
+       !preparedStatement->datasetClauses().empty());
+  if (cacheWarmup_.has_value() && !hasDatasetFromRequest) {
+    cacheWarmup_->recordQuery(
+        plannedQuery.value().parsedQuery()._originalString,
+        requestTimer.msecs());
+  }
+
   // Print the runtime info. This needs to be done after the query
   // was computed.
   AD_LOG_INFO << "Done processing query and sending result"
@@ -1149,6 +1575,9 @@ nlohmann::ordered_json Server::createResponseMetadataForUpdate(
         nlohmann::json(updateMetadata.countAfter_.value() -
                        updateMetadata.countBefore_.value());
   }
+  if (updateMetadata.throughput_.has_value()) {
+    response["throughput"] = nlohmann::json(updateMetadata.throughput_.value());
+  }
   response["time"] = tracer.getJSONShort()["update"];
   for (auto permutation : Permutation::ALL) {
     response["located-triples"][Permutation::toString(
@@ -1187,6 +1616,13 @@ UpdateMetadata Server::processUpdateImpl(
   // part of the cache key).
   cache_.clearAll();
   namedResultCache_.clear();
+  // The cached query plans are only discarded if the statistics have changed
+  // significantly.
+  const auto& countAfter = updateMetadata.countAfter_.value();
+  queryPlanCache_.onDeltaTriplesChanged(
+      static_cast<size_t>(countAfter.triplesInserted_ +
+                          countAfter.triplesDeleted_),
+      index().numTriples().normal);
   tracer.endTrace("clearCache");
 
   return updateMetadata;
@@ -1483,12 +1919,11 @@ void Server::writeMaterializedView(
     const std::string& name, const Query& query,
     const ad_utility::Timer& requestTimer,
     ad_utility::SharedCancellationHandle cancellationHandle,
-    TimeLimit timeLimit) {
+    TimeLimit timeLimit,
+    const std::vector<MaterializedViewColumnOrder>& additionalOrders) {
   auto parsedQuery = SparqlParser::parseQuery(
       &index().encodedIriManager(), query.query_, query.datasetClauses_);
-  auto qec = std::make_shared<QueryExecutionContext>(
-      index_, &cache_, allocator_, sortPerformanceEstimator_,
-      &namedResultCache_, materializedViewsManager_);
+  auto qec = makeDefaultQueryExecutionContext();
   auto plan = planQuery(std::move(parsedQuery), requestTimer, timeLimit, *qec,
                         cancellationHandle);
   auto qet = std::make_shared<QueryExecutionTree>(
@@ -1496,7 +1931,8 @@ void Server::writeMaterializedView(
   auto memoryLimit =
       getRuntimeParameter<&RuntimeParameters::materializedViewWriterMemory_>();
   materializedViewsManager_->writeViewToDisk(
-      name, {qet, qec, std::move(plan.parsedQuery())}, memoryLimit);
+      name, {qet, qec, std::move(plan.parsedQuery())}, memoryLimit,
+      ad_utility::makeUnlimitedAllocator<Id>(), additionalOrders);
 }
 
 // _____________________________________________________________________________
@@ -13,12 +13,18 @@
 #include <string>
 #include <vector>
 
+#include "engine/CacheWarmup.h"
 #include "engine/ExecuteUpdate.h"
 #include "engine/MaterializedViews.h"
 #include "engine/NamedResultCache.h"
+#include "engine/PreparedStatement.h"
+#include "engine/QueryAdmissionController.h"
+#include "engine/QueryCursorManager.h"
 #include "engine/QueryExecutionContext.h"
 #include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanCache.h"
 #include "engine/SortPerformanceEstimator.h"
+#include "index/DeltaTriplesCompactor.h"
 #include "index/IdTableUtils.h"
 #include "index/Index.h"
 #include "util/AllocatorWithLimit.h"
@@ -64,7 +70,8 @@ class Server {
   void initialize(const std::string& indexBaseName, bool useText,
                   bool usePatterns = true, bool loadAllPermutations = true,
                   bool persistUpdates = false,
-                  std::vector<std::string> preloadMaterializedViews = {});
+                  std::vector<std::string> preloadMaterializedViews = {},
+                  std::string cacheWarmupFile = "");
 
  public:
   // First initialize the server. Then loop, wait for requests and trigger
@@ -72,7 +79,8 @@ class Server {
   void run(const std::string& indexBaseName, bool useText,
            bool usePatterns = true, bool loadAllPermutations = true,
            bool persistUpdates = false,
-           std::vector<std::string> preloadMaterializedViews = {});
+           std::vector<std::string> preloadMaterializedViews = {},
+           std::string cacheWarmupFile = "");
 
   Index& index() { return *index_; }
   const Index& index() const { return *index_; }
@@ -122,11 +130,30 @@ class Server {
   bool noAccessCheck_;
   QueryResultCache cache_;
   NamedResultCache namedResultCache_;
+  QueryPlanCache queryPlanCache_;
+  // The prepared statements by their name, see `cmd=prepare`.
+  using PreparedStatements =
+      ad_utility::HashMap<std::string,
+                          std::shared_ptr<const PreparedStatement>>;
+  ad_utility::Synchronized<PreparedStatements> preparedStatements_;
   std::shared_ptr<MaterializedViewsManager> materializedViewsManager_ =
       std::make_shared<MaterializedViewsManager>();
   ad_utility::AllocatorWithLimit<Id> allocator_;
+  // Decides when a query is executed, see `QueryAdmissionController`.
+  QueryAdmissionController admissionController_;
+  // The server-side cursors of the queries with `cursor=true`.
+  QueryCursorManager queryCursors_;
   SortPerformanceEstimator sortPerformanceEstimator_;
   std::shared_ptr<Index> index_;
+  // Compacts the delta triples of the `index_` in the background. It is
+  // started in `initialize` and declared after the `index_`, s.t. it is
+  // stopped before the `index_` is destroyed.
+  std::optional<DeltaTriplesCompactor> deltaTriplesCompactor_;
+  // Records the executed queries and replays the hottest of them after a
+  // restart, see `CacheWarmup`. It is only started in `initialize` if a file
+  // for the queries is specified, and it is stopped before the `index_` is
+  // destroyed.
+  std::optional<CacheWarmup> cacheWarmup_;
   ad_utility::websocket::QueryRegistry queryRegistry_{};
 
   bool enablePatternTrick_;
@@ -219,7 +246,9 @@ class Server {
           ParsedQuery&& query, const ad_utility::Timer& requestTimer,
           ad_utility::SharedCancellationHandle cancellationHandle,
           QueryExecutionContext& qec, const RequestT& request, ResponseT&& send,
-          TimeLimit timeLimit, std::optional<PlannedQuery>& plannedQuery);
+          TimeLimit timeLimit, bool accessTokenOk,
+          std::optional<PlannedQuery>& plannedQuery,
+          std::shared_ptr<const PreparedStatement> preparedStatement = nullptr);
   // For an executed update create a JSON with some stats on the update (timing,
   // number of changed triples, etc.).
   static nlohmann::ordered_json createResponseMetadataForUpdate(
@@ -252,6 +281,31 @@ class Server {
   static std::pair<bool, bool> determineResultPinning(
       const ad_utility::url_parser::ParamValueMap& params);
   FRIEND_TEST(ServerTest, determineResultPinning);
+  // Determine the priority of a query from the `Query-Priority` header of the
+  // `request` (`interactive` or `batch`, the default is `interactive`). A query
+  // with a cost estimate above `admission-interactive-max-cost` is always a
+  // batch query, unless the request has a valid access token. Throws an
+  // `HttpError` for an invalid header value.
+  CPP_template(typename RequestT)(
+      requires ad_utility::httpUtils::HttpRequest<RequestT>) static
+      QueryPriority determineQueryPriority(const RequestT& request,
+                                           size_t costEstimate,
+                                           bool accessTokenOk);
+  FRIEND_TEST(ServerTest, determineQueryPriority);
+  // Determine the number of rows per page of a cursor from the `page-size`
+  // parameter (default: `cursor-default-page-size`). Throws if the parameter
+  // is not a positive number.
+  static size_t determineCursorPageSize(
+      const ad_utility::url_parser::ParamValueMap& params);
+  FRIEND_TEST(ServerTest, determineCursorPageSize);
+  // Determine the client on whose behalf a cursor is opened, fetched, or
+  // closed. This is the IP address of the connection of the `request`. If the
+  // connection comes from one of the `cursor-trusted-proxies`, it is the last
+  // address of the `X-Forwarded-For` header (which was added by the proxy).
+  CPP_template(typename RequestT)(
+      requires ad_utility::httpUtils::HttpRequest<RequestT>) static std::string
+      determineCursorClient(const RequestT& request);
+  FRIEND_TEST(ServerTest, determineCursorClient);
   //  Prepare the execution of an operation
   auto prepareOperation(std::string_view operationName,
                         std::string_view operationSPARQL,
@@ -274,11 +328,28 @@ class Server {
       const std::optional<std::string>& pinNamedGeoIndex, bool accessTokenOk,
       QueryExecutionContext& qec);
 
-  // Plan a parsed query.
-  PlannedQuery planQuery(ParsedQuery&& operation,
-                         const ad_utility::Timer& requestTimer,
-                         TimeLimit timeLimit, QueryExecutionContext& qec,
-                         SharedCancellationHandle handle) const;
+  // Plan a parsed query. If the query was created from a `preparedStatement`,
+  // then the plan might be taken from the `queryPlanCache_`.
+  PlannedQuery planQuery(
+      ParsedQuery&& operation, const ad_utility::Timer& requestTimer,
+      TimeLimit timeLimit, QueryExecutionContext& qec,
+      SharedCancellationHandle handle,
+      const PreparedStatement* preparedStatement = nullptr);
+
+  // Return the allocator for a single operation. If `query-memory-budget` is
+  // set, the operation may only allocate that much memory (in addition to the
+  // limit of the whole server).
+  ad_utility::AllocatorWithLimit<Id> makeOperationAllocator() const;
+
+  // Plan and compute the given query when the server is idle and with the
+  // default time limit, without sending its result anywhere. Used to replay
+  // the queries of the `cacheWarmup_`.
+  void replayCacheWarmupQuery(const std::string& query,
+                              SharedCancellationHandle handle);
+
+  // Create a `QueryExecutionContext` without a websocket connection and
+  // without pinning, e.g. for the plans in the `queryPlanCache_`.
+  std::shared_ptr<QueryExecutionContext> makeDefaultQueryExecutionContext();
   // Creates a `MessageSender` for the given operation.
   CPP_template(typename RequestT)(
       requires ad_utility::httpUtils::HttpRequest<RequestT>)
@@ -374,15 +445,28 @@ class Server {
           const QueryExecutionTree& qet, const ad_utility::Timer& requestTimer,
           SharedCancellationHandle cancellationHandle) const;
 
+  // Send the `page` of the cursor with the given `cursorId` in the media type
+  // of the cursor. If the cursor has more rows, the response has the header
+  // `QLever-Cursor: <cursorId>`.
+  CPP_template(typename RequestT, typename ResponseT)(
+      requires ad_utility::httpUtils::HttpRequest<RequestT>)
+      Awaitable<void> sendCursorPage(const RequestT& request, ResponseT& send,
+                                     const std::string& cursorId,
+                                     const QueryCursorManager::Page& page,
+                                     const ad_utility::Timer& requestTimer,
+                                     SharedCancellationHandle handle);
+
   // Given a name and query, compute the query result and write a new
-  // materialized view of this result to disk. This assumes that the access
-  // token has already been checked.
+  // materialized view of this result to disk (and in the same pass the views
+  // for the `additionalOrders`). This assumes that the access token has
+  // already been checked.
   void writeMaterializedView(
       const std::string& name,
       const ad_utility::url_parser::sparqlOperation::Query& query,
       const ad_utility::Timer& requestTimer,
       ad_utility::SharedCancellationHandle cancellationHandle,
-      TimeLimit timeLimit);
+      TimeLimit timeLimit,
+      const std::vector<MaterializedViewColumnOrder>& additionalOrders = {});
   FRIEND_TEST(MaterializedViewsTest, serverIntegration);
 
   // Trigger an index rebuild with `indexBaseName` as the base name for the new
@@ -0,0 +1,282 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "engine/SharedLazyResults.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "backports/algorithm.h"
+#include "util/Exception.h"
+#include "util/Iterators.h"
+
+// The lazy result of a single consumer of a `LazyResultBroadcast`.
+class LazyResultBroadcast::Consumer
+    : public ad_utility::InputRangeFromGet<IdTableVocabPair> {
+  std::shared_ptr<LazyResultBroadcast> broadcast_;
+  size_t id_;
+  // Empty for the owner, which is never detached.
+  Recompute recompute_;
+  size_t numRowsConsumed_ = 0;
+  // Only set after the consumer has been detached.
+  std::optional<LazyResult> independentResult_;
+
+ public:
+  Consumer(std::shared_ptr<LazyResultBroadcast> broadcast, size_t id,
+           Recompute recompute)
+      : broadcast_{std::move(broadcast)},
+        id_{id},
+        recompute_{std::move(recompute)} {}
+
+  ~Consumer() override {
+    if (broadcast_ != nullptr) {
+      broadcast_->removeConsumer(id_);
+    }
+  }
+
+  std::optional<IdTableVocabPair> get() override {
+    if (independentResult_.has_value()) {
+      return getIndependently();
+    }
+    auto& broadcast = *broadcast_;
+    std::unique_lock lock{broadcast.mutex_};
+    while (true) {
+      auto& state = broadcast.consumers_.at(id_);
+      if (state.detached_) {
+        break;
+      }
+      if (state.position_ < broadcast.numChunksProduced_) {
+        auto pair = broadcast.takeChunk(id_);
+        numRowsConsumed_ += pair.idTable_.numRows();
+        return pair;
+      }
+      if (broadcast.isFinished_) {
+        return std::nullopt;
+      }
+      if (broadcast.isProducing_) {
+        broadcast.conditionVariable_.wait(lock);
+        continue;
+      }
+      if (broadcast.failure_ != nullptr || broadcast.isClosed_) {
+        if (state.isOwner()) {
+          AD_CORRECTNESS_CHECK(broadcast.failure_ != nullptr);
+          std::rethrow_exception(broadcast.failure_);
+        }
+        state.detached_ = true;
+        continue;
+      }
+      if (!state.isOwner()) {
+        waitForOwner(lock);
+        continue;
+      }
+      broadcast.makeRoomForNextChunk();
+
+      // Compute the next chunk without holding the lock, s.t. the other
+      // consumers can consume the buffered chunks in the meantime.
+      broadcast.isProducing_ = true;
+      broadcast.conditionVariable_.notify_all();
+      lock.unlock();
+      std::optional<IdTableVocabPair> next;
+      try {
+        next = broadcast.source_.get();
+      } catch (...) {
+        lock.lock();
+        broadcast.isProducing_ = false;
+        broadcast.failure_ = std::current_exception();
+        broadcast.conditionVariable_.notify_all();
+        continue;
+      }
+      lock.lock();
+      broadcast.isProducing_ = false;
+      if (next.has_value()) {
+        auto memory = ad_utility::MemorySize::bytes(
+            next->idTable_.numRows() * next->idTable_.numColumns() *
+            sizeof(Id));
+        broadcast.buffer_.push_back(Chunk{std::move(next.value()), memory});
+        broadcast.memory_ += memory;
+        ++broadcast.numChunksProduced_;
+      } else {
+        broadcast.isFinished_ = true;
+      }
+      broadcast.conditionVariable_.notify_all();
+    }
+
+    // The consumer has been detached, recompute the result and skip the rows
+    // that have already been consumed.
+    AD_CORRECTNESS_CHECK(recompute_ != nullptr);
+    broadcast.consumers_.erase(id_);
+    ++broadcast.numConsumersDetached_;
+    broadcast.removeConsumedChunks();
+    lock.unlock();
+    broadcast_.reset();
+    independentResult_ = recompute_();
+    return getIndependently();
+  }
+
+ private:
+  // Wait until the owner starts to compute the next chunk (or something else
+  // happens that this consumer has to react to). Detach the consumer if this
+  // takes longer than the `maxWaitForOwner_`.
+  void waitForOwner(std::unique_lock<std::mutex>& lock) {
+    auto& broadcast = *broadcast_;
+    auto position = broadcast.consumers_.at(id_).position_;
+    bool ownerHasProgressed = broadcast.conditionVariable_.wait_for(
+        lock, broadcast.maxWaitForOwner_, [&broadcast, position, this]() {
+          return broadcast.isProducing_ ||
+                 broadcast.numChunksProduced_ > position ||
+                 broadcast.isFinished_ || broadcast.failure_ != nullptr ||
+                 broadcast.isClosed_ || broadcast.consumers_.at(id_).detached_;
+        });
+    if (!ownerHasProgressed) {
+      broadcast.consumers_.at(id_).detached_ = true;
+    }
+  }
+
+  // Get the next chunk of the `independentResult_`.
+  std::optional<IdTableVocabPair> getIndependently() {
+    while (true) {
+      auto next = independentResult_->get();
+      if (!next.has_value() || numRowsConsumed_ == 0) {
+        return next;
+      }
+      auto& idTable = next->idTable_;
+      if (idTable.numRows() <= numRowsConsumed_) {
+        numRowsConsumed_ -= idTable.numRows();
+        continue;
+      }
+      idTable.erase(idTable.begin(), idTable.begin() + numRowsConsumed_);
+      numRowsConsumed_ = 0;
+      return next;
+    }
+  }
+};
+
+// _____________________________________________________________________________
+LazyResultBroadcast::LazyResultBroadcast(
+    LazyResult source, ad_utility::MemorySize maxMemory,
+    std::chrono::milliseconds maxWaitForOwner)
+    : source_{std::move(source)},
+      maxMemory_{maxMemory},
+      maxWaitForOwner_{maxWaitForOwner} {}
+
+// _____________________________________________________________________________
+auto LazyResultBroadcast::consumeAsOwner() -> LazyResult {
+  std::lock_guard lock{mutex_};
+  AD_CONTRACT_CHECK(!hasOwner_);
+  hasOwner_ = true;
+  return addConsumer(std::nullopt, {});
+}
+
+// _____________________________________________________________________________
+auto LazyResultBroadcast::attach(Recompute recompute, Allocator allocator)
+    -> std::optional<LazyResult> {
+  AD_CONTRACT_CHECK(recompute != nullptr);
+  std::lock_guard lock{mutex_};
+  if (isClosed_ || failure_ != nullptr || firstBufferedChunk_ > 0) {
+    return std::nullopt;
+  }
+  return addConsumer(std::move(allocator), std::move(recompute));
+}
+
+// _____________________________________________________________________________
+auto LazyResultBroadcast::addConsumer(std::optional<Allocator> allocator,
+                                      Recompute recompute) -> LazyResult {
+  auto id = nextConsumerId_++;
+  consumers_.emplace(id, ConsumerState{0, std::move(allocator), false});
+  return LazyResult{
+      std::make_unique<Consumer>(shared_from_this(), id, std::move(recompute))};
+}
+
+// _____________________________________________________________________________
+void LazyResultBroadcast::removeConsumer(size_t id) {
+  LazyResult source;
+  {
+    std::unique_lock lock{mutex_};
+    auto it = consumers_.find(id);
+    AD_CORRECTNESS_CHECK(it != consumers_.end());
+    if (it->second.isOwner()) {
+      conditionVariable_.wait(lock, [this]() { return !isProducing_; });
+      isClosed_ = true;
+      source = std::move(source_);
+      // Wake up the consumers that wait for the owner.
+      conditionVariable_.notify_all();
+    }
+    consumers_.erase(it);
+    removeConsumedChunks();
+  }
+  // The `source` is destroyed here, without holding the lock.
+}
+
+// _____________________________________________________________________________
+auto LazyResultBroadcast::takeChunk(size_t id) -> IdTableVocabPair {
+  auto& state = consumers_.at(id);
+  auto index = state.position_++;
+  AD_CORRECTNESS_CHECK(index >= firstBufferedChunk_);
+  auto& chunk = buffer_.at(index - firstBufferedChunk_);
+  if (state.allocator_.has_value()) {
+    // The copy for a consumer other than the owner is charged to the
+    // consumer's own allocator.
+    IdTable copy{chunk.pair_.idTable_.numColumns(), state.allocator_.value()};
+    copy.insertAtEnd(chunk.pair_.idTable_);
+    IdTableVocabPair pair{std::move(copy), chunk.pair_.localVocab_.clone()};
+    removeConsumedChunks();
+    return pair;
+  }
+  bool isNeededByOthers =
+      ql::ranges::any_of(consumers_, [index](const auto& entry) {
+        const ConsumerState& other = entry.second;
+        return !other.detached_ && other.position_ <= index;
+      });
+  if (isNeededByOthers) {
+    return IdTableVocabPair{chunk.pair_.idTable_.clone(),
+                            chunk.pair_.localVocab_.clone()};
+  }
+  // No other consumer needs this chunk, so it is the first buffered chunk,
+  // and it is removed below.
+  AD_CORRECTNESS_CHECK(index == firstBufferedChunk_);
+  auto pair = std::move(chunk.pair_);
+  removeConsumedChunks();
+  return pair;
+}
+
+// _____________________________________________________________________________
+void LazyResultBroadcast::makeRoomForNextChunk() {
+  while (memory_ >= maxMemory_ && !buffer_.empty()) {
+    // The owner has consumed all the buffered chunks, so one of the other
+    // consumers is the slowest.
+    auto slowest = ql::ranges::min_element(
+        consumers_, {}, [](const auto& entry) {
+          const ConsumerState& state = entry.second;
+          return state.detached_ ? std::numeric_limits<size_t>::max()
+                                 : state.position_;
+        });
+    AD_CORRECTNESS_CHECK(slowest != consumers_.end() &&
+                         !slowest->second.isOwner());
+    slowest->second.detached_ = true;
+    removeConsumedChunks();
+  }
+}
+
+// _____________________________________________________________________________
+void LazyResultBroadcast::removeConsumedChunks() {
+  size_t minPosition = numChunksProduced_;
+  for (const auto& [id, state] : consumers_) {
+    if (!state.detached_) {
+      minPosition = std::min(minPosition, state.position_);
+    }
+  }
+  while (firstBufferedChunk_ < minPosition) {
+    memory_ -= buffer_.front().memory_;
+    buffer_.pop_front();
+    ++firstBufferedChunk_;
+  }
+}
+
+// _____________________________________________________________________________
+auto LazyResultBroadcast::getStatistics() -> Statistics {
+  std::lock_guard lock{mutex_};
+  return Statistics{consumers_.size(), numConsumersDetached_,
+                    numChunksProduced_, buffer_.size(), memory_};
+}
@@ -0,0 +1,213 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_ENGINE_SHAREDLAZYRESULTS_H
+#define QLEVER_SRC_ENGINE_SHAREDLAZYRESULTS_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+#include "engine/Result.h"
+#include "util/AllocatorWithLimit.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// A lazy result that is consumed by several consumers at the same time (e.g.
+// by two concurrent queries that contain the same subtree). The chunks of the
+// underlying lazy result (the `source`) are only computed once and are
+// buffered until all consumers have consumed them.
+//
+// The consumer that has computed the `source` is the owner of the broadcast.
+// The `source` refers to the operations of the owner's query (including the
+// updates of their runtime information), so only the owner computes its
+// chunks, in the owner's thread. The owner gets the buffered chunk itself if
+// it is the last consumer of the chunk, and a copy otherwise. The other
+// consumers always get a copy that is allocated by their own allocator.
+//
+// A consumer that needs a chunk that the owner hasn't computed yet waits for
+// the owner for at most `maxWaitForOwner` (the owner's query might be slow or
+// might even be blocked by this consumer). If the owner doesn't start to
+// compute the chunk in time, the consumer detaches from the broadcast and
+// recomputes the rest of its result independently (see `Recompute`). The same
+// happens when the owner's consumer is destroyed (which also destroys the
+// `source`), to the slowest consumer when the buffered chunks would exceed the
+// `maxMemory`, and to all consumers but the owner when the computation of a
+// chunk fails.
+class LazyResultBroadcast
+    : public std::enable_shared_from_this<LazyResultBroadcast> {
+ public:
+  using LazyResult = Result::LazyResult;
+  using IdTableVocabPair = Result::IdTableVocabPair;
+  // Compute the lazy result of a consumer from scratch. The rows that the
+  // consumer has already consumed from the broadcast are then skipped, which
+  // requires that the computation is deterministic (as for the cache).
+  using Recompute = std::function<LazyResult()>;
+  using Allocator = ad_utility::AllocatorWithLimit<Id>;
+
+  static constexpr std::chrono::milliseconds DEFAULT_MAX_WAIT_FOR_OWNER{100};
+
+  // Statistics for testing and logging.
+  struct Statistics {
+    size_t numConsumers_ = 0;
+    size_t numConsumersDetached_ = 0;
+    size_t numChunksProduced_ = 0;
+    size_t numChunksBuffered_ = 0;
+    ad_utility::MemorySize memory_;
+  };
+
+ private:
+  class Consumer;
+
+  struct ConsumerState {
+    // The index of the next chunk that the consumer needs.
+    size_t position_ = 0;
+    // The allocator for the copies of the chunks, not set for the owner.
+    std::optional<Allocator> allocator_;
+    // Set when the consumer has been detached by another consumer. It then
+    // has to recompute its result.
+    bool detached_ = false;
+
+    bool isOwner() const { return !allocator_.has_value(); }
+  };
+
+  struct Chunk {
+    IdTableVocabPair pair_;
+    ad_utility::MemorySize memory_;
+  };
+
+  // Only accessed by the owner.
+  LazyResult source_;
+  ad_utility::MemorySize maxMemory_;
+  std::chrono::milliseconds maxWaitForOwner_;
+
+  // The state below is protected by the `mutex_`. The `conditionVariable_` is
+  // notified whenever the computation of a chunk has finished.
+  std::mutex mutex_;
+  std::condition_variable conditionVariable_;
+  ad_utility::HashMap<size_t, ConsumerState> consumers_;
+  size_t nextConsumerId_ = 0;
+  bool hasOwner_ = false;
+  // The chunks `[firstBufferedChunk_, numChunksProduced_)` are buffered.
+  std::deque<Chunk> buffer_;
+  size_t firstBufferedChunk_ = 0;
+  size_t numChunksProduced_ = 0;
+  ad_utility::MemorySize memory_;
+  size_t numConsumersDetached_ = 0;
+  // True while the owner computes the next chunk of the `source_`.
+  bool isProducing_ = false;
+  // True once the `source_` is exhausted.
+  bool isFinished_ = false;
+  // True once the owner's consumer has been destroyed.
+  bool isClosed_ = false;
+  // Set if the computation of a chunk has failed.
+  std::exception_ptr failure_;
+
+ public:
+  LazyResultBroadcast(
+      LazyResult source, ad_utility::MemorySize maxMemory,
+      std::chrono::milliseconds maxWaitForOwner = DEFAULT_MAX_WAIT_FOR_OWNER);
+
+  // Return the lazy result of the owner. Must be called exactly once.
+  LazyResult consumeAsOwner();
+
+  // Return the lazy result of an additional consumer, the copies of the
+  // chunks are allocated by the `allocator`. Return `std::nullopt` if the
+  // consumer cannot be attached anymore because some of the chunks are not
+  // buffered anymore or because the owner is gone.
+  std::optional<LazyResult> attach(Recompute recompute, Allocator allocator);
+
+  Statistics getStatistics();
+
+ private:
+  // Add a consumer at the first chunk (the owner iff the `allocator` is not
+  // set), the `mutex_` must be locked.
+  LazyResult addConsumer(std::optional<Allocator> allocator,
+                         Recompute recompute);
+
+  // Remove the consumer with the given `id` and release the chunks that are
+  // not needed anymore. If the consumer is the owner, wait until the current
+  // computation of a chunk has finished and destroy the `source_`.
+  void removeConsumer(size_t id);
+
+  // Return the next buffered chunk for the consumer with the given `id` and
+  // advance it, the `mutex_` must be locked.
+  IdTableVocabPair takeChunk(size_t id);
+
+  // Detach the slowest consumers until the buffered chunks fit into the
+  // `maxMemory_`. This is only called by the owner, which is never detached.
+  // The `mutex_` must be locked.
+  void makeRoomForNextChunk();
+
+  // Remove the buffered chunks that all consumers have consumed, the `mutex_`
+  // must be locked.
+  void removeConsumedChunks();
+};
+
+// The broadcasts of the lazy results that are currently being computed, by
+// the key of the computation (for the `QueryResultCache`, the cache key of the
+// corresponding subtree).
+template <typename Key>
+class SharedLazyResults {
+  using Broadcasts =
+      ad_utility::HashMap<Key, std::weak_ptr<LazyResultBroadcast>>;
+  ad_utility::Synchronized<Broadcasts> broadcasts_;
+
+ public:
+  // Share the lazy `result` for the given `key` with all the consumers that
+  // attach to it via `tryAttach` and return the lazy result for the caller
+  // (the owner of the broadcast).
+  Result::LazyResult share(const Key& key, Result::LazyResult result,
+                           ad_utility::MemorySize maxMemory) {
+    auto broadcast =
+        std::make_shared<LazyResultBroadcast>(std::move(result), maxMemory);
+    auto ownerResult = broadcast->consumeAsOwner();
+    broadcasts_.withWriteLock([&](Broadcasts& broadcasts) {
+      removeExpired(broadcasts);
+      broadcasts[key] = broadcast;
+    });
+    return ownerResult;
+  }
+
+  // Attach to the lazy result for the given `key` if it is currently being
+  // computed and can still be attached to (see
+  // `LazyResultBroadcast::attach`). Otherwise return `std::nullopt`.
+  std::optional<Result::LazyResult> tryAttach(
+      const Key& key, LazyResultBroadcast::Recompute recompute,
+      LazyResultBroadcast::Allocator allocator) {
+    auto broadcast = broadcasts_.withWriteLock([&](Broadcasts& broadcasts) {
+      removeExpired(broadcasts);
+      auto it = broadcasts.find(key);
+      return it == broadcasts.end() ? nullptr : it->second.lock();
+    });
+    if (broadcast == nullptr) {
+      return std::nullopt;
+    }
+    return broadcast->attach(std::move(recompute), std::move(allocator));
+  }
+
+  // The number of lazy results that are currently being shared.
+  size_t numBroadcasts() {
+    return broadcasts_.withWriteLock([](Broadcasts& broadcasts) {
+      removeExpired(broadcasts);
+      return broadcasts.size();
+    });
+  }
+
+ private:
+  // Remove the entries of the broadcasts whose consumers are all gone.
+  static void removeExpired(Broadcasts& broadcasts) {
+    absl::erase_if(broadcasts,
+                   [](const auto& entry) { return entry.second.expired(); });
+  }
+};
+
+#endif  // QLEVER_SRC_ENGINE_SHAREDLAZYRESULTS_H
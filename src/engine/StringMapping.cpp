@@ -16,13 +16,26 @@ std::vector<std::string> StringMapping::flush(const Index& index) {
   LocalVocab dummy;
   std::vector<std::string> sortedStrings;
   sortedStrings.resize(stringMapping_.size());
+  // The words from the vocabulary are obtained with a single batch lookup,
+  // which is much cheaper than looking them up one by one.
+  std::vector<VocabIndex> vocabIndices;
+  std::vector<uint64_t> positionsOfVocabIndices;
   for (const auto& [oldId, newId] : stringMapping_) {
+    if (oldId.getDatatype() == Datatype::VocabIndex) {
+      vocabIndices.push_back(oldId.getVocabIndex());
+      positionsOfVocabIndices.push_back(newId);
+      continue;
+    }
     auto literalOrIri =
         ql::exportIds::idToLiteralOrIri(index, oldId, dummy, true);
     AD_CORRECTNESS_CHECK(literalOrIri.has_value());
     sortedStrings[newId] =
         std::move(literalOrIri.value()).toStringRepresentation();
   }
+  auto words = index.getVocab().lookupBatch(vocabIndices);
+  for (size_t i = 0; i < words.size(); ++i) {
+    sortedStrings[positionsOfVocabIndices[i]] = std::move(words[i]);
+  }
   stringMapping_.clear();
   return sortedStrings;
 }
@@ -40,12 +53,13 @@ Id StringMapping::remapId(Id id) {
 
   // A static assertion that each datatype is either `trivial`, or `allowed`
   // (see above), or `BlankNodeIndex` (which also requires special handling and
-  // remapping, but cannot be handled by the `StringMapping`.
+  // remapping, but cannot be handled by the `StringMapping`), or directly
+  // encoded in the ID (`EncodedVal` and `InlineLiteral`).
   static constexpr auto checkDatatypes = []() {
     auto checkType = [](Datatype datatype) {
       return ad_utility::contains(allowedDatatypes, datatype) ||
              isDatatypeTrivial(datatype) || datatype == BlankNodeIndex ||
-             datatype == EncodedVal;
+             datatype == EncodedVal || datatype == InlineLiteral;
     };
     for (size_t i = 0; i <= static_cast<size_t>(MaxValue); ++i) {
       if (!checkType(static_cast<Datatype>(i))) {
@@ -15,3 +15,10 @@ void to_json(nlohmann::json& j, const DeltaTriplesCount& count) {
                      {"deleted", count.triplesDeleted_},
                      {"total", count.triplesInserted_ + count.triplesDeleted_}};
 }
+
+// ____________________________________________________________________________
+void to_json(nlohmann::json& j, const DeltaTriplesThroughput& t) {
+  j = nlohmann::json{{"triples", t.numTriples_},
+                     {"time-ms", t.time_.count() / 1000.0},
+                     {"triples-per-second", t.triplesPerSecond()}};
+}
@@ -10,6 +10,8 @@
 #ifndef QLEVER_SRC_ENGINE_UPDATEMETADATA_H
 #define QLEVER_SRC_ENGINE_UPDATEMETADATA_H
 
+#include <chrono>
+
 #include "backports/three_way_comparison.h"
 #include "util/json.h"
 
@@ -32,12 +34,35 @@ struct DeltaTriplesCount {
                                               triplesInserted_, triplesDeleted_)
 };
 
+// The throughput of adding the triples of an update operation to the
+// `DeltaTriples` (locating them in all permutations and adding them to the
+// located triples).
+struct DeltaTriplesThroughput {
+  size_t numTriples_;
+  std::chrono::microseconds time_;
+
+  // The number of triples per second (0 if no time was measured).
+  double triplesPerSecond() const {
+    if (time_.count() == 0) {
+      return 0.0;
+    }
+    return static_cast<double>(numTriples_) * 1e6 /
+           static_cast<double>(time_.count());
+  }
+
+  /// Output as json. The signature of this function is mandated by the json
+  /// library to allow for implicit conversion.
+  friend void to_json(nlohmann::json& j, const DeltaTriplesThroughput& t);
+};
+
 // Metadata of a single update operation: number of inserted and deleted triples
-// before the operation, of the operation, and after the operation.
+// before the operation, of the operation, and after the operation, and the
+// throughput of adding the triples to the `DeltaTriples`.
 struct UpdateMetadata {
   std::optional<DeltaTriplesCount> countBefore_;
   std::optional<DeltaTriplesCount> inUpdate_;
   std::optional<DeltaTriplesCount> countAfter_;
+  std::optional<DeltaTriplesThroughput> throughput_;
 };
 
 #endif  // QLEVER_SRC_ENGINE_UPDATEMETADATA_H
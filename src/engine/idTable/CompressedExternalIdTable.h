@@ -564,6 +564,9 @@ class CompressedExternalIdTableSorterTypeErased {
  public:
   // Push a complete block at once.
   virtual void pushBlock(const IdTableStatic<0>& block) = 0;
+  // Push a complete block at once from a view, e.g. a (permuted) subset of the
+  // columns of another table (see `IdTable::asColumnSubsetView`).
+  virtual void pushBlock(const IdTableView<0>& block) = 0;
   // Get the sorted output after all blocks have been pushed. If `blocksize ==
   // nullopt`, the size of the returned blocks will be chosen automatically.
   virtual ad_utility::InputRangeTypeErased<IdTableStatic<0>> getSortedOutput(
@@ -709,9 +712,10 @@ class CompressedExternalIdTableSorter
   // The implementation of the type-erased interface. Push a complete block at
   // once.
   void pushBlock(const IdTableStatic<0>& block) override {
-    AD_CONTRACT_CHECK(block.numColumns() == this->numColumns_);
-    ql::ranges::for_each(block,
-                         [ptr = this](const auto& row) { ptr->push(row); });
+    pushBlockImpl(block);
+  }
+  void pushBlock(const IdTableView<0>& block) override {
+    pushBlockImpl(block);
   }
 
   // The implementation of the type-erased interface. Get the sorted blocks as
@@ -722,6 +726,28 @@ class CompressedExternalIdTableSorter
   }
 
  private:
+  // Implementation of `pushBlock` for tables and views. The rows are copied
+  // column by column in chunks that fill up the `currentBlock_`, which is much
+  // faster than pushing them one by one.
+  template <typename Table>
+  void pushBlockImpl(const Table& block) {
+    AD_CONTRACT_CHECK(block.numColumns() == this->numColumns_);
+    auto& currentBlock = this->currentBlock_;
+    const size_t blocksize = std::max(this->blocksize_, size_t{1});
+    size_t begin = 0;
+    while (begin < block.numRows()) {
+      size_t end = std::min(block.numRows(),
+                            begin + blocksize - currentBlock.numRows());
+      currentBlock.insertAtEnd(block, begin, end);
+      this->numElementsPushed_ += end - begin;
+      begin = end;
+      if (currentBlock.numRows() >= blocksize) {
+        Base::pushBlock(std::move(currentBlock));
+        this->resetCurrentBlock(true);
+      }
+    }
+  }
+
   template <typename RowGenVectorType, typename CompType>
   struct SortState
       : ad_utility::InputRangeMixin<SortState<RowGenVectorType, CompType>> {
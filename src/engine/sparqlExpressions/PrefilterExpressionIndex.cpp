@@ -406,12 +406,41 @@ BlockMetadataRanges PrefilterExpression::evaluate(
   return result;
 }
 
+//______________________________________________________________________________
+bool PrefilterExpression::mayBeTrueForZoneMap(
+    const LocalVocabContext& context, const ColumnZoneMap& zoneMap) const {
+  // Each range of a datatype becomes the first and last `ValueId` of a
+  // pseudo-block in column 0. The pseudo-blocks are sorted and don't contain
+  // mixed datatypes, so `evaluateImpl` can be used directly.
+  std::vector<CompressedBlockMetadata> pseudoBlocks(zoneMap.size());
+  for (size_t i = 0; i < zoneMap.size(); ++i) {
+    pseudoBlocks[i].firstTriple_.col0Id_ = zoneMap[i].first;
+    pseudoBlocks[i].lastTriple_.col0Id_ = zoneMap[i].second;
+  }
+  BlockMetadataSpan blockRange{pseudoBlocks};
+  AccessValueIdFromBlockMetadata accessValueIdOp(0);
+  ValueIdSubrange idRange{
+      ValueIdIt{&blockRange, 0, accessValueIdOp},
+      ValueIdIt{&blockRange, blockRange.size() * 2, accessValueIdOp}};
+  return ql::ranges::any_of(
+      evaluateImpl(context, idRange, blockRange, false),
+      [](const BlockMetadataRange& range) { return !range.empty(); });
+}
+
 //______________________________________________________________________________
 ValueId PrefilterExpression::getValueIdFromIdOrLocalVocabEntry(
     const IdOrLocalVocabEntry& referenceValue, LocalVocab& vocab) {
   return std::visit(ad_utility::OverloadCallOperator{
                         [](const ValueId& referenceId) { return referenceId; },
                         [&vocab](const LocalVocabEntry& referenceLVE) {
+                          // A literal that is stored inline in the `Id`s of
+                          // the index has to be compared to the inline
+                          // literals, not to the vocabulary entries.
+                          auto lower = Id::fromBits(
+                              referenceLVE.positionInVocab().lowerBound_.get());
+                          if (lower.getDatatype() == Datatype::InlineLiteral) {
+                            return lower;
+                          }
                           return Id::makeFromLocalVocabIndex(
                               vocab.getIndexAndAddIfNotContained(referenceLVE));
                         }},
@@ -420,6 +449,26 @@ ValueId PrefilterExpression::getValueIdFromIdOrLocalVocabEntry(
 
 // SECTION PREFIX-REGEX
 
+//______________________________________________________________________________
+static BlockMetadataRanges getRangesForDatatypes(const ValueIdSubrange& idRange,
+                                                 BlockMetadataSpan blockRange,
+                                                 const bool isNegated,
+                                                 ql::span<Datatype> datatypes) {
+  std::vector<ValueIdItPair> relevantRanges;
+  for (Datatype datatype : datatypes) {
+    relevantRanges.emplace_back(valueIdComparators::getRangeForDatatype(
+        idRange.begin(), idRange.end(), datatype));
+  }
+  // Sort and remove overlapping ranges.
+  relevantRanges =
+      valueIdComparators::detail::simplifyRanges(std::move(relevantRanges));
+  return isNegated
+             ? detail::mapping::mapValueIdItRangesToBlockItRangesComplemented(
+                   relevantRanges, idRange, blockRange)
+             : detail::mapping::mapValueIdItRangesToBlockItRanges(
+                   relevantRanges, idRange, blockRange);
+}
+
 //______________________________________________________________________________
 std::unique_ptr<PrefilterExpression> PrefixRegexExpression::logicalComplement()
     const {
@@ -547,11 +596,33 @@ BlockMetadataRanges RelationalExpression<Comparison>::evaluateImpl(
                                                referenceId, Comparison)
                               : getRangesForId(idRange.begin(), idRange.end(),
                                                referenceId, Comparison, false);
-  return getTotalComplement
-             ? detail::mapping::mapValueIdItRangesToBlockItRangesComplemented(
-                   relevantIdRanges, idRange, blockRange)
-             : detail::mapping::mapValueIdItRangesToBlockItRanges(
-                   relevantIdRanges, idRange, blockRange);
+  auto result =
+      getTotalComplement
+          ? detail::mapping::mapValueIdItRangesToBlockItRangesComplemented(
+                relevantIdRanges, idRange, blockRange)
+          : detail::mapping::mapValueIdItRangesToBlockItRanges(
+                relevantIdRanges, idRange, blockRange);
+  // The inline literals are not interleaved with the vocabulary, so their
+  // order w.r.t. other strings (and among themselves, which follows the
+  // collation) can't be decided from the bits. For `<`, `<=`, `>=`, and `>`,
+  // all the blocks with such strings therefore stay relevant, both for the
+  // expression and for its complement.
+  if constexpr (Comparison == CompOp::EQ || Comparison == CompOp::NE) {
+    return result;
+  }
+  auto referenceType = referenceId.getDatatype();
+  if (referenceType == Datatype::InlineLiteral) {
+    std::array datatypes{Datatype::VocabIndex, Datatype::LocalVocabIndex,
+                         Datatype::InlineLiteral};
+    return detail::logicalOps::mergeRelevantBlockItRanges<true>(
+        result, getRangesForDatatypes(idRange, blockRange, false, datatypes));
+  }
+  if (ad_utility::contains(ValueId::stringTypes_, referenceType)) {
+    std::array datatypes{Datatype::InlineLiteral};
+    return detail::logicalOps::mergeRelevantBlockItRanges<true>(
+        result, getRangesForDatatypes(idRange, blockRange, false, datatypes));
+  }
+  return result;
 }
 
 //______________________________________________________________________________
@@ -636,26 +707,6 @@ std::string IsDatatypeExpression<Datatype>::asString(
       "\nis negated: ", isNegated_ ? "true" : "false", ".\n");
 }
 
-//______________________________________________________________________________
-static BlockMetadataRanges getRangesForDatatypes(const ValueIdSubrange& idRange,
-                                                 BlockMetadataSpan blockRange,
-                                                 const bool isNegated,
-                                                 ql::span<Datatype> datatypes) {
-  std::vector<ValueIdItPair> relevantRanges;
-  for (Datatype datatype : datatypes) {
-    relevantRanges.emplace_back(valueIdComparators::getRangeForDatatype(
-        idRange.begin(), idRange.end(), datatype));
-  }
-  // Sort and remove overlapping ranges.
-  relevantRanges =
-      valueIdComparators::detail::simplifyRanges(std::move(relevantRanges));
-  return isNegated
-             ? detail::mapping::mapValueIdItRangesToBlockItRangesComplemented(
-                   relevantRanges, idRange, blockRange)
-             : detail::mapping::mapValueIdItRangesToBlockItRanges(
-                   relevantRanges, idRange, blockRange);
-}
-
 //______________________________________________________________________________
 template <>
 BlockMetadataRanges IsDatatypeExpression<IsDatatype::BLANK>::evaluateImpl(
@@ -699,8 +750,9 @@ BlockMetadataRanges IsDatatypeExpression<IsDatatype::LITERAL>::evaluateImpl(
   // For pre-filtering LITERAL related ValueIds we use the ValueId representing
   // the beginning of IRI values as an upper bound and add all the value types
   // that are literals inlined into a compact representation.
-  std::array datatypes{Datatype::Int, Datatype::Double, Datatype::Date,
-                       Datatype::Bool, Datatype::GeoPoint};
+  std::array datatypes{Datatype::Int,  Datatype::Double,
+                       Datatype::Date, Datatype::Bool,
+                       Datatype::GeoPoint, Datatype::InlineLiteral};
   auto inlinedRanges =
       getRangesForDatatypes(idRange, blockRange, isNegated_, datatypes);
   auto nonInlinedRanges =
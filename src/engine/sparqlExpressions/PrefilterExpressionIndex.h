@@ -136,6 +136,13 @@ class PrefilterExpression {
                                BlockMetadataSpan blockRange,
                                size_t evaluationColumn) const;
 
+  // Return false if no value in the range of the given `zoneMap` (of a single
+  // column of a single block, see `ColumnZoneMap`) can fulfill this
+  // expression. In contrast to `evaluate`, this also works for the columns by
+  // which the blocks are not sorted.
+  bool mayBeTrueForZoneMap(const LocalVocabContext& context,
+                           const ColumnZoneMap& zoneMap) const;
+
   // `evaluateImpl` is internally used for the actual pre-filter procedure.
   // `ValueIdSubrange idRange` enables indirect access to all `ValueId`s at
   // column index `evaluationColumn` over the containerized `ql::span<const
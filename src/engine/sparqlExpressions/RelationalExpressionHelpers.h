@@ -132,6 +132,42 @@ inline std::pair<ValueId, ValueId> getRangeFromVocab(
   return {lower, upper};
 }
 
+// If one of `a` and `b` is an `InlineLiteral` and the other one is also a
+// string (`InlineLiteral`, `VocabIndex`, or `LocalVocabIndex`), return the
+// three-way comparison (negative, zero, or positive) of their string
+// representations according to the collation by which the vocabulary is
+// sorted. The inline literals are not interleaved with the vocabulary, so the
+// bits of such `Id`s can't be used for `<` etc. For all other pairs of `Id`s,
+// return `std::nullopt`.
+inline std::optional<int> compareStringsWithInlineLiterals(ValueId a,
+                                                           ValueId b,
+                                                           const Index& index) {
+  auto isString = [](Datatype type) {
+    return type == Datatype::InlineLiteral ||
+           ad_utility::contains(ValueId::stringTypes_, type);
+  };
+  Datatype typeA = a.getDatatype();
+  Datatype typeB = b.getDatatype();
+  if ((typeA != Datatype::InlineLiteral && typeB != Datatype::InlineLiteral) ||
+      !isString(typeA) || !isString(typeB)) {
+    return std::nullopt;
+  }
+  auto toString = [&index](ValueId id) -> std::string {
+    switch (id.getDatatype()) {
+      case Datatype::InlineLiteral:
+        return id.getInlineLiteral().toStringRepresentation();
+      case Datatype::VocabIndex:
+        return std::string{index.indexToString(id.getVocabIndex())};
+      case Datatype::LocalVocabIndex:
+        return id.getLocalVocabIndex()->toStringRepresentation();
+      default:
+        AD_FAIL();
+    }
+  };
+  return index.getVocab().getCaseComparator().compare(
+      toString(a), toString(b), LocaleManager::Level::TOTAL);
+}
+
 // A concept for various types that either represent a string, an ID or a
 // consecutive range of IDs. For its usage see below.
 template <typename S>
@@ -185,6 +221,10 @@ inline const auto compareIdsOrStrings =
                                     decltype(x), decltype(y),
                                     valueIdComparators::Comparison>) {
       // Compare two `ValueId`s
+      if (auto cmp =
+              compareStringsWithInlineLiterals(x, y, ctx->_qec.getIndex())) {
+        return valueIdComparators::fromBool(applyComparison<Comp>(*cmp, 0));
+      }
       return valueIdComparators::compareIds<comparisonForIncompatibleTypes>(
           x, y, Comp);
     } else if constexpr (ranges::invocable<
@@ -119,6 +119,30 @@ ad_utility::SetOfIntervals evaluateWithBinarySearch(
   return s;
 }
 
+// Return true iff the index stores short literals inline, `Comp` is not `EQ`
+// or `NE`, and `reference` (an `Id` or a range of equal `Id`s) is a string.
+// Then the order of the strings in a sorted column is not the order of `Comp`
+// (see `compareStringsWithInlineLiterals`), and the binary search above can't
+// be used.
+template <Comparison Comp, typename T>
+bool orderOfStringsDependsOnVocab(const T& reference,
+                                  const EvaluationContext* context) {
+  if constexpr (Comp == Comparison::EQ || Comp == Comparison::NE) {
+    return false;
+  } else {
+    ValueId id;
+    if constexpr (ad_utility::isSimilar<T, ValueId>) {
+      id = reference;
+    } else {
+      id = reference.first;
+    }
+    auto type = id.getDatatype();
+    return (type == Datatype::InlineLiteral ||
+            ad_utility::contains(ValueId::stringTypes_, type)) &&
+           context->_qec.getIndex().encodedIriManager().encodesShortLiterals();
+  }
+}
+
 // The actual comparison function for the `SingleExpressionResult`'s which are
 // `AreComparable` (see above), which means that the comparison between them is
 // supported and not always false.
@@ -142,7 +166,8 @@ CPP_template(Comparison Comp, typename S1, typename S2)(
       auto valueId = makeValueId(value2, context);
       // TODO<C++23> Use `ql::ranges::starts_with`.
       if (const auto& cols = context->_columnsByWhichResultIsSorted;
-          !cols.empty() && cols[0] == columnIndex) {
+          !cols.empty() && cols[0] == columnIndex &&
+          !orderOfStringsDependsOnVocab<Comp>(valueId, context)) {
         constexpr static bool value2IsString =
             !ad_utility::isSimilar<decltype(valueId), Id>;
         if constexpr (value2IsString) {
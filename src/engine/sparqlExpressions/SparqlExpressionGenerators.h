@@ -24,6 +24,7 @@
 #include "backports/functional.h"
 #endif
 #include "engine/sparqlExpressions/SparqlExpression.h"
+#include "global/RuntimeParameters.h"
 #include "util/Generator.h"
 
 namespace sparqlExpression::detail {
@@ -200,20 +201,68 @@ CPP_template(typename Input, typename Transformation = ql::identity)(
   }
 }
 
+// True iff the `ValueGetter` needs the strings of `VocabIndex` IDs (see
+// `SparqlExpressionValueGetters.h`).
+template <typename ValueGetter, typename = void>
+constexpr bool needsVocabularyStrings = false;
+template <typename ValueGetter>
+constexpr bool needsVocabularyStrings<
+    ValueGetter, std::void_t<decltype(ValueGetter::needsVocabularyStrings)>> =
+    ValueGetter::needsVocabularyStrings;
+
+// If the `position` is the start of a batch, then prefetch the words of the
+// `VocabIndex` IDs of the next batch of the `ids` into the cache of hot strings
+// of the vocabulary, from which the value getters are then served.
+inline void prefetchVocabularyStrings(ql::span<const ValueId> ids,
+                                      size_t position,
+                                      const EvaluationContext* context) {
+  constexpr size_t batchSize = Index::Vocab::prefetchBatchSize_;
+  if (position % batchSize != 0 || position >= ids.size() ||
+      !getRuntimeParameter<&RuntimeParameters::vocabularyHotStringCache_>()) {
+    return;
+  }
+  std::vector<VocabIndex> vocabIndices;
+  for (ValueId id :
+       ids.subspan(position, std::min(batchSize, ids.size() - position))) {
+    if (id.getDatatype() == Datatype::VocabIndex) {
+      vocabIndices.push_back(id.getVocabIndex());
+    }
+  }
+  context->_qec.getIndex().getVocab().prefetch(vocabIndices);
+}
+
 /// Generate `numItems` many values from the `input` and apply the
 /// `valueGetter` to each of the values.
 inline auto valueGetterGenerator =
     CPP_template_lambda()(typename ValueGetter, typename Input)(
         size_t numElements, EvaluationContext* context, Input&& input,
         ValueGetter&& valueGetter)(requires SingleExpressionResult<Input>) {
-  auto transformation =
-      CPP_template_lambda(context, valueGetter)(typename I)(I && i)(
-          requires ranges::invocable<ValueGetter, I&&, EvaluationContext*>) {
-    context->cancellationHandle_->throwIfCancelled();
-    return valueGetter(AD_FWD(i), context);
-  };
-
-  return makeGenerator(AD_FWD(input), numElements, context, transformation);
+  if constexpr (ad_utility::isSimilar<::Variable, Input> &&
+                needsVocabularyStrings<std::decay_t<ValueGetter>>) {
+    // The strings of the column are prefetched in batches, which is much
+    // cheaper than looking them up one by one when the vocabulary is on disk.
+    // The position is stored in a `shared_ptr` because the transformation has
+    // to be copyable and callable as `const`.
+    auto ids = getIdsFromVariable(input, context);
+    auto position = std::make_shared<size_t>(0);
+    auto transformation =
+        CPP_template_lambda(context, valueGetter, ids, position)(typename I)(
+            I && i)(requires ranges::invocable<ValueGetter, I&&,
+                                               EvaluationContext*>) {
+      context->cancellationHandle_->throwIfCancelled();
+      prefetchVocabularyStrings(ids, (*position)++, context);
+      return valueGetter(AD_FWD(i), context);
+    };
+    return makeGenerator(AD_FWD(input), numElements, context, transformation);
+  } else {
+    auto transformation =
+        CPP_template_lambda(context, valueGetter)(typename I)(I && i)(
+            requires ranges::invocable<ValueGetter, I&&, EvaluationContext*>) {
+      context->cancellationHandle_->throwIfCancelled();
+      return valueGetter(AD_FWD(i), context);
+    };
+    return makeGenerator(AD_FWD(input), numElements, context, transformation);
+  }
 };
 
 /// Do the following `numItems` times: Obtain the next elements e_1, ..., e_n
@@ -37,6 +37,7 @@ NumericValue NumericValueGetter::operator()(
     case Datatype::EncodedVal:
     case Datatype::VocabIndex:
     case Datatype::LocalVocabIndex:
+    case Datatype::InlineLiteral:
     case Datatype::TextRecordIndex:
     case Datatype::WordVocabIndex:
     case Datatype::Date:
@@ -61,6 +62,7 @@ NumericOrDateValue NumericOrDateValueGetter::operator()(
     case Datatype::EncodedVal:
     case Datatype::VocabIndex:
     case Datatype::LocalVocabIndex:
+    case Datatype::InlineLiteral:
     case Datatype::TextRecordIndex:
     case Datatype::WordVocabIndex:
       return NotNumeric{};
@@ -106,6 +108,8 @@ auto EffectiveBooleanValueGetter::operator()(
                  ? False
                  : True;
     }
+    case Datatype::InlineLiteral:
+      return id.getInlineLiteral().size() == 0 ? False : True;
     case Datatype::WordVocabIndex:
     case Datatype::TextRecordIndex:
     case Datatype::Date:
@@ -239,6 +243,8 @@ Id IsSomethingValueGetter<isSomethingFunction, prefix>::operator()(
     case Datatype::EncodedVal:
       // We currently only encode IRIs.
       return Id::makeFromBool(prefix == isIriPrefix);
+    case Datatype::InlineLiteral:
+      return Id::makeFromBool(prefix == isLiteralPrefix);
     case Datatype::Bool:
     case Datatype::Int:
     case Datatype::Double:
@@ -302,6 +308,7 @@ IntDoubleStr ToNumericValueGetter::operator()(
     case Datatype::Date:
     case Datatype::BlankNodeIndex:
     case Datatype::EncodedVal:
+    case Datatype::InlineLiteral:
       auto optString = LiteralFromIdGetter{}(id, context);
       if (optString.has_value()) {
         return std::move(optString.value());
@@ -339,6 +346,9 @@ OptIri DatatypeValueGetter::operator()(ValueId id,
       AD_CORRECTNESS_CHECK(dateType != nullptr);
       return Iri::fromIrirefWithoutBrackets(dateType);
     }
+    case InlineLiteral:
+      // Only plain literals are stored inline.
+      return Iri::fromIrirefWithoutBrackets(XSD_STRING);
     case EncodedVal:
     case LocalVocabIndex:
     case VocabIndex:
@@ -444,6 +454,7 @@ std::optional<ad_utility::GeoPointOrWkt> GeoPointOrWktValueGetter::operator()(
     case WordVocabIndex:
     case BlankNodeIndex:
     case EncodedVal:
+    case InlineLiteral:
       return std::nullopt;
   }
 
@@ -471,6 +482,7 @@ CPP_template(typename T, typename ValueGetter)(
     case LocalVocabIndex:
     case EncodedVal:
     case VocabIndex:
+    case InlineLiteral:
       return valueGetter(
           ql::exportIds::getLiteralOrIriFromVocabIndex(
               context->_qec.getIndex(), id, context->_localVocab),
@@ -509,6 +521,7 @@ std::optional<std::string> LanguageTagValueGetter::operator()(
     case Double:
     case Date:
     case GeoPoint:
+    case InlineLiteral:
       // For literals without language tag, we return an empty string per
       // standard.
       return {""};
@@ -584,6 +597,7 @@ CPP_template_out_def(typename RequestedInfo)(
     case Double:
     case Date:
     case Undefined:
+    case InlineLiteral:
       return std::nullopt;
   }
   AD_FAIL();
@@ -26,6 +26,9 @@
 
 /// Several classes that can be used as the `ValueGetter` template
 /// argument in the SparqlExpression templates in `SparqlExpression.h`
+/// Value getters that need the strings of `VocabIndex` IDs declare a static
+/// member `needsVocabularyStrings = true`. For these, the strings are then
+/// prefetched in batches (see `valueGetterGenerator`).
 
 namespace sparqlExpression::detail {
 
@@ -167,6 +170,7 @@ struct EffectiveBooleanValueGetter : Mixin<EffectiveBooleanValueGetter> {
 // templates. It produces a string value.
 struct StringValueGetter : Mixin<StringValueGetter> {
   using Value = std::optional<std::string>;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<StringValueGetter>::operator();
   std::optional<std::string> operator()(ValueId,
                                         const EvaluationContext*) const;
@@ -186,6 +190,7 @@ struct StringValueGetter : Mixin<StringValueGetter> {
 struct LiteralValueGetterWithStrFunction
     : Mixin<LiteralValueGetterWithStrFunction> {
   using Value = std::optional<ad_utility::triple_component::Literal>;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<LiteralValueGetterWithStrFunction>::operator();
 
   std::optional<ad_utility::triple_component::Literal> operator()(
@@ -200,6 +205,7 @@ struct LiteralValueGetterWithStrFunction
 struct LiteralValueGetterWithoutStrFunction
     : Mixin<LiteralValueGetterWithoutStrFunction> {
   using Value = std::optional<ad_utility::triple_component::Literal>;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<LiteralValueGetterWithoutStrFunction>::operator();
 
   std::optional<ad_utility::triple_component::Literal> operator()(
@@ -308,6 +314,7 @@ struct GeoPointValueGetter : Mixin<GeoPointValueGetter> {
 // the input of which the `STR()` function was not used in a query.
 struct LiteralFromIdGetter : Mixin<LiteralFromIdGetter> {
   using Value = std::optional<std::string>;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<LiteralFromIdGetter>::operator();
   std::optional<std::string> operator()(ValueId id,
                                         const EvaluationContext* context) const;
@@ -326,6 +333,7 @@ struct LiteralFromIdGetter : Mixin<LiteralFromIdGetter> {
 // the latter represents the format that re2 expects.
 struct ReplacementStringGetter : Mixin<ReplacementStringGetter> {
   using Value = std::optional<std::string>;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<ReplacementStringGetter>::operator();
   std::optional<std::string> operator()(ValueId,
                                         const EvaluationContext*) const;
@@ -343,6 +351,7 @@ struct RegexValueGetter {
   mutable ad_utility::util::LRUCache<std::string, std::shared_ptr<RE2>> cache_{
       100};
   using Value = std::shared_ptr<RE2>;
+  static constexpr bool needsVocabularyStrings = true;
   template <typename S>
   auto operator()(S&& input, const EvaluationContext* context) const
       -> CPP_ret(Value)(requires SingleExpressionResult<S>&& ranges::invocable<
@@ -361,6 +370,7 @@ struct RegexValueGetter {
 // can contain: `int64_t`, `double`, `std::string` or `std::monostate`(empty).
 struct ToNumericValueGetter : Mixin<ToNumericValueGetter> {
   using Value = IntDoubleStr;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<ToNumericValueGetter>::operator();
   IntDoubleStr operator()(ValueId id, const EvaluationContext*) const;
   IntDoubleStr operator()(const LiteralOrIri& s,
@@ -372,6 +382,7 @@ struct ToNumericValueGetter : Mixin<ToNumericValueGetter> {
 // ad_utility::triple_component::Literal, std::string> object.
 struct DatatypeValueGetter : Mixin<DatatypeValueGetter> {
   using Value = OptIri;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<DatatypeValueGetter>::operator();
   OptIri operator()(ValueId id, const EvaluationContext* context) const;
   OptIri operator()(const LiteralOrIri& litOrIri,
@@ -415,6 +426,7 @@ struct UnitOfMeasurementValueGetter : Mixin<UnitOfMeasurementValueGetter> {
 // `geo:wktLiteral` datatype.
 struct GeoPointOrWktValueGetter : Mixin<GeoPointOrWktValueGetter> {
   using Value = std::optional<ad_utility::GeoPointOrWkt>;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<GeoPointOrWktValueGetter>::operator();
   std::optional<ad_utility::GeoPointOrWkt> operator()(
       ValueId id, const EvaluationContext*) const;
@@ -429,6 +441,7 @@ struct GeoPointOrWktValueGetter : Mixin<GeoPointOrWktValueGetter> {
 // `LANG()`-expression.
 struct LanguageTagValueGetter : Mixin<LanguageTagValueGetter> {
   using Value = std::optional<std::string>;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<LanguageTagValueGetter>::operator();
   std::optional<std::string> operator()(ValueId id,
                                         const EvaluationContext* context) const;
@@ -451,6 +464,7 @@ struct LanguageTagValueGetter : Mixin<LanguageTagValueGetter> {
 // Value getter for implementing the expressions `IRI()`/`URI()`.
 struct IriOrUriValueGetter : Mixin<IriOrUriValueGetter> {
   using Value = IdOrLocalVocabEntry;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<IriOrUriValueGetter>::operator();
   IdOrLocalVocabEntry operator()(ValueId id,
                                  const EvaluationContext* context) const;
@@ -491,6 +505,7 @@ using OptStringOrDate =
 // (from literal) values.
 struct StringOrDateGetter : Mixin<StringOrDateGetter> {
   using Value = OptStringOrDate;
+  static constexpr bool needsVocabularyStrings = true;
   using Mixin<StringOrDateGetter>::operator();
   // Remark: We use only LiteralFromIdGetter because Iri values should never
   // contain date-related string values.
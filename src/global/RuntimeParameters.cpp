@@ -56,7 +56,32 @@ RuntimeParameters::RuntimeParameters() {
   add(enableMaterializedViewQueryRewrite_);
   add(serviceAllowedIriPrefixes_);
   add(permutationWriterNumThreads_);
+  add(enableMultiwayJoin_);
+  add(multiwayJoinMinIntermediateSize_);
+  add(queryPlanCacheMaxNumEntries_);
+  add(queryPlanCacheMaxDeltaTriplesRatio_);
+  add(adaptiveJoinReoptimizationFactor_);
   add(vacuumMinimumBlockSize_);
+  add(deltaTriplesCompactionInterval_);
+  add(deltaTriplesCompactionMaxBlocksPerRound_);
+  add(deltaTriplesCompactionMinimumBlockSize_);
+  add(deltaTriplesCompactionMaxMemory_);
+  add(deltaTriplesLogMinCheckpointSize_);
+  add(admissionMaxConcurrentQueries_);
+  add(admissionMaxQueueLength_);
+  add(admissionInteractiveMaxCost_);
+  add(admissionStarvationTimeout_);
+  add(queryMemoryBudget_);
+  add(cursorTimeout_);
+  add(cursorMaxOpenPerClient_);
+  add(cursorMaxMemory_);
+  add(cursorDefaultPageSize_);
+  add(cursorTrustedProxies_);
+  add(sharedScansMaxMemory_);
+  add(vocabularyHotStringCache_);
+  add(lazyResultSharingMaxMemory_);
+  add(cacheWarmupNumQueries_);
+  add(cacheWarmupSaveInterval_);
   add(disableCaching_);
   add(logLevel_);
 
@@ -74,6 +99,15 @@ RuntimeParameters::RuntimeParameters() {
               value.count(), "s")};
         }
       });
+
+  adaptiveJoinReoptimizationFactor_.setParameterConstraint(
+      [](double value, std::string_view parameterName) {
+        if (value != 0.0 && value <= 1.0) {
+          throw std::runtime_error{absl::StrCat(
+              "Parameter ", parameterName,
+              " must be 0 (disabled) or greater than 1, was ", value)};
+        }
+      });
 }
 
 // _____________________________________________________________________________
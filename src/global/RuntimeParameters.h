@@ -170,9 +170,130 @@ struct RuntimeParameters {
   // `qlever-index`doesn't expose a CLI flag to set this parameter.
   SizeT permutationWriterNumThreads_{2, "permutation-writer-num-threads"};
 
+  // If set, the query planner additionally considers a worst-case optimal
+  // `MultiwayJoin` for cyclic basic graph patterns (e.g. triangles).
+  Bool enableMultiwayJoin_{true, "enable-multiway-join"};
+  // The `MultiwayJoin` is only considered if the best plan that consists of
+  // binary joins has an intermediate result with at least this estimated
+  // size that is also larger than the estimated sizes of all the joined
+  // triples together.
+  SizeT multiwayJoinMinIntermediateSize_{1'000'000,
+                                         "multiway-join-min-intermediate-size"};
+
+  // The maximal number of query plans of prepared statements that are kept in
+  // the `QueryPlanCache`. A value of 0 disables the reuse of query plans.
+  SizeT queryPlanCacheMaxNumEntries_{1000, "query-plan-cache-max-num-entries"};
+  // The cached query plans are discarded as soon as the number of delta
+  // triples has changed by more than this fraction of the number of triples in
+  // the index since the plans were cached, because the plans were chosen based
+  // on the (now outdated) statistics.
+  Double queryPlanCacheMaxDeltaTriplesRatio_{
+      0.01, "query-plan-cache-max-delta-triples-ratio"};
+
+  // If set to a value > 1, joins of at least three inputs are executed by an
+  // `AdaptiveJoin`, which re-plans the remaining joins as soon as the actual
+  // size of a materialized intermediate result differs from its estimate by
+  // more than this factor. A value of 0 disables the re-optimization.
+  Double adaptiveJoinReoptimizationFactor_{
+      0.0, "adaptive-join-reoptimization-factor"};
+
   // Only blocks of this size or larger will be considered for vacuuming.
   SizeT vacuumMinimumBlockSize_{100, "vacuum-minimum-block-size"};
 
+  // The background compaction of the delta triples (see
+  // `DeltaTriplesCompactor`) runs once per interval (a value of 0 disables
+  // it, which is the default) and then merges the located triples of at most
+  // the given number of blocks per permutation into these blocks. Only blocks
+  // with at least the given number of located triples are considered. The
+  // compacted blocks are kept in RAM, no further blocks are compacted as long
+  // as they take up more than the given amount of memory.
+  Duration<std::chrono::milliseconds> deltaTriplesCompactionInterval_{
+      std::chrono::milliseconds(0), "delta-triples-compaction-interval"};
+  SizeT deltaTriplesCompactionMaxBlocksPerRound_{
+      4, "delta-triples-compaction-max-blocks-per-round"};
+  SizeT deltaTriplesCompactionMinimumBlockSize_{
+      1000, "delta-triples-compaction-minimum-block-size"};
+  MemorySizeParameter deltaTriplesCompactionMaxMemory_{
+      ad_utility::MemorySize::megabytes(512),
+      "delta-triples-compaction-max-memory"};
+
+  // When updates are persisted, the delta triples are only completely written
+  // to disk (as a checkpoint) when the log of the updates since the last
+  // checkpoint becomes larger than the checkpoint and larger than this size.
+  // Otherwise, only the updates are appended to the log.
+  MemorySizeParameter deltaTriplesLogMinCheckpointSize_{
+      ad_utility::MemorySize::megabytes(64),
+      "delta-triples-log-min-checkpoint-size"};
+
+  // Admission control of the server (see `QueryAdmissionController`). At most
+  // the given number of queries are executed concurrently (0 means no limit),
+  // and at most the given number of queries wait for their admission, further
+  // queries are rejected. Queries with a cost estimate above
+  // `admission-interactive-max-cost` (0 means no limit) are executed with the
+  // batch priority unless the request carries a valid access token.
+  SizeT admissionMaxConcurrentQueries_{0, "admission-max-concurrent-queries"};
+  SizeT admissionMaxQueueLength_{1000, "admission-max-queue-length"};
+  SizeT admissionInteractiveMaxCost_{0, "admission-interactive-max-cost"};
+  // A query that has waited for its admission for longer than this is
+  // admitted before all the queries that have waited for a shorter time,
+  // regardless of their priority and cost estimate (0 means never).
+  Duration<std::chrono::seconds> admissionStarvationTimeout_{
+      std::chrono::seconds(60), "admission-starvation-timeout"};
+  // The memory that a single query may allocate. This memory is reserved when
+  // the query is admitted, so that the budgets of the queries that run
+  // concurrently never exceed the memory limit of the server. A value of 0
+  // disables the per-query budgets.
+  MemorySizeParameter queryMemoryBudget_{ad_utility::MemorySize::bytes(0),
+                                         "query-memory-budget"};
+
+  // Server-side cursors (`cursor=true`, see `QueryCursorManager`). A cursor is
+  // closed when it has not been accessed for the given time. A single client
+  // may have at most the given number of open cursors, and the results of all
+  // open cursors together may use at most the given amount of memory. Pages
+  // have the default size unless a request sets the `page-size` parameter.
+  Duration<std::chrono::seconds> cursorTimeout_{std::chrono::seconds(300),
+                                                "cursor-timeout"};
+  SizeT cursorMaxOpenPerClient_{10, "cursor-max-open-per-client"};
+  MemorySizeParameter cursorMaxMemory_{ad_utility::MemorySize::gigabytes(2),
+                                       "cursor-max-memory"};
+  SizeT cursorDefaultPageSize_{10'000, "cursor-default-page-size"};
+  // The clients of cursors are identified by the IP address of their
+  // connection. Only if the connection comes from one of these addresses (of
+  // reverse proxies), the last address of the `X-Forwarded-For` header is used
+  // instead.
+  SpaceSeparatedStrings cursorTrustedProxies_{{}, "cursor-trusted-proxies"};
+
+  // Concurrent lazy scans of the same blocks of a permutation share the
+  // reading and decompression of these blocks (see `SharedBlockScans`). The
+  // blocks that are kept in memory for other scans may use at most the given
+  // amount of memory. A value of 0 disables the sharing.
+  MemorySizeParameter sharedScansMaxMemory_{
+      ad_utility::MemorySize::megabytes(512), "shared-scans-max-memory"};
+
+  // If set, the export of query results and the expressions that need the
+  // strings of a column prefetch these strings in batches into a cache of the
+  // vocabulary (see `Vocabulary::prefetch`). This is only useful when the
+  // vocabulary is on a slow disk, otherwise it only adds overhead.
+  Bool vocabularyHotStringCache_{false, "vocabulary-hot-string-cache"};
+
+  // Identical subtrees of concurrent queries that are computed lazily share
+  // the computation of their result (see `SharedLazyResults`). The chunks
+  // that are buffered for the slower consumers of such a result may use at
+  // most the given amount of memory. A value of 0 disables the sharing.
+  MemorySizeParameter lazyResultSharingMaxMemory_{
+      ad_utility::MemorySize::megabytes(256),
+      "lazy-result-sharing-max-memory"};
+
+  // The cache warm-up of the server (see `CacheWarmup`, only enabled if the
+  // server is started with a `--cache-warmup-file`). The given number of the
+  // hottest queries are saved once per interval (a value of 0 disables the
+  // periodic saving, they are then only saved when the server is shut down)
+  // and replayed when the server is started. If the number of queries is 0,
+  // no queries are recorded or saved.
+  SizeT cacheWarmupNumQueries_{100, "cache-warmup-num-queries"};
+  Duration<std::chrono::seconds> cacheWarmupSaveInterval_{
+      std::chrono::seconds(60), "cache-warmup-save-interval"};
+
   // The runtime log level. Messages with a higher level are suppressed. The
   // compile-time level (CMake LOGLEVEL) still applies as an upper bound.
   LogLevelParameter logLevel_{LogLevel{ad_utility::detail::defaultLogLevel},
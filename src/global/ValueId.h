@@ -18,6 +18,7 @@
 #include "global/Constants.h"
 #include "global/IndexTypes.h"
 #include "rdfTypes/GeoPoint.h"
+#include "rdfTypes/InlineLiteral.h"
 #include "util/Algorithm.h"
 #include "util/BitUtils.h"
 #include "util/DateYearDuration.h"
@@ -42,7 +43,8 @@ enum struct Datatype {
   WordVocabIndex,
   BlankNodeIndex,
   EncodedVal,
-  MaxValue = EncodedVal
+  InlineLiteral,
+  MaxValue = InlineLiteral
   // Note: Unfortunately, we cannot easily get the size of an enum.
   // If members are added to this enum, then the `MaxValue`
   // alias must always be equal to the last member,
@@ -56,7 +58,9 @@ enum struct Datatype {
 // `BlankNodeIndex` is deliberately NOT considiered trivial, as blank nodes
 // depend on the context, in particular they have to be remapped when results
 // from different  RDF sources are merged. Same goes for `EncodedVal` which
-// depends on the (configurable!) prefixes for the encoding.
+// depends on the (configurable!) prefixes for the encoding, and for
+// `InlineLiteral`, because whether short literals are encoded is also
+// configurable.
 constexpr bool isDatatypeTrivial(Datatype datatype) {
   using enum Datatype;
   constexpr std::array trivialDatatypes{Undefined, Bool, Int,
@@ -77,6 +81,8 @@ inline QL_CONSTEXPR std::string_view toString(Datatype type) {
       return "Int";
     case Datatype::EncodedVal:
       return "EncodedIri";
+    case Datatype::InlineLiteral:
+      return "InlineLiteral";
     case Datatype::VocabIndex:
       return "VocabIndex";
     case Datatype::LocalVocabIndex:
@@ -140,6 +146,8 @@ class ValueId {
   // Assert that the size of an encoded GeoPoint equals the available bits in a
   // ValueId.
   static_assert(numDataBits == GeoPoint::numDataBits);
+  // The same for short literals that are stored inline.
+  static_assert(numDataBits == InlineLiteral::numDataBits);
 
   /// This exception is thrown if we try to store a value of an index type
   /// (VocabIndex, LocalVocabIndex, TextRecordIndex) that is larger than
@@ -193,14 +201,18 @@ class ValueId {
     }
 
     // GCC 11 issues a false positive warning here, so we try to avoid it by
-    // being over-explicit about the branches here.
-    if ((type == VocabIndex || type == EncodedVal) &&
+    // being over-explicit about the branches here. Note that local vocab
+    // entries that can be encoded as an `EncodedVal` or an `InlineLiteral`
+    // use the encoded ID as their position in the vocabulary (see
+    // `LocalVocabEntry::positionInVocab`).
+    if ((type == VocabIndex || type == EncodedVal || type == InlineLiteral) &&
         otherType == LocalVocabIndex) {
       return compareVocabAndLocalVocab(
           LocalVocabEntry::IdProxy::make(getBits()),
           other.getLocalVocabIndex());
     } else if (type == LocalVocabIndex &&
-               (otherType == VocabIndex || otherType == EncodedVal)) {
+               (otherType == VocabIndex || otherType == EncodedVal ||
+                otherType == InlineLiteral)) {
       auto inverseOrder = compareVocabAndLocalVocab(
           LocalVocabEntry::IdProxy::make(other.getBits()),
           getLocalVocabIndex());
@@ -310,6 +322,20 @@ class ValueId {
     return value ? "true" : "false";
   }
 
+  /// Create a `ValueId` for a short plain literal that is stored directly in
+  /// the ID (see `InlineLiteral.h`).
+  static constexpr ValueId makeFromInlineLiteral(
+      ::InlineLiteral literal) noexcept {
+    return addDatatypeBits(literal.toBitRepresentation(),
+                           Datatype::InlineLiteral);
+  }
+
+  /// Obtain the `InlineLiteral` that this `ValueId` encodes. If
+  /// `getDatatype() != InlineLiteral` then the result is unspecified.
+  [[nodiscard]] constexpr ::InlineLiteral getInlineLiteral() const noexcept {
+    return ::InlineLiteral::fromBitRepresentation(removeDatatypeBits(_bits));
+  }
+
   /// Create a `ValueId` for an unsigned index of type
   /// `VocabIndex|TextRecordIndex|LocalVocabIndex`. These types can
   /// represent values in the range [0, 2^60]. When `index` is outside of this
@@ -461,6 +487,8 @@ class ValueId {
         return std::invoke(visitor, getGeoPoint());
       case Datatype::BlankNodeIndex:
         return std::invoke(visitor, getBlankNodeIndex());
+      case Datatype::InlineLiteral:
+        return std::invoke(visitor, getInlineLiteral());
     }
     AD_FAIL();
   }
@@ -485,7 +513,8 @@ class ValueId {
         ostr << (value ? "true" : "false");
       } else if constexpr (ad_utility::isSimilar<T, DateYearOrDuration>) {
         ostr << value.toStringAndType().first;
-      } else if constexpr (ad_utility::isSimilar<T, GeoPoint>) {
+      } else if constexpr (ad_utility::SimilarToAny<T, GeoPoint,
+                                                    ::InlineLiteral>) {
         ostr << value.toStringRepresentation();
       } else if constexpr (ad_utility::isSimilar<T, LocalVocabIndex>) {
         AD_CORRECTNESS_CHECK(value != nullptr);
@@ -423,7 +423,10 @@ inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForId(
     case Datatype::Date:
     case Datatype::GeoPoint:
     case Datatype::BlankNodeIndex:
-      // For `Date` the trivial comparison via bits is also correct.
+    case Datatype::InlineLiteral:
+      // For `Date` the trivial comparison via bits is also correct. For
+      // `InlineLiteral`, this is only correct for equality (the order of the
+      // bits is not the order of the vocabulary, see `compareIdsImpl`).
       return detail::simplifyRanges(
           detail::getRangesForIndexTypes(begin, end, valueId, comparison),
           removeEmptyRanges);
@@ -461,6 +464,7 @@ inline std::vector<std::pair<RandomIt, RandomIt>> getRangesForEqualIds(
       AD_FAIL();
     // TODO<joka921> check what the correct behavior is here.
     case Datatype::EncodedVal:
+    case Datatype::InlineLiteral:
     case Datatype::VocabIndex:
     case Datatype::LocalVocabIndex:
     case Datatype::WordVocabIndex:
@@ -482,7 +486,8 @@ inline bool areTypesCompatible(Datatype typeA, Datatype typeB) {
   };
   // TODO<joka921> Make this work for the WordIndex also.
   auto isString = [](Datatype type) {
-    return ad_utility::contains(ValueId::stringTypes_, type);
+    return ad_utility::contains(ValueId::stringTypes_, type) ||
+           type == Datatype::InlineLiteral;
   };
   auto isUndefined = [](Datatype type) { return type == Datatype::Undefined; };
   // Note: Undefined values cannot be compared to other undefined values.
@@ -516,6 +521,17 @@ ComparisonResult compareIdsImpl(ValueId a, ValueId b, Comparator comparator) {
     return fromBool(std::invoke(comparator, a, b));
   }
 
+  // Two `InlineLiteral`s are compared by their bytes (via the visitor below).
+  // An `InlineLiteral` and a `VocabIndex` are never equal, but their order
+  // would require a vocabulary lookup, so we compare by the datatype. Note that
+  // neither of these orders is the order of the vocabulary. This is correct
+  // for equality, the comparisons that have access to the vocabulary (FILTER,
+  // ORDER BY, MIN, MAX) use `compareStringsWithInlineLiterals` instead.
+  if (typeA != typeB && (typeA == Datatype::InlineLiteral ||
+                         typeB == Datatype::InlineLiteral)) {
+    return fromBool(std::invoke(comparator, a, b));
+  }
+
   // TODO<joka921> We currently don't perform correct comparisons (other than
   // equality) for the `EncodedVal` datatype. This will be added in a future
   // PR. This is okay for now, as 1. the maintainer of an inex has to explicitly
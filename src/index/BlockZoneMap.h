@@ -0,0 +1,94 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_BLOCKZONEMAP_H
+#define QLEVER_SRC_INDEX_BLOCKZONEMAP_H
+
+#include <array>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "backports/span.h"
+#include "backports/three_way_comparison.h"
+#include "global/Id.h"
+#include "util/Serializer/SerializeArrayOrTuple.h"
+#include "util/Serializer/SerializeOptional.h"
+#include "util/Serializer/SerializePair.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/Serializer.h"
+
+// The smallest and the largest `Id` of each datatype that occurs in a column
+// of a block, ordered by the datatype. Within a datatype, the `Id`s are
+// compared by their bits, which is the order of the `Id`s in a permutation.
+// The pairs therefore look exactly like the first and last `Id`s of a sorted
+// sequence of blocks, which is the input of the `PrefilterExpression`s (see
+// `PrefilterExpression::mayBeTrueForZoneMap`).
+using ColumnZoneMap = std::vector<std::pair<Id, Id>>;
+
+// The `ColumnZoneMap`s for the three columns (in the order of the
+// permutation) of a single block. In contrast to the first and last triple of
+// the block, they also bound the values of the columns by which the block is
+// not sorted, e.g. the objects in the PSO permutation.
+struct BlockZoneMap {
+  std::array<ColumnZoneMap, 3> columns_;
+
+  // Compute the zone map of the first three columns of the `block` (an
+  // `IdTable` or a view of it). Return `std::nullopt` if the block contains
+  // entries from a local vocabulary, which can't be compared by their bits.
+  template <typename Block>
+  static std::optional<BlockZoneMap> compute(const Block& block) {
+    BlockZoneMap result;
+    for (size_t i = 0; i < result.columns_.size(); ++i) {
+      auto column = computeForColumn(block.getColumn(i));
+      if (!column.has_value()) {
+        return std::nullopt;
+      }
+      result.columns_[i] = std::move(column.value());
+    }
+    return result;
+  }
+
+  // Compute the `ColumnZoneMap` of a single `column`, see `compute` above.
+  static std::optional<ColumnZoneMap> computeForColumn(
+      ql::span<const Id> column) {
+    static constexpr size_t numDatatypes =
+        static_cast<size_t>(Datatype::MaxValue) + 1;
+    std::array<std::optional<std::pair<Id, Id>>, numDatatypes> rangePerType;
+    for (Id id : column) {
+      auto datatype = id.getDatatype();
+      if (datatype == Datatype::LocalVocabIndex) {
+        return std::nullopt;
+      }
+      auto& range = rangePerType[static_cast<size_t>(datatype)];
+      if (!range.has_value()) {
+        range.emplace(id, id);
+      } else if (id.getBits() < range->first.getBits()) {
+        range->first = id;
+      } else if (id.getBits() > range->second.getBits()) {
+        range->second = id;
+      }
+    }
+    ColumnZoneMap result;
+    for (const auto& range : rangePerType) {
+      if (range.has_value()) {
+        result.push_back(range.value());
+      }
+    }
+    return result;
+  }
+
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(BlockZoneMap, columns_)
+
+  AD_SERIALIZE_FRIEND_FUNCTION(BlockZoneMap) { serializer | arg.columns_; }
+};
+
+// For each block of a permutation (indexed by the `blockIndex_`), the zone map
+// of the block as it is stored on disk, or `std::nullopt` if it couldn't be
+// computed. The zone maps are written by the `CompressedRelationWriter` to a
+// separate file (see `ZONE_MAPS_SUFFIX`), so indices without them still work.
+using BlockZoneMaps = std::vector<std::optional<BlockZoneMap>>;
+
+#endif  // QLEVER_SRC_INDEX_BLOCKZONEMAP_H
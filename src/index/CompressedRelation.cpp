@@ -6,6 +6,7 @@
 
 #include "index/CompressedRelation.h"
 
+#include <filesystem>
 #include <thread>
 
 #include "engine/idTable/CompressedExternalIdTable.h"
@@ -19,6 +20,8 @@
 #include "index/LocatedTriples.h"
 #include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/Iterators.h"
+#include "util/Log.h"
+#include "util/Serializer/FileSerializer.h"
 #include "util/ThreadSafeQueue.h"
 #include "util/Timer.h"
 #include "util/TypeTraits.h"
@@ -160,6 +163,9 @@ CompressedRelationReader::asyncParallelBlockGenerator(
     ad_utility::Timer popTimer_{
         ad_utility::timer::Timer::InitialStatus::Stopped};
     std::mutex blockIteratorMutex_;
+    // The registration of this scan at the `sharedScans_` of the reader. It is
+    // declared before the `queue_`, s.t. it outlives the worker threads.
+    std::optional<SharedBlockScans::Scan> sharedScan_;
     ad_utility::InputRangeTypeErased<
         std::optional<DecompressedBlockAndMetadata>>
         queue_;
@@ -184,6 +190,15 @@ CompressedRelationReader::asyncParallelBlockGenerator(
           getRuntimeParameter<&RuntimeParameters::lazyIndexScanQueueSize_>()};
       auto producer{std::bind(&Generator::readAndDecompressBlock, this)};
 
+      // Share the reading of the blocks with concurrent scans of the same
+      // blocks, see `SharedBlockScans`.
+      if (getRuntimeParameter<&RuntimeParameters::sharedScansMaxMemory_>() >
+          ad_utility::MemorySize::bytes(0)) {
+        sharedScan_.emplace(reader_->sharedScans_->registerScan(
+            scanConfig_.scanColumns_, beginBlock_->blockIndex_,
+            (endBlock_ - 1)->blockIndex_ + 1));
+      }
+
       // Prepare queue for reading and decompressing blocks concurrently using
       // `numThreads` threads.
       queue_ = ad_utility::data_structures::queueManager<
@@ -214,22 +229,68 @@ CompressedRelationReader::asyncParallelBlockGenerator(
       if (scanConfig_.graphFilter_.canBlockBeSkipped(blockMetadata)) {
         return std::pair{myIndex, std::nullopt};
       }
+      // Blocks that have to be filtered by graph only read the other columns
+      // for the rows of the desired graphs (see `readRowsOfDesiredGraphs`).
+      // Such a block is not shared with other scans (which would need all of
+      // its rows), just like the blocks that are skipped because of the graph.
+      if (reader_->canReadRowsOfDesiredGraphs(blockMetadata, scanConfig_)) {
+        lock.unlock();
+        return std::pair{myIndex,
+                         std::optional{reader_->readRowsOfDesiredGraphs(
+                             blockMetadata, scanConfig_)}};
+      }
+      // Blocks that have been compacted are specific to the state of the
+      // located triples of this scan, so only the blocks from the file are
+      // shared.
+      const auto& locatedTriples = scanConfig_.locatedTriples_;
+      if (sharedScan_.has_value() &&
+          locatedTriples.getCompactedBlock(blockMetadata.blockIndex_) ==
+              nullptr) {
+        lock.unlock();
+        return std::pair{myIndex,
+                         std::optional{readSharedBlock(blockMetadata)}};
+      }
+
       // Note: the reading of the blockMetadata could also happen without
       // holding the lock. We still perform it inside the lock to avoid
       // contention of the file. On a fast SSD we could possibly change this,
       // but this has to be investigated.
-      auto compressedBlock = reader_->readCompressedBlockFromFile(
-          blockMetadata, scanConfig_.scanColumns_);
+      auto [compressedBlock, numRows] = reader_->readCompressedBlock(
+          blockMetadata, scanConfig_.scanColumns_, locatedTriples);
 
       lock.unlock();
       auto decompressedBlockAndMetadata =
-          reader_->decompressAndPostprocessBlock(compressedBlock,
-                                                 blockMetadata.numRows_,
+          reader_->decompressAndPostprocessBlock(compressedBlock, numRows,
                                                  scanConfig_, blockMetadata);
       return std::pair{myIndex,
                        std::optional{std::move(decompressedBlockAndMetadata)}};
     };
 
+    // Get the decompressed block from the `sharedScan_` (which reads it only
+    // if no other scan has read it) and postprocess it (or a copy of it if it
+    // is shared with other scans).
+    DecompressedBlockAndMetadata readSharedBlock(
+        const CompressedBlockMetadata& blockMetadata) {
+      auto blockOrSharedBlock = sharedScan_->getBlock(
+          blockMetadata.blockIndex_, blockMetadata.numRows_,
+          [this, &blockMetadata]() {
+            return reader_->decompressBlock(
+                reader_->readCompressedBlockFromFile(blockMetadata,
+                                                     scanConfig_.scanColumns_),
+                blockMetadata.numRows_);
+          });
+      if (auto* sharedBlock =
+              std::get_if<SharedBlockScans::Block>(&blockOrSharedBlock)) {
+        DecompressedBlock block{(*sharedBlock)->numColumns(),
+                                reader_->allocator_};
+        block.insertAtEnd(**sharedBlock);
+        blockOrSharedBlock = std::move(block);
+      }
+      return reader_->postprocessDecompressedBlock(
+          std::get<DecompressedBlock>(std::move(blockOrSharedBlock)),
+          scanConfig_, blockMetadata);
+    }
+
     std::optional<IdTable> get() override {
       if (std::exchange(needsStart_, false)) {
         start();
@@ -825,7 +886,15 @@ DecompressedBlock CompressedRelationReader::readPossiblyIncompleteBlock(
   // Helper lambda that returns the decompressed block or an empty block if
   // `readAndDecompressBlock` returns `std::nullopt`.
   DecompressedBlock block = [&]() {
-    auto result = readAndDecompressBlock(blockMetadata, config);
+    // If no located triples have to be merged into the block, we only
+    // decompress the remaining columns for the rows that match the `scanSpec`
+    // (see `readMatchingRowsOfBlock`).
+    bool useLateMaterialization =
+        scanSpec.col0Id().has_value() &&
+        !locatedTriples.hasTriplesToMerge(blockMetadata.blockIndex_);
+    auto result = useLateMaterialization
+                      ? readMatchingRowsOfBlock(scanSpec, blockMetadata, config)
+                      : readAndDecompressBlock(blockMetadata, config);
     if (scanMetadata.has_value()) {
       scanMetadata.value().get().update(result);
     }
@@ -1149,6 +1218,26 @@ CompressedBlock CompressedRelationReader::readCompressedBlockFromFile(
   return compressedBuffer;
 }
 
+// _____________________________________________________________________________
+std::pair<CompressedBlock, size_t>
+CompressedRelationReader::readCompressedBlock(
+    const CompressedBlockMetadata& blockMetaData,
+    ColumnIndicesRef columnIndices,
+    const LocatedTriplesPerBlock& locatedTriples) const {
+  const auto* compactedBlock =
+      locatedTriples.getCompactedBlock(blockMetaData.blockIndex_);
+  if (compactedBlock == nullptr) {
+    return {readCompressedBlockFromFile(blockMetaData, columnIndices),
+            blockMetaData.numRows_};
+  }
+  CompressedBlock compressedBuffer;
+  compressedBuffer.reserve(columnIndices.size());
+  for (auto columnIndex : columnIndices) {
+    compressedBuffer.push_back(compactedBlock->columns_.at(columnIndex));
+  }
+  return {std::move(compressedBuffer), compactedBlock->metadata_.numRows_};
+}
+
 // ____________________________________________________________________________
 DecompressedBlock CompressedRelationReader::decompressBlock(
     const CompressedBlock& compressedBlock, size_t numRowsToRead) const {
@@ -1167,11 +1256,20 @@ CompressedRelationReader::decompressAndPostprocessBlock(
     const CompressedBlock& compressedBlock, size_t numRowsToRead,
     const CompressedRelationReader::ScanImplConfig& scanConfig,
     const CompressedBlockMetadata& metadata) const {
-  auto decompressedBlock = decompressBlock(compressedBlock, numRowsToRead);
+  return postprocessDecompressedBlock(
+      decompressBlock(compressedBlock, numRowsToRead), scanConfig, metadata);
+}
+
+// ____________________________________________________________________________
+DecompressedBlockAndMetadata
+CompressedRelationReader::postprocessDecompressedBlock(
+    DecompressedBlock decompressedBlock,
+    const CompressedRelationReader::ScanImplConfig& scanConfig,
+    const CompressedBlockMetadata& metadata) const {
   auto [numIndexColumns, includeGraphColumn] =
       prepareLocatedTriples(scanConfig.scanColumns_);
   bool hasUpdates = false;
-  if (scanConfig.locatedTriples_.containsTriples(metadata.blockIndex_)) {
+  if (scanConfig.locatedTriples_.hasTriplesToMerge(metadata.blockIndex_)) {
     decompressedBlock = scanConfig.locatedTriples_.mergeTriples(
         metadata.blockIndex_, decompressedBlock, numIndexColumns,
         includeGraphColumn);
@@ -1209,13 +1307,152 @@ CompressedRelationReader::readAndDecompressBlock(
   if (scanConfig.graphFilter_.canBlockBeSkipped(blockMetaData)) {
     return std::nullopt;
   }
-  CompressedBlock compressedColumns =
-      readCompressedBlockFromFile(blockMetaData, scanConfig.scanColumns_);
-  const auto numRowsToRead = blockMetaData.numRows_;
+  if (canReadRowsOfDesiredGraphs(blockMetaData, scanConfig)) {
+    return readRowsOfDesiredGraphs(blockMetaData, scanConfig);
+  }
+  auto [compressedColumns, numRowsToRead] = readCompressedBlock(
+      blockMetaData, scanConfig.scanColumns_, scanConfig.locatedTriples_);
   return decompressAndPostprocessBlock(compressedColumns, numRowsToRead,
                                        scanConfig, blockMetaData);
 }
 
+// ____________________________________________________________________________
+std::optional<DecompressedBlockAndMetadata>
+CompressedRelationReader::readMatchingRowsOfBlock(
+    const ScanSpecification& scanSpec,
+    const CompressedBlockMetadata& blockMetadata,
+    const ScanImplConfig& scanConfig) const {
+  AD_CORRECTNESS_CHECK(!scanConfig.locatedTriples_.hasTriplesToMerge(
+      blockMetadata.blockIndex_));
+  if (scanConfig.graphFilter_.canBlockBeSkipped(blockMetadata)) {
+    return std::nullopt;
+  }
+
+  // The key columns are the triple columns up to the last one that is fixed
+  // by the `scanSpec`. They are the first columns of the `scanConfig`.
+  std::array fixedIds{scanSpec.col0Id(), scanSpec.col1Id(), scanSpec.col2Id()};
+  size_t numKeyColumns = 0;
+  for (size_t i = 0; i < fixedIds.size(); ++i) {
+    if (fixedIds[i].has_value()) {
+      numKeyColumns = i + 1;
+    }
+  }
+  ColumnIndicesRef columns{scanConfig.scanColumns_};
+  AD_CORRECTNESS_CHECK(numKeyColumns > 0 && numKeyColumns <= columns.size());
+  for (size_t i = 0; i < numKeyColumns; ++i) {
+    AD_CORRECTNESS_CHECK(columns[i] == i);
+  }
+
+  // Read and decompress the key columns, and restrict the block to the rows
+  // that match the `scanSpec`.
+  auto [compressedKeyColumns, numRows] =
+      readCompressedBlock(blockMetadata, columns.subspan(0, numKeyColumns),
+                          scanConfig.locatedTriples_);
+  auto block = decompressBlock(compressedKeyColumns, numRows);
+  size_t beginIdx = 0;
+  size_t endIdx = numRows;
+  for (size_t i = 0; i < numKeyColumns; ++i) {
+    if (!fixedIds[i].has_value()) {
+      continue;
+    }
+    auto column = block.getColumn(i);
+    auto matchingRange = ql::ranges::equal_range(column.begin() + beginIdx,
+                                                 column.begin() + endIdx,
+                                                 fixedIds[i].value());
+    beginIdx = matchingRange.begin() - column.begin();
+    endIdx = matchingRange.end() - column.begin();
+  }
+  block.erase(block.begin() + endIdx, block.end());
+  block.erase(block.begin(), block.begin() + beginIdx);
+
+  // Only if there are matching rows, read and decompress the remaining
+  // columns (e.g. the graph column and the payload columns), and copy their
+  // matching rows.
+  auto remainingColumns = columns.subspan(numKeyColumns);
+  std::optional<DecompressedBlock> remainingBlock;
+  if (!block.empty() && !remainingColumns.empty()) {
+    auto [compressedRemainingColumns, numRowsRemaining] = readCompressedBlock(
+        blockMetadata, remainingColumns, scanConfig.locatedTriples_);
+    AD_CORRECTNESS_CHECK(numRowsRemaining == numRows);
+    remainingBlock = decompressBlock(compressedRemainingColumns, numRows);
+  }
+  for (size_t i = 0; i < remainingColumns.size(); ++i) {
+    block.addEmptyColumn();
+    if (remainingBlock.has_value()) {
+      auto column = remainingBlock.value().getColumn(i);
+      ql::ranges::copy(column.begin() + beginIdx, column.begin() + endIdx,
+                       block.getColumn(numKeyColumns + i).begin());
+    }
+  }
+  return postprocessDecompressedBlock(std::move(block), scanConfig,
+                                      blockMetadata);
+}
+
+// ____________________________________________________________________________
+bool CompressedRelationReader::canReadRowsOfDesiredGraphs(
+    const CompressedBlockMetadata& blockMetadata,
+    const ScanImplConfig& scanConfig) const {
+  return useGraphPostProcessing_ && scanConfig.scanColumns_.size() > 1 &&
+         scanConfig.graphFilter_.blockNeedsFilteringByGraph(blockMetadata) &&
+         !scanConfig.locatedTriples_.hasTriplesToMerge(
+             blockMetadata.blockIndex_);
+}
+
+// ____________________________________________________________________________
+DecompressedBlockAndMetadata CompressedRelationReader::readRowsOfDesiredGraphs(
+    const CompressedBlockMetadata& blockMetadata,
+    const ScanImplConfig& scanConfig) const {
+  AD_CORRECTNESS_CHECK(canReadRowsOfDesiredGraphs(blockMetadata, scanConfig));
+  const auto& filter = scanConfig.graphFilter_;
+  ColumnIndicesRef columns{scanConfig.scanColumns_};
+  size_t graphColumn = filter.graphColumn_;
+  AD_CORRECTNESS_CHECK(graphColumn < columns.size());
+
+  // Read and decompress the graph column, and determine the rows that belong
+  // to one of the desired graphs.
+  auto [compressedGraphColumn, numRows] = readCompressedBlock(
+      blockMetadata, columns.subspan(graphColumn, 1),
+      scanConfig.locatedTriples_);
+  auto graphs = decompressBlock(compressedGraphColumn, numRows);
+  auto graphIds = graphs.getColumn(0);
+  std::vector<size_t> matchingRows;
+  for (size_t i = 0; i < numRows; ++i) {
+    if (filter.graphFilter_.isGraphAllowed(graphIds[i])) {
+      matchingRows.push_back(i);
+    }
+  }
+
+  // Only if there are matching rows, read and decompress the remaining
+  // columns, and copy their matching rows.
+  DecompressedBlock block{columns.size(), allocator_};
+  block.resize(matchingRows.size());
+  if (!matchingRows.empty()) {
+    ColumnIndices remainingColumns;
+    for (size_t i = 0; i < columns.size(); ++i) {
+      if (i != graphColumn) {
+        remainingColumns.push_back(columns[i]);
+      }
+    }
+    auto [compressedRemainingColumns, numRowsRemaining] = readCompressedBlock(
+        blockMetadata, remainingColumns, scanConfig.locatedTriples_);
+    AD_CORRECTNESS_CHECK(numRowsRemaining == numRows);
+    auto remainingBlock = decompressBlock(compressedRemainingColumns, numRows);
+    auto copyMatchingRows = [&matchingRows](const auto& from, auto to) {
+      ql::ranges::transform(matchingRows, to.begin(),
+                            [&from](size_t row) { return from[row]; });
+    };
+    for (size_t i = 0; i < columns.size(); ++i) {
+      copyMatchingRows(
+          i == graphColumn
+              ? graphIds
+              : remainingBlock.getColumn(i < graphColumn ? i : i - 1),
+          block.getColumn(i));
+    }
+  }
+  return postprocessDecompressedBlock(std::move(block), scanConfig,
+                                      blockMetadata);
+}
+
 // ____________________________________________________________________________
 CompressedBlockMetadata::OffsetAndCompressedSize
 CompressedRelationWriter::compressAndWriteColumn(ql::span<const Id> column) {
@@ -1248,13 +1485,19 @@ void CompressedRelationWriter::compressAndWriteBlock(Id firstCol0Id,
     AD_CORRECTNESS_CHECK(lastCol0Id == last[0]);
 
     auto [hasDuplicates, graphInfo] = getGraphInfo(block);
-    blockBuffer_.wlock()->emplace_back(CompressedBlockMetadataNoBlockIndex{
-        std::move(offsets),
-        numRows,
-        {first[0], first[1], first[2], first[3]},
-        {last[0], last[1], last[2], last[3]},
-        std::move(graphInfo),
-        hasDuplicates});
+    std::optional<BlockZoneMap> zoneMap;
+    if (writeZoneMaps_) {
+      zoneMap = BlockZoneMap::compute(block);
+    }
+    blockBuffer_.wlock()->emplace_back(
+        CompressedBlockMetadataNoBlockIndex{
+            std::move(offsets),
+            numRows,
+            {first[0], first[1], first[2], first[3]},
+            {last[0], last[1], last[2], last[3]},
+            std::move(graphInfo),
+            hasDuplicates},
+        std::move(zoneMap));
     if (invokeCallback && smallBlocksCallback_) {
       std::invoke(smallBlocksCallback_, std::move(block));
     }
@@ -1262,6 +1505,18 @@ void CompressedRelationWriter::compressAndWriteBlock(Id firstCol0Id,
   timer.stop();
 }
 
+// _____________________________________________________________________________
+void CompressedRelationWriter::writeZoneMapsToFile(
+    ql::span<const CompressedBlockMetadata> blocks,
+    const BlockZoneMaps& zoneMaps) {
+  auto filename = absl::StrCat(outfile_.wlock()->name(), ZONE_MAPS_SUFFIX);
+  if (!writeZoneMaps_) {
+    std::filesystem::remove(filename);
+    return;
+  }
+  writePerBlockDataToFile(filename, blocks, zoneMaps);
+}
+
 // _____________________________________________________________________________
 size_t CompressedRelationReader::getNumberOfBlockMetadataValues(
     const BlockMetadataRanges& blockMetadata) {
@@ -1852,6 +2107,182 @@ void CompressedRelationReader::ScanSpecAndBlocks::removePrefix(
   blockMetadata_.erase(blockMetadata_.begin(), it);
 }
 
+// Return true iff the contents of the block with the given index differ from
+// the block on disk because of located triples (also if these have already been
+// merged into a compacted block). The per-block data that was computed for the
+// blocks on disk (membership filters and zone maps) must not be used for such
+// blocks. The last block (which only consists of located triples) has no such
+// data anyway.
+static bool isModifiedByLocatedTriples(
+    size_t blockIndex, const LocatedTriplesPerBlock& locatedTriples) {
+  return locatedTriples.containsTriples(blockIndex) ||
+         locatedTriples.getCompactedBlock(blockIndex) != nullptr;
+}
+
+// _____________________________________________________________________________
+void CompressedRelationReader::ScanSpecAndBlocks::
+    removeBlocksExcludedByMembershipFilters(
+        const BlockMembershipFilters& filters,
+        const LocatedTriplesPerBlock& locatedTriples) {
+  auto col0Id = scanSpec_.col0Id();
+  auto col1Id = scanSpec_.col1Id();
+  auto col2Id = scanSpec_.col2Id();
+  if (!col0Id.has_value() || !col1Id.has_value() || !col2Id.has_value()) {
+    return;
+  }
+  auto key = membershipFilterKey(col0Id.value(), col1Id.value(),
+                                 col2Id.value());
+  removeBlocksIf([&](const CompressedBlockMetadata& block) {
+    auto blockIndex = block.blockIndex_;
+    if (blockIndex >= filters.size() || !filters[blockIndex].has_value() ||
+        isModifiedByLocatedTriples(blockIndex, locatedTriples)) {
+      return false;
+    }
+    return !filters[blockIndex].value().mayContain(key);
+  });
+}
+
+// _____________________________________________________________________________
+void CompressedRelationReader::ScanSpecAndBlocks::
+    removeBlocksExcludedByZoneMaps(
+        const BlockZoneMaps& zoneMaps, size_t column,
+        const LocatedTriplesPerBlock& locatedTriples,
+        const std::function<bool(const ColumnZoneMap&)>& mayContainMatch) {
+  AD_CONTRACT_CHECK(column < 3);
+  removeBlocksIf([&](const CompressedBlockMetadata& block) {
+    auto blockIndex = block.blockIndex_;
+    if (blockIndex >= zoneMaps.size() || !zoneMaps[blockIndex].has_value() ||
+        isModifiedByLocatedTriples(blockIndex, locatedTriples)) {
+      return false;
+    }
+    return !mayContainMatch(zoneMaps[blockIndex].value().columns_[column]);
+  });
+}
+
+// _____________________________________________________________________________
+void CompressedRelationReader::ScanSpecAndBlocks::removeBlocksIf(
+    const std::function<bool(const CompressedBlockMetadata&)>& canBeRemoved) {
+  BlockMetadataRanges result;
+  for (const auto& range : blockMetadata_) {
+    auto it = range.begin();
+    while (it != range.end()) {
+      it = std::find_if_not(it, range.end(), canBeRemoved);
+      auto end = std::find_if(it, range.end(), canBeRemoved);
+      if (it != end) {
+        result.emplace_back(it, end);
+      }
+      it = end;
+    }
+  }
+  blockMetadata_ = std::move(result);
+  sizeBlockMetadata_ = getNumberOfBlockMetadataValues(blockMetadata_);
+}
+
+// _____________________________________________________________________________
+BlockMembershipFilters CompressedRelationReader::computeMembershipFilters(
+    ql::span<const CompressedBlockMetadata> blocks, size_t numThreads,
+    const CancellationHandle& cancellationHandle) const {
+  BlockMembershipFilters filters(blocks.size());
+  ad_utility::TaskQueue<false> queue{2 * numThreads, numThreads,
+                                     "Building membership filters"};
+  for (const auto& block : blocks) {
+    cancellationHandle->throwIfCancelled();
+    AD_CORRECTNESS_CHECK(block.blockIndex_ < filters.size());
+    // Each task writes to a different element of `filters`.
+    queue.push([this, &block, &filters]() {
+      static constexpr std::array<ColumnIndex, 3> columns{0, 1, 2};
+      auto triples = decompressBlock(
+          readCompressedBlockFromFile(block, columns), block.numRows_);
+      std::vector<uint64_t> keys;
+      keys.reserve(triples.numRows());
+      for (const auto& row : triples) {
+        keys.push_back(membershipFilterKey(row[0], row[1], row[2]));
+      }
+      filters[block.blockIndex_] =
+          ad_utility::XorFilter::build(std::move(keys));
+    });
+  }
+  queue.finish();
+  return filters;
+}
+
+// _____________________________________________________________________________
+uint64_t blockMetadataFingerprint(
+    ql::span<const CompressedBlockMetadata> blocks) {
+  using F = ad_utility::XorFilter;
+  uint64_t fingerprint = F::mix(blocks.size());
+  auto add = [&fingerprint](uint64_t value) {
+    fingerprint = F::mix(fingerprint ^ value);
+  };
+  for (const auto& block : blocks) {
+    add(block.numRows_);
+    if (block.offsetsAndCompressedSize_.has_value()) {
+      for (const auto& column : block.offsetsAndCompressedSize_.value()) {
+        add(static_cast<uint64_t>(column.offsetInFile_));
+        add(column.compressedSize_);
+      }
+    }
+    for (const auto& triple : {block.firstTriple_, block.lastTriple_}) {
+      for (Id id : {triple.col0Id_, triple.col1Id_, triple.col2Id_,
+                    triple.graphId_}) {
+        add(id.getBits());
+      }
+    }
+  }
+  return fingerprint;
+}
+
+// _____________________________________________________________________________
+template <typename PerBlockData>
+void writePerBlockDataToFile(const std::string& filename,
+                             ql::span<const CompressedBlockMetadata> blocks,
+                             const PerBlockData& data) {
+  AD_CONTRACT_CHECK(data.size() == blocks.size());
+  ad_utility::serialization::FileWriteSerializer serializer{filename};
+  serializer << blockMetadataFingerprint(blocks);
+  serializer << data;
+}
+
+// _____________________________________________________________________________
+template <typename PerBlockData>
+std::optional<PerBlockData> readPerBlockDataFromFileIfExists(
+    const std::string& filename,
+    ql::span<const CompressedBlockMetadata> blocks) {
+  if (!std::filesystem::exists(filename)) {
+    return std::nullopt;
+  }
+  ad_utility::serialization::FileReadSerializer serializer{filename};
+  // Files from before the fingerprint was introduced start with the size of
+  // the data instead, which (almost certainly) doesn't match either.
+  uint64_t fingerprint;
+  serializer >> fingerprint;
+  if (fingerprint != blockMetadataFingerprint(blocks)) {
+    AD_LOG_WARN << "The file " << filename
+                << " doesn't belong to the blocks of the permutation (it was "
+                   "probably left over from a previous index build) and is "
+                   "ignored"
+                << std::endl;
+    return std::nullopt;
+  }
+  PerBlockData data;
+  serializer >> data;
+  AD_CORRECTNESS_CHECK(data.size() == blocks.size());
+  return data;
+}
+
+template void writePerBlockDataToFile<BlockMembershipFilters>(
+    const std::string&, ql::span<const CompressedBlockMetadata>,
+    const BlockMembershipFilters&);
+template void writePerBlockDataToFile<BlockZoneMaps>(
+    const std::string&, ql::span<const CompressedBlockMetadata>,
+    const BlockZoneMaps&);
+template std::optional<BlockMembershipFilters>
+readPerBlockDataFromFileIfExists<BlockMembershipFilters>(
+    const std::string&, ql::span<const CompressedBlockMetadata>);
+template std::optional<BlockZoneMaps>
+readPerBlockDataFromFileIfExists<BlockZoneMaps>(
+    const std::string&, ql::span<const CompressedBlockMetadata>);
+
 // _____________________________________________________________________________
 void CompressedRelationReader::LazyScanMetadata::update(
     const DecompressedBlockAndMetadata& blockAndMetadata) {
@@ -14,8 +14,10 @@
 #include "backports/type_traits.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "index/BlockZoneMap.h"
 #include "index/KeyOrder.h"
 #include "index/ScanSpecification.h"
+#include "index/SharedBlockScans.h"
 #include "parser/data/LimitOffsetClause.h"
 #include "util/CancellationHandle.h"
 #include "util/File.h"
@@ -25,6 +27,7 @@
 #include "util/Serializer/SerializeVector.h"
 #include "util/Serializer/Serializer.h"
 #include "util/TaskQueue.h"
+#include "util/XorFilter.h"
 
 // Forward declarations
 class IdTable;
@@ -235,6 +238,48 @@ using BlockMetadataRange = ql::ranges::subrange<BlockMetadataIt>;
 // Vector containing `BlockMetadataRange`s.
 using BlockMetadataRanges = std::vector<BlockMetadataRange>;
 
+// For each block of a permutation (indexed by the `blockIndex_`), an optional
+// filter for the triples (without the graph) that are stored in this block on
+// disk. The keys of the filter are computed by `membershipFilterKey`. The
+// filters allow to skip most of the blocks when looking for a single triple
+// with all three columns fixed (e.g. for `ASK` or `EXISTS`). They are only
+// built if requested during the index building and are stored in a separate
+// file (see `MEMBERSHIP_FILTERS_SUFFIX`), so indices without them still work.
+using BlockMembershipFilters =
+    std::vector<std::optional<ad_utility::XorFilter>>;
+
+// The key of the triple `col0, col1, col2` (in the order of the permutation)
+// for the `BlockMembershipFilters`.
+inline uint64_t membershipFilterKey(Id col0, Id col1, Id col2) {
+  using F = ad_utility::XorFilter;
+  return F::mix(F::mix(F::mix(col0.getBits()) ^ col1.getBits()) ^
+                col2.getBits());
+}
+
+// A fingerprint of the given blocks of a permutation (their positions and
+// sizes in the file and their first and last triple). The data with one entry
+// per block (`BlockMembershipFilters` and `BlockZoneMaps`) is stored together
+// with this fingerprint, so that a file that belongs to a different build of
+// the permutation is detected (even if the number of blocks happens to match).
+uint64_t blockMetadataFingerprint(
+    ql::span<const CompressedBlockMetadata> blocks);
+
+// Write the `data` with one entry per block of the `blocks` (see above) to the
+// file with the given `filename`, preceded by the fingerprint of the `blocks`.
+template <typename PerBlockData>
+void writePerBlockDataToFile(const std::string& filename,
+                             ql::span<const CompressedBlockMetadata> blocks,
+                             const PerBlockData& data);
+
+// Read the data with one entry per block that was written by
+// `writePerBlockDataToFile`. Return `std::nullopt` if the file doesn't exist
+// (the data is optional) or if it doesn't belong to the given `blocks`, e.g.
+// because it was left over from a previous build of the permutation.
+template <typename PerBlockData>
+std::optional<PerBlockData> readPerBlockDataFromFileIfExists(
+    const std::string& filename,
+    ql::span<const CompressedBlockMetadata> blocks);
+
 // The metadata of a whole compressed "relation", where relation refers to a
 // maximal sequence of triples with equal first component (e.g., P for the PSO
 // permutation).
@@ -283,8 +328,14 @@ AD_SERIALIZE_FUNCTION(CompressedRelationMetadata) {
 class CompressedRelationWriter {
  private:
   ad_utility::Synchronized<ad_utility::File> outfile_;
-  ad_utility::Synchronized<std::vector<CompressedBlockMetadataNoBlockIndex>>
-      blockBuffer_;
+  // The metadata of the written blocks together with their zone maps (which
+  // are only computed if `writeZoneMaps_` is set).
+  using BlockMetadataAndZoneMap = std::pair<CompressedBlockMetadataNoBlockIndex,
+                                            std::optional<BlockZoneMap>>;
+  ad_utility::Synchronized<std::vector<BlockMetadataAndZoneMap>> blockBuffer_;
+  // If set, the `BlockZoneMaps` of the blocks are written to the file of the
+  // permutation with the `ZONE_MAPS_SUFFIX` appended.
+  bool writeZoneMaps_;
   // If multiple small relations are stored in the same block, keep track of the
   // first and last `col0Id`.
   Id currentBlockFirstCol0_ = Id::makeUndefined();
@@ -319,11 +370,15 @@ class CompressedRelationWriter {
   static constexpr float multiplicityDummy = 42.4242f;
 
  public:
-  /// Create using a filename, to which the relation data will be written.
+  /// Create using a filename, to which the relation data will be written. If
+  /// `writeZoneMaps` is set, the `BlockZoneMaps` of the blocks are written to
+  /// a separate file, see `ZONE_MAPS_SUFFIX`.
   explicit CompressedRelationWriter(
       size_t numColumns, ad_utility::File f,
-      ad_utility::MemorySize uncompressedBlocksizePerColumn)
+      ad_utility::MemorySize uncompressedBlocksizePerColumn,
+      bool writeZoneMaps = false)
       : outfile_{std::move(f)},
+        writeZoneMaps_{writeZoneMaps},
         numColumns_{numColumns},
         uncompressedBlocksizePerColumn_{uncompressedBlocksizePerColumn} {}
   // Two helper types used to make the interface of the function
@@ -413,20 +468,25 @@ class CompressedRelationWriter {
       qlever::KeyOrder permutation, const PerBlockCallbacks& perBlockCallbacks);
 
   /// Get all the CompressedBlockMetaData that were created by the calls to
-  /// addRelation. This also closes the writer. The typical workflow is:
-  /// add all relations and then call this method.
+  /// addRelation. This also closes the writer and writes the zone maps of the
+  /// blocks (if requested). The typical workflow is: add all relations and
+  /// then call this method.
   std::vector<CompressedBlockMetadata> getFinishedBlocks() && {
     finish();
     auto blocks = std::move(*(blockBuffer_.wlock()));
-    ql::ranges::sort(blocks, {},
-                     &CompressedBlockMetadataNoBlockIndex::firstTriple_);
+    ql::ranges::sort(blocks, {}, [](const BlockMetadataAndZoneMap& block) {
+      return block.first.firstTriple_;
+    });
 
     std::vector<CompressedBlockMetadata> result;
     result.reserve(blocks.size());
+    BlockZoneMaps zoneMaps;
     // Write the correct block indices
     for (size_t i : ad_utility::integerRange(blocks.size())) {
-      result.push_back({std::move(blocks.at(i)), i});
+      result.push_back({std::move(blocks.at(i).first), i});
+      zoneMaps.push_back(std::move(blocks.at(i).second));
     }
+    writeZoneMapsToFile(result, zoneMaps);
 
     AD_CORRECTNESS_CHECK(
         CompressedBlockMetadata::checkInvariantsForSortedBlocks(result));
@@ -463,6 +523,13 @@ class CompressedRelationWriter {
     outfile_.wlock()->close();
   }
 
+  // Write the `zoneMaps` of the `blocks` to the file of the permutation with
+  // the `ZONE_MAPS_SUFFIX` appended (see `writePerBlockDataToFile`). If
+  // `writeZoneMaps_` is not set, only remove a file with zone maps from a
+  // previous build of the permutation.
+  void writeZoneMapsToFile(ql::span<const CompressedBlockMetadata> blocks,
+                           const BlockZoneMaps& zoneMaps);
+
   // Compress the contents of `smallRelationsBuffer_` into a single
   // block and write it to outfile_. Update `currentBlockData_` with the meta
   // data of the written block. Then clear `smallRelationsBuffer_`.
@@ -571,17 +638,17 @@ class CompressedRelationReader {
     // Delete the `graphColumn_` from `block` if `deleteGraphColumn_` is true.
     void deleteGraphColumnIfNecessary(IdTable& block) const;
 
-   private:
-    // Return a lambda that returns true if `desiredGraphs_` allows the given
-    // `graph` and it is not the default graph.
-    auto isGraphAllowedLambda() const;
-
-    // Return true iff all triples from the block belong to the
+    // Return false iff all triples from the block belong to the
     // `desiredGraphs_`, and if this fact can be determined by looking at the
     // metadata alone.
     bool blockNeedsFilteringByGraph(
         const CompressedBlockMetadata& metadata) const;
 
+   private:
+    // Return a lambda that returns true if `desiredGraphs_` allows the given
+    // `graph` and it is not the default graph.
+    auto isGraphAllowedLambda() const;
+
     // Implementation of the various steps of `postprocessBlock`. Each of them
     // returns `true` iff filtering the block was necessary.
     bool filterByGraphIfNecessary(
@@ -646,6 +713,29 @@ class CompressedRelationReader {
     // be used if it is known that those are not needed anymore, e.g. because
     // they have already been dealt with by a lazy `IndexScan` or `Join`.
     void removePrefix(size_t numBlocksToRemove);
+
+    // If all three columns of the `scanSpec_` are fixed, remove the blocks
+    // which, according to the `filters`, don't contain this triple. Blocks
+    // with located triples are never removed, because their contents differ
+    // from the contents for which the filters were built.
+    void removeBlocksExcludedByMembershipFilters(
+        const BlockMembershipFilters& filters,
+        const LocatedTriplesPerBlock& locatedTriples);
+
+    // Remove the blocks for which `mayContainMatch` returns false for the
+    // `ColumnZoneMap` of the given `column` of the block. This is used for
+    // filters on a column by which the blocks are not sorted. As above, blocks
+    // with located triples are never removed.
+    void removeBlocksExcludedByZoneMaps(
+        const BlockZoneMaps& zoneMaps, size_t column,
+        const LocatedTriplesPerBlock& locatedTriples,
+        const std::function<bool(const ColumnZoneMap&)>& mayContainMatch);
+
+   private:
+    // Remove the blocks for which `canBeRemoved` returns true.
+    void removeBlocksIf(
+        const std::function<bool(const CompressedBlockMetadata&)>&
+            canBeRemoved);
   };
 
   // This struct additionally contains the first and last triple of the scan
@@ -714,6 +804,11 @@ class CompressedRelationReader {
   // used for materialized views where repeated rows are meaningful.
   bool useGraphPostProcessing_;
 
+  // Lets concurrent lazy scans share the reading of the blocks. Shared by all
+  // the readers of the same file (see `makeReaderWithReboundAllocator`).
+  std::shared_ptr<SharedBlockScans> sharedScans_ =
+      std::make_shared<SharedBlockScans>();
+
  public:
   explicit CompressedRelationReader(Allocator allocator, ad_utility::File file,
                                     bool useGraphPostProcessing = true)
@@ -867,6 +962,13 @@ class CompressedRelationReader {
       const ScanSpecAndBlocks& metadataAndBlocks,
       const LocatedTriplesPerBlock& locatedTriplesPerBlock) const;
 
+  // Read all the `blocks` of this permutation and build the
+  // `BlockMembershipFilters` for them. The blocks are processed concurrently
+  // by `numThreads` threads.
+  BlockMembershipFilters computeMembershipFilters(
+      ql::span<const CompressedBlockMetadata> blocks, size_t numThreads,
+      const CancellationHandle& cancellationHandle) const;
+
   // Get access to the underlying allocator
   const Allocator& allocator() const { return allocator_; }
 
@@ -874,11 +976,16 @@ class CompressedRelationReader {
   // allocator.
   CompressedRelationReader makeReaderWithReboundAllocator(
       Allocator allocator) const {
-    return CompressedRelationReader{std::move(allocator),
+    CompressedRelationReader reader{std::move(allocator),
                                     ad_utility::File{file_.name(), "r"},
                                     useGraphPostProcessing_};
+    reader.sharedScans_ = sharedScans_;
+    return reader;
   }
 
+  // Getter for testing.
+  const SharedBlockScans& sharedScans() const { return *sharedScans_; }
+
  private:
   // Read the block that is identified by the `blockMetaData` from the `file`.
   // Only the columns specified by `columnIndices` are read.
@@ -886,6 +993,15 @@ class CompressedRelationReader {
       const CompressedBlockMetadata& blockMetaData,
       ColumnIndicesRef columnIndices) const;
 
+  // Like `readCompressedBlockFromFile`, but if the block has been compacted
+  // (see `LocatedTriplesPerBlock::getCompactedBlock`), the columns are taken
+  // from the compacted block instead. Also return the number of rows of the
+  // block that was read.
+  std::pair<CompressedBlock, size_t> readCompressedBlock(
+      const CompressedBlockMetadata& blockMetaData,
+      ColumnIndicesRef columnIndices,
+      const LocatedTriplesPerBlock& locatedTriples) const;
+
   // Decompress the `compressedBlock`. The number of rows that the block will
   // have after decompression must be passed in via the `numRowsToRead`
   // argument. It is typically obtained from the corresponding
@@ -916,6 +1032,45 @@ class CompressedRelationReader {
       const CompressedRelationReader::ScanImplConfig& scanConfig,
       const CompressedBlockMetadata& metadata) const;
 
+  // Merge the located triples (if any) into the `decompressedBlock` and apply
+  // the graph filters (if any), both specified as part of the `scanConfig`.
+  DecompressedBlockAndMetadata postprocessDecompressedBlock(
+      DecompressedBlock decompressedBlock,
+      const CompressedRelationReader::ScanImplConfig& scanConfig,
+      const CompressedBlockMetadata& metadata) const;
+
+  // Like `readAndDecompressBlock`, but only return the rows that match the
+  // `scanSpec` (which must fix at least the `col0Id`), and use late
+  // materialization: First only the columns that are fixed by the `scanSpec`
+  // are read and decompressed. The remaining columns of the `scanConfig` (for
+  // example, the graph column and payload columns) are only read and
+  // decompressed if at least one row matches, and only the matching rows are
+  // postprocessed. This saves work for the first and last block of a scan,
+  // which are often shared with other relations. The block must not have
+  // located triples that have to be merged.
+  std::optional<DecompressedBlockAndMetadata> readMatchingRowsOfBlock(
+      const ScanSpecification& scanSpec,
+      const CompressedBlockMetadata& blockMetadata,
+      const ScanImplConfig& scanConfig) const;
+
+  // Return true iff `readRowsOfDesiredGraphs` (see below) can be used for the
+  // block given by `blockMetadata`: The block has to be filtered by graph, it
+  // has no located triples that have to be merged, and there are columns other
+  // than the graph column.
+  bool canReadRowsOfDesiredGraphs(const CompressedBlockMetadata& blockMetadata,
+                                  const ScanImplConfig& scanConfig) const;
+
+  // Like `readAndDecompressBlock`, but use late materialization for a block
+  // that has to be filtered by graph (typically one of the complete blocks in
+  // the middle of a scan, for the first and last block see
+  // `readMatchingRowsOfBlock`): First only the graph column is read and
+  // decompressed. The remaining columns of the `scanConfig` are only read and
+  // decompressed if at least one row belongs to one of the desired graphs, and
+  // only these rows are postprocessed. Requires `canReadRowsOfDesiredGraphs`.
+  DecompressedBlockAndMetadata readRowsOfDesiredGraphs(
+      const CompressedBlockMetadata& blockMetadata,
+      const ScanImplConfig& scanConfig) const;
+
   // Read, decompress, and postprocess the part of the block according to
   // `blockMetadata` (which identifies the block) and `scanConfig` (which
   // specifies the part of that block, graph filters, and located triples).
@@ -62,6 +62,17 @@ constexpr inline std::string_view PARTIAL_VOCAB_IDMAP_INFIX =
 // _________________________________________________________________
 constexpr inline std::string_view QLEVER_INTERNAL_INDEX_INFIX = ".internal";
 
+// _________________________________________________________________
+// The suffix of the (optional) file with the `BlockMembershipFilters` of a
+// permutation, appended to the name of the file of the permutation.
+constexpr inline std::string_view MEMBERSHIP_FILTERS_SUFFIX =
+    ".membership-filters";
+
+// _________________________________________________________________
+// The suffix of the file with the `BlockZoneMaps` of a permutation, appended to
+// the name of the file of the permutation.
+constexpr inline std::string_view ZONE_MAPS_SUFFIX = ".zone-maps";
+
 // _________________________________________________________________
 // The degree of parallelism that is used for the index building step, where the
 // unique elements of the vocabulary are identified via hash maps. Typically, 6
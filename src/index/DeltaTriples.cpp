@@ -14,9 +14,12 @@
 
 #include <absl/strings/str_cat.h>
 
+#include <future>
+
 #include "backports/algorithm.h"
 #include "engine/ExecuteUpdate.h"
 #include "engine/ExportQueryExecutionTrees.h"
+#include "global/RuntimeParameters.h"
 #include "index/ExportIds.h"
 #include "index/Index.h"
 #include "index/IndexImpl.h"
@@ -81,9 +84,9 @@ LocatedTriplesState::getLocatedTriples() const {
 
 // ____________________________________________________________________________
 template <bool isInternal>
-LocatedTriples::iterator& DeltaTriples::TriplesToHandles<isInternal>::
-    LocatedTripleHandles::forPermutation(Permutation::Enum permutation) {
-  return handles_[static_cast<size_t>(permutation)];
+size_t& DeltaTriples::TriplesToHandles<isInternal>::LocatedTripleHandles::
+    forPermutation(Permutation::Enum permutation) {
+  return blockIndices_[static_cast<size_t>(permutation)];
 }
 
 // ____________________________________________________________________________
@@ -97,6 +100,7 @@ void DeltaTriples::clear() {
             locatedTriples_->getLocatedTriples<false>());
   clearImpl(triplesToHandlesInternal_,
             locatedTriples_->getLocatedTriples<true>());
+  requireCheckpoint();
 }
 
 // ____________________________________________________________________________
@@ -127,7 +131,8 @@ nlohmann::json DeltaTriples::vacuum(
               [&triples, &triplesToHandlesMap, this, &isInternal](size_t i) {
                 auto it = triplesToHandlesMap.find(triples[i]);
                 AD_CORRECTNESS_CHECK(it != triplesToHandlesMap.end());
-                this->eraseTripleInAllPermutations<isInternal>(it->second);
+                this->eraseTripleInAllPermutations<isInternal>(it->first,
+                                                               it->second);
                 triplesToHandlesMap.erase(it);
               },
               [&cancellationHandle]() {
@@ -139,6 +144,7 @@ nlohmann::json DeltaTriples::vacuum(
         removeTriples(insertionsToRemove, state.triplesInserted_);
       };
 
+  requireCheckpoint();
   nlohmann::json result = nlohmann::json::object();
   auto toRemoveInExternal = identifyTriplesToVacuum(vi<false>);
   removeIdentifiedTriples(vi<false>, toRemoveInExternal.deletionsToRemove_,
@@ -173,47 +179,83 @@ DeltaTriples::locateAndAddTriples(CancellationHandle cancellationHandle,
                                   ad_utility::timer::TimeTracer& tracer) {
   constexpr const auto& allPermutations = Permutation::all<isInternal>();
   auto& lt = locatedTriples_->getLocatedTriples<isInternal>();
-  std::array<std::vector<LocatedTriples::iterator>, allPermutations.size()>
-      intermediateHandles;
-  for (auto permutation : allPermutations) {
-    tracer.beginTrace(std::string{Permutation::toString(permutation)});
-    tracer.beginTrace("locateTriples");
+  std::vector<typename TriplesToHandles<isInternal>::LocatedTripleHandles>
+      handles{triples.size()};
+  // Locate the triples in the given permutation and add them to its located
+  // triples. The permutations are independent of each other (the `handles`
+  // are written at different positions), so this can run concurrently.
+  auto locateAndAdd = [&](Permutation::Enum permutation,
+                          ad_utility::timer::TimeTracer& permutationTracer) {
+    permutationTracer.beginTrace("locateTriples");
     auto& basePerm = index_.getPermutation(permutation);
     auto& perm = isInternal ? basePerm.internalPermutation() : basePerm;
     auto locatedTriples = LocatedTriple::locateTriplesInPermutation(
         triples, perm.metaData().blockData(), perm.keyOrder(), insertOrDelete,
         cancellationHandle);
     cancellationHandle->throwIfCancelled();
-    tracer.endTrace("locateTriples");
-    tracer.beginTrace("addToLocatedTriples");
-    intermediateHandles[static_cast<size_t>(permutation)] =
-        lt[static_cast<size_t>(permutation)].add(locatedTriples, tracer);
+    permutationTracer.endTrace("locateTriples");
+    permutationTracer.beginTrace("addToLocatedTriples");
+    lt[static_cast<size_t>(permutation)].add(locatedTriples, permutationTracer);
     cancellationHandle->throwIfCancelled();
-    tracer.endTrace("addToLocatedTriples");
-    tracer.endTrace(Permutation::toString(permutation));
+    permutationTracer.endTrace("addToLocatedTriples");
+    permutationTracer.beginTrace("transformHandles");
+    AD_CORRECTNESS_CHECK(locatedTriples.size() == triples.size());
+    for (size_t i = 0; i < triples.size(); i++) {
+      handles[i].forPermutation(permutation) = locatedTriples[i].blockIndex_;
+    }
+    permutationTracer.endTrace("transformHandles");
+  };
+
+  // For small updates, starting the threads is more expensive than the actual
+  // work.
+  if (triples.size() < minNumTriplesForParallelLocation_) {
+    for (auto permutation : allPermutations) {
+      tracer.beginTrace(std::string{Permutation::toString(permutation)});
+      locateAndAdd(permutation, tracer);
+      tracer.endTrace(Permutation::toString(permutation));
+    }
+    return handles;
   }
-  tracer.beginTrace("transformHandles");
-  std::vector<typename TriplesToHandles<isInternal>::LocatedTripleHandles>
-      handles{triples.size()};
+  // The `TimeTracer` is not thread-safe, so only the total time is traced.
+  tracer.beginTrace("allPermutationsInParallel");
+  std::vector<std::future<void>> futures;
   for (auto permutation : allPermutations) {
-    for (size_t i = 0; i < triples.size(); i++) {
-      handles[i].forPermutation(permutation) =
-          intermediateHandles[static_cast<size_t>(permutation)][i];
+    futures.push_back(
+        std::async(std::launch::async, [&locateAndAdd, permutation]() {
+          locateAndAdd(permutation, ad_utility::timer::DEFAULT_TIME_TRACER);
+        }));
+  }
+  // Wait for all threads before rethrowing an exception, because they all
+  // refer to local variables.
+  std::exception_ptr exception;
+  for (auto& future : futures) {
+    try {
+      future.get();
+    } catch (...) {
+      exception = std::current_exception();
     }
   }
-  tracer.endTrace("transformHandles");
+  if (exception) {
+    std::rethrow_exception(exception);
+  }
+  tracer.endTrace("allPermutationsInParallel");
   return handles;
 }
 
 // ____________________________________________________________________________
 template <bool isInternal>
 void DeltaTriples::eraseTripleInAllPermutations(
-    typename TriplesToHandles<isInternal>::LocatedTripleHandles& handles) {
+    const IdTriple<0>& triple,
+    const typename TriplesToHandles<isInternal>::LocatedTripleHandles&
+        handles) {
   auto& lt = locatedTriples_->getLocatedTriples<isInternal>();
   // Erase for all permutations.
   for (auto permutation : Permutation::all<isInternal>()) {
-    auto ltIter = handles.forPermutation(permutation);
-    lt[static_cast<int>(permutation)].erase(ltIter->blockIndex_, ltIter);
+    auto& basePerm = index_.getPermutation(permutation);
+    auto& perm = isInternal ? basePerm.internalPermutation() : basePerm;
+    lt[static_cast<int>(permutation)].erase(
+        handles.blockIndices_[static_cast<size_t>(permutation)],
+        triple.permute(perm.keyOrder()));
   }
 }
 
@@ -421,6 +463,13 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
   tracer.beginTrace("rewriteLocalVocabEntries");
   rewriteLocalVocabEntriesAndBlankNodes(triples);
   tracer.endTrace("rewriteLocalVocabEntries");
+  // The internal triples are derived from the other triples when the log is
+  // replayed.
+  if (!isInternal && writeAheadLog_.has_value() && !checkpointRequired_) {
+    tracer.beginTrace("addToLog");
+    writeAheadLog_->addRecord(insertOrDelete, triples);
+    tracer.endTrace("addToLog");
+  }
   AD_EXPENSIVE_CHECK(ql::ranges::is_sorted(triples));
   AD_EXPENSIVE_CHECK(std::unique(triples.begin(), triples.end()) ==
                      triples.end());
@@ -433,7 +482,7 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
   ql::ranges::for_each(triples, [this, &inverseMap](const IdTriple<0>& triple) {
     auto handle = inverseMap.find(triple);
     if (handle != inverseMap.end()) {
-      eraseTripleInAllPermutations<isInternal>(handle->second);
+      eraseTripleInAllPermutations<isInternal>(handle->first, handle->second);
       inverseMap.erase(triple);
     }
   });
@@ -457,7 +506,8 @@ void DeltaTriples::modifyTriplesImpl(CancellationHandle cancellationHandle,
 LocatedTriplesSharedState DeltaTriples::getLocatedTriplesSharedStateCopy()
     const {
   // Create a copy of the `LocatedTriplesState` for use as a constant
-  // snapshot.
+  // snapshot. This only copies pointers to the located triples of the blocks,
+  // which are shared until they are modified again.
   return LocatedTriplesSharedState{
       std::make_shared<LocatedTriplesState>(LocatedTriplesState{
           locatedTriples_->locatedTriplesPerBlock_,
@@ -558,6 +608,87 @@ INSTANTIATE_MODIFY(nlohmann::json);
 // _____________________________________________________________________________
 void DeltaTriplesManager::clear() { modify<void>(&DeltaTriples::clear); }
 
+// _____________________________________________________________________________
+nlohmann::json DeltaTriplesManager::compact(
+    size_t maxNumBlocksPerPermutation, CancellationHandle cancellationHandle) {
+  using namespace ad_utility::use_value_identity;
+  using CompactedBlocks =
+      std::vector<std::pair<size_t, std::shared_ptr<const CompactedBlock>>>;
+  auto snapshot = getCurrentLocatedTriplesSharedState();
+
+  // The compacted blocks are kept in RAM, so no further blocks are compacted
+  // once they exceed the memory limit. The limit is checked before each round,
+  // so it is exceeded by at most the blocks of a single round.
+  size_t memoryUsed = 0;
+  auto addMemory = [&](auto isInternal) {
+    for (auto permutation : Permutation::all<isInternal>()) {
+      memoryUsed +=
+          snapshot->getLocatedTriplesForPermutation<isInternal>(permutation)
+              .compactedBlocksMemory()
+              .getBytes();
+    }
+  };
+  addMemory(vi<false>);
+  addMemory(vi<true>);
+  auto maxMemory = getRuntimeParameter<
+      &RuntimeParameters::deltaTriplesCompactionMaxMemory_>();
+  if (memoryUsed >= maxMemory.getBytes()) {
+    return nlohmann::json{{"blocksCompacted", 0},
+                          {"blocksOutdated", 0},
+                          {"memoryLimitReached", true}};
+  }
+
+  // The index outlives the `DeltaTriples`, so the reference stays valid.
+  const IndexImpl& index = deltaTriples_.rlock()->index_;
+  auto computeCompactedBlocks = [&](auto isInternal) {
+    std::vector<CompactedBlocks> result;
+    for (auto permutation : Permutation::all<isInternal>()) {
+      const auto& basePerm = index.getPermutation(permutation);
+      const auto& perm = isInternal ? basePerm.internalPermutation() : basePerm;
+      result.push_back(
+          snapshot->getLocatedTriplesForPermutation<isInternal>(permutation)
+              .computeCompactedBlocks(perm, maxNumBlocksPerPermutation,
+                                      cancellationHandle));
+    }
+    return result;
+  };
+  auto compactedBlocks = computeCompactedBlocks(vi<false>);
+  auto internalCompactedBlocks = computeCompactedBlocks(vi<true>);
+
+  size_t numComputed = 0;
+  for (const auto& blocks : {&compactedBlocks, &internalCompactedBlocks}) {
+    for (const auto& blocksForPermutation : *blocks) {
+      numComputed += blocksForPermutation.size();
+    }
+  }
+  size_t numInstalled = 0;
+  if (numComputed > 0) {
+    // Install the blocks and update the augmented metadata (which contains the
+    // sizes of the compacted blocks). Nothing has to be written to disk.
+    modify<void>(
+        [&](DeltaTriples& deltaTriples) {
+          auto install = [&](auto isInternal,
+                             const std::vector<CompactedBlocks>& blocks) {
+            auto& locatedTriples =
+                deltaTriples.locatedTriples_->getLocatedTriples<isInternal>();
+            for (size_t i = 0; i < blocks.size(); ++i) {
+              for (const auto& [blockIndex, block] : blocks.at(i)) {
+                numInstalled += static_cast<size_t>(
+                    locatedTriples.at(i).installCompactedBlock(blockIndex,
+                                                               block));
+              }
+            }
+          };
+          install(vi<false>, compactedBlocks);
+          install(vi<true>, internalCompactedBlocks);
+        },
+        false);
+  }
+  return nlohmann::json{{"blocksCompacted", numInstalled},
+                        {"blocksOutdated", numComputed - numInstalled},
+                        {"memoryLimitReached", false}};
+}
+
 // _____________________________________________________________________________
 LocatedTriplesSharedState
 DeltaTriplesManager::getCurrentLocatedTriplesSharedState() const {
@@ -600,10 +731,29 @@ void DeltaTriples::updateAugmentedMetadata() {
 }
 
 // _____________________________________________________________________________
-void DeltaTriples::writeToDisk() const {
+void DeltaTriples::writeToDisk() {
   if (!filenameForPersisting_.has_value()) {
     return;
   }
+  // Write a checkpoint as soon as the log becomes larger than the checkpoint.
+  // This bounds the time for restoring the delta triples, and the total number
+  // of bytes written stays proportional to the size of the updates.
+  auto& log = writeAheadLog_.value();
+  auto minCheckpointSize =
+      getRuntimeParameter<
+          &RuntimeParameters::deltaTriplesLogMinCheckpointSize_>()
+          .getBytes();
+  if (checkpointRequired_ ||
+      log.sizeAfterCommit() > std::max(minCheckpointSize, checkpointSize_)) {
+    writeCheckpoint();
+  } else {
+    log.commit();
+  }
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::writeCheckpoint() {
+  AD_CORRECTNESS_CHECK(filenameForPersisting_.has_value());
   // TODO<RobinTF> Currently this only writes non-internal delta triples to
   // disk. The internal triples will be regenerated when importing the rest
   // again. In the future we might to also want to explicitly store the
@@ -623,6 +773,20 @@ void DeltaTriples::writeToDisk() const {
       std::array{toRange(triplesToHandlesNormal_.triplesDeleted_),
                  toRange(triplesToHandlesNormal_.triplesInserted_)});
   std::filesystem::rename(tempPath, filenameForPersisting_.value());
+  checkpointSize_ = std::filesystem::file_size(filenameForPersisting_.value());
+  // NOTE: If the server crashes before the log is truncated, the log is
+  // replayed on top of the new checkpoint, which has no effect, because the
+  // checkpoint already contains all the insertions and deletions of the log.
+  writeAheadLog_.value().truncate();
+  checkpointRequired_ = false;
+}
+
+// _____________________________________________________________________________
+void DeltaTriples::requireCheckpoint() {
+  checkpointRequired_ = true;
+  if (writeAheadLog_.has_value()) {
+    writeAheadLog_->discardPendingRecords();
+  }
 }
 
 // _____________________________________________________________________________
@@ -633,10 +797,38 @@ void DeltaTriples::readFromDisk() {
   AD_CONTRACT_CHECK(localVocab_.empty());
   auto [vocab, idRanges] =
       ad_utility::deserializeIds(filenameForPersisting_.value(), index_);
-  if (idRanges.empty()) {
+  LocalVocab vocabOfLog;
+  auto records = DeltaTriplesWriteAheadLog::readRecords(
+      writeAheadLog_.value().filename(), index_, vocabOfLog);
+  if (idRanges.empty() && records.empty()) {
     return;
   }
-  AD_CORRECTNESS_CHECK(idRanges.size() == 2);
+  AD_CORRECTNESS_CHECK(idRanges.empty() || idRanges.size() == 2);
+  // Map the local blank nodes from the files to new blank nodes of the
+  // `localVocab_`. The same mapping has to be used for the checkpoint and all
+  // the records of the log, because the log might refer to the blank nodes of
+  // the checkpoint.
+  ad_utility::HashMap<Id, Id> blankNodeMap;
+  auto remapBlankNodes = [this, &blankNodeMap,
+                          minLocalBlankNode =
+                              index_.getBlankNodeManager()->minIndex_](
+                             Triples triples) {
+    for (auto& triple : triples) {
+      for (Id& id : triple.ids()) {
+        if (id.getDatatype() != Datatype::BlankNodeIndex ||
+            id.getBlankNodeIndex().get() < minLocalBlankNode) {
+          continue;
+        }
+        auto [it, isNew] = blankNodeMap.try_emplace(id, Id::makeUndefined());
+        if (isNew) {
+          it->second = Id::makeFromBlankNodeIndex(
+              localVocab_.getBlankNodeIndex(index_.getBlankNodeManager()));
+        }
+        id = it->second;
+      }
+    }
+    return triples;
+  };
   auto toTriples = [](const std::vector<Id>& ids) {
     Triples triples;
     static_assert(Triples::value_type::PayloadSize == 0);
@@ -651,15 +843,43 @@ void DeltaTriples::readFromDisk() {
   };
   auto cancellationHandle =
       std::make_shared<CancellationHandle::element_type>();
-  insertTriples(cancellationHandle, toTriples(idRanges.at(1)));
-  deleteTriples(cancellationHandle, toTriples(idRanges.at(0)));
-  AD_LOG_INFO << "Done, #inserted triples = " << idRanges.at(1).size()
-              << ", #deleted triples = " << idRanges.at(0).size() << std::endl;
+  if (!idRanges.empty()) {
+    insertTriples(cancellationHandle,
+                  remapBlankNodes(toTriples(idRanges.at(1))));
+    deleteTriples(cancellationHandle,
+                  remapBlankNodes(toTriples(idRanges.at(0))));
+    AD_LOG_INFO << "Done, #inserted triples = " << idRanges.at(1).size()
+                << ", #deleted triples = " << idRanges.at(0).size()
+                << std::endl;
+  }
+  for (auto& record : records) {
+    auto triples = remapBlankNodes(std::move(record.triples_));
+    if (record.insertOrDelete_) {
+      insertTriples(cancellationHandle, std::move(triples));
+    } else {
+      deleteTriples(cancellationHandle, std::move(triples));
+    }
+  }
+  if (!records.empty()) {
+    AD_LOG_INFO << "Replayed " << records.size()
+                << " batches of updates from the log, #inserted triples = "
+                << numInserted() << ", #deleted triples = " << numDeleted()
+                << std::endl;
+  }
+  // The restored delta triples use other local vocab entries and blank nodes
+  // than the ones in the files, so the log cannot be continued.
+  writeCheckpoint();
 }
 
 // _____________________________________________________________________________
 void DeltaTriples::setPersists(std::optional<std::string> filename) {
   filenameForPersisting_ = std::move(filename);
+  writeAheadLog_.reset();
+  if (filenameForPersisting_.has_value()) {
+    writeAheadLog_.emplace(
+        absl::StrCat(filenameForPersisting_.value(), ".wal"));
+  }
+  checkpointRequired_ = true;
 }
 
 // _____________________________________________________________________________
@@ -696,6 +916,9 @@ void DeltaTriples::addFromSnapshotDiff(
     const qlever::indexRebuilder::IndexRebuildMapping& idMapping,
     CancellationHandle cancellationHandle,
     ad_utility::timer::TimeTracer& tracer) {
+  // The internal triples are not derived from the other triples here, so the
+  // triples cannot be replayed from the log of updates.
+  requireCheckpoint();
   tracer.beginTrace("computeLocatedTriplesDiff");
   auto difference = computeLocatedTriplesDiff(oldState, newState);
   difference.remapIds([&idMapping](Id& id) { remapId(idMapping, id); });
@@ -15,6 +15,7 @@
 #include "backports/three_way_comparison.h"
 #include "engine/UpdateMetadata.h"
 #include "global/IdTriple.h"
+#include "index/DeltaTriplesWriteAheadLog.h"
 #include "index/Index.h"
 #include "index/IndexBuilderTypes.h"
 #include "index/IndexRebuilderTypes.h"
@@ -91,6 +92,7 @@ class DeltaTriples {
   FRIEND_TEST(DeltaTriplesTest, clear);
   FRIEND_TEST(DeltaTriplesTest, addTriplesToLocalVocab);
   FRIEND_TEST(DeltaTriplesTest, storeAndRestoreData);
+  FRIEND_TEST(DeltaTriplesTest, writeAheadLog);
 
  public:
   using Triples = std::vector<IdTriple<0>>;
@@ -115,6 +117,21 @@ class DeltaTriples {
   // See the documentation of `setPersist()` below.
   std::optional<std::string> filenameForPersisting_;
 
+  // The log of the updates since the last checkpoint (the complete delta
+  // triples written to `filenameForPersisting_`). It is only used if the
+  // updates are persisted.
+  std::optional<DeltaTriplesWriteAheadLog> writeAheadLog_;
+  // If true, the next call to `writeToDisk` writes a checkpoint, because the
+  // changes since the last checkpoint cannot be (or have not been) expressed
+  // as a log of insertions and deletions (e.g. `clear` or `vacuum`).
+  bool checkpointRequired_ = true;
+  // The size of the last checkpoint in bytes.
+  size_t checkpointSize_ = 0;
+
+  // The minimal number of triples of a single update for which the triples are
+  // located in all permutations concurrently (see `locateAndAddTriples`).
+  size_t minNumTriplesForParallelLocation_ = 10'000;
+
   // Store the id of the `ql:langtag` predicate to avoid repeated disk lookups.
   // This is initialized on first use.
   Id languagePredicate_ = Id::makeUndefined();
@@ -148,12 +165,13 @@ class DeltaTriples {
   template <bool isInternal>
   struct TriplesToHandles {
     // Each delta triple needs to know where it is stored in each of the six
-    // `LocatedTriplesPerBlock` above.
+    // `LocatedTriplesPerBlock` above. We store the block indices and not
+    // iterators into the `LocatedTriples`, because the sets of the blocks are
+    // copied when they are modified while being shared with a snapshot.
     struct LocatedTripleHandles {
-      using It = LocatedTriples::iterator;
-      std::array<It, Permutation::all<isInternal>().size()> handles_;
+      std::array<size_t, Permutation::all<isInternal>().size()> blockIndices_;
 
-      LocatedTriples::iterator& forPermutation(Permutation::Enum permutation);
+      size_t& forPermutation(Permutation::Enum permutation);
     };
     using TriplesToHandlesMap =
         ad_utility::HashMap<IdTriple<0>, LocatedTripleHandles>;
@@ -240,6 +258,19 @@ class DeltaTriples {
                      ad_utility::timer::TimeTracer& tracer =
                          ad_utility::timer::DEFAULT_TIME_TRACER);
 
+  // Rewrite each triple in `triples` such that all local vocab entries and all
+  // local blank nodes are managed by the `localVocab_` of this class.
+  //
+  // NOTE: This is important for two reasons: (1) It avoids duplicates for
+  // successive insertions referring to the same local vocab entries; (2) It
+  // avoids storing local vocab entries or blank nodes that were created only
+  // temporarily when evaluating the WHERE clause of an update query.
+  //
+  // This is done by `insertTriples` and `deleteTriples`. Rewriting the triples
+  // again doesn't change them, so it can be called before these functions to
+  // obtain the `Id`s with which the triples will be stored.
+  void rewriteLocalVocabEntriesAndBlankNodes(Triples& triples);
+
   // Insert internal delta triples for test code. In practice these are inferred
   // from regular triples, so `insertTriples` and `deleteTriples` will insert
   // them on their own.
@@ -256,20 +287,35 @@ class DeltaTriples {
       ad_utility::timer::TimeTracer& tracer =
           ad_utility::timer::DEFAULT_TIME_TRACER);
 
+  // Set the minimal number of triples of a single update for which the
+  // permutations are processed concurrently. Only used in tests to exercise
+  // both the sequential and the concurrent code path on small inputs.
+  void setMinNumTriplesForParallelLocationForTesting(size_t numTriples) {
+    minNumTriplesForParallelLocation_ = numTriples;
+  }
+
   // If the `filename` is set, then `writeToDisk()` will write these
-  // `DeltaTriples` to `filename.value()`. If `filename` is `nullopt`, then
+  // `DeltaTriples` to `filename.value()` (the checkpoint) and to the log of
+  // updates `filename.value() + ".wal"`. If `filename` is `nullopt`, then
   // `writeToDisk` will be a nullop.
   void setPersists(std::optional<std::string> filename);
 
-  // Write the delta triples to disk to persist them between restarts.
-  void writeToDisk() const;
+  // Write the delta triples to disk to persist them between restarts. If
+  // possible, only the insertions and deletions since the last call are
+  // appended to the log, otherwise a checkpoint is written (see the runtime
+  // parameter `delta-triples-log-min-checkpoint-size`).
+  void writeToDisk();
 
-  // Read the delta triples from disk to restore them after a restart.
+  // Read the delta triples from disk (the checkpoint and the log of updates) to
+  // restore them after a restart.
   void readFromDisk();
 
-  // Return a deep copy of the `LocatedTriples` and the corresponding
-  // `LocalVocab` which form an unchanging snapshot of the current state of
-  // this `DeltaTriples` object.
+  // Return a copy of the `LocatedTriples` and the corresponding `LocalVocab`
+  // which form an unchanging snapshot of the current state of this
+  // `DeltaTriples` object. The located triples of the individual blocks are
+  // shared with this object (copy-on-write, see `LocatedTriplesPerBlock`), so
+  // the cost of a copy only depends on the number of blocks with located
+  // triples, not on the number of delta triples.
   LocatedTriplesSharedState getLocatedTriplesSharedStateCopy() const;
 
   // Return a cheap shallow copy of the `LocatedTriples` which directly mirrors
@@ -325,8 +371,10 @@ class DeltaTriples {
   // Find the position of the given triple in the given permutation and add it
   // to each of the six `LocatedTriplesPerBlock` maps (one per permutation).
   // When `insertOrDelete` is `true`, the triples are inserted, otherwise
-  // deleted. Return the iterators of where it was added (so that we can easily
-  // delete it again from these maps later).
+  // deleted. Return the blocks to which they were added (so that we can easily
+  // delete them again from these maps later). For at least
+  // `minNumTriplesForParallelLocation_` triples, the permutations are
+  // processed concurrently, one thread per permutation.
   template <bool isInternal>
   std::vector<typename TriplesToHandles<isInternal>::LocatedTripleHandles>
   locateAndAddTriples(CancellationHandle cancellationHandle,
@@ -345,26 +393,25 @@ class DeltaTriples {
                          ad_utility::timer::TimeTracer& tracer =
                              ad_utility::timer::DEFAULT_TIME_TRACER);
 
-  // Rewrite each triple in `triples` such that all local vocab entries and all
-  // local blank nodes are managed by the `localVocab_` of this class.
-  //
-  // NOTE: This is important for two reasons: (1) It avoids duplicates for
-  // successive insertions referring to the same local vocab entries; (2) It
-  // avoids storing local vocab entries or blank nodes that were created only
-  // temporarily when evaluating the WHERE clause of an update query.
-  void rewriteLocalVocabEntriesAndBlankNodes(Triples& triples);
-  FRIEND_TEST(DeltaTriplesTest, rewriteLocalVocabEntriesAndBlankNodes);
+  // Write all the delta triples to `filenameForPersisting_` and truncate the
+  // log of updates.
+  void writeCheckpoint();
 
-  // Erase `LocatedTriple` object from each `LocatedTriplesPerBlock` list. The
-  // argument are iterators for each list, as returned by the method
-  // `locateTripleInAllPermutations` above.
+  // Make the next call to `writeToDisk` write a checkpoint. This has to be
+  // called for all modifications that are not added to the log of updates.
+  void requireCheckpoint();
+
+  // Erase the `LocatedTriple` objects of the given `triple` (in SPO order) from
+  // each `LocatedTriplesPerBlock` list. The `handles` are the blocks in each
+  // list, as returned by the method `locateAndAddTriples` above.
   //
-  // NOTE: The iterators are invalid afterward. That is OK, as long as we also
-  // delete the respective entry in `triplesInserted_` or `triplesDeleted_`,
-  // which stores these iterators.
+  // NOTE: The respective entry in `triplesInserted_` or `triplesDeleted_`,
+  // which stores these handles, also has to be deleted.
   template <bool isInternal>
   void eraseTripleInAllPermutations(
-      typename TriplesToHandles<isInternal>::LocatedTripleHandles& handles);
+      const IdTriple<0>& triple,
+      const typename TriplesToHandles<isInternal>::LocatedTripleHandles&
+          handles);
 
   // The difference between two `LocatedTriplesState` snapshots, split into
   // inserted/deleted and internal/external triples.
@@ -425,6 +472,19 @@ class DeltaTriplesManager {
   // update the current snapshot.
   void clear();
 
+  // Merge the located triples of the blocks with the most located triples into
+  // these blocks (at most `maxNumBlocksPerPermutation` blocks for each
+  // permutation, see `LocatedTriplesPerBlock::computeCompactedBlocks`), s.t.
+  // scans no longer have to merge them. The merged blocks are computed on the
+  // current snapshot without holding the lock, so queries and updates are not
+  // blocked. Blocks that were modified in the meantime are discarded. This does
+  // not change the content of the index, so the index of the snapshot (which
+  // is used by the query cache) is not changed. Nothing is compacted if the
+  // compacted blocks already take up more than
+  // `delta-triples-compaction-max-memory`. Return statistics as JSON.
+  nlohmann::json compact(size_t maxNumBlocksPerPermutation,
+                         CancellationHandle cancellationHandle);
+
   // Return a shared pointer to a deep copy of the current version snapshot.
   // This can be safely used to execute a query without interfering with future
   // updates.
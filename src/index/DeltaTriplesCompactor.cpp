@@ -0,0 +1,72 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/DeltaTriplesCompactor.h"
+
+#include "global/RuntimeParameters.h"
+#include "index/DeltaTriples.h"
+#include "util/Log.h"
+
+// _____________________________________________________________________________
+DeltaTriplesCompactor::DeltaTriplesCompactor(
+    DeltaTriplesManager& deltaTriplesManager)
+    : deltaTriplesManager_{deltaTriplesManager},
+      thread_{[this]() { run(); }} {}
+
+// _____________________________________________________________________________
+DeltaTriplesCompactor::~DeltaTriplesCompactor() {
+  {
+    std::unique_lock lock{mutex_};
+    running_ = false;
+  }
+  cancellationHandle_->cancel(ad_utility::CancellationState::MANUAL);
+  conditionVariable_.notify_all();
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesCompactor::run() {
+  std::unique_lock lock{mutex_};
+  while (true) {
+    // The interval is read in each round, s.t. changes of the runtime
+    // parameter take effect without a restart.
+    std::chrono::milliseconds interval = getRuntimeParameter<
+        &RuntimeParameters::deltaTriplesCompactionInterval_>();
+    bool enabled = interval.count() > 0;
+    if (conditionVariable_.wait_for(
+            lock,
+            enabled ? interval
+                    : std::chrono::milliseconds{disabledCheckInterval_},
+            [this]() { return !running_; })) {
+      return;
+    }
+    if (!enabled) {
+      continue;
+    }
+    lock.unlock();
+    compactOnce();
+    lock.lock();
+  }
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesCompactor::compactOnce() {
+  try {
+    auto stats = deltaTriplesManager_.compact(
+        getRuntimeParameter<
+            &RuntimeParameters::deltaTriplesCompactionMaxBlocksPerRound_>(),
+        cancellationHandle_);
+    if (stats["blocksCompacted"].get<size_t>() > 0) {
+      AD_LOG_DEBUG << "Compaction of delta triples: " << stats.dump()
+                   << std::endl;
+    }
+  } catch (const ad_utility::CancellationException&) {
+    // This object is being destroyed.
+  } catch (const std::exception& e) {
+    // The compaction is only an optimization, so an error must not stop the
+    // server.
+    AD_LOG_ERROR << "Compaction of delta triples failed: " << e.what()
+                 << std::endl;
+  }
+}
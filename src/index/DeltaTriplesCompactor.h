@@ -0,0 +1,62 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_DELTATRIPLESCOMPACTOR_H
+#define QLEVER_SRC_INDEX_DELTATRIPLESCOMPACTOR_H
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+#include "util/CancellationHandle.h"
+#include "util/jthread.h"
+
+class DeltaTriplesManager;
+
+// Periodically merge the located triples of the blocks with the most located
+// triples into these blocks in a background thread (see
+// `DeltaTriplesManager::compact`). This keeps the cost of scans stable under
+// a continuous load of updates, which would otherwise have to merge more and
+// more located triples. The compaction is controlled by the runtime parameters
+// `delta-triples-compaction-interval` (disabled by default) and
+// `delta-triples-compaction-max-blocks-per-round`, which limit the amount of
+// work that competes with the queries, and by
+// `delta-triples-compaction-max-memory`, which limits the RAM used by the
+// compacted blocks.
+class DeltaTriplesCompactor {
+ private:
+  DeltaTriplesManager& deltaTriplesManager_;
+  // Used to stop an ongoing compaction when this object is destroyed.
+  ad_utility::SharedCancellationHandle cancellationHandle_ =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  std::mutex mutex_;
+  std::condition_variable conditionVariable_;
+  bool running_ = true;
+  ad_utility::JThread thread_;
+
+  // If the compaction is disabled, check this often whether it has been
+  // enabled in the meantime.
+  static constexpr std::chrono::seconds disabledCheckInterval_{1};
+
+ public:
+  // Start the background thread. The `deltaTriplesManager` must outlive this
+  // object.
+  explicit DeltaTriplesCompactor(DeltaTriplesManager& deltaTriplesManager);
+
+  // Stop the background thread (and cancel an ongoing compaction).
+  ~DeltaTriplesCompactor();
+
+  DeltaTriplesCompactor(const DeltaTriplesCompactor&) = delete;
+  DeltaTriplesCompactor& operator=(const DeltaTriplesCompactor&) = delete;
+
+ private:
+  // The loop of the background thread.
+  void run();
+
+  // Perform a single round of compaction and log the result.
+  void compactOnce();
+};
+
+#endif  // QLEVER_SRC_INDEX_DELTATRIPLESCOMPACTOR_H
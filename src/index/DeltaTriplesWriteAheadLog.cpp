@@ -0,0 +1,208 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/DeltaTriplesWriteAheadLog.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#include "util/File.h"
+#include "util/Log.h"
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializePair.h"
+#include "util/Serializer/SerializeString.h"
+#include "util/Serializer/SerializeVector.h"
+#include "util/Serializer/TripleSerializer.h"
+
+namespace {
+constexpr std::array magicBytes{'Q', 'L', 'E', 'V', 'E', 'R', '.',
+                                'U', 'P', 'D', 'L', 'O', 'G'};
+// The `formatVersion` has to be increased when the format is changed.
+constexpr uint16_t formatVersion = 1;
+constexpr size_t headerSize = magicBytes.size() + sizeof(formatVersion);
+// Each record starts with the size of the payload and its checksum.
+constexpr size_t recordHeaderSize = 2 * sizeof(uint64_t);
+
+// The local vocab entries of a record as pairs of the bits of the `Id` and
+// the string representation.
+using Words = std::vector<std::pair<Id::T, std::string>>;
+
+// Append the bytes of the `value` to the `buffer`.
+template <typename T>
+void appendBytes(std::vector<char>& buffer, const T& value) {
+  const auto* bytes = reinterpret_cast<const char*>(&value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+// Read a value of type `T` from the `bytes` at the given `offset`.
+template <typename T>
+T readBytes(const std::vector<char>& bytes, size_t offset) {
+  T value;
+  std::memcpy(&value, bytes.data() + offset, sizeof(T));
+  return value;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+DeltaTriplesWriteAheadLog::DeltaTriplesWriteAheadLog(std::string filename)
+    : filename_{std::move(filename)} {
+  std::error_code errorCode;
+  auto size = std::filesystem::file_size(filename_, errorCode);
+  sizeOnDisk_ = errorCode ? 0 : size;
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::addRecord(bool insertOrDelete,
+                                          const Triples& triples) {
+  Words newWords;
+  std::vector<Id> ids;
+  ids.reserve(triples.size() * Triples::value_type::NumCols);
+  for (const auto& triple : triples) {
+    for (Id id : triple.ids()) {
+      if (id.getDatatype() == Datatype::LocalVocabIndex &&
+          loggedLocalVocabEntries_.insert(id.getLocalVocabIndex()).second) {
+        pendingLocalVocabEntries_.push_back(id.getLocalVocabIndex());
+        newWords.emplace_back(
+            id.getBits(), id.getLocalVocabIndex()->toStringRepresentation());
+      }
+      ids.push_back(id);
+    }
+  }
+  ad_utility::serialization::ByteBufferWriteSerializer serializer;
+  serializer << insertOrDelete;
+  serializer << newWords;
+  serializer << ids;
+  const auto& payload = serializer.data();
+  appendBytes(pendingRecords_, uint64_t{payload.size()});
+  appendBytes(pendingRecords_, checksum(payload));
+  pendingRecords_.insert(pendingRecords_.end(), payload.begin(),
+                         payload.end());
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::commit() {
+  if (pendingRecords_.empty()) {
+    return;
+  }
+  std::vector<char> bytes;
+  if (sizeOnDisk_ == 0) {
+    appendBytes(bytes, magicBytes);
+    appendBytes(bytes, formatVersion);
+  }
+  bytes.insert(bytes.end(), pendingRecords_.begin(), pendingRecords_.end());
+  ad_utility::File file{filename_, "a"};
+  auto numBytesWritten = file.write(bytes.data(), bytes.size());
+  AD_CORRECTNESS_CHECK(numBytesWritten == bytes.size());
+  file.close();
+  sizeOnDisk_ += bytes.size();
+  pendingRecords_.clear();
+  pendingLocalVocabEntries_.clear();
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::discardPendingRecords() {
+  pendingRecords_.clear();
+  // The entries of the discarded records have to be written again by the next
+  // record that uses them.
+  for (auto entry : pendingLocalVocabEntries_) {
+    loggedLocalVocabEntries_.erase(entry);
+  }
+  pendingLocalVocabEntries_.clear();
+}
+
+// _____________________________________________________________________________
+void DeltaTriplesWriteAheadLog::truncate() {
+  pendingRecords_.clear();
+  pendingLocalVocabEntries_.clear();
+  loggedLocalVocabEntries_.clear();
+  std::filesystem::remove(filename_);
+  sizeOnDisk_ = 0;
+}
+
+// _____________________________________________________________________________
+std::vector<DeltaTriplesWriteAheadLog::Record>
+DeltaTriplesWriteAheadLog::readRecords(const std::string& filename,
+                                       const LocalVocabContext& context,
+                                       LocalVocab& localVocab) {
+  std::vector<Record> records;
+  std::ifstream stream{filename, std::ios::binary};
+  if (!stream) {
+    return records;
+  }
+  std::vector<char> bytes{std::istreambuf_iterator<char>{stream},
+                          std::istreambuf_iterator<char>{}};
+  if (bytes.empty()) {
+    return records;
+  }
+  using MagicBytes = std::decay_t<decltype(magicBytes)>;
+  AD_CORRECTNESS_CHECK(
+      bytes.size() >= headerSize &&
+          readBytes<MagicBytes>(bytes, 0) == magicBytes &&
+          readBytes<uint16_t>(bytes, magicBytes.size()) == formatVersion,
+      "The log of persisted updates '", filename,
+      "' has an unknown format. Please contact the developers of QLever");
+
+  // The mapping from the `Id`s of the local vocab entries in the file to the
+  // `Id`s of the entries in the `localVocab`.
+  absl::flat_hash_map<Id::T, Id> mapping;
+  size_t offset = headerSize;
+  while (offset < bytes.size()) {
+    bool isValid = bytes.size() - offset >= recordHeaderSize;
+    uint64_t payloadSize = 0;
+    if (isValid) {
+      payloadSize = readBytes<uint64_t>(bytes, offset);
+      isValid = bytes.size() - offset - recordHeaderSize >= payloadSize;
+    }
+    ql::span<const char> payload;
+    if (isValid) {
+      payload =
+          ql::span{bytes}.subspan(offset + recordHeaderSize, payloadSize);
+      isValid = readBytes<uint64_t>(bytes, offset + sizeof(uint64_t)) ==
+                checksum(payload);
+    }
+    if (!isValid) {
+      AD_LOG_WARN << "The log of persisted updates '" << filename
+                  << "' ends with an incomplete or corrupt record, which is "
+                     "ignored. Number of valid records: "
+                  << records.size() << std::endl;
+      break;
+    }
+    ad_utility::serialization::ByteBufferReadSerializer serializer{
+        std::vector<char>(payload.begin(), payload.end())};
+    auto insertOrDelete = ad_utility::detail::readValue<bool>(serializer);
+    for (auto& [bits, word] :
+         ad_utility::detail::readValue<Words>(serializer)) {
+      auto index = localVocab.getIndexAndAddIfNotContained(
+          LocalVocabEntry::fromStringRepresentation(std::move(word), context));
+      mapping[bits] = Id::makeFromLocalVocabIndex(index);
+    }
+    auto ids = ad_utility::detail::deserializeIds(serializer, mapping);
+    constexpr size_t numCols = Triples::value_type::NumCols;
+    AD_CORRECTNESS_CHECK(ids.size() % numCols == 0);
+    Triples triples;
+    triples.reserve(ids.size() / numCols);
+    for (size_t i = 0; i < ids.size(); i += numCols) {
+      triples.emplace_back(
+          std::array{ids[i], ids[i + 1], ids[i + 2], ids[i + 3]});
+    }
+    records.push_back({insertOrDelete, std::move(triples)});
+    offset += recordHeaderSize + payloadSize;
+  }
+  return records;
+}
+
+// _____________________________________________________________________________
+uint64_t DeltaTriplesWriteAheadLog::checksum(ql::span<const char> bytes) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (char byte : bytes) {
+    hash ^= static_cast<uint8_t>(byte);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
@@ -0,0 +1,93 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
+#define QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
+
+#include <string>
+#include <vector>
+
+#include "global/IdTriple.h"
+#include "index/LocalVocab.h"
+#include "util/HashSet.h"
+
+// An append-only log of the batches of triples that were inserted into or
+// deleted from the `DeltaTriples` since the last checkpoint (the complete
+// delta triples, written by `DeltaTriples::writeToDisk`). Appending a batch to
+// the log is much cheaper than writing all the delta triples after each
+// update. When the server is restarted, the batches are replayed on top of the
+// checkpoint.
+//
+// The file consists of a header, followed by the records. Each record
+// consists of the size of its payload, a checksum of the payload, and the
+// payload itself, which contains
+// - whether the triples were inserted or deleted,
+// - the string representations of the local vocab entries that are used by
+//   the triples and that were not contained in any of the previous records,
+// - the `Id`s of the triples.
+//
+// A record that is incomplete or has a wrong checksum (e.g. because the server
+// crashed while the record was written) ends the log.
+class DeltaTriplesWriteAheadLog {
+ public:
+  using Triples = std::vector<IdTriple<0>>;
+
+  // A batch of triples that were inserted or deleted.
+  struct Record {
+    bool insertOrDelete_;
+    Triples triples_;
+  };
+
+ private:
+  std::string filename_;
+  // The records that were added since the last call to `commit`, in the format
+  // in which they are written to the file.
+  std::vector<char> pendingRecords_;
+  // The local vocab entries that are contained in one of the records since the
+  // last call to `truncate` (including the pending ones), and the ones that
+  // were added by the pending records.
+  ad_utility::HashSet<LocalVocabIndex> loggedLocalVocabEntries_;
+  std::vector<LocalVocabIndex> pendingLocalVocabEntries_;
+  // The size of the file in bytes (0 if it doesn't exist).
+  size_t sizeOnDisk_ = 0;
+
+ public:
+  explicit DeltaTriplesWriteAheadLog(std::string filename);
+
+  // Add a record for the `triples` that will be written to the file with the
+  // next call to `commit`. All the local vocab entries of the `triples` must
+  // stay valid until `truncate` is called.
+  void addRecord(bool insertOrDelete, const Triples& triples);
+
+  // Append all the records that were added since the last call to `commit` to
+  // the file using a single write.
+  void commit();
+
+  // Discard the records that were added since the last call to `commit`.
+  void discardPendingRecords();
+
+  // Remove all the records from the file and discard the pending records. This
+  // has to be called after a checkpoint was written.
+  void truncate();
+
+  // The size of the file in bytes after the next call to `commit`.
+  size_t sizeAfterCommit() const {
+    return sizeOnDisk_ + pendingRecords_.size();
+  }
+
+  const std::string& filename() const { return filename_; }
+
+  // Read all the valid records from the file with the given `filename`. The
+  // local vocab entries of the triples are added to the `localVocab`. If the
+  // file doesn't exist, no records are returned.
+  static std::vector<Record> readRecords(const std::string& filename,
+                                         const LocalVocabContext& context,
+                                         LocalVocab& localVocab);
+
+  // The (stable) checksum of the given `bytes` (64-bit FNV-1a).
+  static uint64_t checksum(ql::span<const char> bytes);
+};
+
+#endif  // QLEVER_SRC_INDEX_DELTATRIPLESWRITEAHEADLOG_H
@@ -11,6 +11,7 @@
 #include "backports/algorithm.h"
 #include "backports/three_way_comparison.h"
 #include "global/Id.h"
+#include "rdfTypes/InlineLiteral.h"
 #include "util/BitUtils.h"
 #include "util/CtreHelpers.h"
 #include "util/Log.h"
@@ -55,6 +56,11 @@ constexpr ctll::fixed_string digitsCaptureGroup = "digits";
 // if 4 times the number of digits is larger than `NumBitsTotal - NumBitsTags`,
 // the IRI will not be encoded (but stored as a regular IRI). See the bottom of
 // the file for the default values of `NumBitsTotal` and `NumBitsTags`.
+//
+// Additionally, if `encodeShortLiterals_` is set, plain literals with at most
+// `InlineLiteral::maxSize` bytes are encoded as `Id`s with datatype
+// `InlineLiteral` (see `InlineLiteral.h` for the encoding). This lives here,
+// because all the places that encode IRIs have to encode these literals too.
 struct NoHardcodedPrefixes {
   // The fixed prefixes have to be wrapped into a struct because
   // `std::array<std::string_view>` cannot be passed as a template parameter
@@ -84,6 +90,9 @@ class EncodedIriManagerImpl {
 
   static constexpr auto maxNumPrefixes_ = 1ULL << NumBitsTags;
 
+  // If true, short plain literals are encoded (see above).
+  bool encodeShortLiterals_ = false;
+
   // By default, `prefixes_` is empty, so no IRI will be encoded.
   // NOTE: When loading an existing index, in particular one from an older
   // QLever version with different hardcoded prefixes, it is crucial to use the
@@ -93,13 +102,16 @@ class EncodedIriManagerImpl {
 
   // Construct from the list of prefixes. The prefixes have to be specified
   // without any brackets, so e.g. "http://example.org/" if IRIs of the form
-  // `<http://example.org/1234>` should be encoded.
+  // `<http://example.org/1234>` should be encoded. If `encodeShortLiterals` is
+  // true, short plain literals are also encoded (see above).
   // NOTE: When loading an existing index, in particular one from an older
   // QLever version with different hardcoded prefixes, it is crucial to use the
   // deserialization from JSON to initialize the EncodedIriManager. See the
   // note in `from_json`.
   explicit EncodedIriManagerImpl(
-      std::vector<std::string> prefixesWithoutAngleBrackets) {
+      std::vector<std::string> prefixesWithoutAngleBrackets,
+      bool encodeShortLiterals = false)
+      : encodeShortLiterals_{encodeShortLiterals} {
     // Add hardcoded prefixes.
     for (const auto& prefix : HardcodedPrefixes) {
       // Adding a hardcoded prefix a second time in the constructor is an error.
@@ -159,7 +171,13 @@ class EncodedIriManagerImpl {
   // 2. The string does not start with any of the `prefixes_`
   // 3. After the matching prefix, there are characters other than `[0-9]`
   // 4. There are more digits than fit into `NumBitsEncoding` (4 bits / digit)
+  //
+  // If the string is a literal, it is encoded iff `encodeShortLiterals_` is
+  // set and the literal can be stored as an `InlineLiteral`.
   std::optional<Id> encode(std::string_view repr) const {
+    if (ql::starts_with(repr, '"')) {
+      return encodeLiteral(repr);
+    }
     // Find the matching prefix.
     auto it = ql::ranges::find_if(prefixes_, [&repr](std::string_view prefix) {
       return ql::starts_with(repr, prefix);
@@ -190,6 +208,22 @@ class EncodedIriManagerImpl {
                                          encodeDecimalToNBit(numString));
   }
 
+  // Return true iff short plain literals are encoded (see above).
+  bool encodesShortLiterals() const { return encodeShortLiterals_; }
+
+  // The part of `encode` for literals (in their string representation with
+  // quotes).
+  std::optional<Id> encodeLiteral(std::string_view repr) const {
+    if (!encodeShortLiterals_) {
+      return std::nullopt;
+    }
+    auto literal = InlineLiteral::fromStringRepresentation(repr);
+    if (!literal.has_value()) {
+      return std::nullopt;
+    }
+    return Id::makeFromInlineLiteral(literal.value());
+  }
+
   // combine the integer representation of the prefix and of the payload into a
   // single `Id` with datatype `EncodedValue`.
   static Id makeIdFromPrefixIdxAndPayload(uint64_t prefixIdx,
@@ -259,9 +293,11 @@ class EncodedIriManagerImpl {
   // Conversion to and from JSON.
   static constexpr const char* jsonKey_ =
       "prefixes-with-leading-angle-brackets";
+  static constexpr const char* jsonKeyShortLiterals_ = "encode-short-literals";
   friend void to_json(nlohmann::json& j,
                       const EncodedIriManagerImpl& encodedIriManager) {
     j[jsonKey_] = encodedIriManager.prefixes_;
+    j[jsonKeyShortLiterals_] = encodedIriManager.encodeShortLiterals_;
   }
   friend void from_json(const nlohmann::json& j,
                         EncodedIriManagerImpl& encodedIriManager) {
@@ -276,16 +312,23 @@ class EncodedIriManagerImpl {
     // prefixes.
     encodedIriManager.prefixes_ =
         static_cast<std::vector<std::string>>(j[jsonKey_]);
+    // Indices that were built before short literals could be encoded don't
+    // have this key, and their short literals are stored in the vocabulary.
+    encodedIriManager.encodeShortLiterals_ =
+        j.contains(jsonKeyShortLiterals_) &&
+        static_cast<bool>(j[jsonKeyShortLiterals_]);
   }
 
   // Hash support for use in `TestIndexConfig`.
   template <typename H>
   friend H AbslHashValue(H h, const EncodedIriManagerImpl& manager) {
-    return H::combine(std::move(h), manager.prefixes_);
+    return H::combine(std::move(h), manager.prefixes_,
+                      manager.encodeShortLiterals_);
   }
 
   // Equality operator for use in `TestIndexConfig`.
-  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(EncodedIriManagerImpl, prefixes_)
+  QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(EncodedIriManagerImpl, prefixes_,
+                                              encodeShortLiterals_)
 
   // Encode the `numberStr` (which may only consist of digits) into a 64-bit
   // number.
@@ -88,6 +88,7 @@ std::optional<Literal> idToLiteral(const IndexImpl& index, Id id,
                                 onlyReturnLiteralsWithXsdString);
     case VocabIndex:
     case LocalVocabIndex:
+    case InlineLiteral:
       return handleIriOrLiteral(
           getLiteralOrIriFromVocabIndex(index, id, localVocab),
           onlyReturnLiteralsWithXsdString);
@@ -155,6 +156,7 @@ std::optional<LiteralOrIri> idToLiteralOrIri(const IndexImpl& index, Id id,
     case VocabIndex:
     case LocalVocabIndex:
     case EncodedVal:
+    case InlineLiteral:
       return ql::exportIds::getLiteralOrIriFromVocabIndex(index, id,
                                                           localVocab);
     case TextRecordIndex:
@@ -201,6 +203,10 @@ LiteralOrIri getLiteralOrIriFromVocabIndex(const IndexImpl& index, Id id,
     }
     case Datatype::EncodedVal:
       return encodedIdToLiteralOrIri(id, index);
+    case Datatype::InlineLiteral:
+      // No vocabulary lookup is needed, the literal is stored in the `id`.
+      return LiteralOrIri::fromStringRepresentation(
+          id.getInlineLiteral().toStringRepresentation());
     default:
       AD_FAIL();
   }
@@ -93,9 +93,9 @@ std::string replaceAnglesByQuotes(std::string iriString);
 std::optional<std::string> blankNodeIriToString(const Iri& iri);
 
 // Acts as a helper to retrieve a LiteralOrIri object from an Id, where the Id
-// is of type `VocabIndex`, `LocalVocabIndex`, or `EncodedVal`. This function
-// should only be called with suitable `Datatype` Ids, otherwise `AD_FAIL()` is
-// called.
+// is of type `VocabIndex`, `LocalVocabIndex`, `EncodedVal`, or `InlineLiteral`.
+// This function should only be called with suitable `Datatype` Ids, otherwise
+// `AD_FAIL()` is called.
 LiteralOrIri getLiteralOrIriFromVocabIndex(const IndexImpl& index, Id id,
                                            const LocalVocab& localVocab);
 
@@ -108,6 +108,32 @@ idToStringAndTypeForEncodedValue(Id id);
 // IRI via the `EncodedIriManager` in the index.
 LiteralOrIri encodedIdToLiteralOrIri(Id id, const IndexImpl& index);
 
+// Helper for `idToStringAndType` and `idsToStringAndType`: Convert a `word`
+// from the vocabulary or the local vocabulary to the result format of these
+// functions (see there for details).
+template <bool removeQuotesAndAngleBrackets, bool returnOnlyLiterals,
+          typename EscapeFunction>
+std::optional<std::pair<std::string, const char*>> literalOrIriToStringAndType(
+    const LiteralOrIri& word, EscapeFunction& escapeFunction) {
+  if constexpr (returnOnlyLiterals) {
+    if (!word.isLiteral()) {
+      return std::nullopt;
+    }
+  }
+  if (word.isIri()) {
+    if (auto blankNodeString = blankNodeIriToString(word.getIri())) {
+      return std::pair{std::move(blankNodeString.value()), nullptr};
+    }
+  }
+  if constexpr (removeQuotesAndAngleBrackets) {
+    // TODO<joka921> Can we get rid of the string copying here?
+    return std::pair{
+        escapeFunction(std::string{asStringViewUnsafe(word.getContent())}),
+        nullptr};
+  }
+  return std::pair{escapeFunction(word.toStringRepresentation()), nullptr};
+}
+
 // Convert the `id` to a human-readable string. The `index` is used to resolve
 // `Id`s with datatype `VocabIndex` or `TextRecordIndex`. The `localVocab` is
 // used to resolve `Id`s with datatype `LocalVocabIndex`. The `escapeFunction`
@@ -129,30 +155,16 @@ std::optional<std::pair<std::string, const char*>> idToStringAndType(
   using enum Datatype;
   auto datatype = id.getDatatype();
   if constexpr (returnOnlyLiterals) {
-    if (!(datatype == VocabIndex || datatype == LocalVocabIndex)) {
+    if (!(datatype == VocabIndex || datatype == LocalVocabIndex ||
+          datatype == InlineLiteral)) {
       return std::nullopt;
     }
   }
 
-  auto handleIriOrLiteral = [&escapeFunction](const LiteralOrIri& word)
-      -> std::optional<std::pair<std::string, const char*>> {
-    if constexpr (returnOnlyLiterals) {
-      if (!word.isLiteral()) {
-        return std::nullopt;
-      }
-    }
-    if (word.isIri()) {
-      if (auto blankNodeString = blankNodeIriToString(word.getIri())) {
-        return std::pair{std::move(blankNodeString.value()), nullptr};
-      }
-    }
-    if constexpr (removeQuotesAndAngleBrackets) {
-      // TODO<joka921> Can we get rid of the string copying here?
-      return std::pair{
-          escapeFunction(std::string{asStringViewUnsafe(word.getContent())}),
-          nullptr};
-    }
-    return std::pair{escapeFunction(word.toStringRepresentation()), nullptr};
+  auto handleIriOrLiteral = [&escapeFunction](const LiteralOrIri& word) {
+    return literalOrIriToStringAndType<removeQuotesAndAngleBrackets,
+                                       returnOnlyLiterals>(word,
+                                                           escapeFunction);
   };
 
   switch (id.getDatatype()) {
@@ -162,6 +174,7 @@ std::optional<std::pair<std::string, const char*>> idToStringAndType(
     }
     case VocabIndex:
     case LocalVocabIndex:
+    case InlineLiteral:
       return handleIriOrLiteral(
           getLiteralOrIriFromVocabIndex(index.getImpl(), id, localVocab));
     case EncodedVal:
@@ -175,14 +188,11 @@ std::optional<std::pair<std::string, const char*>> idToStringAndType(
   }
 }
 
-// Batch variant of idToStringAndType.
-// Precondition: `ids` is sorted by `ValueId` (as `ConstructBatchEvaluator`
-// does before calling vocabulary lookups). Under this precondition, all
-// `VocabIndex` IDs form a single contiguous block that is already sorted by
-// vocabulary position, so they can be resolved last and in sequential order
-// for I/O-local access to the on-disk vocabulary. All other IDs are resolved
-// immediately since their values are either encoded in the id bits or stored
-// in the in-memory `LocalVocab`.
+// Batch variant of `idToStringAndType`. The strings of all the `VocabIndex`
+// IDs are obtained from the vocabulary with a single call to `lookupBatch`,
+// which deduplicates and sorts them and reads neighboring words from disk at
+// once. All other IDs are resolved immediately since their values are either
+// encoded in the id bits or stored in the in-memory `LocalVocab`.
 template <bool removeQuotesAndAngleBrackets = false,
           bool returnOnlyLiterals = false,
           typename EscapeFunction = ql::identity>
@@ -193,31 +203,27 @@ idsToStringAndType(const Index& index, ql::span<const Id> ids,
   std::vector<std::optional<std::pair<std::string, const char*>>> results(
       ids.size());
 
-  // `ids` is sorted by `ValueId`. Because the datatype tag occupies the 4 most
-  // significant bits of a `ValueId`, all `VocabIndex` IDs form a single
-  // contiguous block and are already sorted by vocabulary position within that
-  // block. We resolve all other datatypes immediately (in-memory lookups) and
-  // record where the `VocabIndex` block begins.
-  size_t vocabBegin = ids.size();
+  std::vector<::VocabIndex> vocabIndices;
+  std::vector<size_t> positionsOfVocabIndices;
   for (size_t i = 0; i < ids.size(); ++i) {
-    if (ids[i].getDatatype() != Datatype::VocabIndex) {
+    if (ids[i].getDatatype() == Datatype::VocabIndex) {
+      vocabIndices.push_back(ids[i].getVocabIndex());
+      positionsOfVocabIndices.push_back(i);
+    } else {
       results[i] =
           idToStringAndType<removeQuotesAndAngleBrackets, returnOnlyLiterals>(
               index, ids[i], localVocab, escapeFunction);
-    } else if (vocabBegin == ids.size()) {
-      vocabBegin = i;
     }
   }
 
-  // Resolve the contiguous `VocabIndex` block in sorted (vocabulary-position)
-  // order, giving sequential I/O access to the on-disk vocabulary file.
-  for (size_t i = vocabBegin;
-       i < ids.size() && ids[i].getDatatype() == Datatype::VocabIndex; ++i) {
-    results[i] =
-        idToStringAndType<removeQuotesAndAngleBrackets, returnOnlyLiterals>(
-            index, ids[i], localVocab, escapeFunction);
+  auto words = index.getVocab().lookupBatch(vocabIndices);
+  for (size_t i = 0; i < words.size(); ++i) {
+    results[positionsOfVocabIndices[i]] =
+        literalOrIriToStringAndType<removeQuotesAndAngleBrackets,
+                                    returnOnlyLiterals>(
+            LiteralOrIri::fromStringRepresentation(std::move(words[i])),
+            escapeFunction);
   }
-
   return results;
 }
 
@@ -147,6 +147,11 @@ bool& Index::loadAllPermutations() { return pimpl_->loadAllPermutations(); }
 // ____________________________________________________________________________
 bool& Index::addHasWordTriples() { return pimpl_->addHasWordTriples(); }
 
+// ____________________________________________________________________________
+bool& Index::buildMembershipFilters() {
+  return pimpl_->buildMembershipFilters();
+}
+
 // ____________________________________________________________________________
 bool& Index::doNotLoadPermutations() { return pimpl_->doNotLoadPermutations(); }
 
@@ -191,6 +191,8 @@ class Index {
 
   bool& addHasWordTriples();
 
+  bool& buildMembershipFilters();
+
   bool& doNotLoadPermutations();
 
   void setKeepTempFiles(bool keepTempFiles);
@@ -19,6 +19,7 @@
 #include "global/RuntimeParameters.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "libqlever/Qlever.h"
+#include "parser/ParallelDecompressingBuffer.h"
 #include "util/ProgramOptionsHelpers.h"
 #include "util/ReadableNumberFacet.h"
 #include "util/json.h"
@@ -75,7 +76,10 @@ qlever::Filetype getFiletype(std::optional<std::string_view> filetype,
     }
   }
 
-  auto posOfDot = filename.rfind('.');
+  // For compressed files (e.g. `data.ttl.gz`), the format is deduced from
+  // the extension before the one of the compression format.
+  auto filenameWithoutCompression = stripCompressionExtension(filename);
+  auto posOfDot = filenameWithoutCompression.rfind('.');
   auto throwNotDeducable = [&filename]() {
     throw std::runtime_error{absl::StrCat(
         "Could not deduce the file format from the filename \"", filename,
@@ -85,7 +89,7 @@ qlever::Filetype getFiletype(std::optional<std::string_view> filetype,
   if (posOfDot == std::string::npos) {
     throwNotDeducable();
   }
-  auto deducedType = impl(filename.substr(posOfDot + 1));
+  auto deducedType = impl(filenameWithoutCompression.substr(posOfDot + 1));
   if (deducedType.has_value()) {
     return deducedType.value();
   } else {
@@ -204,7 +208,9 @@ int main(int argc, char** argv) {
       "The basename of the output files (required).");
   add("kg-input-file,f", po::value(&inputFile),
       "The file with the knowledge graph data to be parsed from. If omitted, "
-      "will read from stdin.");
+      "will read from stdin. Files that are compressed with gzip, bzip2, or "
+      "zstd are decompressed automatically (in parallel if the file consists "
+      "of independently compressed units).");
   add("file-format,F", po::value(&filetype),
       "The format of the input file with the knowledge graph data. Must be one "
       "of [nt|ttl|nq]. Can be specified once (then all files use that format), "
@@ -277,6 +283,18 @@ int main(int argc, char** argv) {
       "in the ID. NOTE: When using ORDER BY, the order among encoded IRIs and "
       "among non-encoded IRIs is correct, but the order between encoded "
       "and non-encoded IRIs is not");
+  add("encode-short-literals", po::bool_switch(&config.encodeShortLiterals_),
+      "Plain literals (without datatype or language tag) with at most 7 "
+      "bytes do not require a vocabulary entry, but are directly encoded in "
+      "the ID. NOTE: When using ORDER BY, the order among encoded literals "
+      "and among non-encoded literals is correct, but the order between "
+      "encoded and non-encoded literals is not");
+
+  add("membership-filters", po::bool_switch(&config.buildMembershipFilters_),
+      "Build a membership filter for the triples of each block of each "
+      "permutation. This makes the lookup of triples without variables (e.g. "
+      "in `ASK` or `EXISTS`) cheaper, at the cost of about 10 bits per triple "
+      "and permutation.");
 
   // Options for the index building process.
   add("stxxl-memory,m", po::value(&config.memoryLimit_),
@@ -287,6 +305,10 @@ int main(int argc, char** argv) {
       "large enough to hold a single input triple. Default: 10 MB.");
   add("keep-temporary-files,k", po::bool_switch(&config.keepTemporaryFiles_),
       "Do not delete temporary files from index creation for debugging.");
+  add("merge-into-index", po::value(&config.mergeIntoIndex_),
+      "The basename of an existing index. If specified, the triples from the "
+      "input files are merged into a copy of this index, which is written to "
+      "`index-basename`. The existing index is not modified.");
   add("materialized-views", po::value(&materializedViewsJson),
       "create materialized views after index building. Takes a JSON object "
       "mapping view names to SELECT queries for writing the view, for example: "
@@ -9,9 +9,11 @@
 
 #include <atomic>
 #include <cstdio>
+#include <filesystem>
 #include <future>
 #include <numeric>
 #include <optional>
+#include <thread>
 #include <utility>
 
 #include "CompilationInfo.h"
@@ -856,7 +858,7 @@ CompressedRelationWriter::WriterAndCallback IndexImpl::getWriterAndCallback(
 
   auto writer = std::make_unique<CompressedRelationWriter>(
       numColumns, ad_utility::File(fileName, "w"),
-      blocksizePermutationPerColumn_);
+      blocksizePermutationPerColumn_, true);
 
   auto callback =
       liftCallback([&metaData](const auto& md) { metaData.add(md); });
@@ -944,6 +946,22 @@ void IndexImpl::writeMetaData(IndexMetaDataMmapDispatcher::WriteType& metaData,
   metaData.setName(getKbName());
   ad_utility::File f(filename, "r+");
   metaData.appendToFile(&f);
+  f.close();
+  auto filtersFilename = absl::StrCat(filename, MEMBERSHIP_FILTERS_SUFFIX);
+  if (!buildMembershipFilters_) {
+    // Don't leave the filters of a previous build of the permutation behind.
+    std::filesystem::remove(filtersFilename);
+    return;
+  }
+  AD_LOG_INFO << "Building membership filters for the blocks of " << filename
+              << " ..." << std::endl;
+  CompressedRelationReader reader{ad_utility::makeUnlimitedAllocator<Id>(),
+                                  ad_utility::File{filename, "r"}};
+  auto filters = reader.computeMembershipFilters(
+      metaData.blockData(),
+      std::max(1U, std::thread::hardware_concurrency()),
+      std::make_shared<ad_utility::SharedCancellationHandle::element_type>());
+  writePerBlockDataToFile(filtersFilename, metaData.blockData(), filters);
 }
 
 // _____________________________________________________________________________
@@ -1160,6 +1178,9 @@ bool& IndexImpl::loadAllPermutations() { return loadAllPermutations_; }
 // _____________________________________________________________________________
 bool& IndexImpl::addHasWordTriples() { return addHasWordTriples_; }
 
+// _____________________________________________________________________________
+bool& IndexImpl::buildMembershipFilters() { return buildMembershipFilters_; }
+
 // _____________________________________________________________________________
 bool& IndexImpl::doNotLoadPermutations() { return doNotLoadPermutations_; }
 
@@ -1914,9 +1935,10 @@ ad_utility::BlankNodeManager* IndexImpl::getBlankNodeManager() const {
 
 // _____________________________________________________________________________
 void IndexImpl::setPrefixesForEncodedValues(
-    std::vector<std::string> prefixesWithoutAngleBrackets) {
-  encodedIriManager_ =
-      EncodedIriManager{std::move(prefixesWithoutAngleBrackets)};
+    std::vector<std::string> prefixesWithoutAngleBrackets,
+    bool encodeShortLiterals) {
+  encodedIriManager_ = EncodedIriManager{
+      std::move(prefixesWithoutAngleBrackets), encodeShortLiterals};
 }
 // _____________________________________________________________________________
 void IndexImpl::writePatternsToFile() const {
@@ -140,6 +140,9 @@ class IndexImpl {
   // If true, add `ql:has-word` triples for each word in each literal.
   bool addHasWordTriples_ = false;
 
+  // If true, build the `BlockMembershipFilters` for all permutations.
+  bool buildMembershipFilters_ = false;
+
   size_t parserBatchSize_ = PARSER_BATCH_SIZE;
   size_t numTriplesPerBatch_ = NUM_TRIPLES_PER_PARTIAL_VOCAB;
 
@@ -273,9 +276,11 @@ class IndexImpl {
   const auto& encodedIriManager() const { return encodedIriManager_; }
 
   // Set the prefixes of the IRIs that will be encoded directly into
-  // the `Id`; see `EncodedIriManager` for details.
+  // the `Id`, and whether short literals are encoded directly into the `Id`;
+  // see `EncodedIriManager` for details.
   void setPrefixesForEncodedValues(
-      std::vector<std::string> prefixesWithoutAngleBrackets);
+      std::vector<std::string> prefixesWithoutAngleBrackets,
+      bool encodeShortLiterals = false);
 
   // Set the vocabulary type; see `ad_utility::VocabularyType` for details.
   void setVocabularyTypeForIndexBuilding(ad_utility::VocabularyType type) {
@@ -438,6 +443,9 @@ class IndexImpl {
 
   bool& addHasWordTriples();
 
+  bool& buildMembershipFilters();
+  bool buildMembershipFilters() const { return buildMembershipFilters_; }
+
   bool& doNotLoadPermutations();
 
   void setKeepTempFiles(bool keepTempFiles);
@@ -602,7 +610,10 @@ class IndexImpl {
   // the SPO permutation is also needed for patterns (see usage in
   // IndexImpl::createFromFile function)
 
-  // Write `metaData` to the provided file.
+  // Write `metaData` to the provided file. If `buildMembershipFilters_` is
+  // set, also build the `BlockMembershipFilters` for the blocks of the
+  // permutation in this file and write them to a separate file (together with
+  // the fingerprint of the blocks), otherwise remove that file if it exists.
   void writeMetaData(IndexMetaDataMmapDispatcher::WriteType& metaData,
                      const std::string& filename) const;
 
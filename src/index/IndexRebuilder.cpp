@@ -10,6 +10,8 @@
 #ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
 #include "index/IndexRebuilder.h"
 
+#include <absl/strings/str_cat.h>
+
 #include <array>
 #include <boost/asio/awaitable.hpp>
 #include <boost/asio/co_spawn.hpp>
@@ -19,6 +21,9 @@
 #include <boost/asio/use_awaitable.hpp>
 #include <cstdint>
 #include <fstream>
+#include <iterator>
+#include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -26,12 +31,17 @@
 
 #include "backports/algorithm.h"
 #include "engine/idTable/IdTable.h"
+#include "global/Constants.h"
 #include "global/Id.h"
 #include "index/IndexImpl.h"
 #include "index/IndexRebuilderImpl.h"
 #include "index/LocalVocabEntry.h"
 #include "index/Permutation.h"
+#include "parser/NormalizedString.h"
+#include "parser/RdfParser.h"
+#include "util/AllocatorWithLimit.h"
 #include "util/CancellationHandle.h"
+#include "util/Conversions.h"
 #include "util/Exception.h"
 #include "util/ExceptionHandling.h"
 #include "util/HashMap.h"
@@ -115,8 +125,28 @@ std::tuple<InsertionPositions, LocalVocabMapping> materializeLocalVocab(
     return std::tie(info.insertionPosition_, info.originalId_);
   });
 
+  // The same word may be contained in more than one local vocab (e.g. in the
+  // local vocab of the updates and in the new words of `mergeFilesIntoIndex`).
+  // Such words are adjacent after sorting, they are written only once and all
+  // their original `Id`s are mapped to the same new `Id`.
+  std::vector<std::pair<Id, Id>> duplicates;
+  auto newEnd = std::unique(
+      insertInfo.begin(), insertInfo.end(),
+      [&duplicates](const InsertionInfo& a, const InsertionInfo& b) {
+        if (a.insertionPosition_ != b.insertionPosition_ ||
+            a.word_ != b.word_) {
+          return false;
+        }
+        duplicates.emplace_back(b.originalId_, a.originalId_);
+        return true;
+      });
+  insertInfo.erase(newEnd, insertInfo.end());
   LocalVocabMapping localVocabMapping =
       mergeVocabs(newIndexName + VOCAB_SUFFIX, vocab, insertInfo);
+  for (const auto& [duplicate, original] : duplicates) {
+    Id newId = localVocabMapping.at(original.getBits());
+    localVocabMapping.emplace(duplicate.getBits(), newId);
+  }
   auto denseInfo = insertInfo |
                    ql::views::transform(&InsertionInfo::insertionPosition_) |
                    ::ranges::to<std::vector>;
@@ -181,6 +211,36 @@ Id remapBlankNodeId(Id original, const BlankNodeBlocks& blankNodeBlocks,
   return value.value();
 }
 
+namespace {
+// Return a lambda that remaps a single `Id` of the old index (in place) to the
+// corresponding `Id` of the new index. If the same `Id` is remapped several
+// times in a row, the mapping is only computed once.
+auto makeIdRemapper(const LocalVocabMapping& localVocabMapping,
+                    const InsertionPositions& insertionPositions,
+                    const BlankNodeBlocks& blankNodeBlocks,
+                    uint64_t minBlankNodeIndex) {
+  return [&insertionPositions, &localVocabMapping, &blankNodeBlocks,
+          minBlankNodeIndex, lastId = Id::makeUndefined(),
+          mappedId = Id::makeUndefined()](Id& id) mutable {
+    if (lastId.getBits() == id.getBits()) {
+      id = mappedId;
+      return;
+    }
+    lastId = id;
+    using enum Datatype;
+    auto datatype = id.getDatatype();
+    if (datatype == VocabIndex) [[likely]] {
+      id = remapVocabId(id, insertionPositions);
+    } else if (datatype == LocalVocabIndex) {
+      id = localVocabMapping.at(id.getBits());
+    } else if (datatype == BlankNodeIndex) {
+      id = remapBlankNodeId(id, blankNodeBlocks, minBlankNodeIndex);
+    }
+    mappedId = id;
+  };
+}
+}  // namespace
+
 // _____________________________________________________________________________
 ad_utility::InputRangeTypeErased<IdTableStatic<0>> readIndexAndRemap(
     const Permutation& permutation,
@@ -200,25 +260,8 @@ ad_utility::InputRangeTypeErased<IdTableStatic<0>> readIndexAndRemap(
       scanSpecAndBlocks, additionalColumns, cancellationHandle,
       *locatedTriplesSharedState);
 
-  auto remapId = [&insertionPositions, &localVocabMapping, &blankNodeBlocks,
-                  minBlankNodeIndex, lastId = Id::makeUndefined(),
-                  mappedId = Id::makeUndefined()](Id& id) mutable {
-    if (lastId.getBits() == id.getBits()) {
-      id = mappedId;
-      return;
-    }
-    lastId = id;
-    using enum Datatype;
-    auto datatype = id.getDatatype();
-    if (datatype == VocabIndex) [[likely]] {
-      id = remapVocabId(id, insertionPositions);
-    } else if (datatype == LocalVocabIndex) {
-      id = localVocabMapping.at(id.getBits());
-    } else if (datatype == BlankNodeIndex) {
-      id = remapBlankNodeId(id, blankNodeBlocks, minBlankNodeIndex);
-    }
-    mappedId = id;
-  };
+  auto remapId = makeIdRemapper(localVocabMapping, insertionPositions,
+                                blankNodeBlocks, minBlankNodeIndex);
 
   return ad_utility::InputRangeTypeErased{
       ad_utility::CachingTransformInputRange{
@@ -243,6 +286,205 @@ ad_utility::InputRangeTypeErased<IdTableStatic<0>> readIndexAndRemap(
           }}};
 }
 
+namespace {
+// Compare the first four columns (the triple and the graph) of two rows. All
+// `Id`s are already remapped, so there are no local vocab `Id`s left.
+template <typename RowA, typename RowB>
+auto compareTriples(const RowA& a, const RowB& b) {
+  for (size_t i = 0; i + 1 < NumColumnsIndexBuilding; ++i) {
+    if (auto c = a[i].compareWithoutLocalVocab(b[i]); c != 0) {
+      return c;
+    }
+  }
+  constexpr size_t last = NumColumnsIndexBuilding - 1;
+  return a[last].compareWithoutLocalVocab(b[last]);
+}
+
+// The implementation of `mergeAdditionalTriples` (see there for details).
+class MergeAdditionalTriples
+    : public ad_utility::InputRangeFromGet<IdTableStatic<0>> {
+  using Blocks = ad_utility::InputRangeTypeErased<IdTableStatic<0>>;
+  using Triple = std::array<Id, NumColumnsIndexBuilding>;
+  // The number of rows of the blocks that only consist of additional triples.
+  static constexpr size_t blocksizeAdditionalOnly_ = 100'000;
+
+  Blocks existing_;
+  Blocks additional_;
+  size_t numColumns_;
+  // The block of `additional_` that is currently being merged and the index
+  // of its first row that has not been merged yet.
+  std::optional<IdTableStatic<0>> additionalBlock_;
+  size_t additionalRow_ = 0;
+  // The last additional triple that was handled, to skip duplicates.
+  std::optional<Triple> lastAdditional_;
+
+ public:
+  MergeAdditionalTriples(Blocks existing, Blocks additional, size_t numColumns)
+      : existing_{std::move(existing)},
+        additional_{std::move(additional)},
+        numColumns_{numColumns} {
+    AD_CONTRACT_CHECK(numColumns_ >= NumColumnsIndexBuilding);
+  }
+
+  std::optional<IdTableStatic<0>> get() override {
+    auto block = existing_.get();
+    if (!block.has_value()) {
+      return getAdditionalOnly();
+    }
+    if (block->empty()) {
+      return block;
+    }
+    // Merge all the additional triples that are not larger than the last
+    // triple of the `block`.
+    IdTableStatic<0> result{numColumns_, block->getAllocator()};
+    size_t row = 0;
+    auto lastRowOfBlock = (*block)[block->numRows() - 1];
+    while (hasAdditional() &&
+           compareTriples(currentAdditional(), lastRowOfBlock) <= 0) {
+      auto triple = currentAdditional();
+      while (compareTriples((*block)[row], triple) < 0) {
+        result.push_back((*block)[row]);
+        ++row;
+      }
+      if (compareTriples((*block)[row], triple) != 0 && !isDuplicate(triple)) {
+        pushAdditional(result, triple);
+      }
+      lastAdditional_ = Triple{triple[0], triple[1], triple[2], triple[3]};
+      ++additionalRow_;
+    }
+    if (result.empty()) {
+      return block;
+    }
+    for (; row < block->numRows(); ++row) {
+      result.push_back((*block)[row]);
+    }
+    return result;
+  }
+
+ private:
+  // Return true iff there is an additional triple left, read the next block of
+  // `additional_` if required.
+  bool hasAdditional() {
+    while (!additionalBlock_.has_value() ||
+           additionalRow_ == additionalBlock_->numRows()) {
+      additionalBlock_ = additional_.get();
+      additionalRow_ = 0;
+      if (!additionalBlock_.has_value()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The current additional triple, requires `hasAdditional()`.
+  auto currentAdditional() const { return (*additionalBlock_)[additionalRow_]; }
+
+  // Return true iff `triple` is equal to the previous additional triple.
+  template <typename Row>
+  bool isDuplicate(const Row& triple) const {
+    return lastAdditional_.has_value() &&
+           compareTriples(lastAdditional_.value(), triple) == 0;
+  }
+
+  // Append the `triple` to the `result` and fill the remaining columns with
+  // `Id::makeUndefined()`.
+  template <typename Row>
+  void pushAdditional(IdTableStatic<0>& result, const Row& triple) const {
+    result.emplace_back();
+    size_t row = result.numRows() - 1;
+    for (size_t col = 0; col < numColumns_; ++col) {
+      result(row, col) =
+          col < NumColumnsIndexBuilding ? triple[col] : Id::makeUndefined();
+    }
+  }
+
+  // Yield the additional triples that are larger than all existing triples.
+  std::optional<IdTableStatic<0>> getAdditionalOnly() {
+    if (!hasAdditional()) {
+      return std::nullopt;
+    }
+    IdTableStatic<0> result{numColumns_, additionalBlock_->getAllocator()};
+    while (result.numRows() < blocksizeAdditionalOnly_ && hasAdditional()) {
+      auto triple = currentAdditional();
+      if (!isDuplicate(triple)) {
+        pushAdditional(result, triple);
+      }
+      lastAdditional_ = Triple{triple[0], triple[1], triple[2], triple[3]};
+      ++additionalRow_;
+    }
+    // If only duplicates were left, the result is empty.
+    if (result.empty()) {
+      return std::nullopt;
+    }
+    return result;
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+ad_utility::InputRangeTypeErased<IdTableStatic<0>> mergeAdditionalTriples(
+    ad_utility::InputRangeTypeErased<IdTableStatic<0>> existing,
+    ad_utility::InputRangeTypeErased<IdTableStatic<0>> additional,
+    size_t numColumns) {
+  return ad_utility::InputRangeTypeErased{MergeAdditionalTriples{
+      std::move(existing), std::move(additional), numColumns}};
+}
+
+// _____________________________________________________________________________
+SortedAdditionalTriples::SortedAdditionalTriples(
+    AdditionalTriples triples, ql::span<const Permutation::Enum> permutations,
+    ql::span<const Permutation::Enum> internalPermutations,
+    const std::string& baseFilename, ad_utility::MemorySize memory,
+    const LocalVocabMapping& localVocabMapping,
+    const InsertionPositions& insertionPositions,
+    const BlankNodeBlocks& blankNodeBlocks, uint64_t minBlankNodeIndex,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) {
+  auto memoryPerSorter =
+      memory / (permutations.size() + internalPermutations.size());
+  auto sort = [&](AdditionalTriples::Storage& storage,
+                  ql::span<const Permutation::Enum> permutationEnums,
+                  auto& sorters, std::string_view suffix) {
+    std::vector<std::pair<Sorter*, Permutation::KeyOrder>> targets;
+    for (auto permutation : permutationEnums) {
+      auto& sorter = sorters.at(static_cast<size_t>(permutation));
+      sorter = std::make_unique<Sorter>(
+          absl::StrCat(baseFilename, ".", Permutation::toString(permutation),
+                       suffix),
+          memoryPerSorter, ad_utility::makeUnlimitedAllocator<Id>());
+      targets.emplace_back(sorter.get(), Permutation::toKeyOrder(permutation));
+    }
+    auto remapId = makeIdRemapper(localVocabMapping, insertionPositions,
+                                  blankNodeBlocks, minBlankNodeIndex);
+    size_t numTriples = 0;
+    for (const auto& row : storage.getRows()) {
+      if (++numTriples % 1'000'000 == 0) {
+        cancellationHandle->throwIfCancelled();
+      }
+      std::array<Id, NumColumnsIndexBuilding> triple{row[0], row[1], row[2],
+                                                     row[3]};
+      ql::ranges::for_each(triple, remapId);
+      for (auto& [sorter, keyOrder] : targets) {
+        sorter->push(keyOrder.permuteTuple(triple));
+      }
+    }
+  };
+  // The unsorted triples are deleted as soon as they are sorted.
+  sort(*triples.normal_, permutations, normal_, "");
+  triples.normal_.reset();
+  sort(*triples.internal_, internalPermutations, internal_, ".internal");
+  triples.internal_.reset();
+}
+
+// _____________________________________________________________________________
+ad_utility::InputRangeTypeErased<IdTableStatic<0>>
+SortedAdditionalTriples::getSortedTriples(Permutation::Enum permutation,
+                                          bool isInternal) {
+  auto& sorter = (isInternal ? internal_ : normal_)
+                     .at(static_cast<size_t>(permutation));
+  AD_CORRECTNESS_CHECK(sorter != nullptr);
+  return sorter->getSortedBlocks<0>();
+}
+
 // _____________________________________________________________________________
 size_t getNumColumns(const BlockMetadataRanges& blockMetadataRanges) {
   if (!blockMetadataRanges.empty()) {
@@ -290,35 +532,54 @@ boost::asio::awaitable<void> createPermutationWriterTask(
     const LocalVocabMapping& localVocabMapping,
     const InsertionPositions& insertionPositions,
     const BlankNodeBlocks& blankNodeBlocks, uint64_t minBlankNodeIndex,
-    const ad_utility::SharedCancellationHandle& cancellationHandle) {
+    const ad_utility::SharedCancellationHandle& cancellationHandle,
+    std::optional<ad_utility::InputRangeTypeErased<IdTableStatic<0>>>
+        additionalTriplesA,
+    std::optional<ad_utility::InputRangeTypeErased<IdTableStatic<0>>>
+        additionalTriplesB,
+    std::array<PermutationStatistics, 2>* statistics) {
   namespace net = boost::asio;
   auto ex = co_await net::this_coro::executor;
-  auto makeTaskForPermutation = [&](const Permutation& permutation) {
+  auto makeTaskForPermutation = [&](const Permutation& permutation,
+                                    auto additionalTriples) {
     return [&newIndex, &permutation, isInternal, &locatedTriplesSharedState,
             &localVocabMapping, &insertionPositions, &blankNodeBlocks,
-            minBlankNodeIndex, &cancellationHandle]() {
+            minBlankNodeIndex, &cancellationHandle,
+            additionalTriples = std::move(additionalTriples)]() mutable {
       auto blockMetadataRanges = permutation.getAugmentedMetadataForPermutation(
           *locatedTriplesSharedState);
       auto [numColumns, additionalColumns] =
           getNumberOfColumnsAndAdditionalColumns(blockMetadataRanges);
+      auto triples = readIndexAndRemap(
+          permutation, blockMetadataRanges, locatedTriplesSharedState,
+          localVocabMapping, insertionPositions, blankNodeBlocks,
+          minBlankNodeIndex, cancellationHandle, additionalColumns);
+      if (additionalTriples.has_value()) {
+        triples = mergeAdditionalTriples(std::move(triples),
+                                         std::move(additionalTriples.value()),
+                                         numColumns);
+      }
       return newIndex.createPermutationWithoutMetadata(
-          numColumns,
-          readIndexAndRemap(
-              permutation, blockMetadataRanges, locatedTriplesSharedState,
-              localVocabMapping, insertionPositions, blankNodeBlocks,
-              minBlankNodeIndex, cancellationHandle, additionalColumns),
-          permutation, isInternal);
+          numColumns, std::move(triples), permutation, isInternal);
     };
   };
-  auto taskA =
-      net::co_spawn(ex, asCoroutine(makeTaskForPermutation(permutationA)),
-                    net::use_awaitable);
-  auto taskB =
-      net::co_spawn(ex, asCoroutine(makeTaskForPermutation(permutationB)),
-                    net::use_awaitable);
-
-  auto [_, metaA] = co_await std::move(taskA);
-  auto [__, metaB] = co_await std::move(taskB);
+  auto taskA = net::co_spawn(
+      ex,
+      asCoroutine(makeTaskForPermutation(permutationA,
+                                         std::move(additionalTriplesA))),
+      net::use_awaitable);
+  auto taskB = net::co_spawn(
+      ex,
+      asCoroutine(makeTaskForPermutation(permutationB,
+                                         std::move(additionalTriplesB))),
+      net::use_awaitable);
+
+  auto [numDistinctCol0A, metaA] = co_await std::move(taskA);
+  auto [numDistinctCol0B, metaB] = co_await std::move(taskB);
+  if (statistics != nullptr) {
+    (*statistics)[0] = {numDistinctCol0A, metaA.totalElements()};
+    (*statistics)[1] = {numDistinctCol0B, metaB.totalElements()};
+  }
   metaA.exchangeMultiplicities(metaB);
 
   auto makeFinalizerTasks =
@@ -349,7 +610,8 @@ indexRebuilder::IndexRebuildMapping materializeToIndex(
     const std::vector<LocalVocabIndex>& entries,
     const indexRebuilder::OwnedBlocks& ownedBlocks,
     const ad_utility::SharedCancellationHandle& cancellationHandle,
-    const std::string& logFileName) {
+    const std::string& logFileName,
+    std::optional<indexRebuilder::AdditionalTriples> additionalTriples) {
   using namespace indexRebuilder;
   AD_CONTRACT_CHECK(!logFileName.empty(), "Log file name must not be empty");
 
@@ -384,8 +646,37 @@ indexRebuilder::IndexRebuildMapping materializeToIndex(
   // will throw immediately rather than silently using whatever allocator
   // the source index happens to have.
   IndexImpl newIndex{ad_utility::makeAllocatorWithLimit<Id>(0_B)};
+  newIndex.buildMembershipFilters() = index.buildMembershipFilters();
   newIndex.loadConfigFromOldIndex(newIndexName, index, newStats);
 
+  using enum Permutation::Enum;
+
+  // List of permutation pairs, with the information whether the attached
+  // internal permutation should be used.
+  std::vector<std::pair<std::pair<Permutation::Enum, Permutation::Enum>, bool>>
+      permutationSettings{{{PSO, POS}, false}, {{PSO, POS}, true}};
+
+  if (index.hasAllPermutations()) {
+    permutationSettings.push_back({{SPO, SOP}, false});
+    permutationSettings.push_back({{OPS, OSP}, false});
+  }
+
+  std::optional<SortedAdditionalTriples> sortedAdditionalTriples;
+  if (additionalTriples.has_value()) {
+    REBUILD_LOG_INFO << "Sorting the additional triples ..." << std::endl;
+    std::vector<Permutation::Enum> permutations{PSO, POS};
+    if (index.hasAllPermutations()) {
+      permutations.insert(permutations.end(), {SPO, SOP, OPS, OSP});
+    }
+    std::array internalPermutations{PSO, POS};
+    sortedAdditionalTriples.emplace(
+        std::move(additionalTriples.value()), permutations,
+        internalPermutations, newIndexName + ".merge-sort",
+        index.memoryLimitIndexBuilding(), localVocabMapping,
+        insertionPositions, blankNodeBlocks, minBlankNodeIndex,
+        cancellationHandle);
+  }
+
   REBUILD_LOG_INFO << "Writing new permutations ..." << std::endl;
 
   auto patternThreads = static_cast<size_t>(index.usePatterns());
@@ -412,19 +703,14 @@ indexRebuilder::IndexRebuildMapping materializeToIndex(
     }));
   }
 
-  using enum Permutation::Enum;
-
-  // List of permutation pairs, with the information whether the attached
-  // internal permutation should be used.
-  std::vector<std::pair<std::pair<Permutation::Enum, Permutation::Enum>, bool>>
-      permutationSettings{{{PSO, POS}, false}, {{PSO, POS}, true}};
-
-  if (index.hasAllPermutations()) {
-    permutationSettings.push_back({{SPO, SOP}, false});
-    permutationSettings.push_back({{OPS, OSP}, false});
-  }
+  // The statistics of the written permutations, in the same order as the
+  // `permutationSettings`. They are only needed for the additional triples,
+  // because otherwise the statistics have already been computed above.
+  std::vector<std::array<PermutationStatistics, 2>> statistics(
+      permutationSettings.size());
 
-  for (const auto& [permutationEnums, isInternal] : permutationSettings) {
+  for (size_t i = 0; i < permutationSettings.size(); ++i) {
+    const auto& [permutationEnums, isInternal] = permutationSettings.at(i);
     auto [a, b] = permutationEnums;
     auto getPermutation =
         [&index, isInternal](Permutation::Enum permEnum) -> const Permutation& {
@@ -432,18 +718,48 @@ indexRebuilder::IndexRebuildMapping materializeToIndex(
       return isInternal ? perm.internalPermutation() : perm;
     };
 
+    auto getAdditionalTriples = [&sortedAdditionalTriples, isInternal](
+                                    Permutation::Enum permEnum)
+        -> std::optional<ad_utility::InputRangeTypeErased<IdTableStatic<0>>> {
+      if (!sortedAdditionalTriples.has_value()) {
+        return std::nullopt;
+      }
+      return sortedAdditionalTriples->getSortedTriples(permEnum, isInternal);
+    };
+
     net::co_spawn(
         threadPool,
         createPermutationWriterTask(
             newIndex, getPermutation(a), getPermutation(b), isInternal,
             locatedTriplesSharedState, localVocabMapping, insertionPositions,
-            blankNodeBlocks, minBlankNodeIndex, cancellationHandle),
+            blankNodeBlocks, minBlankNodeIndex, cancellationHandle,
+            getAdditionalTriples(a), getAdditionalTriples(b),
+            &statistics.at(i)),
         std::ref(exceptionCollector));
   }
 
   threadPool.join();
   exceptionCollector.rethrowIfException();
 
+  if (sortedAdditionalTriples.has_value()) {
+    // The statistics of the existing index don't include the additional
+    // triples, so we take them from the written permutations. The indices
+    // refer to the order of the `permutationSettings` above.
+    const auto& pso = statistics.at(0).at(0);
+    const auto& psoInternal = statistics.at(1).at(0);
+    newStats["num-triples"] =
+        NumNormalAndInternal{pso.numTriples_, psoInternal.numTriples_};
+    newStats["num-predicates"] = NumNormalAndInternal{
+        pso.numDistinctCol0_, psoInternal.numDistinctCol0_};
+    if (index.hasAllPermutations()) {
+      newStats["num-subjects"] =
+          NumNormalAndInternal{statistics.at(2).at(0).numDistinctCol0_, 0};
+      newStats["num-objects"] =
+          NumNormalAndInternal{statistics.at(3).at(1).numDistinctCol0_, 0};
+    }
+    newIndex.loadConfigFromOldIndex(newIndexName, index, newStats);
+  }
+
   REBUILD_LOG_INFO << "Index rebuild completed" << std::endl;
 
 #undef REBUILD_LOG_INFO
@@ -451,6 +767,116 @@ indexRebuilder::IndexRebuildMapping materializeToIndex(
           std::move(blankNodeBlocks), minBlankNodeIndex};
 }
 
+// _____________________________________________________________________________
+void mergeFilesIntoIndex(
+    IndexImpl& index, const std::vector<InputFileSpecification>& files,
+    const std::string& newIndexName,
+    const ad_utility::SharedCancellationHandle& cancellationHandle) {
+  AD_CONTRACT_CHECK(!files.empty());
+  AD_CONTRACT_CHECK(newIndexName != index.getOnDiskBase(),
+                    "The merged index must not overwrite the existing index");
+  AD_LOG_INFO << "Parsing the input files to merge them into the index \""
+              << index.getOnDiskBase() << "\" ..." << std::endl;
+
+  // The new triples are stored externally until the new index is written.
+  // Neither the delta triples nor the files of the existing index are
+  // modified.
+  using Storage = indexRebuilder::AdditionalTriples::Storage;
+  auto makeStorage = [&index, &newIndexName](std::string_view suffix) {
+    return std::make_unique<Storage>(
+        absl::StrCat(newIndexName, ".merge-input", suffix),
+        index.memoryLimitIndexBuilding() / 2,
+        ad_utility::makeUnlimitedAllocator<Id>());
+  };
+  indexRebuilder::AdditionalTriples newTriples{makeStorage(""),
+                                               makeStorage(".internal")};
+
+  // The `Id`s of words that are not contained in the vocabulary of the
+  // `index` and of the blank nodes are managed by this `localVocab`. The same
+  // label always yields the same blank node, also across files.
+  LocalVocab localVocab;
+  ad_utility::HashMap<std::string, Id> blankNodes;
+  auto toId = [&index, &localVocab, &blankNodes](TripleComponent&& tc) {
+    if (!tc.isString()) {
+      return std::move(tc).toValueId(index, localVocab);
+    }
+    auto [it, isNew] =
+        blankNodes.try_emplace(tc.getString(), Id::makeUndefined());
+    if (isNew) {
+      it->second = Id::makeFromBlankNodeIndex(
+          localVocab.getBlankNodeIndex(index.getBlankNodeManager()));
+    }
+    return it->second;
+  };
+
+  // For literals with a language tag, the same internal triples are added as
+  // for the initial index build (see `getIdMapLambdas` in
+  // `IndexBuilderTypes.h`) and for UPDATEs (see
+  // `DeltaTriples::makeInternalTriples`). The `Id` of the predicate is only
+  // computed when it is needed, such that no unused word is added.
+  std::optional<Id> languagePredicate;
+
+  size_t numTriples = 0;
+  RdfMultifileParser parser{files, &index.encodedIriManager(),
+                            index.parserBufferSize()};
+  while (auto batch = parser.getBatch()) {
+    cancellationHandle->throwIfCancelled();
+    for (auto& triple : batch.value()) {
+      std::optional<TripleComponent> langTaggedPredicate;
+      std::optional<TripleComponent> langtagEntity;
+      if (triple.object_.isLiteral() &&
+          triple.object_.getLiteral().hasLanguageTag()) {
+        auto langtag =
+            asStringViewUnsafe(triple.object_.getLiteral().getLanguageTag());
+        langTaggedPredicate.emplace(
+            ad_utility::convertToLanguageTaggedPredicate(
+                triple.predicate_.getIri(), langtag));
+        langtagEntity.emplace(ad_utility::convertLangtagToEntityUri(langtag));
+      }
+      std::array ids{
+          toId(std::move(triple.subject_)), toId(std::move(triple.predicate_)),
+          toId(std::move(triple.object_)), toId(std::move(triple.graphIri_))};
+      newTriples.normal_->push(ids);
+      ++numTriples;
+      if (!langTaggedPredicate.has_value()) {
+        continue;
+      }
+      const auto& [subject, predicate, object, graph] = ids;
+      // `<subject> @language@<predicate> "object"@language`.
+      newTriples.internal_->push(std::array{
+          subject, toId(std::move(langTaggedPredicate.value())), object,
+          graph});
+      // `"object"@language ql:langtag <@language>`.
+      if (!languagePredicate.has_value()) {
+        languagePredicate = toId(TripleComponent{
+            ad_utility::triple_component::Iri::fromIriref(LANGUAGE_PREDICATE)});
+      }
+      newTriples.internal_->push(std::array{
+          object, languagePredicate.value(),
+          toId(std::move(langtagEntity.value())), graph});
+    }
+  }
+  AD_LOG_INFO << "Number of triples parsed: " << numTriples << std::endl;
+
+  // The new words and blank nodes are added to those of the updates.
+  AD_LOG_INFO << "Writing the merged index to \"" << newIndexName << "\" ..."
+              << std::endl;
+  auto [state, entries, ownedBlocks] =
+      index.deltaTriplesManager()
+          .getCurrentLocatedTriplesSharedStateWithVocab();
+  ql::ranges::copy(localVocab.primaryWordSet() |
+                       ql::views::transform(
+                           [](const LocalVocabEntry& entry) { return &entry; }),
+                   std::back_inserter(entries));
+  ql::ranges::copy(localVocab.getOwnedLocalBlankNodeBlocks(),
+                   std::back_inserter(ownedBlocks));
+  materializeToIndex(index, newIndexName, state, entries, ownedBlocks,
+                     cancellationHandle,
+                     absl::StrCat(newIndexName, ".merge-index-log.txt"),
+                     std::move(newTriples));
+  AD_LOG_INFO << "Index merge completed" << std::endl;
+}
+
 }  // namespace qlever
 
 #endif  // QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
@@ -10,14 +10,18 @@
 #ifndef QLEVER_SRC_INDEX_INDEXREBUILDER_H
 #define QLEVER_SRC_INDEX_INDEXREBUILDER_H
 
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
 
+#include "engine/idTable/CompressedExternalIdTable.h"
 #include "global/IndexTypes.h"
+#include "index/ConstantsIndexBuilding.h"
 #include "index/DeltaTriples.h"
 #include "index/IndexImpl.h"
 #include "index/IndexRebuilderTypes.h"
+#include "index/InputFileSpecification.h"
 #include "util/CancellationHandle.h"
 
 namespace qlever {
@@ -40,6 +44,19 @@ std::optional<Id> tryRemapBlankNodeId(Id original,
 // id space left by random allocation of blank node ids.
 Id remapBlankNodeId(Id original, const BlankNodeBlocks& blankNodeBlocks,
                     uint64_t minBlankNodeIndex);
+
+// Triples that are written to the new index by `materializeToIndex` in
+// addition to the triples of the existing index and its updates. The triples
+// are stored externally in the order of their `Id`s (subject, predicate,
+// object, graph), may be unsorted and may contain duplicates. Their `Id`s must
+// either be contained in the vocabulary of the existing index or in the
+// `entries` and `ownedBlocks` that are passed to `materializeToIndex`.
+struct AdditionalTriples {
+  using Storage =
+      ad_utility::CompressedExternalIdTable<NumColumnsIndexBuilding>;
+  std::unique_ptr<Storage> normal_;
+  std::unique_ptr<Storage> internal_;
+};
 }  // namespace indexRebuilder
 
 // Build a new index based on the existing state of the engine.
@@ -53,6 +70,9 @@ Id remapBlankNodeId(Id original, const BlankNodeBlocks& blankNodeBlocks,
 // `cancellationHandle` can be used to cancel the rebuild. In this case, the new
 // index will be left in an incomplete state and should be deleted by the
 // caller.
+// If `additionalTriples` are specified, they are sorted once for each
+// permutation and merged into the triples of the existing permutations while
+// these are written (see `AdditionalTriples` above).
 // Return the datastructures used for mapping to be used in further
 // post-processing.
 indexRebuilder::IndexRebuildMapping materializeToIndex(
@@ -61,7 +81,25 @@ indexRebuilder::IndexRebuildMapping materializeToIndex(
     const std::vector<LocalVocabIndex>& entries,
     const indexRebuilder::OwnedBlocks& ownedBlocks,
     const ad_utility::SharedCancellationHandle& cancellationHandle,
-    const std::string& logFileName);
+    const std::string& logFileName,
+    std::optional<indexRebuilder::AdditionalTriples> additionalTriples =
+        std::nullopt);
+
+// Build a new index at `newIndexName` that contains all the triples of the
+// existing `index` (including its updates) and all the triples from the given
+// input `files`. The new triples are parsed into an external (on-disk) buffer,
+// without modifying the delta triples of `index`, and then the index is
+// rebuilt using `materializeToIndex` above, which merges the new words into
+// the vocabulary and merges the sorted new triples into all permutations in a
+// single streaming pass over the existing ones. Only the words and blank nodes
+// that are not yet contained in the index are kept in RAM. The memory for
+// sorting the new triples is limited by `index.memoryLimitIndexBuilding()`.
+// The files of the existing index are not modified. The progress of the
+// rebuild is logged to `newIndexName + ".merge-index-log.txt"`.
+void mergeFilesIntoIndex(
+    IndexImpl& index, const std::vector<InputFileSpecification>& files,
+    const std::string& newIndexName,
+    const ad_utility::SharedCancellationHandle& cancellationHandle);
 
 }  // namespace qlever
 
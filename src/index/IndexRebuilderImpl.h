@@ -10,14 +10,20 @@
 #ifndef QLEVER_SRC_INDEX_INDEXREBUILDERIMPL_H
 #define QLEVER_SRC_INDEX_INDEXREBUILDERIMPL_H
 
+#include <array>
 #include <boost/asio/awaitable.hpp>
 #include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
 #include <tuple>
 #include <utility>
 #include <vector>
 
+#include "engine/idTable/CompressedExternalIdTable.h"
 #include "engine/idTable/IdTable.h"
 #include "global/Id.h"
+#include "index/ExternalSortFunctors.h"
 #include "index/IndexRebuilder.h"
 #include "index/IndexRebuilderTypes.h"
 #include "util/CancellationHandle.h"
@@ -60,9 +66,63 @@ ad_utility::InputRangeTypeErased<IdTableStatic<0>> readIndexAndRemap(
 // `Id::makeUndefined()`.
 size_t getNumColumns(const BlockMetadataRanges& blockMetadataRanges);
 
+// Merge the sorted `existing` triples of a permutation (with `numColumns`
+// columns) and the sorted `additional` triples (with four columns in the same
+// order as the permutation). Both inputs must be sorted by their first four
+// columns. The additional columns of the `additional` triples are filled with
+// `Id::makeUndefined()`, like for triples that were added via UPDATE. Triples
+// from `additional` that are contained in `existing` and duplicates within
+// `additional` are skipped. Blocks of `existing` that no additional triple
+// belongs to are passed through unchanged.
+ad_utility::InputRangeTypeErased<IdTableStatic<0>> mergeAdditionalTriples(
+    ad_utility::InputRangeTypeErased<IdTableStatic<0>> existing,
+    ad_utility::InputRangeTypeErased<IdTableStatic<0>> additional,
+    size_t numColumns);
+
+// The `AdditionalTriples::Storage`, sorted once for each permutation.
+class SortedAdditionalTriples {
+ public:
+  using Sorter = ad_utility::CompressedExternalIdTableSorter<
+      SortBySPO, NumColumnsIndexBuilding>;
+
+ private:
+  std::array<std::unique_ptr<Sorter>, Permutation::ALL.size()> normal_;
+  std::array<std::unique_ptr<Sorter>, Permutation::ALL.size()> internal_;
+
+ public:
+  // Remap the `Id`s of the `triples` to the `Id`s of the new index (see
+  // `readIndexAndRemap`) and sort them for each of the `permutations`, and
+  // the same for the `internalTriples` and the `internalPermutations`. The
+  // names of the temporary files start with `baseFilename`, the `memory` is
+  // split evenly between all sorters.
+  SortedAdditionalTriples(
+      AdditionalTriples triples, ql::span<const Permutation::Enum> permutations,
+      ql::span<const Permutation::Enum> internalPermutations,
+      const std::string& baseFilename, ad_utility::MemorySize memory,
+      const LocalVocabMapping& localVocabMapping,
+      const InsertionPositions& insertionPositions,
+      const BlankNodeBlocks& blankNodeBlocks, uint64_t minBlankNodeIndex,
+      const ad_utility::SharedCancellationHandle& cancellationHandle);
+
+  // Get the sorted triples for the given `permutation`, with the columns in
+  // the order of the permutation. May be called only once per permutation.
+  ad_utility::InputRangeTypeErased<IdTableStatic<0>> getSortedTriples(
+      Permutation::Enum permutation, bool isInternal);
+};
+
+// The number of distinct `Id`s in the first column and the total number of
+// triples of a permutation that was written by `createPermutationWriterTask`.
+struct PermutationStatistics {
+  size_t numDistinctCol0_ = 0;
+  size_t numTriples_ = 0;
+};
+
 // Create a `boost::asio::awaitable<void>` that writes a pair of new
 // permutations according to the settings of `newIndex`, based on the data of
-// the current index.
+// the current index. If `additionalTriplesA` (`additionalTriplesB`) is
+// specified, these triples are merged into the first (second) permutation
+// (see `mergeAdditionalTriples`). If `statistics` is not `nullptr`, the
+// statistics of the two written permutations are stored there.
 boost::asio::awaitable<void> createPermutationWriterTask(
     IndexImpl& newIndex, const Permutation& permutationA,
     const Permutation& permutationB, bool isInternal,
@@ -70,7 +130,12 @@ boost::asio::awaitable<void> createPermutationWriterTask(
     const LocalVocabMapping& localVocabMapping,
     const InsertionPositions& insertionPositions,
     const BlankNodeBlocks& blankNodeBlocks, uint64_t minBlankNodeIndex,
-    const ad_utility::SharedCancellationHandle& cancellationHandle);
+    const ad_utility::SharedCancellationHandle& cancellationHandle,
+    std::optional<ad_utility::InputRangeTypeErased<IdTableStatic<0>>>
+        additionalTriplesA = std::nullopt,
+    std::optional<ad_utility::InputRangeTypeErased<IdTableStatic<0>>>
+        additionalTriplesB = std::nullopt,
+    std::array<PermutationStatistics, 2>* statistics = nullptr);
 
 // Analyze how many columns the new permutation will have and which additional
 // columns it will have based on the given `blockMetadataRanges`. The number of
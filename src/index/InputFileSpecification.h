@@ -16,7 +16,7 @@
 #include <string>
 #include <variant>
 
-#include "parser/ParallelBuffer.h"
+#include "parser/ParallelDecompressingBuffer.h"
 
 namespace qlever {
 
@@ -71,12 +71,14 @@ struct InputFileSpecification {
   }
 
   // Create and return a `ParallelBuffer` for this spec. For filename-based
-  // specs, a `ParallelFileBuffer` with the given `blocksize` is returned. For
-  // factory-based specs, the factory is called.
+  // specs, a buffer with the given `blocksize` that reads (and, if the file is
+  // compressed, decompresses) the file is returned (see
+  // `makeParallelBufferForFile`). For factory-based specs, the factory is
+  // called.
   std::unique_ptr<ParallelBuffer> getParallelBuffer(size_t blocksize) const {
     if (std::holds_alternative<std::string>(source_)) {
-      return std::make_unique<ParallelFileBuffer>(
-          blocksize, std::get<std::string>(source_));
+      return makeParallelBufferForFile(blocksize,
+                                       std::get<std::string>(source_));
     }
     auto& [factory, description] =
         std::get<BufferFactoryAndDescription>(source_);
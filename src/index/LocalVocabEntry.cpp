@@ -31,9 +31,10 @@ auto LocalVocabEntry::positionInVocabExpensiveCase() const -> PositionInVocab {
 
   const auto& vocab = context_->getVocab();
 
-  // NOTE: For encoded IRIs, the only purpose of the returned `std::pair` is to
-  // give us a consistent ordering, which is important for determining equality
-  // and for operations like `Join`, `Distinct`, `GroupBy`, etc.
+  // NOTE: For encoded IRIs and inline literals, the only purpose of the
+  // returned `std::pair` is to give us a consistent ordering, which is
+  // important for determining equality and for operations like `Join`,
+  // `Distinct`, `GroupBy`, etc.
   auto [lower, upper] = [&]() {
     if (auto opt =
             context_->encodedIriManager().encode(toStringRepresentation());
@@ -10,13 +10,18 @@
 
 #include "index/LocatedTriples.h"
 
+#include <atomic>
+#include <numeric>
+
 #include "backports/algorithm.h"
 #include "global/RuntimeParameters.h"
 #include "index/CompressedRelation.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "index/GraphComputation.h"
 #include "index/Permutation.h"
+#include "util/Algorithm.h"
 #include "util/ChunkedForLoop.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/Log.h"
 #include "util/ValueIdentity.h"
 
@@ -26,32 +31,58 @@ std::vector<LocatedTriple> LocatedTriple::locateTriplesInPermutation(
     ql::span<const CompressedBlockMetadata> blockMetadata,
     const qlever::KeyOrder& keyOrder, bool insertOrDelete,
     ad_utility::SharedCancellationHandle cancellationHandle) {
-  std::vector<LocatedTriple> out;
-  out.reserve(triples.size());
+  auto permutedTriples =
+      ad_utility::transform(triples, [&keyOrder](const IdTriple<0>& triple) {
+        return triple.permute(keyOrder);
+      });
+  // Visit the triples in the order of the permutation, s.t. the blocks can be
+  // found with a single sweep over the block metadata. The input is typically
+  // sorted by SPO, so for the SPO permutation there is nothing to sort.
+  std::vector<size_t> order(triples.size());
+  std::iota(order.begin(), order.end(), size_t{0});
+  if (!ql::ranges::is_sorted(permutedTriples)) {
+    ql::ranges::sort(order, [&permutedTriples](size_t a, size_t b) {
+      return permutedTriples[a] < permutedTriples[b];
+    });
+  }
+  cancellationHandle->throwIfCancelled();
+
+  // A triple belongs to the first block that contains at least one triple
+  // that larger than or equal to the triple. See `LocatedTriples.h` for a
+  // discussion of the corner cases.
+  //
+  // NOTE: All identical triples with different graphs are currently stored in
+  // the same block, so we don't need to check the graph. In particular, if
+  // a triple is equal (without graphs) to the first or last triple of a block,
+  // then it is correctly assigned to this block.
+  auto isBeforeTriple = [](const CompressedBlockMetadata& block,
+                           const CompressedBlockMetadata::PermutedTriple& t) {
+    return block.lastTriple_.tieWithoutGraph() < t.tieWithoutGraph();
+  };
+  std::vector<size_t> blockIndices(triples.size());
+  size_t blockIndex = 0;
   ad_utility::chunkedForLoop<10'000>(
-      0, triples.size(),
-      [&triples, &out, &blockMetadata, &keyOrder, &insertOrDelete](size_t i) {
-        auto triple = triples[i].permute(keyOrder);
-        // A triple belongs to the first block that contains at least one triple
-        // that larger than or equal to the triple. See `LocatedTriples.h` for a
-        // discussion of the corner cases.
-        size_t blockIndex =
-            ql::ranges::lower_bound(
-                blockMetadata, triple.toPermutedTriple(),
-                [](const auto& a, const auto& b) {
-                  // All identical triples with different graphs are currently
-                  // stored in the same block, so we don't need to check the
-                  // graph. In particular, if this triple is equal (without
-                  // graphs) to the first or last triple of a block, then this
-                  // call to `lower_bound` will correctly identify this block.
-                  return a.tieWithoutGraph() < b.tieWithoutGraph();
-                },
-                &CompressedBlockMetadata::lastTriple_) -
-            blockMetadata.begin();
-        out.push_back({blockIndex, triple, insertOrDelete});
+      0, order.size(),
+      [&](size_t i) {
+        auto triple = permutedTriples[order[i]].toPermutedTriple();
+        // Many consecutive triples usually belong to the same block. Otherwise
+        // the block is searched among the remaining blocks.
+        if (blockIndex < blockMetadata.size() &&
+            isBeforeTriple(blockMetadata[blockIndex], triple)) {
+          blockIndex = std::lower_bound(blockMetadata.begin() + blockIndex + 1,
+                                        blockMetadata.end(), triple,
+                                        isBeforeTriple) -
+                       blockMetadata.begin();
+        }
+        blockIndices[order[i]] = blockIndex;
       },
       [&cancellationHandle]() { cancellationHandle->throwIfCancelled(); });
 
+  std::vector<LocatedTriple> out;
+  out.reserve(triples.size());
+  for (size_t i = 0; i < triples.size(); ++i) {
+    out.push_back({blockIndices[i], permutedTriples[i], insertOrDelete});
+  }
   return out;
 }
 
@@ -62,11 +93,15 @@ LocatedTriplesPerBlock::getUpdatesIfPresent(size_t blockIndex) const {
   if (it == map_.end()) {
     return boost::optional<const LocatedTriples&>{};
   }
-  return boost::optional<const LocatedTriples&>{it->second};
+  return boost::optional<const LocatedTriples&>{*it->second};
 }
 
 // ____________________________________________________________________________
 NumAddedAndDeleted LocatedTriplesPerBlock::numTriples(size_t blockIndex) const {
+  if (!hasTriplesToMerge(blockIndex)) {
+    // The located triples (if any) are already part of the compacted block.
+    return {0, 0};
+  }
   if (auto blockUpdateTriples = getUpdatesIfPresent(blockIndex)) {
     // Simply return the number of located triples twice. See the comment in the
     // header file for the reasons and potential improvements.
@@ -143,11 +178,9 @@ IdTable LocatedTriplesPerBlock::mergeTriplesImpl(size_t blockIndex,
   AD_CONTRACT_CHECK(numIndexColumns + static_cast<size_t>(includeGraphColumn) <=
                     block.numColumns());
 
-  auto numInsertsAndDeletes = numTriples(blockIndex);
+  const auto& locatedTriples = *map_.at(blockIndex);
   IdTable result{block.numColumns(), block.getAllocator()};
-  result.resize(block.numRows() + numInsertsAndDeletes.numAdded_);
-
-  const auto& locatedTriples = map_.at(blockIndex);
+  result.resize(block.numRows() + locatedTriples.size());
 
   auto lessThan = [](const auto& lt, const auto& row) {
     return tieLocatedTriple<numIndexColumns, includeGraphColumn>(lt) <
@@ -311,7 +344,7 @@ TriplesToVacuum LocatedTriplesPerBlock::identifyTriplesToVacuum(
       getRuntimeParameter<&RuntimeParameters::vacuumMinimumBlockSize_>();
   auto blocksToVacuum = map_ |
                         ql::views::filter([minimumBlockSize](const auto& e) {
-                          return e.second.size() >= minimumBlockSize;
+                          return e.second->size() >= minimumBlockSize;
                         }) |
                         ql::views::keys;
 
@@ -339,7 +372,7 @@ TriplesToVacuum LocatedTriplesPerBlock::identifyTriplesToVacuum(
           ad_utility::makeAllocatorWithLimit<Id>(0_B);
       IdTable idTable(4, allocator);
       totalStats +=
-          processBlockForVacuum(idTable, map_.at(blockIndex), inverseKeys,
+          processBlockForVacuum(idTable, *map_.at(blockIndex), inverseKeys,
                                 allDeletionsToRemove, allInsertionsToRemove);
       continue;
     }
@@ -349,7 +382,7 @@ TriplesToVacuum LocatedTriplesPerBlock::identifyTriplesToVacuum(
         std::vector<ColumnIndex>{ADDITIONAL_COLUMN_GRAPH_ID});
 
     totalStats +=
-        processBlockForVacuum(idTable, map_.at(blockIndex), inverseKeys,
+        processBlockForVacuum(idTable, *map_.at(blockIndex), inverseKeys,
                               allDeletionsToRemove, allInsertionsToRemove);
     cancellationHandle->throwIfCancelled();
   }
@@ -359,36 +392,164 @@ TriplesToVacuum LocatedTriplesPerBlock::identifyTriplesToVacuum(
 }
 
 // ____________________________________________________________________________
-std::vector<LocatedTriples::iterator> LocatedTriplesPerBlock::add(
-    ql::span<const LocatedTriple> locatedTriples,
-    ad_utility::timer::TimeTracer& tracer) {
+bool LocatedTriplesPerBlock::hasTriplesToMerge(size_t blockIndex) const {
+  auto it = map_.find(blockIndex);
+  if (it == map_.end()) {
+    return false;
+  }
+  auto compactedBlock = getCompactedBlock(blockIndex);
+  return compactedBlock == nullptr ||
+         compactedBlock->locatedTriples_ != it->second;
+}
+
+// ____________________________________________________________________________
+const CompactedBlock* LocatedTriplesPerBlock::getCompactedBlock(
+    size_t blockIndex) const {
+  auto it = compactedBlocks_.find(blockIndex);
+  return it == compactedBlocks_.end() ? nullptr : it->second.get();
+}
+
+// ____________________________________________________________________________
+ad_utility::MemorySize LocatedTriplesPerBlock::compactedBlocksMemory() const {
+  size_t numBytes = 0;
+  for (const auto& block : compactedBlocks_ | ql::views::values) {
+    for (const auto& column : block->columns_) {
+      numBytes += column.size();
+    }
+  }
+  return ad_utility::MemorySize::bytes(numBytes);
+}
+
+// ____________________________________________________________________________
+std::vector<std::pair<size_t, std::shared_ptr<const CompactedBlock>>>
+LocatedTriplesPerBlock::computeCompactedBlocks(
+    const Permutation& perm, size_t maxNumBlocks,
+    ad_utility::SharedCancellationHandle cancellationHandle) const {
+  size_t minimumBlockSize = getRuntimeParameter<
+      &RuntimeParameters::deltaTriplesCompactionMinimumBlockSize_>();
+  std::vector<std::pair<size_t, size_t>> candidates;
+  for (const auto& [blockIndex, locatedTriples] : map_) {
+    if (locatedTriples->size() >= minimumBlockSize &&
+        hasTriplesToMerge(blockIndex)) {
+      candidates.emplace_back(locatedTriples->size(), blockIndex);
+    }
+  }
+  // Compact the blocks with the most located triples first, because merging
+  // these is the most expensive for a scan.
+  ql::ranges::sort(candidates, std::greater{});
+  candidates.resize(std::min(candidates.size(), maxNumBlocks));
+
+  const auto& reader = perm.reader();
+  const auto& blockMetadata = perm.metaData().blockData();
+  AD_CORRECTNESS_CHECK(!blockMetadata.empty());
+  AD_CORRECTNESS_CHECK(
+      blockMetadata.front().offsetsAndCompressedSize_.has_value());
+  size_t numColumns = blockMetadata.front().offsetsAndCompressedSize_->size();
+  std::vector<ColumnIndex> additionalColumns;
+  for (ColumnIndex col = ADDITIONAL_COLUMN_GRAPH_ID; col < numColumns; ++col) {
+    additionalColumns.push_back(col);
+  }
+  const auto& augmentedMetadata = getAugmentedMetadata();
+
+  std::vector<std::pair<size_t, std::shared_ptr<const CompactedBlock>>> result;
+  for (size_t blockIndex : candidates | ql::views::values) {
+    AD_CORRECTNESS_CHECK(blockIndex <= blockMetadata.size());
+    // The block one past the last block with index triples only consists of
+    // located triples, so we merge them into an empty block.
+    auto block =
+        blockIndex == blockMetadata.size()
+            ? IdTable(numColumns, ad_utility::makeUnlimitedAllocator<Id>())
+            : reader.readBlockWithoutLocatedTriples(
+                  blockMetadata.at(blockIndex), additionalColumns);
+    auto merged = mergeTriples(blockIndex, block, 3, true);
+    cancellationHandle->throwIfCancelled();
+
+    auto compactedBlock = std::make_shared<CompactedBlock>();
+    // The augmented metadata already accounts for the located triples, we
+    // only have to adjust the number of rows.
+    auto metadataIt = ql::ranges::find(augmentedMetadata, blockIndex,
+                                       &CompressedBlockMetadata::blockIndex_);
+    AD_CORRECTNESS_CHECK(metadataIt != augmentedMetadata.end());
+    compactedBlock->metadata_ = *metadataIt;
+    compactedBlock->metadata_.numRows_ = merged.numRows();
+    for (size_t col = 0; col < merged.numColumns(); ++col) {
+      auto column = merged.getColumn(col);
+      compactedBlock->columns_.push_back(ZstdWrapper::compress(
+          column.data(), column.size() * sizeof(Id)));
+    }
+    compactedBlock->locatedTriples_ = map_.at(blockIndex);
+    result.emplace_back(blockIndex, std::move(compactedBlock));
+    cancellationHandle->throwIfCancelled();
+  }
+  return result;
+}
+
+// ____________________________________________________________________________
+bool LocatedTriplesPerBlock::installCompactedBlock(
+    size_t blockIndex, std::shared_ptr<const CompactedBlock> compactedBlock) {
+  AD_CONTRACT_CHECK(compactedBlock != nullptr);
+  auto it = map_.find(blockIndex);
+  if (it == map_.end() || it->second != compactedBlock->locatedTriples_) {
+    return false;
+  }
+  compactedBlocks_[blockIndex] = std::move(compactedBlock);
+  return true;
+}
+
+// ____________________________________________________________________________
+LocatedTriples& LocatedTriplesPerBlock::getBlockForModification(
+    size_t blockIndex) {
+  auto& block = map_[blockIndex];
+  if (block == nullptr) {
+    block = std::make_shared<LocatedTriples>();
+  } else if (block.use_count() > 1) {
+    block = std::make_shared<LocatedTriples>(*block);
+  } else {
+    // The other copies of the block might have been destroyed concurrently
+    // (copies are only created by the thread that also modifies this object).
+    // Synchronize with their destruction before modifying the block.
+    std::atomic_thread_fence(std::memory_order_acquire);
+  }
+  return *block;
+}
+
+// ____________________________________________________________________________
+void LocatedTriplesPerBlock::add(ql::span<const LocatedTriple> locatedTriples,
+                                 ad_utility::timer::TimeTracer& tracer) {
   tracer.beginTrace("adding");
-  std::vector<LocatedTriples::iterator> handles;
-  handles.reserve(locatedTriples.size());
-  for (auto triple : locatedTriples) {
-    LocatedTriples& locatedTriplesInBlock = map_[triple.blockIndex_];
-    auto [handle, wasInserted] = locatedTriplesInBlock.emplace(triple);
+  // The triples are usually grouped by block, so we only look up the block
+  // when the block index changes.
+  LocatedTriples* locatedTriplesInBlock = nullptr;
+  std::optional<size_t> currentBlockIndex;
+  for (const auto& triple : locatedTriples) {
+    if (currentBlockIndex != triple.blockIndex_) {
+      currentBlockIndex = triple.blockIndex_;
+      locatedTriplesInBlock = &getBlockForModification(triple.blockIndex_);
+    }
+    auto [handle, wasInserted] = locatedTriplesInBlock->emplace(triple);
     AD_CORRECTNESS_CHECK(wasInserted == true);
-    AD_CORRECTNESS_CHECK(handle != locatedTriplesInBlock.end());
+    AD_CORRECTNESS_CHECK(handle != locatedTriplesInBlock->end());
     ++numTriples_;
-    handles.emplace_back(handle);
   }
 
   tracer.endTrace("adding");
-  return handles;
 }
 
 // ____________________________________________________________________________
 void LocatedTriplesPerBlock::erase(size_t blockIndex,
-                                   LocatedTriples::iterator iter) {
-  auto blockIter = map_.find(blockIndex);
-  AD_CONTRACT_CHECK(blockIter != map_.end(), "Block ", blockIndex,
+                                   const IdTriple<0>& triple) {
+  AD_CONTRACT_CHECK(map_.contains(blockIndex), "Block ", blockIndex,
                     " is not contained");
-  auto& block = blockIter->second;
-  block.erase(iter);
+  auto& block = getBlockForModification(blockIndex);
+  // The comparison of `LocatedTriple`s only uses the `triple_`.
+  auto numErased = block.erase(LocatedTriple{blockIndex, triple, false});
+  AD_CONTRACT_CHECK(numErased == 1,
+                    "The triple to erase is not contained in block ",
+                    blockIndex);
   numTriples_--;
   if (block.empty()) {
     map_.erase(blockIndex);
+    compactedBlocks_.erase(blockIndex);
   }
 }
 
@@ -431,15 +592,21 @@ void updateGraphMetadata(CompressedBlockMetadata& blockMetadata,
 void LocatedTriplesPerBlock::updateAugmentedMetadata() {
   // TODO<C++23> use view::enumerate
   size_t blockIndex = 0;
-  // Copy to preserve originalMetadata_.
+  // Copy to preserve originalMetadata_. The previous augmented metadata might
+  // still be used by a snapshot, so it is replaced and not modified.
+  std::vector<CompressedBlockMetadata> augmentedMetadata;
   if (!originalMetadata_.has_value()) {
     AD_LOG_WARN << "The original metadata has not been set, but updates are "
                    "being performed. This should only happen in unit tests\n";
-    augmentedMetadata_.emplace();
   } else {
-    augmentedMetadata_ = *originalMetadata_.value();
+    augmentedMetadata = *originalMetadata_.value();
   }
-  for (auto& blockMetadata : augmentedMetadata_.value()) {
+  for (auto& blockMetadata : augmentedMetadata) {
+    // A compacted block has its own metadata, which already accounts for the
+    // located triples that were merged into it.
+    if (auto compactedBlock = getCompactedBlock(blockIndex)) {
+      blockMetadata = compactedBlock->metadata_;
+    }
     if (auto blockUpdates = getUpdatesIfPresent(blockIndex)) {
       blockMetadata.firstTriple_ =
           std::min(blockMetadata.firstTriple_,
@@ -463,13 +630,21 @@ void LocatedTriplesPerBlock::updateAugmentedMetadata() {
         std::nullopt, 0, firstTriple, lastTriple, std::nullopt, true};
     lastBlockN.graphInfo_.emplace();
     CompressedBlockMetadata lastBlock{lastBlockN, blockIndex};
+    if (auto compactedBlock = getCompactedBlock(blockIndex)) {
+      lastBlock = compactedBlock->metadata_;
+      lastBlock.firstTriple_ = std::min(lastBlock.firstTriple_, firstTriple);
+      lastBlock.lastTriple_ = std::max(lastBlock.lastTriple_, lastTriple);
+    }
     updateGraphMetadata(lastBlock, *blockUpdates);
-    augmentedMetadata_->push_back(lastBlock);
+    augmentedMetadata.push_back(lastBlock);
 
     AD_CORRECTNESS_CHECK(
         CompressedBlockMetadata::checkInvariantsForSortedBlocks(
-            *augmentedMetadata_));
+            augmentedMetadata));
   }
+  augmentedMetadata_ =
+      std::make_shared<const std::vector<CompressedBlockMetadata>>(
+          std::move(augmentedMetadata));
 }
 
 // ____________________________________________________________________________
@@ -508,7 +683,7 @@ bool LocatedTriplesPerBlock::isLocatedTriple(const IdTriple<0>& triple,
 
   return ql::ranges::any_of(map_, [&blockContains](auto& indexAndBlock) {
     const auto& [index, block] = indexAndBlock;
-    return blockContains(block, index);
+    return blockContains(*block, index);
   });
 }
 
@@ -522,10 +697,14 @@ std::array<std::vector<IdTriple<0>>, 2> LocatedTriplesPerBlock::computeDiff(
 
   for (const auto& [blockIndex, locatedTriples] : map_) {
     auto it = oldBlocks.map_.find(blockIndex);
+    // A shared block is unchanged.
+    if (it != oldBlocks.map_.end() && it->second == locatedTriples) {
+      continue;
+    }
     LocatedTriples empty;
-    const auto& set = it != oldBlocks.map_.end() ? it->second : empty;
+    const auto& set = it != oldBlocks.map_.end() ? *it->second : empty;
     ql::ranges::for_each(
-        locatedTriples, [&addTriple, &set](const LocatedTriple& lt) {
+        *locatedTriples, [&addTriple, &set](const LocatedTriple& lt) {
           auto it = set.find(lt);
           if (it == set.end() || it->insertOrDelete_ != lt.insertOrDelete_) {
             addTriple(lt.triple_, lt.insertOrDelete_);
@@ -12,6 +12,7 @@
 #define QLEVER_SRC_INDEX_LOCATEDTRIPLES_H
 
 #include <boost/optional.hpp>
+#include <memory>
 
 #include "backports/three_way_comparison.h"
 #include "engine/idTable/IdTable.h"
@@ -19,6 +20,7 @@
 #include "index/CompressedRelation.h"
 #include "index/KeyOrder.h"
 #include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
 #include "util/TimeTracer.h"
 
 class Permutation;
@@ -84,7 +86,9 @@ struct LocatedTriple {
   // If `true`, the triple is inserted, otherwise it is deleted.
   bool insertOrDelete_;
 
-  // Locate the given triples in the given permutation.
+  // Locate the given triples in the given permutation. The triples are sorted
+  // in the order of the permutation and located in a single sweep over the
+  // `blockMetadata`. The result is in the order of the input `triples`.
   static std::vector<LocatedTriple> locateTriplesInPermutation(
       ql::span<const IdTriple<0>> triples,
       ql::span<const CompressedBlockMetadata> blockMetadata,
@@ -119,27 +123,69 @@ using LocatedTriples = std::set<LocatedTriple, LocatedTripleCompare>;
 // human-readable representation.
 std::ostream& operator<<(std::ostream& os, const LocatedTriples& lts);
 
+// A block of a permutation into which the located triples of that block have
+// already been merged (see `DeltaTriplesCompactor`). Scans read such a block
+// instead of the original block from disk, and only have to merge the located
+// triples that were added or removed since the compaction.
+struct CompactedBlock {
+  // The metadata of the merged block. The `numRows_` are those of the merged
+  // block, the offsets are those of the original block and are not used.
+  CompressedBlockMetadata metadata_;
+  // The compressed columns of the merged block, one for each column of the
+  // permutation (in the order of the column indices).
+  CompressedBlock columns_;
+  // The located triples that were merged into the block. If the located
+  // triples of the block are still the same set (which is shared, see
+  // `LocatedTriplesPerBlock`), then nothing has to be merged when reading the
+  // block.
+  std::shared_ptr<const LocatedTriples> locatedTriples_;
+};
+
 // Sorted sets of located triples, grouped by block. We use this to store all
 // located triples for a permutation.
+//
+// The sets of the individual blocks are shared between copies of a
+// `LocatedTriplesPerBlock` (copy-on-write). This makes copies (which are
+// created for each snapshot of the delta triples after an update) cheap: only
+// the blocks that are modified afterwards are actually copied.
 class LocatedTriplesPerBlock {
  private:
   // The total number of `LocatedTriple` objects stored (for all blocks).
   size_t numTriples_ = 0;
 
   // For each block with a non-empty set of located triples, the located triples
-  // in that block.
-  ad_utility::HashMap<size_t, LocatedTriples> map_;
+  // in that block. The sets might be shared with other copies of this
+  // `LocatedTriplesPerBlock`, so they must only be modified via
+  // `getBlockForModification`.
+  ad_utility::HashMap<size_t, std::shared_ptr<LocatedTriples>> map_;
+
+  // For some of the blocks in `map_`, a `CompactedBlock` that already contains
+  // (a previous version of) the located triples of that block. Like the
+  // located triples, these are shared between copies of this
+  // `LocatedTriplesPerBlock`, so running queries keep the blocks they use
+  // alive.
+  ad_utility::HashMap<size_t, std::shared_ptr<const CompactedBlock>>
+      compactedBlocks_;
 
   FRIEND_TEST(LocatedTriplesTest, numTriplesInBlock);
 
+  // Return the located triples of the block with the given index for
+  // modification. If the block has no located triples yet, an empty set is
+  // created. If the set is shared with another copy of this
+  // `LocatedTriplesPerBlock`, it is copied first.
+  LocatedTriples& getBlockForModification(size_t blockIndex);
+
   // Implementation of the `mergeTriples` function (which has `numIndexColumns`
   // as a normal argument, and translates it into a template argument).
   template <size_t numIndexColumns, bool includeGraphColumn>
   IdTable mergeTriplesImpl(size_t blockIndex, const IdTable& block) const;
 
   // Stores the block metadata where the block borders have been adjusted for
-  // the updated triples.
-  std::optional<std::vector<CompressedBlockMetadata>> augmentedMetadata_;
+  // the updated triples. Like the located triples, it is shared between copies
+  // of this `LocatedTriplesPerBlock` (it is never modified, but replaced as a
+  // whole by `updateAugmentedMetadata`).
+  std::shared_ptr<const std::vector<CompressedBlockMetadata>>
+      augmentedMetadata_;
   std::optional<std::shared_ptr<const std::vector<CompressedBlockMetadata>>>
       originalMetadata_;
 
@@ -148,7 +194,8 @@ class LocatedTriplesPerBlock {
 
  public:
   // Get upper limits for the number of inserted and deleted located triples
-  // for the given block.
+  // for the given block. For a compacted block, only the located triples that
+  // still have to be merged are counted (see `hasTriplesToMerge`).
   //
   // NOTE: This currently returns the total number of triples in the block
   // twice, in order to avoid counting the triples with `insertOrDelete_ ==
@@ -198,23 +245,60 @@ class LocatedTriplesPerBlock {
     return map_.contains(blockIndex);
   }
 
-  // Add `locatedTriples` to the `LocatedTriplesPerBlock` and return handles to
-  // where they were added (`LocatedTriples` is a sorted set, see above). Using
-  // these handles, we can easily remove the `locatedTriples` from the set again
-  // when we need to.
+  // Return true iff the block with the given index has located triples that
+  // are not yet contained in its `CompactedBlock` (if any). These have to be
+  // merged with the block when it is read.
+  bool hasTriplesToMerge(size_t blockIndex) const;
+
+  // Return the `CompactedBlock` for the block with the given index, or
+  // `nullptr` if the block has not been compacted.
+  const CompactedBlock* getCompactedBlock(size_t blockIndex) const;
+
+  // Get the number of blocks that have been compacted.
+  size_t numCompactedBlocks() const { return compactedBlocks_.size(); }
+
+  // Get the size of the (compressed) columns of all compacted blocks.
+  ad_utility::MemorySize compactedBlocksMemory() const;
+
+  // For the (at most) `maxNumBlocks` blocks of `perm` with the most located
+  // triples that still have to be merged (at least
+  // `delta-triples-compaction-minimum-block-size` many), read the original
+  // block, merge the located triples into it, and compress the result. The
+  // blocks are returned together with their block index and have to be
+  // installed with `installCompactedBlock`. This is expensive and therefore
+  // meant to be called on a snapshot without holding any locks.
+  std::vector<std::pair<size_t, std::shared_ptr<const CompactedBlock>>>
+  computeCompactedBlocks(
+      const Permutation& perm, size_t maxNumBlocks,
+      ad_utility::SharedCancellationHandle cancellationHandle) const;
+
+  // Use the `compactedBlock` for the block with the given index from now on.
+  // This is only done if the located triples of that block are still the ones
+  // that were merged into the `compactedBlock`, otherwise the `compactedBlock`
+  // is outdated and `false` is returned.
+  //
+  // NOTE: `updateAugmentedMetadata()` must be called to update the block
+  // metadata.
+  bool installCompactedBlock(
+      size_t blockIndex, std::shared_ptr<const CompactedBlock> compactedBlock);
+
+  // Add `locatedTriples` to the `LocatedTriplesPerBlock`. Only the blocks to
+  // which triples are added are copied if they are shared with another copy
+  // of this `LocatedTriplesPerBlock`.
   //
   // PRECONDITION: The `locatedTriples` must not already exist in
   // `LocatedTriplesPerBlock`.
-  std::vector<LocatedTriples::iterator> add(
-      ql::span<const LocatedTriple> locatedTriples,
-      ad_utility::timer::TimeTracer& tracer =
-          ad_utility::timer::DEFAULT_TIME_TRACER);
+  void add(ql::span<const LocatedTriple> locatedTriples,
+           ad_utility::timer::TimeTracer& tracer =
+               ad_utility::timer::DEFAULT_TIME_TRACER);
 
-  // Removes the given `LocatedTriple` from the `LocatedTriplesPerBlock`.
+  // Removes the located triple with the given `triple` (in the order of the
+  // permutation, like `LocatedTriple::triple_`) from the block with the given
+  // `blockIndex`. The triple must be contained in the block.
   //
   // NOTE: `updateAugmentedMetadata()` must be called to update the block
   // metadata.
-  void erase(size_t blockIndex, LocatedTriples::iterator iter);
+  void erase(size_t blockIndex, const IdTriple<0>& triple);
 
   // Get the total number of `LocatedTriple`s (for all blocks).
   size_t numTriples() const { return numTriples_; }
@@ -237,8 +321,8 @@ class LocatedTriplesPerBlock {
   // account for the update triples. All triples (both insert and delete) will
   // enlarge the block borders.
   const std::vector<CompressedBlockMetadata>& getAugmentedMetadata() const {
-    if (augmentedMetadata_.has_value()) {
-      return augmentedMetadata_.value();
+    if (augmentedMetadata_ != nullptr) {
+      return *augmentedMetadata_;
     }
     AD_CONTRACT_CHECK(originalMetadata_.has_value());
     return *originalMetadata_.value();
@@ -247,6 +331,7 @@ class LocatedTriplesPerBlock {
   // Remove all located triples.
   void clear() {
     map_.clear();
+    compactedBlocks_.clear();
     numTriples_ = 0;
     augmentedMetadata_.reset();
   }
@@ -269,7 +354,8 @@ class LocatedTriplesPerBlock {
 
   // Compute the located triples that are present in this
   // `LocatedTriplesPerBlock` instance but not in `oldBlocks`. The result is a
-  // pair of vectors (insertions, deletions), each sorted in SPO order.
+  // pair of vectors (insertions, deletions), each sorted in SPO order. Blocks
+  // that are shared between the two instances are skipped.
   std::array<std::vector<IdTriple<0>>, 2> computeDiff(
       const LocatedTriplesPerBlock& oldBlocks) const;
 
@@ -283,8 +369,8 @@ class LocatedTriplesPerBlock {
                      std::back_inserter(blockIndices));
     ql::ranges::sort(blockIndices);
     for (auto blockIndex : blockIndices) {
-      os << "LTs in Block #" << blockIndex << ": " << ltpb.map_.at(blockIndex)
-         << std::endl;
+      os << "LTs in Block #" << blockIndex << ": "
+         << *ltpb.map_.at(blockIndex) << std::endl;
     }
     return os;
   };
@@ -32,8 +32,15 @@ Permutation::Permutation(Enum permutation, Allocator allocator,
 CompressedRelationReader::ScanSpecAndBlocks Permutation::getScanSpecAndBlocks(
     const ScanSpecification& scanSpec,
     const LocatedTriplesState& locatedTriplesState) const {
-  return {scanSpec, BlockMetadataRanges(getAugmentedMetadataForPermutation(
-                        locatedTriplesState))};
+  ScanSpecAndBlocks result{
+      scanSpec, BlockMetadataRanges(
+                    getAugmentedMetadataForPermutation(locatedTriplesState))};
+  if (membershipFilters_.has_value()) {
+    result.removeBlocksExcludedByMembershipFilters(
+        membershipFilters_.value(),
+        getLocatedTriplesForPermutation(locatedTriplesState));
+  }
+  return result;
 }
 
 // _____________________________________________________________________
@@ -68,6 +75,11 @@ void Permutation::loadFromDisk(
              e.what());
   }
   meta_.readFromFile(&file);
+  const auto& blocks = meta_.blockData();
+  membershipFilters_ = readPerBlockDataFromFileIfExists<BlockMembershipFilters>(
+      absl::StrCat(filename, MEMBERSHIP_FILTERS_SUFFIX), blocks);
+  zoneMaps_ = readPerBlockDataFromFileIfExists<BlockZoneMaps>(
+      absl::StrCat(filename, ZONE_MAPS_SUFFIX), blocks);
   // Materialized views never use graph post-processing, while normal and
   // internal permutations always use it.
   bool useGraphPostProcessing = permutationType != Type::MATERIALIZED_VIEW;
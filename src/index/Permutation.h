@@ -169,7 +169,9 @@ class Permutation {
       const LocatedTriplesState& locatedTriplesState) const;
 
   // Returns the corresponding `CompressedRelationReader::ScanSpecAndBlocks`
-  // with relevant `BlockMetadataRanges`.
+  // with relevant `BlockMetadataRanges`. If all three columns of the
+  // `scanSpec` are fixed, the blocks that don't contain this triple according
+  // to the `membershipFilters()` are not part of the result.
   ScanSpecAndBlocks getScanSpecAndBlocks(
       const ScanSpecification& scanSpec,
       const LocatedTriplesState& locatedTriplesState) const;
@@ -241,6 +243,16 @@ class Permutation {
 
   const CompressedRelationReader& reader() const { return reader_.value(); }
 
+  // The membership filters of the blocks, if they were built during the index
+  // building (see `BlockMembershipFilters`).
+  const std::optional<BlockMembershipFilters>& membershipFilters() const {
+    return membershipFilters_;
+  }
+
+  // The zone maps of the blocks, if they were written during the index
+  // building (see `BlockZoneMaps`).
+  const std::optional<BlockZoneMaps>& zoneMaps() const { return zoneMaps_; }
+
   Enum permutation() const { return permutation_; }
 
   // Provide const access to a linked internal permutation. If no internal
@@ -290,6 +302,10 @@ class Permutation {
   std::optional<CompressedRelationReader> reader_;
   Allocator allocator_;
 
+  // See `membershipFilters()` and `zoneMaps()` above.
+  std::optional<BlockMembershipFilters> membershipFilters_;
+  std::optional<BlockZoneMaps> zoneMaps_;
+
   bool isLoaded_ = false;
 
   Enum permutation_;
@@ -0,0 +1,177 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "index/SharedBlockScans.h"
+
+#include <absl/container/flat_hash_map.h>
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+#include "backports/algorithm.h"
+#include "global/RuntimeParameters.h"
+#include "util/Exception.h"
+
+// _____________________________________________________________________________
+static ad_utility::MemorySize memoryOfBlock(size_t numRows,
+                                            size_t numColumns) {
+  return ad_utility::MemorySize::bytes(numRows * numColumns * sizeof(Id));
+}
+
+// _____________________________________________________________________________
+auto SharedBlockScans::registerScan(Columns columns, size_t beginBlockIndex,
+                                    size_t endBlockIndex) -> Scan {
+  AD_CONTRACT_CHECK(beginBlockIndex <= endBlockIndex);
+  auto id = state_.withWriteLock([&](State& state) {
+    auto id = state.nextScanId_++;
+    state.scans_.emplace(id,
+                         ScanState{columns, beginBlockIndex, endBlockIndex});
+    return id;
+  });
+  return Scan{shared_from_this(), id, std::move(columns)};
+}
+
+// _____________________________________________________________________________
+SharedBlockScans::Scan::~Scan() {
+  if (scans_ == nullptr) {
+    return;
+  }
+  scans_->state_.withWriteLock([this](State& state) {
+    auto it = state.scans_.find(id_);
+    AD_CORRECTNESS_CHECK(it != state.scans_.end());
+    auto [position, end] = std::pair{it->second.position_, it->second.end_};
+    state.scans_.erase(it);
+    removeUnneededBlocks(state, columns_, position, end);
+  });
+}
+
+// _____________________________________________________________________________
+bool SharedBlockScans::isNeeded(const State& state, const Columns& columns,
+                                size_t blockIndex) {
+  return ql::ranges::any_of(state.scans_, [&](const auto& entry) {
+    const ScanState& scan = entry.second;
+    return scan.position_ <= blockIndex && blockIndex < scan.end_ &&
+           scan.columns_ == columns;
+  });
+}
+
+// _____________________________________________________________________________
+void SharedBlockScans::removeUnneededBlocks(State& state,
+                                            const Columns& columns,
+                                            size_t beginBlockIndex,
+                                            size_t endBlockIndex) {
+  auto blocksIt = state.blocks_.find(columns);
+  if (blocksIt == state.blocks_.end()) {
+    return;
+  }
+  auto& blocks = blocksIt->second;
+  auto it = blocks.lower_bound(beginBlockIndex);
+  while (it != blocks.end() && it->first < endBlockIndex) {
+    if (isNeeded(state, columns, it->first)) {
+      ++it;
+    } else {
+      state.memory_ -= it->second.memory_;
+      it = blocks.erase(it);
+    }
+  }
+  if (blocks.empty()) {
+    state.blocks_.erase(blocksIt);
+  }
+}
+
+// _____________________________________________________________________________
+auto SharedBlockScans::Scan::getBlock(size_t blockIndex, size_t numRows,
+                                      const ReadBlock& readBlock)
+    -> BlockOrSharedBlock {
+  auto maxMemory =
+      getRuntimeParameter<&RuntimeParameters::sharedScansMaxMemory_>();
+  auto memory = memoryOfBlock(numRows, columns_.size());
+  std::optional<std::shared_future<Block>> readByOtherScan;
+  std::optional<std::promise<Block>> readForOtherScans;
+  scans_->state_.withWriteLock([&](State& state) {
+    auto& scan = state.scans_.at(id_);
+    auto previousPosition = scan.position_;
+    scan.position_ = std::max(scan.position_, blockIndex + 1);
+    auto& blocks = state.blocks_[columns_];
+    if (auto it = blocks.find(blockIndex); it != blocks.end()) {
+      readByOtherScan = it->second.block_;
+      ++state.numBlocksShared_;
+    } else {
+      ++state.numBlocksRead_;
+      // This scan has already passed the block, so it is only kept if another
+      // scan still needs it. The memory is reserved now, s.t. the blocks that
+      // are read concurrently don't exceed the limit together.
+      if (isNeeded(state, columns_, blockIndex) &&
+          state.memory_ + memory <= maxMemory) {
+        readForOtherScans.emplace();
+        blocks.emplace(blockIndex,
+                       KeptBlock{readForOtherScans->get_future().share(),
+                                 memory});
+        state.memory_ += memory;
+      }
+    }
+    removeUnneededBlocks(state, columns_, previousPosition, scan.position_);
+  });
+
+  if (readByOtherScan.has_value()) {
+    try {
+      return readByOtherScan->get();
+    } catch (...) {
+      // The read of the other scan has failed (e.g. because its memory limit
+      // was exceeded), read the block independently.
+      return readBlock();
+    }
+  }
+  if (!readForOtherScans.has_value()) {
+    return readBlock();
+  }
+  // Call `action` for the kept block if it hasn't been removed in the
+  // meantime (because the other scans have passed it).
+  auto forKeptBlock = [this, blockIndex](auto action) {
+    scans_->state_.withWriteLock([&](State& state) {
+      auto blocksIt = state.blocks_.find(columns_);
+      if (blocksIt == state.blocks_.end()) {
+        return;
+      }
+      if (auto it = blocksIt->second.find(blockIndex);
+          it != blocksIt->second.end()) {
+        state.memory_ -= it->second.memory_;
+        action(state, blocksIt, it);
+      }
+    });
+  };
+  try {
+    auto block = std::make_shared<const IdTable>(readBlock());
+    readForOtherScans->set_value(block);
+    forKeptBlock([&block](State& state, auto, auto it) {
+      it->second.memory_ =
+          memoryOfBlock(block->numRows(), block->numColumns());
+      state.memory_ += it->second.memory_;
+    });
+    return block;
+  } catch (...) {
+    readForOtherScans->set_exception(std::current_exception());
+    forKeptBlock([](State& state, auto blocksIt, auto it) {
+      blocksIt->second.erase(it);
+      if (blocksIt->second.empty()) {
+        state.blocks_.erase(blocksIt);
+      }
+    });
+    throw;
+  }
+}
+
+// _____________________________________________________________________________
+auto SharedBlockScans::getStatistics() const -> Statistics {
+  return state_.withReadLock([](const State& state) {
+    size_t numBlocksKept = 0;
+    for (const auto& [columns, blocks] : state.blocks_) {
+      numBlocksKept += blocks.size();
+    }
+    return Statistics{state.scans_.size(), state.numBlocksRead_,
+                      state.numBlocksShared_, numBlocksKept, state.memory_};
+  });
+}
@@ -0,0 +1,138 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_INDEX_SHAREDBLOCKSCANS_H
+#define QLEVER_SRC_INDEX_SHAREDBLOCKSCANS_H
+
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "engine/idTable/IdTable.h"
+#include "global/Id.h"
+#include "util/HashMap.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/Synchronized.h"
+
+// Cooperative scans of the blocks of a single permutation: Concurrent lazy
+// scans that read the same columns share the reading and decompression of the
+// blocks. Each scan is registered together with the range of blocks that it
+// reads (in ascending order of the block index). When a scan reads a block
+// that another registered scan still has ahead of it, the decompressed block
+// is kept in memory until all these scans have passed it, and when a scan
+// requests a block that is currently being read by another scan, it waits for
+// that read instead of reading the block again.
+//
+// A scan that starts while another scan of the same blocks is running thus
+// reads the blocks before the current position of the running scan itself
+// (the scans have to yield their blocks in order, so they cannot wrap around)
+// and then consumes the blocks that are read by the running scan. The memory
+// of the kept blocks is limited by `shared-scans-max-memory`, when it is
+// exhausted, the scans read their blocks independently.
+class SharedBlockScans
+    : public std::enable_shared_from_this<SharedBlockScans> {
+ public:
+  using Block = std::shared_ptr<const IdTable>;
+  // A block that was read only for a single scan is returned directly (s.t.
+  // the scan can modify it without copying it).
+  using BlockOrSharedBlock = std::variant<IdTable, Block>;
+  using Columns = std::vector<ColumnIndex>;
+  using ReadBlock = std::function<IdTable()>;
+
+  // The registration of a single scan. The scan is unregistered when this
+  // object is destroyed.
+  class Scan {
+    std::shared_ptr<SharedBlockScans> scans_;
+    size_t id_;
+    Columns columns_;
+
+    friend class SharedBlockScans;
+    Scan(std::shared_ptr<SharedBlockScans> scans, size_t id, Columns columns)
+        : scans_{std::move(scans)}, id_{id}, columns_{std::move(columns)} {}
+
+   public:
+    Scan(Scan&&) noexcept = default;
+    Scan& operator=(Scan&&) = delete;
+    Scan(const Scan&) = delete;
+    Scan& operator=(const Scan&) = delete;
+    ~Scan();
+
+    // Return the decompressed block with the given index, either from another
+    // scan, or by calling `readBlock`. The scan has then passed all blocks
+    // with a smaller index. This function may be called concurrently for
+    // different blocks of the same scan. The block has `numRows` rows, the
+    // memory for it is reserved before it is read, s.t. concurrent reads
+    // can't exceed `shared-scans-max-memory`.
+    BlockOrSharedBlock getBlock(size_t blockIndex, size_t numRows,
+                                const ReadBlock& readBlock);
+  };
+
+  // Statistics for testing and logging.
+  struct Statistics {
+    size_t numScans_ = 0;
+    size_t numBlocksRead_ = 0;
+    size_t numBlocksShared_ = 0;
+    size_t numBlocksKept_ = 0;
+    ad_utility::MemorySize memory_;
+  };
+
+ private:
+  struct ScanState {
+    Columns columns_;
+    // The index of the next block that the scan needs.
+    size_t position_;
+    // The index after the last block that the scan needs.
+    size_t end_;
+  };
+
+  struct KeptBlock {
+    std::shared_future<Block> block_;
+    // The memory that is reserved for the block (the exact size once the
+    // block has been read).
+    ad_utility::MemorySize memory_;
+  };
+  // The kept blocks for the scans of the same columns, by their index.
+  using KeptBlocks = std::map<size_t, KeptBlock>;
+
+  struct State {
+    ad_utility::HashMap<size_t, ScanState> scans_;
+    ad_utility::HashMap<Columns, KeptBlocks> blocks_;
+    ad_utility::MemorySize memory_;
+    size_t nextScanId_ = 0;
+    size_t numBlocksRead_ = 0;
+    size_t numBlocksShared_ = 0;
+  };
+  ad_utility::Synchronized<State> state_;
+
+ public:
+  // Register a scan of the blocks with indices in `[beginBlockIndex,
+  // endBlockIndex)` that reads the given `columns`. Blocks in this range that
+  // the scan skips (e.g. because of a filter) might be kept for the scan
+  // unnecessarily until it has passed them.
+  Scan registerScan(Columns columns, size_t beginBlockIndex,
+                    size_t endBlockIndex);
+
+  Statistics getStatistics() const;
+
+ private:
+  // Return true iff the block with the given index lies ahead of a registered
+  // scan of the `columns`.
+  static bool isNeeded(const State& state, const Columns& columns,
+                       size_t blockIndex);
+
+  // Remove the kept blocks of the `columns` with indices in `[beginBlockIndex,
+  // endBlockIndex)` that are not needed anymore. A block can only become
+  // unneeded when a scan passes it or is unregistered, so only the blocks in
+  // the range that the scan has passed have to be checked.
+  static void removeUnneededBlocks(State& state, const Columns& columns,
+                                   size_t beginBlockIndex,
+                                   size_t endBlockIndex);
+};
+
+#endif  // QLEVER_SRC_INDEX_SHAREDBLOCKSCANS_H
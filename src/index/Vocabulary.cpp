@@ -10,6 +10,8 @@
 #include <iostream>
 
 #include "backports/StartsWithAndEndsWith.h"
+#include "backports/algorithm.h"
+#include "global/RuntimeParameters.h"
 #include "index/ConstantsIndexBuilding.h"
 #include "index/vocabulary/PolymorphicVocabulary.h"
 #include "index/vocabulary/SplitVocabulary.h"
@@ -44,6 +46,8 @@ template <class S, class C, typename I>
 void Vocabulary<S, C, I>::readFromFile(const string& fileName) {
   vocabulary_.close();
   vocabulary_.open(fileName);
+  hotStrings_.clear();
+  hotStringsInUse_ = false;
 
   // Precomputing ranges for IRIs, blank nodes, and literals, for faster
   // processing of the `isIrI` and `isLiteral` functions.
@@ -61,6 +65,8 @@ void Vocabulary<S, C, I>::createFromSet(
     const ad_utility::HashSet<std::string>& set, const std::string& filename) {
   AD_LOG_DEBUG << "BEGIN Vocabulary::createFromSet" << std::endl;
   vocabulary_.close();
+  hotStrings_.clear();
+  hotStringsInUse_ = false;
   std::vector<std::string> words(set.begin(), set.end());
   auto totalComparison = [this](const auto& a, const auto& b) {
     return getCaseComparator()(a, b, SortLevel::TOTAL);
@@ -295,9 +301,78 @@ auto Vocabulary<S, C, I>::prefixRanges(std::string_view prefix) const
 template <typename UnderlyingVocabulary, typename C, typename I>
 auto Vocabulary<UnderlyingVocabulary, C, I>::operator[](IndexType idx) const
     -> AccessReturnType {
+  if constexpr (useHotStringCache_) {
+    if (hotStringsInUse_.load(std::memory_order_relaxed)) {
+      if (auto word = hotStrings_.tryGet(idx.get())) {
+        return *word.value();
+      }
+    }
+  }
   return vocabulary_[idx.get()];
 }
 
+// _____________________________________________________________________________
+template <typename UnderlyingVocabulary, typename C, typename I>
+std::vector<std::string> Vocabulary<UnderlyingVocabulary, C, I>::lookupBatch(
+    ql::span<const IndexType> indices) const {
+  std::vector<std::string> result(indices.size());
+  std::vector<bool> isCached(indices.size(), false);
+  std::vector<uint64_t> indicesToLookUp;
+  bool useCache = useHotStringCache_ && hotStringsInUse_.load();
+  for (size_t i = 0; i < indices.size(); ++i) {
+    uint64_t idx = indices[i].get();
+    AD_CONTRACT_CHECK(idx < size());
+    if (useCache) {
+      if (auto word = hotStrings_.tryGet(idx)) {
+        result[i] = *word.value();
+        isCached[i] = true;
+        continue;
+      }
+    }
+    indicesToLookUp.push_back(idx);
+  }
+  ql::ranges::sort(indicesToLookUp);
+  indicesToLookUp.erase(
+      std::unique(indicesToLookUp.begin(), indicesToLookUp.end()),
+      indicesToLookUp.end());
+  auto words = detail::lookupBatch(vocabulary_.getUnderlyingVocabulary(),
+                                   indicesToLookUp);
+
+  for (size_t i = 0; i < indices.size(); ++i) {
+    if (!isCached[i]) {
+      auto pos = ql::ranges::lower_bound(indicesToLookUp, indices[i].get()) -
+                 indicesToLookUp.begin();
+      result[i] = words[pos];
+    }
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+template <typename UnderlyingVocabulary, typename C, typename I>
+void Vocabulary<UnderlyingVocabulary, C, I>::prefetch(
+    ql::span<const IndexType> indices) const {
+  if constexpr (useHotStringCache_) {
+    if (!getRuntimeParameter<
+            &RuntimeParameters::vocabularyHotStringCache_>()) {
+      return;
+    }
+    // Only the words that are not yet cached are looked up.
+    std::vector<IndexType> missing;
+    for (IndexType idx : indices) {
+      if (!hotStringsInUse_ || !hotStrings_.tryGet(idx.get())) {
+        missing.push_back(idx);
+      }
+    }
+    auto words = lookupBatch(missing);
+    for (size_t i = 0; i < missing.size(); ++i) {
+      hotStrings_.insert(missing[i].get(), std::make_shared<const std::string>(
+                                               std::move(words[i])));
+    }
+    hotStringsInUse_ = true;
+  }
+}
+
 // Explicit template instantiations
 template class Vocabulary<detail::UnderlyingVocabRdfsVocabulary,
                           TripleComponentComparator, VocabIndex>;
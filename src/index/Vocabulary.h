@@ -16,13 +16,16 @@
 #include <string_view>
 #include <vector>
 
+#include "backports/span.h"
 #include "backports/three_way_comparison.h"
 #include "index/StringSortComparator.h"
 #include "index/vocabulary/UnicodeVocabulary.h"
 #include "index/vocabulary/VocabularyInMemory.h"
 #include "rdfTypes/GeometryInfo.h"
+#include "util/CopyableSynchronization.h"
 #include "util/Exception.h"
 #include "util/HashSet.h"
+#include "util/ShardedLruCache.h"
 
 template <typename IndexT = WordVocabIndex>
 class IdRange {
@@ -106,6 +109,32 @@ class Vocabulary {
   using AccessReturnType =
       decltype(std::declval<const UnderlyingVocabulary&>()[0]);
 
+  // The maximal number of words in the cache of prefetched words (see
+  // `hotStrings_` below), and the maximal number of indices that should be
+  // passed to `prefetch` at once. The latter is only a fraction of the capacity
+  // of a single shard of the cache, s.t. the words of a batch (which are
+  // distributed over the shards by their hash) are not evicted before they are
+  // accessed, even if several queries prefetch concurrently.
+  static constexpr size_t hotStringCacheSize_ = 1 << 16;
+  static constexpr size_t hotStringCacheNumShards_ = 16;
+  static constexpr size_t prefetchBatchSize_ =
+      hotStringCacheSize_ / hotStringCacheNumShards_ / 4;
+
+ private:
+  // The cache is only used if the words are not stored in memory anyway.
+  static constexpr bool useHotStringCache_ =
+      std::is_same_v<AccessReturnType, std::string>;
+  // A cache for the words that were prefetched via `prefetch`. It is sharded
+  // to allow for concurrent accesses. The words are shared, s.t. a cache hit
+  // doesn't copy the word while the shard is locked.
+  mutable ad_utility::util::ShardedLRUCache<uint64_t,
+                                            std::shared_ptr<const std::string>>
+      hotStrings_{hotStringCacheSize_, hotStringCacheNumShards_};
+  // True iff words were prefetched into `hotStrings_`. As long as this is
+  // false, `operator[]` doesn't access the cache at all.
+  mutable ad_utility::CopyableAtomic<bool> hotStringsInUse_{false};
+
+ public:
   Vocabulary() = default;
   Vocabulary& operator=(Vocabulary&&) noexcept = default;
   Vocabulary(Vocabulary&&) noexcept = default;
@@ -119,6 +148,22 @@ class Vocabulary {
   // in the vocabulary.
   AccessReturnType operator[](IndexType idx) const;
 
+  // Get the words with the given `indices` (in the same order, duplicates are
+  // allowed). The indices of the words that are not in the cache of hot
+  // strings are deduplicated and sorted, and the words are then obtained from
+  // the underlying vocabulary in a single batch. This is much cheaper than
+  // calling `operator[]` for each index when the vocabulary is stored on disk,
+  // because neighboring words are read at once. The words are not added to
+  // the cache.
+  std::vector<std::string> lookupBatch(ql::span<const IndexType> indices) const;
+
+  // If the runtime parameter `vocabulary-hot-string-cache` is set, look up the
+  // words with the given `indices` in a single batch and store them in the
+  // cache of hot strings, s.t. subsequent calls to `operator[]` for these
+  // indices are cheap. Otherwise, do nothing. At most `prefetchBatchSize_`
+  // indices should be passed at once.
+  void prefetch(ql::span<const IndexType> indices) const;
+
   //! Get the number of words in the vocabulary.
   [[nodiscard]] size_t size() const { return vocabulary_.size(); }
 
@@ -238,6 +283,7 @@ class Vocabulary {
   void resetToType(ad_utility::VocabularyType type) {
     if constexpr (std::is_same_v<UnderlyingVocabulary, PolymorphicVocabulary>) {
       vocabulary_.getUnderlyingVocabulary().resetToType(type);
+      hotStrings_.clear();
     }
   }
 };
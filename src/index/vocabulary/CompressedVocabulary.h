@@ -58,6 +58,18 @@ CPP_template(typename UnderlyingVocabulary,
         toStringView(underlyingVocabulary_[idx]), getDecoderIdx(idx));
   }
 
+  // Get the uncompressed words with the given sorted `indices` (see
+  // `detail::lookupBatch`). The compressed words are obtained from the
+  // underlying vocabulary in a single batch.
+  std::vector<std::string> lookupBatch(ql::span<const uint64_t> indices) const {
+    auto words = detail::lookupBatch(underlyingVocabulary_, indices);
+    for (size_t i = 0; i < words.size(); ++i) {
+      words[i] = compressionWrapper_.decompress(words[i],
+                                                getDecoderIdx(indices[i]));
+    }
+    return words;
+  }
+
   [[nodiscard]] uint64_t size() const { return underlyingVocabulary_.size(); }
 
   // From a `comparator` that can compare two strings, make a new comparator,
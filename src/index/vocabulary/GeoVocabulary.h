@@ -70,6 +70,11 @@ class GeoVocabulary {
   // ___________________________________________________________________________
   decltype(auto) operator[](uint64_t id) const { return literals_[id]; }
 
+  // ___________________________________________________________________________
+  std::vector<std::string> lookupBatch(ql::span<const uint64_t> indices) const {
+    return detail::lookupBatch(literals_, indices);
+  }
+
   // ___________________________________________________________________________
   [[nodiscard]] uint64_t size() const { return literals_.size(); }
 
@@ -33,6 +33,14 @@ std::string PolymorphicVocabulary::operator[](uint64_t i) const {
   return std::visit([i](auto& vocab) { return std::string{vocab[i]}; }, vocab_);
 }
 
+// _____________________________________________________________________________
+std::vector<std::string> PolymorphicVocabulary::lookupBatch(
+    ql::span<const uint64_t> indices) const {
+  return std::visit(
+      [indices](auto& vocab) { return detail::lookupBatch(vocab, indices); },
+      vocab_);
+}
+
 // _____________________________________________________________________________
 auto PolymorphicVocabulary::makeDiskWriterPtr(const std::string& filename) const
     -> std::unique_ptr<WordWriterBase> {
@@ -73,6 +73,12 @@ class PolymorphicVocabulary {
   // Return the `i`-th word, throw if `i` is out of bounds.
   std::string operator[](uint64_t i) const;
 
+  // Return the words with the given `indices` (in the same order). The
+  // `indices` must be sorted and must not contain duplicates. This is much
+  // cheaper than calling `operator[]` for each of the indices when the words
+  // have to be read from disk.
+  std::vector<std::string> lookupBatch(ql::span<const uint64_t> indices) const;
+
   // Return a reference to currently underlying vocabulary, as a variant of the
   // possible types.
   Variant& getUnderlyingVocabulary() { return vocab_; }
@@ -5,7 +5,9 @@
 #ifndef QLEVER_SRC_INDEX_VOCABULARY_SPLITVOCABULARY_H
 #define QLEVER_SRC_INDEX_VOCABULARY_SPLITVOCABULARY_H
 
+#include <algorithm>
 #include <cstdint>
+#include <iterator>
 #include <memory>
 #include <string_view>
 #include <variant>
@@ -166,6 +168,33 @@ class SplitVocabulary {
         underlying_[marker]);
   }
 
+  // Get the words with the given sorted `indices` (see `detail::lookupBatch`).
+  // As the marker is stored in the most significant bits, the indices for each
+  // of the underlying vocabularies are contiguous.
+  std::vector<std::string> lookupBatch(ql::span<const uint64_t> indices) const {
+    std::vector<std::string> result;
+    result.reserve(indices.size());
+    std::vector<uint64_t> unmarkedIndices;
+    auto it = indices.begin();
+    while (it != indices.end()) {
+      auto marker = getMarker(*it);
+      auto end = std::find_if(it, indices.end(), [marker](uint64_t idx) {
+        return getMarker(idx) != marker;
+      });
+      unmarkedIndices.clear();
+      std::transform(it, end, std::back_inserter(unmarkedIndices),
+                     &getVocabIndex);
+      auto words = std::visit(
+          [&unmarkedIndices](const auto& vocab) {
+            return detail::lookupBatch(vocab, unmarkedIndices);
+          },
+          underlying_[marker]);
+      std::move(words.begin(), words.end(), std::back_inserter(result));
+      it = end;
+    }
+    return result;
+  }
+
   // The size of a SplitVocabulary is the sum of the sizes of the underlying
   // vocabularies.
   [[nodiscard]] uint64_t size() const {
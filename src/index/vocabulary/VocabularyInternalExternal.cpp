@@ -13,6 +13,28 @@ std::string VocabularyInternalExternal::operator[](uint64_t i) const {
   return externalVocab_[i];
 }
 
+// _____________________________________________________________________________
+std::vector<std::string> VocabularyInternalExternal::lookupBatch(
+    ql::span<const uint64_t> indices) const {
+  std::vector<std::string> result(indices.size());
+  std::vector<uint64_t> externalIndices;
+  std::vector<size_t> positionsOfExternalIndices;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    auto fromInternal = internalVocab_[indices[i]];
+    if (fromInternal.has_value()) {
+      result[i] = fromInternal.value();
+    } else {
+      externalIndices.push_back(indices[i]);
+      positionsOfExternalIndices.push_back(i);
+    }
+  }
+  auto fromExternal = externalVocab_.lookupBatch(externalIndices);
+  for (size_t i = 0; i < fromExternal.size(); ++i) {
+    result[positionsOfExternalIndices[i]] = std::move(fromExternal[i]);
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 VocabularyInternalExternal::WordWriter::WordWriter(const std::string& filename,
                                                    size_t milestoneDistance)
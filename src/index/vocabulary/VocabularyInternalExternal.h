@@ -49,6 +49,11 @@ class VocabularyInternalExternal {
   /// Return the `i-th` word. The behavior is undefined if `i >= size()`
   std::string operator[](uint64_t i) const;
 
+  // Get the words with the given sorted `indices` (see `detail::lookupBatch`).
+  // The words that are not contained in the internal vocabulary are read from
+  // the external vocabulary in a single batch.
+  std::vector<std::string> lookupBatch(ql::span<const uint64_t> indices) const;
+
   /// Return a `WordAndIndex` that points to the first entry that is equal or
   /// greater than `word` wrt. to the `comparator`. Only works correctly if the
   /// `words_` are sorted according to the comparator (exactly like in
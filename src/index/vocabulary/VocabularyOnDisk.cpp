@@ -28,6 +28,41 @@ std::string VocabularyOnDisk::operator[](uint64_t idx) const {
   return result;
 }
 
+// _____________________________________________________________________________
+std::vector<std::string> VocabularyOnDisk::lookupBatch(
+    ql::span<const uint64_t> indices) const {
+  std::vector<std::string> result;
+  result.reserve(indices.size());
+  std::string buffer;
+  size_t i = 0;
+  while (i < indices.size()) {
+    AD_CONTRACT_CHECK(indices[i] < size());
+    // Extend the range of bytes to read as long as the next word is close
+    // enough.
+    auto first = getOffsetAndSize(indices[i]);
+    uint64_t begin = first.offset_;
+    uint64_t end = begin + first.size_;
+    size_t j = i + 1;
+    for (; j < indices.size(); ++j) {
+      AD_CONTRACT_CHECK(indices[j - 1] < indices[j] && indices[j] < size());
+      auto next = getOffsetAndSize(indices[j]);
+      uint64_t nextEnd = next.offset_ + next.size_;
+      if (next.offset_ - end > maxGapForCombinedReads_ ||
+          nextEnd - begin > maxSizeOfCombinedReads_) {
+        break;
+      }
+      end = nextEnd;
+    }
+    buffer.resize(end - begin);
+    file_.read(buffer.data(), buffer.size(), begin);
+    for (; i < j; ++i) {
+      auto [offset, wordSize] = getOffsetAndSize(indices[i]);
+      result.emplace_back(buffer, offset - begin, wordSize);
+    }
+  }
+  return result;
+}
+
 // _____________________________________________________________________________
 template <typename Iterable>
 void VocabularyOnDisk::buildFromIterable(Iterable&& it,
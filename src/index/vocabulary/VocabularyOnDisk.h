@@ -23,6 +23,11 @@ class VocabularyOnDisk : public VocabularyBinarySearchMixin<VocabularyOnDisk> {
  private:
   // The offset of a word in the underlying file.
   using Offset = uint64_t;
+  // For `lookupBatch`: Neighboring words are read from the file with a single
+  // read if the gap between them is at most `maxGapForCombinedReads_` bytes
+  // and the total size of the read is at most `maxSizeOfCombinedReads_`.
+  static constexpr uint64_t maxGapForCombinedReads_ = 4096;
+  static constexpr uint64_t maxSizeOfCombinedReads_ = 1 << 20;
   // The file in which the words are stored.
   mutable ad_utility::File file_;
 
@@ -75,6 +80,11 @@ class VocabularyOnDisk : public VocabularyBinarySearchMixin<VocabularyOnDisk> {
   // size`.
   std::string operator[](uint64_t idx) const;
 
+  // Get the words with the given `indices` (in the same order). The `indices`
+  // must be sorted and must not contain duplicates. Words that are stored close
+  // to each other in the file are read with a single read.
+  std::vector<std::string> lookupBatch(ql::span<const uint64_t> indices) const;
+
   /// Get the number of words in the vocabulary.
   size_t size() const { return size_; }
 
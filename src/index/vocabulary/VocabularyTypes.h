@@ -10,7 +10,10 @@
 #include <optional>
 #include <string>
 #include <utility>
+#include <vector>
 
+#include "backports/concepts.h"
+#include "backports/span.h"
 #include "util/Exception.h"
 #include "util/ExceptionHandling.h"
 
@@ -135,4 +138,35 @@ class WordWriterBase {
   virtual void finishImpl() = 0;
 };
 
+namespace detail {
+template <typename Vocabulary>
+CPP_requires(HasLookupBatch_,
+             requires(const Vocabulary& vocabulary,
+                      ql::span<const uint64_t> indices)(
+                 vocabulary.lookupBatch(indices)));
+
+template <typename Vocabulary>
+CPP_concept HasLookupBatch = CPP_requires_ref(HasLookupBatch_, Vocabulary);
+
+// Return the words with the given `indices` (in the same order). The `indices`
+// must be sorted and must not contain duplicates. If the `vocabulary` has a
+// member function `lookupBatch` with the same semantics (which can exploit the
+// sortedness, e.g. to read neighboring words from disk at once), it is used,
+// otherwise the words are looked up one by one.
+template <typename Vocabulary>
+std::vector<std::string> lookupBatch(const Vocabulary& vocabulary,
+                                     ql::span<const uint64_t> indices) {
+  if constexpr (HasLookupBatch<Vocabulary>) {
+    return vocabulary.lookupBatch(indices);
+  } else {
+    std::vector<std::string> result;
+    result.reserve(indices.size());
+    for (uint64_t index : indices) {
+      result.emplace_back(vocabulary[index]);
+    }
+    return result;
+  }
+}
+}  // namespace detail
+
 #endif  // QLEVER_SRC_INDEX_VOCABULARY_VOCABULARYTYPES_H
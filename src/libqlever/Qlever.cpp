@@ -9,6 +9,7 @@
 #include "engine/ExportQueryExecutionTrees.h"
 #include "engine/MaterializedViews.h"
 #include "index/IndexImpl.h"
+#include "index/IndexRebuilder.h"
 #include "index/TextIndexBuilder.h"
 #include "libqlever/QleverTypes.h"
 #include "parser/SparqlParser.h"
@@ -79,11 +80,39 @@ void Qlever::buildIndex(IndexBuilderConfig config) {
   index.setSettingsFile(config.settingsFile_);
   index.loadAllPermutations() = !config.onlyPsoAndPos_;
   index.addHasWordTriples() = config.addHasWordTriples_;
+  index.buildMembershipFilters() = config.buildMembershipFilters_;
   index.getImpl().setVocabularyTypeForIndexBuilding(config.vocabType_);
-  index.getImpl().setPrefixesForEncodedValues(config.prefixesForIdEncodedIris_);
+  index.getImpl().setPrefixesForEncodedValues(config.prefixesForIdEncodedIris_,
+                                              config.encodeShortLiterals_);
 
-  // Build text index if requested (various options).
-  if (!config.onlyAddTextIndex_) {
+  // Build the RDF index, unless only a text index is added. If requested,
+  // the input files are merged into an existing index instead of building an
+  // index from scratch.
+  if (!config.mergeIntoIndex_.empty()) {
+    AD_CONTRACT_CHECK(!config.inputFiles_.empty());
+#ifndef QLEVER_REDUCED_FEATURE_SET_FOR_CPP17
+    // The settings that determine how the new index is written are taken from
+    // the `config`, the settings that determine the `Id`s (e.g. the encoded
+    // IRIs) are those of the existing index.
+    Index existingIndex{ad_utility::makeUnlimitedAllocator<Id>()};
+    existingIndex.usePatterns() = !config.noPatterns_;
+    existingIndex.memoryLimitIndexBuilding() = index.memoryLimitIndexBuilding();
+    existingIndex.parserBufferSize() = index.parserBufferSize();
+    existingIndex.buildMembershipFilters() = config.buildMembershipFilters_;
+    existingIndex.createFromOnDiskIndex(config.mergeIntoIndex_,
+                                        config.persistUpdates_);
+    if (config.kbIndexName_ != CommonConfig{}.kbIndexName_) {
+      existingIndex.setKbName(config.kbIndexName_);
+    }
+    mergeFilesIntoIndex(
+        existingIndex.getImpl(), config.inputFiles_, config.baseName_,
+        std::make_shared<ad_utility::SharedCancellationHandle::element_type>());
+#else
+    throw std::runtime_error(
+        "Merging input files into an existing index is not supported using "
+        "this restricted version of QLever");
+#endif
+  } else if (!config.onlyAddTextIndex_) {
     AD_CONTRACT_CHECK(!config.inputFiles_.empty());
     index.createFromFiles(config.inputFiles_);
   }
@@ -216,12 +245,28 @@ void IndexBuilderConfig::validate() const {
         "text index. If none are given the option to add words from literals "
         "has to be true. For details see --help."));
   }
+  if (!mergeIntoIndex_.empty()) {
+    if (onlyAddTextIndex_) {
+      throw std::invalid_argument(
+          "Merging into an existing index and only adding a text index "
+          "cannot be combined");
+    }
+    if (mergeIntoIndex_ == baseName_) {
+      throw std::invalid_argument(
+          "The index into which the input is merged must not be overwritten, "
+          "choose a different basename for the merged index");
+    }
+  }
 }
 
 // ___________________________________________________________________________
-void Qlever::writeMaterializedView(std::string name, std::string query) const {
+void Qlever::writeMaterializedView(
+    std::string name, std::string query,
+    const std::vector<MaterializedViewColumnOrder>& additionalOrders) const {
   materializedViewsManager_->writeViewToDisk(
-      std::move(name), parseAndPlanQuery(std::move(query)));
+      std::move(name), parseAndPlanQuery(std::move(query)),
+      ad_utility::MemorySize::gigabytes(4),
+      ad_utility::makeUnlimitedAllocator<Id>(), additionalOrders);
 }
 
 // ___________________________________________________________________________
@@ -105,6 +105,18 @@ struct IndexBuilderConfig : CommonConfig {
   // building the index are not deleted. This can be useful for debugging.
   bool keepTemporaryFiles_ = false;
 
+  // If set, the triples from the `inputFiles_` are merged into the existing
+  // index with this basename, and the merged index is written to `baseName_`.
+  // The vocabulary and the permutations of the existing index are merged with
+  // the new triples in a single pass, without rebuilding the index from
+  // scratch. The settings of the existing index (e.g. the encoded IRIs) are
+  // also used for the new triples, and the files of the existing index are not
+  // modified. Updates of the existing index are included if `persistUpdates_`
+  // is set. No text index is carried over from the existing index. The memory
+  // limit, the name, and the membership filters of the merged index are taken
+  // from this config.
+  std::string mergeIntoIndex_;
+
   // A list of IRI prefixes (without angle brackets). IRIs that start with one
   // of these prefixes, followed by a sequence of a bounded number of digits
   // are encoded directly in the internal ID. This reduces the size of the
@@ -116,6 +128,19 @@ struct IndexBuilderConfig : CommonConfig {
   // limitations regarding the correctness of FILTER and ORDER BY.
   std::vector<std::string> prefixesForIdEncodedIris_;
 
+  // If set to true, plain literals with at most 7 bytes (e.g. country codes or
+  // short labels) are encoded directly in the internal ID. Like for the
+  // encoded IRIs above, the order between encoded and non-encoded literals is
+  // not correct for ORDER BY and FILTER.
+  bool encodeShortLiterals_ = false;
+
+  // If set to true, a membership filter (a variant of a Bloom filter) is built
+  // for the triples of each block of each permutation and stored in a separate
+  // file. This makes lookups of single triples with all three positions fixed
+  // (e.g. in `ASK` or `EXISTS`) much cheaper, because most blocks don't have
+  // to be read. The filters need about 10 bits per triple and permutation.
+  bool buildMembershipFilters_ = false;
+
   // The remaining members of this class, are only relevant if a full-text
   // index is built in addition to the RDF index. By default, no fulltext index
   // is built. The full-text index enables efficient keyword search in text
@@ -266,8 +291,12 @@ class Qlever {
   void clearNamedResultCache();
 
   // Write a new materialized view with `name` to disk and store the result of
-  // `query`.
-  void writeMaterializedView(std::string name, std::string query) const;
+  // `query`. For each of the `additionalOrders`, the same rows are written to
+  // another view in the same pass (see `MaterializedViewColumnOrder`).
+  void writeMaterializedView(
+      std::string name, std::string query,
+      const std::vector<MaterializedViewColumnOrder>& additionalOrders =
+          {}) const;
 
   // Preload a materialized view s.t. the first query to the view does not have
   // to load the view.
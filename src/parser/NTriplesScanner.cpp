@@ -0,0 +1,178 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "parser/NTriplesScanner.h"
+
+#include "backports/StartsWithAndEndsWith.h"
+
+namespace nTriplesScanner {
+
+namespace {
+using Type = ScannedTerm::Type;
+
+bool isBlank(char c) { return c == ' ' || c == '\t'; }
+bool isAsciiAlpha(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+bool isAsciiAlphaNumeric(char c) {
+  return isAsciiAlpha(c) || (c >= '0' && c <= '9');
+}
+
+// Return the position of the first byte at or after `pos` that is not a space
+// or a tab.
+size_t skipBlanks(std::string_view input, size_t pos) {
+  while (pos < input.size() && isBlank(input[pos])) {
+    ++pos;
+  }
+  return pos;
+}
+
+// Each of the following functions recognizes a term that starts at `pos`. On
+// success, the term is returned, and `pos` is advanced to the first byte after
+// the term.
+
+// _____________________________________________________________________________
+std::optional<ScannedTerm> scanIriref(std::string_view input, size_t& pos) {
+  if (pos >= input.size() || input[pos] != '<') {
+    return std::nullopt;
+  }
+  auto end = findEndOfIriref(input, pos + 1);
+  if (end == input.size() || input[end] != '>') {
+    return std::nullopt;
+  }
+  ScannedTerm term{Type::Iriref, input.substr(pos, end + 1 - pos)};
+  pos = end + 1;
+  return term;
+}
+
+// Only labels that consist of ASCII letters, digits, `_`, `-`, and `.` are
+// recognized, everything else (in particular non-ASCII characters) is left to
+// the general parser.
+std::optional<ScannedTerm> scanBlankNodeLabel(std::string_view input,
+                                              size_t& pos) {
+  if (!ql::starts_with(input.substr(pos), "_:")) {
+    return std::nullopt;
+  }
+  size_t begin = pos + 2;
+  size_t end = begin;
+  while (end < input.size() &&
+         (isAsciiAlphaNumeric(input[end]) || input[end] == '_' ||
+          input[end] == '-' || input[end] == '.')) {
+    ++end;
+  }
+  // A label must not end with a dot, such a dot ends the statement.
+  while (end > begin && input[end - 1] == '.') {
+    --end;
+  }
+  if (end == begin || input[begin] == '-' || input[begin] == '.' ||
+      end == input.size()) {
+    return std::nullopt;
+  }
+  char next = input[end];
+  if (!isBlank(next) && next != '.' && next != '<') {
+    return std::nullopt;
+  }
+  ScannedTerm term{Type::BlankNodeLabel, input.substr(pos, end - pos)};
+  pos = end;
+  return term;
+}
+
+// Only literals in double quotes are recognized. The escape sequences are only
+// skipped here, they are validated when the literal is unescaped.
+std::optional<ScannedTerm> scanLiteral(std::string_view input, size_t& pos) {
+  if (pos >= input.size() || input[pos] != '"') {
+    return std::nullopt;
+  }
+  ScannedTerm term{Type::Literal};
+  size_t end = pos + 1;
+  while (true) {
+    end = findEndOfLiteral(input, end);
+    if (end >= input.size() || input[end] == '\n' || input[end] == '\r') {
+      return std::nullopt;
+    }
+    if (input[end] == '"') {
+      break;
+    }
+    // A backslash, the next byte is escaped.
+    term.hasEscapes_ = true;
+    end += 2;
+  }
+  term.text_ = input.substr(pos, end + 1 - pos);
+  size_t next = end + 1;
+  if (next < input.size() && input[next] == '@') {
+    // A language tag of the form `@[a-zA-Z]+(-[a-zA-Z0-9]+)*`.
+    size_t tagEnd = next + 1;
+    while (tagEnd < input.size() && isAsciiAlpha(input[tagEnd])) {
+      ++tagEnd;
+    }
+    if (tagEnd == next + 1) {
+      return std::nullopt;
+    }
+    while (tagEnd < input.size() && input[tagEnd] == '-') {
+      size_t subtagBegin = tagEnd + 1;
+      tagEnd = subtagBegin;
+      while (tagEnd < input.size() && isAsciiAlphaNumeric(input[tagEnd])) {
+        ++tagEnd;
+      }
+      if (tagEnd == subtagBegin) {
+        return std::nullopt;
+      }
+    }
+    term.languageTag_ = input.substr(next, tagEnd - next);
+    next = tagEnd;
+  } else if (ql::starts_with(input.substr(next), "^^")) {
+    next += 2;
+    auto datatype = scanIriref(input, next);
+    if (!datatype.has_value()) {
+      return std::nullopt;
+    }
+    term.datatype_ = datatype.value().text_;
+  }
+  pos = next;
+  return term;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+std::optional<ScannedStatement> scanStatement(std::string_view input,
+                                              bool allowGraphLabel) {
+  size_t pos = 0;
+  auto iriOrBlankNode = [&input, &pos]() {
+    pos = skipBlanks(input, pos);
+    auto result = scanIriref(input, pos);
+    return result.has_value() ? result : scanBlankNodeLabel(input, pos);
+  };
+
+  auto subject = iriOrBlankNode();
+  if (!subject.has_value()) {
+    return std::nullopt;
+  }
+  pos = skipBlanks(input, pos);
+  auto predicate = scanIriref(input, pos);
+  if (!predicate.has_value()) {
+    return std::nullopt;
+  }
+  pos = skipBlanks(input, pos);
+  auto object = iriOrBlankNode();
+  if (!object.has_value()) {
+    object = scanLiteral(input, pos);
+    if (!object.has_value()) {
+      return std::nullopt;
+    }
+  }
+  std::optional<ScannedTerm> graphLabel;
+  if (allowGraphLabel) {
+    graphLabel = iriOrBlankNode();
+  }
+  pos = skipBlanks(input, pos);
+  if (pos >= input.size() || input[pos] != '.') {
+    return std::nullopt;
+  }
+  return ScannedStatement{{subject.value(), predicate.value(), object.value()},
+                          graphLabel,
+                          pos + 1};
+}
+
+}  // namespace nTriplesScanner
@@ -0,0 +1,137 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_PARSER_NTRIPLESSCANNER_H
+#define QLEVER_SRC_PARSER_NTRIPLESSCANNER_H
+
+#include <absl/base/config.h>
+#include <absl/numeric/bits.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+
+// A scanner that finds the boundaries of the terms of simple N-Triples and
+// N-Quads statements (like `<s> <p> "o"@en .`) without a tokenizer. The
+// structural characters are found by examining eight bytes at once with
+// word-level bit tricks ("SIMD within a register"), which works on all
+// platforms without special instructions. The scanner only recognizes the
+// common simple cases (IRIs without escape sequences, ASCII blank node labels,
+// and single-quoted literals with an optional language tag or datatype). For
+// everything else it returns `std::nullopt`, and the caller has to fall back
+// to the general parser, which also produces the proper error messages.
+namespace nTriplesScanner {
+
+namespace detail {
+constexpr uint64_t lowBits = 0x0101010101010101ULL;
+constexpr uint64_t highBits = 0x8080808080808080ULL;
+
+// A word in which each of the eight bytes is `c`.
+constexpr uint64_t broadcast(uint8_t c) { return lowBits * c; }
+
+// Return a word in which the high bit of each byte of `word` that is smaller
+// than `n` (which must be at most 128) is set. Bytes above the first such byte
+// might also be set, so only the lowest set bit is reliable.
+constexpr uint64_t bytesLessThan(uint64_t word, uint8_t n) {
+  return (word - broadcast(n)) & ~word & highBits;
+}
+
+// Return a word in which the high bit of each byte of `word` that equals `c`
+// is set (the same caveat as for `bytesLessThan` applies).
+constexpr uint64_t bytesEqualTo(uint64_t word, char c) {
+  return bytesLessThan(word ^ broadcast(static_cast<uint8_t>(c)), 1);
+}
+
+// Load eight bytes such that the byte at `ptr` is the least significant one.
+inline uint64_t loadWord(const char* ptr) {
+  uint64_t word;
+  std::memcpy(&word, ptr, sizeof(word));
+#ifdef ABSL_IS_BIG_ENDIAN
+  word = __builtin_bswap64(word);
+#endif
+  return word;
+}
+
+// Return the position of the first byte in `input` at or after `pos` that is
+// one of the `Chars` or (if `IncludeControlAndSpace` is true) is at most
+// 0x20. Return `input.size()` if there is no such byte.
+template <bool IncludeControlAndSpace, char... Chars>
+size_t findFirst(std::string_view input, size_t pos) {
+  auto matchesWord = [](uint64_t word) {
+    uint64_t result = (bytesEqualTo(word, Chars) | ...);
+    if constexpr (IncludeControlAndSpace) {
+      result |= bytesLessThan(word, 0x21);
+    }
+    return result;
+  };
+  for (; pos + 8 <= input.size(); pos += 8) {
+    uint64_t matches = matchesWord(loadWord(input.data() + pos));
+    if (matches != 0) {
+      return pos + absl::countr_zero(matches) / 8;
+    }
+  }
+  for (; pos < input.size(); ++pos) {
+    auto c = input[pos];
+    if (((c == Chars) || ...) ||
+        (IncludeControlAndSpace && static_cast<uint8_t>(c) <= 0x20)) {
+      return pos;
+    }
+  }
+  return input.size();
+}
+}  // namespace detail
+
+// Return the position of the first byte at or after `pos` that ends the
+// IRI reference that starts before `pos`. This is either the closing `>` or
+// a byte that is not allowed in an IRI reference without escape sequences.
+inline size_t findEndOfIriref(std::string_view input, size_t pos) {
+  return detail::findFirst<true, '>', '<', '"', '{', '}', '|', '^', '`',
+                           '\\'>(input, pos);
+}
+
+// Return the position of the first byte at or after `pos` that ends the
+// content of a literal, or that requires special treatment (a backslash or a
+// line break).
+inline size_t findEndOfLiteral(std::string_view input, size_t pos) {
+  return detail::findFirst<false, '"', '\\', '\n', '\r'>(input, pos);
+}
+
+// A single term of a statement that was recognized by `scanStatement`.
+struct ScannedTerm {
+  enum class Type { Iriref, BlankNodeLabel, Literal };
+  Type type_;
+  // The IRI reference with the angle brackets, the blank node label with the
+  // leading `_:`, or the literal with the quotes (but without a language tag
+  // or datatype).
+  std::string_view text_;
+  // For literals: true iff the content contains escape sequences.
+  bool hasEscapes_ = false;
+  // For literals: the language tag (with the leading `@`) and the datatype (an
+  // IRI reference with angle brackets). At most one of them is non-empty.
+  std::string_view languageTag_;
+  std::string_view datatype_;
+};
+
+// A statement that was recognized by `scanStatement`.
+struct ScannedStatement {
+  std::array<ScannedTerm, 3> triple_;
+  std::optional<ScannedTerm> graphLabel_;
+  // The number of bytes of the statement, including the final dot.
+  size_t size_;
+};
+
+// Recognize a simple statement at the beginning of the `input`, which must not
+// start with whitespace or a comment. If `allowGraphLabel` is true, an
+// (optional) fourth term is allowed before the final dot (as in N-Quads).
+// Return `std::nullopt` if the input does not start with such a statement, or
+// if the statement is not complete.
+std::optional<ScannedStatement> scanStatement(std::string_view input,
+                                              bool allowGraphLabel);
+
+}  // namespace nTriplesScanner
+
+#endif  // QLEVER_SRC_PARSER_NTRIPLESSCANNER_H
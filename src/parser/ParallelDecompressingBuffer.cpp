@@ -0,0 +1,539 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include "parser/ParallelDecompressingBuffer.h"
+
+#include <absl/strings/str_cat.h>
+#include <zstd.h>
+
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+#include <filesystem>
+#include <fstream>
+
+#include "backports/StartsWithAndEndsWith.h"
+#include "util/Log.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/ParallelExecutor.h"
+
+using BufferType = ParallelBuffer::BufferType;
+namespace io = boost::iostreams;
+
+namespace {
+// The magic numbers at the beginning of a compressed file.
+constexpr std::string_view gzipMagic{"\x1f\x8b", 2};
+constexpr std::string_view bzip2Magic{"BZh"};
+constexpr std::string_view zstdMagic{"\x28\xb5\x2f\xfd", 4};
+// The magic number of a bzip2 block, which directly follows the header of a
+// bzip2 stream (`BZh` and the block size as a digit).
+constexpr std::string_view bzip2BlockMagic{"\x31\x41\x59\x26\x53\x59", 6};
+
+// Independently compressed units that are larger than this are not supported.
+constexpr size_t maxUnitSize = 1ULL << 30;
+
+// Throw if `result` (the return value of a zstd function) is an error.
+size_t checkZstdResult(size_t result) {
+  if (ZSTD_isError(result)) {
+    throw std::runtime_error{absl::StrCat(
+        "Error decompressing zstd input: ", ZSTD_getErrorName(result))};
+  }
+  return result;
+}
+
+using ZstdContext = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>;
+ZstdContext makeZstdContext() {
+  return ZstdContext{ZSTD_createDCtx(), &ZSTD_freeDCtx};
+}
+
+// Return true iff a bzip2 stream starts at the given `position` of `bytes`.
+bool isBzip2StreamStart(std::string_view bytes, size_t position) {
+  auto header = bytes.substr(position, 4 + bzip2BlockMagic.size());
+  return header.size() == 4 + bzip2BlockMagic.size() &&
+         ql::starts_with(header, bzip2Magic) && header[3] >= '1' &&
+         header[3] <= '9' && header.substr(4) == bzip2BlockMagic;
+}
+
+// Return the size of the gzip member at the beginning of `bytes` if it is a
+// block in the BGZF format (which stores the size of the block in an extra
+// field of the header). Return `std::nullopt` if the member is not a BGZF
+// block or if `bytes` is too short.
+std::optional<size_t> sizeOfBgzfBlock(std::string_view bytes) {
+  auto byte = [&bytes](size_t i) { return static_cast<uint8_t>(bytes[i]); };
+  // The fixed header (10 bytes), the size of the extra field (2 bytes), and
+  // the `BC` subfield (6 bytes).
+  if (bytes.size() < 18 || byte(0) != 0x1f || byte(1) != 0x8b ||
+      byte(2) != 8 || (byte(3) & 4) == 0) {
+    return std::nullopt;
+  }
+  size_t extraLength = byte(10) | (byte(11) << 8);
+  for (size_t i = 12; i + 6 <= 12 + extraLength && i + 6 <= bytes.size();) {
+    size_t subfieldLength = byte(i + 2) | (byte(i + 3) << 8);
+    if (byte(i) == 'B' && byte(i + 1) == 'C' && subfieldLength == 2) {
+      size_t blockSize = (byte(i + 4) | (byte(i + 5) << 8)) + 1;
+      if (blockSize > bytes.size()) {
+        return std::nullopt;
+      }
+      return blockSize;
+    }
+    i += 4 + subfieldLength;
+  }
+  return std::nullopt;
+}
+
+// Return the size of the independently compressed unit at the beginning of
+// `bytes` (a zstd frame, a BGZF block, or a bzip2 stream), or `std::nullopt`
+// if `bytes` doesn't contain a complete unit (or the units cannot be
+// determined without decompressing, as for ordinary gzip files).
+std::optional<size_t> sizeOfFirstUnit(InputCompression compression,
+                                      std::string_view bytes) {
+  switch (compression) {
+    case InputCompression::Zstd: {
+      auto size = ZSTD_findFrameCompressedSize(bytes.data(), bytes.size());
+      if (ZSTD_isError(size)) {
+        return std::nullopt;
+      }
+      return size;
+    }
+    case InputCompression::Gzip:
+      return sizeOfBgzfBlock(bytes);
+    case InputCompression::Bzip2:
+      // A bzip2 stream ends where the next one starts. The block magic makes
+      // a wrong match extremely unlikely.
+      for (auto pos = bytes.find(bzip2Magic, 1); pos != std::string_view::npos;
+           pos = bytes.find(bzip2Magic, pos + 1)) {
+        if (isBzip2StreamStart(bytes, pos)) {
+          return pos;
+        }
+      }
+      return std::nullopt;
+    default:
+      AD_FAIL();
+  }
+}
+
+// Decompress a complete zstd frame, BGZF block, or bzip2 stream and append the
+// result to the `output`.
+void decompressUnit(InputCompression compression, std::string_view unit,
+                    ZSTD_DCtx* zstdContext, BufferType& output) {
+  constexpr size_t outputIncrement = 1 << 20;
+  if (compression == InputCompression::Zstd) {
+    checkZstdResult(ZSTD_DCtx_reset(zstdContext, ZSTD_reset_session_only));
+    ZSTD_inBuffer input{unit.data(), unit.size(), 0};
+    size_t remaining = 0;
+    while (true) {
+      size_t oldSize = output.size();
+      output.resize(oldSize + outputIncrement);
+      ZSTD_outBuffer out{output.data() + oldSize, outputIncrement, 0};
+      remaining =
+          checkZstdResult(ZSTD_decompressStream(zstdContext, &out, &input));
+      output.resize(oldSize + out.pos);
+      // If the output buffer is full, there might be more data to flush.
+      if (input.pos == input.size && out.pos < out.size) {
+        break;
+      }
+    }
+    if (remaining != 0) {
+      throw std::runtime_error{"The zstd input is truncated"};
+    }
+    return;
+  }
+  io::filtering_istream stream;
+  stream.exceptions(std::ios::badbit);
+  if (compression == InputCompression::Gzip) {
+    stream.push(io::gzip_decompressor{});
+  } else {
+    stream.push(io::bzip2_decompressor{});
+  }
+  stream.push(io::array_source{unit.data(), unit.size()});
+  while (stream) {
+    size_t oldSize = output.size();
+    output.resize(oldSize + outputIncrement);
+    stream.read(output.data() + oldSize, outputIncrement);
+    output.resize(oldSize + stream.gcount());
+  }
+}
+
+// A boost.iostreams source that reads from a file and counts the bytes.
+struct CountingFileSource {
+  using char_type = char;
+  using category = io::source_tag;
+  ad_utility::File* file_;
+  size_t* numBytesRead_;
+  std::streamsize read(char* target, std::streamsize numBytes) {
+    auto numBytesRead = file_->read(target, numBytes);
+    *numBytesRead_ += numBytesRead;
+    return numBytesRead == 0 ? -1 : static_cast<std::streamsize>(numBytesRead);
+  }
+};
+}  // namespace
+
+// The actual decompression. Each call to `decompressNextBatch` returns the next
+// decompressed bytes, or `std::nullopt` if the end of the input is reached.
+class ParallelDecompressingBuffer::Decompressor {
+ protected:
+  ad_utility::File file_;
+  size_t numCompressedBytesRead_ = 0;
+
+ public:
+  explicit Decompressor(ad_utility::File file) : file_{std::move(file)} {}
+  virtual ~Decompressor() = default;
+  virtual std::optional<BufferType> decompressNextBatch() = 0;
+  size_t numCompressedBytesRead() const { return numCompressedBytesRead_; }
+};
+
+namespace {
+using Decompressor = ParallelDecompressingBuffer::Decompressor;
+
+// Decompress a zstd file with a single thread.
+class StreamingZstdDecompressor : public Decompressor {
+  size_t batchSize_;
+  ZstdContext context_ = makeZstdContext();
+  std::vector<char> input_ = std::vector<char>(ZSTD_DStreamInSize());
+  ZSTD_inBuffer inBuffer_{input_.data(), 0, 0};
+  bool fileExhausted_ = false;
+  // The return value of the last call to `ZSTD_decompressStream`, which is
+  // zero iff a frame was completely decompressed.
+  size_t remaining_ = 0;
+
+ public:
+  StreamingZstdDecompressor(ad_utility::File file, size_t batchSize)
+      : Decompressor{std::move(file)}, batchSize_{batchSize} {}
+
+  std::optional<BufferType> decompressNextBatch() override {
+    BufferType result(batchSize_);
+    ZSTD_outBuffer out{result.data(), result.size(), 0};
+    while (out.pos < out.size) {
+      if (inBuffer_.pos == inBuffer_.size && !fileExhausted_) {
+        auto numBytesRead = file_.read(input_.data(), input_.size());
+        numCompressedBytesRead_ += numBytesRead;
+        inBuffer_ = ZSTD_inBuffer{input_.data(), numBytesRead, 0};
+        fileExhausted_ = numBytesRead == 0;
+      }
+      size_t oldPos = out.pos;
+      remaining_ = checkZstdResult(
+          ZSTD_decompressStream(context_.get(), &out, &inBuffer_));
+      // At the end of the file, continue as long as buffered data is flushed.
+      if (fileExhausted_ && out.pos == oldPos) {
+        if (remaining_ != 0) {
+          throw std::runtime_error{"The zstd input is truncated"};
+        }
+        break;
+      }
+    }
+    result.resize(out.pos);
+    if (result.empty()) {
+      return std::nullopt;
+    }
+    return result;
+  }
+};
+
+// Decompress a gzip or bzip2 file with a single thread via boost.iostreams.
+class StreamingBoostDecompressor : public Decompressor {
+  size_t batchSize_;
+  io::filtering_istream stream_;
+
+ public:
+  StreamingBoostDecompressor(ad_utility::File file,
+                             InputCompression compression, size_t batchSize)
+      : Decompressor{std::move(file)}, batchSize_{batchSize} {
+    stream_.exceptions(std::ios::badbit);
+    if (compression == InputCompression::Gzip) {
+      stream_.push(io::gzip_decompressor{});
+    } else {
+      stream_.push(io::bzip2_decompressor{});
+    }
+    stream_.push(CountingFileSource{&file_, &numCompressedBytesRead_});
+  }
+
+  std::optional<BufferType> decompressNextBatch() override {
+    BufferType result(batchSize_);
+    stream_.read(result.data(), result.size());
+    result.resize(stream_.gcount());
+    if (result.empty()) {
+      return std::nullopt;
+    }
+    return result;
+  }
+};
+
+// Decompress a file that consists of many independently compressed units by
+// decompressing the units of each chunk of the compressed input in parallel.
+class ParallelUnitsDecompressor : public Decompressor {
+  InputCompression compression_;
+  size_t numThreads_;
+  size_t compressedChunkSize_;
+  // The compressed bytes that have been read, but not yet decompressed. They
+  // always start at the beginning of a unit.
+  BufferType compressed_;
+  bool fileExhausted_ = false;
+
+ public:
+  ParallelUnitsDecompressor(ad_utility::File file,
+                            InputCompression compression, size_t numThreads,
+                            size_t compressedChunkSize, BufferType firstChunk)
+      : Decompressor{std::move(file)},
+        compression_{compression},
+        numThreads_{std::max(numThreads, size_t{1})},
+        compressedChunkSize_{compressedChunkSize},
+        compressed_{std::move(firstChunk)} {
+    numCompressedBytesRead_ = compressed_.size();
+    fileExhausted_ = compressed_.size() < compressedChunkSize_;
+  }
+
+  std::optional<BufferType> decompressNextBatch() override {
+    while (true) {
+      if (!fileExhausted_) {
+        readNextChunk();
+      }
+      if (compressed_.empty()) {
+        return std::nullopt;
+      }
+      auto units = splitIntoUnits();
+      if (units.empty()) {
+        // The first unit is not complete yet, read more input.
+        if (compressed_.size() > maxUnitSize) {
+          throw std::runtime_error{absl::StrCat(
+              "The compressed input contains an independently compressed "
+              "unit of more than ",
+              ad_utility::MemorySize::bytes(maxUnitSize).asString(),
+              ", which is not supported. Please recompress the input")};
+        }
+        continue;
+      }
+      auto result = decompressInParallel(units);
+      size_t numBytesConsumed = units.back().data() + units.back().size() -
+                                compressed_.data();
+      compressed_.erase(compressed_.begin(),
+                        compressed_.begin() + numBytesConsumed);
+      // Units can be empty (e.g. the skippable frame at the end of a seekable
+      // zstd file).
+      if (!result.empty()) {
+        return result;
+      }
+    }
+  }
+
+ private:
+  // Append the next `compressedChunkSize_` bytes of the file to `compressed_`.
+  void readNextChunk() {
+    size_t oldSize = compressed_.size();
+    compressed_.resize(oldSize + compressedChunkSize_);
+    auto numBytesRead =
+        file_.read(compressed_.data() + oldSize, compressedChunkSize_);
+    compressed_.resize(oldSize + numBytesRead);
+    numCompressedBytesRead_ += numBytesRead;
+    fileExhausted_ = numBytesRead < compressedChunkSize_;
+  }
+
+  // Split `compressed_` into the complete units. At the end of the file, the
+  // remaining bytes form the last unit.
+  std::vector<std::string_view> splitIntoUnits() const {
+    std::vector<std::string_view> units;
+    std::string_view remaining{compressed_.data(), compressed_.size()};
+    while (!remaining.empty()) {
+      auto size = sizeOfFirstUnit(compression_, remaining);
+      if (!size.has_value()) {
+        if (fileExhausted_) {
+          units.push_back(remaining);
+        }
+        break;
+      }
+      units.push_back(remaining.substr(0, size.value()));
+      remaining.remove_prefix(size.value());
+    }
+    return units;
+  }
+
+  // Decompress the `units` with `numThreads_` threads, each of which handles a
+  // contiguous range of the units. Return the concatenation of the results.
+  BufferType decompressInParallel(const std::vector<std::string_view>& units) {
+    size_t numTasks = std::min(numThreads_, units.size());
+    std::vector<BufferType> results(numTasks);
+    std::vector<std::packaged_task<void()>> tasks;
+    for (size_t i = 0; i < numTasks; ++i) {
+      tasks.emplace_back([this, &units, &results, numTasks, i]() {
+        auto context = makeZstdContext();
+        size_t begin = units.size() * i / numTasks;
+        size_t end = units.size() * (i + 1) / numTasks;
+        for (size_t j = begin; j < end; ++j) {
+          decompressUnit(compression_, units[j], context.get(), results[i]);
+        }
+      });
+    }
+    ad_utility::runTasksInParallel(std::move(tasks));
+    if (results.size() == 1) {
+      return std::move(results.front());
+    }
+    BufferType result;
+    for (const auto& part : results) {
+      result.insert(result.end(), part.begin(), part.end());
+    }
+    return result;
+  }
+};
+
+// Create the `Decompressor` for the given file. If the first chunk of the file
+// starts with a complete unit, the `ParallelUnitsDecompressor` is used,
+// otherwise the file is decompressed by a single thread.
+std::unique_ptr<Decompressor> makeDecompressor(const std::string& filename,
+                                               InputCompression compression,
+                                               size_t numThreads,
+                                               size_t compressedChunkSize,
+                                               size_t batchSize) {
+  ad_utility::File file{filename, "r"};
+  BufferType firstChunk(compressedChunkSize);
+  firstChunk.resize(file.read(firstChunk.data(), compressedChunkSize));
+  bool isEntireFile = firstChunk.size() < compressedChunkSize;
+  auto sizeOfFirst = sizeOfFirstUnit(
+      compression, std::string_view{firstChunk.data(), firstChunk.size()});
+  if (sizeOfFirst.has_value() &&
+      (sizeOfFirst.value() < firstChunk.size() || isEntireFile)) {
+    return std::make_unique<ParallelUnitsDecompressor>(
+        std::move(file), compression, numThreads, compressedChunkSize,
+        std::move(firstChunk));
+  }
+  AD_LOG_INFO << "The compressed input file \"" << filename
+              << "\" does not consist of independently compressed units and "
+                 "is therefore decompressed by a single thread"
+              << std::endl;
+  file.seek(0, SEEK_SET);
+  if (compression == InputCompression::Zstd) {
+    return std::make_unique<StreamingZstdDecompressor>(std::move(file),
+                                                       batchSize);
+  }
+  return std::make_unique<StreamingBoostDecompressor>(std::move(file),
+                                                      compression, batchSize);
+}
+}  // namespace
+
+// _____________________________________________________________________________
+InputCompression detectInputCompression(std::string_view firstBytes) {
+  if (ql::starts_with(firstBytes, zstdMagic)) {
+    return InputCompression::Zstd;
+  } else if (ql::starts_with(firstBytes, gzipMagic)) {
+    return InputCompression::Gzip;
+  } else if (ql::starts_with(firstBytes, bzip2Magic) &&
+             firstBytes.size() > 3 && firstBytes[3] >= '1' &&
+             firstBytes[3] <= '9') {
+    return InputCompression::Bzip2;
+  }
+  return InputCompression::None;
+}
+
+// _____________________________________________________________________________
+std::string_view stripCompressionExtension(std::string_view filename) {
+  for (std::string_view extension : {".gz", ".bz2", ".zst"}) {
+    if (ql::ends_with(filename, extension)) {
+      filename.remove_suffix(extension.size());
+      break;
+    }
+  }
+  return filename;
+}
+
+// _____________________________________________________________________________
+ParallelDecompressingBuffer::ParallelDecompressingBuffer(
+    size_t blocksize, const std::string& filename,
+    InputCompression compression, size_t numThreads,
+    size_t compressedChunkSize)
+    : ParallelBuffer{blocksize}, filename_{filename} {
+  AD_CONTRACT_CHECK(compression != InputCompression::None);
+  AD_CONTRACT_CHECK(compressedChunkSize > 0);
+  decompressor_ =
+      makeDecompressor(filename, compression, numThreads, compressedChunkSize,
+                       std::max(blocksize, compressedChunkSize));
+  startNextBatch();
+}
+
+// _____________________________________________________________________________
+ParallelDecompressingBuffer::~ParallelDecompressingBuffer() {
+  // Wait for the asynchronous decompression before destroying the
+  // `decompressor_`.
+  if (nextBatch_.valid()) {
+    nextBatch_.wait();
+  }
+}
+
+// _____________________________________________________________________________
+void ParallelDecompressingBuffer::startNextBatch() {
+  nextBatch_ = std::async(std::launch::async, [this]() {
+    return decompressor_->decompressNextBatch();
+  });
+}
+
+// _____________________________________________________________________________
+std::optional<ParallelBuffer::BufferType>
+ParallelDecompressingBuffer::getNextBlock() {
+  BufferType result;
+  while (result.size() < blocksize_) {
+    if (positionInCurrentBatch_ == currentBatch_.size()) {
+      if (exhausted_) {
+        break;
+      }
+      auto batch = nextBatch_.get();
+      if (!batch.has_value()) {
+        exhausted_ = true;
+        logProgress(true);
+        break;
+      }
+      currentBatch_ = std::move(batch.value());
+      positionInCurrentBatch_ = 0;
+      numBytesDecompressed_ += currentBatch_.size();
+      logProgress(false);
+      startNextBatch();
+    }
+    size_t numBytes = std::min(blocksize_ - result.size(),
+                               currentBatch_.size() - positionInCurrentBatch_);
+    auto begin = currentBatch_.begin() + positionInCurrentBatch_;
+    result.insert(result.end(), begin, begin + numBytes);
+    positionInCurrentBatch_ += numBytes;
+  }
+  if (result.empty()) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+// _____________________________________________________________________________
+void ParallelDecompressingBuffer::logProgress(bool isFinal) {
+  if (!isFinal && numBytesDecompressed_ < nextProgressLog_) {
+    return;
+  }
+  while (nextProgressLog_ <= numBytesDecompressed_) {
+    nextProgressLog_ += progressLogInterval_;
+  }
+  double seconds = std::max(ad_utility::Timer::toSeconds(timer_.value()), 1e-3);
+  auto numCompressedBytes = decompressor_->numCompressedBytesRead();
+  AD_LOG_INFO << "Input file \"" << filename_ << "\": "
+              << ad_utility::MemorySize::bytes(numCompressedBytes).asString()
+              << " compressed, "
+              << ad_utility::MemorySize::bytes(numBytesDecompressed_).asString()
+              << " decompressed, throughput "
+              << static_cast<size_t>(numCompressedBytes / seconds / 1e6)
+              << " MB/s compressed, "
+              << static_cast<size_t>(numBytesDecompressed_ / seconds / 1e6)
+              << " MB/s decompressed" << std::endl;
+}
+
+// _____________________________________________________________________________
+std::unique_ptr<ParallelBuffer> makeParallelBufferForFile(
+    size_t blocksize, const std::string& filename) {
+  auto compression = InputCompression::None;
+  if (std::filesystem::is_regular_file(filename)) {
+    std::ifstream file{filename, std::ios::binary};
+    std::string firstBytes(4, '\0');
+    file.read(firstBytes.data(), firstBytes.size());
+    firstBytes.resize(file.gcount());
+    compression = detectInputCompression(firstBytes);
+  }
+  if (compression == InputCompression::None) {
+    return std::make_unique<ParallelFileBuffer>(blocksize, filename);
+  }
+  return std::make_unique<ParallelDecompressingBuffer>(blocksize, filename,
+                                                       compression);
+}
@@ -0,0 +1,95 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_PARSER_PARALLELDECOMPRESSINGBUFFER_H
+#define QLEVER_SRC_PARSER_PARALLELDECOMPRESSINGBUFFER_H
+
+#include <future>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "parser/ParallelBuffer.h"
+#include "util/Timer.h"
+
+// The compression formats of input files that are decompressed by the
+// `ParallelDecompressingBuffer`.
+enum class InputCompression { None, Gzip, Bzip2, Zstd };
+
+// Detect the compression format from the first bytes of a file.
+InputCompression detectInputCompression(std::string_view firstBytes);
+
+// Remove the extension of a compression format (`.gz`, `.bz2`, or `.zst`)
+// from the `filename` if it has one. This is used to deduce the format of the
+// RDF data from the filename, e.g. `Turtle` for `data.ttl.gz`.
+std::string_view stripCompressionExtension(std::string_view filename);
+
+// A `ParallelBuffer` that reads a compressed file and returns the decompressed
+// bytes in blocks of `blocksize` bytes (except for the last block). The next
+// bytes are decompressed asynchronously while the previous blocks are parsed.
+//
+// If the file consists of many independently compressed units, then these are
+// decompressed in parallel using `numThreads` threads. This is the case for
+// zstd files with many frames (e.g. created by `pzstd` or `zstd -T0 -B`, or in
+// the seekable zstd format), for gzip files in the BGZF format (created by
+// `bgzip`), and for bzip2 files that consist of many streams (created by
+// `pbzip2`). All other files are decompressed by a single thread.
+class ParallelDecompressingBuffer : public ParallelBuffer {
+ public:
+  // The interface for the actual decompression (see the `.cpp` file).
+  class Decompressor;
+
+  // The number of compressed bytes that are read from the file at once.
+  static constexpr size_t defaultCompressedChunkSize_ = 16 << 20;
+
+ private:
+  std::string filename_;
+  std::unique_ptr<Decompressor> decompressor_;
+  // The next batch of decompressed bytes, which is computed asynchronously.
+  std::future<std::optional<BufferType>> nextBatch_;
+  // The current batch of decompressed bytes and the position of the first
+  // byte that has not yet been returned by `getNextBlock`.
+  BufferType currentBatch_;
+  size_t positionInCurrentBatch_ = 0;
+  bool exhausted_ = false;
+
+  // The throughput is logged after each `progressLogInterval_` many
+  // decompressed bytes, and when the end of the input is reached.
+  static constexpr size_t progressLogInterval_ = 10'000'000'000;
+  ad_utility::Timer timer_{ad_utility::Timer::Started};
+  size_t numBytesDecompressed_ = 0;
+  size_t nextProgressLog_ = progressLogInterval_;
+
+ public:
+  ParallelDecompressingBuffer(
+      size_t blocksize, const std::string& filename,
+      InputCompression compression,
+      size_t numThreads = std::thread::hardware_concurrency(),
+      size_t compressedChunkSize = defaultCompressedChunkSize_);
+  ~ParallelDecompressingBuffer() override;
+
+  // _____________________________________________________
+  std::optional<BufferType> getNextBlock() override;
+
+ private:
+  // Start the asynchronous decompression of the next batch.
+  void startNextBatch();
+
+  // Log the number of compressed and decompressed bytes and the throughput.
+  // If `isFinal` is false, only log if the next `progressLogInterval_` has
+  // been reached.
+  void logProgress(bool isFinal);
+};
+
+// Return a `ParallelBuffer` for the file with the given `filename`. If the file
+// is compressed in one of the supported formats, the buffer decompresses it,
+// otherwise it is a `ParallelFileBuffer`. The compression is only detected for
+// regular files, because reading the first bytes of a pipe would consume them.
+std::unique_ptr<ParallelBuffer> makeParallelBufferForFile(
+    size_t blocksize, const std::string& filename);
+
+#endif  // QLEVER_SRC_PARSER_PARALLELDECOMPRESSINGBUFFER_H
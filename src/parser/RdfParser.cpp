@@ -495,6 +495,89 @@ bool NQuadParser<T>::nQuadGraphLabel() {
   return false;
 }
 
+// _____________________________________________________________________________
+template <typename Parser>
+bool NTriplesFastPathParser<Parser>::statement() {
+  return fastPathStatement() || Parser::statement();
+}
+
+// _____________________________________________________________________________
+template <typename Parser>
+bool NTriplesFastPathParser<Parser>::fastPathStatement() {
+  this->tok_.skipWhitespaceAndComments();
+  auto statement =
+      nTriplesScanner::scanStatement(this->tok_.view(), hasGraphLabel);
+  if (!statement.has_value()) {
+    return false;
+  }
+  // Only advance the tokenizer after the conversion, s.t. errors for invalid
+  // literals report the beginning of the statement.
+  const auto& [subject, predicate, object] = statement.value().triple_;
+  TurtleTriple triple{scannedTermToTripleComponent(subject),
+                      scannedTermToTripleComponent(predicate),
+                      scannedTermToTripleComponent(object)};
+  if constexpr (hasGraphLabel) {
+    const auto& graphLabel = statement.value().graphLabel_;
+    triple.graphIri_ = graphLabel.has_value()
+                           ? scannedTermToTripleComponent(graphLabel.value())
+                           : this->defaultGraphId_;
+  } else {
+    triple.graphIri_ = this->defaultGraphIri_;
+  }
+  this->tok_.remove_prefix(statement.value().size_);
+  if (!this->currentTripleIgnoredBecauseOfInvalidLiteral_) {
+    this->triples_.push_back(std::move(triple));
+  }
+  this->currentTripleIgnoredBecauseOfInvalidLiteral_ = false;
+  return true;
+}
+
+// _____________________________________________________________________________
+template <typename Parser>
+TripleComponent NTriplesFastPathParser<Parser>::scannedTermToTripleComponent(
+    const nTriplesScanner::ScannedTerm& term) {
+  using Type = nTriplesScanner::ScannedTerm::Type;
+  auto iriref = [this](std::string_view iriWithBrackets) {
+    return TripleComponent::Iri::fromIrirefConsiderBase(
+        iriWithBrackets, this->baseForRelativeIri(),
+        this->baseForAbsoluteIri());
+  };
+  if (term.type_ == Type::Iriref) {
+    auto iri = iriref(term.text_);
+    // The `TurtleParser` folds IRIs into the ID where possible (see `iri()`),
+    // the `NQuadParser` only parses IRI references.
+    if constexpr (!hasGraphLabel) {
+      auto optId =
+          this->encodedIriManager().encode(iri.toStringRepresentation());
+      if (optId.has_value()) {
+        return optId.value();
+      }
+    }
+    return iri;
+  }
+  if (term.type_ == Type::BlankNodeLabel) {
+    // The same as in `blankNodeLabel()`.
+    return BlankNode{false, absl::StrCat(this->fileBlankNodePrefix_, "_",
+                                         term.text_.substr(2))}
+        .toSparql();
+  }
+  AD_CORRECTNESS_CHECK(term.type_ == Type::Literal);
+  auto literal =
+      term.hasEscapes_
+          ? TripleComponent::Literal::fromEscapedRdfLiteral(term.text_)
+          : TripleComponent::Literal::literalWithNormalizedContent(
+                asNormalizedStringViewUnsafe(
+                    term.text_.substr(1, term.text_.size() - 2)));
+  if (!term.languageTag_.empty()) {
+    literal.addLanguageTag(term.languageTag_);
+  } else if (!term.datatype_.empty()) {
+    this->literalAndDatatypeToTripleComponentImpl(
+        asStringViewUnsafe(literal.getContent()), iriref(term.datatype_));
+    return std::move(this->lastParseResult_);
+  }
+  return literal;
+}
+
 // ______________________________________________________________________
 template <class T>
 bool TurtleParser<T>::rdfLiteralImpl(bool allowMultilineLiterals) {
@@ -1303,9 +1386,11 @@ static std::unique_ptr<RdfParserBase> makeSingleRdfParser(
       [&input, &bufferSize, &graph, ev](
           auto useParallel,
           auto isTurtleInput) -> std::unique_ptr<RdfParserBase> {
-        using InnerParser =
+        // Statements that consist of a single line of N-Triples or N-Quads
+        // (which most large inputs consist of) are parsed by a fast path.
+        using InnerParser = NTriplesFastPathParser<
             std::conditional_t<isTurtleInput == 1, TurtleParser<TokenizerT>,
-                               NQuadParser<TokenizerT>>;
+                               NQuadParser<TokenizerT>>>;
         using Parser =
             std::conditional_t<useParallel == 1, RdfParallelParser<InnerParser>,
                                RdfStreamParser<InnerParser>>;
@@ -1424,3 +1509,21 @@ template class RdfStreamParser<NQuadParser<Tokenizer>>;
 template class RdfStreamParser<NQuadParser<TokenizerCtre>>;
 template class RdfParallelParser<NQuadParser<Tokenizer>>;
 template class RdfParallelParser<NQuadParser<TokenizerCtre>>;
+template class NTriplesFastPathParser<TurtleParser<Tokenizer>>;
+template class NTriplesFastPathParser<TurtleParser<TokenizerCtre>>;
+template class NTriplesFastPathParser<NQuadParser<Tokenizer>>;
+template class NTriplesFastPathParser<NQuadParser<TokenizerCtre>>;
+template class RdfStreamParser<NTriplesFastPathParser<TurtleParser<Tokenizer>>>;
+template class RdfStreamParser<
+    NTriplesFastPathParser<TurtleParser<TokenizerCtre>>>;
+template class RdfParallelParser<
+    NTriplesFastPathParser<TurtleParser<Tokenizer>>>;
+template class RdfParallelParser<
+    NTriplesFastPathParser<TurtleParser<TokenizerCtre>>>;
+template class RdfStreamParser<NTriplesFastPathParser<NQuadParser<Tokenizer>>>;
+template class RdfStreamParser<
+    NTriplesFastPathParser<NQuadParser<TokenizerCtre>>>;
+template class RdfParallelParser<
+    NTriplesFastPathParser<NQuadParser<Tokenizer>>>;
+template class RdfParallelParser<
+    NTriplesFastPathParser<NQuadParser<TokenizerCtre>>>;
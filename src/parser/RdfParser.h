@@ -24,6 +24,7 @@
 #include "index/ConstantsIndexBuilding.h"
 #include "index/EncodedIriManager.h"
 #include "index/InputFileSpecification.h"
+#include "parser/NTriplesScanner.h"
 #include "parser/ParallelBuffer.h"
 #include "parser/TripleComponent.h"
 #include "parser/TurtleTokenId.h"
@@ -34,6 +35,7 @@
 #include "util/ParseException.h"
 #include "util/TaskQueue.h"
 #include "util/ThreadSafeQueue.h"
+#include "util/TypeTraits.h"
 
 enum class TurtleParserIntegerOverflowBehavior {
   Error,
@@ -141,12 +143,13 @@ class TurtleParser : public RdfParserBase {
       const TripleComponent::Iri& typeIri,
       const EncodedIriManager& encodedIriManager);
 
- private:
+ protected:
   // Impl of the method above, also used in rdfLiteral parsing.
   TripleComponent literalAndDatatypeToTripleComponentImpl(
       std::string_view normalizedLiteralContent,
       const TripleComponent::Iri& typeIri);
 
+ private:
   static constexpr std::array<const char*, 12> integerDatatypes_ = {
       XSD_INT_TYPE,
       XSD_INTEGER_TYPE,
@@ -402,11 +405,13 @@ class TurtleParser : public RdfParserBase {
 
 template <class Tokenizer_T>
 class NQuadParser : public TurtleParser<Tokenizer_T> {
-  TripleComponent defaultGraphId_ = qlever::specialIds().at(DEFAULT_GRAPH_IRI);
   TripleComponent activeObject_;
   TripleComponent activeGraphLabel_;
   using Base = TurtleParser<Tokenizer_T>;
 
+ protected:
+  TripleComponent defaultGraphId_ = qlever::specialIds().at(DEFAULT_GRAPH_IRI);
+
  public:
   explicit NQuadParser(const EncodedIriManager* ev) : Base{ev} {};
   explicit NQuadParser(const EncodedIriManager* ev,
@@ -424,6 +429,38 @@ class NQuadParser : public TurtleParser<Tokenizer_T> {
   bool nQuadLiteral();
 };
 
+// A fast path for statements that consist of a single line of N-Triples or
+// N-Quads (like `<s> <p> "o"@en .`), which is the format of many large
+// datasets, for example the N-Triples dumps of Wikidata. The `Parser` is either
+// a `TurtleParser` or an `NQuadParser`. The terms of such statements are found
+// by the `nTriplesScanner` without the regexes of the tokenizer, and escape
+// sequences are only processed for literals that actually contain them. All
+// other statements (and statements that are invalid or incomplete) are passed
+// on to the `statement()` of the `Parser`, so for valid input the result is the
+// same as that of the `Parser` alone.
+template <typename Parser>
+class NTriplesFastPathParser : public Parser {
+  // True iff the statements can have a graph label (as in N-Quads).
+  static constexpr bool hasGraphLabel =
+      ad_utility::isInstantiation<Parser, NQuadParser>;
+
+ public:
+  using Parser::Parser;
+
+ protected:
+  bool statement() override;
+
+ private:
+  // Parse a single statement using the `nTriplesScanner`. Return false and
+  // leave the parser unchanged if this is not possible.
+  bool fastPathStatement();
+
+  // Convert a term that was found by the `nTriplesScanner` in the same way as
+  // the `Parser` would.
+  TripleComponent scannedTermToTripleComponent(
+      const nTriplesScanner::ScannedTerm& term);
+};
+
 /**
  * Parses turtle from std::string. Used to perform unit tests for
  * the different parser rules
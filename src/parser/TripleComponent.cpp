@@ -59,7 +59,10 @@ std::optional<Id> TripleComponent::toValueIdIfNotString(
     if constexpr (std::is_same_v<T, Iri>) {
       return evManager->encode(value.toStringRepresentation());
 
-    } else if constexpr (ad_utility::SameAsAny<T, std::string, Literal>) {
+    } else if constexpr (std::is_same_v<T, Literal>) {
+      // Short literals may be encoded (see `EncodedIriManager`).
+      return evManager->encodeLiteral(value.toStringRepresentation());
+    } else if constexpr (std::is_same_v<T, std::string>) {
       return std::nullopt;
     } else if constexpr (std::is_same_v<T, int64_t>) {
       return Id::makeFromInt(value);
@@ -97,9 +100,12 @@ std::string TripleComponent::toRdfLiteral() const {
     return getIri().toStringRepresentation();
   } else {
     EncodedIriManager ev;
-    auto [value, type] = ql::exportIds::idToStringAndTypeForEncodedValue(
-                             toValueIdIfNotString(&ev).value())
-                             .value();
+    auto id = toValueIdIfNotString(&ev).value();
+    if (id.getDatatype() == Datatype::InlineLiteral) {
+      return id.getInlineLiteral().toStringRepresentation();
+    }
+    auto [value, type] =
+        ql::exportIds::idToStringAndTypeForEncodedValue(id).value();
     return absl::StrCat("\"", value, "\"^^<", type, ">");
   }
 }
@@ -211,8 +211,10 @@ class TripleComponent {
   [[nodiscard]] std::string toRdfLiteral() const;
 
   /// Convert the `TripleComponent` to an ID if it is not a string. In case of a
-  /// string return `std::nullopt`. This is used in `toValueId` below and during
-  /// the index building when we haven't built the vocabulary yet.
+  /// string return `std::nullopt`. IRIs and literals are only converted if
+  /// they can be encoded by the `encodedIriManager`. This is used in
+  /// `toValueId` below and during the index building when we haven't built the
+  /// vocabulary yet.
   [[nodiscard]] std::optional<Id> toValueIdIfNotString(
       const EncodedIriManager* encodedIriManager) const;
 
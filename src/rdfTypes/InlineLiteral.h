@@ -0,0 +1,128 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_RDFTYPES_INLINELITERAL_H
+#define QLEVER_SRC_RDFTYPES_INLINELITERAL_H
+
+#include <absl/strings/str_cat.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "backports/StartsWithAndEndsWith.h"
+#include "backports/three_way_comparison.h"
+#include "util/BitUtils.h"
+
+// A plain literal (without a datatype or a language tag) whose content is so
+// short that it can be stored directly in the data bits of an `Id` (see
+// `Datatype::InlineLiteral`). Such literals (think of country codes, "yes" and
+// "no", or short labels) then need no vocabulary entry, and exporting or
+// comparing them needs no vocabulary lookup.
+//
+// The encoding is as follows: The (UTF-8) bytes of the content are stored
+// left-aligned, the first byte in the most significant bits. Unused bytes are
+// zero, and the `numSizeBits` least significant bits store the number of
+// bytes. The content must not contain zero bytes. This makes sure that the
+// order of the bit representations is the bytewise order of the contents,
+// which for UTF-8 is the order of the Unicode code points. For example,
+// with `maxSize = 7`:
+//
+// ""     ->  0 00 00 00 00 00 00 00 0
+// "a"    ->  0 61 00 00 00 00 00 00 1
+// "ab"   ->  0 61 62 00 00 00 00 00 2
+// "b"    ->  0 62 00 00 00 00 00 00 1
+class InlineLiteral {
+ public:
+  using T = uint64_t;
+  // The number of bits of an `Id` that are available for the encoding.
+  static constexpr T numDataBits = 60;
+  static constexpr T numSizeBits = 4;
+  // The maximal number of bytes of the content.
+  static constexpr size_t maxSize = (numDataBits - numSizeBits) / 8;
+  static_assert(maxSize < (1u << numSizeBits));
+
+ private:
+  T bits_ = 0;
+
+  explicit constexpr InlineLiteral(T bits) : bits_{bits} {}
+
+ public:
+  // The empty literal `""`.
+  constexpr InlineLiteral() = default;
+
+  // Encode the `content` of a plain literal (without the quotes). Return
+  // `std::nullopt` if the content is too long or contains a zero byte.
+  static constexpr std::optional<InlineLiteral> fromContent(
+      std::string_view content) {
+    if (content.size() > maxSize) {
+      return std::nullopt;
+    }
+    T bits = 0;
+    T shift = numDataBits - 8;
+    for (char c : content) {
+      if (c == '\0') {
+        return std::nullopt;
+      }
+      bits |= static_cast<T>(static_cast<uint8_t>(c)) << shift;
+      shift -= 8;
+    }
+    return InlineLiteral{bits | content.size()};
+  }
+
+  // Encode a literal that is given in QLever's internal string representation
+  // (with the quotes, e.g. `"abc"`). Return `std::nullopt` if the literal
+  // has a datatype or a language tag, or if the content cannot be encoded (see
+  // `fromContent`).
+  static constexpr std::optional<InlineLiteral> fromStringRepresentation(
+      std::string_view representation) {
+    // A literal with a datatype or a language tag ends with `>` or with the
+    // tag, so only plain literals start and end with a quote.
+    if (representation.size() < 2 || !ql::starts_with(representation, '"') ||
+        !ql::ends_with(representation, '"')) {
+      return std::nullopt;
+    }
+    return fromContent(representation.substr(1, representation.size() - 2));
+  }
+
+  // The number of bytes of the content.
+  constexpr size_t size() const {
+    return bits_ & ad_utility::bitMaskForLowerBits(numSizeBits);
+  }
+
+  // The content of the literal (without the quotes).
+  std::string content() const {
+    std::string result;
+    result.reserve(size());
+    T shift = numDataBits - 8;
+    for (size_t i = 0; i < size(); ++i) {
+      result.push_back(static_cast<char>((bits_ >> shift) & 0xFF));
+      shift -= 8;
+    }
+    return result;
+  }
+
+  // The literal in QLever's internal string representation (with the quotes).
+  std::string toStringRepresentation() const {
+    return absl::StrCat("\"", content(), "\"");
+  }
+
+  // Conversion from and to the bits that are stored in an `Id`.
+  constexpr T toBitRepresentation() const { return bits_; }
+  static constexpr InlineLiteral fromBitRepresentation(T bits) {
+    return InlineLiteral{bits &
+                         ad_utility::bitMaskForLowerBits(numDataBits)};
+  }
+
+  QL_DEFINE_DEFAULTED_THREEWAY_OPERATOR_LOCAL_CONSTEXPR(InlineLiteral, bits_)
+
+  template <typename H>
+  friend H AbslHashValue(H h, const InlineLiteral& literal) {
+    return H::combine(std::move(h), literal.bits_);
+  }
+};
+
+#endif  // QLEVER_SRC_RDFTYPES_INLINELITERAL_H
@@ -8,6 +8,7 @@
 
 #include <absl/strings/str_cat.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "backports/functional.h"
@@ -40,32 +41,54 @@ class AllocationExceedsLimitException : public std::exception {
 // objects at the same time (hence the wrapper class and the synchronization
 // below).
 class AllocationMemoryLeft {
+ public:
+  using Parent = std::shared_ptr<Synchronized<AllocationMemoryLeft, SpinLock>>;
+
+ private:
   // Remaining free memory.
   MemorySize free_;
+  // An optional pool from which this pool is carved out, e.g. the memory limit
+  // of the whole server for the budget of a single query. Memory is only
+  // available if it is available in this pool and in the parent pool.
+  Parent parent_;
 
  public:
-  AllocationMemoryLeft(MemorySize n) : free_(n) {}
+  AllocationMemoryLeft(MemorySize n, Parent parent = nullptr)
+      : free_(n), parent_{std::move(parent)} {}
 
   // Called before memory is allocated.
   bool decrease_if_enough_left_or_return_false(MemorySize n) noexcept {
-    if (n <= free_) {
-      free_ -= n;
-      return true;
-    } else {
+    if (n > free_) {
       return false;
     }
+    if (parent_ &&
+        !parent_->wlock()->decrease_if_enough_left_or_return_false(n)) {
+      return false;
+    }
+    free_ -= n;
+    return true;
   }
 
   // Called before memory is allocated.
   void decrease_if_enough_left_or_throw(MemorySize n) {
     if (!decrease_if_enough_left_or_return_false(n)) {
-      throw AllocationExceedsLimitException{n, free_};
+      throw AllocationExceedsLimitException{n, amountMemoryLeft()};
     }
   }
 
   // Called after memory is deallocated.
-  void increase(MemorySize n) { free_ += n; }
-  [[nodiscard]] MemorySize amountMemoryLeft() const { return free_; }
+  void increase(MemorySize n) {
+    free_ += n;
+    if (parent_) {
+      parent_->wlock()->increase(n);
+    }
+  }
+  [[nodiscard]] MemorySize amountMemoryLeft() const {
+    if (!parent_) {
+      return free_;
+    }
+    return std::min(free_, parent_->wlock()->amountMemoryLeft());
+  }
 };
 
 /*
@@ -100,6 +123,18 @@ makeAllocationMemoryLeftThreadsafeObject(MemorySize n) {
       ad_utility::Synchronized<detail::AllocationMemoryLeft, SpinLock>>(n)};
 }
 
+// Set up a shared allocation state with at most `n` bytes, which is carved out
+// of the `parent` state: every allocation also counts towards the limit of the
+// `parent` and only succeeds if the memory is available in both.
+inline detail::AllocationMemoryLeftThreadsafe
+makeAllocationMemoryLeftThreadsafeObject(
+    MemorySize n, const detail::AllocationMemoryLeftThreadsafe& parent) {
+  return detail::AllocationMemoryLeftThreadsafe{
+      std::make_shared<
+          ad_utility::Synchronized<detail::AllocationMemoryLeft, SpinLock>>(
+          n, parent.ptr())};
+}
+
 /*
 A lambda for use with `AllocatorWithLimit`.
 
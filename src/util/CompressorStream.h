@@ -13,15 +13,102 @@
 #endif
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
+#include <chrono>
+#include <deque>
+#include <future>
 #include <string>
 
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
 #include "util/Generator.h"
+#include "util/MemorySize/MemorySize.h"
+#include "util/TaskQueue.h"
 #include "util/http/ContentEncodingHelper.h"
 
 namespace ad_utility::streams {
 namespace io = boost::iostreams;
 using ad_utility::content_encoding::CompressionMethod;
 
+// The parameters of `compressStreamZstd` below.
+struct ZstdStreamOptions {
+  // The input is compressed in batches of (at least) this size.
+  MemorySize batchSize_ = MemorySize::megabytes(1);
+  // The maximal number of batches of a single stream that are compressed or
+  // wait to be yielded at the same time.
+  size_t queueSize_ = 8;
+  int compressionLevel_ = 3;
+};
+
+// The number of threads that compress the batches of all streams from
+// `compressStreamZstd` together.
+static constexpr size_t ZSTD_COMPRESSION_NUM_THREADS = 4;
+
+// The process-wide pool of threads for `compressStreamZstd`. It is shared by
+// all streams, s.t. the number of compression threads does not grow with the
+// number of concurrent responses.
+inline ad_utility::TaskQueue<false>& zstdCompressionThreadPool() {
+  static ad_utility::TaskQueue<false> pool{
+      4 * ZSTD_COMPRESSION_NUM_THREADS, ZSTD_COMPRESSION_NUM_THREADS,
+      "zstd compression of streams"};
+  return pool;
+}
+
+/**
+ * Takes a range of strings and yields the zstd compression of the
+ * concatenation of all the strings. The input is split into batches, each of
+ * which is compressed to an independent zstd frame on the
+ * `zstdCompressionThreadPool`, so the compression is pipelined with the
+ * creation of the input and runs in parallel. The concatenation of the frames
+ * (which are yielded in order) is a valid zstd stream.
+ */
+template <typename Range>
+cppcoro::generator<std::string> compressStreamZstd(
+    Range range, ZstdStreamOptions options = {}) {
+  AD_CONTRACT_CHECK(options.queueSize_ > 0);
+  // The frames of the batches that were handed to the thread pool, in the
+  // order of the input. The tasks own their batch, so it is safe to destroy
+  // this generator before all of them have finished.
+  std::deque<std::future<std::string>> frames;
+  auto compressBatch = [&frames, level = options.compressionLevel_](
+                           std::string batch) {
+    std::packaged_task<std::string()> task{
+        [batch = std::move(batch), level]() {
+          auto frame = ZstdWrapper::compress(batch.data(), batch.size(), level);
+          return std::string(frame.begin(), frame.end());
+        }};
+    frames.push_back(task.get_future());
+    zstdCompressionThreadPool().push(std::move(task));
+  };
+  auto frontIsReady = [&frames]() {
+    return frames.front().wait_for(std::chrono::seconds{0}) ==
+           std::future_status::ready;
+  };
+
+  std::string batch;
+  for (const auto& value : range) {
+    batch.append(value);
+    if (batch.size() < options.batchSize_.getBytes()) {
+      continue;
+    }
+    compressBatch(std::exchange(batch, {}));
+    // Yield the frames that are already finished, and wait for the oldest one
+    // if the maximal number of batches is in flight.
+    while (!frames.empty() &&
+           (frames.size() >= options.queueSize_ || frontIsReady())) {
+      auto frame = frames.front().get();
+      frames.pop_front();
+      co_yield frame;
+    }
+  }
+  if (!batch.empty()) {
+    compressBatch(std::move(batch));
+  }
+  while (!frames.empty()) {
+    auto frame = frames.front().get();
+    frames.pop_front();
+    co_yield frame;
+  }
+}
+
 /**
  * Takes a range of strings. Behavior: The concatenation of all yielded strings
  * is the compression, specified by the `compressionMethod` applied to the
@@ -30,6 +117,12 @@ using ad_utility::content_encoding::CompressionMethod;
 template <typename Range>
 cppcoro::generator<std::string> compressStream(
     Range range, CompressionMethod compressionMethod) {
+  if (compressionMethod == CompressionMethod::ZSTD) {
+    for (auto& frame : compressStreamZstd(std::move(range))) {
+      co_yield frame;
+    }
+    co_return;
+  }
   // NOTE: `stringBuffer` must be declared before `filteringStream` so that it
   // is destroyed after it. The `filteringStream` holds a reference to
   // `stringBuffer` via `io::back_inserter`. If the coroutine is destroyed
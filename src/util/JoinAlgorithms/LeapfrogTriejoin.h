@@ -0,0 +1,239 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_JOINALGORITHMS_LEAPFROGTRIEJOIN_H
+#define QLEVER_SRC_UTIL_JOINALGORITHMS_LEAPFROGTRIEJOIN_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "backports/span.h"
+#include "util/Exception.h"
+#include "util/TransparentFunctors.h"
+
+namespace ad_utility {
+
+// A single input of the `leapfrogTriejoin` below. The relation consists of
+// `columns_.size()` columns of equal length, where `columns_[i]` stores the
+// values of the (global) variable with index `variables_[i]`. The
+// `variables_` must be strictly increasing and the rows of the relation must
+// be sorted lexicographically by the columns in this order. This is exactly
+// the format of an index scan that reads its variables in permutation order.
+template <typename T>
+struct LeapfrogRelation {
+  std::vector<ql::span<const T>> columns_;
+  std::vector<size_t> variables_;
+
+  size_t numRows() const { return columns_.empty() ? 0 : columns_[0].size(); }
+};
+
+namespace detail {
+
+// Return the first index `i` in `[begin, end)` with `column[i] >= value`, or
+// `end` if there is no such index. Start with exponentially growing steps
+// from `begin` (galloping search), because in the leapfrog join most seeks
+// only move a short distance.
+template <typename T, typename Less>
+size_t gallopingLowerBound(ql::span<const T> column, size_t begin, size_t end,
+                           const T& value, const Less& less) {
+  size_t step = 1;
+  size_t lo = begin;
+  size_t hi = begin;
+  while (hi < end && less(column[hi], value)) {
+    lo = hi + 1;
+    hi = begin + step;
+    step *= 2;
+  }
+  hi = std::min(hi, end);
+  return static_cast<size_t>(
+      std::lower_bound(column.begin() + lo, column.begin() + hi, value, less) -
+      column.begin());
+}
+
+// Same as `gallopingLowerBound`, but return the first index with
+// `column[i] > value`.
+template <typename T, typename Less>
+size_t gallopingUpperBound(ql::span<const T> column, size_t begin, size_t end,
+                           const T& value, const Less& less) {
+  auto lessEqual = [&less](const T& a, const T& b) { return !less(b, a); };
+  return gallopingLowerBound(column, begin, end, value, lessEqual);
+}
+
+// The state of a single `leapfrogTriejoin` call. See the documentation there
+// for the semantics.
+template <typename T, typename Less, typename OnResult,
+          typename CheckCancellation>
+class LeapfrogTriejoinImpl {
+  // A half-open range of rows `[first, second)`.
+  using Range = std::pair<size_t, size_t>;
+
+  const std::vector<LeapfrogRelation<T>>& relations_;
+  size_t numVariables_;
+  const Less& less_;
+  const OnResult& onResult_;
+  const CheckCancellation& checkCancellation_;
+
+  // For each variable, the indices of the relations that contain it, as well
+  // as the index of the column of the variable inside those relations.
+  std::vector<std::vector<std::pair<size_t, size_t>>> participants_;
+  // For each relation the stack of ranges. The top of the stack is the range
+  // of rows that is consistent with all the variables bound so far.
+  std::vector<std::vector<Range>> rangeStacks_;
+  // Per level the current positions of the participating relations. They are
+  // preallocated to avoid allocations in the recursion.
+  std::vector<std::vector<size_t>> positions_;
+  // The values of the currently bound variables.
+  std::vector<T> currentTuple_;
+
+ public:
+  LeapfrogTriejoinImpl(const std::vector<LeapfrogRelation<T>>& relations,
+                       size_t numVariables, const Less& less,
+                       const OnResult& onResult,
+                       const CheckCancellation& checkCancellation)
+      : relations_{relations},
+        numVariables_{numVariables},
+        less_{less},
+        onResult_{onResult},
+        checkCancellation_{checkCancellation},
+        participants_(numVariables),
+        rangeStacks_(relations.size()),
+        positions_(numVariables),
+        currentTuple_(numVariables) {
+    for (size_t r = 0; r < relations_.size(); ++r) {
+      const auto& relation = relations_[r];
+      AD_CONTRACT_CHECK(!relation.variables_.empty());
+      AD_CONTRACT_CHECK(relation.variables_.size() == relation.columns_.size());
+      for (size_t c = 0; c < relation.variables_.size(); ++c) {
+        auto var = relation.variables_[c];
+        AD_CONTRACT_CHECK(var < numVariables_);
+        AD_CONTRACT_CHECK(c == 0 || relation.variables_[c - 1] < var,
+                          "The variables of a relation must be sorted");
+        AD_CONTRACT_CHECK(relation.columns_[c].size() == relation.numRows());
+        participants_[var].emplace_back(r, c);
+      }
+      rangeStacks_[r].reserve(relation.variables_.size() + 1);
+      rangeStacks_[r].emplace_back(0, relation.numRows());
+    }
+    for (size_t var = 0; var < numVariables_; ++var) {
+      AD_CONTRACT_CHECK(!participants_[var].empty(),
+                        "Each variable must occur in at least one relation");
+      positions_[var].resize(participants_[var].size());
+    }
+  }
+
+  // Run the join. Can only be called once.
+  void run() { join(0); }
+
+ private:
+  // Enumerate all the values of the variable `level` that occur in all the
+  // participating relations (restricted to the current ranges), and recurse
+  // to the next level for each of them.
+  void join(size_t level) {
+    if (level == numVariables_) {
+      // All variables are bound, so all the rows in the current range of each
+      // relation are identical. The number of result rows is the product of
+      // the sizes of these ranges.
+      size_t multiplicity = 1;
+      for (const auto& stack : rangeStacks_) {
+        multiplicity *= stack.back().second - stack.back().first;
+      }
+      onResult_(std::as_const(currentTuple_), multiplicity);
+      return;
+    }
+    checkCancellation_();
+    const auto& participants = participants_[level];
+    auto& positions = positions_[level];
+    auto column = [this, &participants](size_t i) {
+      auto [r, c] = participants[i];
+      return relations_[r].columns_[c];
+    };
+    auto end = [this, &participants](size_t i) {
+      return rangeStacks_[participants[i].first].back().second;
+    };
+    for (size_t i = 0; i < participants.size(); ++i) {
+      positions[i] = rangeStacks_[participants[i].first].back().first;
+      if (positions[i] == end(i)) {
+        return;
+      }
+    }
+
+    while (true) {
+      // Leapfrog: Seek all the relations to the currently largest value until
+      // they all agree.
+      const T* maxValue = &column(0)[positions[0]];
+      for (size_t i = 1; i < participants.size(); ++i) {
+        const T& value = column(i)[positions[i]];
+        if (less_(*maxValue, value)) {
+          maxValue = &value;
+        }
+      }
+      bool allEqual = true;
+      for (size_t i = 0; i < participants.size(); ++i) {
+        auto col = column(i);
+        if (less_(col[positions[i]], *maxValue)) {
+          positions[i] =
+              gallopingLowerBound(col, positions[i], end(i), *maxValue, less_);
+          if (positions[i] == end(i)) {
+            return;
+          }
+          if (less_(*maxValue, col[positions[i]])) {
+            allEqual = false;
+          }
+        }
+      }
+      if (!allEqual) {
+        continue;
+      }
+
+      // All relations agree on `value`, narrow their ranges, recurse, and
+      // afterwards continue with the rows after the current value.
+      currentTuple_[level] = *maxValue;
+      bool atEnd = false;
+      for (size_t i = 0; i < participants.size(); ++i) {
+        auto upper = gallopingUpperBound(column(i), positions[i], end(i),
+                                         currentTuple_[level], less_);
+        rangeStacks_[participants[i].first].emplace_back(positions[i], upper);
+      }
+      join(level + 1);
+      for (size_t i = 0; i < participants.size(); ++i) {
+        auto& stack = rangeStacks_[participants[i].first];
+        positions[i] = stack.back().second;
+        stack.pop_back();
+        atEnd = atEnd || positions[i] == end(i);
+      }
+      if (atEnd) {
+        return;
+      }
+    }
+  }
+};
+}  // namespace detail
+
+// Compute the natural join of the `relations` using the leapfrog triejoin
+// algorithm (Veldhuizen, 2014), which is worst-case optimal for arbitrary
+// (in particular cyclic) join queries. The variables are numbered
+// `0, ..., numVariables - 1` and bound in this order; for the requirements on
+// the relations see `LeapfrogRelation` above. For each result tuple (in
+// lexicographical order) `onResult(tuple, multiplicity)` is called, where
+// `tuple[i]` is the value of variable `i`, and `multiplicity` is the number of
+// times the tuple occurs in the result (the product of its multiplicities in
+// the inputs). `checkCancellation` is called regularly.
+template <typename T, typename OnResult, typename Less = std::less<>,
+          typename CheckCancellation = ad_utility::Noop>
+void leapfrogTriejoin(const std::vector<LeapfrogRelation<T>>& relations,
+                      size_t numVariables, const OnResult& onResult,
+                      const Less& less = {},
+                      const CheckCancellation& checkCancellation = {}) {
+  detail::LeapfrogTriejoinImpl<T, Less, OnResult, CheckCancellation> impl{
+      relations, numVariables, less, onResult, checkCancellation};
+  impl.run();
+}
+
+}  // namespace ad_utility
+
+#endif  // QLEVER_SRC_UTIL_JOINALGORITHMS_LEAPFROGTRIEJOIN_H
@@ -0,0 +1,86 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#ifndef QLEVER_SRC_UTIL_SHARDEDLRUCACHE_H
+#define QLEVER_SRC_UTIL_SHARDEDLRUCACHE_H
+
+#include <absl/hash/hash.h>
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "util/LruCache.h"
+
+namespace ad_utility::util {
+
+// A thread-safe LRU cache. The keys are distributed over `numShards` many
+// `LRUCache`s (by their hash), each of which is protected by its own mutex, so
+// that concurrent accesses to different keys rarely block each other. Each of
+// the shards evicts its least recently used element independently, so the
+// eviction order is only approximately LRU.
+template <typename K, typename V>
+class ShardedLRUCache {
+ private:
+  struct Shard {
+    std::mutex mutex_;
+    LRUCache<K, V> cache_;
+    explicit Shard(size_t capacity) : cache_{capacity} {}
+  };
+  // The shards are stored via `unique_ptr`s to keep this class movable.
+  std::vector<std::unique_ptr<Shard>> shards_;
+
+ public:
+  // Create a cache for (approximately) `capacity` many elements in total.
+  explicit ShardedLRUCache(size_t capacity, size_t numShards = 16) {
+    AD_CONTRACT_CHECK(numShards > 0, "The number of shards must be positive");
+    AD_CONTRACT_CHECK(capacity >= numShards,
+                      "The capacity must be at least the number of shards");
+    shards_.reserve(numShards);
+    for (size_t i = 0; i < numShards; ++i) {
+      shards_.push_back(std::make_unique<Shard>(capacity / numShards));
+    }
+  }
+
+  // Return a copy of the value for the `key` if it is contained in the cache,
+  // and mark it as most recently used. Return `std::nullopt` otherwise.
+  std::optional<V> tryGet(const K& key) {
+    auto& shard = getShard(key);
+    std::lock_guard lock{shard.mutex_};
+    auto value = shard.cache_.tryGet(key);
+    if (!value) {
+      return std::nullopt;
+    }
+    return value.value();
+  }
+
+  // Store the `value` for the `key` (unless the `key` is already contained),
+  // and evict the least recently used element of the shard if necessary.
+  void insert(const K& key, V value) {
+    auto& shard = getShard(key);
+    std::lock_guard lock{shard.mutex_};
+    shard.cache_.getOrCompute(key, [&value](const K&) -> V {
+      return std::move(value);
+    });
+  }
+
+  // Remove all elements from the cache.
+  void clear() {
+    for (auto& shard : shards_) {
+      std::lock_guard lock{shard->mutex_};
+      shard->cache_ = LRUCache<K, V>{shard->cache_.capacity()};
+    }
+  }
+
+ private:
+  Shard& getShard(const K& key) {
+    return *shards_[absl::HashOf(key) % shards_.size()];
+  }
+};
+
+}  // namespace ad_utility::util
+
+#endif  // QLEVER_SRC_UTIL_SHARDEDLRUCACHE_H
@@ -12,12 +12,13 @@
 
 namespace ad_utility::content_encoding {
 
-enum class CompressionMethod { NONE, DEFLATE, GZIP };
+enum class CompressionMethod { NONE, DEFLATE, GZIP, ZSTD };
 
 namespace detail {
 
 constexpr std::string_view DEFLATE = "deflate";
 constexpr std::string_view GZIP = "gzip";
+constexpr std::string_view ZSTD = "zstd";
 
 inline CompressionMethod getCompressionMethodFromAcceptEncodingHeader(
     std::vector<std::string_view> acceptedEncodings) {
@@ -25,7 +26,11 @@ inline CompressionMethod getCompressionMethodFromAcceptEncodingHeader(
     return std::find(acceptedEncodings.begin(), acceptedEncodings.end(),
                      value) != acceptedEncodings.end();
   };
-  if (contains(DEFLATE)) {
+  // Zstd is preferred, because it is faster and compresses better, and
+  // because the server can compress the response in parallel.
+  if (contains(ZSTD)) {
+    return CompressionMethod::ZSTD;
+  } else if (contains(DEFLATE)) {
     return CompressionMethod::DEFLATE;
   } else if (contains(GZIP)) {
     return CompressionMethod::GZIP;
@@ -62,6 +67,8 @@ void setContentEncodingHeaderForCompressionMethod(
     header.insert(field::content_encoding, detail::DEFLATE);
   } else if (method == CompressionMethod::GZIP) {
     header.insert(field::content_encoding, detail::GZIP);
+  } else if (method == CompressionMethod::ZSTD) {
+    header.insert(field::content_encoding, detail::ZSTD);
   }
 }
 
@@ -77,6 +84,9 @@ inline std::ostream& operator<<(std::ostream& out,
     case CompressionMethod::GZIP:
       out << "CompressionMethod::GZIP";
       break;
+    case CompressionMethod::ZSTD:
+      out << "CompressionMethod::ZSTD";
+      break;
   }
   return out;
 }
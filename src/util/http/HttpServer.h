@@ -263,6 +263,12 @@ CPP_template(typename HttpHandler, typename WebSocketHandler)(
         co_await http::async_read(stream, buffer, requestParser,
                                   boost::asio::use_awaitable);
         http::request<http::string_body> req = requestParser.release();
+        beast::error_code remoteEndpointError;
+        auto remoteEndpoint =
+            stream.socket().remote_endpoint(remoteEndpointError);
+        req.set(ad_utility::httpUtils::REMOTE_ADDRESS_HEADER,
+                remoteEndpointError ? std::string{}
+                                    : remoteEndpoint.address().to_string());
 
         // Let request be handled by `WebSocketSession` if the HTTP
         // request is a WebSocket handshake
@@ -79,6 +79,12 @@ class Url {
                                               target_)
 };
 
+// The header that the `HttpServer` sets for each request to the IP address of
+// the remote endpoint of its connection. A header with the same name that is
+// sent by the client is replaced, so the value can't be spoofed.
+static constexpr std::string_view REMOTE_ADDRESS_HEADER =
+    "QLever-Remote-Address";
+
 // A concept for `http::request`
 namespace detail {
 template <typename T>
@@ -57,6 +57,46 @@ TEST(AllocatorWithLimit, vectorShared) {
                ad_utility::detail::AllocationExceedsLimitException);
 }
 
+// _____________________________________________________________________________
+TEST(AllocatorWithLimit, memoryCarvedOutOfParent) {
+  auto parent = makeAllocationMemoryLeftThreadsafeObject(3_MB);
+  AllocatorWithLimit<int> parentAllocator{parent};
+  AllocatorWithLimit<int> child1{
+      makeAllocationMemoryLeftThreadsafeObject(2_MB, parent)};
+  AllocatorWithLimit<int> child2{
+      makeAllocationMemoryLeftThreadsafeObject(2_MB, parent)};
+  EXPECT_NE(child1, parentAllocator);
+
+  // The allocation counts towards the child and the parent.
+  auto ptr1 = child1.allocate(375'000);
+  EXPECT_EQ(child1.amountMemoryLeft(), 500_kB);
+  EXPECT_EQ(parentAllocator.amountMemoryLeft(), 1500_kB);
+
+  // The limit of the child is exceeded.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      child1.allocate(250'000),
+      ::testing::StrEq(
+          "Tried to allocate 1 MB, but only 500 kB were available"));
+  EXPECT_EQ(parentAllocator.amountMemoryLeft(), 1500_kB);
+
+  // The limit of the parent is exceeded, although the child has enough memory
+  // left.
+  EXPECT_EQ(child2.amountMemoryLeft(), 1500_kB);
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      child2.allocate(500'000),
+      ::testing::StrEq(
+          "Tried to allocate 2 MB, but only 1.5 MB were available"));
+  EXPECT_EQ(child2.amountMemoryLeft(), 1500_kB);
+
+  // Deallocating frees the memory in both pools.
+  child1.deallocate(ptr1, 375'000);
+  EXPECT_EQ(child1.amountMemoryLeft(), 2_MB);
+  EXPECT_EQ(parentAllocator.amountMemoryLeft(), 3_MB);
+  auto ptr2 = child2.allocate(500'000);
+  EXPECT_EQ(parentAllocator.amountMemoryLeft(), 1_MB);
+  child2.deallocate(ptr2, 500'000);
+}
+
 TEST(AllocatorWithLimit, equality) {
   AllocatorWithLimit<int> a1{
       ad_utility::makeAllocationMemoryLeftThreadsafeObject(20_B)};
@@ -0,0 +1,200 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include "engine/CacheWarmup.h"
+#include "util/File.h"
+#include "util/GTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
+
+using Entry = CacheWarmup::Entry;
+using namespace std::chrono_literals;
+
+namespace {
+// A `ReplayQuery` function that must not be called.
+void noReplay(const std::string&, ad_utility::SharedCancellationHandle) {
+  ADD_FAILURE() << "No query should be replayed";
+}
+
+// Remove the file with the given name (and its temporary file) when the test
+// ends.
+struct RemoveFile {
+  std::string filename_;
+  ~RemoveFile() {
+    std::filesystem::remove(filename_);
+    std::filesystem::remove(filename_ + ".tmp");
+  }
+};
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, recordAndSave) {
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::cacheWarmupSaveInterval_>(0s);
+  std::string filename = "CacheWarmupTest.recordAndSave.json";
+  RemoveFile removeFile{filename};
+  {
+    CacheWarmup warmup{filename, &noReplay};
+    warmup.recordQuery("a", 10ms);
+    warmup.recordQuery("b", 5ms);
+    warmup.recordQuery("b", 1ms);
+    warmup.recordQuery("c", 20ms);
+    // The queries that are executed more often are hotter, the total time
+    // breaks ties.
+    std::vector<Entry> expected{{"b", 2, 6ms}, {"c", 1, 20ms}, {"a", 1, 10ms}};
+    EXPECT_EQ(warmup.hottestQueries(10), expected);
+    expected.resize(2);
+    EXPECT_EQ(warmup.hottestQueries(2), expected);
+    // Nothing is saved before the `warmup` is destroyed.
+    EXPECT_FALSE(std::filesystem::exists(filename));
+  }
+  std::vector<Entry> expected{{"b", 2, 6ms}, {"c", 1, 20ms}, {"a", 1, 10ms}};
+  EXPECT_EQ(CacheWarmup::readFromFile(filename), expected);
+
+  // Only the configured number of queries is saved.
+  auto numQueries =
+      setRuntimeParameterForTest<&RuntimeParameters::cacheWarmupNumQueries_>(1);
+  {
+    auto replay = [](const std::string&,
+                     ad_utility::SharedCancellationHandle) {};
+    CacheWarmup warmup{filename, replay};
+    warmup.recordQuery("c", 1ms);
+  }
+  expected = {{"c", 2, 21ms}};
+  EXPECT_EQ(CacheWarmup::readFromFile(filename), expected);
+}
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, replayOnStartup) {
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::cacheWarmupSaveInterval_>(0s);
+  std::string filename = "CacheWarmupTest.replayOnStartup.json";
+  RemoveFile removeFile{filename};
+  {
+    CacheWarmup warmup{filename, &noReplay};
+    warmup.recordQuery("cold", 1ms);
+    warmup.recordQuery("failing", 1ms);
+    warmup.recordQuery("failing", 1ms);
+    warmup.recordQuery("hot", 1ms);
+    warmup.recordQuery("hot", 1ms);
+    warmup.recordQuery("hot", 1ms);
+  }
+
+  // The queries are replayed in the background, the hottest first. A query
+  // that fails doesn't stop the replay.
+  std::mutex mutex;
+  std::vector<std::string> replayed;
+  std::promise<void> done;
+  auto replay = [&](const std::string& query,
+                    ad_utility::SharedCancellationHandle) {
+    std::lock_guard lock{mutex};
+    replayed.push_back(query);
+    if (query == "failing") {
+      throw std::runtime_error("Query failed");
+    }
+    if (query == "cold") {
+      done.set_value();
+    }
+  };
+  {
+    CacheWarmup warmup{filename, replay};
+    done.get_future().wait();
+    // The replayed queries are still considered hot.
+    warmup.recordQuery("new", 1ms);
+    std::vector<Entry> expected{
+        {"hot", 3, 3ms}, {"failing", 2, 2ms}, {"cold", 1, 1ms}};
+    EXPECT_EQ(warmup.hottestQueries(3), expected);
+  }
+  EXPECT_THAT(replayed, ::testing::ElementsAre("hot", "failing", "cold"));
+  EXPECT_EQ(CacheWarmup::readFromFile(filename).size(), 4u);
+}
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, eachReplayedQueryHasItsOwnCancellationHandle) {
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::cacheWarmupSaveInterval_>(0s);
+  std::string filename =
+      "CacheWarmupTest.eachReplayedQueryHasItsOwnCancellationHandle.json";
+  RemoveFile removeFile{filename};
+  {
+    CacheWarmup warmup{filename, &noReplay};
+    warmup.recordQuery("timeout", 1ms);
+    warmup.recordQuery("timeout", 1ms);
+    warmup.recordQuery("running", 1ms);
+  }
+
+  // A query that times out doesn't stop the replay, and the query that is
+  // replayed when the `CacheWarmup` is destroyed is cancelled.
+  std::promise<void> started;
+  auto replay = [&](const std::string& query,
+                    ad_utility::SharedCancellationHandle handle) {
+    EXPECT_FALSE(handle->isCancelled());
+    if (query == "timeout") {
+      handle->cancel(ad_utility::CancellationState::TIMEOUT);
+    } else {
+      started.set_value();
+      while (!handle->isCancelled()) {
+        std::this_thread::sleep_for(1ms);
+      }
+    }
+    handle->throwIfCancelled();
+  };
+  {
+    CacheWarmup warmup{filename, replay};
+    started.get_future().wait();
+  }
+}
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, coldQueriesAreRemoved) {
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::cacheWarmupSaveInterval_>(0s);
+  auto numQueries =
+      setRuntimeParameterForTest<&RuntimeParameters::cacheWarmupNumQueries_>(1);
+  std::string filename = "CacheWarmupTest.coldQueriesAreRemoved.json";
+  RemoveFile removeFile{filename};
+  CacheWarmup warmup{filename, &noReplay};
+  warmup.recordQuery("hot", 1ms);
+  warmup.recordQuery("hot", 1ms);
+  // At most ten times the number of saved queries are recorded.
+  for (size_t i = 0; i < 9; ++i) {
+    warmup.recordQuery(absl::StrCat("cold", i), 1ms);
+  }
+  EXPECT_EQ(warmup.hottestQueries(100).size(), 10u);
+  warmup.recordQuery("cold9", 1ms);
+  std::vector<Entry> expected{{"hot", 2, 2ms}};
+  EXPECT_EQ(warmup.hottestQueries(100), expected);
+}
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, disabled) {
+  auto numQueries =
+      setRuntimeParameterForTest<&RuntimeParameters::cacheWarmupNumQueries_>(0);
+  std::string filename = "CacheWarmupTest.disabled.json";
+  RemoveFile removeFile{filename};
+  {
+    CacheWarmup warmup{filename, &noReplay};
+    warmup.recordQuery("a", 1ms);
+    EXPECT_TRUE(warmup.hottestQueries(10).empty());
+  }
+  EXPECT_FALSE(std::filesystem::exists(filename));
+}
+
+// _____________________________________________________________________________
+TEST(CacheWarmup, invalidFile) {
+  std::string filename = "CacheWarmupTest.invalidFile.json";
+  RemoveFile removeFile{filename};
+  EXPECT_TRUE(CacheWarmup::readFromFile(filename).empty());
+  ad_utility::makeOfstream(filename) << R"({"version": 0, "queries": []})";
+  AD_EXPECT_THROW_WITH_MESSAGE(CacheWarmup::readFromFile(filename),
+                               ::testing::HasSubstr("format version 0"));
+}
@@ -4,16 +4,21 @@
 
 #include <gtest/gtest.h>
 
+#include <array>
+#include <filesystem>
+#include <future>
 #include <thread>
 
 #include "./util/GTestHelpers.h"
 #include "./util/IdTableHelpers.h"
 #include "index/CompressedRelation.h"
+#include "index/ConstantsIndexBuilding.h"
 #include "index/IndexImpl.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OnDestructionDontThrowDuringStackUnwinding.h"
 #include "util/RuntimeParametersTestHelpers.h"
 #include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/FileSerializer.h"
 #include "util/SourceLocation.h"
 
 namespace {
@@ -170,9 +175,9 @@ compressedRelationTestWriteCompressedRelations(
     }
   };
 
-  // First create the on-disk permutation.
+  // First create the on-disk permutation (with zone maps).
   auto writer = std::make_unique<CompressedRelationWriter>(
-      numColumns, ad_utility::File{filename, "w"}, blocksize);
+      numColumns, ad_utility::File{filename, "w"}, blocksize, true);
   std::vector<CompressedRelationMetadata> metaData;
   CompressedRelationWriter::WriterAndCallback wc1{
       std::move(writer),
@@ -207,7 +212,10 @@ namespace {
 // persistent index files that are created for these tests.
 auto makeCleanup(std::string filename) {
   return ad_utility::makeOnDestructionDontThrowDuringStackUnwinding(
-      [filename = std::move(filename)] { ad_utility::deleteFile(filename); });
+      [filename = std::move(filename)] {
+        ad_utility::deleteFile(filename);
+        ad_utility::deleteFile(absl::StrCat(filename, ZONE_MAPS_SUFFIX));
+      });
 }
 
 // From the `inputs` delete each triple with probability `locatedProbab` and
@@ -1324,6 +1332,227 @@ TEST(CompressedRelationWriter, scanWithGraphs) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(CompressedRelationReader, lateMaterializationOfIncompleteBlocks) {
+  // Three small relations that are all stored in the same block, so the
+  // payload columns of the block only have to be decompressed for the rows
+  // that match the scan.
+  std::vector<RelationInput> inputs;
+  inputs.push_back(RelationInput{41, {{1, 2, 0}, {3, 4, 1}}});
+  inputs.push_back(RelationInput{42, {{3, 4, 0}, {3, 4, 1}, {7, 4, 0}}});
+  inputs.push_back(RelationInput{43, {{5, 6, 0}}});
+  auto [blocks, metadata, readerPtr] =
+      writeAndOpenRelations(inputs, "lateMaterialization", 100_MB);
+  ASSERT_EQ(blocks.size(), 1);
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  std::vector<ColumnIndex> additionalColumns{ADDITIONAL_COLUMN_GRAPH_ID};
+
+  auto lazyScan = [&](const ScanSpecification& spec) {
+    auto result = readerPtr->lazyScan(
+        spec,
+        CompressedRelationReader::convertBlockMetadataRangesToVector(
+            CompressedRelationReader::getRelevantBlocks(
+                spec, getBlockMetadataRangesfromVec(blocks))),
+        additionalColumns, handle, emptyLocatedTriples);
+    IdTable table{1 + additionalColumns.size() +
+                      static_cast<size_t>(!spec.col1Id().has_value()),
+                  ad_utility::testing::makeAllocator()};
+    for (const auto& block : result) {
+      table.insertAtEnd(block);
+    }
+    return std::pair{std::move(table), result.details()};
+  };
+
+  // Only the matching rows are read.
+  auto [table, details] = lazyScan({V(42), std::nullopt, std::nullopt});
+  EXPECT_THAT(table, matchesIdTableFromVector(
+                         {{3, 4, 0}, {3, 4, 1}, {7, 4, 0}}));
+  EXPECT_EQ(details.numBlocksRead_, 1);
+  EXPECT_EQ(details.numElementsRead_, 3);
+
+  std::tie(table, details) = lazyScan({V(42), V(3), std::nullopt});
+  EXPECT_THAT(table, matchesIdTableFromVector({{4, 0}, {4, 1}}));
+  EXPECT_EQ(details.numElementsRead_, 2);
+
+  // The graph filter is applied to the matching rows.
+  using GF = ScanSpecification::GraphFilter;
+  additionalColumns.clear();
+  std::tie(table, details) =
+      lazyScan({V(42), std::nullopt, std::nullopt, {},
+                GF::Whitelist(ad_utility::HashSet<Id>{V(1)})});
+  EXPECT_THAT(table, matchesIdTableFromVector({{3, 4}}));
+}
+
+// _____________________________________________________________________________
+TEST(CompressedRelationReader, lateMaterializationOfBlocksFilteredByGraph) {
+  // A relation with several blocks (of two rows each), most of which contain
+  // triples from both graphs, s.t. they have to be filtered by graph.
+  std::vector<RelationInput> inputs;
+  inputs.push_back(RelationInput{42,
+                                 {{1, 1, 0},
+                                  {1, 2, 1},
+                                  {2, 1, 0},
+                                  {2, 2, 0},
+                                  {3, 1, 1},
+                                  {3, 2, 0},
+                                  {4, 1, 1},
+                                  {4, 2, 1},
+                                  {5, 1, 0},
+                                  {5, 2, 1}}});
+  std::string filename = "lateMaterializationGraphs.dat";
+  auto cleanup = makeCleanup(filename);
+  auto [blocks, metadata, readerPtr] =
+      writeAndOpenRelations(inputs, filename, 16_B);
+  ASSERT_GE(blocks.size(), 3);
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  using GF = ScanSpecification::GraphFilter;
+  ScanSpecification spec{V(42), std::nullopt, std::nullopt, {},
+                         GF::Whitelist(ad_utility::HashSet<Id>{V(1)})};
+
+  auto lazyScan = [&](const std::vector<ColumnIndex>& additionalColumns) {
+    auto result = readerPtr->lazyScan(
+        spec,
+        CompressedRelationReader::convertBlockMetadataRangesToVector(
+            CompressedRelationReader::getRelevantBlocks(
+                spec, getBlockMetadataRangesfromVec(blocks))),
+        additionalColumns, handle, emptyLocatedTriples);
+    IdTable table{2 + additionalColumns.size(),
+                  ad_utility::testing::makeAllocator()};
+    for (const auto& block : result) {
+      table.insertAtEnd(block);
+    }
+    return table;
+  };
+
+  // The complete blocks in the middle of the scan are read with and without
+  // sharing them with other scans.
+  for (auto sharedScansMemory : {0_B, 100_MB}) {
+    auto cleanupParameter = setRuntimeParameterForTest<
+        &RuntimeParameters::sharedScansMaxMemory_>(sharedScansMemory);
+    EXPECT_THAT(lazyScan({}), matchesIdTableFromVector(
+                                  {{1, 2}, {3, 1}, {4, 1}, {4, 2}, {5, 2}}));
+    EXPECT_THAT(lazyScan({ADDITIONAL_COLUMN_GRAPH_ID}),
+                matchesIdTableFromVector({{1, 2, 1},
+                                          {3, 1, 1},
+                                          {4, 1, 1},
+                                          {4, 2, 1},
+                                          {5, 2, 1}}));
+
+    // The materialized scan yields the same result.
+    EXPECT_THAT(
+        readerPtr->scan(CompressedRelationReader::ScanSpecAndBlocks{
+                            spec, getBlockMetadataRangesfromVec(blocks)},
+                        {}, handle, emptyLocatedTriples),
+        matchesIdTableFromVector({{1, 2}, {3, 1}, {4, 1}, {4, 2}, {5, 2}}));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(CompressedRelationReader, concurrentLazyScansShareBlocks) {
+  // A single relation that is stored in many blocks.
+  std::vector<RelationInput> inputs{RelationInput{42, {}}};
+  for (int i = 0; i < 200; ++i) {
+    inputs.back().col1And2_.push_back({i, i + 1, 0});
+  }
+  std::string filename = "concurrentLazyScans.dat";
+  auto cleanup = makeCleanup(filename);
+  auto [blocks, metadata, readerPtr] =
+      writeAndOpenRelations(inputs, filename, 64_B);
+  ASSERT_GE(blocks.size(), 20);
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+
+  // Insert and delete some triples of the relation.
+  auto triple = [](int col1, int col2) {
+    return IdTriple<>{{V(42), V(col1), V(col2), V(0)}};
+  };
+  std::vector<IdTriple<>> inserted{triple(10, 20), triple(100, 3),
+                                   triple(190, 0)};
+  std::vector<IdTriple<>> deleted{triple(50, 51), triple(150, 151)};
+  LocatedTriplesPerBlock locatedTriples;
+  locatedTriples.add(LocatedTriple::locateTriplesInPermutation(
+      inserted, blocks, {0, 1, 2, 3}, true, handle));
+  locatedTriples.add(LocatedTriple::locateTriplesInPermutation(
+      deleted, blocks, {0, 1, 2, 3}, false, handle));
+  locatedTriples.setOriginalMetadata(blocks);
+  locatedTriples.updateAugmentedMetadata();
+
+  ScanSpecification spec{V(42), std::nullopt, std::nullopt};
+  auto lazyScan = [&](bool withLocatedTriples) {
+    const auto& located =
+        withLocatedTriples ? locatedTriples : emptyLocatedTriples;
+    const auto& blockMetadata = withLocatedTriples
+                                    ? locatedTriples.getAugmentedMetadata()
+                                    : blocks;
+    return readerPtr->lazyScan(
+        spec,
+        CompressedRelationReader::convertBlockMetadataRangesToVector(
+            CompressedRelationReader::getRelevantBlocks(
+                spec, getBlockMetadataRangesfromVec(blockMetadata))),
+        Permutation::ColumnIndices{}, handle, located);
+  };
+  auto makeTable = []() {
+    return IdTable{2, ad_utility::testing::makeAllocator()};
+  };
+
+  // The results of scans that don't share their blocks.
+  std::array<IdTable, 2> expected{makeTable(), makeTable()};
+  {
+    auto noSharing =
+        setRuntimeParameterForTest<&RuntimeParameters::sharedScansMaxMemory_>(
+            0_B);
+    for (bool withLocatedTriples : {false, true}) {
+      for (const auto& block : lazyScan(withLocatedTriples)) {
+        expected.at(withLocatedTriples).insertAtEnd(block);
+      }
+    }
+  }
+  ASSERT_EQ(expected.at(false).numRows(), 200u);
+  ASSERT_EQ(expected.at(true).numRows(), 201u);
+
+  // Only read a single block ahead, s.t. the second scan reads most of the
+  // blocks before the first scan and keeps them for it.
+  auto c1 =
+      setRuntimeParameterForTest<&RuntimeParameters::lazyIndexScanQueueSize_>(
+          1);
+  auto c2 = setRuntimeParameterForTest<
+      &RuntimeParameters::lazyIndexScanNumThreads_>(1);
+  auto c3 =
+      setRuntimeParameterForTest<&RuntimeParameters::sharedScansMaxMemory_>(
+          100_MB);
+  const auto& sharedScans = readerPtr->sharedScans();
+  // The located triples of a scan are applied to the blocks that were read by
+  // the other scan (and vice versa).
+  for (bool firstWithLocatedTriples : {true, false}) {
+    auto numBlocksSharedBefore = sharedScans.getStatistics().numBlocksShared_;
+    auto first = lazyScan(firstWithLocatedTriples);
+    auto second = lazyScan(!firstWithLocatedTriples);
+    auto firstTable = makeTable();
+    auto secondTable = makeTable();
+    // Start the first scan, then read the complete second scan, and only then
+    // the rest of the first scan.
+    auto it = first.begin();
+    auto secondScan = std::async(std::launch::async, [&]() {
+      for (const auto& block : second) {
+        secondTable.insertAtEnd(block);
+      }
+    });
+    secondScan.get();
+    for (; it != first.end(); ++it) {
+      firstTable.insertAtEnd(*it);
+    }
+    EXPECT_THAT(firstTable,
+                matchesIdTable(expected.at(firstWithLocatedTriples)));
+    EXPECT_THAT(secondTable,
+                matchesIdTable(expected.at(!firstWithLocatedTriples)));
+    EXPECT_GT(sharedScans.getStatistics().numBlocksShared_,
+              numBlocksSharedBefore);
+  }
+  // All the scans are finished, so no blocks are kept anymore.
+  EXPECT_EQ(sharedScans.getStatistics().numScans_, 0u);
+  EXPECT_EQ(sharedScans.getStatistics().numBlocksKept_, 0u);
+  EXPECT_EQ(sharedScans.getStatistics().memory_, 0_B);
+}
+
 namespace ad_utility {
 std::pair<size_t, size_t> getThreadCountAndTaskSize(
     const TaskQueue<false>& taskQueue) {
@@ -1419,6 +1648,217 @@ TEST(ScanSpecAndBlocks, removePrefix) {
   }
 }
 
+// _____________________________________________________________________________
+TEST(ScanSpecAndBlocks, removeBlocksExcludedByMembershipFilters) {
+  using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
+  // Only even values in the second column, s.t. the triples with odd values
+  // lie within the range of a block, but are not contained in it.
+  std::vector<RelationInput> inputs;
+  inputs.push_back(RelationInput{42,
+                                 {{0, 0, 0},
+                                  {2, 0, 0},
+                                  {4, 0, 0},
+                                  {6, 0, 0},
+                                  {8, 0, 0},
+                                  {10, 0, 0},
+                                  {12, 0, 0},
+                                  {14, 0, 0}}});
+  std::string filename = "membershipFilters.dat";
+  auto cleanup = makeCleanup(filename);
+  auto [blocks, metadata, reader] =
+      writeAndOpenRelations(inputs, filename, 16_B);
+  ASSERT_EQ(blocks.size(), 4);
+
+  auto filters = reader->computeMembershipFilters(
+      blocks, 2, std::make_shared<ad_utility::CancellationHandle<>>());
+  ASSERT_EQ(filters.size(), 4);
+  // There are no false negatives.
+  for (int i = 0; i < 8; ++i) {
+    const auto& filter = filters.at(i / 2);
+    ASSERT_TRUE(filter.has_value());
+    EXPECT_TRUE(filter->mayContain(membershipFilterKey(V(42), V(2 * i), V(0))));
+  }
+
+  auto getBlockIndices = [&](const ScanSpecification& spec,
+                             const LocatedTriplesPerBlock& locatedTriples) {
+    ScanSpecAndBlocks specAndBlocks{spec,
+                                    getBlockMetadataRangesfromVec(blocks)};
+    specAndBlocks.removeBlocksExcludedByMembershipFilters(filters,
+                                                          locatedTriples);
+    std::vector<size_t> result;
+    for (const auto& block : specAndBlocks.getBlockMetadataView()) {
+      result.push_back(block.blockIndex_);
+    }
+    EXPECT_EQ(result.size(), specAndBlocks.sizeBlockMetadata_);
+    return result;
+  };
+  using ::testing::ElementsAre;
+  using ::testing::IsEmpty;
+
+  // Existing triples are found.
+  EXPECT_THAT(getBlockIndices({V(42), V(6), V(0)}, emptyLocatedTriples),
+              ElementsAre(1));
+  // The triple `42 5 0` lies within the range of block 1, but it is not
+  // contained in it.
+  EXPECT_THAT(getBlockIndices({V(42), V(5), V(0)}, emptyLocatedTriples),
+              IsEmpty());
+  // If not all columns are fixed, the filters are not used.
+  EXPECT_THAT(getBlockIndices({V(42), V(5), std::nullopt}, emptyLocatedTriples),
+              ElementsAre(1));
+
+  // A block with located triples is never removed.
+  LocatedTriplesPerBlock locatedTriples;
+  locatedTriples.setOriginalMetadata(blocks);
+  std::vector<LocatedTriple> insertTriples;
+  insertTriples.emplace_back(
+      LocatedTriple{1, IdTriple{{V(42), V(5), V(0), V(0)}}, true});
+  locatedTriples.add(insertTriples);
+  EXPECT_THAT(getBlockIndices({V(42), V(5), V(0)}, locatedTriples),
+              ElementsAre(1));
+}
+
+// _____________________________________________________________________________
+TEST(BlockZoneMap, computeForColumn) {
+  using ad_utility::testing::LocalVocabId;
+  // Within a datatype, the `Id`s are compared by their bits, so the negative
+  // integers are larger than the positive ones.
+  std::vector<Id> column{I(5), V(3), I(-1), V(1), I(7), V(2)};
+  auto zoneMap = BlockZoneMap::computeForColumn(column);
+  ASSERT_TRUE(zoneMap.has_value());
+  EXPECT_THAT(zoneMap.value(),
+              ::testing::ElementsAre(std::pair{I(5), I(-1)},
+                                     std::pair{V(1), V(3)}));
+
+  EXPECT_THAT(BlockZoneMap::computeForColumn({}).value(), ::testing::IsEmpty());
+  // Entries of a local vocab can't be compared by their bits.
+  column.push_back(LocalVocabId(4));
+  EXPECT_FALSE(BlockZoneMap::computeForColumn(column).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(CompressedRelationWriter, perBlockDataOfPreviousBuildIsIgnored) {
+  std::vector<RelationInput> inputs;
+  inputs.push_back(
+      RelationInput{42, {{0, 1, 0}, {2, 3, 0}, {4, 5, 0}, {6, 7, 0}}});
+  std::string filename = "perBlockData.dat";
+  std::string zoneMapsFilename = absl::StrCat(filename, ZONE_MAPS_SUFFIX);
+  std::string filtersFilename =
+      absl::StrCat(filename, MEMBERSHIP_FILTERS_SUFFIX);
+  auto cleanup = makeCleanup(filename);
+  auto cleanupFilters =
+      ad_utility::makeOnDestructionDontThrowDuringStackUnwinding(
+          [&filtersFilename] { ad_utility::deleteFile(filtersFilename); });
+  auto [blocks, metadata, reader] =
+      writeAndOpenRelations(inputs, filename, 16_B);
+  ASSERT_EQ(blocks.size(), 2);
+  auto filters = reader->computeMembershipFilters(
+      blocks, 1, std::make_shared<ad_utility::CancellationHandle<>>());
+  writePerBlockDataToFile(filtersFilename, blocks, filters);
+
+  // The data is read back for the blocks it was written for.
+  using Blocks = std::vector<CompressedBlockMetadata>;
+  auto readFilters = [&](const Blocks& blocksOfPermutation) {
+    return readPerBlockDataFromFileIfExists<BlockMembershipFilters>(
+        filtersFilename, blocksOfPermutation);
+  };
+  auto readZoneMaps = [&](const Blocks& blocksOfPermutation) {
+    return readPerBlockDataFromFileIfExists<BlockZoneMaps>(
+        zoneMapsFilename, blocksOfPermutation);
+  };
+  EXPECT_TRUE(readFilters(blocks).has_value());
+  EXPECT_TRUE(readZoneMaps(blocks).has_value());
+
+  // A rebuild with different triples but the same number of blocks changes the
+  // fingerprint, so the old data is not used for the new blocks.
+  inputs.at(0).col1And2_.at(1) = {2, 4, 0};
+  auto [otherBlocks, otherMetadata, otherReader] =
+      writeAndOpenRelations(inputs, filename, 16_B);
+  ASSERT_EQ(otherBlocks.size(), blocks.size());
+  EXPECT_NE(blockMetadataFingerprint(otherBlocks),
+            blockMetadataFingerprint(blocks));
+  EXPECT_FALSE(readFilters(otherBlocks).has_value());
+  EXPECT_TRUE(readZoneMaps(otherBlocks).has_value());
+  EXPECT_FALSE(readZoneMaps(blocks).has_value());
+
+  // A writer without zone maps removes the zone maps of a previous build.
+  ASSERT_TRUE(std::filesystem::exists(zoneMapsFilename));
+  {
+    CompressedRelationWriter writer{4, ad_utility::File{filename, "w"}, 16_B};
+    std::move(writer).getFinishedBlocks();
+  }
+  EXPECT_FALSE(std::filesystem::exists(zoneMapsFilename));
+
+  // A missing file is not an error, the data is optional.
+  EXPECT_FALSE(readZoneMaps(blocks).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(ScanSpecAndBlocks, removeBlocksExcludedByZoneMaps) {
+  using ScanSpecAndBlocks = CompressedRelationReader::ScanSpecAndBlocks;
+  // The blocks (of two triples each) are sorted by the second column, but not
+  // by the third column.
+  std::vector<RelationInput> inputs;
+  inputs.push_back(RelationInput{42,
+                                 {{0, 100, 0},
+                                  {2, 5, 0},
+                                  {4, 7, 0},
+                                  {6, 200, 0},
+                                  {8, 1, 0},
+                                  {10, 3, 0},
+                                  {12, 300, 0},
+                                  {14, 2, 0}}});
+  std::string filename = "zoneMaps.dat";
+  auto cleanup = makeCleanup(filename);
+  auto [blocks, metadata, reader] =
+      writeAndOpenRelations(inputs, filename, 16_B);
+  ASSERT_EQ(blocks.size(), 4);
+
+  // The writer has written the zone maps of the blocks.
+  auto zoneMapsFromFile = readPerBlockDataFromFileIfExists<BlockZoneMaps>(
+      absl::StrCat(filename, ZONE_MAPS_SUFFIX), blocks);
+  ASSERT_TRUE(zoneMapsFromFile.has_value());
+  BlockZoneMaps zoneMaps = std::move(zoneMapsFromFile.value());
+  ASSERT_EQ(zoneMaps.size(), 4);
+  using P = std::pair<Id, Id>;
+  using ::testing::ElementsAre;
+  for (size_t i = 0; i < zoneMaps.size(); ++i) {
+    ASSERT_TRUE(zoneMaps[i].has_value());
+    const auto& columns = zoneMaps[i]->columns_;
+    EXPECT_THAT(columns[0], ElementsAre(P{V(42), V(42)}));
+    EXPECT_THAT(columns[1], ElementsAre(P{V(4 * i), V(4 * i + 2)}));
+  }
+  EXPECT_THAT(zoneMaps[0]->columns_[2], ElementsAre(P{V(5), V(100)}));
+  EXPECT_THAT(zoneMaps[3]->columns_[2], ElementsAre(P{V(2), V(300)}));
+
+  auto getBlockIndices = [&](const LocatedTriplesPerBlock& locatedTriples) {
+    ScanSpecAndBlocks specAndBlocks{{V(42), std::nullopt, std::nullopt},
+                                    getBlockMetadataRangesfromVec(blocks)};
+    // Only keep the blocks with a value `>= 150` in the third column.
+    specAndBlocks.removeBlocksExcludedByZoneMaps(
+        zoneMaps, 2, locatedTriples, [](const ColumnZoneMap& zoneMap) {
+          return ql::ranges::any_of(zoneMap, [](const auto& range) {
+            return range.second.getBits() >= V(150).getBits();
+          });
+        });
+    std::vector<size_t> result;
+    for (const auto& block : specAndBlocks.getBlockMetadataView()) {
+      result.push_back(block.blockIndex_);
+    }
+    EXPECT_EQ(result.size(), specAndBlocks.sizeBlockMetadata_);
+    return result;
+  };
+  EXPECT_THAT(getBlockIndices(emptyLocatedTriples), ElementsAre(1, 3));
+
+  // A block with located triples is never removed.
+  LocatedTriplesPerBlock locatedTriples;
+  locatedTriples.setOriginalMetadata(blocks);
+  std::vector<LocatedTriple> insertTriples;
+  insertTriples.emplace_back(
+      LocatedTriple{2, IdTriple{{V(42), V(9), V(0), V(0)}}, true});
+  locatedTriples.add(insertTriples);
+  EXPECT_THAT(getBlockIndices(locatedTriples), ElementsAre(1, 2, 3));
+}
+
 // _____________________________________________________________________________
 TEST(CompressedBlockMetadata, invariantChecks) {
   std::vector<CompressedBlockMetadata> blocks;
@@ -2,7 +2,12 @@
 // Chair of Algorithms and Data Structures.
 // Author: Robin Textor-Falconi (textorr@informatik.uni-freiburg.de)
 
+#include <absl/strings/str_cat.h>
 #include <gmock/gmock.h>
+#include <zstd.h>
+
+#include <future>
+#include <vector>
 
 #include "util/CompressorStream.h"
 #include "util/Exception.h"
@@ -12,6 +17,7 @@ namespace io = boost::iostreams;
 namespace http = boost::beast::http;
 using ad_utility::content_encoding::CompressionMethod;
 using ad_utility::streams::compressStream;
+using ad_utility::streams::compressStreamZstd;
 
 namespace {
 cppcoro::generator<std::string> generateNChars(size_t n) {
@@ -19,6 +25,22 @@ cppcoro::generator<std::string> generateNChars(size_t n) {
     co_yield "A";
   }
 }
+
+// Decompress a stream of (possibly several) zstd frames.
+std::string decompressZstd(std::string_view compressedData) {
+  std::string result;
+  auto context = std::unique_ptr<ZSTD_DCtx, decltype(&ZSTD_freeDCtx)>(
+      ZSTD_createDCtx(), &ZSTD_freeDCtx);
+  ZSTD_inBuffer input{compressedData.data(), compressedData.size(), 0};
+  std::string buffer(ZSTD_DStreamOutSize(), '\0');
+  while (input.pos < input.size) {
+    ZSTD_outBuffer output{buffer.data(), buffer.size(), 0};
+    auto status = ZSTD_decompressStream(context.get(), &output, &input);
+    AD_CORRECTNESS_CHECK(!ZSTD_isError(status));
+    result.append(buffer.data(), output.pos);
+  }
+  return result;
+}
 }  // namespace
 
 class CompressorStreamTestFixture
@@ -32,6 +54,8 @@ class CompressorStreamTestFixture
       filterStream.push(io::gzip_decompressor());
     } else if (GetParam() == CompressionMethod::DEFLATE) {
       filterStream.push(io::zlib_decompressor());
+    } else if (GetParam() == CompressionMethod::ZSTD) {
+      return decompressZstd(compressedData);
     } else {
       // Unsupported decompression
       AD_FAIL();
@@ -80,4 +104,72 @@ using ad_utility::content_encoding::CompressionMethod;
 INSTANTIATE_TEST_SUITE_P(CompressionMethodParameters,
                          CompressorStreamTestFixture,
                          ::testing::Values(CompressionMethod::DEFLATE,
-                                           CompressionMethod::GZIP));
+                                           CompressionMethod::GZIP,
+                                           CompressionMethod::ZSTD));
+
+// _____________________________________________________________________________
+TEST(CompressorStream, ZstdFramesAreCompressedInParallelAndInOrder) {
+  auto generateNumbers = []() -> cppcoro::generator<std::string> {
+    for (size_t i = 0; i < 10'000; ++i) {
+      co_yield absl::StrCat(i, "\n");
+    }
+  };
+  std::string expected;
+  for (const auto& line : generateNumbers()) {
+    expected.append(line);
+  }
+  using namespace ad_utility::memory_literals;
+  for (size_t queueSize : {1, 2, 5}) {
+    std::string compressed;
+    size_t numFrames = 0;
+    for (const auto& frame :
+         compressStreamZstd(generateNumbers(), {1_kB, queueSize, 3})) {
+      compressed.append(frame);
+      ++numFrames;
+    }
+    // Each batch of 1 kB is compressed to its own frame.
+    EXPECT_GE(numFrames, expected.size() / 1'100);
+    EXPECT_EQ(decompressZstd(compressed), expected);
+  }
+
+  // An empty input results in an empty output.
+  auto empty = compressStreamZstd(generateNChars(0));
+  EXPECT_EQ(empty.begin(), empty.end());
+
+  // A stream that is destroyed before all its frames are consumed doesn't
+  // affect the shared thread pool.
+  {
+    auto stream = compressStreamZstd(generateNumbers(), {1_kB, 5, 3});
+    EXPECT_NE(stream.begin(), stream.end());
+  }
+}
+
+// _____________________________________________________________________________
+TEST(CompressorStream, ConcurrentZstdStreamsShareTheThreadPool) {
+  auto generateNumbers = [](size_t offset) -> cppcoro::generator<std::string> {
+    for (size_t i = 0; i < 5'000; ++i) {
+      co_yield absl::StrCat(offset + i, "\n");
+    }
+  };
+  using namespace ad_utility::memory_literals;
+  // Many more streams than there are compression threads.
+  constexpr size_t numStreams = 16;
+  std::vector<std::future<void>> streams;
+  for (size_t s = 0; s < numStreams; ++s) {
+    streams.push_back(std::async(std::launch::async, [&generateNumbers, s]() {
+      std::string expected;
+      for (const auto& line : generateNumbers(s)) {
+        expected.append(line);
+      }
+      std::string compressed;
+      for (const auto& frame :
+           compressStreamZstd(generateNumbers(s), {1_kB, 3, 3})) {
+        compressed.append(frame);
+      }
+      EXPECT_EQ(decompressZstd(compressed), expected);
+    }));
+  }
+  for (auto& stream : streams) {
+    stream.get();
+  }
+}
@@ -740,6 +740,98 @@ TEST_F(DeltaTriplesTest, LocatedTriplesSharedState) {
   EXPECT_THAT(transparentSnapshotBeforeUpdate, Snapshot(1, 1));
   // The copied snapshot before the update is unchanged.
   EXPECT_THAT(copiedSnapshotBeforeUpdate, Snapshot(0, 0));
+
+  // The copied snapshot shares the located triples of the block with the
+  // `DeltaTriples` until the block is modified again.
+  const auto& current =
+      deltaTriples.getLocatedTriplesForPermutation(Permutation::PSO);
+  const auto& copied =
+      copiedSnapshotAfterUpdate->getLocatedTriplesForPermutation<false>(
+          Permutation::PSO);
+  ASSERT_EQ(current.numBlocks(), 1);
+  size_t blockIndex = 0;
+  while (!current.containsTriples(blockIndex)) {
+    ++blockIndex;
+  }
+  EXPECT_EQ(&current.getUpdatesIfPresent(blockIndex).value(),
+            &copied.getUpdatesIfPresent(blockIndex).value());
+  deltaTriples.deleteTriples(
+      cancellationHandle, makeIdTriples(index, localVocab, {"<A> <B> <C>"}));
+  EXPECT_NE(&current.getUpdatesIfPresent(blockIndex).value(),
+            &copied.getUpdatesIfPresent(blockIndex).value());
+  EXPECT_THAT(copiedSnapshotAfterUpdate, Snapshot(1, 1));
+}
+
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, parallelLocationOfTriples) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  auto& index = testQec->getIndex();
+
+  // The same updates are applied to a `DeltaTriples` which locates the triples
+  // in one permutation after the other and to one which locates them in all
+  // permutations concurrently.
+  DeltaTriples sequential(index);
+  sequential.setMinNumTriplesForParallelLocationForTesting(
+      std::numeric_limits<size_t>::max());
+  DeltaTriples parallel(index);
+  parallel.setMinNumTriplesForParallelLocationForTesting(0);
+
+  // Insertions and deletions of triples that are and are not in the index,
+  // including ones with a language tag (which also yield internal triples).
+  std::vector<std::string> insertions{"<a> <upp> <A>", "<a> <new> <b>",
+                                      "<zzz> <z> <z>", "<a> <label> \"a\"@en"};
+  std::vector<std::string> deletions{"<b> <next> <c>", "<X> <Y> <Z>",
+                                     "<C> <low> <c>"};
+  for (size_t i = 0; i < 50; ++i) {
+    insertions.push_back(absl::StrCat("<s", i, "> <p> <o", i % 7, ">"));
+  }
+  auto update = [&](DeltaTriples& deltaTriples) {
+    auto& localVocab = deltaTriples.localVocab();
+    deltaTriples.insertTriples(cancellationHandle,
+                               makeIdTriples(index, localVocab, insertions));
+    deltaTriples.deleteTriples(cancellationHandle,
+                               makeIdTriples(index, localVocab, deletions));
+  };
+  update(sequential);
+  update(parallel);
+
+  // Scan the complete permutation with the current delta triples.
+  auto scan = [&](const DeltaTriples& deltaTriples,
+                  Permutation::Enum permutation) {
+    auto state = deltaTriples.getLocatedTriplesSharedStateReference();
+    const auto& perm = index.getPermutation(permutation);
+    ScanSpecification scanSpec{std::nullopt, std::nullopt, std::nullopt};
+    return perm.scan(perm.getScanSpecAndBlocks(scanSpec, *state), {},
+                     cancellationHandle, *state);
+  };
+  auto expectEqualState = [&]() {
+    EXPECT_EQ(parallel.numInserted(), sequential.numInserted());
+    EXPECT_EQ(parallel.numDeleted(), sequential.numDeleted());
+    EXPECT_EQ(parallel.numInternalInserted(), sequential.numInternalInserted());
+    EXPECT_EQ(parallel.numInternalDeleted(), sequential.numInternalDeleted());
+    for (auto permutation : Permutation::ALL) {
+      EXPECT_EQ(
+          parallel.getLocatedTriplesForPermutation(permutation).numTriples(),
+          sequential.getLocatedTriplesForPermutation(permutation).numTriples());
+      EXPECT_EQ(scan(parallel, permutation), scan(sequential, permutation));
+    }
+  };
+  EXPECT_EQ(sequential.numInserted(), 54);
+  EXPECT_EQ(sequential.numDeleted(), 3);
+  EXPECT_GT(sequential.numInternalInserted(), 0);
+  expectEqualState();
+
+  // The handles are also correct, so that triples which are located
+  // concurrently can be removed again (here by deleting them again).
+  std::swap(insertions, deletions);
+  update(sequential);
+  update(parallel);
+  expectEqualState();
+
+  // A cancellation in one of the concurrent threads is propagated.
+  cancellationHandle->cancel(ad_utility::CancellationState::MANUAL);
+  EXPECT_THROW(update(parallel), ad_utility::CancellationException);
 }
 
 // _____________________________________________________________________________
@@ -935,6 +1027,129 @@ TEST_F(DeltaTriplesTest, storeAndRestoreData) {
   }
 }
 
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, writeAheadLog) {
+  auto tmpFile = std::filesystem::temp_directory_path() / "testDeltaTriplesLog";
+  auto logFile = tmpFile;
+  logFile += ".wal";
+  std::filesystem::remove(tmpFile);
+  std::filesystem::remove(logFile);
+  absl::Cleanup cleanup{[&tmpFile, &logFile]() {
+    std::filesystem::remove(tmpFile);
+    std::filesystem::remove(logFile);
+  }};
+  auto cleanupParameter = setRuntimeParameterForTest<
+      &RuntimeParameters::deltaTriplesLogMinCheckpointSize_>(
+      ad_utility::MemorySize::megabytes(1));
+  auto& index = testQec->getIndex();
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  LocalVocab localVocab;
+  auto checkpointSize = [&tmpFile]() {
+    return std::filesystem::file_size(tmpFile);
+  };
+  {
+    DeltaTriples deltaTriples{index};
+    deltaTriples.setPersists(tmpFile);
+    deltaTriples.readFromDisk();
+    // The first write is always a checkpoint.
+    deltaTriples.writeToDisk();
+    auto initialCheckpointSize = checkpointSize();
+    EXPECT_FALSE(std::filesystem::exists(logFile));
+
+    // The following updates are only appended to the log.
+    auto blankNodeTriple = makeIdTriples(index, localVocab, {"<b> <x> <c>"});
+    blankNodeTriple.at(0).ids().at(2) =
+        Id::makeFromBlankNodeIndex(BlankNodeIndex::make(
+            index.getBlankNodeManager()->minIndex_ + 42));
+    deltaTriples.insertTriples(cancellationHandle, blankNodeTriple);
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        makeIdTriples(index, localVocab, {"<a> <UPP> <A>", "<new> <x> <y>"}));
+    deltaTriples.writeToDisk();
+    auto logSize = std::filesystem::file_size(logFile);
+    EXPECT_GT(logSize, 0);
+    // The blank node of the triple was replaced by one of the `DeltaTriples`,
+    // so the triple has to be looked up to be deleted again.
+    auto isBlankNodeTriple = [](const IdTriple<0>& triple) {
+      return triple.ids().at(2).getDatatype() == Datatype::BlankNodeIndex;
+    };
+    auto inserted = ::ranges::to_vector(
+        deltaTriples.triplesToHandlesNormal_.triplesInserted_ |
+        ql::views::keys | ql::views::filter(isBlankNodeTriple));
+    ASSERT_EQ(inserted.size(), 1);
+    deltaTriples.deleteTriples(cancellationHandle, inserted);
+    deltaTriples.deleteTriples(
+        cancellationHandle,
+        makeIdTriples(index, localVocab, {"<A> <low> <a>"}));
+    deltaTriples.writeToDisk();
+    EXPECT_GT(std::filesystem::file_size(logFile), logSize);
+    EXPECT_EQ(checkpointSize(), initialCheckpointSize);
+    EXPECT_THAT(deltaTriples, NumTriples(2, 2, 4));
+  }
+
+  // An incomplete record at the end of the log (e.g. after a crash) is
+  // ignored.
+  {
+    std::ofstream stream{logFile, std::ios::binary | std::ios::app};
+    stream << "incomplete";
+  }
+
+  auto isRestoredCorrectly = [&](DeltaTriples& deltaTriples) {
+    // If the same blank node wasn't used for the insertion and the deletion,
+    // there would be three insertions.
+    EXPECT_THAT(deltaTriples, NumTriples(2, 2, 4));
+    EXPECT_THAT(deltaTriples.localVocab().getAllWordsForTesting(),
+                ::testing::Contains(AD_PROPERTY(LocalVocabEntry,
+                                                toStringRepresentation,
+                                                ::testing::Eq("<new>"))));
+  };
+  {
+    DeltaTriples deltaTriples{index};
+    deltaTriples.setPersists(tmpFile);
+    deltaTriples.readFromDisk();
+    isRestoredCorrectly(deltaTriples);
+    // The restored triples are written as a new checkpoint.
+    EXPECT_FALSE(std::filesystem::exists(logFile));
+
+    // A large batch of updates leads to a checkpoint, because the log would
+    // become larger than the checkpoint.
+    auto cleanupParameter2 = setRuntimeParameterForTest<
+        &RuntimeParameters::deltaTriplesLogMinCheckpointSize_>(
+        ad_utility::MemorySize::bytes(0));
+    std::vector<std::string> triples;
+    for (size_t i = 0; i < 50; ++i) {
+      triples.push_back(absl::StrCat("<s", i, "> <p> <o>"));
+    }
+    deltaTriples.insertTriples(cancellationHandle,
+                               makeIdTriples(index, localVocab, triples));
+    deltaTriples.deleteTriples(cancellationHandle,
+                               makeIdTriples(index, localVocab, triples));
+    deltaTriples.writeToDisk();
+    EXPECT_FALSE(std::filesystem::exists(logFile));
+  }
+  {
+    DeltaTriples deltaTriples{index};
+    deltaTriples.setPersists(tmpFile);
+    deltaTriples.readFromDisk();
+    EXPECT_THAT(deltaTriples, NumTriples(2, 52, 54));
+
+    // Clearing the delta triples can't be expressed in the log, so a
+    // checkpoint is written.
+    deltaTriples.insertTriples(
+        cancellationHandle, makeIdTriples(index, localVocab, {"<c> <x> <d>"}));
+    deltaTriples.clear();
+    deltaTriples.writeToDisk();
+    EXPECT_FALSE(std::filesystem::exists(logFile));
+  }
+  {
+    DeltaTriples deltaTriples{index};
+    deltaTriples.setPersists(tmpFile);
+    deltaTriples.readFromDisk();
+    EXPECT_THAT(deltaTriples, NumTriples(0, 0, 0));
+  }
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, copyLocalVocab) {
   using namespace ::testing;
@@ -1069,6 +1284,126 @@ TEST_F(DeltaTriplesTest, vacuum) {
   EXPECT_EQ(result["internal"]["totalKept"], 0);
 }
 
+// _____________________________________________________________________________
+TEST_F(DeltaTriplesTest, compact) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::CancellationHandle<>>();
+  const auto& index = testQec->getIndex().getImpl();
+  // The expected results are computed with the `reference`, which gets the same
+  // updates, but is never compacted.
+  DeltaTriplesManager deltaTriplesManager(index);
+  DeltaTriplesManager reference(index);
+  for (auto* manager : {&deltaTriplesManager, &reference}) {
+    manager->modify<void>(
+        [&index](DeltaTriples& deltaTriples) {
+          for (auto permutation : Permutation::ALL) {
+            index.getPermutation(permutation)
+                .setOriginalMetadataForDeltaTriples(deltaTriples);
+          }
+        },
+        false);
+  }
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::deltaTriplesCompactionMinimumBlockSize_>(1ul);
+
+  // Scan the complete SPO permutation with the current delta triples.
+  auto scanSPO = [&](const DeltaTriplesManager& manager) {
+    auto state = manager.getCurrentLocatedTriplesSharedState();
+    const auto& permutation = index.getPermutation(Permutation::SPO);
+    ScanSpecification scanSpec{std::nullopt, std::nullopt, std::nullopt};
+    return permutation.scan(permutation.getScanSpecAndBlocks(scanSpec, *state),
+                            {}, cancellationHandle, *state);
+  };
+  // Return true iff one of the blocks of SPO has located triples that are not
+  // yet part of a compacted block.
+  auto hasTriplesToMerge = [&]() {
+    auto state = deltaTriplesManager.getCurrentLocatedTriplesSharedState();
+    const auto& locatedTriples =
+        state->getLocatedTriplesForPermutation<false>(Permutation::SPO);
+    return ql::ranges::any_of(
+        locatedTriples.getAugmentedMetadata(),
+        [&locatedTriples](const CompressedBlockMetadata& block) {
+          return locatedTriples.hasTriplesToMerge(block.blockIndex_);
+        });
+  };
+  auto compact = [&]() {
+    return deltaTriplesManager.compact(std::numeric_limits<size_t>::max(),
+                                       cancellationHandle);
+  };
+  auto update = [&](const std::vector<std::string>& insertions,
+                    const std::vector<std::string>& deletions) {
+    for (auto* manager : {&deltaTriplesManager, &reference}) {
+      manager->modify<void>(
+          [&](DeltaTriples& deltaTriples) {
+            LocalVocab localVocab;
+            deltaTriples.insertTriples(
+                cancellationHandle,
+                makeIdTriples(index, localVocab, insertions));
+            deltaTriples.deleteTriples(
+                cancellationHandle,
+                makeIdTriples(index, localVocab, deletions));
+          },
+          false);
+    }
+  };
+
+  auto original = scanSPO(deltaTriplesManager);
+  // Insertions and deletions of triples that are and are not in the index.
+  update({"<a> <upp> <A>", "<a> <new> <b>", "<zzz> <z> <z>"},
+         {"<b> <next> <c>", "<X> <Y> <Z>"});
+  EXPECT_TRUE(hasTriplesToMerge());
+  auto expected = scanSPO(reference);
+  EXPECT_NE(expected, original);
+  EXPECT_EQ(scanSPO(deltaTriplesManager), expected);
+
+  // After the compaction, nothing has to be merged anymore, but the result of
+  // the scan and the index of the snapshot (which is used by the query cache)
+  // are the same.
+  auto snapshotIndex =
+      deltaTriplesManager.getCurrentLocatedTriplesSharedState()->index_;
+  auto stats = compact();
+  EXPECT_GT(stats["blocksCompacted"].get<size_t>(), 0);
+  EXPECT_EQ(stats["blocksOutdated"], 0);
+  EXPECT_FALSE(hasTriplesToMerge());
+  EXPECT_EQ(scanSPO(deltaTriplesManager), expected);
+  EXPECT_EQ(deltaTriplesManager.getCurrentLocatedTriplesSharedState()->index_,
+            snapshotIndex);
+  EXPECT_EQ(compact()["blocksCompacted"], 0);
+
+  // Later updates are merged with the compacted blocks until these are
+  // compacted again. The expected result is computed without any compaction.
+  update({"<a> <newer> <c>"}, {"<a> <new> <b>", "<a> <upp> <A>"});
+  EXPECT_TRUE(hasTriplesToMerge());
+  auto expectedAfterUpdate = scanSPO(reference);
+  EXPECT_NE(expectedAfterUpdate, expected);
+  EXPECT_EQ(scanSPO(deltaTriplesManager), expectedAfterUpdate);
+  compact();
+  EXPECT_FALSE(hasTriplesToMerge());
+  EXPECT_EQ(scanSPO(deltaTriplesManager), expectedAfterUpdate);
+
+  // Once the compacted blocks exceed the memory limit, no further blocks are
+  // compacted, but the scans are still correct.
+  {
+    auto cleanupMemory = setRuntimeParameterForTest<
+        &RuntimeParameters::deltaTriplesCompactionMaxMemory_>(
+        ad_utility::MemorySize::bytes(1));
+    update({"<b> <newest> <c>"}, {});
+    auto stats = compact();
+    EXPECT_EQ(stats["blocksCompacted"], 0);
+    EXPECT_TRUE(stats["memoryLimitReached"].get<bool>());
+    EXPECT_TRUE(hasTriplesToMerge());
+    EXPECT_EQ(scanSPO(deltaTriplesManager), scanSPO(reference));
+  }
+
+  // Clearing the delta triples also removes the compacted blocks.
+  deltaTriplesManager.clear();
+  EXPECT_EQ(deltaTriplesManager.getCurrentLocatedTriplesSharedState()
+                ->getLocatedTriplesForPermutation<false>(Permutation::SPO)
+                .numCompactedBlocks(),
+            0);
+  EXPECT_EQ(scanSPO(deltaTriplesManager), original);
+}
+
 // _____________________________________________________________________________
 TEST_F(DeltaTriplesTest, remapId) {
   auto I = &Id::makeFromInt;
@@ -270,8 +270,10 @@ TEST(ExportIds, idsToStringAndTypeBatchMatchesIndividualLookups) {
       Id::makeUndefined(),
   };
 
-  // `idsToStringAndType` requires the input to be sorted by `ValueId`.
-  ql::ranges::sort(ids);
+  // The input may be unsorted and contain duplicates.
+  ids.push_back(getId("<p>"));
+  ids.push_back(getId("\"hello\""));
+  ids.push_back(getId("<s>"));
 
   auto batchResults = ql::exportIds::idsToStringAndType(
       index, ql::span<const Id>{ids}, localVocab);
@@ -282,6 +284,17 @@ TEST(ExportIds, idsToStringAndTypeBatchMatchesIndividualLookups) {
               ql::exportIds::idToStringAndType(index, ids[i], localVocab))
         << "Mismatch at index " << i;
   }
+
+  // The same with removed quotes and only literals.
+  auto literalResults = ql::exportIds::idsToStringAndType<true, true>(
+      index, ql::span<const Id>{ids}, localVocab);
+  ASSERT_EQ(literalResults.size(), ids.size());
+  for (size_t i = 0; i < ids.size(); ++i) {
+    EXPECT_EQ(literalResults[i],
+              (ql::exportIds::idToStringAndType<true, true>(index, ids[i],
+                                                            localVocab)))
+        << "Mismatch at index " << i;
+  }
 }
 
 // _____________________________________________________________________________
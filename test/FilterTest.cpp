@@ -7,10 +7,13 @@
 #include "./PrefilterExpressionTestHelpers.h"
 #include "engine/Filter.h"
 #include "engine/IndexScan.h"
+#include "engine/QueryPlanner.h"
 #include "engine/ValuesForTesting.h"
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/NaryExpression.h"
 #include "engine/sparqlExpressions/SparqlExpression.h"
+#include "parser/SparqlParser.h"
+#include "util/GTestHelpers.h"
 #include "util/IdTableHelpers.h"
 #include "util/IndexTestHelpers.h"
 #include "util/OperationTestHelpers.h"
@@ -266,3 +269,61 @@ TEST(Filter, clone) {
   EXPECT_THAT(filter, IsDeepCopy(*clone));
   EXPECT_EQ(clone->getDescriptor(), filter.getDescriptor());
 }
+
+// _____________________________________________________________________________
+TEST(Filter, inlineLiteralsAndVocabularyStrings) {
+  // The literals with at most seven bytes are stored inline, the others are
+  // stored in the vocabulary. The comparisons have to follow the collation of
+  // the vocabulary. The input of the FILTER is an `IndexScan` that is sorted
+  // by `?o` and to which the FILTER is also passed as a prefilter.
+  ad_utility::testing::TestIndexConfig config{
+      "<s> <p> \"a\" . <s> <p> \"B\" . <s> <p> \"c\" . "
+      "<s> <p> \"b-longer-text\" . <s> <p> \"longerthan7\" . "
+      "<s> <p> \"Zebra-long\" . <s> <p> 42 ."};
+  config.encodeShortLiterals = true;
+  auto qec = ad_utility::testing::getQec(std::move(config));
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+
+  auto expectFilterResult = [&](std::string filter,
+                                const std::vector<std::string>& expected,
+                                ad_utility::source_location l =
+                                    AD_CURRENT_SOURCE_LOC()) {
+    auto trace = generateLocationTrace(l);
+    auto query = absl::StrCat("SELECT ?o WHERE { <s> <p> ?o FILTER(", filter,
+                              ") }");
+    QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+    auto qet = qp.createExecutionTree(SparqlParser::parseQuery(
+        &qec->getIndex().encodedIriManager(), std::move(query)));
+    auto result = qet.getResult();
+    std::vector<Id> ids;
+    for (const auto& row : result->idTable()) {
+      ids.push_back(row[0]);
+    }
+    std::vector<Id> expectedIds;
+    for (const auto& literal : expected) {
+      expectedIds.push_back(getId(literal));
+    }
+    EXPECT_THAT(ids, ::testing::UnorderedElementsAreArray(expectedIds));
+  };
+
+  // Inline literal as the reference value.
+  expectFilterResult("?o < \"c\"",
+                     {"\"a\"", "\"B\"", "\"b-longer-text\""});
+  expectFilterResult("?o >= \"c\"",
+                     {"\"c\"", "\"longerthan7\"", "\"Zebra-long\""});
+  expectFilterResult("?o > \"B\"",
+                     {"\"b-longer-text\"", "\"c\"", "\"longerthan7\"",
+                      "\"Zebra-long\""});
+  // Literal from the vocabulary as the reference value.
+  expectFilterResult("?o > \"b-longer-text\"",
+                     {"\"c\"", "\"longerthan7\"", "\"Zebra-long\""});
+  expectFilterResult("?o <= \"longerthan7\"",
+                     {"\"a\"", "\"B\"", "\"b-longer-text\"", "\"c\"",
+                      "\"longerthan7\""});
+  // Negated comparisons (the complement of the prefilter).
+  expectFilterResult("!(?o >= \"b-longer-text\")",
+                     {"\"a\"", "\"B\""});
+  // Equality is decided by the bits.
+  expectFilterResult("?o = \"c\"", {"\"c\""});
+  expectFilterResult("?o = \"Zebra-long\"", {"\"Zebra-long\""});
+}
@@ -106,7 +106,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
     return testing::ResultOf(
         absl::StrCat(".map_.at(", std::to_string(blockIndex), ")"),
         [blockIndex](const LocatedTriplesPerBlock& ltpb) {
-          return ltpb.map_.at(blockIndex);
+          return *ltpb.map_.at(blockIndex);
         },
         testing::Eq(expectedLTs));
   };
@@ -123,7 +123,8 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
               return locatedTriplesInBlock(blockIndex, expectedLTs);
             });
         // The macro does not work with templated types.
-        using HashMapType = ad_utility::HashMap<size_t, LocatedTriples>;
+        using HashMapType =
+            ad_utility::HashMap<size_t, std::shared_ptr<LocatedTriples>>;
         return testing::AllOf(
             AD_FIELD(LocatedTriplesPerBlock, map_,
                      AD_PROPERTY(HashMapType, size,
@@ -157,7 +158,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
               locatedTriplesAre(
                   {{0, {LT1, LT2, LT3}}, {1, {LT4, LT5}}, {3, {LT6, LT7}}}));
 
-  auto handles = locatedTriplesPerBlock.add(std::vector{LT8, LT9});
+  locatedTriplesPerBlock.add(std::vector{LT8, LT9});
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(4));
   EXPECT_THAT(locatedTriplesPerBlock, numTriplesTotal(9));
@@ -170,7 +171,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
                                  {2, {LT8}},
                                  {3, {LT6, LT7, LT9}}}));
 
-  locatedTriplesPerBlock.erase(2, handles[0]);
+  locatedTriplesPerBlock.erase(2, LT8.triple_);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(3));
@@ -184,7 +185,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
           {{0, {LT1, LT2, LT3}}, {1, {LT4, LT5}}, {3, {LT6, LT7, LT9}}}));
 
   // Erasing in a block that does not exist, raises an exception.
-  EXPECT_THROW(locatedTriplesPerBlock.erase(100, handles[1]),
+  EXPECT_THROW(locatedTriplesPerBlock.erase(100, LT9.triple_),
                ad_utility::Exception);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
@@ -199,7 +200,7 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
       locatedTriplesAre(
           {{0, {LT1, LT2, LT3}}, {1, {LT4, LT5}}, {3, {LT6, LT7, LT9}}}));
 
-  locatedTriplesPerBlock.erase(3, handles[1]);
+  locatedTriplesPerBlock.erase(3, LT9.triple_);
   locatedTriplesPerBlock.updateAugmentedMetadata();
 
   EXPECT_THAT(locatedTriplesPerBlock, numBlocks(3));
@@ -221,6 +222,50 @@ TEST_F(LocatedTriplesTest, numTriplesInBlock) {
   EXPECT_THAT(locatedTriplesPerBlock, locatedTriplesAre({}));
 }
 
+// Test that copies of a `LocatedTriplesPerBlock` share the located triples of
+// the blocks until they are modified.
+TEST_F(LocatedTriplesTest, copyOnWrite) {
+  using LT = LocatedTriple;
+  auto LT1 = LT{0, IT(1, 10, 10), true};
+  auto LT2 = LT{1, IT(20, 4, 0), true};
+  auto LT3 = LT{1, IT(21, 5, 0), false};
+  auto LT4 = LT{2, IT(30, 6, 0), true};
+  auto original = makeLocatedTriplesPerBlock({LT1, LT2});
+  auto copy = original;
+  auto blockAddress = [](const LocatedTriplesPerBlock& ltpb,
+                         size_t blockIndex) -> const LocatedTriples* {
+    auto block = ltpb.getUpdatesIfPresent(blockIndex);
+    return block ? &block.value() : nullptr;
+  };
+  EXPECT_EQ(blockAddress(original, 0), blockAddress(copy, 0));
+  EXPECT_EQ(blockAddress(original, 1), blockAddress(copy, 1));
+
+  // Only the modified blocks are copied, and the copy is unchanged.
+  original.add(std::vector{LT3, LT4});
+  original.erase(0, LT1.triple_);
+  EXPECT_EQ(original.numTriples(), 3);
+  EXPECT_EQ(blockAddress(original, 0), nullptr);
+  EXPECT_NE(blockAddress(original, 1), blockAddress(copy, 1));
+  EXPECT_EQ(original.getUpdatesIfPresent(1)->size(), 2);
+  EXPECT_EQ(copy.numTriples(), 2);
+  EXPECT_EQ(copy.getUpdatesIfPresent(0)->size(), 1);
+  EXPECT_EQ(copy.getUpdatesIfPresent(1)->size(), 1);
+  EXPECT_FALSE(copy.containsTriples(2));
+
+  // A block that is no longer shared is modified in place.
+  const auto* block1 = blockAddress(original, 1);
+  original.erase(1, LT3.triple_);
+  EXPECT_EQ(blockAddress(original, 1), block1);
+
+  // Erasing a triple that is not contained in the block throws.
+  EXPECT_THROW(original.erase(1, LT3.triple_), ad_utility::Exception);
+
+  // The diff only has to consider the blocks that are not shared.
+  auto [insertions, deletions] = original.computeDiff(copy);
+  EXPECT_THAT(insertions, ::testing::ElementsAre(LT4.triple_));
+  EXPECT_THAT(deletions, ::testing::IsEmpty());
+}
+
 // Test the method that merges the matching `LocatedTriple`s from a block into
 // an `IdTable`.
 TEST_F(LocatedTriplesTest, mergeTriples) {
@@ -708,6 +753,21 @@ TEST_F(LocatedTriplesTest, locatedTriple) {
                      LT(1, T2, false), LT(0, T1, false)}));
   }
 
+  {
+    // Triples in an arbitrary order are located in the same blocks as in the
+    // sorted case, and the result is in the order of the input.
+    auto locatedTriples = LocatedTriple::locateTriplesInPermutation(
+        std::vector<IdTriple<0>>{T4, T1, T8, T3, T6, T2, T7, T5},
+        Span{CBM(PT1, PT1), CBM(PT2, PT3), CBM(PT4, PT5), CBM(PT6, PT7),
+             CBM(PT8, PT8)},
+        keyOrder, true, handle);
+    EXPECT_THAT(locatedTriples,
+                testing::ElementsAreArray({LT(1, T4, true), LT(0, T1, true),
+                                           LT(5, T8, true), LT(1, T3, true),
+                                           LT(3, T6, true), LT(1, T2, true),
+                                           LT(4, T7, true), LT(2, T5, true)}));
+  }
+
   {
     // All triples are in one block.
     auto locatedTriples = LocatedTriple::locateTriplesInPermutation(
@@ -791,9 +851,9 @@ TEST_F(LocatedTriplesTest, augmentedMetadata) {
                 testing::ElementsAreArray(expectedAugmentedMetadata));
 
     // T4 is before block 4. The beginning of block 4 changes.
-    auto handles =
-        locatedTriplesPerBlock.add(LocatedTriple::locateTriplesInPermutation(
-            Span{T4}, metadata, keyOrder, true, handle));
+    auto locatedT4 = LocatedTriple::locateTriplesInPermutation(
+        Span{T4}, metadata, keyOrder, true, handle);
+    locatedTriplesPerBlock.add(locatedT4);
     locatedTriplesPerBlock.updateAugmentedMetadata();
 
     expectedAugmentedMetadata[4] = CBM(T4.toPermutedTriple(), PT8);
@@ -802,7 +862,7 @@ TEST_F(LocatedTriplesTest, augmentedMetadata) {
                 testing::ElementsAreArray(expectedAugmentedMetadata));
 
     // Erasing the update of T4 restores the beginning of block 4.
-    locatedTriplesPerBlock.erase(4, handles[0]);
+    locatedTriplesPerBlock.erase(4, locatedT4[0].triple_);
     locatedTriplesPerBlock.updateAugmentedMetadata();
 
     expectedAugmentedMetadata[4] = CBM(PT8, PT8);
@@ -8,6 +8,7 @@
 // which can be found in the `LICENSE` file at the root of the QLever project.
 
 #include <absl/cleanup/cleanup.h>
+#include <absl/strings/str_cat.h>
 #include <gmock/gmock.h>
 
 #include <functional>
@@ -17,6 +18,7 @@
 #include "./ServerTestHelpers.h"
 #include "./util/HttpRequestHelpers.h"
 #include "./util/RuntimeParametersTestHelpers.h"
+#include "engine/ExecuteUpdate.h"
 #include "engine/IndexScan.h"
 #include "engine/MaterializedViews.h"
 #include "engine/MaterializedViewsQueryAnalysis.h"
@@ -29,6 +31,7 @@
 #include "engine/sparqlExpressions/LiteralExpression.h"
 #include "engine/sparqlExpressions/SparqlExpressionPimpl.h"
 #include "index/EncodedIriManager.h"
+#include "index/IndexImpl.h"
 #include "parser/MaterializedViewQuery.h"
 #include "parser/SparqlParser.h"
 #include "parser/SparqlTriple.h"
@@ -472,6 +475,75 @@ TEST_F(MaterializedViewsTest, ColumnPermutation) {
   }
 }
 
+// _____________________________________________________________________________
+TEST_F(MaterializedViewsTest, AdditionalColumnOrders) {
+  SKIP_IF_LOGLEVEL_IS_LOWER(INFO);
+  MaterializedViewsManager manager{testIndexBase_};
+  const std::string query = "SELECT ?s ?o ?g { ?s <p1> ?o . BIND(1 AS ?g) }";
+  auto write = [&](std::vector<MaterializedViewColumnOrder> orders) {
+    manager.writeViewToDisk("testView1", qlv().parseAndPlanQuery(query),
+                            ad_utility::MemorySize::megabytes(1),
+                            ad_utility::makeUnlimitedAllocator<Id>(), orders);
+  };
+
+  // The query result is computed only once for all the column orders.
+  clearLog();
+  write({{"testView1ByO", V{"?o"}}, {"testView1ByG", V{"?g"}}});
+  auto logString = log_.str();
+  auto pos = logString.find("Computing query result");
+  ASSERT_NE(pos, std::string::npos);
+  EXPECT_EQ(logString.find("Computing query result", pos + 1),
+            std::string::npos);
+  for (std::string name : {"testView1", "testView1ByO", "testView1ByG"}) {
+    EXPECT_THAT(logString,
+                ::testing::HasSubstr(absl::StrCat(
+                    "Materialized view \"", name, "\" written to disk")));
+  }
+
+  // The additional views have the requested first column, followed by the
+  // other columns in their original order.
+  auto view = manager.getView("testView1ByO");
+  VariableToColumnMap expected{{V{"?o"}, makeAlwaysDefinedColumn(0)},
+                               {V{"?s"}, makeAlwaysDefinedColumn(1)},
+                               {V{"?g"}, makeAlwaysDefinedColumn(2)}};
+  EXPECT_THAT(view->variableToColumnMap(),
+              ::testing::UnorderedElementsAreArray(expected));
+  EXPECT_EQ(manager.getView("testView1ByG")
+                ->variableToColumnMap()
+                .at(V{"?g"})
+                .columnIndex_,
+            0);
+
+  // Each view can be scanned by its first column.
+  auto res = qlv().query(
+      "PREFIX view: <https://qlever.cs.uni-freiburg.de/materializedView/>"
+      "SELECT ?o ?s { ?o view:testView1ByO-s ?s }",
+      ad_utility::MediaType::tsv);
+  EXPECT_EQ(res, "?o\t?s\n\"abc\"\t<s1>\n\"xyz\"\t<s2>\n");
+  res = qlv().query(
+      "PREFIX view: <https://qlever.cs.uni-freiburg.de/materializedView/>"
+      "SELECT ?s { <s2> view:testView1-o ?o . ?o view:testView1ByO-s ?s }",
+      ad_utility::MediaType::tsv);
+  EXPECT_EQ(res, "?s\n<s2>\n");
+
+  // Invalid column orders.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      write({{"testView1ByX", V{"?x"}}}),
+      ::testing::HasSubstr("is not selected by the query"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      write({{"testView1ByS", V{"?s"}}}),
+      ::testing::HasSubstr("is already the first column"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      write({{"testView1ByO", V{"?o"}}, {"testView1ByO", V{"?g"}}}),
+      ::testing::HasSubstr("is used for more than one column order"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      write({{"testView1", V{"?o"}}}),
+      ::testing::HasSubstr("is used for more than one column order"));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      write({{"testView1.ByO", V{"?o"}}}),
+      ::testing::HasSubstr("not a valid name for a materialized view"));
+}
+
 // _____________________________________________________________________________
 TEST_F(MaterializedViewsTest, InvalidInputToWriter) {
   MaterializedViewsManager manager{testIndexBase_};
@@ -1721,3 +1793,190 @@ TEST_F(MaterializedViewsTest, JoinBetweenLazyScansWithPlaceholderVars) {
             "more than one column in common."));
   }
 }
+
+// _____________________________________________________________________________
+TEST_F(MaterializedViewsTest, IncrementalMaintenanceUnderUpdates) {
+  const std::string joinQuery = "SELECT ?s ?x ?y { ?s <p1> ?x . ?s <p2> ?y }";
+  qlv().writeMaterializedView("joinView", joinQuery);
+  qlv().loadMaterializedView("joinView");
+  qlv().writeMaterializedView(
+      "bindView", "SELECT ?s ?x ?y { ?s <p1> ?x . BIND(1 AS ?y) }");
+  qlv().loadMaterializedView("bindView");
+
+  // Execute the given SPARQL `update` on the index of `qlv()`.
+  auto executeUpdate = [this](const std::string& update) {
+    auto qec = std::get<1>(qlv().parseAndPlanQuery("SELECT * {}"));
+    auto& index = const_cast<Index&>(qec->getIndex());
+    auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+    ad_utility::BlankNodeManager bnm;
+    auto pqs = SparqlParser::parseUpdate(
+        &bnm, &index.getImpl().encodedIriManager(), update);
+    index.deltaTriplesManager().modify<void>([&](DeltaTriples& deltaTriples) {
+      qec->setLocatedTriplesForEvaluation(
+          deltaTriples.getLocatedTriplesSharedStateReference());
+      for (auto& pq : pqs) {
+        deltaTriples.updateAugmentedMetadata();
+        QueryPlanner qp{qec.get(), handle};
+        auto updateQet = qp.createExecutionTree(pq);
+        ExecuteUpdate::executeUpdate(index, pq, updateQet, deltaTriples,
+                                     handle);
+      }
+    });
+  };
+
+  // The rows of the `joinView` must always be the result of its query.
+  auto expectViewIsUpToDate = [&](size_t expectedNumRows,
+                                  ad_utility::source_location location =
+                                      AD_CURRENT_SOURCE_LOC()) {
+    auto trace = generateLocationTrace(location);
+    auto viewRows = getQueryResultAsIdTable(R"(
+      PREFIX view: <https://qlever.cs.uni-freiburg.de/materializedView/>
+      SELECT ?s ?x ?y {
+        SERVICE view:joinView {
+          _:config view:column-s ?s ;
+                   view:column-x ?x ;
+                   view:column-y ?y .
+        }
+      }
+    )");
+    EXPECT_EQ(viewRows.numRows(), expectedNumRows);
+    EXPECT_THAT(viewRows, matchesIdTable(getQueryResultAsIdTable(
+                              joinQuery + " INTERNAL SORT BY ?s ?x ?y")));
+  };
+  auto qec = std::get<1>(qlv().parseAndPlanQuery("SELECT * {}"));
+  const auto& manager = qec->materializedViewsManager();
+  expectViewIsUpToDate(1);
+
+  // Inserting a triple adds a row to the view.
+  executeUpdate("INSERT DATA { <s2> <p2> 5 }");
+  expectViewIsUpToDate(2);
+  EXPECT_FALSE(manager.getView("joinView")->isStale());
+
+  // The view with a `BIND` can't be maintained.
+  EXPECT_TRUE(manager.getView("bindView")->isStale());
+
+  // Deleting a triple removes a row from the view.
+  executeUpdate("DELETE DATA { <s1> <p1> \"abc\" }");
+  expectViewIsUpToDate(1);
+
+  // Reinserting the triple restores the row that is stored on disk.
+  executeUpdate("INSERT DATA { <s1> <p1> \"abc\" }");
+  expectViewIsUpToDate(2);
+
+  // Triples that don't match the view don't change it.
+  executeUpdate("INSERT DATA { <s1> <p3> <s2> }");
+  expectViewIsUpToDate(2);
+  EXPECT_FALSE(manager.getView("joinView")->isStale());
+
+  // New IRIs and literals (which are stored in the local vocab of the delta
+  // triples) and blank nodes are also maintained, across several updates.
+  executeUpdate("INSERT DATA { <s3> <p1> 7 . <s3> <p2> \"new\" }");
+  expectViewIsUpToDate(3);
+  executeUpdate("INSERT DATA { _:b <p1> 9 . _:b <p2> 10 }");
+  expectViewIsUpToDate(4);
+  executeUpdate("INSERT DATA { <s3> <p2> <s4> }");
+  expectViewIsUpToDate(5);
+  executeUpdate("DELETE DATA { <s3> <p2> \"new\" }");
+  expectViewIsUpToDate(4);
+  executeUpdate("DELETE WHERE { ?s <p1> 9 }");
+  expectViewIsUpToDate(3);
+  executeUpdate("INSERT DATA { <s1> <p1> <s3> }");
+  expectViewIsUpToDate(4);
+  EXPECT_FALSE(manager.getView("joinView")->isStale());
+  EXPECT_TRUE(manager.hasViewsToMaintain());
+
+  // After all delta triples are removed, the views can't be maintained.
+  manager.markAllViewsStale("the delta triples were cleared");
+  EXPECT_TRUE(manager.getView("joinView")->isStale());
+  EXPECT_FALSE(manager.hasViewsToMaintain());
+}
+
+// _____________________________________________________________________________
+class MaterializedViewsAggregateTest : public MaterializedViewsTest {
+ protected:
+  std::string getDummyTurtle() const override {
+    return "<a> <p> 1 . <a> <p> 2 . <a> <q> 3 . "
+           "<b> <p> 4 . <b> <q> 5 . <b> <q> 6 .";
+  }
+};
+
+// _____________________________________________________________________________
+TEST_F(MaterializedViewsAggregateTest, AggregateRewrite) {
+  qlv().writeMaterializedView("aggView", R"(
+    SELECT ?s ?p (COUNT(?o) AS ?cnt) (SUM(?o) AS ?sum) (MIN(?o) AS ?min)
+           (MAX(?o) AS ?max) (AVG(?o) AS ?avg) {
+      ?s ?p ?o
+    } GROUP BY ?s ?p
+  )");
+  qlv().loadMaterializedView("aggView");
+
+  // The `query` is rewritten to re-aggregate the view, s.t. the `GROUP BY`
+  // has the `expectedAliases`. The result is the same as without rewriting.
+  auto expectRewrite = [&](const std::string& query,
+                           const std::vector<Variable>& expectedGroupBy,
+                           const std::vector<std::string>& expectedAliases,
+                           ad_utility::source_location location =
+                               AD_CURRENT_SOURCE_LOC()) {
+    auto trace = generateLocationTrace(location);
+    qpExpect(qlv(), query,
+             h::GroupBy(expectedGroupBy, expectedAliases, ::testing::_));
+    auto actual = getQueryResultAsIdTable(query);
+    auto cleanup = setRuntimeParameterForTest<
+        &RuntimeParameters::enableMaterializedViewQueryRewrite_>(false);
+    EXPECT_THAT(actual, matchesIdTable(getQueryResultAsIdTable(query)));
+  };
+  static constexpr std::string_view agg = "?_ql_materialized_view_agg_";
+
+  // Roll up the grouping by subject and predicate to the subject.
+  expectRewrite(
+      "SELECT ?s (COUNT(?o) AS ?c) (SUM(?o) AS ?x) (MIN(?o) AS ?y) "
+      "(MAX(?o) AS ?z) (AVG(?o) AS ?a) { ?s ?p ?o } GROUP BY ?s "
+      "ORDER BY ?s",
+      {V{"?s"}},
+      {absl::StrCat("(SUM(", agg, "1) as ?c)"),
+       absl::StrCat("(SUM(", agg, "2) as ?x)"),
+       absl::StrCat("(MIN(", agg, "3) as ?y)"),
+       absl::StrCat("(MAX(", agg, "4) as ?z)"),
+       absl::StrCat("((SUM(", agg, "2) / SUM(", agg, "1)) as ?a)")});
+
+  // Renamed variables, `COUNT(*)`, and grouping by a column that is not the
+  // first column of the view.
+  expectRewrite(
+      "SELECT ?y (COUNT(*) AS ?n) { ?x ?y ?z } GROUP BY ?y ORDER BY ?y",
+      {V{"?y"}}, {absl::StrCat("(SUM(", agg, "1) as ?n)")});
+
+  // Aggregation without `GROUP BY`.
+  expectRewrite("SELECT (SUM(?o) AS ?total) { ?s ?p ?o }", {},
+                {absl::StrCat("(SUM(", agg, "0) as ?total)")});
+
+  // A `FILTER` on a grouped column of the view is applied to its rows.
+  expectRewrite(
+      "SELECT ?s (MAX(?o) AS ?m) { ?s ?p ?o FILTER(?p = <q>) } GROUP BY ?s "
+      "ORDER BY ?s",
+      {V{"?s"}}, {absl::StrCat("(MAX(", agg, "2) as ?m)")});
+
+  // Queries that can't be answered from the view are not rewritten.
+  auto expectNoRewrite = [&](const std::string& query,
+                             const std::vector<Variable>& expectedGroupBy,
+                             const std::vector<std::string>& expectedAliases,
+                             ad_utility::source_location location =
+                                 AD_CURRENT_SOURCE_LOC()) {
+    auto trace = generateLocationTrace(location);
+    qpExpect(qlv(), query,
+             h::GroupBy(expectedGroupBy, expectedAliases, ::testing::_));
+  };
+  // Grouping by a column that is not grouped in the view.
+  expectNoRewrite("SELECT ?o (COUNT(?s) AS ?c) { ?s ?p ?o } GROUP BY ?o",
+                  {V{"?o"}}, {"(COUNT(?s) as ?c)"});
+  // A `DISTINCT` aggregate.
+  expectNoRewrite(
+      "SELECT ?s (COUNT(DISTINCT ?o) AS ?c) { ?s ?p ?o } GROUP BY ?s",
+      {V{"?s"}}, {"(COUNT(DISTINCT ?o) as ?c)"});
+  // A `FILTER` on a column that is aggregated in the view.
+  expectNoRewrite(
+      "SELECT ?s (SUM(?o) AS ?x) { ?s ?p ?o FILTER(?o > 1) } GROUP BY ?s",
+      {V{"?s"}}, {"(SUM(?o) as ?x)"});
+  // A different basic graph pattern.
+  expectNoRewrite("SELECT ?s (SUM(?o) AS ?x) { ?s <p> ?o } GROUP BY ?s",
+                  {V{"?s"}}, {"(SUM(?o) as ?x)"});
+}
@@ -5,6 +5,7 @@
 #include <absl/cleanup/cleanup.h>
 #include <gmock/gmock.h>
 
+#include <future>
 #include <optional>
 
 #include "engine/IndexScan.h"
@@ -905,3 +906,152 @@ TEST(OperationTest, disableCachingGlobally) {
   EXPECT_EQ(valuesForTesting.getResult(false, ComputationMode::ONLY_IF_CACHED),
             nullptr);
 }
+
+// _____________________________________________________________________________
+TEST(OperationTest, limitedResultIsDerivedFromCachedResult) {
+  auto qec = getQec();
+  qec->getQueryTreeCache().clearAll();
+  auto makeValues = [qec]() {
+    return ValuesForTesting{qec, makeIdTableFromVector({{1}, {2}, {3}, {4}}),
+                            {Variable{"?x"}}};
+  };
+  // Cache the result without a `LIMIT`.
+  {
+    auto values = makeValues();
+    values.getResult(true);
+  }
+
+  // The result with a `LIMIT` and `OFFSET` is derived from the cached result.
+  {
+    auto values = makeValues();
+    values.applyLimitOffset({2, 1});
+    auto result = values.getResult(true);
+    EXPECT_EQ(result->idTable(), makeIdTableFromVector({{2}, {3}}));
+    auto& rti = values.runtimeInfo();
+    EXPECT_EQ(rti.cacheStatus_, CacheStatus::cachedNotPinned);
+    EXPECT_EQ(rti.details_["derived-from-cached-result"], "limit-offset");
+  }
+
+  // Copying the rows is more expensive than computing the result, so the
+  // result is computed.
+  {
+    auto values = makeValues();
+    values.costEstimate() = 1;
+    values.applyLimitOffset({3, 0});
+    auto result = values.getResult(true);
+    EXPECT_EQ(result->idTable(), makeIdTableFromVector({{1}, {2}, {3}}));
+    auto& rti = values.runtimeInfo();
+    EXPECT_EQ(rti.cacheStatus_, CacheStatus::computed);
+    EXPECT_FALSE(rti.details_.contains("derived-from-cached-result"));
+  }
+}
+
+// _____________________________________________________________________________
+TEST(Operation, lazyResultIsSharedWithConcurrentQuery) {
+  auto qec = getQec();
+  auto makeValues = [qec]() {
+    std::vector<IdTable> idTablesVector{};
+    idTablesVector.push_back(makeIdTableFromVector({{1}, {2}}));
+    idTablesVector.push_back(makeIdTableFromVector({{3}}));
+    idTablesVector.push_back(makeIdTableFromVector({{4}, {5}}));
+    return ValuesForTesting{qec, std::move(idTablesVector), {Variable{"?x"}}};
+  };
+  auto expected = makeIdTableFromVector({{1}, {2}, {3}, {4}, {5}});
+  // Append at most `maxNumChunks` chunks of `chunks` to `table`.
+  auto consume = [](auto& chunks, IdTable& table,
+                    size_t maxNumChunks = std::numeric_limits<size_t>::max()) {
+    for (size_t i = 0; i < maxNumChunks; ++i) {
+      auto chunk = chunks.get();
+      if (!chunk.has_value()) {
+        return;
+      }
+      table.insertAtEnd(chunk->idTable_);
+    }
+  };
+
+  // The second operation consumes the chunks that are computed by the first
+  // one, the runtime information of each operation is only updated by its own
+  // consumer.
+  {
+    qec->getQueryTreeCache().clearAll();
+    auto owner = makeValues();
+    auto other = makeValues();
+    auto ownerResult =
+        owner.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+    auto otherResult =
+        other.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+    ASSERT_FALSE(ownerResult->isFullyMaterialized());
+    ASSERT_FALSE(otherResult->isFullyMaterialized());
+    EXPECT_FALSE(
+        owner.runtimeInfo().details_.contains("shared-with-concurrent-query"));
+    EXPECT_TRUE(
+        other.runtimeInfo().details_.contains("shared-with-concurrent-query"));
+
+    auto ownerChunks = ownerResult->idTables();
+    auto otherChunks = otherResult->idTables();
+    IdTable ownerTable{1, makeAllocator()};
+    IdTable otherTable{1, makeAllocator()};
+    consume(ownerChunks, ownerTable);
+    EXPECT_EQ(owner.runtimeInfo().numRows_, 5);
+    EXPECT_EQ(other.runtimeInfo().numRows_, 0);
+    consume(otherChunks, otherTable);
+    EXPECT_EQ(ownerTable, expected);
+    EXPECT_EQ(otherTable, expected);
+    EXPECT_EQ(owner.runtimeInfo().numRows_, 5);
+    EXPECT_EQ(other.runtimeInfo().numRows_, 5);
+    EXPECT_EQ(other.runtimeInfo().status_,
+              Status::lazilyMaterializedCompleted);
+  }
+
+  // The second operation falls too far behind, so it is detached from the
+  // shared result, recomputes it, and skips the rows it has already consumed.
+  {
+    qec->getQueryTreeCache().clearAll();
+    auto restoreWhenScopeEnds = setRuntimeParameterForTest<
+        &RuntimeParameters::lazyResultSharingMaxMemory_>(
+        ad_utility::MemorySize::bytes(sizeof(Id)));
+    auto owner = makeValues();
+    auto other = makeValues();
+    auto ownerResult =
+        owner.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+    auto otherResult =
+        other.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+    EXPECT_TRUE(
+        other.runtimeInfo().details_.contains("shared-with-concurrent-query"));
+
+    auto ownerChunks = ownerResult->idTables();
+    auto otherChunks = otherResult->idTables();
+    IdTable ownerTable{1, makeAllocator()};
+    IdTable otherTable{1, makeAllocator()};
+    consume(ownerChunks, ownerTable, 1);
+    consume(otherChunks, otherTable, 1);
+    EXPECT_EQ(otherTable, makeIdTableFromVector({{1}, {2}}));
+    consume(ownerChunks, ownerTable);
+    consume(otherChunks, otherTable);
+    EXPECT_EQ(ownerTable, expected);
+    EXPECT_EQ(otherTable, expected);
+  }
+
+  // Both operations are computed and consumed concurrently. Whether the
+  // result is shared depends on the timing, but both results are complete.
+  {
+    qec->getQueryTreeCache().clearAll();
+    auto computeAndConsume = [&]() {
+      auto values = makeValues();
+      auto result =
+          values.getResult(false, ComputationMode::LAZY_IF_SUPPORTED);
+      IdTable table{1, makeAllocator()};
+      if (result->isFullyMaterialized()) {
+        table.insertAtEnd(result->idTable());
+      } else {
+        auto chunks = result->idTables();
+        consume(chunks, table);
+      }
+      return table;
+    };
+    auto first = std::async(std::launch::async, computeAndConsume);
+    auto second = std::async(std::launch::async, computeAndConsume);
+    EXPECT_EQ(first.get(), expected);
+    EXPECT_EQ(second.get(), expected);
+  }
+}
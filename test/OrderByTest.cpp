@@ -198,6 +198,46 @@ TEST(OrderBy, mixedDatatypes) {
               {true});
 }
 
+// _____________________________________________________________________________
+TEST(OrderBy, inlineLiteralsAndVocabularyStrings) {
+  // The literals with at most seven bytes are stored inline, the others are
+  // stored in the vocabulary. ORDER BY has to interleave them according to the
+  // collation of the vocabulary.
+  ad_utility::testing::TestIndexConfig config{
+      "<s> <p> \"a\" . <s> <p> \"B\" . <s> <p> \"c\" . "
+      "<s> <p> \"b-longer-text\" . <s> <p> \"longerthan7\" . "
+      "<s> <p> \"Zebra-long\" ."};
+  config.encodeShortLiterals = true;
+  auto qec = ad_utility::testing::getQec(std::move(config));
+  auto getId = ad_utility::testing::makeGetId(qec->getIndex());
+  ASSERT_EQ(getId("\"a\"").getDatatype(), Datatype::InlineLiteral);
+  ASSERT_EQ(getId("\"longerthan7\"").getDatatype(), Datatype::VocabIndex);
+
+  std::vector<std::string> sorted{"\"a\"",           "\"B\"",
+                                  "\"b-longer-text\"", "\"c\"",
+                                  "\"longerthan7\"",   "\"Zebra-long\""};
+  for (bool isDescending : {false, true}) {
+    IdTable input{1, qec->getAllocator()};
+    for (const auto& literal : sorted) {
+      input.push_back({getId(literal)});
+    }
+    randomShuffle(input.begin(), input.end());
+    auto subtree = ad_utility::makeExecutionTree<ValuesForTesting>(
+        qec, std::move(input), std::vector{std::optional{Variable{"?o"}}});
+    OrderBy orderBy{qec, std::move(subtree), {{0, isDescending}}};
+    auto result = orderBy.getResult();
+    std::vector<std::string> expected = sorted;
+    if (isDescending) {
+      ql::ranges::reverse(expected);
+    }
+    IdTable expectedTable{1, qec->getAllocator()};
+    for (const auto& literal : expected) {
+      expectedTable.push_back({getId(literal)});
+    }
+    EXPECT_EQ(result->idTable(), expectedTable);
+  }
+}
+
 // _____________________________________________________________________________
 TEST(OrderBy, simpleMemberFunctions) {
   {
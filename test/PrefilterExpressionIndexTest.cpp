@@ -1230,6 +1230,38 @@ TEST_F(PrefilterExpressionOnMetadataTest, testWithFewBlockMetadataValues) {
             std::vector<CompressedBlockMetadata>{});
 }
 
+//______________________________________________________________________________
+// Test the evaluation on the zone map of a column by which the blocks are not
+// sorted.
+TEST_F(PrefilterExpressionOnMetadataTest, testMayBeTrueForZoneMap) {
+  ColumnZoneMap zoneMap{{IntId(0), IntId(10)},
+                        {DoubleId(2.5), DoubleId(4.5)},
+                        {referenceDate1, referenceDate2}};
+  auto mayBeTrue = [this, &zoneMap](std::unique_ptr<PrefilterExpression> expr) {
+    return expr->mayBeTrueForZoneMap(lvc, zoneMap);
+  };
+  EXPECT_TRUE(mayBeTrue(gt(IntId(8))));
+  EXPECT_FALSE(mayBeTrue(gt(IntId(20))));
+  EXPECT_TRUE(mayBeTrue(lt(DoubleId(1.0))));
+  EXPECT_TRUE(mayBeTrue(andExpr(gt(DoubleId(3.0)), lt(IntId(4)))));
+  EXPECT_FALSE(mayBeTrue(andExpr(gt(IntId(10)), lt(IntId(20)))));
+  EXPECT_FALSE(mayBeTrue(gt(referenceDate2)));
+  EXPECT_TRUE(mayBeTrue(ge(referenceDate2)));
+  EXPECT_TRUE(mayBeTrue(eq(referenceDateEqual)));
+  EXPECT_FALSE(mayBeTrue(eq(IntId(11))));
+  EXPECT_TRUE(mayBeTrue(isNum()));
+  EXPECT_FALSE(mayBeTrue(isIri()));
+  EXPECT_TRUE(mayBeTrue(notExpr(isNum())));
+
+  zoneMap = {{IntId(0), IntId(10)}};
+  EXPECT_FALSE(mayBeTrue(notExpr(isNum())));
+  EXPECT_FALSE(mayBeTrue(gt(referenceDate1)));
+
+  // An empty zone map contains no values.
+  zoneMap.clear();
+  EXPECT_FALSE(mayBeTrue(gt(IntId(0))));
+}
+
 //______________________________________________________________________________
 // Test method clone. clone() creates a copy of the complete PrefilterExpression
 // tree.
@@ -0,0 +1,308 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <future>
+#include <thread>
+
+#include "engine/HttpError.h"
+#include "engine/QueryAdmissionController.h"
+#include "util/AsioHelpers.h"
+#include "util/GTestHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
+
+using namespace ad_utility::memory_literals;
+using Controller = QueryAdmissionController;
+using enum QueryPriority;
+
+namespace {
+// The number of running, waiting, and rejected queries of the `controller`.
+using Stats = std::tuple<size_t, size_t, size_t>;
+Stats stats(const Controller& controller) {
+  auto s = controller.getStatistics();
+  return {s.numRunning_, s.numWaiting_, s.numRejected_};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, priorityToString) {
+  EXPECT_EQ(toString(Interactive), "interactive");
+  EXPECT_EQ(toString(Batch), "batch");
+  EXPECT_EQ(parseQueryPriority("interactive"), Interactive);
+  EXPECT_EQ(parseQueryPriority("batch"), Batch);
+  EXPECT_EQ(parseQueryPriority("Batch"), std::nullopt);
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, concurrencyLimitAndOrder) {
+  auto c1 = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionMaxConcurrentQueries_>(1);
+  Controller controller{1_GB};
+  auto now = Controller::Clock::now();
+
+  auto running =
+      controller.tryAdmit(controller.enqueue({Batch, 100}, now), now);
+  ASSERT_TRUE(running.has_value());
+  EXPECT_EQ(running->waitTime(), std::chrono::milliseconds{0});
+
+  // The slot is taken, so all further queries wait.
+  auto expensive = controller.enqueue({Interactive, 1000}, now);
+  auto batch = controller.enqueue({Batch, 1}, now);
+  auto cheap = controller.enqueue({Interactive, 10}, now);
+  EXPECT_EQ(stats(controller), Stats(1, 3, 0));
+  EXPECT_FALSE(controller.tryAdmit(cheap, now).has_value());
+
+  // Interactive queries come first, the cheapest one first, and only the best
+  // waiting query is admitted.
+  running.reset();
+  EXPECT_FALSE(controller.tryAdmit(expensive, now).has_value());
+  EXPECT_FALSE(controller.tryAdmit(batch, now).has_value());
+  auto later = now + std::chrono::seconds{2};
+  running = controller.tryAdmit(cheap, later);
+  ASSERT_TRUE(running.has_value());
+  EXPECT_EQ(running->waitTime(), std::chrono::seconds{2});
+
+  running.reset();
+  running = controller.tryAdmit(expensive, later);
+  ASSERT_TRUE(running.has_value());
+  running.reset();
+  EXPECT_TRUE(controller.tryAdmit(batch, later).has_value());
+  EXPECT_EQ(stats(controller), Stats(0, 0, 0));
+  EXPECT_EQ(controller.getStatistics().numAdmitted_, 4u);
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, costIsReducedByWaitTime) {
+  auto c1 = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionMaxConcurrentQueries_>(1);
+  Controller controller{1_GB};
+  auto now = Controller::Clock::now();
+  auto running =
+      controller.tryAdmit(controller.enqueue({Batch, 0}, now), now);
+  ASSERT_TRUE(running.has_value());
+
+  // The expensive query has waited so long that its cost is now lower than
+  // the cost of the cheap query that just arrived.
+  auto expensive = controller.enqueue({Interactive, 1000}, now);
+  auto later = now + std::chrono::seconds{199};
+  auto cheap = controller.enqueue({Interactive, 10}, later);
+  running.reset();
+  EXPECT_FALSE(controller.tryAdmit(cheap, later).has_value());
+  EXPECT_TRUE(controller.tryAdmit(expensive, later).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, batchQueriesDoNotStarve) {
+  auto c1 = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionMaxConcurrentQueries_>(1);
+  std::chrono::seconds timeout{60};
+  auto c2 = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionStarvationTimeout_>(timeout);
+  Controller controller{1_GB};
+  auto now = Controller::Clock::now();
+  auto running =
+      controller.tryAdmit(controller.enqueue({Batch, 0}, now), now);
+  ASSERT_TRUE(running.has_value());
+
+  // Before the starvation timeout, interactive queries always come first.
+  auto batch = controller.enqueue({Batch, 1}, now);
+  auto idle = controller.enqueue({Batch, 1, true}, now);
+  auto later = now + std::chrono::seconds{30};
+  auto interactive = controller.enqueue({Interactive, 1000}, later);
+  running.reset();
+  EXPECT_FALSE(controller.tryAdmit(batch, later).has_value());
+  running = controller.tryAdmit(interactive, later);
+  ASSERT_TRUE(running.has_value());
+
+  // After the timeout, the batch query is admitted before the interactive
+  // queries. The queries that may only run when the server is idle still come
+  // last.
+  auto muchLater = now + timeout + std::chrono::seconds{1};
+  interactive = controller.enqueue({Interactive, 0}, muchLater);
+  running.reset();
+  EXPECT_FALSE(controller.tryAdmit(interactive, muchLater).has_value());
+  EXPECT_FALSE(controller.tryAdmit(idle, muchLater).has_value());
+  running = controller.tryAdmit(batch, muchLater);
+  ASSERT_TRUE(running.has_value());
+
+  // A timeout of zero disables this.
+  auto c3 = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionStarvationTimeout_>(std::chrono::seconds{0});
+  batch = controller.enqueue({Batch, 0}, now);
+  running.reset();
+  EXPECT_FALSE(controller.tryAdmit(batch, muchLater).has_value());
+  EXPECT_TRUE(controller.tryAdmit(interactive, muchLater).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, memoryBudgets) {
+  Controller controller{1_GB};
+  EXPECT_EQ(controller.memoryBudgetPerQuery(), std::nullopt);
+
+  auto c1 =
+      setRuntimeParameterForTest<&RuntimeParameters::queryMemoryBudget_>(
+          400_MB);
+  EXPECT_EQ(controller.memoryBudgetPerQuery(), 400_MB);
+  auto now = Controller::Clock::now();
+  auto first = controller.tryAdmit(controller.enqueue({}, now), now);
+  auto second = controller.tryAdmit(controller.enqueue({}, now), now);
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(first->reservedMemory(), 400_MB);
+  EXPECT_EQ(controller.getStatistics().reservedMemory_, 800_MB);
+
+  // There is no budget left for a third query.
+  auto third = controller.enqueue({}, now);
+  EXPECT_FALSE(controller.tryAdmit(third, now).has_value());
+  first.reset();
+  EXPECT_TRUE(controller.tryAdmit(third, now).has_value());
+
+  // Budgets that are larger than the memory of the server are reduced.
+  auto c2 =
+      setRuntimeParameterForTest<&RuntimeParameters::queryMemoryBudget_>(
+          2_GB);
+  EXPECT_EQ(controller.memoryBudgetPerQuery(), 1_GB);
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, rejectionAndWithdrawal) {
+  auto c1 = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionMaxConcurrentQueries_>(1);
+  auto c2 =
+      setRuntimeParameterForTest<&RuntimeParameters::admissionMaxQueueLength_>(
+          1);
+  Controller controller{1_GB};
+  auto now = Controller::Clock::now();
+  auto running = controller.tryAdmit(controller.enqueue({}, now), now);
+  ASSERT_TRUE(running.has_value());
+  auto waiting = controller.enqueue({}, now);
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      controller.enqueue({}, now),
+      ::testing::HasSubstr("1 queries are already waiting"), HttpError);
+  EXPECT_EQ(stats(controller), Stats(1, 1, 1));
+
+  // A withdrawn query frees its place in the queue.
+  controller.withdraw(waiting);
+  EXPECT_EQ(stats(controller), Stats(1, 0, 1));
+  EXPECT_NO_THROW(controller.enqueue({}, now));
+
+  // With a queue length of zero, queries are only rejected if they can't be
+  // admitted immediately.
+  auto c3 =
+      setRuntimeParameterForTest<&RuntimeParameters::admissionMaxQueueLength_>(
+          0);
+  Controller other{1_GB};
+  EXPECT_NO_THROW(other.enqueue({}, now));
+  EXPECT_THROW(other.enqueue({}, now), HttpError);
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, admit) {
+  auto c1 = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionMaxConcurrentQueries_>(1);
+  Controller controller{1_GB};
+  boost::asio::io_context ioContext;
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  auto ticket = ad_utility::runAndWaitForAwaitable(
+      controller.admit({}, handle), ioContext);
+  EXPECT_EQ(stats(controller), Stats(1, 0, 0));
+
+  // The second query waits until it is cancelled and is then removed from the
+  // queue.
+  auto otherHandle = std::make_shared<ad_utility::CancellationHandle<>>();
+  otherHandle->cancel(ad_utility::CancellationState::MANUAL);
+  EXPECT_THROW(ad_utility::runAndWaitForAwaitable(
+                   controller.admit({}, otherHandle), ioContext),
+               ad_utility::CancellationException);
+  EXPECT_EQ(stats(controller), Stats(1, 0, 0));
+
+  // Release the first ticket while the second query is waiting.
+  auto waitForAdmission = [&]() -> boost::asio::awaitable<size_t> {
+    auto admitted = co_await controller.admit({}, handle);
+    co_return admitted.reservedMemory().getBytes();
+  };
+  auto release = [&ticket]() -> boost::asio::awaitable<size_t> {
+    boost::asio::steady_timer timer{co_await boost::asio::this_coro::executor,
+                                    std::chrono::milliseconds{30}};
+    co_await timer.async_wait(boost::asio::use_awaitable);
+    auto released = std::move(ticket);
+    co_return 0;
+  };
+  auto future = boost::asio::co_spawn(ioContext, release(),
+                                      boost::asio::use_future);
+  EXPECT_EQ(ad_utility::runAndWaitForAwaitable(waitForAdmission(), ioContext),
+            0);
+  future.get();
+  EXPECT_EQ(stats(controller), Stats(0, 0, 0));
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, admitBlocking) {
+  auto c1 = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionMaxConcurrentQueries_>(1);
+  Controller controller{1_GB};
+  auto handle = std::make_shared<ad_utility::CancellationHandle<>>();
+  std::optional<Controller::Ticket> ticket =
+      controller.admitBlocking({Batch, 1}, handle);
+  EXPECT_EQ(stats(controller), Stats(1, 0, 0));
+
+  // A cancelled query stops waiting and is removed from the queue.
+  auto otherHandle = std::make_shared<ad_utility::CancellationHandle<>>();
+  otherHandle->cancel(ad_utility::CancellationState::MANUAL);
+  EXPECT_THROW(controller.admitBlocking({Batch, 1}, otherHandle),
+               ad_utility::CancellationException);
+  EXPECT_EQ(stats(controller), Stats(1, 0, 0));
+
+  // The waiting query is admitted as soon as the first ticket is released.
+  auto future = std::async(std::launch::async, [&]() {
+    return controller.admitBlocking({Batch, 1}, handle).reservedMemory();
+  });
+  while (stats(controller) != Stats(1, 1, 0)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  ticket.reset();
+  EXPECT_EQ(future.get(), 0_B);
+  EXPECT_EQ(stats(controller), Stats(0, 0, 0));
+}
+
+// _____________________________________________________________________________
+TEST(QueryAdmissionController, onlyWhenIdle) {
+  // The queries that may only run when the server is idle wait for the other
+  // queries also if the number of concurrent queries is unlimited.
+  auto c1 = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionMaxConcurrentQueries_>(0);
+  Controller controller{1_GB};
+  auto now = Controller::Clock::now();
+
+  auto running =
+      controller.tryAdmit(controller.enqueue({Interactive, 100}, now), now);
+  ASSERT_TRUE(running.has_value());
+  auto idle = controller.enqueue({Batch, 1, true}, now);
+  EXPECT_FALSE(controller.tryAdmit(idle, now).has_value());
+
+  // Other queries are admitted before it, even if they are more expensive and
+  // have waited for a shorter time.
+  auto later = now + std::chrono::seconds{10};
+  auto other = controller.enqueue({Batch, 1000}, later);
+  EXPECT_EQ(stats(controller), Stats(1, 2, 0));
+  EXPECT_FALSE(controller.tryAdmit(idle, later).has_value());
+  auto otherTicket = controller.tryAdmit(other, later);
+  ASSERT_TRUE(otherTicket.has_value());
+  EXPECT_FALSE(controller.tryAdmit(idle, later).has_value());
+
+  // The query is admitted as soon as no other query is running.
+  running.reset();
+  EXPECT_FALSE(controller.tryAdmit(idle, later).has_value());
+  otherTicket.reset();
+  auto idleTicket = controller.tryAdmit(idle, later);
+  ASSERT_TRUE(idleTicket.has_value());
+  EXPECT_EQ(stats(controller), Stats(1, 0, 0));
+
+  // Queries that arrive while it is running are admitted.
+  EXPECT_TRUE(
+      controller.tryAdmit(controller.enqueue({Interactive, 1}, later), later)
+          .has_value());
+}
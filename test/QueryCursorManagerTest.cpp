@@ -0,0 +1,145 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "engine/HttpError.h"
+#include "engine/QueryCursorManager.h"
+#include "util/GTestHelpers.h"
+#include "util/IdTableHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
+
+using namespace ad_utility::memory_literals;
+using Manager = QueryCursorManager;
+
+namespace {
+// A cursor for the rows `[rowBegin, rowEnd)` of a result with `numRows` rows
+// and a single column.
+Manager::CursorResult makeCursor(size_t numRows, size_t rowBegin = 0,
+                                 std::optional<size_t> rowEnd = std::nullopt) {
+  VectorTable rows;
+  for (size_t i = 0; i < numRows; ++i) {
+    rows.push_back({static_cast<int64_t>(i)});
+  }
+  auto result = std::make_shared<const Result>(
+      makeIdTableFromVector(rows), std::vector<ColumnIndex>{}, LocalVocab{});
+  return {ParsedQuery{},
+          std::move(result),
+          {},
+          ad_utility::MediaType::tsv,
+          rowBegin,
+          rowEnd.value_or(numRows)};
+}
+
+// The first row, the end, and whether it is the last page.
+using PageBounds = std::tuple<size_t, size_t, bool>;
+PageBounds bounds(const Manager::Page& page) {
+  return {page.begin_, page.end_, page.isLast_};
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(QueryCursorManager, pagesAndAutomaticClose) {
+  Manager manager;
+  auto id = manager.open(makeCursor(10, 2, 9), "client");
+  EXPECT_EQ(manager.getStatistics().numOpen_, 1u);
+  EXPECT_EQ(manager.getStatistics().memory_, 80_B);
+
+  auto first = manager.nextPage(id, "client", 3);
+  EXPECT_EQ(bounds(first), PageBounds(2, 5, false));
+  EXPECT_EQ(first.cursor_->result_->idTable().numRows(), 10u);
+  EXPECT_EQ(bounds(manager.nextPage(id, "client", 3)),
+            PageBounds(5, 8, false));
+  EXPECT_EQ(bounds(manager.nextPage(id, "client", 3)), PageBounds(8, 9, true));
+
+  // After the last page, the cursor is closed.
+  EXPECT_EQ(manager.getStatistics().numOpen_, 0u);
+  EXPECT_EQ(manager.getStatistics().memory_, 0_B);
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      manager.nextPage(id, "client", 3),
+      ::testing::HasSubstr("There is no open cursor with ID"), HttpError);
+
+  // The single page of an empty result is also the last one.
+  auto empty = manager.open(makeCursor(0), "client");
+  EXPECT_EQ(bounds(manager.nextPage(empty, "client", 5)),
+            PageBounds(0, 0, true));
+}
+
+// _____________________________________________________________________________
+TEST(QueryCursorManager, close) {
+  Manager manager;
+  auto id = manager.open(makeCursor(4), "client");
+  EXPECT_NE(manager.open(makeCursor(4), "client"), id);
+  EXPECT_TRUE(manager.close(id, "client"));
+  EXPECT_FALSE(manager.close(id, "client"));
+  EXPECT_THROW(manager.nextPage(id, "client", 1), HttpError);
+  EXPECT_EQ(manager.getStatistics().numOpen_, 1u);
+  EXPECT_EQ(manager.getStatistics().memory_, 32_B);
+}
+
+// _____________________________________________________________________________
+TEST(QueryCursorManager, cursorsBelongToTheirClient) {
+  Manager manager;
+  auto id = manager.open(makeCursor(4), "a");
+  // Another client can neither fetch nor close the cursor, and the error is
+  // the same as for a cursor that doesn't exist.
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      manager.nextPage(id, "b", 1),
+      ::testing::HasSubstr("There is no open cursor with ID"), HttpError);
+  EXPECT_FALSE(manager.close(id, "b"));
+  EXPECT_EQ(manager.getStatistics().numOpen_, 1u);
+
+  // The cursor is unchanged for its own client.
+  EXPECT_EQ(bounds(manager.nextPage(id, "a", 2)), PageBounds(0, 2, false));
+  EXPECT_TRUE(manager.close(id, "a"));
+}
+
+// _____________________________________________________________________________
+TEST(QueryCursorManager, timeout) {
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::cursorTimeout_>(
+          std::chrono::seconds{10});
+  Manager manager;
+  auto now = Manager::Clock::now();
+  auto id = manager.open(makeCursor(4), "client", now);
+  auto other = manager.open(makeCursor(4), "client", now);
+
+  // Each access resets the timeout of the accessed cursor only.
+  auto later = now + std::chrono::seconds{9};
+  EXPECT_EQ(bounds(manager.nextPage(id, "client", 1, later)),
+            PageBounds(0, 1, false));
+  auto muchLater = now + std::chrono::seconds{11};
+  EXPECT_EQ(bounds(manager.nextPage(id, "client", 1, muchLater)),
+            PageBounds(1, 2, false));
+  EXPECT_THROW(manager.nextPage(other, "client", 1, muchLater), HttpError);
+  EXPECT_EQ(manager.getStatistics().numOpen_, 1u);
+  EXPECT_FALSE(
+      manager.close(id, "client", muchLater + std::chrono::seconds{10}));
+}
+
+// _____________________________________________________________________________
+TEST(QueryCursorManager, limits) {
+  auto c1 =
+      setRuntimeParameterForTest<&RuntimeParameters::cursorMaxOpenPerClient_>(
+          2);
+  auto c2 =
+      setRuntimeParameterForTest<&RuntimeParameters::cursorMaxMemory_>(100_B);
+  Manager manager;
+  auto first = manager.open(makeCursor(4), "a");
+  manager.open(makeCursor(4), "a");
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      manager.open(makeCursor(1), "a"),
+      ::testing::HasSubstr("may have at most 2 open cursors"), HttpError);
+
+  // The limit is per client, but the memory is shared by all clients.
+  manager.open(makeCursor(4), "b");
+  AD_EXPECT_THROW_WITH_MESSAGE_AND_TYPE(
+      manager.open(makeCursor(1), "b"),
+      ::testing::HasSubstr("does not fit into the memory"), HttpError);
+  EXPECT_TRUE(manager.close(first, "a"));
+  EXPECT_NO_THROW(manager.open(makeCursor(1), "b"));
+  EXPECT_EQ(manager.getStatistics().numOpen_, 3u);
+  EXPECT_EQ(manager.getStatistics().memory_, 72_B);
+}
@@ -926,6 +926,9 @@ auto forAllParallelParsers(const auto& function, const auto&... args) {
   function(ti<RdfParallelParser<TurtleParser<Tokenizer>>>, false, args...);
   function(ti<RdfParallelParser<TurtleParser<TokenizerCtre>>>, true, args...);
   function(ti<RdfParallelParser<TurtleParser<TokenizerCtre>>>, false, args...);
+  using FastPathParser = NTriplesFastPathParser<TurtleParser<Tokenizer>>;
+  function(ti<RdfParallelParser<FastPathParser>>, true, args...);
+  function(ti<RdfParallelParser<FastPathParser>>, false, args...);
 }
 auto forAllMultifileParsers(const auto& function, const auto&... args) {
   function(ti<RdfMultifileParser>, true, args...);
@@ -936,6 +939,9 @@ auto forAllParsers(const auto& function, const auto&... args) {
   function(ti<RdfStreamParser<TurtleParser<Tokenizer>>>, false, args...);
   function(ti<RdfStreamParser<TurtleParser<TokenizerCtre>>>, true, args...);
   function(ti<RdfStreamParser<TurtleParser<TokenizerCtre>>>, false, args...);
+  using FastPathParser = NTriplesFastPathParser<TurtleParser<TokenizerCtre>>;
+  function(ti<RdfStreamParser<FastPathParser>>, true, args...);
+  function(ti<RdfStreamParser<FastPathParser>>, false, args...);
   forAllParallelParsers(function, args...);
   forAllMultifileParsers(function, args...);
 }
@@ -1306,6 +1312,74 @@ TEST(RdfParserTest, nQuadParser) {
   runTestsForParser(NQuadCtreParser{encodedIriManager()});
 }
 
+// _____________________________________________________________________________
+TEST(RdfParserTest, nTriplesFastPath) {
+  // Parse the `input` with the `Parser` and with the `Parser` that is wrapped
+  // in an `NTriplesFastPathParser` and check that the results are the same.
+  auto expectSameResult = [](auto t, std::string_view input,
+                             ad_utility::source_location l =
+                                 AD_CURRENT_SOURCE_LOC()) {
+    using Parser = typename decltype(t)::type;
+    auto trace = generateLocationTrace(l);
+    auto parse = [input](auto parser) {
+      parser.setBlankNodePrefixOnlyForTesting(42);
+      parser.setInputStream(input);
+      return parser.parseAndReturnAllTriples();
+    };
+    auto expected = parse(RdfStringParser<Parser>{encodedIriManager()});
+    auto actual = parse(
+        RdfStringParser<NTriplesFastPathParser<Parser>>{encodedIriManager()});
+    EXPECT_FALSE(actual.empty());
+    EXPECT_THAT(actual, ::testing::ElementsAreArray(expected));
+  };
+  // Statements that are handled by the fast path.
+  std::string nTriples =
+      "<http://example.org/s> <http://example.org/p> <http://example.org/o> .\n"
+      "_:b1 <p> _:b2.\n"
+      "<s> <p> \"plain\" .\n"
+      "<s> <p> \"with \\\"escapes\\\" \\u0041\\n\" .\n"
+      "<s> <p> \"chat\"@en-GB .\n"
+      "<s> <p> \"42\"^^<http://www.w3.org/2001/XMLSchema#int> .\n"
+      "<s> <p> \"2.5\"^^<http://www.w3.org/2001/XMLSchema#double> .\n"
+      "<s> <p> \"2024-01-01\"^^<http://www.w3.org/2001/XMLSchema#date> .\n"
+      "<s> <p> \"x\"^^<http://example.org/type> . # comment\n";
+  // Statements that are passed on to the general parser.
+  std::string mixed =
+      "<s> <p> <o1>, <o2> .\n"
+      "<s> <p> <o\\u0041> .\n"
+      "<s> <p> \"\"\"multi\nline\"\"\" .\n";
+  std::string nQuads =
+      "<s> <p> <o> <g> .\n"
+      "<s> <p> \"o\"@en _:g .\n"
+      "_:s <p> _:o .\n";
+  std::string nTriplesAndMixed = nTriples + mixed;
+  for (std::string_view input : {nTriples, nTriplesAndMixed}) {
+    expectSameResult(ti<TurtleParser<Tokenizer>>, input);
+    expectSameResult(ti<TurtleParser<TokenizerCtre>>, input);
+  }
+  for (std::string_view input : {nTriples, nQuads}) {
+    expectSameResult(ti<NQuadParser<Tokenizer>>, input);
+    expectSameResult(ti<NQuadParser<TokenizerCtre>>, input);
+  }
+
+  // Invalid literals are reported or skipped by the fast path in the same way.
+  using FastPathParser =
+      RdfStringParser<NTriplesFastPathParser<TurtleParser<Tokenizer>>>;
+  std::string_view invalidLiteral =
+      "<s> <p> \"noInt\"^^<http://www.w3.org/2001/XMLSchema#int> .\n"
+      "<s> <p> <o> .";
+  FastPathParser parser{encodedIriManager()};
+  parser.setInputStream(invalidLiteral);
+  AD_EXPECT_THROW_WITH_MESSAGE(parser.parseAndReturnAllTriples(),
+                               ::testing::HasSubstr("Parse error"));
+  FastPathParser skippingParser{encodedIriManager()};
+  skippingParser.invalidLiteralsAreSkipped() = true;
+  skippingParser.setInputStream(invalidLiteral);
+  EXPECT_THAT(skippingParser.parseAndReturnAllTriples(),
+              ::testing::ElementsAre(TurtleTriple{iri("<s>"), iri("<p>"),
+                                                  iri("<o>")}));
+}
+
 // _____________________________________________________________________________
 TEST(RdfParserTest, noGetlineInStringParser) {
   auto runTestsForParser = [](auto parser) {
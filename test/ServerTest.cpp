@@ -48,6 +48,83 @@ TEST(ServerTest, determineResultPinning) {
       testing::Pair(false, false));
 }
 
+// _____________________________________________________________________________
+TEST(ServerTest, determineQueryPriority) {
+  auto makeRequest = [](std::optional<std::string> priority) {
+    auto request = makeGetRequest("/");
+    if (priority.has_value()) {
+      request.set("Query-Priority", priority.value());
+    }
+    return request;
+  };
+  using enum QueryPriority;
+  auto determine = [&](std::optional<std::string> priority,
+                       size_t costEstimate = 10, bool accessTokenOk = false) {
+    return Server::determineQueryPriority(makeRequest(std::move(priority)),
+                                          costEstimate, accessTokenOk);
+  };
+  EXPECT_EQ(determine(std::nullopt), Interactive);
+  EXPECT_EQ(determine("interactive"), Interactive);
+  EXPECT_EQ(determine("batch"), Batch);
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      determine("urgent"),
+      testing::HasSubstr(R"(Invalid value "urgent" for the header)"));
+
+  // Expensive queries are batch queries unless the access token is valid.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::admissionInteractiveMaxCost_>(100);
+  EXPECT_EQ(determine(std::nullopt, 100), Interactive);
+  EXPECT_EQ(determine(std::nullopt, 101), Batch);
+  EXPECT_EQ(determine("interactive", 101), Batch);
+  EXPECT_EQ(determine("interactive", 101, true), Interactive);
+  EXPECT_EQ(determine("batch", 101, true), Batch);
+}
+
+// _____________________________________________________________________________
+TEST(ServerTest, determineCursorClient) {
+  auto makeRequest = [](std::string remoteAddress,
+                        std::optional<std::string> forwardedFor) {
+    auto request = makeGetRequest("/");
+    request.set(ad_utility::httpUtils::REMOTE_ADDRESS_HEADER, remoteAddress);
+    if (forwardedFor.has_value()) {
+      request.set("X-Forwarded-For", forwardedFor.value());
+    }
+    return request;
+  };
+  auto determine = [&](std::string remoteAddress,
+                       std::optional<std::string> forwardedFor) {
+    return Server::determineCursorClient(
+        makeRequest(std::move(remoteAddress), std::move(forwardedFor)));
+  };
+  // Without a trusted proxy, the `X-Forwarded-For` header is ignored.
+  EXPECT_EQ(determine("1.2.3.4", std::nullopt), "1.2.3.4");
+  EXPECT_EQ(determine("1.2.3.4", "5.6.7.8"), "1.2.3.4");
+
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::cursorTrustedProxies_>(
+          std::vector<std::string>{"10.0.0.1"});
+  EXPECT_EQ(determine("1.2.3.4", "5.6.7.8"), "1.2.3.4");
+  EXPECT_EQ(determine("10.0.0.1", std::nullopt), "10.0.0.1");
+  EXPECT_EQ(determine("10.0.0.1", "5.6.7.8"), "5.6.7.8");
+  // Only the last address is added by the proxy, the others can be spoofed.
+  EXPECT_EQ(determine("10.0.0.1", "9.9.9.9, 5.6.7.8"), "5.6.7.8");
+}
+
+// _____________________________________________________________________________
+TEST(ServerTest, determineCursorPageSize) {
+  EXPECT_EQ(Server::determineCursorPageSize({}), 10'000u);
+  EXPECT_EQ(Server::determineCursorPageSize({{"page-size", {"42"}}}), 42u);
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::cursorDefaultPageSize_>(
+          0);
+  EXPECT_EQ(Server::determineCursorPageSize({}), 1u);
+  for (std::string invalid : {"0", "-3", "12abc", ""}) {
+    AD_EXPECT_THROW_WITH_MESSAGE(
+        Server::determineCursorPageSize({{"page-size", {invalid}}}),
+        testing::HasSubstr("for the parameter \"page-size\""));
+  }
+}
+
 // _____________________________________________________________________________
 TEST(ServerTest, determineMediaType) {
   auto MakeRequest = [](const std::optional<std::string>& accept,
@@ -174,9 +251,14 @@ TEST(ServerTest, composeStatsJson) {
                     {"name-index", ""},
                     {"name-text-index", ""},
                     {"num-entity-occurrences", 0},
+                    {"num-open-cursors", 0},
                     {"num-permutations", 2},
                     {"num-predicates-internal", 0},
                     {"num-predicates-normal", 0},
+                    {"num-queries-admitted", 0},
+                    {"num-queries-rejected", 0},
+                    {"num-queries-running", 0},
+                    {"num-queries-waiting", 0},
                     {"num-text-records", 0},
                     {"num-triples-internal", 0},
                     {"num-triples-normal", 0},
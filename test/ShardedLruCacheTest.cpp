@@ -0,0 +1,90 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "util/ShardedLruCache.h"
+
+using ad_utility::util::ShardedLRUCache;
+
+// _____________________________________________________________________________
+TEST(ShardedLRUCache, basicOperations) {
+  ShardedLRUCache<int, std::string> cache{8, 2};
+  EXPECT_FALSE(cache.tryGet(1).has_value());
+  cache.insert(1, "one");
+  cache.insert(2, "two");
+  EXPECT_EQ(cache.tryGet(1), "one");
+  EXPECT_EQ(cache.tryGet(2), "two");
+
+  // Inserting an existing key doesn't change its value.
+  cache.insert(1, "uno");
+  EXPECT_EQ(cache.tryGet(1), "one");
+
+  cache.clear();
+  EXPECT_FALSE(cache.tryGet(1).has_value());
+  EXPECT_FALSE(cache.tryGet(2).has_value());
+}
+
+// _____________________________________________________________________________
+TEST(ShardedLRUCache, eviction) {
+  // With a single shard, the cache behaves like an ordinary `LRUCache`.
+  ShardedLRUCache<int, int> cache{2, 1};
+  cache.insert(1, 10);
+  cache.insert(2, 20);
+  EXPECT_EQ(cache.tryGet(1), 10);
+  cache.insert(3, 30);
+  // `2` was the least recently used element.
+  EXPECT_FALSE(cache.tryGet(2).has_value());
+  EXPECT_EQ(cache.tryGet(1), 10);
+  EXPECT_EQ(cache.tryGet(3), 30);
+
+  // With several shards, the total number of elements is bounded by the
+  // capacity.
+  ShardedLRUCache<int, int> sharded{16, 4};
+  for (int i = 0; i < 1000; ++i) {
+    sharded.insert(i, i);
+  }
+  size_t numContained = 0;
+  for (int i = 0; i < 1000; ++i) {
+    if (auto value = sharded.tryGet(i)) {
+      EXPECT_EQ(value.value(), i);
+      ++numContained;
+    }
+  }
+  EXPECT_GT(numContained, 0u);
+  EXPECT_LE(numContained, 16u);
+}
+
+// _____________________________________________________________________________
+TEST(ShardedLRUCache, invalidArguments) {
+  using Cache = ShardedLRUCache<int, int>;
+  EXPECT_ANY_THROW(Cache(16, 0));
+  EXPECT_ANY_THROW(Cache(3, 4));
+}
+
+// _____________________________________________________________________________
+TEST(ShardedLRUCache, concurrentAccess) {
+  ShardedLRUCache<int, int> cache{1024};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&cache, t]() {
+      for (int i = 0; i < 10'000; ++i) {
+        int key = (i * 7 + t) % 2048;
+        if (auto value = cache.tryGet(key)) {
+          EXPECT_EQ(value.value(), 2 * key);
+        } else {
+          cache.insert(key, 2 * key);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
@@ -0,0 +1,177 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <future>
+
+#include "index/SharedBlockScans.h"
+#include "util/IdTableHelpers.h"
+#include "util/RuntimeParametersTestHelpers.h"
+
+using namespace ad_utility::memory_literals;
+
+namespace {
+// A `ReadBlock` function that counts how often it is called. Each block has a
+// single row and two columns.
+struct CountingReader {
+  std::atomic<size_t> numReads_ = 0;
+  auto operator()(size_t blockIndex) {
+    return [this, blockIndex]() {
+      ++numReads_;
+      auto value = static_cast<int64_t>(blockIndex);
+      return makeIdTableFromVector({{value, value}});
+    };
+  }
+};
+
+// Read the blocks `[begin, end)` with the `scan`.
+void readBlocks(SharedBlockScans::Scan& scan, CountingReader& reader,
+                size_t begin, size_t end) {
+  for (size_t i = begin; i < end; ++i) {
+    auto block = scan.getBlock(i, 1, reader(i));
+    const IdTable& table =
+        std::holds_alternative<IdTable>(block)
+            ? std::get<IdTable>(block)
+            : *std::get<SharedBlockScans::Block>(block);
+    EXPECT_EQ(table.at(0, 0), ad_utility::testing::VocabId(i));
+  }
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(SharedBlockScans, concurrentScansShareBlocks) {
+  auto scans = std::make_shared<SharedBlockScans>();
+  CountingReader reader;
+  auto first = scans->registerScan({0, 1}, 0, 10);
+  auto second = scans->registerScan({0, 1}, 0, 10);
+
+  // The blocks read by the first scan are kept for the second scan.
+  readBlocks(first, reader, 0, 5);
+  EXPECT_EQ(reader.numReads_, 5u);
+  EXPECT_EQ(scans->getStatistics().numBlocksKept_, 5u);
+  EXPECT_EQ(scans->getStatistics().memory_, 80_B);
+
+  // The second scan doesn't read them again and releases them as it passes
+  // them.
+  readBlocks(second, reader, 0, 3);
+  EXPECT_EQ(reader.numReads_, 5u);
+  EXPECT_EQ(scans->getStatistics().numBlocksKept_, 2u);
+  readBlocks(second, reader, 3, 10);
+  EXPECT_EQ(reader.numReads_, 10u);
+  EXPECT_EQ(scans->getStatistics().numBlocksKept_, 5u);
+
+  // The blocks that the second scan has read ahead of the first one are kept
+  // for the first scan.
+  readBlocks(first, reader, 5, 10);
+  EXPECT_EQ(reader.numReads_, 10u);
+  auto statistics = scans->getStatistics();
+  EXPECT_EQ(statistics.numBlocksRead_, 10u);
+  EXPECT_EQ(statistics.numBlocksShared_, 10u);
+  EXPECT_EQ(statistics.numBlocksKept_, 0u);
+  EXPECT_EQ(statistics.memory_, 0_B);
+}
+
+// _____________________________________________________________________________
+TEST(SharedBlockScans, lateScanReadsMissedBlocksItself) {
+  auto scans = std::make_shared<SharedBlockScans>();
+  CountingReader reader;
+  auto first = scans->registerScan({0, 1}, 0, 10);
+  readBlocks(first, reader, 0, 5);
+  EXPECT_EQ(scans->getStatistics().numBlocksKept_, 0u);
+
+  // The late scan has to read the first blocks itself, but the blocks that are
+  // read by the first scan from now on are kept for it.
+  auto late = scans->registerScan({0, 1}, 0, 10);
+  readBlocks(first, reader, 5, 10);
+  EXPECT_EQ(reader.numReads_, 10u);
+  readBlocks(late, reader, 0, 10);
+  EXPECT_EQ(reader.numReads_, 15u);
+  EXPECT_EQ(scans->getStatistics().numBlocksShared_, 5u);
+}
+
+// _____________________________________________________________________________
+TEST(SharedBlockScans, blocksAreOnlySharedForTheSameColumns) {
+  auto scans = std::make_shared<SharedBlockScans>();
+  CountingReader reader;
+  auto first = scans->registerScan({0, 1}, 0, 2);
+  auto otherColumns = scans->registerScan({1, 0}, 0, 2);
+  readBlocks(first, reader, 0, 2);
+  EXPECT_EQ(scans->getStatistics().numBlocksKept_, 0u);
+  readBlocks(otherColumns, reader, 0, 2);
+  EXPECT_EQ(reader.numReads_, 4u);
+}
+
+// _____________________________________________________________________________
+TEST(SharedBlockScans, memoryLimitAndUnregistration) {
+  auto scans = std::make_shared<SharedBlockScans>();
+  CountingReader reader;
+  auto first = scans->registerScan({0, 1}, 0, 10);
+  {
+    auto second = scans->registerScan({0, 1}, 0, 10);
+    auto cleanup =
+        setRuntimeParameterForTest<&RuntimeParameters::sharedScansMaxMemory_>(
+            32_B);
+    readBlocks(first, reader, 0, 4);
+    // Only two blocks fit into the memory.
+    EXPECT_EQ(scans->getStatistics().numBlocksKept_, 2u);
+    EXPECT_EQ(scans->getStatistics().memory_, 32_B);
+  }
+  // The kept blocks are released when the scan that needs them is
+  // unregistered.
+  EXPECT_EQ(scans->getStatistics().numScans_, 1u);
+  EXPECT_EQ(scans->getStatistics().numBlocksKept_, 0u);
+  EXPECT_EQ(scans->getStatistics().memory_, 0_B);
+}
+
+// _____________________________________________________________________________
+TEST(SharedBlockScans, memoryIsReservedBeforeTheRead) {
+  auto scans = std::make_shared<SharedBlockScans>();
+  CountingReader reader;
+  auto first = scans->registerScan({0, 1}, 0, 10);
+  auto second = scans->registerScan({0, 1}, 0, 10);
+  auto cleanup =
+      setRuntimeParameterForTest<&RuntimeParameters::sharedScansMaxMemory_>(
+          16_B);
+  // While the first block is read, its memory is already reserved, so a block
+  // that is read concurrently is not kept.
+  first.getBlock(0, 1, [&]() {
+    EXPECT_EQ(scans->getStatistics().memory_, 16_B);
+    readBlocks(first, reader, 1, 2);
+    EXPECT_EQ(scans->getStatistics().numBlocksKept_, 1u);
+    return reader(0)();
+  });
+  EXPECT_EQ(scans->getStatistics().numBlocksKept_, 1u);
+  EXPECT_EQ(scans->getStatistics().memory_, 16_B);
+}
+
+// _____________________________________________________________________________
+TEST(SharedBlockScans, waitForBlockThatIsBeingRead) {
+  auto scans = std::make_shared<SharedBlockScans>();
+  auto first = scans->registerScan({0}, 0, 1);
+  auto second = scans->registerScan({0}, 0, 1);
+
+  std::promise<void> readStarted;
+  std::promise<void> finishRead;
+  std::atomic<size_t> numReads = 0;
+  auto read = [&]() {
+    ++numReads;
+    readStarted.set_value();
+    finishRead.get_future().wait();
+    return makeIdTableFromVector({{42}});
+  };
+  auto firstBlock = std::async(std::launch::async,
+                               [&]() { return first.getBlock(0, 1, read); });
+  readStarted.get_future().wait();
+  auto secondBlock = std::async(std::launch::async, [&]() {
+    return second.getBlock(0, 1, []() -> IdTable { AD_FAIL(); });
+  });
+  finishRead.set_value();
+  using Block = SharedBlockScans::Block;
+  EXPECT_EQ(std::get<Block>(firstBlock.get()),
+            std::get<Block>(secondBlock.get()));
+  EXPECT_EQ(numReads, 1u);
+}
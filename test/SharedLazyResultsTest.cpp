@@ -0,0 +1,309 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <future>
+#include <limits>
+#include <thread>
+
+#include "engine/SharedLazyResults.h"
+#include "util/GTestHelpers.h"
+#include "util/IdTableHelpers.h"
+
+using namespace ad_utility::memory_literals;
+using Pair = Result::IdTableVocabPair;
+using LazyResult = Result::LazyResult;
+using Values = std::vector<int64_t>;
+using ad_utility::testing::makeAllocator;
+
+namespace {
+// A lazy result with `numChunks` chunks of two rows each (the rows of the
+// chunk `i` are `2 * i` and `2 * i + 1`), which counts the computed chunks in
+// `numComputed`. Computing the chunk `failAt` throws an exception.
+LazyResult makeSource(size_t numChunks, std::atomic<size_t>& numComputed,
+                      std::optional<size_t> failAt = std::nullopt) {
+  return LazyResult{ad_utility::InputRangeFromGetCallable{
+      [i = size_t{0}, numChunks, &numComputed,
+       failAt]() mutable -> std::optional<Pair> {
+        if (i == numChunks) {
+          return std::nullopt;
+        }
+        if (i == failAt) {
+          throw std::runtime_error("Computing the chunk failed");
+        }
+        ++numComputed;
+        auto value = static_cast<int64_t>(2 * i++);
+        return Pair{makeIdTableFromVector({{value}, {value + 1}},
+                                          ad_utility::testing::IntId),
+                    LocalVocab{}};
+      }}};
+}
+
+// A `Recompute` function that counts its calls in `numRecomputed`.
+LazyResultBroadcast::Recompute recomputeSource(
+    size_t numChunks, std::atomic<size_t>& numComputed,
+    std::atomic<size_t>& numRecomputed) {
+  return [numChunks, &numComputed, &numRecomputed]() {
+    ++numRecomputed;
+    return makeSource(numChunks, numComputed);
+  };
+}
+
+// The values of the next `numChunks` chunks of the `result` (all remaining
+// chunks if `numChunks` is not specified).
+Values consume(LazyResult& result,
+               size_t numChunks = std::numeric_limits<size_t>::max()) {
+  Values values;
+  for (size_t i = 0; i < numChunks; ++i) {
+    auto pair = result.get();
+    if (!pair.has_value()) {
+      break;
+    }
+    for (size_t row = 0; row < pair->idTable_.numRows(); ++row) {
+      values.push_back(pair->idTable_(row, 0).getInt());
+    }
+  }
+  return values;
+}
+
+// A broadcast of the `source` for the tests that consume from a single
+// thread, the consumers don't wait for the owner.
+std::shared_ptr<LazyResultBroadcast> makeBroadcast(
+    LazyResult source, ad_utility::MemorySize maxMemory) {
+  return std::make_shared<LazyResultBroadcast>(std::move(source), maxMemory,
+                                               std::chrono::milliseconds{0});
+}
+
+// The values `[begin, end)`.
+Values range(int64_t begin, int64_t end) {
+  Values values;
+  for (auto i = begin; i < end; ++i) {
+    values.push_back(i);
+  }
+  return values;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, consumersShareChunks) {
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto broadcast = makeBroadcast(makeSource(4, numComputed), 1_GB);
+  auto owner = broadcast->consumeAsOwner();
+  auto consumer = broadcast->attach(
+      recomputeSource(4, numComputed, numRecomputed), makeAllocator());
+  ASSERT_TRUE(consumer.has_value());
+
+  // The chunks computed by the owner are buffered for the other consumer.
+  EXPECT_EQ(consume(owner, 3), range(0, 6));
+  EXPECT_EQ(broadcast->getStatistics().numChunksBuffered_, 3u);
+  EXPECT_EQ(broadcast->getStatistics().memory_, 48_B);
+  EXPECT_EQ(consume(consumer.value(), 2), range(0, 4));
+  EXPECT_EQ(broadcast->getStatistics().numChunksBuffered_, 1u);
+
+  EXPECT_EQ(consume(owner), range(6, 8));
+  EXPECT_EQ(consume(consumer.value()), range(4, 8));
+  auto statistics = broadcast->getStatistics();
+  EXPECT_EQ(numComputed, 4u);
+  EXPECT_EQ(numRecomputed, 0u);
+  EXPECT_EQ(statistics.numConsumers_, 2u);
+  EXPECT_EQ(statistics.numChunksProduced_, 4u);
+  EXPECT_EQ(statistics.numChunksBuffered_, 0u);
+  EXPECT_EQ(statistics.memory_, 0_B);
+
+  // Consumers can no longer attach once the first chunk has been released.
+  EXPECT_FALSE(broadcast->attach(
+      recomputeSource(4, numComputed, numRecomputed), makeAllocator()));
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, chunksAreCopiedToTheAllocatorOfTheConsumer) {
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto broadcast = makeBroadcast(makeSource(2, numComputed), 1_GB);
+  auto owner = broadcast->consumeAsOwner();
+  auto allocator = makeAllocator(1_kB);
+  auto consumer = broadcast->attach(
+      recomputeSource(2, numComputed, numRecomputed), allocator);
+  ASSERT_TRUE(consumer.has_value());
+  EXPECT_EQ(consume(owner, 1), range(0, 2));
+
+  // The consumer is the last consumer of the chunk, but still gets a copy
+  // that is charged to its own allocator.
+  auto chunk = consumer.value().get();
+  ASSERT_TRUE(chunk.has_value());
+  EXPECT_EQ(chunk->idTable_.getAllocator(), allocator);
+  EXPECT_LT(allocator.amountMemoryLeft(), 1_kB);
+  EXPECT_EQ(broadcast->getStatistics().memory_, 0_B);
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, slowConsumerIsDetached) {
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  // Only two chunks can be buffered.
+  auto broadcast = makeBroadcast(makeSource(5, numComputed), 32_B);
+  auto owner = broadcast->consumeAsOwner();
+  auto consumer = broadcast->attach(
+      recomputeSource(5, numComputed, numRecomputed), makeAllocator());
+  ASSERT_TRUE(consumer.has_value());
+  EXPECT_EQ(consume(owner, 1), range(0, 2));
+  EXPECT_EQ(consume(consumer.value(), 1), range(0, 2));
+
+  EXPECT_EQ(consume(owner, 2), range(2, 6));
+  EXPECT_EQ(broadcast->getStatistics().memory_, 32_B);
+
+  // The buffer is full, so the other consumer is detached when the owner
+  // runs further ahead. It then recomputes its result (without the rows that
+  // it has already consumed).
+  EXPECT_EQ(consume(owner, 1), range(6, 8));
+  EXPECT_EQ(broadcast->getStatistics().memory_, 0_B);
+  EXPECT_EQ(consume(consumer.value()), range(2, 10));
+  EXPECT_EQ(numRecomputed, 1u);
+  EXPECT_EQ(broadcast->getStatistics().numConsumersDetached_, 1u);
+  EXPECT_EQ(broadcast->getStatistics().memory_, 0_B);
+  EXPECT_EQ(consume(owner), range(8, 10));
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, consumerAheadOfTheOwnerIsDetached) {
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto broadcast = makeBroadcast(makeSource(5, numComputed), 1_GB);
+  auto owner = broadcast->consumeAsOwner();
+  auto consumer = broadcast->attach(
+      recomputeSource(5, numComputed, numRecomputed), makeAllocator());
+  ASSERT_TRUE(consumer.has_value());
+
+  // Only the owner computes the chunks. The consumer doesn't wait for it, so
+  // it detaches itself and recomputes its result.
+  EXPECT_EQ(consume(consumer.value(), 3), range(0, 6));
+  EXPECT_EQ(numRecomputed, 1u);
+  EXPECT_EQ(broadcast->getStatistics().numChunksProduced_, 0u);
+  EXPECT_EQ(consume(owner), range(0, 10));
+  EXPECT_EQ(consume(consumer.value()), range(6, 10));
+  EXPECT_EQ(numComputed, 10u);
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, consumerWaitsForTheOwner) {
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto broadcast = std::make_shared<LazyResultBroadcast>(
+      makeSource(5, numComputed), 1_GB, std::chrono::hours{1});
+  auto owner = broadcast->consumeAsOwner();
+  auto consumer = broadcast->attach(
+      recomputeSource(5, numComputed, numRecomputed), makeAllocator());
+  ASSERT_TRUE(consumer.has_value());
+
+  // The consumer runs ahead of the owner, and gets the chunks as soon as the
+  // owner has computed them.
+  auto consumed = std::async(std::launch::async,
+                             [&consumer]() { return consume(*consumer); });
+  for (int64_t i = 0; i < 5; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    EXPECT_EQ(consume(owner, 1), range(2 * i, 2 * i + 2));
+  }
+  EXPECT_EQ(consume(owner), Values{});
+  EXPECT_EQ(consumed.get(), range(0, 10));
+  EXPECT_EQ(numComputed, 5u);
+  EXPECT_EQ(numRecomputed, 0u);
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, ownerIsDestroyed) {
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto broadcast = makeBroadcast(makeSource(3, numComputed), 1_GB);
+  std::optional<LazyResult> consumer;
+  {
+    auto owner = broadcast->consumeAsOwner();
+    consumer = broadcast->attach(
+        recomputeSource(3, numComputed, numRecomputed), makeAllocator());
+    ASSERT_TRUE(consumer.has_value());
+    EXPECT_EQ(consume(owner, 2), range(0, 4));
+  }
+  // The buffered chunks are still consumed from the broadcast, the remaining
+  // rows are recomputed.
+  EXPECT_EQ(consume(consumer.value(), 2), range(0, 4));
+  EXPECT_EQ(numRecomputed, 0u);
+  EXPECT_EQ(consume(consumer.value()), range(4, 6));
+  EXPECT_EQ(numRecomputed, 1u);
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, computationFails) {
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto broadcast = makeBroadcast(makeSource(3, numComputed, 1), 1_GB);
+  auto owner = broadcast->consumeAsOwner();
+  auto consumer = broadcast->attach(
+      recomputeSource(3, numComputed, numRecomputed), makeAllocator());
+  ASSERT_TRUE(consumer.has_value());
+
+  // The failure is only propagated to the owner, the other consumers
+  // recompute the rest of their result.
+  EXPECT_EQ(consume(owner, 1), range(0, 2));
+  AD_EXPECT_THROW_WITH_MESSAGE(consume(owner),
+                               ::testing::HasSubstr("Computing the chunk"));
+  EXPECT_EQ(consume(consumer.value()), range(0, 6));
+  EXPECT_EQ(numRecomputed, 1u);
+}
+
+// _____________________________________________________________________________
+TEST(LazyResultBroadcast, concurrentConsumers) {
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  auto broadcast = std::make_shared<LazyResultBroadcast>(
+      makeSource(1000, numComputed), 1_GB, std::chrono::hours{1});
+  auto owner = broadcast->consumeAsOwner();
+  std::vector<LazyResult> consumers;
+  for (size_t i = 0; i < 3; ++i) {
+    consumers.push_back(
+        broadcast
+            ->attach(recomputeSource(1000, numComputed, numRecomputed),
+                     makeAllocator())
+            .value());
+  }
+  std::vector<std::future<Values>> futures;
+  futures.push_back(std::async(std::launch::async,
+                               [&owner]() { return consume(owner); }));
+  for (auto& consumer : consumers) {
+    futures.push_back(std::async(std::launch::async,
+                                 [&consumer]() { return consume(consumer); }));
+  }
+  for (auto& future : futures) {
+    EXPECT_EQ(future.get(), range(0, 2000));
+  }
+  EXPECT_EQ(numComputed, 1000u);
+  EXPECT_EQ(numRecomputed, 0u);
+}
+
+// _____________________________________________________________________________
+TEST(SharedLazyResults, shareAndAttach) {
+  std::atomic<size_t> numComputed = 0;
+  std::atomic<size_t> numRecomputed = 0;
+  SharedLazyResults<std::string> sharedResults;
+  auto recompute = recomputeSource(2, numComputed, numRecomputed);
+  EXPECT_FALSE(
+      sharedResults.tryAttach("a", recompute, makeAllocator()).has_value());
+  {
+    auto owner = sharedResults.share("a", makeSource(2, numComputed), 1_GB);
+    EXPECT_EQ(sharedResults.numBroadcasts(), 1u);
+    EXPECT_FALSE(
+        sharedResults.tryAttach("b", recompute, makeAllocator()).has_value());
+    auto consumer = sharedResults.tryAttach("a", recompute, makeAllocator());
+    ASSERT_TRUE(consumer.has_value());
+    EXPECT_EQ(consume(owner), range(0, 4));
+    EXPECT_EQ(consume(consumer.value()), range(0, 4));
+    EXPECT_EQ(numComputed, 2u);
+  }
+  // The broadcast is removed when all its consumers are gone.
+  EXPECT_EQ(sharedResults.numBroadcasts(), 0u);
+  EXPECT_FALSE(
+      sharedResults.tryAttach("a", recompute, makeAllocator()).has_value());
+}
@@ -28,3 +28,16 @@ TEST(UpdateMetadataTest, subtractOperator) {
   EXPECT_THAT(count1 - count2, testing::Eq(DeltaTriplesCount{7, 3}));
   EXPECT_THAT(count2 - count1, testing::Eq(DeltaTriplesCount{-7, -3}));
 }
+
+// _____________________________________________________________________________
+TEST(UpdateMetadataTest, throughput) {
+  DeltaTriplesThroughput throughput{500, std::chrono::milliseconds{250}};
+  EXPECT_DOUBLE_EQ(throughput.triplesPerSecond(), 2000.0);
+  const nlohmann::json expected = {
+      {"triples", 500}, {"time-ms", 250.0}, {"triples-per-second", 2000.0}};
+  EXPECT_THAT(nlohmann::json(throughput), testing::Eq(expected));
+
+  // No measurable time, e.g. for an empty update.
+  DeltaTriplesThroughput empty{0, std::chrono::microseconds{0}};
+  EXPECT_DOUBLE_EQ(empty.triplesPerSecond(), 0.0);
+}
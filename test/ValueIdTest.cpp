@@ -13,6 +13,7 @@
 #include "./util/IndexTestHelpers.h"
 #include "backports/algorithm.h"
 #include "global/ValueId.h"
+#include "global/ValueIdComparators.h"
 #include "index/EncodedIriManager.h"
 #include "index/LocalVocabEntry.h"
 #include "util/HashSet.h"
@@ -464,4 +465,36 @@ TEST(ValueId, isTrivial) {
   EXPECT_FALSE(
       Id::makeFromBlankNodeIndex(BlankNodeIndex::make(17)).isTrivial());
   EXPECT_FALSE(Id::makeFromEncodedVal(738).isTrivial());
+  EXPECT_FALSE(Id::makeFromInlineLiteral(InlineLiteral{}).isTrivial());
+}
+
+// _____________________________________________________________________________
+TEST(ValueId, InlineLiteral) {
+  auto makeId = [](std::string_view content) {
+    return Id::makeFromInlineLiteral(
+        InlineLiteral::fromContent(content).value());
+  };
+  auto id = makeId("yes");
+  EXPECT_EQ(id.getDatatype(), Datatype::InlineLiteral);
+  EXPECT_EQ(id.getInlineLiteral().content(), "yes");
+  std::stringstream stream;
+  stream << id;
+  EXPECT_EQ(stream.str(), "I:\"yes\"");
+
+  // Inline literals are ordered by their contents.
+  using namespace valueIdComparators;
+  EXPECT_LT(makeId("no"), id);
+  EXPECT_EQ(compareIds(makeId("no"), id, Comparison::LT),
+            ComparisonResult::True);
+  EXPECT_EQ(compareIds(id, makeId("yes"), Comparison::EQ),
+            ComparisonResult::True);
+  EXPECT_EQ(compareIds(id, makeId("ye"), Comparison::LE),
+            ComparisonResult::False);
+  // The comparison with other strings is by the datatype.
+  auto vocabId = Id::makeFromVocabIndex(VocabIndex::make(12));
+  EXPECT_EQ(compareIds(vocabId, id, Comparison::LT), ComparisonResult::True);
+  EXPECT_EQ(compareIds(vocabId, id, Comparison::EQ), ComparisonResult::False);
+  // Inline literals are incompatible with numeric values.
+  EXPECT_EQ(compareIds(Id::makeFromInt(3), id, Comparison::LT),
+            ComparisonResult::Undef);
 }
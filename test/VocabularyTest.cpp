@@ -9,6 +9,7 @@
 
 #include "index/Vocabulary.h"
 #include "index/vocabulary/VocabularyType.h"
+#include "util/RuntimeParametersTestHelpers.h"
 #include "util/json.h"
 
 using json = nlohmann::json;
@@ -157,3 +158,47 @@ TEST(Vocabulary, IsGeoInfoAvailable) {
   TextVocabulary v4;
   ASSERT_FALSE(v4.isGeoInfoAvailable());
 }
+
+// _____________________________________________________________________________
+TEST(Vocabulary, LookupBatch) {
+  using ad_utility::VocabularyType;
+  for (auto type : VocabularyType::all()) {
+    RdfsVocabulary vocabulary;
+    vocabulary.resetToType(VocabularyType{type});
+    ad_utility::HashSet<string> words{"\"alpha\"", "\"beta\"", "<gamma>",
+                                      "<delta>", "\"epsilon\"@en"};
+    auto filename = "vocTestLookupBatch.dat";
+    vocabulary.createFromSet(words, filename);
+
+    // The indices may be unsorted and contain duplicates.
+    std::vector<VocabIndex> indices;
+    for (uint64_t i : {3u, 1u, 4u, 1u, 0u, 2u, 3u}) {
+      indices.push_back(VocabIndex::make(i));
+    }
+    auto expected = [&]() {
+      std::vector<std::string> result;
+      for (auto idx : indices) {
+        result.emplace_back(vocabulary[idx]);
+      }
+      return result;
+    };
+    ASSERT_EQ(vocabulary.lookupBatch(indices), expected());
+    // Without the runtime parameter, `prefetch` does nothing.
+    vocabulary.prefetch(indices);
+    ASSERT_EQ(vocabulary.lookupBatch(indices), expected());
+    {
+      // The following lookups (of the same words) might be served by the
+      // cache.
+      auto cleanup = setRuntimeParameterForTest<
+          &RuntimeParameters::vocabularyHotStringCache_>(true);
+      vocabulary.prefetch(indices);
+      vocabulary.prefetch(indices);
+      ASSERT_EQ(vocabulary.lookupBatch(indices), expected());
+      for (size_t i = 0; i < indices.size(); ++i) {
+        ASSERT_EQ(vocabulary[indices[i]], expected().at(i));
+      }
+    }
+    ASSERT_TRUE(vocabulary.lookupBatch({}).empty());
+    ad_utility::deleteFile(filename);
+  }
+}
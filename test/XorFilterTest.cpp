@@ -0,0 +1,94 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "util/Serializer/ByteBufferSerializer.h"
+#include "util/Serializer/SerializeOptional.h"
+#include "util/XorFilter.h"
+
+using ad_utility::XorFilter;
+
+namespace {
+// Return `numKeys` random keys.
+std::vector<uint64_t> randomKeys(size_t numKeys, uint64_t seed) {
+  std::mt19937_64 generator{seed};
+  std::vector<uint64_t> keys(numKeys);
+  for (auto& key : keys) {
+    key = generator();
+  }
+  return keys;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(XorFilter, noFalseNegativesAndFewFalsePositives) {
+  for (size_t numKeys : {0, 1, 2, 10, 1000, 100'000}) {
+    auto keys = randomKeys(numKeys, numKeys);
+    auto filter = XorFilter::build(keys);
+    ASSERT_TRUE(filter.has_value()) << numKeys;
+    for (auto key : keys) {
+      ASSERT_TRUE(filter->mayContain(key)) << numKeys;
+    }
+    // The expected false positive rate is 1/256.
+    size_t numFalsePositives = 0;
+    for (auto key : randomKeys(100'000, numKeys + 1)) {
+      numFalsePositives += filter->mayContain(key);
+    }
+    EXPECT_LT(numFalsePositives, 1000) << numKeys;
+    // About 1.23 bytes per key (plus a constant).
+    EXPECT_LE(filter->sizeInBytes(), 32 + 1.23 * numKeys) << numKeys;
+  }
+}
+
+// _____________________________________________________________________________
+TEST(XorFilter, duplicateAndConsecutiveKeys) {
+  std::vector<uint64_t> keys;
+  for (uint64_t i = 0; i < 1000; ++i) {
+    keys.push_back(i);
+    keys.push_back(i);
+  }
+  auto filter = XorFilter::build(keys);
+  ASSERT_TRUE(filter.has_value());
+  for (uint64_t i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(filter->mayContain(i));
+  }
+  size_t numFalsePositives = 0;
+  for (uint64_t i = 1000; i < 101'000; ++i) {
+    numFalsePositives += filter->mayContain(i);
+  }
+  EXPECT_LT(numFalsePositives, 1000);
+}
+
+// _____________________________________________________________________________
+TEST(XorFilter, mixIsDeterministic) {
+  // The filters are persisted, so the hash function must never change.
+  static_assert(XorFilter::mix(0) == 0);
+  EXPECT_EQ(XorFilter::mix(1), XorFilter::mix(1));
+  EXPECT_NE(XorFilter::mix(1), XorFilter::mix(2));
+}
+
+// _____________________________________________________________________________
+TEST(XorFilter, serialization) {
+  auto keys = randomKeys(500, 42);
+  std::optional<XorFilter> filter = XorFilter::build(keys);
+  ASSERT_TRUE(filter.has_value());
+  ad_utility::serialization::ByteBufferWriteSerializer writer;
+  writer << filter;
+  ad_utility::serialization::ByteBufferReadSerializer reader{
+      std::move(writer).data()};
+  std::optional<XorFilter> filter2;
+  reader >> filter2;
+  ASSERT_TRUE(filter2.has_value());
+  EXPECT_EQ(filter2->sizeInBytes(), filter->sizeInBytes());
+  for (auto key : keys) {
+    EXPECT_TRUE(filter2->mayContain(key));
+  }
+  for (auto key : randomKeys(1000, 43)) {
+    EXPECT_EQ(filter2->mayContain(key), filter->mayContain(key));
+  }
+}
@@ -0,0 +1,163 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "./ValuesForTesting.h"
+#include "engine/AdaptiveJoin.h"
+#include "engine/Join.h"
+#include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+namespace {
+using namespace ad_utility::testing;
+using namespace ::testing;
+using Vars = std::vector<std::optional<Variable>>;
+using V = Variable;
+
+// Create an input with the given `table` and `variables`. The multiplicity
+// of all the columns is claimed to be one, which makes the size estimates of
+// joins with many matching rows much too small.
+std::shared_ptr<QueryExecutionTree> makeInput(QueryExecutionContext* qec,
+                                              const VectorTable& table,
+                                              Vars variables) {
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, makeIdTableFromVector(table), std::move(variables), false,
+      std::vector<ColumnIndex>{}, LocalVocab{}, 1.0f);
+}
+
+// Join `a` and `b` on the `variable`.
+std::shared_ptr<QueryExecutionTree> join(QueryExecutionContext* qec,
+                                         std::shared_ptr<QueryExecutionTree> a,
+                                         std::shared_ptr<QueryExecutionTree> b,
+                                         const Variable& variable) {
+  auto colA = a->getVariableColumn(variable);
+  auto colB = b->getVariableColumn(variable);
+  return ad_utility::makeExecutionTree<Join>(qec, std::move(a), std::move(b),
+                                             colA, colB);
+}
+
+// Return the rows of the `idTable` in sorted order.
+std::vector<std::vector<Id>> sortedRows(const IdTable& idTable) {
+  std::vector<std::vector<Id>> rows;
+  for (const auto& row : idTable) {
+    rows.emplace_back(row.begin(), row.end());
+  }
+  ql::ranges::sort(rows);
+  return rows;
+}
+
+// Return true iff the root of the `qet` or one of its descendants is an
+// `AdaptiveJoin`.
+bool containsAdaptiveJoin(const QueryExecutionTree& qet) {
+  auto isAdaptiveJoin = [](const QueryExecutionTree* tree) {
+    return std::dynamic_pointer_cast<AdaptiveJoin>(tree->getRootOperation()) !=
+           nullptr;
+  };
+  bool found = isAdaptiveJoin(&qet);
+  qet.forAllDescendants([&found, &isAdaptiveJoin](const auto* descendant) {
+    found = found || isAdaptiveJoin(descendant);
+  });
+  return found;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(AdaptiveJoin, replansAfterMisestimatedJoin) {
+  auto qec = getQec();
+  VectorTable a, b, c, d;
+  for (int64_t i = 0; i < 20; ++i) {
+    // All the rows of `a` and `b` match, so `a JOIN b` has 400 rows.
+    a.push_back({1, i});
+    b.push_back({1, i});
+    c.push_back({i, i});
+  }
+  for (int64_t i = 0; i < 5; ++i) {
+    d.push_back({i, i});
+  }
+  auto plan = join(
+      qec,
+      join(qec,
+           join(qec, makeInput(qec, a, Vars{V{"?x"}, V{"?y"}}),
+                makeInput(qec, b, Vars{V{"?x"}, V{"?z"}}), V{"?x"}),
+           makeInput(qec, c, Vars{V{"?z"}, V{"?w"}}), V{"?z"}),
+      makeInput(qec, d, Vars{V{"?w"}, V{"?v"}}), V{"?w"});
+  ASSERT_TRUE(AdaptiveJoin::isApplicable(*plan));
+  auto expected = plan->clone()->getResult();
+  ASSERT_EQ(expected->idTable().numRows(), 100);
+
+  AdaptiveJoin adaptiveJoin{qec, plan, 2.0};
+  EXPECT_EQ(adaptiveJoin.getDescriptor(), "Adaptive Join");
+  EXPECT_THAT(adaptiveJoin.getCacheKey(), HasSubstr("ADAPTIVE JOIN"));
+  auto variables = plan->getVariableColumns();
+  auto sortedOn = plan->resultSortedOn();
+  EXPECT_EQ(adaptiveJoin.getExternallyVisibleVariableColumns(), variables);
+  EXPECT_EQ(adaptiveJoin.getResultSortedOn(), sortedOn);
+
+  auto result = adaptiveJoin.computeResultOnlyForTesting(false);
+  EXPECT_EQ(sortedRows(result.idTable()), sortedRows(expected->idTable()));
+  // The columns and the sort order are the same as for the original plan.
+  EXPECT_EQ(plan->getVariableColumns(), variables);
+  EXPECT_EQ(result.sortedBy(), sortedOn);
+
+  // The first join was misestimated, so the remaining three inputs were
+  // re-planned.
+  const auto& reoptimizations = adaptiveJoin.reoptimizations();
+  ASSERT_EQ(reoptimizations.size(), 1);
+  EXPECT_EQ(reoptimizations[0]["actual-size"], 400);
+  EXPECT_EQ(reoptimizations[0]["num-replanned-inputs"], 3);
+}
+
+// _____________________________________________________________________________
+TEST(AdaptiveJoin, noReplanningWithoutMisestimation) {
+  auto qec = getQec();
+  auto plan =
+      join(qec,
+           join(qec, makeInput(qec, {{1, 2}, {2, 3}}, Vars{V{"?x"}, V{"?y"}}),
+                makeInput(qec, {{1, 4}, {2, 5}}, Vars{V{"?x"}, V{"?z"}}),
+                V{"?x"}),
+           makeInput(qec, {{4, 6}, {5, 7}}, Vars{V{"?z"}, V{"?w"}}), V{"?z"});
+  auto expected = plan->clone()->getResult();
+
+  AdaptiveJoin adaptiveJoin{qec, plan, 1000.0};
+  auto result = adaptiveJoin.computeResultOnlyForTesting(false);
+  EXPECT_EQ(sortedRows(result.idTable()), sortedRows(expected->idTable()));
+  EXPECT_TRUE(adaptiveJoin.reoptimizations().empty());
+
+  // A single join has nothing to re-plan.
+  auto singleJoin =
+      join(qec, makeInput(qec, {{1, 2}}, Vars{V{"?x"}, V{"?y"}}),
+           makeInput(qec, {{1, 4}}, Vars{V{"?x"}, V{"?z"}}), V{"?x"});
+  EXPECT_FALSE(AdaptiveJoin::isApplicable(*singleJoin));
+}
+
+// _____________________________________________________________________________
+TEST(AdaptiveJoin, queryPlannerCreatesAdaptiveJoins) {
+  auto qec = getQec(
+      "<a> <p> <b> . <b> <p> <c> . <c> <q> <d> . <b> <q> <e> . <e> <r> <f> .");
+  auto plan = [&qec]() {
+    QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+    auto pq = SparqlParser::parseQuery(
+        &qec->getIndex().encodedIriManager(),
+        "SELECT * { ?a <p> ?b . ?b <q> ?c . ?c <r> ?d }");
+    return qp.createExecutionTree(pq);
+  };
+  EXPECT_FALSE(containsAdaptiveJoin(plan()));
+
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::adaptiveJoinReoptimizationFactor_>(2.0);
+  auto adaptivePlan = plan();
+  EXPECT_TRUE(containsAdaptiveJoin(adaptivePlan));
+  auto result = adaptivePlan.getResult();
+  ASSERT_EQ(result->idTable().numRows(), 1);
+
+  // The factor must be 0 or greater than 1.
+  EXPECT_ANY_THROW(globalRuntimeParameters.wlock()->setFromString(
+      "adaptive-join-reoptimization-factor", "0.5"));
+}
@@ -2,6 +2,7 @@
 //                  Chair of Algorithms and Data Structures.
 //  Author: Johannes Kalmbach <kalmbach@cs.uni-freiburg.de>
 
+#include <absl/strings/str_cat.h>
 #include <gtest/gtest.h>
 
 #include <memory>
@@ -781,7 +782,7 @@ TEST(IndexScan, verifyThatPrefilteredIndexScanResultIsNotCacheable) {
   using namespace makeFilterExpression;
   using namespace filterHelper;
   using V = Variable;
-  auto qec = getQec("<x> <y> <z>.");
+  auto qec = getQec("<x> <y> 30.");
   SparqlTripleSimple triple{V{"?x"}, iri("<y>"), V{"?z"}};
   auto scan = IndexScan{qec, Permutation::PSO, triple};
   auto prefilterPairs =
@@ -800,22 +801,110 @@ TEST(IndexScan, verifyThatPrefilteredIndexScanResultIsNotCacheable) {
   EXPECT_TRUE(updatedQet.has_value());
   EXPECT_FALSE(updatedQet.value()->getRootOperation()->canResultBeCached());
 
-  // Assert that we don't set a <PrefilterExpression, ColumnIndex> pair for the
-  // second Variable.
+  // Assert that the <PrefilterExpression, ColumnIndex> pair for the second
+  // Variable has no effect if it doesn't remove any blocks.
   prefilterPairs = makePrefilterVec(pr(lt(IntId(10)), V{"?a"}),
                                     pr(gt(DoubleId(22)), V{"?z"}),
                                     pr(gt(IntId(10)), V{"?b"}));
   EXPECT_TRUE(qet->getRootOperation()->canResultBeCached());
   updatedQet = qet->getUpdatedQueryExecutionTreeWithPrefilterApplied(
       std::move(prefilterPairs));
-  // No `PrefilterExpression` should be applied for this `IndexScan`, we don't
-  // expect an updated QueryExecutionTree. The `IndexScan` should remain
+  // The `PrefilterExpression` for `?z` can only be applied via the zone maps
+  // of the blocks, which don't exclude the single block (`30 > 22`). So we
+  // don't expect an updated QueryExecutionTree. The `IndexScan` should remain
   // unchanged, containing no prefiltered `BlockMetadataRanges`. Thus, it should
   // be still cacheable.
   EXPECT_TRUE(!updatedQet.has_value());
   EXPECT_TRUE(qet->getRootOperation()->canResultBeCached());
 }
 
+// _____________________________________________________________________________
+TEST(IndexScan, prefilterOnUnsortedColumnUsesZoneMaps) {
+  using namespace makeFilterExpression;
+  using namespace filterHelper;
+  using V = Variable;
+  // Each triple is in a separate block of the PSO permutation, and the objects
+  // are not sorted.
+  TestIndexConfig config;
+  config.blocksizePermutations = 8_B;
+  config.turtleInput = "";
+  for (size_t i = 0; i < 10; ++i) {
+    absl::StrAppend(&config.turtleInput.value(), "<s", i, "> <p> ",
+                    (7 * i) % 10, " . ");
+  }
+  auto index = std::make_shared<Index>(
+      makeTestIndex("prefilterOnUnsortedColumnUsesZoneMaps", config));
+  auto getId = makeGetId(*index);
+  ASSERT_TRUE(index->getPimpl()
+                  .getPermutation(Permutation::PSO)
+                  .zoneMaps()
+                  .has_value());
+
+  QueryResultCache cache;
+  NamedResultCache namedCache;
+  auto materializedViewsManager = std::make_shared<MaterializedViewsManager>();
+  std::unique_ptr<QueryExecutionContext> qec = nullptr;
+  // The `QueryExecutionContext` has to be recreated after each update to see
+  // the current delta triples.
+  auto makeScan = [&]() {
+    qec = std::make_unique<QueryExecutionContext>(
+        index, &cache, makeAllocator(ad_utility::MemorySize::megabytes(100)),
+        SortPerformanceEstimator{}, &namedCache, materializedViewsManager);
+    return IndexScan{qec.get(), Permutation::PSO,
+                     SparqlTripleSimple{V{"?s"}, iri("<p>"), V{"?o"}}};
+  };
+
+  // Check that the prefilter `?o > 5` removes blocks from the scan, and that
+  // the remaining blocks contain all the rows of the unpruned scan that
+  // fulfill the filter. Return the number of rows in the remaining blocks.
+  auto testPrefilter = [&](ad_utility::source_location l =
+                               AD_CURRENT_SOURCE_LOC()) {
+    auto trace = generateLocationTrace(l);
+    auto scan = makeScan();
+    auto pruned = scan.getUpdatedQueryExecutionTreeWithPrefilterApplied(
+        makePrefilterVec(pr(gt(IntId(5)), V{"?o"})));
+    EXPECT_TRUE(pruned.has_value());
+    if (!pruned.has_value()) {
+      return size_t{0};
+    }
+    auto& prunedScan =
+        dynamic_cast<IndexScan&>(*pruned.value()->getRootOperation());
+    EXPECT_LT(prunedScan.getExactSize(), scan.getExactSize());
+
+    auto filterRows = [](const IdTable& table) {
+      IdTable result{2, makeAllocator()};
+      for (const auto& row : table) {
+        if (row[1].getDatatype() == Datatype::Int && row[1].getInt() > 5) {
+          result.push_back(row);
+        }
+      }
+      return result;
+    };
+    auto expected =
+        filterRows(scan.computeResultOnlyForTesting(false).idTable());
+    EXPECT_THAT(
+        filterRows(prunedScan.computeResultOnlyForTesting(false).idTable()),
+        matchesIdTable(expected.clone()));
+    return prunedScan.getExactSize();
+  };
+
+  // Only the blocks with the objects 6 to 9 remain.
+  EXPECT_EQ(testPrefilter(), 4);
+
+  // A block with located triples is kept, even if its zone map excludes it.
+  // The inserted triple is located in the block of `<s2>` (object 4) or
+  // `<s3>` (object 1), both of which are excluded by their zone maps.
+  auto cancellationHandle =
+      std::make_shared<ad_utility::SharedCancellationHandle::element_type>();
+  auto g = qlever::specialIds().at(QLEVER_INTERNAL_GRAPH_IRI);
+  index->deltaTriplesManager().modify<void>([&](DeltaTriples& deltaTriples) {
+    deltaTriples.insertTriples(
+        cancellationHandle,
+        {IdTriple<0>{std::array{getId("<s2>"), getId("<p>"), IntId(100), g}}});
+  });
+  EXPECT_EQ(testPrefilter(), 6);
+}
+
 // _____________________________________________________________________________
 TEST(IndexScan, checkEvaluationWithPrefiltering) {
   using namespace makeFilterExpression;
@@ -2142,3 +2231,48 @@ TEST(IndexScan, additionalVariablesInDescriptor) {
           Var{"?s"}, Var{"?p"}, Var{"?o"}, {std::pair{3, Var{"?g"}}}}};
   EXPECT_EQ(scan2.getDescriptor(), "IndexScan PSO ?s ?p ?o ?g");
 }
+
+// _____________________________________________________________________________
+TEST(IndexScan, strippedScanIsDerivedFromCachedFullScan) {
+  auto qec = getQec("<s> <p> <o>. <s2> <p> <o2>. <s2> <p2> <o3>");
+  IndexScan fullScan{qec, Permutation::SPO,
+                     SparqlTripleSimple{Var{"?s"}, Var{"?p"}, Var{"?o"}}};
+  qec->clearCacheUnpinnedOnly();
+  IdTable fullResult =
+      fullScan.computeResultOnlyForTesting(false).idTable().clone();
+
+  // Cache the result of the scan with all columns, then compute the scan with
+  // only the `varsToKeep` and check that it has been derived from the given
+  // `columns` of the cached result.
+  auto testDerivation = [&](const std::set<Variable>& varsToKeep,
+                            const std::vector<ColumnIndex>& columns,
+                            ad_utility::source_location l =
+                                AD_CURRENT_SOURCE_LOC()) {
+    auto trace = generateLocationTrace(l);
+    auto expected = fullResult.asColumnSubsetView(columns).clone();
+    qec->clearCacheUnpinnedOnly();
+    fullScan.getResult(true);
+    auto strippedScan =
+        fullScan.makeTreeWithStrippedColumns(varsToKeep).value();
+    auto result = strippedScan->getResult(true);
+    ASSERT_TRUE(result->isFullyMaterialized());
+    EXPECT_THAT(result->idTable(), matchesIdTable(expected.clone()));
+    const auto& rti = strippedScan->getRootOperation()->runtimeInfo();
+    EXPECT_EQ(rti.cacheStatus_, ad_utility::CacheStatus::cachedNotPinned);
+    ASSERT_TRUE(rti.details_.contains("derived-from-cached-result"));
+    EXPECT_EQ(rti.details_["derived-from-cached-result"], "column-subset");
+
+    // The derived result is the same as the one that is computed.
+    qec->clearCacheUnpinnedOnly();
+    auto computed = fullScan.makeTreeWithStrippedColumns(varsToKeep).value();
+    EXPECT_THAT(computed->getResult(true)->idTable(),
+                matchesIdTable(expected.clone()));
+    EXPECT_FALSE(computed->getRootOperation()->runtimeInfo().details_.contains(
+        "derived-from-cached-result"));
+  };
+
+  testDerivation({Var{"?p"}}, {1});
+  testDerivation({Var{"?o"}}, {2});
+  testDerivation({Var{"?s"}, Var{"?o"}}, {0, 2});
+  testDerivation({Var{"?p"}, Var{"?o"}}, {1, 2});
+}
@@ -0,0 +1,191 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <gmock/gmock.h>
+
+#include "../util/IdTableHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "./ValuesForTesting.h"
+#include "engine/MultiwayJoin.h"
+#include "engine/QueryExecutionTree.h"
+#include "engine/QueryPlanner.h"
+#include "engine/Sort.h"
+#include "parser/SparqlParser.h"
+
+namespace {
+using namespace ad_utility::testing;
+using namespace ::testing;
+using Vars = std::vector<std::optional<Variable>>;
+using V = Variable;
+
+// Create a child for a `MultiwayJoin` from the given `table`, that is sorted
+// by all its columns in the given order.
+std::shared_ptr<QueryExecutionTree> makeChild(
+    QueryExecutionContext* qec, const VectorTable& table, Vars vars,
+    std::vector<ColumnIndex> sortedOn = {0, 1}) {
+  auto idTable = makeIdTableFromVector(table);
+  Engine::sort(idTable, sortedOn);
+  return ad_utility::makeExecutionTree<ValuesForTesting>(
+      qec, std::move(idTable), std::move(vars), false, std::move(sortedOn));
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, triangle) {
+  auto qec = getQec();
+  // The edges of a directed graph: 1->2, 2->3, 3->1, 1->3, 3->4.
+  VectorTable edges{{1, 2}, {2, 3}, {3, 1}, {1, 3}, {3, 4}};
+  VectorTable reversedEdges{{2, 1}, {3, 2}, {1, 3}, {3, 1}, {4, 3}};
+  // `?a -> ?b -> ?c -> ?a`, where the last child is sorted by `?a`.
+  MultiwayJoin join{qec,
+                    {makeChild(qec, edges, Vars{V{"?a"}, V{"?b"}}),
+                     makeChild(qec, edges, Vars{V{"?b"}, V{"?c"}}),
+                     makeChild(qec, reversedEdges, Vars{V{"?a"}, V{"?c"}})}};
+
+  EXPECT_THAT(join.variableOrder(), ElementsAre(V{"?a"}, V{"?b"}, V{"?c"}));
+  EXPECT_EQ(join.getResultWidth(), 3);
+  EXPECT_THAT(join.getResultSortedOn(), ElementsAre(0, 1, 2));
+  EXPECT_EQ(join.getDescriptor(), "MultiwayJoin on ?a ?b ?c");
+  EXPECT_THAT(join.getCacheKey(), HasSubstr("MULTIWAY JOIN"));
+  EXPECT_FALSE(join.knownEmptyResult());
+  // All the children are already sorted, so no sort was added.
+  for (auto* child : join.getChildren()) {
+    EXPECT_EQ(std::dynamic_pointer_cast<Sort>(child->getRootOperation()),
+              nullptr);
+  }
+
+  auto result = join.computeResultOnlyForTesting(false);
+  ASSERT_TRUE(result.isFullyMaterialized());
+  EXPECT_THAT(result.idTable(),
+              matchesIdTableFromVector({{1, 2, 3}, {2, 3, 1}, {3, 1, 2}}));
+  const auto& varCols = join.getExternallyVisibleVariableColumns();
+  EXPECT_EQ(varCols.at(V{"?a"}), makeAlwaysDefinedColumn(0));
+  EXPECT_EQ(varCols.at(V{"?c"}), makeAlwaysDefinedColumn(2));
+
+  // The same join, but with the children in a different order, has the same
+  // cache key.
+  MultiwayJoin join2{qec,
+                     {makeChild(qec, reversedEdges, Vars{V{"?a"}, V{"?c"}}),
+                      makeChild(qec, edges, Vars{V{"?b"}, V{"?c"}}),
+                      makeChild(qec, edges, Vars{V{"?a"}, V{"?b"}})}};
+  EXPECT_EQ(join.getCacheKey(), join2.getCacheKey());
+
+  // The clone behaves the same.
+  auto clone = join.clone();
+  EXPECT_EQ(clone->getCacheKey(), join.getCacheKey());
+}
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, childrenAreSortedIfRequired) {
+  auto qec = getQec();
+  // The sort orders of the children are contradictory, so one of them has to
+  // be sorted.
+  VectorTable table{{1, 2}, {2, 1}, {1, 1}};
+  MultiwayJoin join{qec,
+                    {makeChild(qec, table, Vars{V{"?x"}, V{"?y"}}, {0, 1}),
+                     makeChild(qec, table, Vars{V{"?x"}, V{"?y"}}, {1, 0})}};
+  auto numSorts = ql::ranges::count_if(join.getChildren(), [](auto* child) {
+    return std::dynamic_pointer_cast<Sort>(child->getRootOperation()) !=
+           nullptr;
+  });
+  EXPECT_EQ(numSorts, 1);
+  auto result = join.computeResultOnlyForTesting(false);
+  EXPECT_THAT(result.idTable(),
+              matchesIdTableFromVector({{1, 1}, {1, 2}, {2, 1}}));
+}
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, duplicatesAndEstimates) {
+  auto qec = getQec();
+  MultiwayJoin join{
+      qec,
+      {makeChild(qec, {{1, 5}, {1, 5}, {2, 6}}, Vars{V{"?x"}, V{"?y"}}),
+       makeChild(qec, {{1, 7}, {3, 8}}, Vars{V{"?x"}, V{"?z"}})},
+      42};
+  EXPECT_EQ(join.getSizeEstimate(), 42);
+  EXPECT_GE(join.getCostEstimate(), 42 + 3 + 2);
+  EXPECT_GE(join.getMultiplicity(0), 1.0f);
+  auto result = join.computeResultOnlyForTesting(false);
+  EXPECT_THAT(result.idTable(),
+              matchesIdTableFromVector({{1, 5, 7}, {1, 5, 7}}));
+
+  // Without a hint, the size of the smallest child is used.
+  MultiwayJoin join2{
+      qec,
+      {makeChild(qec, {{1, 5}, {1, 5}, {2, 6}}, Vars{V{"?x"}, V{"?y"}}),
+       makeChild(qec, {{1, 7}, {3, 8}}, Vars{V{"?x"}, V{"?z"}})}};
+  EXPECT_EQ(join2.getSizeEstimate(), 2);
+}
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, illegalChildren) {
+  auto qec = getQec();
+  auto child = makeChild(qec, {{1, 2}}, Vars{V{"?x"}, V{"?y"}});
+  // At least two children are required.
+  EXPECT_ANY_THROW((MultiwayJoin{qec, {child}}));
+  // All columns must be bound to variables.
+  auto unbound = makeChild(qec, {{1, 2}}, Vars{V{"?x"}, std::nullopt});
+  EXPECT_ANY_THROW((MultiwayJoin{qec, {child, unbound}}));
+}
+
+// _____________________________________________________________________________
+TEST(MultiwayJoin, queryPlannerUsesMultiwayJoinForCyclicPatterns) {
+  // A layered graph, in which each of the `k` nodes `<a_i>` has an edge to
+  // each of the nodes `<b_j>`, which have an edge to each of the nodes
+  // `<c_l>`. Together with the single edge from `<c_0>` to `<a_0>`, this
+  // leads to many paths of length two, but only `k` triangles.
+  constexpr size_t k = 8;
+  std::string kg = "<c_0> <p> <a_0> . ";
+  for (size_t i = 0; i < k; ++i) {
+    for (size_t j = 0; j < k; ++j) {
+      absl::StrAppend(&kg, "<a_", i, "> <p> <b_", j, "> . <b_", i, "> <p> <c_",
+                      j, "> . ");
+    }
+  }
+  auto qec = getQec(kg);
+  auto plan = [&qec]() {
+    QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+    auto pq = SparqlParser::parseQuery(
+        &qec->getIndex().encodedIriManager(),
+        "SELECT * { ?a <p> ?b . ?b <p> ?c . ?c <p> ?a }");
+    return qp.createExecutionTree(pq);
+  };
+  auto isMultiwayJoin = [](const QueryExecutionTree& qet) {
+    bool found = std::dynamic_pointer_cast<MultiwayJoin>(
+                     qet.getRootOperation()) != nullptr;
+    qet.forAllDescendants([&found](const QueryExecutionTree* descendant) {
+      found = found || std::dynamic_pointer_cast<MultiwayJoin>(
+                           descendant->getRootOperation()) != nullptr;
+    });
+    return found;
+  };
+  // Each of the `k` triangles occurs once per rotation.
+  constexpr size_t numTriangles = 3 * k;
+
+  // The intermediate results are estimated to be larger than the inputs, but
+  // smaller than the default threshold.
+  EXPECT_FALSE(isMultiwayJoin(plan()));
+
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::multiwayJoinMinIntermediateSize_>(0);
+  {
+    auto qet = plan();
+    EXPECT_TRUE(isMultiwayJoin(qet));
+    EXPECT_EQ(qet.getResult()->idTable().size(), numTriangles);
+  }
+
+  // The `MultiwayJoin` can be disabled completely, the binary joins compute
+  // the same result.
+  {
+    auto cleanup2 =
+        setRuntimeParameterForTest<&RuntimeParameters::enableMultiwayJoin_>(
+            false);
+    auto qet = plan();
+    EXPECT_FALSE(isMultiwayJoin(qet));
+    EXPECT_EQ(qet.getResult()->idTable().size(), numTriangles);
+  }
+}
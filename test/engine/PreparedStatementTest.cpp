@@ -0,0 +1,257 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "../util/GTestHelpers.h"
+#include "../util/IndexTestHelpers.h"
+#include "../util/RuntimeParametersTestHelpers.h"
+#include "engine/IndexScan.h"
+#include "engine/PreparedStatement.h"
+#include "engine/QueryPlanCache.h"
+#include "engine/QueryPlanner.h"
+#include "parser/SparqlParser.h"
+
+namespace {
+using namespace ad_utility::testing;
+using namespace ::testing;
+using Values = ad_utility::HashMap<std::string, std::string>;
+
+constexpr std::string_view kg =
+    "<a> <p> <b> . <a> <p> <c> . <b> <p> <c> . <c> <q> <d> . <b> <q> <d> .";
+
+// Create a `PreparedStatement` for the `templateString` using the `qec`.
+PreparedStatement makeStatement(QueryExecutionContext* qec,
+                                std::string templateString) {
+  return PreparedStatement{std::move(templateString), {},
+                           &qec->getIndex().encodedIriManager()};
+}
+
+// Parse the `query`.
+ParsedQuery parse(QueryExecutionContext* qec, std::string query) {
+  return SparqlParser::parseQuery(&qec->getIndex().encodedIriManager(),
+                                  std::move(query));
+}
+
+// Plan the `parsedQuery`.
+QueryExecutionTree plan(QueryExecutionContext* qec, ParsedQuery parsedQuery) {
+  QueryPlanner qp{qec, std::make_shared<ad_utility::CancellationHandle<>>()};
+  return qp.createExecutionTree(parsedQuery);
+}
+
+// Return the result of the `qet` as a sorted vector of rows.
+std::vector<std::vector<Id>> getRows(QueryExecutionTree& qet) {
+  auto result = qet.getResult();
+  std::vector<std::vector<Id>> rows;
+  for (const auto& row : result->idTable()) {
+    rows.emplace_back(row.begin(), row.end());
+  }
+  ql::ranges::sort(rows);
+  return rows;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(PreparedStatement, parameterNames) {
+  auto qec = getQec(std::string{kg});
+  auto statement = makeStatement(
+      qec,
+      "# A comment with $notAParameter\n"
+      "SELECT ?x WHERE { ?x <p> $object . $subject <p> ?x . "
+      "?x <q> \"$notAParameterEither\" . $subject <q> ?y }");
+  EXPECT_THAT(statement.parameterNames(), ElementsAre("object", "subject"));
+  EXPECT_TRUE(statement.isRebindable());
+  EXPECT_EQ(statement.parameterSlots().at("object").size(), 1);
+  EXPECT_EQ(statement.parameterSlots().at("subject").size(), 2);
+
+  // The template has to be a valid query.
+  EXPECT_ANY_THROW(makeStatement(qec, "SELECT ?x WHERE { ?x <p> $o "));
+}
+
+// _____________________________________________________________________________
+TEST(PreparedStatement, isRebindable) {
+  auto qec = getQec(std::string{kg});
+  auto isRebindable = [&qec](std::string templateString) {
+    return makeStatement(qec, std::move(templateString)).isRebindable();
+  };
+  EXPECT_TRUE(isRebindable("SELECT * { ?x $p $o }"));
+  EXPECT_TRUE(isRebindable("SELECT * { { ?x <p> $o } UNION { ?x <q> $o } }"));
+  EXPECT_TRUE(isRebindable("SELECT * { ?x <p> ?y OPTIONAL { ?y <q> $o } }"));
+  // Parameters that are selected or used outside of triples.
+  EXPECT_FALSE(isRebindable("SELECT $o { ?x <p> $o }"));
+  EXPECT_FALSE(isRebindable("SELECT * { ?x <p> ?y FILTER(?y != $o) }"));
+  EXPECT_FALSE(isRebindable("SELECT * { ?x <p> ?y VALUES ?y { $o } }"));
+  // The same variable is also written with a leading `?`.
+  EXPECT_FALSE(isRebindable("SELECT * { ?x <p> $o . ?o <q> ?x }"));
+  // A statement without parameters is trivially rebindable.
+  EXPECT_TRUE(isRebindable("SELECT * { ?x <p> ?o }"));
+}
+
+// _____________________________________________________________________________
+TEST(PreparedStatement, isSingleRdfTerm) {
+  using PS = PreparedStatement;
+  EXPECT_TRUE(PS::isSingleRdfTerm("<http://example.org/a>"));
+  EXPECT_TRUE(PS::isSingleRdfTerm("\"literal\""));
+  EXPECT_TRUE(PS::isSingleRdfTerm("'literal with \\' escape'"));
+  EXPECT_TRUE(PS::isSingleRdfTerm("\"hallo\"@de-CH"));
+  EXPECT_TRUE(PS::isSingleRdfTerm(
+      "\"42\"^^<http://www.w3.org/2001/XMLSchema#integer>"));
+  EXPECT_TRUE(PS::isSingleRdfTerm("42"));
+  EXPECT_TRUE(PS::isSingleRdfTerm("-4.2e3"));
+  EXPECT_TRUE(PS::isSingleRdfTerm("true"));
+
+  EXPECT_FALSE(PS::isSingleRdfTerm(""));
+  EXPECT_FALSE(PS::isSingleRdfTerm("?x"));
+  EXPECT_FALSE(PS::isSingleRdfTerm("<a> } ; DROP ALL #"));
+  EXPECT_FALSE(PS::isSingleRdfTerm("<a> <b>"));
+  EXPECT_FALSE(PS::isSingleRdfTerm("\"a\" . ?x ?y ?z"));
+  EXPECT_FALSE(PS::isSingleRdfTerm("\"unterminated"));
+  EXPECT_FALSE(PS::isSingleRdfTerm("\"\"\"long\"\"\""));
+  EXPECT_FALSE(PS::isSingleRdfTerm("\"a\"@"));
+  EXPECT_FALSE(PS::isSingleRdfTerm("\"a\"^^"));
+  EXPECT_FALSE(PS::isSingleRdfTerm("prefix:name"));
+}
+
+// _____________________________________________________________________________
+TEST(PreparedStatement, bindParameters) {
+  auto qec = getQec(std::string{kg});
+  auto statement =
+      makeStatement(qec, "SELECT * { ?x <p> $o . ?x <q> $o . $s <p> ?x }");
+  EXPECT_EQ(statement.bindParameters(Values{{"o", "<b>"}, {"s", "42"}}),
+            "SELECT * { ?x <p> <b>  . ?x <q> <b>  . 42  <p> ?x }");
+
+  // Missing, unknown, and invalid values.
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      statement.bindParameters(Values{{"o", "<b>"}}),
+      HasSubstr("No value was specified for the parameter \"$s\""));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      statement.bindParameters(
+          Values{{"o", "<b>"}, {"s", "<c>"}, {"t", "<d>"}}),
+      HasSubstr("no parameter with the name \"$t\""));
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      statement.bindParameters(Values{{"o", "<b> } #"}, {"s", "<c>"}}),
+      HasSubstr("must be a single IRI"));
+}
+
+// _____________________________________________________________________________
+TEST(PreparedStatement, getParameterValues) {
+  auto qec = getQec(std::string{kg});
+  auto statement = makeStatement(qec, "SELECT * { ?x <p> $o . $s <q> ?x }");
+  auto values = statement.getParameterValues(parse(
+      qec, statement.bindParameters(Values{{"o", "<b>"}, {"s", "\"s\""}})));
+  ASSERT_TRUE(values.has_value());
+  EXPECT_EQ(values->at("o"), TripleComponent::Iri::fromIriref("<b>"));
+  EXPECT_EQ(values->at("s"), TripleComponent::Literal::fromStringRepresentation(
+                                 "\"s\""));
+
+  // The structure of the query doesn't match the template.
+  EXPECT_EQ(statement.getParameterValues(parse(qec, "SELECT * { ?x <p> <b> }")),
+            std::nullopt);
+
+  // A statement that is not rebindable never has parameter values.
+  auto notRebindable = makeStatement(qec, "SELECT $o { ?x <p> $o }");
+  EXPECT_EQ(notRebindable.getParameterValues(parse(
+                qec, notRebindable.bindParameters(Values{{"o", "<b>"}}))),
+            std::nullopt);
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, rebindPlan) {
+  auto qec = getQec(std::string{kg});
+  auto statement = makeStatement(qec, "SELECT ?x { ?x <p> $o . ?x <q> ?y }");
+  auto queryFor = [&statement, &qec](std::string value) {
+    return parse(qec, statement.bindParameters(Values{{"o", value}}));
+  };
+  auto parsedB = queryFor("<b>");
+  auto parsedC = queryFor("<c>");
+  auto valuesB = statement.getParameterValues(parsedB).value();
+  auto valuesC = statement.getParameterValues(parsedC).value();
+
+  auto planB = plan(qec, parsedB);
+  auto rebound = QueryPlanCache::rebindPlan(planB.clone(), valuesB, valuesC,
+                                            statement, *qec);
+  ASSERT_TRUE(rebound.has_value());
+  auto planC = plan(qec, parsedC);
+  EXPECT_EQ(rebound->getCacheKey(), planC.getCacheKey());
+  EXPECT_EQ(getRows(rebound.value()), getRows(planC));
+  // The original plan is unchanged.
+  EXPECT_THAT(planB.getCacheKey(), HasSubstr("<b>"));
+
+  // If the parameter value appears at another position of the query, the
+  // plan cannot be rebound.
+  auto statement2 = makeStatement(qec, "SELECT ?x { ?x <p> $o . <b> <q> ?x }");
+  auto parsed2 = parse(qec, statement2.bindParameters(Values{{"o", "<b>"}}));
+  auto values2 = statement2.getParameterValues(parsed2).value();
+  auto rebound2 = QueryPlanCache::rebindPlan(
+      plan(qec, parsed2).clone(), values2, valuesC, statement2, *qec);
+  EXPECT_FALSE(rebound2.has_value());
+
+  // Other constants that merely contain the value as a substring don't
+  // prevent the rebinding.
+  auto statement3 = makeStatement(
+      qec, "SELECT ?x { ?x <p> $o . ?x <q> ?y FILTER(?y != \"<b>\") }");
+  auto parsed3 = parse(qec, statement3.bindParameters(Values{{"o", "<b>"}}));
+  auto values3 = statement3.getParameterValues(parsed3).value();
+  auto parsed3C = parse(qec, statement3.bindParameters(Values{{"o", "<c>"}}));
+  auto rebound3 = QueryPlanCache::rebindPlan(
+      plan(qec, parsed3).clone(), values3,
+      statement3.getParameterValues(parsed3C).value(), statement3, *qec);
+  ASSERT_TRUE(rebound3.has_value());
+  auto plan3C = plan(qec, parsed3C);
+  EXPECT_EQ(rebound3->getCacheKey(), plan3C.getCacheKey());
+  EXPECT_EQ(getRows(rebound3.value()), getRows(plan3C));
+}
+
+// _____________________________________________________________________________
+TEST(QueryPlanCache, getOrCreatePlan) {
+  auto qec = getQec(std::string{kg});
+  auto statement = makeStatement(qec, "SELECT ?x { ?x <p> $o . ?x <q> ?y }");
+  QueryPlanCache cache;
+  // The `qec` is owned by the test helpers, so it must not be deleted.
+  auto makeContext = [&qec]() {
+    return std::shared_ptr<QueryExecutionContext>{qec, [](auto*) {}};
+  };
+  size_t numPlannerCalls = 0;
+  auto getPlan = [&](std::string value) {
+    auto parsed =
+        parse(qec, statement.bindParameters(Values{{"o", std::move(value)}}));
+    return cache.getOrCreatePlan(
+        statement, parsed, *qec,
+        [&]() {
+          ++numPlannerCalls;
+          return plan(qec, parsed);
+        },
+        makeContext);
+  };
+
+  // The first execution is planned and stored, the second one with a
+  // different value validates the cached plan.
+  getPlan("<b>");
+  EXPECT_EQ(cache.numEntries(), 1);
+  getPlan("<c>");
+  EXPECT_EQ(numPlannerCalls, 2);
+  EXPECT_EQ(cache.numMisses(), 2);
+
+  // From now on, the query planner is not called anymore.
+  auto qet = getPlan("<b>");
+  EXPECT_EQ(numPlannerCalls, 2);
+  EXPECT_EQ(cache.numHits(), 1);
+  EXPECT_EQ(qet.getCacheKey(),
+            plan(qec, parse(qec, statement.bindParameters(
+                                     Values{{"o", "<b>"}})))
+                .getCacheKey());
+
+  // A significant change of the number of delta triples clears the cache.
+  cache.onDeltaTriplesChanged(0, 100);
+  EXPECT_EQ(cache.numEntries(), 1);
+  cache.onDeltaTriplesChanged(50, 100);
+  EXPECT_EQ(cache.numEntries(), 0);
+
+  // Plan caching can be disabled via the runtime parameter.
+  auto cleanup = setRuntimeParameterForTest<
+      &RuntimeParameters::queryPlanCacheMaxNumEntries_>(0);
+  getPlan("<b>");
+  EXPECT_EQ(cache.numEntries(), 0);
+}
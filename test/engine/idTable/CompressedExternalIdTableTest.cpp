@@ -360,3 +360,35 @@ TEST(CompressedExternalIdTable, WrongNumberOfColsWhenPushing) {
   EXPECT_NO_THROW(t1.setNumColumns(NUM_COLS + 1));
   EXPECT_ANY_THROW(erased.pushBlock(t1));
 }
+
+// Test that pushing complete blocks (which are split and combined into the
+// blocks of the sorter) yields the same result as pushing single rows.
+TEST(CompressedExternalIdTable, sorterPushBlock) {
+  std::string filename = "idTableCompressedSorter.pushBlock.dat";
+  ad_utility::EXTERNAL_ID_TABLE_SORTER_IGNORE_MEMORY_LIMIT_FOR_TESTING = true;
+  auto alloc = ad_utility::testing::makeAllocator();
+  // With 10 kB memory and NUM_COLS (4) columns, the blocksize is 156 rows, so
+  // the pushed blocks are smaller and larger than the blocks of the sorter.
+  ad_utility::CompressedExternalIdTableSorter<SortByOSP, NUM_COLS> writer{
+      filename, NUM_COLS, 10_kB, alloc};
+  ad_utility::CompressedExternalIdTableSorterTypeErased& erased = writer;
+  IdTable randomTable = createRandomlyFilledIdTable(0, NUM_COLS);
+  for (size_t numRows : {0, 1, 100, 156, 1000, 57}) {
+    auto block = createRandomlyFilledIdTable(numRows, NUM_COLS);
+    erased.pushBlock(block);
+    randomTable.insertAtEnd(block);
+  }
+  // Blocks can also be pushed as views, e.g. with permuted columns.
+  std::vector<ColumnIndex> permutation{3, 2, 1, 0};
+  auto block = createRandomlyFilledIdTable(200, NUM_COLS);
+  erased.pushBlock(block.asColumnSubsetView(permutation));
+  randomTable.insertAtEnd(block, std::nullopt, std::nullopt, permutation);
+  EXPECT_EQ(writer.size(), randomTable.size());
+
+  CopyableIdTable<NUM_COLS> expected =
+      std::move(randomTable).toStatic<NUM_COLS>();
+  ql::ranges::sort(expected, SortByOSP{});
+  auto result =
+      idTableFromRowGenerator<NUM_COLS>(writer.sortedView(), NUM_COLS);
+  EXPECT_THAT(result, ::testing::ElementsAreArray(expected));
+}
@@ -259,4 +259,37 @@ TEST(EncodedIriManager, HardcodedPrefixesJson) {
   ASSERT_TRUE(id2.has_value());
 }
 
+// _____________________________________________________________________________
+TEST(EncodedIriManager, shortLiterals) {
+  EncodedIriManager disabled{{"http://example.org/"}};
+  EXPECT_FALSE(disabled.encode("\"yes\"").has_value());
+  EXPECT_FALSE(disabled.encodeLiteral("\"yes\"").has_value());
+
+  EncodedIriManager em{{"http://example.org/"}, true};
+  auto id = em.encode("\"yes\"");
+  ASSERT_TRUE(id.has_value());
+  EXPECT_EQ(id.value().getDatatype(), Datatype::InlineLiteral);
+  EXPECT_EQ(id.value().getInlineLiteral().toStringRepresentation(), "\"yes\"");
+  EXPECT_EQ(em.encodeLiteral("\"yes\""), id);
+  // IRIs are still encoded as before.
+  EXPECT_EQ(em.encode("<http://example.org/42>"),
+            disabled.encode("<http://example.org/42>"));
+  // Long literals and literals with a datatype or a language tag are not
+  // encoded.
+  EXPECT_FALSE(em.encode("\"a long literal\"").has_value());
+  EXPECT_FALSE(em.encode("\"yes\"@en").has_value());
+  EXPECT_FALSE(
+      em.encode("\"1\"^^<http://www.w3.org/2001/XMLSchema#int>").has_value());
+
+  EXPECT_NE(em, disabled);
+  EXPECT_EQ(em, (EncodedIriManager{{"http://example.org/"}, true}));
+
+  // The setting is part of the JSON representation. Indices that were built
+  // before the setting existed don't encode literals.
+  nlohmann::json j = em;
+  EXPECT_EQ(j.get<EncodedIriManager>(), em);
+  j.erase("encode-short-literals");
+  EXPECT_EQ(j.get<EncodedIriManager>(), disabled);
+}
+
 }  // namespace
@@ -331,6 +331,61 @@ TEST(IndexRebuilder, readIndexAndRemap) {
                  {V(6), V(4), B(0), newG, Id::makeFromInt(1), patternId}}));
 }
 
+// _____________________________________________________________________________
+TEST(IndexRebuilder, mergeAdditionalTriples) {
+  auto U = Id::makeUndefined();
+  auto toRange = [](std::vector<IdTable> tables) {
+    std::vector<IdTableStatic<0>> blocks;
+    for (auto& table : tables) {
+      blocks.emplace_back(std::move(table));
+    }
+    return ad_utility::InputRangeTypeErased{std::move(blocks)};
+  };
+  std::vector<IdTable> existing;
+  existing.push_back(makeIdTableFromVector({{V(1), V(1), V(1), V(0), V(7)},
+                                            {V(1), V(2), V(1), V(0), V(7)}}));
+  existing.push_back(makeIdTableFromVector({{V(3), V(1), V(1), V(0), V(7)}}));
+  existing.push_back(makeIdTableFromVector({{V(5), V(1), V(1), V(0), V(7)}}));
+
+  // The first triple is already contained in the existing triples, and some
+  // triples are contained twice.
+  std::vector<IdTable> additional;
+  additional.push_back(makeIdTableFromVector({{V(1), V(2), V(1), V(0)},
+                                              {V(1), V(3), V(1), V(0)},
+                                              {V(1), V(3), V(1), V(0)},
+                                              {V(2), V(1), V(1), V(0)}}));
+  additional.push_back(makeIdTableFromVector(
+      {{V(6), V(1), V(1), V(0)}, {V(6), V(1), V(1), V(0)}}));
+
+  auto result = ::ranges::to<std::vector>(
+      mergeAdditionalTriples(toRange(std::move(existing)),
+                             toRange(std::move(additional)), 5) |
+      ql::views::transform(ad_utility::staticCast<IdTableStatic<0>&&>));
+
+  // The blocks without additional triples are passed through unchanged.
+  ASSERT_EQ(result.size(), 4);
+  EXPECT_EQ(result.at(0), makeIdTableFromVector(
+                              {{V(1), V(1), V(1), V(0), V(7)},
+                               {V(1), V(2), V(1), V(0), V(7)}}));
+  EXPECT_EQ(result.at(1), makeIdTableFromVector(
+                              {{V(1), V(3), V(1), V(0), U},
+                               {V(2), V(1), V(1), V(0), U},
+                               {V(3), V(1), V(1), V(0), V(7)}}));
+  EXPECT_EQ(result.at(2),
+            makeIdTableFromVector({{V(5), V(1), V(1), V(0), V(7)}}));
+  EXPECT_EQ(result.at(3), makeIdTableFromVector({{V(6), V(1), V(1), V(0), U}}));
+
+  // Without additional triples, the existing triples are unchanged.
+  std::vector<IdTable> single;
+  single.push_back(makeIdTableFromVector({{V(1), V(1), V(1), V(0), V(7)}}));
+  auto unchanged = ::ranges::to<std::vector>(
+      mergeAdditionalTriples(toRange(std::move(single)), toRange({}), 5) |
+      ql::views::transform(ad_utility::staticCast<IdTableStatic<0>&&>));
+  ASSERT_EQ(unchanged.size(), 1);
+  EXPECT_EQ(unchanged.at(0),
+            makeIdTableFromVector({{V(1), V(1), V(1), V(0), V(7)}}));
+}
+
 // _____________________________________________________________________________
 TEST(IndexRebuilder, getNumColumns) {
   EXPECT_EQ(getNumColumns({}), 4);
@@ -571,6 +626,62 @@ TEST(IndexRebuilder, materializeToIndexNoLogFileName) {
       ad_utility::Exception);
 }
 
+// _____________________________________________________________________________
+TEST(IndexRebuilder, mergeFilesIntoIndex) {
+  auto cancellationHandle =
+      std::make_shared<ad_utility::SharedCancellationHandle::element_type>();
+  std::string baseFolder = "/tmp/mergeFilesIntoIndex";
+  std::string newIndexName = baseFolder + "/index";
+  std::string inputFile = baseFolder + "/input.nt";
+
+  std::filesystem::create_directory(baseFolder);
+  absl::Cleanup removeIndexFiles{
+      [&baseFolder] { std::filesystem::remove_all(baseFolder); }};
+  {
+    // The first triple is already contained in the existing index, and the
+    // same blank node label has to be mapped to the same blank node.
+    auto file = ad_utility::makeOfstream(inputFile);
+    file << "<a> <b> <c> .\n<x> <b> \"new\" .\n_:g <e> _:g .\n"
+         << "<x> <b> \"new\"@en .\n<x> <b> \"new\" .\n";
+  }
+  std::vector<qlever::InputFileSpecification> files{
+      {inputFile, qlever::Filetype::Turtle, std::nullopt}};
+
+  auto index = ad_utility::testing::makeTestIndex(
+      "mergeFilesIntoIndex", "<a> <b> <c> . <d> <e> _:f .");
+  AD_EXPECT_THROW_WITH_MESSAGE(
+      qlever::mergeFilesIntoIndex(index.getImpl(), files,
+                                  index.getImpl().getOnDiskBase(),
+                                  cancellationHandle),
+      ::testing::HasSubstr("must not overwrite"));
+
+  auto numInternalTriplesBefore = index.getImpl().numTriples().internal;
+  qlever::mergeFilesIntoIndex(index.getImpl(), files, newIndexName,
+                              cancellationHandle);
+  EXPECT_TRUE(std::filesystem::exists(newIndexName + ".merge-index-log.txt"));
+  // The new triples and words are not added to the delta triples of the index.
+  auto [state, entries, ownedBlocks] =
+      index.deltaTriplesManager()
+          .getCurrentLocatedTriplesSharedStateWithVocab();
+  EXPECT_TRUE(entries.empty());
+  EXPECT_TRUE(ownedBlocks.empty());
+
+  IndexImpl newIndex{ad_utility::makeUnlimitedAllocator<Id>()};
+  newIndex.createFromOnDiskIndex(newIndexName, false);
+  EXPECT_EQ(newIndex.numTriples().normal, 5);
+  // The two internal triples for the language tag.
+  EXPECT_EQ(newIndex.numTriples().internal, numInternalTriplesBefore + 2);
+  EXPECT_EQ(newIndex.numDistinctSubjects().normal, 4);
+  EXPECT_EQ(newIndex.numDistinctObjects().normal, 5);
+  auto [lower, upper] = newIndex.getVocab().getPositionOfWord("\"new\"");
+  EXPECT_NE(lower, upper);
+
+  // The existing index is not modified.
+  IndexImpl existingIndex{ad_utility::makeUnlimitedAllocator<Id>()};
+  existingIndex.createFromOnDiskIndex("mergeFilesIntoIndex", false);
+  EXPECT_EQ(existingIndex.numTriples().normal, 2);
+}
+
 namespace {
 // Get rid of previous files with the specified prefix.
 void cleanFilesWithPrefix(std::string_view prefix) {
@@ -31,6 +31,10 @@ void testForVocabType(VocabularyType::Enum vocabType) {
   EXPECT_EQ(vocab[1], "beta");
   EXPECT_EQ(vocab[2], "gamma");
 
+  std::vector<uint64_t> indices{0, 2};
+  EXPECT_THAT(vocab.lookupBatch(indices),
+              ::testing::ElementsAre("alpha", "gamma"));
+
   auto wI = vocab.lower_bound("alx", ql::ranges::less{});
   EXPECT_EQ(wI.index(), 1);
   EXPECT_EQ(wI.word(), "beta");
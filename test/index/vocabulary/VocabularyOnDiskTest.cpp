@@ -2,8 +2,11 @@
 // Chair of Algorithms and Data Structures.
 // Author: Johannes Kalmbach <johannes.kalmbach@gmail.com>
 
+#include <absl/strings/str_cat.h>
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include "./VocabularyTestHelpers.h"
 #include "backports/algorithm.h"
 #include "index/vocabulary/VocabularyOnDisk.h"
@@ -146,3 +149,35 @@ TEST(VocabularyOnDisk, ErrorOnNonAscendingIds) {
 TEST(VocabularyOnDisk, EmptyVocabulary) {
   testEmptyVocabulary(createVocabulary("EmptyVocabulary"));
 }
+
+TEST(VocabularyOnDisk, LookupBatch) {
+  // Some of the words are so large that the neighboring words are not read
+  // with a single read.
+  std::vector<std::string> words;
+  for (size_t i = 0; i < 200; ++i) {
+    words.push_back(i % 17 == 0 ? std::string(5000 + i, 'a' + i % 26)
+                                : absl::StrCat("word", i));
+  }
+  auto testVocab = [&words](const VocabularyOnDisk& vocab) {
+    std::vector<uint64_t> indices{0, 1, 2, 16, 17, 18, 50, 51, 199};
+    auto result = vocab.lookupBatch(indices);
+    ASSERT_EQ(result.size(), indices.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+      EXPECT_EQ(result[i], words[indices[i]]);
+    }
+    std::vector<uint64_t> all(words.size());
+    std::iota(all.begin(), all.end(), 0);
+    EXPECT_EQ(vocab.lookupBatch(all), words);
+    EXPECT_TRUE(vocab.lookupBatch({}).empty());
+
+    // The indices must be sorted, unique, and valid.
+    std::vector<uint64_t> unsorted{2, 1};
+    EXPECT_ANY_THROW(vocab.lookupBatch(unsorted));
+    std::vector<uint64_t> duplicates{1, 1};
+    EXPECT_ANY_THROW(vocab.lookupBatch(duplicates));
+    std::vector<uint64_t> outOfBounds{1, 200};
+    EXPECT_ANY_THROW(vocab.lookupBatch(outOfBounds));
+  };
+  testVocab(createVocabulary("LookupBatch1")(words));
+  testVocab(createVocabularyFromDisk("LookupBatch2")(words));
+}
@@ -0,0 +1,160 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include <map>
+#include <random>
+
+#include "backports/algorithm.h"
+#include "util/JoinAlgorithms/LeapfrogTriejoin.h"
+
+using ad_utility::LeapfrogRelation;
+using namespace ::testing;
+
+namespace {
+using Tuple = std::vector<int>;
+using Pairs = std::vector<std::array<int, 2>>;
+
+// Store the columns of a sorted binary relation and make a
+// `LeapfrogRelation` that refers to them.
+struct BinaryRelation {
+  std::vector<int> first_;
+  std::vector<int> second_;
+  BinaryRelation(Pairs pairs) {
+    ql::ranges::sort(pairs);
+    for (auto [a, b] : pairs) {
+      first_.push_back(a);
+      second_.push_back(b);
+    }
+  }
+  LeapfrogRelation<int> relation(size_t varA, size_t varB) const {
+    return {{first_, second_}, {varA, varB}};
+  }
+};
+
+// Run the leapfrog triejoin and return the result tuples (including
+// duplicates) in the order in which they were reported.
+std::vector<Tuple> join(const std::vector<LeapfrogRelation<int>>& relations,
+                        size_t numVariables) {
+  std::vector<Tuple> result;
+  ad_utility::leapfrogTriejoin(relations, numVariables,
+                               [&result](const Tuple& tuple, size_t mult) {
+                                 for (size_t i = 0; i < mult; ++i) {
+                                   result.push_back(tuple);
+                                 }
+                               });
+  return result;
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, triangle) {
+  // Triangles in the graph with edges 1->2, 2->3, 3->1, 1->3, 3->4.
+  BinaryRelation edges{Pairs{{1, 2}, {2, 3}, {3, 1}, {1, 3}, {3, 4}}};
+  // `?a -> ?b -> ?c` and `?a -> ?c`.
+  auto result = join(
+      {edges.relation(0, 1), edges.relation(1, 2), edges.relation(0, 2)}, 3);
+  EXPECT_THAT(result, ElementsAre(Tuple{1, 2, 3}));
+
+  // `?a -> ?b -> ?c -> ?a`, the third relation is scanned as `(?a, ?c)` and
+  // therefore needs the reversed edges.
+  BinaryRelation reversed{Pairs{{2, 1}, {3, 2}, {1, 3}, {3, 1}, {4, 3}}};
+  result = join(
+      {edges.relation(0, 1), edges.relation(1, 2), reversed.relation(0, 2)}, 3);
+  // The cycle `1 -> 2 -> 3 -> 1` is found once per starting point.
+  EXPECT_THAT(result,
+              ElementsAre(Tuple{1, 2, 3}, Tuple{2, 3, 1}, Tuple{3, 1, 2}));
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, duplicatesAndNonJoinVariables) {
+  // Duplicates in the input lead to duplicates in the output.
+  BinaryRelation r{Pairs{{1, 5}, {1, 5}, {2, 6}}};
+  BinaryRelation s{Pairs{{1, 7}, {1, 8}, {3, 9}}};
+  auto result = join({r.relation(0, 1), s.relation(0, 2)}, 3);
+  EXPECT_THAT(result, ElementsAre(Tuple{1, 5, 7}, Tuple{1, 5, 7},
+                                  Tuple{1, 5, 8}, Tuple{1, 5, 8}));
+
+  // A single relation is simply enumerated.
+  result = join({r.relation(0, 1)}, 2);
+  EXPECT_THAT(result, ElementsAre(Tuple{1, 5}, Tuple{1, 5}, Tuple{2, 6}));
+
+  // Empty inputs lead to an empty result.
+  BinaryRelation empty{Pairs{}};
+  EXPECT_THAT(join({r.relation(0, 1), empty.relation(1, 2)}, 3), IsEmpty());
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, compareWithNestedLoopJoin) {
+  std::mt19937 gen{42};
+  for (size_t iteration = 0; iteration < 100; ++iteration) {
+    int maxValue = 3 + static_cast<int>(iteration % 7);
+    auto randomRelation = [&]() {
+      Pairs pairs;
+      size_t size = gen() % 40;
+      for (size_t i = 0; i < size; ++i) {
+        pairs.push_back({static_cast<int>(gen() % maxValue),
+                         static_cast<int>(gen() % maxValue)});
+      }
+      return BinaryRelation{std::move(pairs)};
+    };
+    // A 4-cycle with a chord: (a,b), (b,c), (c,d), (a,d), (a,c).
+    std::array relations{randomRelation(), randomRelation(), randomRelation(),
+                         randomRelation(), randomRelation()};
+    std::array<std::array<size_t, 2>, 5> vars{
+        {{0, 1}, {1, 2}, {2, 3}, {0, 3}, {0, 2}}};
+    std::vector<LeapfrogRelation<int>> input;
+    for (size_t i = 0; i < relations.size(); ++i) {
+      input.push_back(relations[i].relation(vars[i][0], vars[i][1]));
+    }
+    auto result = join(input, 4);
+    EXPECT_TRUE(ql::ranges::is_sorted(result));
+
+    std::map<Tuple, size_t> expected;
+    auto& [r0, r1, r2, r3, r4] = relations;
+    for (size_t i0 = 0; i0 < r0.first_.size(); ++i0) {
+      for (size_t i1 = 0; i1 < r1.first_.size(); ++i1) {
+        if (r0.second_[i0] != r1.first_[i1]) continue;
+        for (size_t i2 = 0; i2 < r2.first_.size(); ++i2) {
+          if (r1.second_[i1] != r2.first_[i2]) continue;
+          for (size_t i3 = 0; i3 < r3.first_.size(); ++i3) {
+            if (r0.first_[i0] != r3.first_[i3] ||
+                r2.second_[i2] != r3.second_[i3]) {
+              continue;
+            }
+            for (size_t i4 = 0; i4 < r4.first_.size(); ++i4) {
+              if (r0.first_[i0] == r4.first_[i4] &&
+                  r2.first_[i2] == r4.second_[i4]) {
+                ++expected[{r0.first_[i0], r1.first_[i1], r2.first_[i2],
+                            r3.second_[i3]}];
+              }
+            }
+          }
+        }
+      }
+    }
+    std::map<Tuple, size_t> actual;
+    for (const auto& tuple : result) {
+      ++actual[tuple];
+    }
+    EXPECT_EQ(actual, expected);
+  }
+}
+
+// _____________________________________________________________________________
+TEST(LeapfrogTriejoin, illegalInputs) {
+  BinaryRelation r{Pairs{{1, 2}}};
+  auto noop = [](const Tuple&, size_t) {};
+  // Variables not sorted.
+  EXPECT_ANY_THROW(ad_utility::leapfrogTriejoin(
+      std::vector{r.relation(1, 0)}, 2, noop));
+  // Variable out of range.
+  EXPECT_ANY_THROW(ad_utility::leapfrogTriejoin(
+      std::vector{r.relation(0, 2)}, 2, noop));
+  // Variable `2` is not contained in any relation.
+  EXPECT_ANY_THROW(ad_utility::leapfrogTriejoin(
+      std::vector{r.relation(0, 1)}, 3, noop));
+}
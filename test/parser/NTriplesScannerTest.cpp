@@ -0,0 +1,126 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "parser/NTriplesScanner.h"
+
+using namespace nTriplesScanner;
+using Type = ScannedTerm::Type;
+
+// _____________________________________________________________________________
+TEST(NTriplesScanner, findEndOfIriref) {
+  // The positions of the matches are chosen s.t. they are in the first or
+  // second word of eight bytes or in the remaining bytes at the end.
+  std::string_view iri = "<http://example.org/abcdefghijkl> ";
+  EXPECT_EQ(findEndOfIriref(iri, 1), iri.find('>'));
+  EXPECT_EQ(findEndOfIriref("<a>", 1), 2);
+  EXPECT_EQ(findEndOfIriref("<abcdefghijklmnop", 1), 17);
+  for (char c : std::string_view{"<\"{}|^`\\ \t\n"}) {
+    for (size_t pos : {3, 9, 20}) {
+      std::string input(25, 'a');
+      input[pos] = c;
+      input.back() = '>';
+      EXPECT_EQ(findEndOfIriref(input, 1), pos) << c;
+    }
+  }
+  // Non-ASCII characters are allowed.
+  std::string_view unicode = "<http://example.org/äöü€>";
+  EXPECT_EQ(findEndOfIriref(unicode, 1), unicode.size() - 1);
+}
+
+// _____________________________________________________________________________
+TEST(NTriplesScanner, findEndOfLiteral) {
+  std::string_view literal = "\"a literal with <> and ' and äöü\" .";
+  EXPECT_EQ(findEndOfLiteral(literal, 1), literal.rfind('"'));
+  for (char c : std::string_view{"\"\\\n\r"}) {
+    for (size_t pos : {1, 8, 17}) {
+      std::string input(20, 'x');
+      input[pos] = c;
+      EXPECT_EQ(findEndOfLiteral(input, 1), pos) << c;
+    }
+  }
+  EXPECT_EQ(findEndOfLiteral("\"abc", 1), 4);
+}
+
+// _____________________________________________________________________________
+TEST(NTriplesScanner, scanStatement) {
+  auto scan = [](std::string_view input, bool allowGraphLabel = false) {
+    return scanStatement(input, allowGraphLabel);
+  };
+
+  // IRIs and blank nodes, also without whitespace in between.
+  for (std::string_view input :
+       {"<s> <p> _:o1 .", "<s>\t<p>_:o1.", "<s><p>_:o1   .\n"}) {
+    auto statement = scan(input);
+    ASSERT_TRUE(statement.has_value()) << input;
+    const auto& [s, p, o] = statement->triple_;
+    EXPECT_EQ(s.type_, Type::Iriref);
+    EXPECT_EQ(s.text_, "<s>");
+    EXPECT_EQ(p.text_, "<p>");
+    EXPECT_EQ(o.type_, Type::BlankNodeLabel);
+    EXPECT_EQ(o.text_, "_:o1");
+    EXPECT_FALSE(statement->graphLabel_.has_value());
+    EXPECT_EQ(statement->size_, input.find_last_of('.') + 1);
+  }
+
+  // Literals with and without escapes, language tags, and datatypes.
+  auto object = [&scan](std::string_view input) {
+    auto statement = scan(input);
+    EXPECT_TRUE(statement.has_value()) << input;
+    return statement.value_or(ScannedStatement{}).triple_[2];
+  };
+  auto o = object("_:s <p> \"abc\" .");
+  EXPECT_EQ(o.type_, Type::Literal);
+  EXPECT_EQ(o.text_, "\"abc\"");
+  EXPECT_FALSE(o.hasEscapes_);
+  o = object("_:s <p> \"a\\\"b\\\\\" .");
+  EXPECT_EQ(o.text_, "\"a\\\"b\\\\\"");
+  EXPECT_TRUE(o.hasEscapes_);
+  o = object("<s> <p> \"chat\"@en-GB-x1 .");
+  EXPECT_EQ(o.text_, "\"chat\"");
+  EXPECT_EQ(o.languageTag_, "@en-GB-x1");
+  EXPECT_TRUE(o.datatype_.empty());
+  o = object("<s> <p> \"42\"^^<http://www.w3.org/2001/XMLSchema#int>.");
+  EXPECT_EQ(o.text_, "\"42\"");
+  EXPECT_EQ(o.datatype_, "<http://www.w3.org/2001/XMLSchema#int>");
+  EXPECT_TRUE(o.languageTag_.empty());
+
+  // A blank node label must not end with a dot.
+  auto statement = scan("_:s <p> _:o.");
+  ASSERT_TRUE(statement.has_value());
+  EXPECT_EQ(statement->triple_[0].text_, "_:s");
+  EXPECT_EQ(statement->triple_[2].text_, "_:o");
+  EXPECT_EQ(statement->size_, 12);
+
+  // Graph labels.
+  EXPECT_FALSE(scan("<s> <p> <o> <g> .").has_value());
+  statement = scan("<s> <p> \"o\" <g> .", true);
+  ASSERT_TRUE(statement.has_value());
+  ASSERT_TRUE(statement->graphLabel_.has_value());
+  EXPECT_EQ(statement->graphLabel_->text_, "<g>");
+  statement = scan("<s> <p> <o> _:g.", true);
+  ASSERT_TRUE(statement.has_value());
+  EXPECT_EQ(statement->graphLabel_->text_, "_:g");
+  statement = scan("<s> <p> <o> .", true);
+  ASSERT_TRUE(statement.has_value());
+  EXPECT_FALSE(statement->graphLabel_.has_value());
+
+  // Everything else is left to the general parser.
+  for (std::string_view input :
+       {"", "<s> <p> <o>", "<s> <p> \"o\"", "<s> <p> <o> ; <p2> <o2> .",
+        "<s> <p> <o>, <o2> .", "ex:s <p> <o> .", "<s> a <o> .",
+        "<s> <p> 42 .", "<s> <p> true .", "<s> <p> 'o' .",
+        "<s> <p> \"\"\"o\"\"\" .", "<s> <p> \"o\ncontinued\" .",
+        "<s> <p> \"o\"^^xsd:string .", "<s> <p> \"o\"@ .",
+        "<s> <p> \"o\"@en- .", "<s> <p> <o\\u0041> .", "<s> <p> <o o> .",
+        "<s <p> <o> .", "_:äöü <p> <o> .", "_:-s <p> <o> .",
+        "[] <p> <o> .", "@prefix ex: <http://example.org/> .",
+        "<s> \"p\" <o> ."}) {
+    EXPECT_FALSE(scan(input).has_value()) << input;
+    EXPECT_FALSE(scan(input, true).has_value()) << input;
+  }
+}
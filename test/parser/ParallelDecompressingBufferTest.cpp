@@ -0,0 +1,202 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <absl/strings/str_cat.h>
+#include <absl/strings/str_join.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/bzip2.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
+
+#include "../util/GTestHelpers.h"
+#include "parser/ParallelDecompressingBuffer.h"
+#include "util/CompressionUsingZstd/ZstdWrapper.h"
+#include "util/File.h"
+
+namespace {
+namespace io = boost::iostreams;
+
+// Some input that is large enough to consist of several blocks.
+std::string makeInput() {
+  std::string result;
+  for (size_t i = 0; i < 20'000; ++i) {
+    absl::StrAppend(&result, "<s", i, "> <p> \"object ", i, "\" .\n");
+  }
+  return result;
+}
+
+// Split the `input` into `numParts` parts and compress each of them
+// separately with the given `compress` function.
+template <typename F>
+std::vector<std::string> compressInParts(std::string_view input,
+                                         size_t numParts, F compress) {
+  std::vector<std::string> result;
+  for (size_t i = 0; i < numParts; ++i) {
+    auto begin = input.size() * i / numParts;
+    auto end = input.size() * (i + 1) / numParts;
+    result.push_back(compress(input.substr(begin, end - begin)));
+  }
+  return result;
+}
+
+std::string compressZstd(std::string_view input) {
+  auto compressed = ZstdWrapper::compress(input.data(), input.size());
+  return std::string(compressed.begin(), compressed.end());
+}
+
+template <typename Compressor>
+std::string compressWithBoost(std::string_view input) {
+  std::string result;
+  io::filtering_ostream stream;
+  stream.push(Compressor{});
+  stream.push(io::back_inserter(result));
+  stream.write(input.data(), input.size());
+  // Closing the chain writes the footer of the compressed stream.
+  stream.reset();
+  return result;
+}
+
+// Write the `contents` to the file with the given `filename`.
+void writeFile(const std::string& filename, std::string_view contents) {
+  auto of = ad_utility::makeOfstream(filename);
+  of << contents;
+}
+
+// Read all blocks from the `buffer` and check that their concatenation is the
+// `expected` string and that all blocks but the last one are full.
+void expectDecompressed(
+    ParallelBuffer& buffer, std::string_view expected,
+    ad_utility::source_location l = AD_CURRENT_SOURCE_LOC()) {
+  auto trace = generateLocationTrace(l);
+  std::string actual;
+  std::vector<size_t> blockSizes;
+  while (auto block = buffer.getNextBlock()) {
+    actual.append(block->begin(), block->end());
+    blockSizes.push_back(block->size());
+  }
+  EXPECT_EQ(actual, expected);
+  ASSERT_FALSE(blockSizes.empty());
+  blockSizes.pop_back();
+  for (size_t size : blockSizes) {
+    EXPECT_EQ(size, buffer.getBlocksize());
+  }
+  EXPECT_FALSE(buffer.getNextBlock().has_value());
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(ParallelDecompressingBuffer, detectCompression) {
+  using enum InputCompression;
+  EXPECT_EQ(detectInputCompression("\x1f\x8b\x08"), Gzip);
+  EXPECT_EQ(detectInputCompression("BZh9"), Bzip2);
+  EXPECT_EQ(detectInputCompression("BZh"), None);
+  EXPECT_EQ(detectInputCompression("\x28\xb5\x2f\xfd"), Zstd);
+  EXPECT_EQ(detectInputCompression("<s> <p> <o> ."), None);
+  EXPECT_EQ(detectInputCompression(""), None);
+
+  EXPECT_EQ(stripCompressionExtension("data.ttl.gz"), "data.ttl");
+  EXPECT_EQ(stripCompressionExtension("data.nq.bz2"), "data.nq");
+  EXPECT_EQ(stripCompressionExtension("data.nt.zst"), "data.nt");
+  EXPECT_EQ(stripCompressionExtension("data.ttl"), "data.ttl");
+}
+
+// _____________________________________________________________________________
+TEST(ParallelDecompressingBuffer, zstd) {
+  std::string filename = "parallelDecompressingBufferTest.zst";
+  auto input = makeInput();
+  size_t blocksize = 10'000;
+  // Many frames that are decompressed in parallel. With the smaller chunk
+  // size, most of the frames span two chunks.
+  auto frames = compressInParts(input, 17, &compressZstd);
+  writeFile(filename, absl::StrJoin(frames, ""));
+  for (size_t chunkSize : {frames.front().size() + 1, size_t{1 << 20}}) {
+    ParallelDecompressingBuffer buffer{blocksize, filename,
+                                       InputCompression::Zstd, 4, chunkSize};
+    expectDecompressed(buffer, input);
+  }
+  // A single frame that is larger than the chunk size is decompressed by a
+  // single thread.
+  auto compressed = compressZstd(input);
+  writeFile(filename, compressed);
+  {
+    ParallelDecompressingBuffer buffer{blocksize, filename,
+                                       InputCompression::Zstd, 4, 100};
+    expectDecompressed(buffer, input);
+  }
+  // A truncated file.
+  writeFile(filename, compressed.substr(0, compressed.size() - 10));
+  for (size_t chunkSize : {size_t{100}, size_t{1 << 20}}) {
+    ParallelDecompressingBuffer buffer{blocksize, filename,
+                                       InputCompression::Zstd, 4, chunkSize};
+    auto readAll = [&buffer]() {
+      while (buffer.getNextBlock()) {
+      }
+    };
+    EXPECT_ANY_THROW(readAll());
+  }
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(ParallelDecompressingBuffer, gzip) {
+  std::string filename = "parallelDecompressingBufferTest.gz";
+  auto input = makeInput();
+  // Ordinary gzip files cannot be split into independent units and are
+  // decompressed by a single thread.
+  writeFile(filename, compressWithBoost<io::gzip_compressor>(input));
+  {
+    ParallelDecompressingBuffer buffer{10'000, filename,
+                                       InputCompression::Gzip, 4, 100};
+    expectDecompressed(buffer, input);
+  }
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(ParallelDecompressingBuffer, bzip2) {
+  std::string filename = "parallelDecompressingBufferTest.bz2";
+  auto input = makeInput();
+  // Many streams that are decompressed in parallel.
+  auto streams =
+      compressInParts(input, 13, &compressWithBoost<io::bzip2_compressor>);
+  writeFile(filename, absl::StrJoin(streams, ""));
+  for (size_t chunkSize : {streams.front().size() + 1, size_t{1 << 20}}) {
+    ParallelDecompressingBuffer buffer{10'000, filename,
+                                       InputCompression::Bzip2, 4, chunkSize};
+    expectDecompressed(buffer, input);
+  }
+  // A single stream is decompressed by a single thread.
+  writeFile(filename, compressWithBoost<io::bzip2_compressor>(input));
+  {
+    ParallelDecompressingBuffer buffer{10'000, filename,
+                                       InputCompression::Bzip2, 4, 100};
+    expectDecompressed(buffer, input);
+  }
+  ad_utility::deleteFile(filename);
+}
+
+// _____________________________________________________________________________
+TEST(ParallelDecompressingBuffer, makeParallelBufferForFile) {
+  auto input = makeInput();
+  std::string plainFilename = "parallelDecompressingBufferTestPlain.nt";
+  writeFile(plainFilename, input);
+  auto plain = makeParallelBufferForFile(10'000, plainFilename);
+  EXPECT_NE(dynamic_cast<ParallelFileBuffer*>(plain.get()), nullptr);
+  expectDecompressed(*plain, input);
+
+  std::string compressedFilename = "parallelDecompressingBufferTest.nt.zst";
+  writeFile(compressedFilename,
+            absl::StrJoin(compressInParts(input, 5, &compressZstd), ""));
+  auto compressed = makeParallelBufferForFile(10'000, compressedFilename);
+  EXPECT_NE(dynamic_cast<ParallelDecompressingBuffer*>(compressed.get()),
+            nullptr);
+  expectDecompressed(*compressed, input);
+
+  ad_utility::deleteFile(plainFilename);
+  ad_utility::deleteFile(compressedFilename);
+}
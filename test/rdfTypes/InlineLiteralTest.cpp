@@ -0,0 +1,66 @@
+// Copyright 2026 The QLever Authors.
+
+// You may not use this file except in compliance with the Apache 2.0 License,
+// which can be found in the `LICENSE` file at the root of the QLever project.
+
+#include <gmock/gmock.h>
+
+#include "rdfTypes/InlineLiteral.h"
+
+namespace {
+// Encode the given content, which must be encodable.
+InlineLiteral encode(std::string_view content) {
+  auto result = InlineLiteral::fromContent(content);
+  EXPECT_TRUE(result.has_value()) << content;
+  return result.value_or(InlineLiteral{});
+}
+}  // namespace
+
+// _____________________________________________________________________________
+TEST(InlineLiteral, roundTrip) {
+  for (std::string_view content :
+       {"", "a", "yes", "DE", "abcdefg", "\xc3\xa4pfel", "a b\tc"}) {
+    auto literal = encode(content);
+    EXPECT_EQ(literal.size(), content.size());
+    EXPECT_EQ(literal.content(), content);
+    auto repr = absl::StrCat("\"", content, "\"");
+    EXPECT_EQ(literal.toStringRepresentation(), repr);
+    EXPECT_EQ(InlineLiteral::fromStringRepresentation(repr), literal);
+    EXPECT_EQ(
+        InlineLiteral::fromBitRepresentation(literal.toBitRepresentation()),
+        literal);
+  }
+  EXPECT_EQ(InlineLiteral{}, encode(""));
+}
+
+// _____________________________________________________________________________
+TEST(InlineLiteral, unencodable) {
+  static_assert(InlineLiteral::maxSize == 7);
+  EXPECT_FALSE(InlineLiteral::fromContent("abcdefgh").has_value());
+  EXPECT_FALSE(
+      InlineLiteral::fromContent(std::string_view{"a\0b", 3}).has_value());
+  EXPECT_FALSE(InlineLiteral::fromStringRepresentation("\"en\"@en"));
+  EXPECT_FALSE(InlineLiteral::fromStringRepresentation(
+      "\"1\"^^<http://www.w3.org/2001/XMLSchema#int>"));
+  EXPECT_FALSE(InlineLiteral::fromStringRepresentation("<http://a.org/b>"));
+  EXPECT_FALSE(InlineLiteral::fromStringRepresentation("\""));
+  EXPECT_FALSE(InlineLiteral::fromStringRepresentation("\"abcdefgh\""));
+}
+
+// _____________________________________________________________________________
+TEST(InlineLiteral, order) {
+  // The order of the encoded literals is the bytewise order of the contents.
+  std::vector<std::string_view> contents{
+      "",        "A", "Z",        "a",           "aa",
+      "ab",      "b", "\xc3\xa4", "\xe2\x82\xac", "\xf0\x9f\x98\x80"};
+  for (size_t i = 0; i + 1 < contents.size(); ++i) {
+    EXPECT_LT(encode(contents[i]), encode(contents[i + 1]))
+        << contents[i] << ' ' << contents[i + 1];
+    EXPECT_LT(encode(contents[i]).toBitRepresentation(),
+              encode(contents[i + 1]).toBitRepresentation());
+  }
+  // All the bits beyond `numDataBits` are zero.
+  EXPECT_EQ(encode("\xff\xff\xff\xff\xff\xff\xff").toBitRepresentation() >>
+                InlineLiteral::numDataBits,
+            0u);
+}
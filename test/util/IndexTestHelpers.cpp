@@ -224,9 +224,12 @@ Index makeTestIndex(const std::string& indexBasename, TestIndexConfig c) {
     index.getImpl().setVocabularyTypeForIndexBuilding(
         c.vocabularyType.has_value() ? c.vocabularyType.value()
                                      : VocabularyType::random());
-    if (c.encodedPrefixesWithoutAngleBrackets.has_value()) {
+    if (c.encodedPrefixesWithoutAngleBrackets.has_value() ||
+        c.encodeShortLiterals) {
       index.getImpl().setPrefixesForEncodedValues(
-          std::move(c.encodedPrefixesWithoutAngleBrackets.value()));
+          std::move(c.encodedPrefixesWithoutAngleBrackets)
+              .value_or(std::vector<std::string>{}),
+          c.encodeShortLiterals);
     }
     index.createFromFiles({spec});
     if (c.createTextIndex) {
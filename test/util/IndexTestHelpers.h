@@ -69,6 +69,9 @@ struct TestIndexConfig {
   std::optional<VocabularyType> vocabularyType = std::nullopt;
   std::optional<std::vector<std::string>> encodedPrefixesWithoutAngleBrackets =
       std::nullopt;
+  // If true, short plain literals are stored inline in the `Id`s (see
+  // `EncodedIriManager`).
+  bool encodeShortLiterals = false;
   // If true, add `ql:has-word` triples for each word in each literal during
   // index building.
   bool addHasWordTriples = false;
@@ -88,14 +91,16 @@ struct TestIndexConfig {
         c.usePrefixCompression, c.blocksizePermutations, c.createTextIndex,
         c.addWordsFromLiterals, c.contentsOfWordsFileAndDocsfile,
         c.parserBufferSize, c.scoringMetric, c.bAndKParam, c.indexType,
-        c.encodedPrefixesWithoutAngleBrackets, c.addHasWordTriples);
+        c.encodedPrefixesWithoutAngleBrackets, c.encodeShortLiterals,
+        c.addHasWordTriples);
   }
   QL_DEFINE_DEFAULTED_EQUALITY_OPERATOR_LOCAL(
       TestIndexConfig, turtleInput, loadAllPermutations, usePatterns,
       usePrefixCompression, blocksizePermutations, createTextIndex,
       addWordsFromLiterals, contentsOfWordsFileAndDocsfile, parserBufferSize,
       scoringMetric, bAndKParam, indexType, vocabularyType,
-      encodedPrefixesWithoutAngleBrackets, addHasWordTriples)
+      encodedPrefixesWithoutAngleBrackets, encodeShortLiterals,
+      addHasWordTriples)
 };
 
 // Create a test index at the given `indexBasename` and with the given `config`.